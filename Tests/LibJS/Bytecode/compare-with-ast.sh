@@ -0,0 +1,39 @@
+#!/usr/bin/env bash
+
+# Runs a script with the AST interpreter, and then as bytecode with and without the optimization passes,
+# and fails if the bytecode runs don't print exactly what the AST interpreter did.
+# Usage: compare-with-ast.sh path/to/js path/to/script.js
+
+set -eo pipefail
+
+if [ "$#" -ne 2 ]; then
+    echo "Usage: $0 path/to/js path/to/script.js"
+    exit 1
+fi
+
+js="$1"
+script="$2"
+
+# The optimization passes report how long they took on stderr, so only stdout is compared.
+expected=$("${js}" "${script}")
+if [ -z "${expected}" ]; then
+    echo "FAIL: ${script} didn't print anything with the AST interpreter"
+    exit 1
+fi
+
+status=0
+for flags in "-b" "-b -p"; do
+    # shellcheck disable=SC2086 # The flags are meant to be split.
+    if ! actual=$("${js}" ${flags} "${script}" 2>/dev/null); then
+        echo "FAIL: js ${flags} ${script} exited with an error"
+        status=1
+        continue
+    fi
+    if [ "${expected}" != "${actual}" ]; then
+        echo "FAIL: js ${flags} ${script} printed something other than the AST interpreter did:"
+        diff -u <(echo "${expected}") <(echo "${actual}") || true
+        status=1
+    fi
+done
+
+exit "${status}"
@@ -0,0 +1,66 @@
+let values = [0, 1, -1, 2.5, NaN, "1", "abc", "", null, undefined, true, false];
+
+function compareAll(a, b) {
+    let bits = "";
+    if (a < b) bits += "<";
+    if (a <= b) bits += "l";
+    if (a > b) bits += ">";
+    if (a >= b) bits += "g";
+    if (a == b) bits += "=";
+    if (a != b) bits += "!";
+    if (a === b) bits += "s";
+    if (a !== b) bits += "n";
+    return bits;
+}
+
+for (let i = 0; i < values.length; ++i) {
+    let row = [];
+    for (let j = 0; j < values.length; ++j)
+        row.push(compareAll(values[i], values[j]));
+    console.log(row.join(" "));
+}
+
+function countWhile(limit) {
+    let i = 0;
+    let steps = 0;
+    while (i <= limit) {
+        i += 3;
+        ++steps;
+    }
+    while (i >= 0) {
+        i -= 7;
+        ++steps;
+    }
+    while (i != -100 && i > -200) {
+        --i;
+        ++steps;
+    }
+    return steps;
+}
+console.log(countWhile(50));
+
+function classify(x) {
+    return x < 0 ? "negative" : x > 0 ? "positive" : x === 0 ? "zero" : "other";
+}
+console.log(classify(-3), classify(3), classify(0), classify(NaN));
+
+function comparisonResults(a, b) {
+    let less = a < b;
+    let equal = a == b;
+    return [less, equal, a !== b, (a >= b) === !less].join(",");
+}
+console.log(comparisonResults(1, 2), comparisonResults("b", "a"), comparisonResults(3, "3"));
+
+let object = {
+    valueOf() {
+        return 5;
+    },
+};
+console.log(object < 6, object > 6, object <= 5, object >= 6, object == 5, object != 5);
+
+function shortCircuit(a, b) {
+    if (a < b && b < 10) return "both";
+    if (a > b || b > 10) return "either";
+    return "neither";
+}
+console.log(shortCircuit(1, 2), shortCircuit(3, 2), shortCircuit(1, 20), shortCircuit(10, 10));
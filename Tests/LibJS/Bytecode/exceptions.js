@@ -0,0 +1,121 @@
+function catchAndFinally() {
+    let log = [];
+    try {
+        log.push("try");
+        throw 1;
+    } catch (e) {
+        log.push("catch " + e);
+    } finally {
+        log.push("finally");
+    }
+    log.push("after");
+    return log.join(", ");
+}
+console.log(catchAndFinally());
+
+function finallyWithoutThrow() {
+    let log = [];
+    try {
+        log.push("try");
+    } finally {
+        log.push("finally");
+    }
+    return log.join(", ");
+}
+console.log(finallyWithoutThrow());
+
+function thrower(value) {
+    throw value;
+}
+
+function throwThroughFinally() {
+    let log = [];
+    try {
+        try {
+            log.push("inner");
+            thrower("from a call");
+        } finally {
+            log.push("inner finally");
+        }
+    } catch (e) {
+        log.push("outer catch: " + e);
+    }
+    return log.join(", ");
+}
+console.log(throwThroughFinally());
+
+function throwFromCatch() {
+    let result = "";
+    try {
+        try {
+            throw "first";
+        } catch (e) {
+            result += e;
+            throw "second";
+        }
+    } catch (e) {
+        result += " " + e;
+    }
+    return result;
+}
+console.log(throwFromCatch());
+
+function throwFromFinally() {
+    try {
+        try {
+            throw "lost";
+        } finally {
+            throw "replaced";
+        }
+    } catch (e) {
+        return e;
+    }
+}
+console.log(throwFromFinally());
+
+function valuesAcrossTry() {
+    let a = 1;
+    let b = 2;
+    try {
+        a = 10;
+        thrower(a + b);
+        b = 20;
+    } catch (e) {
+        return a + " " + b + " " + e;
+    }
+}
+console.log(valuesAcrossTry());
+
+function tryInLoop(n) {
+    let caught = 0;
+    let total = 0;
+    for (let i = 0; i < n; ++i) {
+        try {
+            if (i % 3 === 0) thrower(i);
+            total += i;
+        } catch (e) {
+            caught += e;
+        } finally {
+            total += 100;
+        }
+    }
+    return caught + " " + total;
+}
+console.log(tryInLoop(10));
+
+function errorObjects() {
+    try {
+        null.property;
+    } catch (e) {
+        return e instanceof TypeError;
+    }
+}
+console.log(errorObjects());
+
+try {
+    thrower("top level");
+} catch (e) {
+    console.log("caught " + e);
+} finally {
+    console.log("top level finally");
+}
@@ -0,0 +1,85 @@
+function sumSkippingMultiplesOfThree(n) {
+    let total = 0;
+    for (let i = 0; i < n; ++i) {
+        if (i % 3 === 0) continue;
+        total += i;
+    }
+    return total;
+}
+console.log(sumSkippingMultiplesOfThree(100));
+
+function firstSquareAbove(limit) {
+    let i = 0;
+    while (true) {
+        if (i * i > limit) break;
+        ++i;
+    }
+    return i;
+}
+console.log(firstSquareAbove(1000));
+
+function countdown(n) {
+    let steps = [];
+    do {
+        steps.push(n);
+        n -= 2;
+    } while (n > 0);
+    return steps.join(",");
+}
+console.log(countdown(9));
+console.log(countdown(-1));
+
+function triangle(n) {
+    let count = 0;
+    for (let i = 0; i < n; ++i) {
+        for (let j = 0; j < n; ++j) {
+            if (j > i) break;
+            if ((i + j) % 4 === 1) continue;
+            ++count;
+        }
+    }
+    return count;
+}
+console.log(triangle(10));
+
+function collatz(n) {
+    let steps = 0;
+    while (n !== 1) {
+        n = n % 2 === 0 ? n / 2 : 3 * n + 1;
+        steps++;
+    }
+    return steps;
+}
+console.log(collatz(27));
+
+function fibonacci(n) {
+    let a = 0;
+    let b = 1;
+    for (let i = 0; i < n; ++i) {
+        let next = a + b;
+        a = b;
+        b = next;
+    }
+    return a;
+}
+console.log(fibonacci(50));
+
+function sumOfEvenElements(array) {
+    let total = 0;
+    let i = array.length;
+    while (i--) {
+        if (array[i] % 2) continue;
+        total += array[i];
+    }
+    return total;
+}
+console.log(sumOfEvenElements([1, 2, 3, 4, 5, 6, 7, 8, 9, 10]));
+
+let counter = 0;
+for (let i = 0; i < 5; ++i) {
+    let j = 0;
+    do {
+        counter += i * j;
+    } while (++j < i);
+}
+console.log(counter);
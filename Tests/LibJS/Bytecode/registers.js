@@ -0,0 +1,86 @@
+function manyTemporaries(a, b, c, d) {
+    return (a + b) * (c - d) + (a * b - c * d) / (a + 1) - ((b + c) * (d + a) - (a - b) * (c - d));
+}
+console.log(manyTemporaries(1, 2, 3, 4), manyTemporaries(5, -6, 7.5, 8));
+
+function add(a, b) {
+    return a + b;
+}
+
+function nestedCalls(x) {
+    return add(add(x, add(x, 1)), add(add(x, 2), add(add(x, 3), x)));
+}
+console.log(nestedCalls(10));
+
+function manyArguments(a, b, c, d, e, f, g, h) {
+    return [a, b, c, d, e, f, g, h].join("");
+}
+console.log(manyArguments(1, 2, 3, 4, 5, 6, 7, 8), manyArguments("a", add(1, 2), nestedCalls(1), 4));
+
+function shadowedValues() {
+    let a = 1;
+    let b = a + 1;
+    a = b * 2;
+    b = a + b;
+    let c = a;
+    a = 100;
+    return [a, b, c].join(" ");
+}
+console.log(shadowedValues());
+
+function makeCounter() {
+    let count = 0;
+    return function () {
+        count += 1;
+        return count;
+    };
+}
+let counter = makeCounter();
+counter();
+counter();
+console.log(counter());
+
+function objectsAndArrays(n) {
+    let points = [];
+    for (let i = 0; i < n; ++i)
+        points.push({ x: i, y: i * i });
+    let total = 0;
+    for (let i = 0; i < points.length; ++i)
+        total += points[i].x * points[i].y;
+    return total;
+}
+console.log(objectsAndArrays(10));
+
+function logicalOperators(a, b) {
+    return [a && b, a || b, a ?? b, !a, !!b].join(",");
+}
+console.log(logicalOperators(0, "x"), logicalOperators(null, 0), logicalOperators("y", undefined));
+
+function unusedResults(x) {
+    x + 1;
+    x * 2;
+    let unused = x - 1;
+    unused = x;
+    return x;
+}
+console.log(unusedResults(7));
+
+function stringBuilding(n) {
+    let result = "";
+    for (let i = 0; i < n; ++i)
+        result = result + i + (i % 2 ? "," : ";");
+    return result;
+}
+console.log(stringBuilding(12));
+
+function switchStatement(x) {
+    switch (x) {
+    case 1:
+        return "one";
+    case "2":
+        return "two";
+    default:
+        return "many";
+    }
+}
+console.log(switchStatement(1), switchStatement("2"), switchStatement(2));
@@ -0,0 +1,61 @@
+// Every pair of instructions that CombineInstructions turns into a superinstruction, at the top level and in a function.
+
+// GetVariable + Store and GetById + Store
+let point = { x: 3, y: 4 };
+console.log(point.x * point.x + point.y * point.y);
+
+// Increment + SetVariable and Decrement + SetVariable
+let up = 0;
+let down = 10;
+up++;
+++up;
+down--;
+--down;
+console.log(up, down);
+
+// Each comparison + JumpConditional, with the result of the comparison used afterwards too
+let numbers = [-1, 0, 1, NaN, "0", null, undefined];
+let results = [];
+for (let i = 0; i < numbers.length; i++) {
+    let a = numbers[i];
+    let row = "";
+    for (let j = 0; j < numbers.length; j++) {
+        let b = numbers[j];
+        if (a > b) row += ">";
+        if (a >= b) row += "g";
+        if (a < b) row += "<";
+        if (a <= b) row += "l";
+        if (a != b) row += "!";
+        if (a == b) row += "=";
+        if (a !== b) row += "n";
+        if (a === b) row += "s";
+        row += ",";
+    }
+    results.push(row);
+}
+console.log(results.join(" "));
+console.log((up > down) || "x", (up < down) && "y");
+
+function inFunction(limit) {
+    let object = { count: 0, step: 2 };
+    let forwards = 0;
+    let backwards = limit;
+    let total = 0;
+    while (forwards < limit) {
+        forwards++;
+        backwards--;
+        if (forwards == backwards) total += 1000;
+        if (forwards === 3) total += 100;
+        if (forwards != 4) total += object.step;
+        if (forwards !== 5) object.count = object.count + 1;
+        if (backwards <= 2) total -= 1;
+        if (backwards >= 8) total -= 10;
+    }
+    do {
+        --forwards;
+        ++backwards;
+    } while (forwards > backwards);
+    return [total, object.count, forwards, backwards].join(" ");
+}
+console.log(inFunction(10));
+console.log(inFunction(3));
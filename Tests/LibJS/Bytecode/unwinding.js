@@ -0,0 +1,115 @@
+// Exceptions that leave try blocks, including ones thrown by functions that a comparison calls, which
+// run in a nested invocation of the bytecode interpreter.
+
+function throwInsideTryFinally() {
+    let log = [];
+    try {
+        try {
+            log.push("before");
+            throw "error";
+            log.push("not reached");
+        } finally {
+            log.push("finally");
+        }
+        log.push("not reached either");
+    } catch (e) {
+        log.push("caught " + e);
+    }
+    return log.join(", ");
+}
+console.log(throwInsideTryFinally());
+
+function throwingValueOf() {
+    let log = [];
+    let object = {
+        valueOf() {
+            log.push("valueOf");
+            throw "from valueOf";
+        },
+    };
+    try {
+        if (object < 1) log.push("not reached");
+        log.push("not reached either");
+    } catch (e) {
+        log.push("caught " + e);
+    }
+    return log.join(", ");
+}
+console.log(throwingValueOf());
+
+function valueOfWithItsOwnHandler() {
+    let log = [];
+    let object = {
+        valueOf() {
+            try {
+                throw 1;
+            } catch (e) {
+                log.push("handled inside valueOf");
+            }
+            return 10;
+        },
+    };
+    try {
+        if (object > 5) log.push("greater");
+        if (object == 10) log.push("equal");
+        throw "afterwards";
+    } catch (e) {
+        log.push("caught " + e);
+    }
+    return log.join(", ");
+}
+console.log(valueOfWithItsOwnHandler());
+
+function valueOfThrowingThroughFinally() {
+    let log = [];
+    let object = {
+        valueOf() {
+            try {
+                throw "inner";
+            } finally {
+                log.push("valueOf finally");
+            }
+        },
+    };
+    try {
+        try {
+            object >= 0;
+        } finally {
+            log.push("outer finally");
+        }
+    } catch (e) {
+        log.push("caught " + e);
+    }
+    return log.join(", ");
+}
+console.log(valueOfThrowingThroughFinally());
+
+function loopWithThrowingComparisons(n) {
+    let caught = 0;
+    let object = {
+        valueOf() {
+            throw "no";
+        },
+    };
+    for (let i = 0; i < n; ++i) {
+        try {
+            if (i % 2 === 0) object <= i;
+        } catch (e) {
+            caught++;
+        }
+    }
+    return caught;
+}
+console.log(loopWithThrowingComparisons(10));
+
+let topLevel = [];
+try {
+    try {
+        ({ valueOf() { throw "top"; } }) > 0;
+    } finally {
+        topLevel.push("finally");
+    }
+} catch (e) {
+    topLevel.push("caught " + e);
+}
+console.log(topLevel.join(", "));
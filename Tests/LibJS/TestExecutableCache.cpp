@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ByteBuffer.h>
+#include <AK/QuickSort.h>
+#include <AK/StringBuilder.h>
+#include <LibCrypto/Checksum/CRC32.h>
+#include <LibJS/Bytecode/ExecutableCache.h>
+#include <LibJS/Bytecode/Generator.h>
+#include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/PassManager.h>
+#include <LibJS/Lexer.h>
+#include <LibJS/Parser.h>
+#include <LibTest/TestCase.h>
+
+namespace {
+
+// Something of everything that the cache has to patch up or check: jumps, unwind contexts, property lookup
+// caches, block-scoped variables, big integers, calls, arrays and functions.
+constexpr StringView source = R"~~~(
+function add(a, b) { return a + b; }
+let object = { count: 0 };
+for (let i = 0; i < 10; i++) {
+    object.count = add(object.count, i);
+}
+try {
+    if (object.count > 40)
+        throw new Error("too many");
+} catch (e) {
+    object.message = e.message;
+} finally {
+    object.done = true;
+}
+const big = 12345678901234567890n;
+const numbers = [1, 2.5, null, undefined, true, "text"];
+const square = x => x * x;
+square(numbers.length) + object.count;
+)~~~";
+
+// The bytes of the file start with a u32 magic and a u64 layout fingerprint, then the checksum of everything after it.
+constexpr size_t checksum_offset = sizeof(u32) + sizeof(u64);
+constexpr size_t header_size = checksum_offset + sizeof(u32);
+
+JS::Bytecode::Executable generate(JS::Program const& program, bool optimize)
+{
+    auto executable = JS::Bytecode::Generator::generate(program);
+    if (optimize)
+        JS::Bytecode::Interpreter::optimization_pipeline().perform(executable);
+    return executable;
+}
+
+NonnullRefPtr<JS::Program> parse(StringView source)
+{
+    auto parser = JS::Parser(JS::Lexer(source));
+    auto program = parser.parse_program();
+    VERIFY(!parser.has_errors());
+    return program;
+}
+
+ByteBuffer cache_file_for(StringView source, bool optimize)
+{
+    auto program = parse(source);
+    auto bytes = JS::Bytecode::ExecutableCache::serialize(generate(*program, optimize), source);
+    VERIFY(bytes.has_value());
+    return bytes.release_value();
+}
+
+String disassemble(JS::Bytecode::Executable const& executable)
+{
+    StringBuilder builder;
+    for (auto& block : executable.basic_blocks) {
+        builder.appendff("{}:\n", block.name());
+        for (JS::Bytecode::InstructionStreamIterator it { block.instruction_stream() }; !it.at_end(); ++it) {
+            // The variables are in a HashMap, which doesn't list them in the same order after they were loaded.
+            if ((*it).type() == JS::Bytecode::Instruction::Type::PushDeclarativeEnvironment) {
+                Vector<u32> keys;
+                for (auto& variable : static_cast<JS::Bytecode::Op::PushDeclarativeEnvironment const&>(*it).variables())
+                    keys.append(variable.key);
+                quick_sort(keys);
+                builder.append("PushDeclarativeEnvironment");
+                for (auto key : keys)
+                    builder.appendff(" {}", key);
+                builder.append('\n');
+                continue;
+            }
+            builder.appendff("{}\n", (*it).to_string(executable));
+        }
+    }
+    return builder.to_string();
+}
+
+void update_checksum(ByteBuffer& bytes)
+{
+    u32 checksum = Crypto::Checksum::CRC32(bytes.bytes().slice(header_size)).digest();
+    bytes.overwrite(checksum_offset, &checksum, sizeof(checksum));
+}
+
+// Anything that did load has to be safe to look at.
+void expect_operands_in_range(JS::Bytecode::Executable const& executable)
+{
+    for (auto& block : executable.basic_blocks) {
+        for (JS::Bytecode::InstructionStreamIterator it { block.instruction_stream() }; !it.at_end(); ++it) {
+            auto& instruction = const_cast<JS::Bytecode::Instruction&>(*it);
+            instruction.visit_registers([&](JS::Bytecode::Register& reg, JS::Bytecode::RegisterAccess) {
+                EXPECT(reg.index() < executable.number_of_registers);
+            });
+            (void)instruction.to_string(executable);
+        }
+    }
+}
+
+}
+
+TEST_CASE(round_trip)
+{
+    auto program = parse(source);
+    for (auto optimize : { false, true }) {
+        auto executable = generate(*program, optimize);
+        auto bytes = JS::Bytecode::ExecutableCache::serialize(executable, source);
+        EXPECT(bytes.has_value());
+
+        auto loaded_executable = JS::Bytecode::ExecutableCache::deserialize(*bytes);
+        EXPECT(loaded_executable.has_value());
+        EXPECT_EQ(loaded_executable->number_of_registers, executable.number_of_registers);
+        EXPECT_EQ(loaded_executable->property_lookup_caches.size(), executable.property_lookup_caches.size());
+        EXPECT_EQ(disassemble(*loaded_executable), disassemble(executable));
+        expect_operands_in_range(*loaded_executable);
+    }
+}
+
+TEST_CASE(truncated_files_are_rejected)
+{
+    auto bytes = cache_file_for(source, true);
+    for (size_t size = 0; size < bytes.size(); ++size)
+        EXPECT(!JS::Bytecode::ExecutableCache::deserialize(bytes.bytes().trim(size)).has_value());
+
+    // A file that is cut short and has its checksum updated must still be rejected.
+    for (size_t size = header_size; size < bytes.size(); ++size) {
+        auto truncated = ByteBuffer::copy(bytes.bytes().trim(size));
+        update_checksum(truncated);
+        EXPECT(!JS::Bytecode::ExecutableCache::deserialize(truncated).has_value());
+    }
+}
+
+TEST_CASE(corrupted_files_are_rejected)
+{
+    auto bytes = cache_file_for(source, true);
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        for (size_t bit = 0; bit < 8; ++bit) {
+            bytes[i] ^= 1 << bit;
+            EXPECT(!JS::Bytecode::ExecutableCache::deserialize(bytes).has_value());
+            bytes[i] ^= 1 << bit;
+        }
+    }
+}
+
+TEST_CASE(corrupted_payloads_with_a_valid_checksum_do_not_crash)
+{
+    // This is what a file that was written by a buggy or malicious process looks like: the checksum can't help,
+    // so every count and operand has to be checked against what it refers to.
+    for (auto optimize : { false, true }) {
+        auto bytes = cache_file_for(source, optimize);
+        for (size_t i = header_size; i < bytes.size(); ++i) {
+            for (u8 mask : { 0x01, 0x10, 0x80, 0xff }) {
+                bytes[i] ^= mask;
+                update_checksum(bytes);
+                if (auto executable = JS::Bytecode::ExecutableCache::deserialize(bytes); executable.has_value())
+                    expect_operands_in_range(*executable);
+                bytes[i] ^= mask;
+            }
+        }
+    }
+}
@@ -123,6 +123,8 @@ constexpr static u32 pointers[] = {
 NonnullRefPtr<SQL::BTree> setup_btree(SQL::Heap& heap);
 void insert_and_get_to_and_from_btree(int num_keys);
 void insert_into_and_scan_btree(int num_keys);
+void lower_bound_in_btree(int num_keys);
+void bulk_load_btree(int num_keys);
 
 NonnullRefPtr<SQL::BTree> setup_btree(SQL::Heap& heap)
 {
@@ -135,8 +137,8 @@ NonnullRefPtr<SQL::BTree> setup_btree(SQL::Heap& heap)
         heap.set_user_value(0, root_pointer);
     }
     auto btree = SQL::BTree::construct(heap, tuple_descriptor, true, root_pointer);
-    btree->on_new_root = [&]() {
-        heap.set_user_value(0, btree->root());
+    btree->on_new_root = [&heap, tree = btree.ptr()]() {
+        heap.set_user_value(0, tree->root());
     };
     return btree;
 }
@@ -309,3 +311,273 @@ TEST_CASE(btree_scan_50_keys)
 {
     insert_into_and_scan_btree(50);
 }
+
+void lower_bound_in_btree(int num_keys)
+{
+    ScopeGuard guard([]() { unlink("/tmp/test.db"); });
+    auto heap = SQL::Heap::construct("/tmp/test.db");
+    auto btree = setup_btree(heap);
+
+    for (auto ix = 0; ix < num_keys; ix++) {
+        SQL::Key k(btree->descriptor());
+        k[0] = keys[ix];
+        k.set_pointer(pointers[ix]);
+        btree->insert(k);
+    }
+
+    for (auto probe = 0; probe <= 100; probe++) {
+        Optional<int> expected;
+        for (auto ix = 0; ix < num_keys; ix++) {
+            if (keys[ix] >= probe && (!expected.has_value() || keys[ix] < expected.value()))
+                expected = keys[ix];
+        }
+
+        SQL::Key k(btree->descriptor());
+        k[0] = probe;
+        auto iter = btree->lower_bound(k);
+        EXPECT_EQ(iter.is_end(), !expected.has_value());
+        if (expected.has_value() && !iter.is_end())
+            EXPECT_EQ((int)(*iter)[0], expected.value());
+    }
+}
+
+TEST_CASE(btree_lower_bound_five_keys)
+{
+    lower_bound_in_btree(5);
+}
+
+TEST_CASE(btree_lower_bound_50_keys)
+{
+    lower_bound_in_btree(50);
+}
+
+void bulk_load_btree(int num_keys)
+{
+    ScopeGuard guard([]() { unlink("/tmp/test.db"); });
+    {
+        auto heap = SQL::Heap::construct("/tmp/test.db");
+        auto btree = setup_btree(heap);
+        int key_value = 0;
+        EXPECT(btree->bulk_load(num_keys, [&]() {
+            SQL::Key k(btree->descriptor());
+            k[0] = key_value;
+            k.set_pointer(key_value + 1000);
+            key_value++;
+            return k;
+        }));
+        EXPECT_EQ(key_value, num_keys);
+
+        SQL::Key k(btree->descriptor());
+        k[0] = num_keys;
+        EXPECT(!btree->bulk_load(1, [&]() { return k; }));
+        heap->flush();
+    }
+
+    {
+        auto heap = SQL::Heap::construct("/tmp/test.db");
+        auto btree = setup_btree(heap);
+
+        for (auto ix = 0; ix < num_keys; ix++) {
+            SQL::Key k(btree->descriptor());
+            k[0] = ix;
+            auto pointer_opt = btree->get(k);
+            EXPECT(pointer_opt.has_value());
+            EXPECT_EQ(pointer_opt.value(), (u32)ix + 1000);
+        }
+
+        int count = 0;
+        for (auto iter = btree->begin(); !iter.is_end(); iter++, count++)
+            EXPECT_EQ((int)(*iter)[0], count);
+        EXPECT_EQ(count, num_keys);
+
+        // The tree accepts inserts after it was bulk loaded:
+        SQL::Key k(btree->descriptor());
+        k[0] = -1;
+        EXPECT(btree->insert(k));
+        EXPECT(!btree->begin().is_end() && (int)(*btree->begin())[0] == -1);
+    }
+}
+
+TEST_CASE(btree_bulk_load_one_key)
+{
+    bulk_load_btree(1);
+}
+
+TEST_CASE(btree_bulk_load_50_keys)
+{
+    bulk_load_btree(50);
+}
+
+TEST_CASE(btree_bulk_load_10000_keys)
+{
+    bulk_load_btree(10000);
+}
+
+TEST_CASE(btree_bulk_load_is_denser_than_inserts)
+{
+    ScopeGuard guard([]() { unlink("/tmp/test.db"); });
+    constexpr int num_keys = 5000;
+    auto make_key = [](SQL::BTree& btree, int value) {
+        SQL::Key k(btree.descriptor());
+        k[0] = value;
+        k.set_pointer(value + 1);
+        return k;
+    };
+
+    u32 blocks_after_inserts;
+    {
+        auto heap = SQL::Heap::construct("/tmp/test.db");
+        auto btree = setup_btree(heap);
+        // Inserting keys in ascending order leaves every node that is split half empty:
+        for (auto ix = 0; ix < num_keys; ix++)
+            btree->insert(make_key(*btree, ix));
+        blocks_after_inserts = heap->new_record_pointer();
+    }
+    unlink("/tmp/test.db");
+    {
+        auto heap = SQL::Heap::construct("/tmp/test.db");
+        auto btree = setup_btree(heap);
+        int value = 0;
+        btree->bulk_load(num_keys, [&]() { return make_key(*btree, value++); });
+        EXPECT(heap->new_record_pointer() < blocks_after_inserts);
+    }
+}
+
+TEST_CASE(btree_keys_with_common_prefix)
+{
+    ScopeGuard guard([]() { unlink("/tmp/test.db"); });
+    constexpr int num_keys = 200;
+    SQL::TupleDescriptor descriptor;
+    descriptor.append({ "key_value", SQL::SQLType::Text, SQL::AST::Order::Ascending });
+    auto make_key = [&](int value) {
+        SQL::Key k(descriptor);
+        k[0] = String::formatted("a rather long prefix shared by all keys {:05}", value);
+        k.set_pointer(value + 1);
+        return k;
+    };
+
+    {
+        auto heap = SQL::Heap::construct("/tmp/test.db", SQL::MIN_BLOCK_SIZE);
+        auto first_block = heap->new_record_pointer();
+        auto btree = SQL::BTree::construct(heap, descriptor, true, 0);
+        for (auto ix = 0; ix < num_keys; ix++)
+            EXPECT(btree->insert(make_key((ix * 37) % num_keys)));
+        // Only about a dozen of these keys would fit in a node if they were stored at their full width:
+        EXPECT(heap->new_record_pointer() - first_block < 8);
+        heap->set_user_value(0, btree->root());
+        heap->flush();
+    }
+
+    {
+        auto heap = SQL::Heap::construct("/tmp/test.db");
+        auto btree = SQL::BTree::construct(heap, descriptor, true, heap->user_value(0));
+        for (auto ix = 0; ix < num_keys; ix++) {
+            auto k = make_key(ix);
+            auto pointer_opt = btree->get(k);
+            EXPECT(pointer_opt.has_value());
+            EXPECT_EQ(pointer_opt.value(), (u32)ix + 1);
+        }
+        int count = 0;
+        for (auto iter = btree->begin(); !iter.is_end(); iter++, count++)
+            EXPECT((*iter)[0] == make_key(count)[0]);
+        EXPECT_EQ(count, num_keys);
+    }
+}
+
+TEST_CASE(btree_remove_merges_nodes)
+{
+    ScopeGuard guard([]() { unlink("/tmp/test.db"); });
+    constexpr int num_keys = 2000;
+    auto make_key = [](SQL::BTree& btree, int value) {
+        SQL::Key k(btree.descriptor());
+        k[0] = value;
+        k.set_pointer(value + 1);
+        return k;
+    };
+    // Every key except the multiples of ten is removed, in a scrambled order:
+    auto is_kept = [](int value) { return value % 10 == 0; };
+
+    u32 file_size;
+    {
+        auto heap = SQL::Heap::construct("/tmp/test.db", SQL::MIN_BLOCK_SIZE);
+        auto btree = setup_btree(heap);
+        for (auto ix = 0; ix < num_keys; ix++)
+            EXPECT(btree->insert(make_key(*btree, (ix * 7) % num_keys)));
+        heap->flush();
+        file_size = heap->new_record_pointer();
+
+        for (auto ix = 0; ix < num_keys; ix++) {
+            auto value = (ix * 13) % num_keys;
+            if (!is_kept(value))
+                EXPECT(btree->remove(make_key(*btree, value)));
+        }
+        EXPECT(!btree->remove(make_key(*btree, 1)));
+        heap->flush();
+        EXPECT(heap->free_blocks() > 0u);
+    }
+
+    {
+        auto heap = SQL::Heap::construct("/tmp/test.db", SQL::MIN_BLOCK_SIZE);
+        auto btree = setup_btree(heap);
+        for (auto ix = 0; ix < num_keys; ix++) {
+            auto k = make_key(*btree, ix);
+            auto pointer_opt = btree->get(k);
+            EXPECT_EQ(pointer_opt.has_value(), is_kept(ix));
+        }
+        int count = 0;
+        for (auto iter = btree->begin(); !iter.is_end(); iter++, count++)
+            EXPECT_EQ((int)(*iter)[0], count * 10);
+        EXPECT_EQ(count, num_keys / 10);
+
+        // New keys go into the blocks that were freed, instead of growing the file:
+        for (auto ix = 1; ix < num_keys; ix += 10)
+            EXPECT(btree->insert(make_key(*btree, ix)));
+        EXPECT(heap->new_record_pointer() < file_size);
+
+        for (auto ix = 0; ix < num_keys; ix++) {
+            if (ix % 10 < 2)
+                EXPECT(btree->remove(make_key(*btree, ix)));
+        }
+        EXPECT(btree->begin().is_end());
+        EXPECT(btree->insert(make_key(*btree, 42)));
+        EXPECT_EQ((int)(*btree->begin())[0], 42);
+    }
+}
+
+TEST_CASE(btree_pins_root_and_internal_nodes)
+{
+    ScopeGuard guard([]() { unlink("/tmp/test.db"); });
+    constexpr int num_keys = 20000;
+    auto make_key = [](SQL::BTree& btree, int value) {
+        SQL::Key k(btree.descriptor());
+        k[0] = value;
+        k.set_pointer(value + 1);
+        return k;
+    };
+
+    auto heap = SQL::Heap::construct("/tmp/test.db", SQL::MIN_BLOCK_SIZE);
+    auto btree = setup_btree(heap);
+    // The root only gets into the page cache when it's committed, and is pinned then:
+    EXPECT(btree->insert(make_key(*btree, 0)));
+    heap->flush();
+    EXPECT_EQ(heap->page_cache().pinned(), 1u);
+
+    // Splitting the leaf root unpins it, and pins the new root:
+    for (auto ix = 1; ix < 500; ix++)
+        EXPECT(btree->insert(make_key(*btree, ix)));
+    heap->flush();
+    EXPECT_EQ(heap->page_cache().pinned(), 1u);
+
+    // Splitting internal nodes pins the new ones:
+    for (auto ix = 500; ix < num_keys; ix++)
+        EXPECT(btree->insert(make_key(*btree, ix)));
+    heap->flush();
+    EXPECT(heap->page_cache().pinned() > 2u);
+
+    // Every internal node is freed as the tree shrinks, until only the leaf root is left:
+    for (auto ix = 0; ix < num_keys; ix++)
+        EXPECT(btree->remove(make_key(*btree, ix)));
+    heap->flush();
+    EXPECT(btree->begin().is_end());
+    EXPECT_EQ(heap->page_cache().pinned(), 1u);
+}
@@ -4,16 +4,23 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <sys/stat.h>
 #include <unistd.h>
 
+#include <AK/Atomic.h>
 #include <AK/ScopeGuard.h>
+#include <LibCore/File.h>
 #include <LibSQL/BTree.h>
+#include <LibSQL/BulkLoader.h>
 #include <LibSQL/Database.h>
+#include <LibSQL/ExternalSorter.h>
 #include <LibSQL/Heap.h>
 #include <LibSQL/Meta.h>
+#include <LibSQL/PageCache.h>
 #include <LibSQL/Row.h>
 #include <LibSQL/Value.h>
 #include <LibTest/TestCase.h>
+#include <LibThreading/Thread.h>
 
 NonnullRefPtr<SQL::SchemaDef> setup_schema(SQL::Database&);
 NonnullRefPtr<SQL::SchemaDef> setup_table(SQL::Database&);
@@ -99,7 +106,297 @@ TEST_CASE(create_heap)
 {
     ScopeGuard guard([]() { unlink("/tmp/test.db"); });
     auto heap = SQL::Heap::construct("/tmp/test.db");
-    EXPECT_EQ(heap->version(), 0x00000001u);
+    EXPECT_EQ(heap->version(), SQL::FORMAT_VERSION);
+}
+
+TEST_CASE(heap_page_cache)
+{
+    ScopeGuard guard([]() { unlink("/tmp/test.db"); });
+    Vector<u32> blocks;
+    {
+        auto heap = SQL::Heap::construct("/tmp/test.db");
+        for (auto ix = 0; ix < 10; ix++) {
+            auto block = heap->new_record_pointer();
+            auto buffer = ByteBuffer::create_zeroed(heap->block_size());
+            buffer.overwrite(0, &ix, sizeof(int));
+            heap->add_to_wal(block, buffer);
+            blocks.append(block);
+        }
+        heap->flush();
+    }
+    {
+        auto heap = SQL::Heap::construct("/tmp/test.db");
+        auto blocks_read = heap->blocks_read();
+        for (auto ix = 0u; ix < blocks.size(); ix++) {
+            auto buffer_or_error = heap->read_block(blocks[ix]);
+            EXPECT(!buffer_or_error.is_error());
+            int value;
+            memcpy(&value, buffer_or_error.value().data(), sizeof(int));
+            EXPECT_EQ(value, (int)ix);
+        }
+        EXPECT_EQ(heap->blocks_read(), blocks_read + blocks.size());
+
+        auto hits = heap->page_cache().hits();
+        for (auto block : blocks)
+            EXPECT(!heap->read_block(block).is_error());
+        EXPECT_EQ(heap->blocks_read(), blocks_read + blocks.size());
+        EXPECT_EQ(heap->page_cache().hits(), hits + blocks.size());
+    }
+}
+
+TEST_CASE(page_cache_eviction)
+{
+    SQL::PageCache cache(4 * SQL::DEFAULT_BLOCK_SIZE, SQL::DEFAULT_BLOCK_SIZE);
+    auto buffer = ByteBuffer::create_zeroed(SQL::DEFAULT_BLOCK_SIZE);
+    for (auto block = 1u; block <= 4; block++)
+        cache.put(block, buffer);
+    EXPECT_EQ(cache.size(), 4u);
+    EXPECT(cache.pin(1));
+    EXPECT(cache.pin(2));
+    EXPECT(!cache.pin(3));
+
+    for (auto block = 5u; block <= 8; block++)
+        cache.put(block, buffer);
+    EXPECT_EQ(cache.size(), 4u);
+    EXPECT(cache.get(1).has_value());
+    EXPECT(cache.get(2).has_value());
+    EXPECT(!cache.get(3).has_value());
+    EXPECT(cache.get(8).has_value());
+    EXPECT_EQ(cache.hits(), 3u);
+    EXPECT_EQ(cache.misses(), 1u);
+    EXPECT_EQ(cache.evictions(), 4u);
+}
+
+TEST_CASE(page_cache_pin_before_put)
+{
+    SQL::PageCache cache(4 * SQL::DEFAULT_BLOCK_SIZE, SQL::DEFAULT_BLOCK_SIZE);
+    auto buffer = ByteBuffer::create_zeroed(SQL::DEFAULT_BLOCK_SIZE);
+    // Pins of blocks that aren't cached yet count against the limit, and take effect when they are put:
+    EXPECT(cache.pin(1));
+    EXPECT(cache.pin(2));
+    EXPECT(!cache.pin(3));
+    EXPECT_EQ(cache.pinned(), 0u);
+    cache.unpin(2);
+    cache.put(1, buffer);
+    cache.put(2, buffer);
+    EXPECT_EQ(cache.pinned(), 1u);
+
+    for (auto block = 3u; block <= 8; block++)
+        cache.put(block, buffer);
+    EXPECT(cache.get(1).has_value());
+    EXPECT(!cache.get(2).has_value());
+}
+
+static void write_test_blocks(SQL::Heap& heap, int first_value, int count, Vector<u32>& blocks)
+{
+    for (auto ix = 0; ix < count; ix++) {
+        auto block = heap.new_record_pointer();
+        auto buffer = ByteBuffer::create_zeroed(heap.block_size());
+        auto value = first_value + ix;
+        buffer.overwrite(0, &value, sizeof(int));
+        heap.add_to_wal(block, buffer);
+        blocks.append(block);
+    }
+}
+
+static void snapshot_database(String const& from, String const& to)
+{
+    unlink(to.characters());
+    unlink(String::formatted("{}-wal", to).characters());
+    EXPECT(!Core::File::copy_file_or_directory(to, from).is_error());
+    EXPECT(!Core::File::copy_file_or_directory(String::formatted("{}-wal", to), String::formatted("{}-wal", from)).is_error());
+}
+
+TEST_CASE(heap_write_ahead_log_recovery)
+{
+    ScopeGuard guard([]() {
+        unlink("/tmp/test.db");
+        unlink("/tmp/test-crash.db");
+    });
+    Vector<u32> blocks;
+    {
+        auto heap = SQL::Heap::construct("/tmp/test.db");
+        heap->set_checkpoint_threshold(1000);
+        write_test_blocks(heap, 0, 10, blocks);
+        heap->flush();
+        EXPECT_EQ(heap->wal_frames(), 10u);
+
+        // Simulate a crash by copying the files while the Heap is open.
+        // The commit is in the log but not in the database file yet:
+        snapshot_database("/tmp/test.db", "/tmp/test-crash.db");
+    }
+    {
+        auto heap = SQL::Heap::construct("/tmp/test-crash.db");
+        EXPECT_EQ(heap->wal_frames(), 0u);
+        for (auto ix = 0u; ix < blocks.size(); ix++) {
+            auto buffer_or_error = heap->read_block(blocks[ix]);
+            EXPECT(!buffer_or_error.is_error());
+            int value;
+            memcpy(&value, buffer_or_error.value().data(), sizeof(int));
+            EXPECT_EQ(value, (int)ix);
+        }
+    }
+}
+
+TEST_CASE(heap_write_ahead_log_discards_torn_commit)
+{
+    ScopeGuard guard([]() {
+        unlink("/tmp/test.db");
+        unlink("/tmp/test-crash.db");
+    });
+    Vector<u32> blocks;
+    {
+        auto heap = SQL::Heap::construct("/tmp/test.db");
+        write_test_blocks(heap, 0, 5, blocks);
+        heap->flush();
+        write_test_blocks(heap, 100, 5, blocks);
+        heap->flush();
+        snapshot_database("/tmp/test.db", "/tmp/test-crash.db");
+    }
+    {
+        // Chop the last frame off, as if the second commit was torn:
+        auto file_or_error = Core::File::open("/tmp/test-crash.db-wal", Core::OpenMode::ReadWrite);
+        EXPECT(!file_or_error.is_error());
+        struct stat stat_buffer;
+        EXPECT_EQ(stat("/tmp/test-crash.db-wal", &stat_buffer), 0);
+        EXPECT(file_or_error.value()->truncate(stat_buffer.st_size - 100));
+    }
+    {
+        auto heap = SQL::Heap::construct("/tmp/test-crash.db");
+        for (auto ix = 0u; ix < 5; ix++) {
+            auto buffer_or_error = heap->read_block(blocks[ix]);
+            EXPECT(!buffer_or_error.is_error());
+            int value;
+            memcpy(&value, buffer_or_error.value().data(), sizeof(int));
+            EXPECT_EQ(value, (int)ix);
+        }
+        EXPECT(!heap->has_block(blocks[5]));
+    }
+}
+
+TEST_CASE(heap_sync_interval)
+{
+    ScopeGuard guard([]() { unlink("/tmp/test.db"); });
+    Vector<u32> blocks;
+    {
+        auto heap = SQL::Heap::construct("/tmp/test.db");
+        heap->set_sync_interval(8);
+        heap->set_checkpoint_threshold(16);
+        for (auto ix = 0; ix < 20; ix++) {
+            write_test_blocks(heap, ix, 1, blocks);
+            heap->flush();
+        }
+        // The log was checkpointed after 16 frames:
+        EXPECT(heap->wal_frames() < 16u);
+    }
+    {
+        auto heap = SQL::Heap::construct("/tmp/test.db");
+        for (auto ix = 0u; ix < blocks.size(); ix++) {
+            auto buffer_or_error = heap->read_block(blocks[ix]);
+            EXPECT(!buffer_or_error.is_error());
+            int value;
+            memcpy(&value, buffer_or_error.value().data(), sizeof(int));
+            EXPECT_EQ(value, (int)ix);
+        }
+    }
+}
+
+TEST_CASE(heap_block_size)
+{
+    ScopeGuard guard([]() { unlink("/tmp/test.db"); });
+    {
+        auto heap = SQL::Heap::construct("/tmp/test.db", 16384);
+        EXPECT_EQ(heap->block_size(), 16384u);
+        Vector<u32> blocks;
+        write_test_blocks(heap, 0, 3, blocks);
+        heap->flush();
+    }
+    {
+        // The block size of an existing file is the one it was created with:
+        auto heap = SQL::Heap::construct("/tmp/test.db", 4096);
+        EXPECT_EQ(heap->block_size(), 16384u);
+        EXPECT_EQ(heap->size(), 4u);
+        auto buffer_or_error = heap->read_block(3);
+        EXPECT(!buffer_or_error.is_error());
+        EXPECT_EQ(buffer_or_error.value().size(), 16384u);
+    }
+    struct stat stat_buffer;
+    EXPECT_EQ(stat("/tmp/test.db", &stat_buffer), 0);
+    EXPECT_EQ(stat_buffer.st_size, 4 * 16384);
+}
+
+TEST_CASE(heap_free_blocks_are_reused)
+{
+    ScopeGuard guard([]() { unlink("/tmp/test.db"); });
+    Vector<u32> blocks;
+    {
+        auto heap = SQL::Heap::construct("/tmp/test.db");
+        write_test_blocks(heap, 0, 10, blocks);
+        heap->free_block(blocks[3]);
+        heap->free_block(blocks[7]);
+        heap->flush();
+        EXPECT_EQ(heap->free_blocks(), 2u);
+    }
+    {
+        // The free list survives reopening the file, and is used before the file grows:
+        auto heap = SQL::Heap::construct("/tmp/test.db");
+        EXPECT_EQ(heap->free_blocks(), 2u);
+        EXPECT_EQ(heap->new_record_pointer(), blocks[7]);
+        EXPECT_EQ(heap->new_record_pointer(), blocks[3]);
+        EXPECT_EQ(heap->free_blocks(), 0u);
+        EXPECT_EQ(heap->new_record_pointer(), heap->size());
+    }
+}
+
+TEST_CASE(heap_snapshot)
+{
+    ScopeGuard guard([]() { unlink("/tmp/test.db"); });
+    auto heap = SQL::Heap::construct("/tmp/test.db");
+    Vector<u32> blocks;
+    write_test_blocks(heap, 0, 5, blocks);
+    heap->flush();
+    EXPECT(heap->checkpoint());
+    write_test_blocks(heap, 5, 5, blocks);
+    heap->flush();
+
+    RefPtr<SQL::Heap> snapshot = heap->snapshot();
+    EXPECT(snapshot->is_snapshot());
+    EXPECT_EQ(heap->open_snapshots(), 1u);
+    EXPECT(snapshot->has_block(blocks.last()));
+
+    // Overwrite every block, and commit some of the new versions:
+    for (auto ix = 0u; ix < blocks.size(); ix++) {
+        auto buffer = ByteBuffer::create_zeroed(heap->block_size());
+        auto value = 100 + (int)ix;
+        buffer.overwrite(0, &value, sizeof(int));
+        heap->add_to_wal(blocks[ix], buffer);
+        if (ix == 2)
+            heap->flush();
+    }
+    auto check_blocks = [&](SQL::Heap& heap, int first_value) {
+        for (auto ix = 0u; ix < blocks.size(); ix++) {
+            auto buffer_or_error = heap.read_block(blocks[ix]);
+            EXPECT(!buffer_or_error.is_error());
+            int value;
+            memcpy(&value, buffer_or_error.value().data(), sizeof(int));
+            EXPECT_EQ(value, first_value + (int)ix);
+        }
+    };
+    check_blocks(*snapshot, 0);
+    heap->flush();
+    check_blocks(*snapshot, 0);
+    check_blocks(heap, 100);
+
+    // The log can't be checkpointed while a snapshot reads from it:
+    EXPECT(!heap->checkpoint());
+    snapshot = heap->snapshot();
+    EXPECT_EQ(heap->open_snapshots(), 1u);
+    check_blocks(*snapshot, 100);
+    snapshot = nullptr;
+    EXPECT_EQ(heap->open_snapshots(), 0u);
+    EXPECT(heap->checkpoint());
+    EXPECT_EQ(heap->wal_frames(), 0u);
+    check_blocks(heap, 100);
 }
 
 TEST_CASE(create_database)
@@ -176,3 +473,209 @@ TEST_CASE(insert_100_into_table)
 {
     insert_and_verify(100);
 }
+
+TEST_CASE(external_sort)
+{
+    SQL::TupleDescriptor descriptor;
+    descriptor.append({ "IntColumn", SQL::SQLType::Integer, SQL::AST::Order::Ascending });
+    SQL::ExternalSorter sorter(descriptor, 1024);
+    for (auto ix = 0; ix < 1000; ix++) {
+        SQL::Key key(descriptor);
+        key[0] = (ix * 7919) % 1000;
+        key.set_pointer(ix);
+        sorter.append(key);
+    }
+    EXPECT_EQ(sorter.size(), 1000u);
+    EXPECT(sorter.runs() > 1);
+
+    for (auto pass = 0; pass < 2; pass++) {
+        sorter.rewind();
+        auto expected = 0;
+        for (auto key = sorter.next(); key.has_value(); key = sorter.next()) {
+            EXPECT_EQ((int)(*key)[0], expected);
+            EXPECT_EQ(((int)key->pointer() * 7919) % 1000, expected);
+            expected++;
+        }
+        EXPECT_EQ(expected, 1000);
+    }
+}
+
+TEST_CASE(bulk_load_into_table)
+{
+    ScopeGuard guard([]() { unlink("/tmp/test.db"); });
+    {
+        auto db = SQL::Database::construct("/tmp/test.db");
+        setup_table(db);
+        insert_into_table(db, 10);
+        auto table = db->get_table("TestSchema", "TestTable");
+        auto text_index = SQL::IndexDef::construct(table.ptr(), "TextIndex", true, 0, SQL::AST::IndexType::BTree);
+        text_index->append_column("TextColumn", SQL::SQLType::Text);
+        EXPECT(db->add_index(text_index));
+        auto int_index = SQL::IndexDef::construct(table.ptr(), "IntIndex", false, 0, SQL::AST::IndexType::BTree);
+        int_index->append_column("IntColumn", SQL::SQLType::Integer);
+        EXPECT(db->add_index(int_index));
+
+        // Sort with a small memory budget, so the entries are spilled to disk:
+        SQL::BulkLoader loader(db, *table, SQL::DEFAULT_BULK_LOAD_FILL_FACTOR, 4096);
+        for (auto ix = 10; ix < 2000; ix++) {
+            SQL::Row row(*table);
+            row["TextColumn"] = String::formatted("Test{}", ix);
+            row["IntColumn"] = ix;
+            loader.append(row);
+        }
+        EXPECT(loader.finish());
+        EXPECT_EQ(loader.rows(), 1990u);
+        db->commit();
+    }
+    {
+        auto db = SQL::Database::construct("/tmp/test.db");
+        verify_table_contents(db, 2000);
+        auto table = db->get_table("TestSchema", "TestTable");
+        EXPECT_EQ(db->row_count(*table), 2000u);
+        EXPECT_EQ(table->num_indexes(), 2u);
+
+        RefPtr<SQL::IndexDef> text_index;
+        for (auto& index : table->indexes()) {
+            auto btree = db->get_btree(index);
+            int count = 0;
+            for (auto iter = btree->begin(); !iter.is_end(); iter++)
+                count++;
+            EXPECT_EQ(count, 2000);
+            EXPECT_EQ(db->distinct_keys(index), 2000u);
+            if (index.name() == "TextIndex")
+                text_index = index;
+        }
+        EXPECT(text_index);
+
+        auto text_btree = db->get_btree(*text_index);
+        SQL::Key key(text_btree->descriptor());
+        key["TextColumn"] = "Test1234";
+        auto iter = text_btree->find(key);
+        EXPECT(!iter.is_end());
+        EXPECT_EQ(db->read_row(table, (*iter).pointer())["IntColumn"].to_int().value(), 1234);
+
+        // A duplicate in the unique index rejects the whole load:
+        SQL::BulkLoader loader(db, *table);
+        for (auto ix : { 3000, 1234 }) {
+            SQL::Row row(*table);
+            row["TextColumn"] = String::formatted("Test{}", ix);
+            row["IntColumn"] = ix;
+            loader.append(row);
+        }
+        EXPECT(!loader.finish());
+        EXPECT_EQ(db->row_count(*table), 2000u);
+        verify_table_contents(db, 2000);
+    }
+}
+
+TEST_CASE(database_snapshot)
+{
+    ScopeGuard guard([]() { unlink("/tmp/test.db"); });
+    auto db = SQL::Database::construct("/tmp/test.db");
+    setup_table(db);
+    insert_into_table(db, 10);
+    db->commit();
+
+    RefPtr<SQL::Database> snapshot = db->snapshot();
+    EXPECT(snapshot->is_snapshot());
+    EXPECT_EQ(db->heap().open_snapshots(), 1u);
+
+    // Rows added after the snapshot was taken, committed or not, are invisible to it:
+    auto table = db->get_table("TestSchema", "TestTable");
+    for (auto ix = 10; ix < 20; ix++) {
+        SQL::Row row(*table);
+        row["TextColumn"] = String::formatted("Test{}", ix);
+        row["IntColumn"] = ix;
+        EXPECT(db->insert(row));
+        if (ix == 14)
+            db->commit();
+    }
+    verify_table_contents(*snapshot, 10);
+    EXPECT_EQ(snapshot->row_count(*snapshot->get_table("TestSchema", "TestTable")), 10u);
+    db->commit();
+    verify_table_contents(*snapshot, 10);
+    verify_table_contents(db, 20);
+
+    // The file the snapshot reads from isn't replaced:
+    EXPECT(!db->vacuum());
+    snapshot = db->snapshot();
+    EXPECT_EQ(db->heap().open_snapshots(), 1u);
+    verify_table_contents(*snapshot, 20);
+    snapshot = nullptr;
+    EXPECT_EQ(db->heap().open_snapshots(), 0u);
+    EXPECT(db->vacuum());
+    verify_table_contents(db, 20);
+}
+
+// A writer keeps inserting batches of rows, while readers keep taking snapshots and check that
+// every snapshot holds a whole number of batches, and that the rows, the index on IntColumn, and
+// the row count agree with each other.
+TEST_CASE(concurrent_snapshot_readers)
+{
+    constexpr int batches = 100;
+    constexpr int batch_size = 10;
+    constexpr int readers = 4;
+
+    ScopeGuard guard([]() { unlink("/tmp/test.db"); });
+    {
+        auto db = SQL::Database::construct("/tmp/test.db");
+        setup_table(db);
+        auto table = db->get_table("TestSchema", "TestTable");
+        auto index = SQL::IndexDef::construct(table.ptr(), "IntIndex", true, 0, SQL::AST::IndexType::BTree);
+        index->append_column("IntColumn", SQL::SQLType::Integer);
+        EXPECT(db->add_index(index));
+        db->commit();
+
+        Atomic<bool> done { false };
+        Atomic<int> snapshots { 0 };
+        Atomic<int> failures { 0 };
+        auto read = [&]() -> intptr_t {
+            while (!done.load()) {
+                auto snapshot = db->snapshot();
+                auto snapshot_table = snapshot->get_table("TestSchema", "TestTable");
+                int count = 0;
+                i64 sum = 0;
+                for (auto& row : snapshot->select_all(*snapshot_table)) {
+                    count++;
+                    sum += row["IntColumn"].to_int().value();
+                }
+                int index_entries = 0;
+                auto btree = snapshot->get_btree(snapshot_table->indexes()[0]);
+                for (auto iter = btree->begin(); !iter.is_end(); iter++)
+                    index_entries++;
+                if (count % batch_size != 0 || sum != (i64)count * (count - 1) / 2 || index_entries != count || snapshot->row_count(*snapshot_table) != (u32)count)
+                    failures++;
+                snapshots++;
+            }
+            return 0;
+        };
+
+        NonnullRefPtrVector<Threading::Thread> threads;
+        for (auto ix = 0; ix < readers; ix++) {
+            threads.append(Threading::Thread::construct([&]() { return read(); }, "sql-reader"));
+            threads.last().start();
+        }
+        for (auto batch = 0; batch < batches; batch++) {
+            for (auto ix = batch * batch_size; ix < (batch + 1) * batch_size; ix++) {
+                SQL::Row row(*table);
+                row["TextColumn"] = String::formatted("Test{}", ix);
+                row["IntColumn"] = ix;
+                EXPECT(db->insert(row));
+            }
+            db->commit();
+        }
+        // Let the readers take a few snapshots of the final state as well:
+        auto seen = snapshots.load();
+        while (snapshots.load() < seen + 2 * readers)
+            usleep(1000);
+        done = true;
+        for (auto& thread : threads)
+            EXPECT(!thread.join().is_error());
+
+        EXPECT_EQ(failures.load(), 0);
+        EXPECT(snapshots.load() > 0);
+        EXPECT_EQ(db->heap().open_snapshots(), 0u);
+        verify_table_contents(db, batches * batch_size);
+    }
+    verify_table_contents(SQL::Database::construct("/tmp/test.db"), batches * batch_size);
+}
@@ -7,6 +7,7 @@
 
 #include <LibTest/TestCase.h>
 
+#include <AK/Function.h>
 #include <AK/HashMap.h>
 #include <AK/Result.h>
 #include <AK/String.h>
@@ -252,6 +253,78 @@ TEST_CASE(binary_operator)
     }
 }
 
+TEST_CASE(binary_operator_precedence)
+{
+    auto symbol = [](SQL::AST::BinaryOperator type) -> StringView {
+        switch (type) {
+        case SQL::AST::BinaryOperator::Multiplication:
+            return "*";
+        case SQL::AST::BinaryOperator::Plus:
+            return "+";
+        case SQL::AST::BinaryOperator::Minus:
+            return "-";
+        case SQL::AST::BinaryOperator::And:
+            return "AND";
+        case SQL::AST::BinaryOperator::Or:
+            return "OR";
+        default:
+            return "?";
+        }
+    };
+
+    // Renders the expression tree with explicit parentheses around every binary operation.
+    Function<String(SQL::AST::Expression const&)> render = [&](SQL::AST::Expression const& expression) -> String {
+        if (is<SQL::AST::NumericLiteral>(expression))
+            return String::number(static_cast<const SQL::AST::NumericLiteral&>(expression).value());
+        if (is<SQL::AST::UnaryOperatorExpression>(expression))
+            return String::formatted("-{}", render(*static_cast<const SQL::AST::UnaryOperatorExpression&>(expression).expression()));
+        EXPECT(is<SQL::AST::BinaryOperatorExpression>(expression));
+        const auto& binary = static_cast<const SQL::AST::BinaryOperatorExpression&>(expression);
+        return String::formatted("({} {} {})", render(*binary.lhs()), symbol(binary.type()), render(*binary.rhs()));
+    };
+
+    auto validate = [&](StringView sql, StringView expected) {
+        auto result = parse(sql);
+        EXPECT(!result.is_error());
+        EXPECT_EQ(render(*result.release_value()), expected);
+    };
+
+    validate("1 + 2 * 3", "(1 + (2 * 3))");
+    validate("1 * 2 + 3", "((1 * 2) + 3)");
+    validate("1 - 2 - 3", "((1 - 2) - 3)");
+    validate("1 - 2 + 3 * 4 - 5", "(((1 - 2) + (3 * 4)) - 5)");
+    validate("-1 + 2", "(-1 + 2)");
+    validate("1 OR 2 AND 3", "(1 OR (2 AND 3))");
+    validate("1 AND 2 OR 3", "((1 AND 2) OR 3)");
+}
+
+TEST_CASE(function_call_expression)
+{
+    EXPECT(parse("COUNT(").is_error());
+    EXPECT(parse("COUNT(1,").is_error());
+    EXPECT(parse("COUNT(*, 1)").is_error());
+
+    auto validate = [](StringView sql, StringView expected_name, size_t expected_arguments, bool expect_distinct, bool expect_star) {
+        auto result = parse(sql);
+        EXPECT(!result.is_error());
+
+        auto expression = result.release_value();
+        EXPECT(is<SQL::AST::FunctionCallExpression>(*expression));
+
+        const auto& call = static_cast<const SQL::AST::FunctionCallExpression&>(*expression);
+        EXPECT_EQ(call.name(), expected_name);
+        EXPECT_EQ(call.arguments().size(), expected_arguments);
+        EXPECT_EQ(call.is_distinct(), expect_distinct);
+        EXPECT_EQ(call.is_star(), expect_star);
+    };
+
+    validate("COUNT(*)", "COUNT", 0, false, true);
+    validate("random()", "RANDOM", 0, false, false);
+    validate("upper(name)", "UPPER", 1, false, false);
+    validate("coalesce(a, b, 15)", "COALESCE", 3, false, false);
+    validate("COUNT(DISTINCT a)", "COUNT", 1, true, false);
+}
+
 TEST_CASE(chained_expression)
 {
     EXPECT(parse("()").is_error());
@@ -0,0 +1,525 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <AK/ScopeGuard.h>
+#include <AK/String.h>
+#include <AK/StringBuilder.h>
+#include <AK/Vector.h>
+#include <LibSQL/AST/Lexer.h>
+#include <LibSQL/AST/Parser.h>
+#include <LibSQL/Database.h>
+#include <LibSQL/Executor.h>
+#include <LibSQL/Operator.h>
+#include <LibTest/TestCase.h>
+
+namespace {
+
+constexpr const char* db_name = "/tmp/test.db";
+
+using ExecutionResult = Result<Vector<String>, String>;
+
+ExecutionResult execute(SQL::Executor& executor, StringView sql)
+{
+    auto parser = SQL::AST::Parser(SQL::AST::Lexer(sql));
+    auto statement = parser.next_statement();
+    if (parser.has_errors())
+        return parser.errors()[0].to_string();
+
+    auto result = executor.execute(statement);
+    if (result.is_error())
+        return result.release_error();
+
+    Vector<String> rows;
+    auto plan = result.release_value();
+    if (!plan)
+        return rows;
+    for (auto row = plan->next(); row.has_value(); row = plan->next()) {
+        StringBuilder builder;
+        for (auto ix = 0u; ix < row->length(); ix++) {
+            if (ix > 0)
+                builder.append('|');
+            builder.append((*row)[ix].to_string().value_or("NULL"));
+        }
+        rows.append(builder.build());
+    }
+    return rows;
+}
+
+Vector<String> run(SQL::Executor& executor, StringView sql)
+{
+    auto result = execute(executor, sql);
+    if (result.is_error()) {
+        FAIL(String::formatted("'{}' failed: {}", sql, result.error()));
+        return {};
+    }
+    return result.release_value();
+}
+
+void expect_rows(SQL::Executor& executor, StringView sql, Vector<String> const& expected)
+{
+    auto rows = run(executor, sql);
+    EXPECT_EQ(rows.size(), expected.size());
+    for (auto ix = 0u; ix < min(rows.size(), expected.size()); ix++)
+        EXPECT_EQ(rows[ix], expected[ix]);
+}
+
+void create_employees(SQL::Executor& executor)
+{
+    run(executor, "CREATE TABLE Employees ( Name text, Dept text, Salary int );");
+    run(executor, "INSERT INTO Employees VALUES ( 'Alice', 'Eng', 120 ), ( 'Bob', 'Eng', 100 ), ( 'Carol', 'Sales', 90 ), ( 'Dave', 'Sales', 70 ), ( 'Eve', 'Ops', 80 );");
+    EXPECT_EQ(executor.rows_affected(), 5u);
+    run(executor, "CREATE TABLE Departments ( Dept text, Floor int );");
+    run(executor, "INSERT INTO Departments VALUES ( 'Eng', 3 ), ( 'Sales', 1 ), ( 'Ops', 2 );");
+}
+
+}
+
+TEST_CASE(select_without_from)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = SQL::Database::construct(db_name);
+    SQL::Executor executor(database);
+
+    expect_rows(executor, "SELECT 1 + 2 * 3, ( 1 + 2 ) * 3, 10 - 2 - 3, 'a' || 'b';", { "7|9|5|ab" });
+    expect_rows(executor, "SELECT 7 / 2, 7.5 / 2, 7 % 3, 1 / 0, -2 + 5;", { "3|3.75|1|NULL|3" });
+    expect_rows(executor, "SELECT 1 < 2 AND 2 < 3, NULL AND 0, NULL OR 1, NULL = NULL;", { "1|0|1|NULL" });
+    expect_rows(executor, "SELECT UPPER('abc'), LENGTH('hello'), ABS(-4), COALESCE(NULL, 5);", { "ABC|5|4|5" });
+    expect_rows(executor, "SELECT CASE WHEN 1 > 2 THEN 'no' ELSE 'yes' END, 3 BETWEEN 1 AND 5, 'abc' LIKE 'A%', 4 IN ( 1, 2, 3 );", { "yes|1|1|0" });
+}
+
+TEST_CASE(create_table_and_insert)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    {
+        auto database = SQL::Database::construct(db_name);
+        SQL::Executor executor(database);
+        create_employees(executor);
+        EXPECT(execute(executor, "CREATE TABLE Employees ( Name text );").is_error());
+        run(executor, "CREATE TABLE IF NOT EXISTS Employees ( Name text );");
+        EXPECT(execute(executor, "INSERT INTO Employees VALUES ( 'Frank' );").is_error());
+        EXPECT(execute(executor, "INSERT INTO Employees VALUES ( 'Frank', 'Eng', 'lots' );").is_error());
+        EXPECT(execute(executor, "INSERT INTO Nowhere VALUES ( 1 );").is_error());
+    }
+    {
+        auto database = SQL::Database::construct(db_name);
+        SQL::Executor executor(database);
+        expect_rows(executor, "SELECT COUNT(*) FROM Employees;", { "5" });
+    }
+}
+
+TEST_CASE(insert_nulls)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    {
+        auto database = SQL::Database::construct(db_name);
+        SQL::Executor executor(database);
+        create_employees(executor);
+        run(executor, "INSERT INTO Employees VALUES ( 'Frank', NULL, -10 );");
+        run(executor, "INSERT INTO Employees ( Name ) VALUES ( 'Grace' );");
+        database->commit();
+    }
+    {
+        auto database = SQL::Database::construct(db_name);
+        SQL::Executor executor(database);
+        expect_rows(executor, "SELECT Name, Dept, Salary FROM Employees WHERE Salary < 0 OR Dept IS NULL ORDER BY Name;", { "Frank|NULL|-10", "Grace|NULL|NULL" });
+    }
+}
+
+TEST_CASE(select_filter_and_order)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = SQL::Database::construct(db_name);
+    SQL::Executor executor(database);
+    create_employees(executor);
+
+    expect_rows(executor, "SELECT Name FROM Employees WHERE Salary >= 90 ORDER BY Name;", { "Alice", "Bob", "Carol" });
+    expect_rows(executor, "SELECT Name, Salary * 2 AS Twice FROM Employees WHERE Dept = 'Sales' ORDER BY Twice DESC;", { "Carol|180", "Dave|140" });
+    expect_rows(executor, "SELECT * FROM Employees WHERE Name = 'Eve';", { "Eve|Ops|80" });
+    expect_rows(executor, "SELECT Name FROM Employees ORDER BY 1 DESC;", { "Eve", "Dave", "Carol", "Bob", "Alice" });
+    expect_rows(executor, "SELECT DISTINCT Dept FROM Employees ORDER BY Dept;", { "Eng", "Ops", "Sales" });
+    expect_rows(executor, "SELECT Name FROM Employees WHERE Name LIKE '%a%' ORDER BY Name;", { "Alice", "Carol", "Dave" });
+    EXPECT(execute(executor, "SELECT Nonsense FROM Employees;").is_error());
+    EXPECT(execute(executor, "SELECT Name FROM Nowhere;").is_error());
+}
+
+TEST_CASE(select_limit)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = SQL::Database::construct(db_name);
+    SQL::Executor executor(database);
+    create_employees(executor);
+
+    expect_rows(executor, "SELECT Name FROM Employees ORDER BY Salary DESC LIMIT 2;", { "Alice", "Bob" });
+    expect_rows(executor, "SELECT Name FROM Employees ORDER BY Salary DESC LIMIT 2 OFFSET 1;", { "Bob", "Carol" });
+    expect_rows(executor, "SELECT Name FROM Employees ORDER BY Salary LIMIT 0;", {});
+    EXPECT_EQ(run(executor, "SELECT Name FROM Employees LIMIT 3;").size(), 3u);
+}
+
+TEST_CASE(select_aggregates)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = SQL::Database::construct(db_name);
+    SQL::Executor executor(database);
+    create_employees(executor);
+
+    expect_rows(executor, "SELECT COUNT(*), SUM(Salary), MIN(Salary), MAX(Salary), AVG(Salary) FROM Employees;", { "5|460|70|120|92" });
+    expect_rows(executor, "SELECT Dept, COUNT(*), SUM(Salary) FROM Employees GROUP BY Dept ORDER BY Dept;", { "Eng|2|220", "Ops|1|80", "Sales|2|160" });
+    expect_rows(executor, "SELECT Dept, MAX(Salary) - MIN(Salary) AS Spread FROM Employees GROUP BY Dept HAVING COUNT(*) > 1 ORDER BY Spread DESC;", { "Sales|20", "Eng|20" });
+    expect_rows(executor, "SELECT COUNT(DISTINCT Dept) FROM Employees;", { "3" });
+    expect_rows(executor, "SELECT COUNT(*), SUM(Salary) FROM Employees WHERE Salary > 1000;", { "0|NULL" });
+    EXPECT(execute(executor, "SELECT Name FROM Employees WHERE COUNT(*) > 1;").is_error());
+    EXPECT(execute(executor, "SELECT SUM(COUNT(*)) FROM Employees;").is_error());
+}
+
+TEST_CASE(select_join)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = SQL::Database::construct(db_name);
+    SQL::Executor executor(database);
+    create_employees(executor);
+
+    expect_rows(executor, "SELECT E.Name, D.Floor FROM Employees E, Departments D WHERE E.Dept = D.Dept AND D.Floor > 1 ORDER BY E.Name;", { "Alice|3", "Bob|3", "Eve|2" });
+    expect_rows(executor, "SELECT D.Dept, COUNT(*) FROM Employees AS E, Departments AS D WHERE E.Dept = D.Dept GROUP BY D.Dept ORDER BY D.Dept;", { "Eng|2", "Ops|1", "Sales|2" });
+    EXPECT_EQ(run(executor, "SELECT * FROM Employees, Departments;").size(), 15u);
+    EXPECT(execute(executor, "SELECT Dept FROM Employees, Departments;").is_error());
+}
+
+TEST_CASE(hash_join)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = SQL::Database::construct(db_name);
+    SQL::Executor executor(database);
+    create_employees(executor);
+    run(executor, "INSERT INTO Employees VALUES ( 'Frank', NULL, 60 );");
+    run(executor, "INSERT INTO Departments VALUES ( NULL, 4 );");
+
+    expect_rows(executor, "EXPLAIN SELECT E.Name, D.Floor FROM Employees E, Departments D WHERE E.Dept = D.Dept;",
+        { "Projection", "  HashJoin ON E.DEPT = D.DEPT", "    TableScan EMPLOYEES AS E (rows=6, cost=6)", "    TableScan DEPARTMENTS AS D (rows=4, cost=4)" });
+    expect_rows(executor, "SELECT E.Name, D.Floor FROM Employees E, Departments D WHERE E.Dept = D.Dept AND E.Salary > D.Floor * 35 ORDER BY E.Name;", { "Alice|3", "Carol|1", "Dave|1", "Eve|2" });
+    expect_rows(executor, "SELECT E.Name, D.Dept FROM Employees E, Departments D WHERE D.Floor = E.Salary / 40 ORDER BY E.Name;", { "Alice|Eng", "Bob|Ops", "Carol|Ops", "Dave|Sales", "Eve|Ops", "Frank|Sales" });
+}
+
+TEST_CASE(hash_join_spills_to_disk)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = SQL::Database::construct(db_name);
+    SQL::Executor executor(database);
+    run(executor, "CREATE TABLE A ( K int, V int );");
+    run(executor, "CREATE TABLE B ( K int, W int );");
+
+    StringBuilder a_values;
+    a_values.append("INSERT INTO A VALUES ( NULL, 1000 )");
+    for (auto ix = 0; ix < 400; ix++)
+        a_values.appendff(", ( {}, {} )", ix % 100, ix);
+    a_values.append(';');
+    run(executor, a_values.build());
+    StringBuilder b_values;
+    b_values.append("INSERT INTO B VALUES ( NULL, 2000 )");
+    for (auto ix = 0; ix < 200; ix++)
+        b_values.appendff(", ( {}, {} )", ix % 50, ix);
+    b_values.append(';');
+    run(executor, b_values.build());
+
+    int count = 0;
+    int v_sum = 0;
+    int w_sum = 0;
+    for (auto a = 0; a < 400; a++) {
+        for (auto b = 0; b < 200; b++) {
+            if (a % 100 == b % 50) {
+                count++;
+                v_sum += a;
+                w_sum += b;
+            }
+        }
+    }
+    auto expected = String::formatted("{}|{}|{}", count, v_sum, w_sum);
+
+    for (auto budget : { SQL::DEFAULT_JOIN_MEMORY_BUDGET, 64 * KiB, 1 * KiB }) {
+        executor.set_join_memory_budget(budget);
+        expect_rows(executor, "SELECT COUNT(*), SUM(A.V), SUM(B.W) FROM A, B WHERE A.K = B.K;", { expected });
+    }
+}
+
+TEST_CASE(hash_join_partitions)
+{
+    auto make_tuple = [](int key, int value) {
+        SQL::Tuple tuple;
+        tuple.append(SQL::integer_value(key));
+        tuple.append(SQL::integer_value(value));
+        return tuple;
+    };
+    Vector<SQL::Tuple> left;
+    for (auto ix = 0; ix < 1000; ix++)
+        left.append(make_tuple(ix % 250, ix));
+    Vector<SQL::Tuple> right;
+    for (auto ix = 0; ix < 500; ix++)
+        right.append(make_tuple(ix % 250, ix));
+
+    auto join_keys = [](SQL::Operator const& input) {
+        SQL::JoinKeys keys { {}, SQL::Evaluator(input.columns()) };
+        auto key = SQL::AST::create_ast_node<SQL::AST::ColumnNameExpression>(String {}, input.columns()[0].table_name, "K");
+        EXPECT(!keys.evaluator.bind(key).has_value());
+        keys.expressions.append(key);
+        return keys;
+    };
+    auto join = [&](size_t budget) {
+        auto probe = make<SQL::Values>(Vector<SQL::OperatorColumn> { { "L", "K" }, { "L", "V" } }, left);
+        auto build = make<SQL::Values>(Vector<SQL::OperatorColumn> { { "R", "K" }, { "R", "V" } }, right);
+        auto probe_keys = join_keys(*probe);
+        auto build_keys = join_keys(*build);
+        Vector<SQL::OperatorColumn> columns;
+        columns.extend(probe->columns());
+        columns.extend(build->columns());
+        return make<SQL::HashJoin>(move(probe), move(build), move(probe_keys), move(build_keys), NonnullRefPtrVector<SQL::AST::Expression> {}, SQL::Evaluator(move(columns)), budget);
+    };
+    auto checksum = [](SQL::Operator& op) {
+        size_t count = 0;
+        i64 sum = 0;
+        for (auto tuple = op.next(); tuple.has_value(); tuple = op.next()) {
+            EXPECT_EQ((*tuple)[0].to_int().value(), (*tuple)[2].to_int().value());
+            count++;
+            sum += (*tuple)[1].to_int().value() * 1000 + (*tuple)[3].to_int().value();
+        }
+        return String::formatted("{}:{}", count, sum);
+    };
+
+    auto in_memory = join(SQL::DEFAULT_JOIN_MEMORY_BUDGET);
+    auto expected = checksum(*in_memory);
+    EXPECT_EQ(in_memory->partitions(), 0u);
+    EXPECT(expected.starts_with("2000:"));
+
+    // With room for only a few tuples, partitions are split again until the maximum depth is reached:
+    for (auto budget : { 32 * KiB, 2 * KiB }) {
+        auto spilled = join(budget);
+        EXPECT_EQ(checksum(*spilled), expected);
+        EXPECT(spilled->partitions() > 0u);
+        if (budget < 32 * KiB)
+            EXPECT(spilled->partitions() > 16u);
+        spilled->rewind();
+        EXPECT_EQ(checksum(*spilled), expected);
+    }
+}
+
+TEST_CASE(merge_join)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = SQL::Database::construct(db_name);
+    SQL::Executor executor(database);
+    create_employees(executor);
+    run(executor, "INSERT INTO Employees VALUES ( 'Frank', NULL, 60 );");
+    run(executor, "INSERT INTO Departments VALUES ( NULL, 4 ), ( 'Eng', 5 );");
+    run(executor, "CREATE INDEX Employees_Dept ON Employees ( Dept );");
+    run(executor, "CREATE INDEX Departments_Dept ON Departments ( Dept );");
+
+    expect_rows(executor, "EXPLAIN SELECT E.Name, D.Floor FROM Employees E, Departments D WHERE E.Dept = D.Dept;",
+        { "Projection", "  MergeJoin ON E.DEPT = D.DEPT", "    IndexRangeScan EMPLOYEES AS E USING INDEX EMPLOYEES_DEPT (rows=6, cost=7)", "    IndexRangeScan DEPARTMENTS AS D USING INDEX DEPARTMENTS_DEPT (rows=5, cost=6)" });
+    expect_rows(executor, "SELECT D.Dept FROM Employees E, Departments D WHERE E.Dept = D.Dept;", { "Eng", "Eng", "Eng", "Eng", "Ops", "Sales", "Sales" });
+    expect_rows(executor, "SELECT E.Name, D.Floor FROM Employees E, Departments D WHERE E.Dept = D.Dept ORDER BY E.Name, D.Floor;", { "Alice|3", "Alice|5", "Bob|3", "Bob|5", "Carol|1", "Dave|1", "Eve|2" });
+    expect_rows(executor, "SELECT E.Name FROM Employees E, Departments D WHERE D.Dept = E.Dept AND D.Floor > 3 AND E.Salary > 110;", { "Alice" });
+}
+
+TEST_CASE(insert_select_and_common_table_expressions)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = SQL::Database::construct(db_name);
+    SQL::Executor executor(database);
+    create_employees(executor);
+
+    run(executor, "CREATE TABLE Payroll ( Name text, Monthly int );");
+    run(executor, "INSERT INTO Payroll ( Name, Monthly ) SELECT Name, Salary / 10 FROM Employees WHERE Dept = 'Eng';");
+    EXPECT_EQ(executor.rows_affected(), 2u);
+    expect_rows(executor, "SELECT * FROM Payroll ORDER BY Monthly;", { "Bob|10", "Alice|12" });
+
+    expect_rows(executor, "WITH Rich ( Who, Pay ) AS ( SELECT Name, Salary FROM Employees WHERE Salary > 95 ) SELECT Who FROM Rich ORDER BY Pay;", { "Bob", "Alice" });
+}
+
+TEST_CASE(create_index)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    {
+        auto database = SQL::Database::construct(db_name);
+        SQL::Executor executor(database);
+        create_employees(executor);
+
+        run(executor, "CREATE UNIQUE INDEX Employees_Name ON Employees ( Name );");
+        run(executor, "CREATE INDEX Employees_Dept_Salary ON Employees ( Dept, Salary );");
+        run(executor, "CREATE UNIQUE INDEX Departments_Dept ON Departments USING HASH ( Dept );");
+        run(executor, "CREATE INDEX IF NOT EXISTS Employees_Name ON Employees ( Salary );");
+        EXPECT(execute(executor, "CREATE INDEX Employees_Name ON Employees ( Salary );").is_error());
+        EXPECT(execute(executor, "CREATE UNIQUE INDEX Employees_Dept ON Employees ( Dept );").is_error());
+        EXPECT(execute(executor, "CREATE INDEX Departments_Floor ON Departments USING HASH ( Floor );").is_error());
+        EXPECT(execute(executor, "CREATE INDEX Employees_Nonsense ON Employees ( Nonsense );").is_error());
+        EXPECT(execute(executor, "CREATE INDEX Nowhere_Name ON Nowhere ( Name );").is_error());
+
+        EXPECT(execute(executor, "INSERT INTO Employees VALUES ( 'Alice', 'Ops', 60 );").is_error());
+        EXPECT(execute(executor, "INSERT INTO Departments VALUES ( 'Eng', 4 );").is_error());
+        run(executor, "INSERT INTO Employees VALUES ( 'Frank', 'Eng', 110 );");
+        expect_rows(executor, "SELECT Name FROM Employees WHERE Name = 'Frank';", { "Frank" });
+    }
+    {
+        auto database = SQL::Database::construct(db_name);
+        SQL::Executor executor(database);
+        expect_rows(executor, "SELECT COUNT(*) FROM Employees;", { "6" });
+        EXPECT(execute(executor, "INSERT INTO Employees VALUES ( 'Bob', 'Ops', 60 );").is_error());
+        expect_rows(executor, "SELECT Name FROM Employees WHERE Dept = 'Eng' ORDER BY Name;", { "Alice", "Bob", "Frank" });
+    }
+}
+
+TEST_CASE(select_using_index)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = SQL::Database::construct(db_name);
+    SQL::Executor executor(database);
+    create_employees(executor);
+    run(executor, "CREATE UNIQUE INDEX Employees_Name ON Employees ( Name );");
+    run(executor, "CREATE INDEX Employees_Dept_Salary ON Employees ( Dept, Salary );");
+    run(executor, "CREATE UNIQUE INDEX Departments_Dept ON Departments USING HASH ( Dept );");
+
+    expect_rows(executor, "SELECT * FROM Employees WHERE Name = 'Eve';", { "Eve|Ops|80" });
+    expect_rows(executor, "SELECT * FROM Employees WHERE Name = 'Nobody';", {});
+    expect_rows(executor, "SELECT Name FROM Employees WHERE 'Carol' < Name;", { "Dave", "Eve" });
+    expect_rows(executor, "SELECT Name FROM Employees WHERE Name >= 'Bob' AND Name < 'Dave';", { "Bob", "Carol" });
+    expect_rows(executor, "SELECT Name FROM Employees WHERE Name BETWEEN 'B' AND 'D';", { "Bob", "Carol" });
+    expect_rows(executor, "SELECT Name FROM Employees WHERE Dept = 'Eng';", { "Bob", "Alice" });
+    expect_rows(executor, "SELECT Name FROM Employees WHERE Dept = 'Sales' AND Salary > 70;", { "Carol" });
+    expect_rows(executor, "SELECT Name FROM Employees WHERE Dept = 'Sales' AND Salary >= 70 AND Salary <= 90;", { "Dave", "Carol" });
+    expect_rows(executor, "SELECT Name FROM Employees WHERE Dept = 'Sales' AND Salary > 90;", {});
+    expect_rows(executor, "SELECT Floor FROM Departments WHERE Dept = 'Ops';", { "2" });
+    expect_rows(executor, "SELECT E.Name, D.Floor FROM Employees E, Departments D WHERE E.Dept = D.Dept AND E.Name = 'Carol';", { "Carol|1" });
+
+    run(executor, "INSERT INTO Employees SELECT Name || '2', Dept, Salary + 1 FROM Employees WHERE Dept = 'Eng';");
+    EXPECT_EQ(executor.rows_affected(), 2u);
+    expect_rows(executor, "SELECT Name FROM Employees WHERE Dept = 'Eng';", { "Bob", "Bob2", "Alice", "Alice2" });
+}
+
+TEST_CASE(explain)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = SQL::Database::construct(db_name);
+    SQL::Executor executor(database);
+    create_employees(executor);
+    run(executor, "CREATE UNIQUE INDEX Employees_Name ON Employees ( Name );");
+    run(executor, "CREATE INDEX Employees_Dept_Salary ON Employees ( Dept, Salary );");
+
+    expect_rows(executor, "EXPLAIN SELECT Name FROM Employees WHERE Name = 'Eve';",
+        { "Projection", "  Filter", "    IndexLookup EMPLOYEES USING INDEX EMPLOYEES_NAME (NAME = 'Eve') (rows=1, cost=2)" });
+    expect_rows(executor, "EXPLAIN SELECT Name FROM Employees E WHERE Dept = 'Eng' AND Salary > 100;",
+        { "Projection", "  Filter", "    IndexRangeScan EMPLOYEES AS E USING INDEX EMPLOYEES_DEPT_SALARY (DEPT = 'Eng' AND SALARY > 100) (rows=1, cost=2)" });
+    expect_rows(executor, "EXPLAIN QUERY PLAN SELECT Name FROM Employees WHERE Salary > 100 LIMIT 1;",
+        { "Limit LIMIT 1", "  Projection", "    Filter", "      TableScan EMPLOYEES (rows=5, cost=5)" });
+    EXPECT(execute(executor, "EXPLAIN INSERT INTO Employees VALUES ( 'Zed', 'Ops', 1 );").is_error());
+}
+
+TEST_CASE(delete_rows)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    {
+        auto database = SQL::Database::construct(db_name);
+        SQL::Executor executor(database);
+        create_employees(executor);
+        run(executor, "CREATE UNIQUE INDEX Employees_Name ON Employees ( Name );");
+        run(executor, "CREATE INDEX Employees_Dept_Salary ON Employees ( Dept, Salary );");
+        run(executor, "CREATE UNIQUE INDEX Departments_Dept ON Departments USING HASH ( Dept );");
+
+        run(executor, "DELETE FROM Employees WHERE Dept = 'Sales' OR Name = 'Alice';");
+        EXPECT_EQ(executor.rows_affected(), 3u);
+        run(executor, "DELETE FROM Employees WHERE Name = 'Nobody';");
+        EXPECT_EQ(executor.rows_affected(), 0u);
+        run(executor, "DELETE FROM Departments WHERE Dept = 'Ops';");
+        EXPECT(execute(executor, "DELETE FROM Nowhere;").is_error());
+        EXPECT(execute(executor, "DELETE FROM Employees WHERE Nonsense = 1;").is_error());
+
+        // The deleted keys can be inserted again, and the freed blocks are reused:
+        auto free_blocks = database->heap().free_blocks();
+        EXPECT(free_blocks >= 4u);
+        run(executor, "INSERT INTO Employees VALUES ( 'Alice', 'Ops', 60 );");
+        run(executor, "INSERT INTO Departments VALUES ( 'Ops', 5 );");
+        EXPECT(database->heap().free_blocks() < free_blocks);
+    }
+    {
+        auto database = SQL::Database::construct(db_name);
+        SQL::Executor executor(database);
+        expect_rows(executor, "SELECT Name, Dept FROM Employees ORDER BY Name;", { "Alice|Ops", "Bob|Eng", "Eve|Ops" });
+        expect_rows(executor, "SELECT Name FROM Employees WHERE Name = 'Carol';", {});
+        expect_rows(executor, "SELECT Name FROM Employees WHERE Dept = 'Ops' ORDER BY Name;", { "Alice", "Eve" });
+        expect_rows(executor, "SELECT Floor FROM Departments WHERE Dept = 'Ops';", { "5" });
+        expect_rows(executor, "SELECT COUNT(*) FROM Employees;", { "3" });
+
+        run(executor, "DELETE FROM Employees;");
+        EXPECT_EQ(executor.rows_affected(), 3u);
+        expect_rows(executor, "SELECT COUNT(*) FROM Employees;", { "0" });
+        expect_rows(executor, "SELECT Name FROM Employees WHERE Name = 'Bob';", {});
+    }
+}
+
+TEST_CASE(vacuum)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto file_size = []() {
+        struct stat stat_buffer;
+        EXPECT_EQ(stat(db_name, &stat_buffer), 0);
+        return stat_buffer.st_size;
+    };
+
+    off_t size_before_vacuum;
+    {
+        auto database = SQL::Database::construct(db_name, 8192);
+        SQL::Executor executor(database);
+        create_employees(executor);
+        run(executor, "CREATE UNIQUE INDEX Employees_Name ON Employees ( Name );");
+        run(executor, "CREATE INDEX Employees_Dept_Salary ON Employees ( Dept, Salary );");
+        for (auto ix = 0; ix < 7; ix++)
+            run(executor, String::formatted("INSERT INTO Employees SELECT Name || '{}', Dept, Salary + 1 FROM Employees;", ix));
+        expect_rows(executor, "SELECT COUNT(*) FROM Employees;", { "640" });
+        run(executor, "DELETE FROM Employees WHERE Salary > 75;");
+        EXPECT(execute(executor, "VACUUM Nowhere;").is_error());
+    }
+    size_before_vacuum = file_size();
+    {
+        auto database = SQL::Database::construct(db_name);
+        SQL::Executor executor(database);
+        EXPECT_EQ(database->block_size(), 8192u);
+        run(executor, "VACUUM;");
+        EXPECT_EQ(database->heap().free_blocks(), 0u);
+        EXPECT_EQ(database->block_size(), 8192u);
+        expect_rows(executor, "SELECT Name, Salary FROM Employees WHERE Name = 'Dave';", { "Dave|70" });
+        expect_rows(executor, "SELECT COUNT(*) FROM Employees WHERE Dept = 'Sales' AND Salary <= 75;", { "120" });
+        run(executor, "INSERT INTO Employees VALUES ( 'Zed', 'Ops', 1 );");
+    }
+    EXPECT(file_size() < size_before_vacuum);
+    {
+        auto database = SQL::Database::construct(db_name);
+        SQL::Executor executor(database);
+        expect_rows(executor, "SELECT COUNT(*) FROM Employees;", { "121" });
+        expect_rows(executor, "SELECT Name FROM Employees WHERE Salary < 70 ORDER BY Name;", { "Zed" });
+        EXPECT(execute(executor, "INSERT INTO Employees VALUES ( 'Dave', 'Ops', 1 );").is_error());
+    }
+}
+
+
+TEST_CASE(select_from_snapshot)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = SQL::Database::construct(db_name);
+    SQL::Executor executor(database);
+    create_employees(executor);
+    run(executor, "CREATE INDEX Employees_Salary ON Employees ( Salary );");
+
+    auto snapshot = database->snapshot();
+    SQL::Executor snapshot_executor(snapshot);
+    run(executor, "INSERT INTO Employees VALUES ( 'Frank', 'Ops', 60 );");
+    run(executor, "DELETE FROM Employees WHERE Name = 'Alice';");
+    expect_rows(snapshot_executor, "SELECT Name FROM Employees WHERE Salary > 95 ORDER BY Name;", { "Alice", "Bob" });
+    expect_rows(snapshot_executor, "SELECT COUNT(*) FROM Employees, Departments WHERE Employees.Dept = Departments.Dept;", { "5" });
+    expect_rows(executor, "SELECT COUNT(*) FROM Employees;", { "5" });
+    expect_rows(executor, "SELECT Name FROM Employees WHERE Salary < 70;", { "Frank" });
+
+    EXPECT(execute(snapshot_executor, "INSERT INTO Employees VALUES ( 'Gina', 'Eng', 1 );").is_error());
+    EXPECT(execute(executor, "VACUUM;").is_error());
+}
@@ -296,6 +296,55 @@ TEST_CASE(drop_table)
     validate("DROP TABLE IF EXISTS test;", {}, "TEST", false);
 }
 
+TEST_CASE(create_index)
+{
+    EXPECT(parse("CREATE INDEX").is_error());
+    EXPECT(parse("CREATE INDEX test").is_error());
+    EXPECT(parse("CREATE INDEX test ON").is_error());
+    EXPECT(parse("CREATE INDEX test ON table_name;").is_error());
+    EXPECT(parse("CREATE INDEX test ON table_name ();").is_error());
+    EXPECT(parse("CREATE INDEX test ON table_name ( column1 )").is_error());
+    EXPECT(parse("CREATE UNIQUE test ON table_name ( column1 );").is_error());
+    EXPECT(parse("CREATE INDEX IF test ON table_name ( column1 );").is_error());
+    EXPECT(parse("CREATE INDEX test ON table_name USING ( column1 );").is_error());
+    EXPECT(parse("CREATE INDEX test ON table_name USING GIST ( column1 );").is_error());
+
+    struct IndexedColumn {
+        StringView name;
+        SQL::AST::Order order { SQL::AST::Order::Ascending };
+    };
+
+    auto validate = [](StringView sql, StringView expected_schema, StringView expected_index, StringView expected_table, Vector<IndexedColumn> expected_columns, SQL::AST::IndexType expected_index_type = SQL::AST::IndexType::BTree, bool expected_is_unique = false, bool expected_is_error_if_index_exists = true) {
+        auto result = parse(sql);
+        EXPECT(!result.is_error());
+
+        auto statement = result.release_value();
+        EXPECT(is<SQL::AST::CreateIndex>(*statement));
+
+        const auto& index = static_cast<const SQL::AST::CreateIndex&>(*statement);
+        EXPECT_EQ(index.schema_name(), expected_schema);
+        EXPECT_EQ(index.index_name(), expected_index);
+        EXPECT_EQ(index.table_name(), expected_table);
+        EXPECT_EQ(index.index_type(), expected_index_type);
+        EXPECT_EQ(index.is_unique(), expected_is_unique);
+        EXPECT_EQ(index.is_error_if_index_exists(), expected_is_error_if_index_exists);
+
+        const auto& columns = index.indexed_columns();
+        EXPECT_EQ(columns.size(), expected_columns.size());
+        for (size_t i = 0; i < min(columns.size(), expected_columns.size()); ++i) {
+            EXPECT_EQ(columns[i].column_name(), expected_columns[i].name);
+            EXPECT_EQ(columns[i].order(), expected_columns[i].order);
+        }
+    };
+
+    validate("CREATE INDEX test ON table_name ( column1 );", {}, "TEST", "TABLE_NAME", { { "COLUMN1" } });
+    validate("CREATE INDEX schema_name.test ON table_name ( column1, column2 DESC );", "SCHEMA_NAME", "TEST", "TABLE_NAME", { { "COLUMN1" }, { "COLUMN2", SQL::AST::Order::Descending } });
+    validate("CREATE UNIQUE INDEX test ON table_name ( column1 ASC );", {}, "TEST", "TABLE_NAME", { { "COLUMN1" } }, SQL::AST::IndexType::BTree, true);
+    validate("CREATE INDEX IF NOT EXISTS test ON table_name ( column1 );", {}, "TEST", "TABLE_NAME", { { "COLUMN1" } }, SQL::AST::IndexType::BTree, false, false);
+    validate("CREATE INDEX test ON table_name USING BTREE ( column1 );", {}, "TEST", "TABLE_NAME", { { "COLUMN1" } });
+    validate("CREATE UNIQUE INDEX test ON table_name USING HASH ( column1 );", {}, "TEST", "TABLE_NAME", { { "COLUMN1" } }, SQL::AST::IndexType::Hash, true);
+}
+
 TEST_CASE(insert)
 {
     EXPECT(parse("INSERT").is_error());
@@ -744,6 +793,53 @@ TEST_CASE(common_table_expression)
     validate("WITH RECURSIVE table_name AS (SELECT * FROM table_name) DELETE FROM table_name;", { true, { { "TABLE_NAME", {} } } });
 }
 
+TEST_CASE(explain)
+{
+    EXPECT(parse("EXPLAIN").is_error());
+    EXPECT(parse("EXPLAIN;").is_error());
+    EXPECT(parse("EXPLAIN QUERY SELECT * FROM table_name;").is_error());
+    EXPECT(parse("EXPLAIN EXPLAIN SELECT * FROM table_name;").is_error());
+    EXPECT(parse("EXPLAIN SELECT * FROM table_name").is_error());
+
+    auto validate = [](StringView sql, auto is_expected_statement) {
+        auto result = parse(sql);
+        EXPECT(!result.is_error());
+
+        auto statement = result.release_value();
+        EXPECT(is<SQL::AST::Explain>(*statement));
+
+        const auto& explain = static_cast<const SQL::AST::Explain&>(*statement);
+        EXPECT(is_expected_statement(*explain.statement()));
+    };
+
+    auto is_select = [](auto const& statement) { return is<SQL::AST::Select>(statement); };
+    validate("EXPLAIN SELECT * FROM table_name;", is_select);
+    validate("EXPLAIN QUERY PLAN SELECT * FROM table_name WHERE column1 = 1;", is_select);
+    validate("EXPLAIN WITH table_name AS (SELECT * FROM table_name) SELECT * FROM table_name;", is_select);
+    validate("EXPLAIN INSERT INTO table_name VALUES (1);", [](auto const& statement) { return is<SQL::AST::Insert>(statement); });
+}
+
+TEST_CASE(vacuum)
+{
+    EXPECT(parse("VACUUM").is_error());
+    EXPECT(parse("VACUUM schema_name table_name;").is_error());
+    EXPECT(parse("VACUUM INTO 'file.db';").is_error());
+
+    auto validate = [](StringView sql, StringView expected_schema) {
+        auto result = parse(sql);
+        EXPECT(!result.is_error());
+
+        auto statement = result.release_value();
+        EXPECT(is<SQL::AST::Vacuum>(*statement));
+
+        const auto& vacuum = static_cast<const SQL::AST::Vacuum&>(*statement);
+        EXPECT_EQ(vacuum.schema_name(), expected_schema);
+    };
+
+    validate("VACUUM;", {});
+    validate("VACUUM schema_name;", "SCHEMA_NAME");
+}
+
 TEST_CASE(nested_subquery_limit)
 {
     auto subquery = String::formatted("{:(^{}}table_name{:)^{}}", "", SQL::AST::Limits::maximum_subquery_depth - 1, "", SQL::AST::Limits::maximum_subquery_depth - 1);
@@ -167,6 +167,48 @@ TEST_CASE(serialize_tuple)
     VERIFY(tuple2[1] == 42);
 }
 
+TEST_CASE(serialize_tuple_with_nulls)
+{
+    SQL::TupleDescriptor descriptor;
+    descriptor.append({ "col1", SQL::SQLType::Text, SQL::AST::Order::Ascending });
+    descriptor.append({ "col2", SQL::SQLType::Integer, SQL::AST::Order::Ascending });
+    descriptor.append({ "col3", SQL::SQLType::Integer, SQL::AST::Order::Ascending });
+    descriptor.append({ "col4", SQL::SQLType::Float, SQL::AST::Order::Ascending });
+    SQL::Tuple tuple(descriptor, 70000);
+
+    tuple["col2"] = -3;
+    tuple["col3"] = NumericLimits<int>::min();
+
+    auto buffer = ByteBuffer();
+    tuple.serialize(buffer);
+    EXPECT(buffer.size() <= descriptor.data_length());
+
+    size_t offset = 0;
+    SQL::Tuple tuple2(descriptor, buffer, offset);
+    EXPECT_EQ(offset, buffer.size());
+    EXPECT(tuple2[0].is_null());
+    EXPECT_EQ((int)tuple2[1], -3);
+    EXPECT_EQ((int)tuple2[2], NumericLimits<int>::min());
+    EXPECT(tuple2[3].is_null());
+    EXPECT_EQ(tuple2.pointer(), 70000u);
+}
+
+TEST_CASE(serialized_tuple_is_compact)
+{
+    SQL::TupleDescriptor descriptor;
+    descriptor.append({ "col1", SQL::SQLType::Text, SQL::AST::Order::Ascending });
+    descriptor.append({ "col2", SQL::SQLType::Integer, SQL::AST::Order::Ascending });
+    SQL::Tuple tuple(descriptor, 1);
+
+    tuple["col1"] = "Test";
+    tuple["col2"] = 42;
+
+    // A NULL bitmap byte, a length byte and the text, a byte for the integer, and a byte for the pointer:
+    auto buffer = ByteBuffer();
+    tuple.serialize(buffer);
+    EXPECT_EQ(buffer.size(), 8u);
+}
+
 TEST_CASE(copy_tuple)
 {
     SQL::TupleDescriptor descriptor;
@@ -65,6 +65,9 @@ public:
 private:
     JS_DECLARE_NATIVE_FUNCTION(get_export);
     JS_DECLARE_NATIVE_FUNCTION(wasm_invoke);
+    JS_DECLARE_NATIVE_FUNCTION(wasm_invoke_interpreted);
+    JS_DECLARE_NATIVE_FUNCTION(wasm_invoke_compiled);
+    static JS::Value invoke(JS::VM&, JS::GlobalObject&, Wasm::BytecodeInterpreter&, bool must_be_compiled = false);
 
     static HashMap<Wasm::Linker::Name, Wasm::ExternValue> const& spec_test_namespace()
     {
@@ -159,6 +162,8 @@ void WebAssemblyModule::initialize(JS::GlobalObject& global_object)
     Base::initialize(global_object);
     define_native_function("getExport", get_export, 1, JS::default_attributes);
     define_native_function("invoke", wasm_invoke, 1, JS::default_attributes);
+    define_native_function("invokeInterpreted", wasm_invoke_interpreted, 1, JS::default_attributes);
+    define_native_function("invokeCompiled", wasm_invoke_compiled, 1, JS::default_attributes);
 }
 
 JS_DEFINE_NATIVE_FUNCTION(WebAssemblyModule::get_export)
@@ -197,7 +202,30 @@ JS_DEFINE_NATIVE_FUNCTION(WebAssemblyModule::get_export)
     return {};
 }
 
+// invoke() compiles functions once they have run as often as the WASM_JIT_THRESHOLD environment variable says, like
+// everything else does. The other two make sure a function runs in the interpreter or as machine code.
 JS_DEFINE_NATIVE_FUNCTION(WebAssemblyModule::wasm_invoke)
+{
+    Wasm::BytecodeInterpreter interpreter;
+    return invoke(vm, global_object, interpreter);
+}
+
+JS_DEFINE_NATIVE_FUNCTION(WebAssemblyModule::wasm_invoke_interpreted)
+{
+    Wasm::BytecodeInterpreter interpreter;
+    interpreter.set_jit_threshold({});
+    return invoke(vm, global_object, interpreter);
+}
+
+// Where there's no JIT, this runs the function in the interpreter too.
+JS_DEFINE_NATIVE_FUNCTION(WebAssemblyModule::wasm_invoke_compiled)
+{
+    Wasm::BytecodeInterpreter interpreter;
+    interpreter.set_jit_threshold(0);
+    return invoke(vm, global_object, interpreter, Wasm::JIT::is_supported());
+}
+
+JS::Value WebAssemblyModule::invoke(JS::VM& vm, JS::GlobalObject& global_object, Wasm::BytecodeInterpreter& interpreter, bool must_be_compiled)
 {
     auto address = static_cast<unsigned long>(vm.argument(0).to_double(global_object));
     if (vm.exception())
@@ -252,7 +280,13 @@ JS_DEFINE_NATIVE_FUNCTION(WebAssemblyModule::wasm_invoke)
         }
     }
 
-    auto result = WebAssemblyModule::machine().invoke(function_address, arguments);
+    auto result = WebAssemblyModule::machine().invoke(interpreter, function_address, arguments);
+    if (auto* function = function_instance->get_pointer<Wasm::WasmFunction>(); must_be_compiled && function) {
+        if (!function->lowered() || !function->lowered()->jit_state().compiled_function) {
+            vm.throw_exception<JS::TypeError>(global_object, "Function could not be compiled");
+            return {};
+        }
+    }
     if (result.is_trap()) {
         vm.throw_exception<JS::TypeError>(global_object, String::formatted("Execution trapped: {}", result.trap().reason));
         return {};
@@ -28,6 +28,9 @@
 #include <LibGUI/ToolbarContainer.h>
 #include <LibGUI/Widget.h>
 #include <LibJS/Interpreter.h>
+#include <LibJS/Runtime/SamplingProfiler.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibWeb/Bindings/MainThreadVM.h>
 #include <LibWeb/Dump.h>
 #include <LibWeb/InProcessWebView.h>
 #include <LibWeb/Layout/InitialContainingBlockBox.h>
@@ -414,6 +417,26 @@ void BrowserWindow::build_menus()
             tab.m_web_content_view->debug_request("clear-cache");
         }
     }));
+    auto js_profiler_action = GUI::Action::create_checkable(
+        "JavaScript &Profiler", [this](auto& action) {
+            auto& tab = active_tab();
+            if (tab.m_type == Tab::Type::InProcessWebView) {
+                auto& vm = Web::Bindings::main_thread_vm();
+                if (action.is_checked()) {
+                    if (!vm.sampling_profiler())
+                        tab.m_js_profiler = make<JS::SamplingProfiler>(vm);
+                } else if (tab.m_js_profiler) {
+                    tab.m_js_profiler->stop();
+                    tab.save_js_profile(tab.m_js_profiler->to_chrome_trace());
+                    tab.m_js_profiler = nullptr;
+                }
+            } else {
+                tab.m_web_content_view->debug_request(action.is_checked() ? "start-js-profiler" : "stop-js-profiler");
+            }
+        },
+        this);
+    js_profiler_action->set_checked(false);
+    debug_menu.add_action(js_profiler_action);
 
     m_user_agent_spoof_actions.set_exclusive(true);
     auto& spoof_user_agent_menu = debug_menu.add_submenu("Spoof &User Agent");
@@ -15,18 +15,22 @@
 #include <AK/StringBuilder.h>
 #include <AK/URL.h>
 #include <Applications/Browser/TabGML.h>
+#include <LibCore/File.h>
+#include <LibCore/StandardPaths.h>
 #include <LibGUI/Action.h>
 #include <LibGUI/Application.h>
 #include <LibGUI/BoxLayout.h>
 #include <LibGUI/Button.h>
 #include <LibGUI/Clipboard.h>
 #include <LibGUI/Menu.h>
+#include <LibGUI/MessageBox.h>
 #include <LibGUI/Statusbar.h>
 #include <LibGUI/TextBox.h>
 #include <LibGUI/Toolbar.h>
 #include <LibGUI/ToolbarContainer.h>
 #include <LibGUI/Window.h>
 #include <LibJS/Interpreter.h>
+#include <LibJS/Runtime/SamplingProfiler.h>
 #include <LibWeb/HTML/SyntaxHighlighter/SyntaxHighlighter.h>
 #include <LibWeb/InProcessWebView.h>
 #include <LibWeb/Layout/BlockBox.h>
@@ -93,6 +97,17 @@ void Tab::view_dom_tree(const String& dom_tree)
     window->move_to_front();
 }
 
+void Tab::save_js_profile(const String& profile)
+{
+    auto path = String::formatted("{}/js-profile.json", Core::StandardPaths::downloads_directory());
+    auto file_or_error = Core::File::open(path, Core::OpenMode::WriteOnly);
+    if (file_or_error.is_error() || !file_or_error.value()->write(profile)) {
+        GUI::MessageBox::show(&window(), String::formatted("Cannot write the JavaScript profile to {}", path), "Error", GUI::MessageBox::Type::Error);
+        return;
+    }
+    GUI::MessageBox::show(&window(), String::formatted("Saved the JavaScript profile to {}.\nIt can be loaded into chrome://tracing.", path), "JavaScript Profiler", GUI::MessageBox::Type::Information);
+}
+
 Tab::Tab(BrowserWindow& window, Type type)
     : m_type(type)
 {
@@ -283,6 +298,10 @@ Tab::Tab(BrowserWindow& window, Type type)
         view_dom_tree(dom_tree);
     };
 
+    hooks().on_get_js_profile = [this](auto& profile) {
+        save_js_profile(profile);
+    };
+
     hooks().on_js_console_output = [this](auto& method, auto& line) {
         if (m_console_window) {
             auto* console_widget = static_cast<ConsoleWidget*>(m_console_window->main_widget());
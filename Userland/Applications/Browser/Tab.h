@@ -12,6 +12,7 @@
 #include <LibGUI/Widget.h>
 #include <LibGfx/ShareableBitmap.h>
 #include <LibHTTP/HttpJob.h>
+#include <LibJS/Forward.h>
 #include <LibWeb/Forward.h>
 
 namespace Web {
@@ -80,6 +81,7 @@ private:
     void start_download(const URL& url);
     void view_source(const URL& url, const String& source);
     void view_dom_tree(const String&);
+    void save_js_profile(const String&);
 
     Type m_type;
 
@@ -92,6 +94,7 @@ private:
     RefPtr<GUI::Button> m_bookmark_button;
     RefPtr<GUI::Window> m_dom_inspector_window;
     RefPtr<GUI::Window> m_console_window;
+    OwnPtr<JS::SamplingProfiler> m_js_profiler;
     RefPtr<GUI::Statusbar> m_statusbar;
     RefPtr<GUI::ToolbarContainer> m_toolbar_container;
 
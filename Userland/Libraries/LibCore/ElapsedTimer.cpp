@@ -34,4 +34,12 @@ int ElapsedTimer::elapsed() const
     return diff.tv_sec * 1000 + diff.tv_usec / 1000;
 }
 
+Time ElapsedTimer::elapsed_time() const
+{
+    VERIFY(is_valid());
+    timespec now_spec;
+    clock_gettime(m_precise ? CLOCK_MONOTONIC : CLOCK_MONOTONIC_COARSE, &now_spec);
+    return Time::from_timespec(now_spec) - Time::from_timeval(m_origin_time);
+}
+
 }
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Time.h>
 #include <sys/time.h>
 
 namespace Core {
@@ -20,6 +21,7 @@ public:
     bool is_valid() const { return m_valid; }
     void start();
     int elapsed() const;
+    Time elapsed_time() const;
 
     const struct timeval& origin_time() const { return m_origin_time; }
 
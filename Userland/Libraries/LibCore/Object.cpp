@@ -10,10 +10,15 @@
 #include <LibCore/Event.h>
 #include <LibCore/EventLoop.h>
 #include <LibCore/Object.h>
+#include <pthread.h>
 #include <stdio.h>
 
 namespace Core {
 
+// Objects can be created and destroyed on threads other than the one running
+// the event loop, for instance by the readers of an SQL database snapshot.
+static pthread_mutex_t s_all_objects_lock = PTHREAD_MUTEX_INITIALIZER;
+
 IntrusiveList<Object, RawPtr<Object>, &Object::m_all_objects_list_node>& Object::all_objects()
 {
     static IntrusiveList<Object, RawPtr<Object>, &Object::m_all_objects_list_node> objects;
@@ -23,7 +28,9 @@ IntrusiveList<Object, RawPtr<Object>, &Object::m_all_objects_list_node>& Object:
 Object::Object(Object* parent)
     : m_parent(parent)
 {
+    pthread_mutex_lock(&s_all_objects_lock);
     all_objects().append(*this);
+    pthread_mutex_unlock(&s_all_objects_lock);
     if (m_parent)
         m_parent->add_child(*this);
 
@@ -49,7 +56,9 @@ Object::~Object()
     for (auto& child : children)
         child.m_parent = nullptr;
 
+    pthread_mutex_lock(&s_all_objects_lock);
     all_objects().remove(*this);
+    pthread_mutex_unlock(&s_all_objects_lock);
     stop_timer();
     if (m_parent)
         m_parent->remove_child(*this);
@@ -14,6 +14,7 @@
 #include <LibCrypto/BigInt/SignedBigInteger.h>
 #include <LibJS/AST.h>
 #include <LibJS/Interpreter.h>
+#include <LibJS/Parser.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/Accessor.h>
 #include <LibJS/Runtime/Array.h>
@@ -29,6 +30,7 @@
 #include <LibJS/Runtime/PrimitiveString.h>
 #include <LibJS/Runtime/Reference.h>
 #include <LibJS/Runtime/RegExpObject.h>
+#include <LibJS/Runtime/SamplingProfiler.h>
 #include <LibJS/Runtime/Shape.h>
 #include <typeinfo>
 
@@ -45,6 +47,8 @@ public:
     {
         m_interpreter.vm().running_execution_context().current_node = &node;
         m_interpreter.push_ast_node(m_chain_node);
+        if (auto* profiler = m_interpreter.vm().sampling_profiler(); profiler && profiler->has_pending_sample()) [[unlikely]]
+            profiler->take_sample(&node.source_range());
     }
 
     ~InterpreterNodeScope()
@@ -93,6 +97,32 @@ Value Program::execute(Interpreter& interpreter, GlobalObject& global_object) co
     return interpreter.execute_statement(global_object, *this, ScopeType::Block);
 }
 
+RefPtr<Statement> LazyFunctionBody::parse() const
+{
+    if (m_body || !m_error.is_null())
+        return m_body;
+
+    auto parser = Parser(Lexer(m_source, m_filename, m_start.line, m_start.column - 1, m_start.offset));
+    auto body = parser.parse_lazy_function_body(*this);
+    if (parser.has_errors()) {
+        m_error = parser.errors().first().to_string();
+        return {};
+    }
+    m_body = move(body);
+    return m_body;
+}
+
+Statement const& FunctionNode::body() const
+{
+    if (m_lazy_body) {
+        auto body = m_lazy_body->parse();
+        // Whoever needs the body right away has to be ready for syntax errors in it, see OrdinaryFunctionObject.
+        VERIFY(body);
+        return *body;
+    }
+    return *m_body;
+}
+
 Value FunctionDeclaration::execute(Interpreter& interpreter, GlobalObject&) const
 {
     InterpreterNodeScope node_scope { interpreter, *this };
@@ -102,7 +132,7 @@ Value FunctionDeclaration::execute(Interpreter& interpreter, GlobalObject&) cons
 Value FunctionExpression::execute(Interpreter& interpreter, GlobalObject& global_object) const
 {
     InterpreterNodeScope node_scope { interpreter, *this };
-    return OrdinaryFunctionObject::create(global_object, name(), body(), parameters(), function_length(), interpreter.lexical_environment(), kind(), is_strict_mode() || interpreter.vm().in_strict_mode(), is_arrow_function());
+    return OrdinaryFunctionObject::create(global_object, *this, interpreter.lexical_environment(), is_strict_mode() || interpreter.vm().in_strict_mode());
 }
 
 Value ExpressionStatement::execute(Interpreter& interpreter, GlobalObject& global_object) const
@@ -1312,6 +1342,11 @@ void FunctionNode::dump(int indent, String const& class_name) const
     }
     print_indent(indent + 1);
     outln("(Body)");
+    if (m_lazy_body) {
+        print_indent(indent + 2);
+        outln("(Not parsed yet)");
+        return;
+    }
     body().dump(indent + 2);
 }
 
@@ -2047,19 +2082,36 @@ Value TemplateLiteral::execute(Interpreter& interpreter, GlobalObject& global_ob
 {
     InterpreterNodeScope node_scope { interpreter, *this };
 
+    auto& vm = interpreter.vm();
+
+    // Short pieces are copied into a builder, but long ones are linked into a rope instead, so that a
+    // template literal that embeds the string it's building up doesn't copy all of it every time.
+    PrimitiveString* result = &vm.empty_string();
     StringBuilder string_builder;
+    auto append_builder_to_result = [&] {
+        if (string_builder.is_empty())
+            return;
+        result = js_rope_string(vm, *result, *js_string(vm, string_builder.build()));
+        string_builder.clear();
+    };
 
     for (auto& expression : m_expressions) {
         auto expr = expression.execute(interpreter, global_object);
         if (interpreter.exception())
             return {};
-        auto string = expr.to_string(global_object);
+        auto* string = expr.to_primitive_string(global_object);
         if (interpreter.exception())
             return {};
-        string_builder.append(string);
+        if (string->length() < PrimitiveString::min_rope_length) {
+            string_builder.append(string->string());
+            continue;
+        }
+        append_builder_to_result();
+        result = js_rope_string(vm, *result, *string);
     }
+    append_builder_to_result();
 
-    return js_string(interpreter.heap(), string_builder.build());
+    return result;
 }
 
 void TaggedTemplateLiteral::dump(int indent) const
@@ -243,6 +243,40 @@ struct BindingPattern : RefCounted<BindingPattern> {
     Kind kind { Kind::Object };
 };
 
+// The body of a function that the parser only skimmed over, see Parser::set_parses_functions_lazily().
+// It keeps the source text alive, and is parsed for real when the function is first called.
+class LazyFunctionBody : public RefCounted<LazyFunctionBody> {
+public:
+    LazyFunctionBody(String source, String filename, Position start, bool is_in_strict_mode_context, bool is_in_generator_function_context)
+        : m_source(move(source))
+        , m_filename(move(filename))
+        , m_start(start)
+        , m_is_in_strict_mode_context(is_in_strict_mode_context)
+        , m_is_in_generator_function_context(is_in_generator_function_context)
+    {
+    }
+
+    // Returns null if the body has a syntax error, which is then described by error().
+    RefPtr<Statement> parse() const;
+    String const& error() const { return m_error; }
+
+    String const& source() const { return m_source; }
+    String const& filename() const { return m_filename; }
+    Position const& start() const { return m_start; }
+    bool is_in_strict_mode_context() const { return m_is_in_strict_mode_context; }
+    bool is_in_generator_function_context() const { return m_is_in_generator_function_context; }
+
+private:
+    String m_source;
+    String m_filename;
+    Position m_start;
+    bool m_is_in_strict_mode_context { false };
+    bool m_is_in_generator_function_context { false };
+
+    mutable RefPtr<Statement> m_body;
+    mutable String m_error;
+};
+
 class FunctionNode {
 public:
     struct Parameter {
@@ -251,16 +285,25 @@ public:
         bool is_rest { false };
     };
 
+    virtual ~FunctionNode() = default;
+
     FlyString const& name() const { return m_name; }
-    Statement const& body() const { return *m_body; }
+    Statement const& body() const;
+    LazyFunctionBody const* lazy_body() const { return m_lazy_body; }
     Vector<Parameter> const& parameters() const { return m_parameters; };
     i32 function_length() const { return m_function_length; }
     bool is_strict_mode() const { return m_is_strict_mode; }
     bool is_arrow_function() const { return m_is_arrow_function; }
     FunctionKind kind() const { return m_kind; }
 
+    void set_lazy_body(NonnullRefPtr<LazyFunctionBody> lazy_body)
+    {
+        VERIFY(!m_body);
+        m_lazy_body = move(lazy_body);
+    }
+
 protected:
-    FunctionNode(FlyString name, NonnullRefPtr<Statement> body, Vector<Parameter> parameters, i32 function_length, FunctionKind kind, bool is_strict_mode, bool is_arrow_function)
+    FunctionNode(FlyString name, RefPtr<Statement> body, Vector<Parameter> parameters, i32 function_length, FunctionKind kind, bool is_strict_mode, bool is_arrow_function)
         : m_name(move(name))
         , m_body(move(body))
         , m_parameters(move(parameters))
@@ -282,7 +325,8 @@ protected:
 
 private:
     FlyString m_name;
-    NonnullRefPtr<Statement> m_body;
+    RefPtr<Statement> m_body;
+    RefPtr<LazyFunctionBody> m_lazy_body;
     Vector<Parameter> const m_parameters;
     const i32 m_function_length;
     FunctionKind m_kind;
@@ -296,7 +340,7 @@ class FunctionDeclaration final
 public:
     static bool must_have_name() { return true; }
 
-    FunctionDeclaration(SourceRange source_range, FlyString const& name, NonnullRefPtr<Statement> body, Vector<Parameter> parameters, i32 function_length, FunctionKind kind, bool is_strict_mode = false)
+    FunctionDeclaration(SourceRange source_range, FlyString const& name, RefPtr<Statement> body, Vector<Parameter> parameters, i32 function_length, FunctionKind kind, bool is_strict_mode = false)
         : Declaration(source_range)
         , FunctionNode(name, move(body), move(parameters), function_length, kind, is_strict_mode, false)
     {
@@ -313,7 +357,7 @@ class FunctionExpression final
 public:
     static bool must_have_name() { return false; }
 
-    FunctionExpression(SourceRange source_range, FlyString const& name, NonnullRefPtr<Statement> body, Vector<Parameter> parameters, i32 function_length, FunctionKind kind, bool is_strict_mode, bool is_arrow_function = false)
+    FunctionExpression(SourceRange source_range, FlyString const& name, RefPtr<Statement> body, Vector<Parameter> parameters, i32 function_length, FunctionKind kind, bool is_strict_mode, bool is_arrow_function = false)
         : Expression(source_range)
         , FunctionNode(name, move(body), move(parameters), function_length, kind, is_strict_mode, is_arrow_function)
     {
@@ -40,12 +40,12 @@ void ScopeNode::generate_bytecode(Bytecode::Generator& generator) const
                 declarator.target().visit(
                     [&](const NonnullRefPtr<Identifier>& id) {
                         generator.emit<Bytecode::Op::LoadImmediate>(js_undefined());
-                        generator.emit<Bytecode::Op::PutById>(Bytecode::Register::global_object(), generator.intern_string(id->string()));
+                        generator.emit<Bytecode::Op::PutById>(Bytecode::Register::global_object(), generator.intern_string(id->string()), generator.next_property_lookup_cache());
                     },
                     [&](const NonnullRefPtr<BindingPattern>& binding) {
                         binding->for_each_bound_name([&](const auto& name) {
                             generator.emit<Bytecode::Op::LoadImmediate>(js_undefined());
-                            generator.emit<Bytecode::Op::PutById>(Bytecode::Register::global_object(), generator.intern_string(name));
+                            generator.emit<Bytecode::Op::PutById>(Bytecode::Register::global_object(), generator.intern_string(name), generator.next_property_lookup_cache());
                         });
                     });
             } else {
@@ -67,6 +67,7 @@ void ScopeNode::generate_bytecode(Bytecode::Generator& generator) const
     }
 
     for (auto& child : children()) {
+        Bytecode::Generator::SourceRangeScope source_range_scope(generator, child.source_range());
         child.generate_bytecode(generator);
         if (generator.is_current_block_terminated())
             break;
@@ -392,7 +393,7 @@ void AssignmentExpression::generate_bytecode(Bytecode::Generator& generator) con
         } else {
             m_rhs->generate_bytecode(generator);
             auto identifier_table_ref = generator.intern_string(verify_cast<Identifier>(expression.property()).string());
-            generator.emit<Bytecode::Op::PutById>(object_reg, identifier_table_ref);
+            generator.emit<Bytecode::Op::PutById>(object_reg, identifier_table_ref, generator.next_property_lookup_cache());
         }
         return;
     }
@@ -581,7 +582,7 @@ void ObjectExpression::generate_bytecode(Bytecode::Generator& generator) const
             Bytecode::StringTableIndex key_name = generator.intern_string(string_literal.value());
 
             property.value().generate_bytecode(generator);
-            generator.emit<Bytecode::Op::PutById>(object_reg, key_name);
+            generator.emit<Bytecode::Op::PutById>(object_reg, key_name, generator.next_property_lookup_cache());
         } else {
             property.key().generate_bytecode(generator);
             auto property_reg = generator.allocate_register();
@@ -628,7 +629,7 @@ void MemberExpression::generate_bytecode(Bytecode::Generator& generator) const
         generator.emit<Bytecode::Op::GetByValue>(object_reg);
     } else {
         auto identifier_table_ref = generator.intern_string(verify_cast<Identifier>(property()).string());
-        generator.emit<Bytecode::Op::GetById>(identifier_table_ref);
+        generator.emit<Bytecode::Op::GetById>(identifier_table_ref, generator.next_property_lookup_cache());
     }
 }
 
@@ -679,7 +680,7 @@ static void generate_object_binding_pattern_bytecode(Bytecode::Generator& genera
             }
 
             generator.emit<Bytecode::Op::Load>(value_reg);
-            generator.emit<Bytecode::Op::GetById>(name_index);
+            generator.emit<Bytecode::Op::GetById>(name_index, generator.next_property_lookup_cache());
         } else {
             auto expression = name.get<NonnullRefPtr<Expression>>();
             expression->generate_bytecode(generator);
@@ -930,7 +931,7 @@ void CallExpression::generate_bytecode(Bytecode::Generator& generator) const
             if (!is<Identifier>(member_expression.property()))
                 TODO();
             auto identifier_table_ref = generator.intern_string(static_cast<Identifier const&>(member_expression.property()).string());
-            generator.emit<Bytecode::Op::GetById>(identifier_table_ref);
+            generator.emit<Bytecode::Op::GetById>(identifier_table_ref, generator.next_property_lookup_cache());
             generator.emit<Bytecode::Op::Store>(callee_reg);
         }
     } else {
@@ -1138,7 +1139,7 @@ void TaggedTemplateLiteral::generate_bytecode(Bytecode::Generator& generator) co
     generator.emit<Bytecode::Op::Store>(raw_strings_reg);
 
     generator.emit<Bytecode::Op::Load>(strings_reg);
-    generator.emit<Bytecode::Op::PutById>(raw_strings_reg, generator.intern_string("raw"));
+    generator.emit<Bytecode::Op::PutById>(raw_strings_reg, generator.intern_string("raw"), generator.next_property_lookup_cache());
 
     generator.emit<Bytecode::Op::LoadImmediate>(js_undefined());
     auto this_reg = generator.allocate_register();
@@ -1238,8 +1239,17 @@ void TryStatement::generate_bytecode(Bytecode::Generator& generator) const
 
     generator.switch_to_basic_block(target_block);
     m_block->generate_bytecode(generator);
-    if (m_finalizer && !generator.is_current_block_terminated())
-        generator.emit<Bytecode::Op::Jump>(finalizer_target);
+    if (!generator.is_current_block_terminated()) {
+        // Once the block has completed normally, an exception must not take us to its handler or finalizer anymore.
+        generator.emit<Bytecode::Op::LeaveUnwindContext>();
+        if (m_finalizer) {
+            generator.emit<Bytecode::Op::Jump>(finalizer_target);
+        } else {
+            if (!next_block)
+                next_block = &generator.make_block();
+            generator.emit<Bytecode::Op::Jump>(Bytecode::Label { *next_block });
+        }
+    }
 
     generator.switch_to_basic_block(next_block ? *next_block : saved_block);
 }
@@ -64,6 +64,134 @@ void BasicBlock::grow(size_t additional_size)
     VERIFY(m_buffer_size <= m_buffer_capacity);
 }
 
+// Removes the instructions at the given offsets, which must be in ascending order, by moving the
+// instructions after them down. Labels only refer to blocks, so nothing needs to be patched up.
+void BasicBlock::remove_instructions(Vector<size_t> const& offsets)
+{
+    if (offsets.is_empty())
+        return;
+
+    size_t read_offset = 0;
+    size_t write_offset = 0;
+    size_t next_removal = 0;
+    size_t next_source_map_entry = 0;
+    while (read_offset < m_buffer_size) {
+        for (; next_source_map_entry < m_source_map.size() && m_source_map[next_source_map_entry].offset == read_offset; ++next_source_map_entry)
+            m_source_map[next_source_map_entry].offset = write_offset;
+        auto& instruction = *reinterpret_cast<Instruction*>(m_buffer + read_offset);
+        auto length = instruction.length();
+        if (next_removal < offsets.size() && offsets[next_removal] == read_offset) {
+            VERIFY(!instruction.is_terminator());
+            Instruction::destroy(instruction);
+            ++next_removal;
+        } else {
+            if (write_offset != read_offset)
+                __builtin_memmove(m_buffer + write_offset, m_buffer + read_offset, length);
+            write_offset += length;
+        }
+        read_offset += length;
+    }
+    VERIFY(next_removal == offsets.size());
+    m_buffer_size = write_offset;
+
+    // Where a removed instruction started a source range, the range now starts at the next instruction. If
+    // that instruction started a range of its own, its range is the one that applies.
+    for (size_t i = 1; i < m_source_map.size();) {
+        if (m_source_map[i - 1].offset == m_source_map[i].offset)
+            m_source_map.remove(i - 1);
+        else
+            ++i;
+    }
+}
+
+// Destroys the instructions in the given range of offsets and makes room for new_length bytes in their
+// place, which the caller has to fill with a new instruction by constructing it at the returned address.
+void* BasicBlock::replace_instructions(size_t offset, size_t length, size_t new_length)
+{
+    VERIFY(new_length <= length);
+    VERIFY(offset + length <= m_buffer_size);
+
+    size_t read_offset = offset;
+    while (read_offset < offset + length) {
+        auto& instruction = *reinterpret_cast<Instruction*>(m_buffer + read_offset);
+        read_offset += instruction.length();
+        Instruction::destroy(instruction);
+    }
+    VERIFY(read_offset == offset + length);
+
+    __builtin_memmove(m_buffer + offset + new_length, m_buffer + offset + length, m_buffer_size - offset - length);
+    m_buffer_size -= length - new_length;
+
+    // The new instruction belongs to the source range of the first instruction that it replaces.
+    m_source_map.remove_all_matching([&](auto& entry) { return entry.offset > offset && entry.offset < offset + length; });
+    for (auto& entry : m_source_map) {
+        if (entry.offset >= offset + length)
+            entry.offset -= length - new_length;
+    }
+
+    return m_buffer + offset;
+}
+
+// The copies own whatever the instructions refer to now, so only the instructions that weren't copied are destroyed.
+void BasicBlock::release_instructions(size_t end_offset)
+{
+    VERIFY(end_offset <= m_buffer_size);
+
+    Bytecode::InstructionStreamIterator it(instruction_stream());
+    it.jump(end_offset);
+    while (!it.at_end()) {
+        auto& to_destroy = (*it);
+        ++it;
+        Instruction::destroy(const_cast<Instruction&>(to_destroy));
+    }
+
+    m_buffer_size = 0;
+    m_source_map.clear();
+}
+
+static bool is_same_source_range(SourceRange const& a, SourceRange const& b)
+{
+    return a.start.offset == b.start.offset && a.end.offset == b.end.offset && a.start.line == b.start.line && a.start.column == b.start.column;
+}
+
+void BasicBlock::add_source_map_entry(size_t offset, SourceRange const& source_range)
+{
+    if (!m_source_map.is_empty()) {
+        auto& last_entry = m_source_map.last();
+        VERIFY(last_entry.offset <= offset);
+        if (is_same_source_range(last_entry.source_range, source_range))
+            return;
+        if (last_entry.offset == offset) {
+            last_entry.source_range = source_range;
+            return;
+        }
+    }
+    m_source_map.append({ offset, source_range });
+}
+
+// Appends the source map of the instructions before end_offset in the other block, which the caller has
+// copied to the end of this block.
+void BasicBlock::copy_source_map_from(BasicBlock const& other, size_t end_offset)
+{
+    auto base_offset = m_buffer_size - end_offset;
+    for (auto& entry : other.m_source_map) {
+        if (entry.offset >= end_offset)
+            break;
+        add_source_map_entry(base_offset + entry.offset, entry.source_range);
+    }
+}
+
+SourceRange const* BasicBlock::source_range_at(size_t offset) const
+{
+    SourceRange const* source_range = nullptr;
+    for (auto& entry : m_source_map) {
+        if (entry.offset > offset)
+            break;
+        source_range = &entry.source_range;
+    }
+    return source_range;
+}
+
 void InstructionStreamIterator::operator++()
 {
     VERIFY(!at_end());
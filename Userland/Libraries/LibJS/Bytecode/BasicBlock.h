@@ -9,7 +9,9 @@
 #include <AK/Badge.h>
 #include <AK/NonnullOwnPtrVector.h>
 #include <AK/String.h>
+#include <AK/Vector.h>
 #include <LibJS/Forward.h>
+#include <LibJS/SourceRange.h>
 
 namespace JS::Bytecode {
 
@@ -59,6 +61,20 @@ public:
     void* next_slot() { return m_buffer + m_buffer_size; }
     bool can_grow(size_t additional_size) const { return m_buffer_size + additional_size <= m_buffer_capacity; }
     void grow(size_t additional_size);
+    void remove_instructions(Vector<size_t> const& offsets);
+    void* replace_instructions(size_t offset, size_t length, size_t new_length);
+    // Gives up the instructions before end_offset without destroying them, once they have been copied into another block.
+    void release_instructions(size_t end_offset);
+
+    // The instructions from each entry's offset up to the next entry were generated for its source range.
+    struct SourceMapEntry {
+        size_t offset { 0 };
+        SourceRange source_range;
+    };
+    Vector<SourceMapEntry> const& source_map() const { return m_source_map; }
+    void add_source_map_entry(size_t offset, SourceRange const&);
+    void copy_source_map_from(BasicBlock const&, size_t end_offset);
+    SourceRange const* source_range_at(size_t offset) const;
 
     void terminate(Badge<Generator>) { m_is_terminated = true; }
     bool is_terminated() const { return m_is_terminated; }
@@ -73,6 +89,7 @@ private:
     size_t m_buffer_size { 0 };
     bool m_is_terminated { false };
     String m_name;
+    Vector<SourceMapEntry> m_source_map;
 };
 
 }
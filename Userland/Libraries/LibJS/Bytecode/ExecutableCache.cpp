@@ -0,0 +1,662 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/CharacterTypes.h>
+#include <AK/HashMap.h>
+#include <AK/MappedFile.h>
+#include <AK/MemoryStream.h>
+#include <AK/StringBuilder.h>
+#include <LibCrypto/Checksum/CRC32.h>
+#include <LibCrypto/Hash/SHA2.h>
+#include <LibJS/AST.h>
+#include <LibJS/Bytecode/ExecutableCache.h>
+#include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Lexer.h>
+#include <LibJS/Parser.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <unistd.h>
+
+namespace JS::Bytecode {
+
+// A cache file looks like this, with all integers in host byte order:
+//
+//   u32 magic, u64 layout fingerprint, u32 CRC32 of everything that follows
+//   u64 number of registers, u64 number of property lookup caches
+//   u32 string count, then each string
+//   u32 function count, then for each function: its name, u8 kind, u8 flags, u64 line, u64 column, its source text
+//   u32 block count, then for each block: its name, u32 size, the instruction bytes
+//   for each instruction that refers to something outside the instruction stream, what it refers to
+//
+// Strings are a u32 length followed by the bytes. Labels are u32 block indices plus one, or zero for none.
+//
+// A file that is damaged in any way must be treated as a cache miss, so nothing that is read from it is trusted:
+// the checksum catches files that were cut short or corrupted on disk, and every count and operand is checked
+// against what it refers to before an instruction becomes part of a block.
+static constexpr u32 cache_file_magic = 0x4342534a; // "JSBC"
+static constexpr u32 cache_format_version = 2;
+static constexpr size_t cache_header_size = sizeof(u32) + sizeof(u64) + sizeof(u32);
+
+static constexpr u8 function_is_strict_mode = 1 << 0;
+static constexpr u8 function_is_arrow_function = 1 << 1;
+static constexpr u8 function_is_declaration = 1 << 2;
+
+// Most instructions are copied byte for byte, so a file is only valid for a build that lays them out the same way.
+static u64 layout_fingerprint()
+{
+    u64 fingerprint = cache_format_version;
+#define __BYTECODE_OP(op) \
+    fingerprint = fingerprint * 31 + sizeof(Op::op);
+    ENUMERATE_BYTECODE_OPS(__BYTECODE_OP)
+#undef __BYTECODE_OP
+    return fingerprint;
+}
+
+// The length of an instruction that was read from a file, or nothing if it doesn't fit in the bytes that are left.
+static Optional<size_t> checked_length(Instruction const& instruction, size_t available)
+{
+    size_t fixed_size = 0;
+    switch (instruction.type()) {
+#define __BYTECODE_OP(op)           \
+    case Instruction::Type::op:     \
+        fixed_size = sizeof(Op::op); \
+        break;
+        ENUMERATE_BYTECODE_OPS(__BYTECODE_OP)
+#undef __BYTECODE_OP
+    default:
+        return {};
+    }
+    if (fixed_size > available)
+        return {};
+
+    // The variable-width instructions end in a register per element, and their count could be anything.
+    size_t register_count = 0;
+    switch (instruction.type()) {
+    case Instruction::Type::Call:
+        register_count = static_cast<Op::Call const&>(instruction).argument_count();
+        break;
+    case Instruction::Type::NewArray:
+        register_count = static_cast<Op::NewArray const&>(instruction).element_count();
+        break;
+    case Instruction::Type::CopyObjectExcludingProperties:
+        register_count = static_cast<Op::CopyObjectExcludingProperties const&>(instruction).excluded_names_count();
+        break;
+    default:
+        break;
+    }
+    if (register_count > (available - fixed_size) / sizeof(Register))
+        return {};
+    return instruction.length();
+}
+
+struct OperandLimits {
+    size_t number_of_registers { 0 };
+    size_t string_count { 0 };
+    size_t property_lookup_cache_count { 0 };
+};
+
+// Makes sure that an instruction that was read from a file only refers to registers, strings and caches that exist.
+static bool has_valid_operands(Instruction& instruction, OperandLimits const& limits)
+{
+    bool registers_are_valid = true;
+    instruction.visit_registers([&](Register& reg, RegisterAccess) {
+        if (reg.index() >= limits.number_of_registers)
+            registers_are_valid = false;
+    });
+    if (!registers_are_valid)
+        return false;
+
+    auto is_valid_string = [&](StringTableIndex index) { return index.value() < limits.string_count; };
+    auto is_valid_cache = [&](size_t index) { return index < limits.property_lookup_cache_count; };
+
+    switch (instruction.type()) {
+    case Instruction::Type::LoadImmediate:
+        // Only values that aren't cells are ever stored, as a cell would point into the process that wrote the file.
+        switch (static_cast<Op::LoadImmediate const&>(instruction).value().type()) {
+        case Value::Type::Empty:
+        case Value::Type::Undefined:
+        case Value::Type::Null:
+        case Value::Type::Int32:
+        case Value::Type::Double:
+        case Value::Type::Boolean:
+            return true;
+        default:
+            return false;
+        }
+    case Instruction::Type::NewString:
+        return is_valid_string(static_cast<Op::NewString const&>(instruction).string());
+    case Instruction::Type::NewRegExp: {
+        auto& new_regexp = static_cast<Op::NewRegExp const&>(instruction);
+        return is_valid_string(new_regexp.source_index()) && is_valid_string(new_regexp.flags_index());
+    }
+    case Instruction::Type::SetVariable:
+        return is_valid_string(static_cast<Op::SetVariable const&>(instruction).identifier());
+    case Instruction::Type::GetVariable:
+        return is_valid_string(static_cast<Op::GetVariable const&>(instruction).identifier());
+    case Instruction::Type::GetVariableAndStore:
+        return is_valid_string(static_cast<Op::GetVariableAndStore const&>(instruction).identifier());
+#define __UPDATE_AND_SET_VARIABLE_OP(OpTitleCase, ...) \
+    case Instruction::Type::OpTitleCase:               \
+        return is_valid_string(static_cast<Op::OpTitleCase const&>(instruction).identifier());
+        JS_ENUMERATE_UPDATE_AND_SET_VARIABLE_OPS(__UPDATE_AND_SET_VARIABLE_OP)
+#undef __UPDATE_AND_SET_VARIABLE_OP
+    case Instruction::Type::GetById: {
+        auto& get_by_id = static_cast<Op::GetById const&>(instruction);
+        return is_valid_string(get_by_id.property()) && is_valid_cache(get_by_id.cache_index());
+    }
+    case Instruction::Type::PutById: {
+        auto& put_by_id = static_cast<Op::PutById const&>(instruction);
+        return is_valid_string(put_by_id.property()) && is_valid_cache(put_by_id.cache_index());
+    }
+    case Instruction::Type::GetByIdAndStore: {
+        auto& get_by_id = static_cast<Op::GetByIdAndStore const&>(instruction);
+        return is_valid_string(get_by_id.property()) && is_valid_cache(get_by_id.cache_index());
+    }
+    case Instruction::Type::Call: {
+        auto call_type = static_cast<Op::Call const&>(instruction).call_type();
+        return call_type == Op::Call::CallType::Call || call_type == Op::Call::CallType::Construct;
+    }
+    default:
+        return true;
+    }
+}
+
+// SignedBigInteger::from_base() insists on being given nothing but digits.
+static bool is_valid_bigint(StringView digits)
+{
+    if (digits.starts_with('-'))
+        digits = digits.substring_view(1);
+    if (digits.is_empty())
+        return false;
+    for (auto ch : digits) {
+        if (!is_ascii_digit(ch))
+            return false;
+    }
+    return true;
+}
+
+static bool is_jump(Instruction::Type type)
+{
+    switch (type) {
+    case Instruction::Type::Jump:
+    case Instruction::Type::JumpConditional:
+    case Instruction::Type::JumpNullish:
+    case Instruction::Type::JumpUndefined:
+#define __COMPARE_AND_JUMP_OP(OpTitleCase, ...) \
+    case Instruction::Type::OpTitleCase:
+        JS_ENUMERATE_COMPARE_AND_JUMP_OPS(__COMPARE_AND_JUMP_OP)
+#undef __COMPARE_AND_JUMP_OP
+        return true;
+    default:
+        return false;
+    }
+}
+
+class CacheWriter {
+public:
+    void write_string(StringView string)
+    {
+        m_stream << static_cast<u32>(string.length());
+        m_stream << string.bytes();
+    }
+
+    template<typename T>
+    void write(T value) { m_stream << value; }
+
+    void write_bytes(ReadonlyBytes bytes) { m_stream << bytes; }
+
+    ByteBuffer copy_into_contiguous_buffer() const { return m_stream.copy_into_contiguous_buffer(); }
+
+private:
+    DuplexMemoryStream m_stream;
+};
+
+class CacheReader {
+public:
+    explicit CacheReader(ReadonlyBytes bytes)
+        : m_stream(bytes)
+    {
+    }
+
+    ~CacheReader()
+    {
+        // Running out of bytes is checked with has_error(), but the stream insists on being told.
+        m_stream.handle_any_error();
+    }
+
+    template<typename T>
+    T read()
+    {
+        T value {};
+        m_stream >> value;
+        return value;
+    }
+
+    ReadonlyBytes read_bytes(size_t size)
+    {
+        if (size > m_stream.remaining()) {
+            m_stream.set_fatal_error();
+            return {};
+        }
+        auto bytes = m_stream.bytes().slice(m_stream.offset(), size);
+        m_stream.discard_or_error(size);
+        return bytes;
+    }
+
+    StringView read_string() { return read_bytes(read<u32>()); }
+
+    bool has_error() const { return m_stream.has_any_error(); }
+    size_t remaining() const { return m_stream.remaining(); }
+
+private:
+    InputMemoryStream m_stream;
+};
+
+Optional<ByteBuffer> ExecutableCache::serialize(Executable const& executable, StringView source)
+{
+    HashMap<BasicBlock const*, u32> block_indices;
+    for (size_t i = 0; i < executable.basic_blocks.size(); ++i)
+        block_indices.set(&executable.basic_blocks[i], i);
+
+    auto write_label = [&](CacheWriter& writer, Optional<Label> const& label) {
+        writer.write<u32>(label.has_value() ? block_indices.get(&label->block()).value() + 1 : 0);
+    };
+
+    HashMap<FunctionNode const*, u32> function_indices;
+    Vector<FunctionNode const*> functions;
+
+    // First the parts that refer to things outside of the instruction streams, which also finds the functions.
+    CacheWriter references;
+    for (auto& block : executable.basic_blocks) {
+        for (InstructionStreamIterator it { block.instruction_stream() }; !it.at_end(); ++it) {
+            auto& instruction = *it;
+            auto type = instruction.type();
+            if (is_jump(type)) {
+                auto& jump = static_cast<Op::Jump const&>(instruction);
+                write_label(references, jump.true_target());
+                write_label(references, jump.false_target());
+                continue;
+            }
+            switch (type) {
+            case Instruction::Type::EnterUnwindContext: {
+                auto& enter = static_cast<Op::EnterUnwindContext const&>(instruction);
+                write_label(references, enter.entry_point());
+                write_label(references, enter.handler_target());
+                write_label(references, enter.finalizer_target());
+                break;
+            }
+            case Instruction::Type::ContinuePendingUnwind:
+                write_label(references, static_cast<Op::ContinuePendingUnwind const&>(instruction).resume_target());
+                break;
+            case Instruction::Type::Yield:
+                write_label(references, static_cast<Op::Yield const&>(instruction).continuation());
+                break;
+            case Instruction::Type::LoadImmediate:
+                if (static_cast<Op::LoadImmediate const&>(instruction).value().is_cell())
+                    return {};
+                break;
+            case Instruction::Type::NewBigInt:
+                references.write_string(static_cast<Op::NewBigInt const&>(instruction).bigint().to_base(10));
+                break;
+            case Instruction::Type::PushDeclarativeEnvironment: {
+                auto& variables = static_cast<Op::PushDeclarativeEnvironment const&>(instruction).variables();
+                references.write<u32>(variables.size());
+                for (auto& it : variables) {
+                    if (!it.value.value.is_undefined())
+                        return {};
+                    references.write<u32>(it.key);
+                    references.write<u8>(to_underlying(it.value.declaration_kind));
+                }
+                break;
+            }
+            case Instruction::Type::NewFunction: {
+                auto& function_node = static_cast<Op::NewFunction const&>(instruction).function_node();
+                auto index = function_indices.get(&function_node);
+                if (!index.has_value()) {
+                    index = functions.size();
+                    function_indices.set(&function_node, *index);
+                    functions.append(&function_node);
+                }
+                references.write<u32>(*index);
+                break;
+            }
+            case Instruction::Type::NewClass:
+                return {};
+            default:
+                break;
+            }
+        }
+    }
+
+    CacheWriter writer;
+    writer.write<u64>(executable.number_of_registers);
+    writer.write<u64>(executable.property_lookup_caches.size());
+
+    auto& strings = executable.string_table->strings();
+    writer.write<u32>(strings.size());
+    for (auto& string : strings)
+        writer.write_string(string);
+
+    writer.write<u32>(functions.size());
+    for (auto* function_node : functions) {
+        auto& range = dynamic_cast<ASTNode const&>(*function_node).source_range();
+        if (range.end.offset <= range.start.offset || range.end.offset > source.length())
+            return {};
+        u8 flags = 0;
+        if (function_node->is_strict_mode())
+            flags |= function_is_strict_mode;
+        if (function_node->is_arrow_function())
+            flags |= function_is_arrow_function;
+        if (is<FunctionDeclaration>(dynamic_cast<ASTNode const&>(*function_node)))
+            flags |= function_is_declaration;
+        writer.write_string(function_node->name());
+        writer.write<u8>(to_underlying(function_node->kind()));
+        writer.write<u8>(flags);
+        writer.write<u64>(range.start.line);
+        writer.write<u64>(range.start.column);
+        writer.write_string(source.substring_view(range.start.offset, range.end.offset - range.start.offset).trim_whitespace());
+    }
+
+    writer.write<u32>(executable.basic_blocks.size());
+    for (auto& block : executable.basic_blocks) {
+        writer.write_string(block.name());
+        writer.write<u32>(block.size());
+        writer.write_bytes(block.instruction_stream());
+    }
+
+    writer.write_bytes(references.copy_into_contiguous_buffer());
+    auto payload = writer.copy_into_contiguous_buffer();
+
+    CacheWriter file;
+    file.write<u32>(cache_file_magic);
+    file.write<u64>(layout_fingerprint());
+    file.write<u32>(Crypto::Checksum::CRC32(payload).digest());
+    file.write_bytes(payload);
+    return file.copy_into_contiguous_buffer();
+}
+
+// Parses the source text of a function again, and makes sure that it comes out the same as it did before.
+static RefPtr<Program> parse_function(StringView name, FunctionKind kind, u8 flags, size_t line, size_t column, StringView text, FunctionNode const*& function_node)
+{
+    bool is_declaration = flags & function_is_declaration;
+
+    // Function expressions are put in an array literal, or they would be parsed as function declarations.
+    // (Parenthesizing them would stop them from taking the name they were given below.)
+    // The text may end in a comment, so the closing bracket goes on a line of its own.
+    String source = is_declaration ? String(text) : String::formatted("[{}\n]", text);
+    auto parser = Parser(Lexer(source, "(unknown)", line, is_declaration || column == 0 ? column : column - 1));
+    // The text parsed fine when it was stored, so its body can wait until the function is called.
+    parser.set_parses_functions_lazily(true);
+    auto program = parser.parse_program();
+    if (parser.has_errors())
+        return {};
+
+    if (is_declaration) {
+        if (program->functions().size() != 1)
+            return {};
+        function_node = &program->functions().first();
+    } else {
+        if (program->children().size() != 1 || !is<ExpressionStatement>(program->children().first()))
+            return {};
+        auto& statement_expression = static_cast<ExpressionStatement const&>(program->children().first()).expression();
+        if (!is<ArrayExpression>(statement_expression))
+            return {};
+        auto& elements = static_cast<ArrayExpression const&>(statement_expression).elements();
+        if (elements.size() != 1 || !is<FunctionExpression>(elements.first().ptr()))
+            return {};
+        // The name of an anonymous function expression comes from where it was assigned to.
+        auto& function_expression = const_cast<FunctionExpression&>(static_cast<FunctionExpression const&>(*elements.first()));
+        if (!name.is_empty())
+            function_expression.set_name_if_possible(name);
+        function_node = &function_expression;
+    }
+
+    if (function_node->name() != name
+        || function_node->kind() != kind
+        || function_node->is_strict_mode() != static_cast<bool>(flags & function_is_strict_mode)
+        || function_node->is_arrow_function() != static_cast<bool>(flags & function_is_arrow_function))
+        return {};
+    return program;
+}
+
+Optional<Executable> ExecutableCache::deserialize(ReadonlyBytes bytes)
+{
+    if (bytes.size() < cache_header_size)
+        return {};
+    auto payload = bytes.slice(cache_header_size);
+    {
+        CacheReader header(bytes.trim(cache_header_size));
+        if (header.read<u32>() != cache_file_magic || header.read<u64>() != layout_fingerprint())
+            return {};
+        if (header.read<u32>() != Crypto::Checksum::CRC32(payload).digest())
+            return {};
+    }
+
+    CacheReader reader(payload);
+
+    // Every register and cache is used by at least one instruction, and every instruction takes up more than
+    // a byte, so none of the counts can be larger than what is left of the file.
+    auto number_of_registers = reader.read<u64>();
+    auto property_lookup_cache_count = reader.read<u64>();
+    if (number_of_registers <= Register::global_object_index || number_of_registers > reader.remaining() || property_lookup_cache_count > reader.remaining())
+        return {};
+    Vector<PropertyLookupCache> property_lookup_caches;
+    property_lookup_caches.resize(property_lookup_cache_count);
+
+    Vector<String> strings;
+    auto string_count = reader.read<u32>();
+    if (string_count > reader.remaining() / sizeof(u32))
+        return {};
+    for (u32 i = 0; i < string_count && !reader.has_error(); ++i)
+        strings.append(String(reader.read_string()));
+
+    NonnullRefPtrVector<ASTNode> function_asts;
+    Vector<FunctionNode const*> functions;
+    auto function_count = reader.read<u32>();
+    if (function_count > reader.remaining() / (2 * sizeof(u32) + 2 * sizeof(u8) + 2 * sizeof(u64)))
+        return {};
+    for (u32 i = 0; i < function_count && !reader.has_error(); ++i) {
+        auto name = reader.read_string();
+        auto kind = reader.read<u8>();
+        auto flags = reader.read<u8>();
+        auto line = reader.read<u64>();
+        auto column = reader.read<u64>();
+        auto text = reader.read_string();
+        if (reader.has_error() || kind > to_underlying(FunctionKind::Regular))
+            return {};
+        FunctionNode const* function_node = nullptr;
+        auto program = parse_function(name, static_cast<FunctionKind>(kind), flags, line, column, text, function_node);
+        if (!program)
+            return {};
+        function_asts.append(program.release_nonnull());
+        functions.append(function_node);
+    }
+
+    NonnullOwnPtrVector<BasicBlock> blocks;
+    Vector<ReadonlyBytes> instruction_streams;
+    auto block_count = reader.read<u32>();
+    if (block_count > reader.remaining() / (2 * sizeof(u32)))
+        return {};
+    for (u32 i = 0; i < block_count && !reader.has_error(); ++i) {
+        auto name = reader.read_string();
+        auto size = reader.read<u32>();
+        auto stream = reader.read_bytes(size);
+        if (reader.has_error())
+            return {};
+        instruction_streams.append(stream);
+        blocks.append(BasicBlock::create(String(name), size));
+    }
+    if (reader.has_error())
+        return {};
+
+    auto read_label = [&]() -> Optional<Label> {
+        auto index = reader.read<u32>();
+        if (index == 0 || index > blocks.size())
+            return {};
+        return Label { blocks[index - 1] };
+    };
+
+    OperandLimits limits { number_of_registers, strings.size(), property_lookup_caches.size() };
+
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        auto& block = blocks[i];
+        auto stream = instruction_streams[i];
+        auto* buffer = static_cast<u8*>(block.next_slot());
+        memcpy(buffer, stream.data(), stream.size());
+
+        // Only the instructions that were checked and patched up become part of the block, so that it
+        // never destroys one that still points into the process that wrote the file.
+        size_t offset = 0;
+        while (offset < stream.size()) {
+            if (stream.size() - offset < sizeof(Instruction))
+                return {};
+            auto& instruction = *reinterpret_cast<Instruction*>(buffer + offset);
+            auto length = checked_length(instruction, stream.size() - offset);
+            if (!length.has_value() || !has_valid_operands(instruction, limits))
+                return {};
+
+            auto type = instruction.type();
+            if (is_jump(type)) {
+                // Every jump has somewhere to go, and all but the unconditional one need somewhere else too.
+                auto true_target = read_label();
+                auto false_target = read_label();
+                if (!true_target.has_value() || (type != Instruction::Type::Jump && !false_target.has_value()))
+                    return {};
+                static_cast<Op::Jump&>(instruction).set_targets(true_target, false_target);
+            } else {
+                switch (type) {
+                case Instruction::Type::EnterUnwindContext: {
+                    auto entry_point = read_label();
+                    auto handler_target = read_label();
+                    auto finalizer_target = read_label();
+                    if (!entry_point.has_value())
+                        return {};
+                    new (&instruction) Op::EnterUnwindContext(*entry_point, handler_target, finalizer_target);
+                    break;
+                }
+                case Instruction::Type::ContinuePendingUnwind: {
+                    auto resume_target = read_label();
+                    if (!resume_target.has_value())
+                        return {};
+                    new (&instruction) Op::ContinuePendingUnwind(*resume_target);
+                    break;
+                }
+                case Instruction::Type::Yield: {
+                    auto continuation = read_label();
+                    if (continuation.has_value())
+                        new (&instruction) Op::Yield(*continuation);
+                    else
+                        new (&instruction) Op::Yield(nullptr);
+                    break;
+                }
+                case Instruction::Type::NewBigInt: {
+                    auto digits = reader.read_string();
+                    if (reader.has_error() || !is_valid_bigint(digits))
+                        return {};
+                    new (&instruction) Op::NewBigInt(Crypto::SignedBigInteger::from_base(10, digits));
+                    break;
+                }
+                case Instruction::Type::PushDeclarativeEnvironment: {
+                    HashMap<u32, Variable> variables;
+                    auto variable_count = reader.read<u32>();
+                    if (variable_count > reader.remaining() / (sizeof(u32) + sizeof(u8)))
+                        return {};
+                    for (u32 j = 0; j < variable_count; ++j) {
+                        auto key = reader.read<u32>();
+                        auto declaration_kind = reader.read<u8>();
+                        if (reader.has_error() || key >= strings.size() || declaration_kind > to_underlying(DeclarationKind::Const))
+                            return {};
+                        variables.set(key, { js_undefined(), static_cast<DeclarationKind>(declaration_kind) });
+                    }
+                    new (&instruction) Op::PushDeclarativeEnvironment(move(variables));
+                    break;
+                }
+                case Instruction::Type::NewFunction: {
+                    auto index = reader.read<u32>();
+                    if (reader.has_error() || index >= functions.size())
+                        return {};
+                    new (&instruction) Op::NewFunction(*functions[index]);
+                    break;
+                }
+                case Instruction::Type::NewClass:
+                    return {};
+                default:
+                    break;
+                }
+            }
+            if (reader.has_error())
+                return {};
+
+            block.grow(*length);
+            offset += *length;
+        }
+    }
+
+    // Everything in the file has to have been used up, or it wasn't written the way it was read.
+    if (reader.remaining() != 0)
+        return {};
+
+    return Executable { move(blocks), make<StringTable>(move(strings)), number_of_registers, move(property_lookup_caches), move(function_asts) };
+}
+
+String ExecutableCache::path_for(StringView source, bool is_optimized) const
+{
+    Crypto::Hash::SHA256 hash;
+    auto fingerprint = layout_fingerprint();
+    hash.update(reinterpret_cast<u8 const*>(&fingerprint), sizeof(fingerprint));
+    hash.update(reinterpret_cast<u8 const*>(&is_optimized), sizeof(is_optimized));
+    hash.update(reinterpret_cast<u8 const*>(source.characters_without_null_termination()), source.length());
+    auto digest = hash.digest();
+
+    StringBuilder builder;
+    builder.append(m_directory);
+    builder.append('/');
+    for (size_t i = 0; i < digest.data_length(); ++i)
+        builder.appendff("{:02x}", digest.immutable_data()[i]);
+    builder.append(".jsbc");
+    return builder.to_string();
+}
+
+Optional<Executable> ExecutableCache::load(StringView source, bool is_optimized) const
+{
+    auto file_or_error = MappedFile::map(path_for(source, is_optimized));
+    if (file_or_error.is_error())
+        return {};
+    return deserialize(file_or_error.value()->bytes());
+}
+
+bool ExecutableCache::store(StringView source, bool is_optimized, Executable const& executable) const
+{
+    auto bytes = serialize(executable, source);
+    if (!bytes.has_value())
+        return false;
+
+    // Write to a temporary file first, so that nobody ever maps a file that is only partially written.
+    auto path = path_for(source, is_optimized);
+    auto temporary_path = String::formatted("{}.{}", path, getpid());
+    int fd = open(temporary_path.characters(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0)
+        return false;
+    size_t nwritten = 0;
+    while (nwritten < bytes->size()) {
+        auto rc = write(fd, bytes->data() + nwritten, bytes->size() - nwritten);
+        if (rc <= 0) {
+            close(fd);
+            unlink(temporary_path.characters());
+            return false;
+        }
+        nwritten += rc;
+    }
+    close(fd);
+    if (rename(temporary_path.characters(), path.characters()) < 0) {
+        unlink(temporary_path.characters());
+        return false;
+    }
+    return true;
+}
+
+}
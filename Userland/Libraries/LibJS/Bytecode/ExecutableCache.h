@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/Optional.h>
+#include <AK/String.h>
+#include <LibJS/Bytecode/Generator.h>
+
+namespace JS::Bytecode {
+
+// Keeps the bytecode of scripts on disk, so that running the same script again doesn't have to lex, parse
+// and generate bytecode for it. Entries are keyed by a hash of the source, and files that were written by a
+// build with a different bytecode layout are ignored.
+//
+// Functions are compiled from their AST when they are first called, so the cache can't do away with their
+// source: it stores the source text of every function that the executable creates, and parses it again
+// lazily when the executable is loaded.
+class ExecutableCache {
+public:
+    explicit ExecutableCache(String directory)
+        : m_directory(move(directory))
+    {
+    }
+
+    // The optimization level is part of the key, since the passes change the bytecode.
+    Optional<Executable> load(StringView source, bool is_optimized) const;
+    bool store(StringView source, bool is_optimized, Executable const&) const;
+
+    // Returns an empty Optional if the executable contains instructions that can't be serialized.
+    static Optional<ByteBuffer> serialize(Executable const&, StringView source);
+    static Optional<Executable> deserialize(ReadonlyBytes);
+
+private:
+    String path_for(StringView source, bool is_optimized) const;
+
+    String m_directory;
+};
+
+}
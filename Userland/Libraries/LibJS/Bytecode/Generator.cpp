@@ -23,9 +23,20 @@ Generator::~Generator()
 {
 }
 
+void Executable::dump() const
+{
+    for (auto& block : basic_blocks)
+        block.dump(*this);
+    if (!string_table->is_empty()) {
+        outln();
+        string_table->dump();
+    }
+}
+
 Executable Generator::generate(ASTNode const& node, bool is_in_generator_function)
 {
     Generator generator;
+    SourceRangeScope source_range_scope(generator, node.source_range());
     generator.switch_to_basic_block(generator.make_block());
     if (is_in_generator_function) {
         generator.enter_generator_context();
@@ -45,7 +56,9 @@ Executable Generator::generate(ASTNode const& node, bool is_in_generator_functio
             generator.emit<Bytecode::Op::Yield>(nullptr);
         }
     }
-    return { move(generator.m_root_basic_blocks), move(generator.m_string_table), generator.m_next_register };
+    Vector<PropertyLookupCache> property_lookup_caches;
+    property_lookup_caches.resize(generator.m_next_property_lookup_cache);
+    return { move(generator.m_root_basic_blocks), move(generator.m_string_table), generator.m_next_register, move(property_lookup_caches), {} };
 }
 
 void Generator::grow(size_t additional_size)
@@ -7,9 +7,11 @@
 #pragma once
 
 #include <AK/NonnullOwnPtrVector.h>
+#include <AK/NonnullRefPtrVector.h>
 #include <AK/OwnPtr.h>
 #include <AK/SinglyLinkedList.h>
 #include <LibJS/Bytecode/BasicBlock.h>
+#include <LibJS/Bytecode/InlineCache.h>
 #include <LibJS/Bytecode/Label.h>
 #include <LibJS/Bytecode/Op.h>
 #include <LibJS/Bytecode/Register.h>
@@ -23,7 +25,16 @@ struct Executable {
     NonnullOwnPtr<StringTable> string_table;
     size_t number_of_registers { 0 };
 
+    // These are updated while the executable runs, even though it is otherwise immutable by then.
+    mutable Vector<PropertyLookupCache> property_lookup_caches;
+
+    // An executable that was loaded from an ExecutableCache has no AST of its own, so it keeps alive
+    // the ASTs that it parsed for the functions its NewFunction instructions refer to.
+    NonnullRefPtrVector<ASTNode> function_asts;
+
     String const& get_string(StringTableIndex index) const { return string_table->get(index); }
+
+    void dump() const;
 };
 
 class Generator {
@@ -52,6 +63,7 @@ public:
         if constexpr (!OpType::IsTerminator)
             ensure_enough_space(sizeof(OpType));
 
+        note_source_range();
         void* slot = next_slot();
         grow(sizeof(OpType));
         new (slot) OpType(forward<Args>(args)...);
@@ -68,6 +80,7 @@ public:
         if constexpr (!OpType::IsTerminator)
             ensure_enough_space(sizeof(OpType) + extra_register_slots * sizeof(Register));
 
+        note_source_range();
         void* slot = next_slot();
         grow(sizeof(OpType) + extra_register_slots * sizeof(Register));
         new (slot) OpType(forward<Args>(args)...);
@@ -109,6 +122,25 @@ public:
         return m_string_table->insert(string);
     }
 
+    size_t next_property_lookup_cache() { return m_next_property_lookup_cache++; }
+
+    // Attributes the instructions that are emitted while this is alive to the given part of the source,
+    // so that we can tell where the executable is when it runs.
+    class SourceRangeScope {
+    public:
+        SourceRangeScope(Generator& generator, SourceRange const& source_range)
+            : m_generator(generator)
+            , m_previous_source_range(exchange(generator.m_current_source_range, &source_range))
+        {
+        }
+
+        ~SourceRangeScope() { m_generator.m_current_source_range = m_previous_source_range; }
+
+    private:
+        Generator& m_generator;
+        SourceRange const* m_previous_source_range { nullptr };
+    };
+
     bool is_in_generator_function() const { return m_is_in_generator_function; }
     void enter_generator_context() { m_is_in_generator_function = true; }
     void leave_generator_context() { m_is_in_generator_function = false; }
@@ -120,13 +152,21 @@ private:
     void grow(size_t);
     void* next_slot();
 
+    void note_source_range()
+    {
+        if (m_current_source_range)
+            m_current_basic_block->add_source_map_entry(m_current_basic_block->size(), *m_current_source_range);
+    }
+
     BasicBlock* m_current_basic_block { nullptr };
     NonnullOwnPtrVector<BasicBlock> m_root_basic_blocks;
     NonnullOwnPtr<StringTable> m_string_table;
 
     u32 m_next_register { 2 };
     u32 m_next_block { 1 };
+    size_t m_next_property_lookup_cache { 0 };
     bool m_is_in_generator_function { false };
+    SourceRange const* m_current_source_range { nullptr };
     Vector<Label> m_continuable_scopes;
     Vector<Label> m_breakable_scopes;
 };
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/InlineCache.h>
+
+namespace JS::Bytecode {
+
+static bool is_cacheable(Object const& object)
+{
+    return !object.shape().is_unique() && !object.has_exotic_property_access();
+}
+
+static bool is_cacheable(Value value)
+{
+    return !value.is_accessor() && !value.is_native_property();
+}
+
+void PropertyLookupCache::fill_for_get(Object const& object, PropertyName const& property_name)
+{
+    if (is_megamorphic || !property_name.is_string() || !is_cacheable(object))
+        return;
+
+    auto key = property_name.to_string_or_symbol();
+    if (auto metadata = object.shape().lookup(key); metadata.has_value()) {
+        if (!is_cacheable(object.get_direct(metadata->offset)))
+            return;
+        add({ object.shape().make_weak_ptr(), object.shape().property_count(), false, {}, 0, metadata->offset });
+        return;
+    }
+
+    // Methods usually live on the prototype, so look one step up the prototype chain as well.
+    auto const* prototype = object.shape().prototype();
+    if (!prototype || !is_cacheable(*prototype))
+        return;
+    auto metadata = prototype->shape().lookup(key);
+    if (!metadata.has_value() || !is_cacheable(prototype->get_direct(metadata->offset)))
+        return;
+    add({ object.shape().make_weak_ptr(), object.shape().property_count(), true, prototype->shape().make_weak_ptr(), prototype->shape().property_count(), metadata->offset });
+}
+
+void PropertyLookupCache::fill_for_put(Object const& object, PropertyName const& property_name)
+{
+    if (is_megamorphic || !property_name.is_string() || !is_cacheable(object))
+        return;
+
+    // Only writes to existing writable data properties are cached. Adding a property changes the shape of
+    // the object, and whether it can be added at all depends on the whole prototype chain.
+    auto metadata = object.shape().lookup(property_name.to_string_or_symbol());
+    if (!metadata.has_value() || !metadata->attributes.is_writable() || !is_cacheable(object.get_direct(metadata->offset)))
+        return;
+    add({ object.shape().make_weak_ptr(), object.shape().property_count(), false, {}, 0, metadata->offset });
+}
+
+void PropertyLookupCache::add(Entry entry)
+{
+    // Shapes that have been garbage collected will never match again, so their entries can be reused.
+    entries.remove_all_matching([](auto& entry) { return !entry.shape || (entry.on_prototype && !entry.prototype_shape); });
+
+    if (entries.size() == max_entries) {
+        entries.clear();
+        is_megamorphic = true;
+        return;
+    }
+    entries.append(move(entry));
+}
+
+String PropertyLookupCache::to_string() const
+{
+    StringView state_name;
+    switch (state()) {
+    case State::Uninitialized:
+        state_name = "uninitialized";
+        break;
+    case State::Monomorphic:
+        state_name = "monomorphic";
+        break;
+    case State::Polymorphic:
+        state_name = "polymorphic";
+        break;
+    case State::Megamorphic:
+        state_name = "megamorphic";
+        break;
+    }
+    return String::formatted("{}, {} hits, {} misses", state_name, hits, misses);
+}
+
+}
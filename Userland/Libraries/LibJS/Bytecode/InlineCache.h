@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/String.h>
+#include <AK/Vector.h>
+#include <AK/WeakPtr.h>
+#include <LibJS/Runtime/Object.h>
+#include <LibJS/Runtime/Shape.h>
+#include <LibJS/Runtime/Value.h>
+
+namespace JS::Bytecode {
+
+// An inline cache remembers where a GetById or PutById found its property the last few times it ran,
+// keyed on the shape of the object it was looking at. As long as an object comes along with one of
+// those shapes, the property can be read or written at the remembered offset without looking it up.
+//
+// Only non-unique shapes are cached: a unique shape is changed in place when a property is removed
+// from it, so the same shape can end up with a different layout. Non-unique shapes can also grow in
+// place while an object is being initialized, so the property count is checked as well.
+struct PropertyLookupCache {
+    static constexpr size_t max_entries = 4;
+
+    enum class State {
+        Uninitialized,
+        Monomorphic,
+        Polymorphic,
+        Megamorphic,
+    };
+
+    struct Entry {
+        WeakPtr<Shape> shape;
+        size_t property_count { 0 };
+
+        // Set if the property was found on the prototype of the object instead of the object itself.
+        // The prototype doesn't need to be remembered, since it can't change without the shape changing.
+        bool on_prototype { false };
+        WeakPtr<Shape> prototype_shape;
+        size_t prototype_property_count { 0 };
+
+        size_t offset { 0 };
+    };
+
+    State state() const
+    {
+        if (is_megamorphic)
+            return State::Megamorphic;
+        if (entries.is_empty())
+            return State::Uninitialized;
+        return entries.size() == 1 ? State::Monomorphic : State::Polymorphic;
+    }
+
+    ALWAYS_INLINE Optional<Value> get(Object const& object)
+    {
+        for (auto& entry : entries) {
+            if (entry.shape.ptr() != &object.shape() || entry.property_count != object.shape().property_count())
+                continue;
+            if (object.has_exotic_property_access())
+                break;
+            auto const* holder = &object;
+            if (entry.on_prototype) {
+                holder = object.shape().prototype();
+                if (entry.prototype_shape.ptr() != &holder->shape() || entry.prototype_property_count != holder->shape().property_count())
+                    continue;
+            }
+            auto value = holder->get_direct(entry.offset);
+            if (value.is_accessor() || value.is_native_property())
+                break;
+            ++hits;
+            return value;
+        }
+        ++misses;
+        return {};
+    }
+
+    ALWAYS_INLINE bool put(Object& object, Value value)
+    {
+        for (auto& entry : entries) {
+            if (entry.shape.ptr() != &object.shape() || entry.property_count != object.shape().property_count())
+                continue;
+            if (object.has_exotic_property_access())
+                break;
+            auto existing_value = object.get_direct(entry.offset);
+            if (existing_value.is_accessor() || existing_value.is_native_property())
+                break;
+            object.put_direct(entry.offset, value);
+            ++hits;
+            return true;
+        }
+        ++misses;
+        return false;
+    }
+
+    void fill_for_get(Object const&, PropertyName const&);
+    void fill_for_put(Object const&, PropertyName const&);
+
+    String to_string() const;
+
+    Vector<Entry, max_entries> entries;
+    bool is_megamorphic { false };
+    u64 hits { 0 };
+    u64 misses { 0 };
+
+private:
+    void add(Entry);
+};
+
+}
@@ -73,10 +73,30 @@
     O(IteratorNext)                  \
     O(IteratorResultDone)            \
     O(IteratorResultValue)           \
-    O(NewClass)
+    O(NewClass)                      \
+    O(GetVariableAndStore)           \
+    O(GetByIdAndStore)               \
+    O(IncrementAndSetVariable)       \
+    O(DecrementAndSetVariable)       \
+    O(JumpGreaterThan)               \
+    O(JumpGreaterThanEquals)         \
+    O(JumpLessThan)                  \
+    O(JumpLessThanEquals)            \
+    O(JumpAbstractInequals)          \
+    O(JumpAbstractEquals)            \
+    O(JumpTypedInequals)             \
+    O(JumpTypedEquals)
 
 namespace JS::Bytecode {
 
+enum class RegisterAccess {
+    Read,
+    Write,
+    ReadWrite,
+};
+
+using RegisterVisitor = Function<void(Register&, RegisterAccess)>;
+
 class Instruction {
 public:
     constexpr static bool IsTerminator = false;
@@ -88,13 +108,21 @@ public:
 #undef __BYTECODE_OP
     };
 
+    static constexpr size_t type_count = 0
+#define __BYTECODE_OP(op) +1
+        ENUMERATE_BYTECODE_OPS(__BYTECODE_OP)
+#undef __BYTECODE_OP
+        ;
+
     bool is_terminator() const;
     Type type() const { return m_type; }
     size_t length() const;
     String to_string(Bytecode::Executable const&) const;
     void execute(Bytecode::Interpreter&) const;
     void replace_references(BasicBlock const&, BasicBlock const&);
+    void visit_registers(RegisterVisitor const&);
     static void destroy(Instruction&);
+    static StringView type_name(Type);
 
 protected:
     explicit Instruction(Type type)
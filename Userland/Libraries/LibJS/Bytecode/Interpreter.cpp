@@ -5,6 +5,7 @@
  */
 
 #include <AK/Debug.h>
+#include <AK/QuickSort.h>
 #include <AK/TemporaryChange.h>
 #include <LibJS/Bytecode/BasicBlock.h>
 #include <LibJS/Bytecode/Instruction.h>
@@ -12,6 +13,14 @@
 #include <LibJS/Bytecode/Op.h>
 #include <LibJS/Runtime/GlobalEnvironment.h>
 #include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/SamplingProfiler.h>
+
+// Labels as values are a GNU extension, which both GCC and Clang support.
+#if defined(__GNUC__) || defined(__clang__)
+#    define JS_BYTECODE_COMPUTED_GOTO 1
+#else
+#    define JS_BYTECODE_COMPUTED_GOTO 0
+#endif
 
 namespace JS::Bytecode {
 
@@ -67,16 +76,62 @@ Value Interpreter::run(Executable const& executable, BasicBlock const* entry_poi
         registers()[Register::global_object_index] = Value(&global_object());
     }
 
+#if JS_BYTECODE_COMPUTED_GOTO
+    static void const* const dispatch_table[] = {
+#    define __BYTECODE_OP(op) &&handle_##op,
+        ENUMERATE_BYTECODE_OPS(__BYTECODE_OP)
+#    undef __BYTECODE_OP
+    };
+#endif
+
+    // Unwind contexts entered by the code that called us belong to another executable, so we must not jump to them.
+    auto unwind_contexts_base = m_unwind_contexts.size();
+
+    bool is_instrumented = m_statistics || vm().sampling_profiler();
+
     for (;;) {
         Bytecode::InstructionStreamIterator pc(block->instruction_stream());
         bool will_jump = false;
         bool will_return = false;
+        if (m_statistics)
+            m_statistics->previous_type = {};
         while (!pc.at_end()) {
-            auto& instruction = *pc;
-            instruction.execute(*this);
+#if JS_BYTECODE_COMPUTED_GOTO
+            // Every instruction gets its own indirect jump to the next one, which gives the branch predictor
+            // a lot more to go on than a single switch would. Only terminators and instructions that throw
+            // have to go through the checks below.
+            goto* dispatch_table[to_underlying((*pc).type())];
+
+#    define __BYTECODE_OP(op)                                           \
+    handle_##op:                                                        \
+    {                                                                   \
+        auto& instruction = static_cast<Op::op const&>(*pc);            \
+        if (is_instrumented) [[unlikely]]                               \
+            instrument(Instruction::Type::op, *block, pc.offset());     \
+        instruction.execute_impl(*this);                                \
+        if constexpr (!Op::op::IsTerminator) {                          \
+            if (!vm().exception()) [[likely]] {                         \
+                pc.jump(pc.offset() + instruction_length(instruction)); \
+                if (pc.at_end())                                        \
+                    continue;                                           \
+                goto* dispatch_table[to_underlying((*pc).type())];      \
+            }                                                           \
+        }                                                               \
+        goto handle_side_effects;                                       \
+    }
+
+            ENUMERATE_BYTECODE_OPS(__BYTECODE_OP)
+#    undef __BYTECODE_OP
+
+        handle_side_effects:
+#else
+            if (is_instrumented)
+                instrument((*pc).type(), *block, pc.offset());
+            (*pc).execute(*this);
+#endif
             if (vm().exception()) {
                 m_saved_exception = {};
-                if (m_unwind_contexts.is_empty())
+                if (m_unwind_contexts.size() == unwind_contexts_base)
                     break;
                 auto& unwind_context = m_unwind_contexts.last();
                 if (unwind_context.handler) {
@@ -85,12 +140,14 @@ Value Interpreter::run(Executable const& executable, BasicBlock const* entry_poi
                     accumulator() = vm().exception()->value();
                     vm().clear_exception();
                     will_jump = true;
+                    break;
                 } else if (unwind_context.finalizer) {
                     block = unwind_context.finalizer;
                     m_unwind_contexts.take_last();
                     will_jump = true;
                     m_saved_exception = Handle<Exception>::create(vm().exception());
                     vm().clear_exception();
+                    break;
                 }
             }
             if (m_pending_jump.has_value()) {
@@ -148,6 +205,14 @@ Value Interpreter::run(Executable const& executable, BasicBlock const* entry_poi
     return return_value;
 }
 
+void Interpreter::instrument(Instruction::Type type, BasicBlock const& block, size_t offset)
+{
+    if (m_statistics)
+        m_statistics->record(type);
+    if (auto* profiler = vm().sampling_profiler(); profiler && profiler->has_pending_sample())
+        profiler->take_sample(block.source_range_at(offset), Instruction::type_name(type));
+}
+
 void Interpreter::enter_unwind_context(Optional<Label> handler_target, Optional<Label> finalizer_target)
 {
     m_unwind_contexts.empend(handler_target.has_value() ? &handler_target->block() : nullptr, finalizer_target.has_value() ? &finalizer_target->block() : nullptr);
@@ -168,6 +233,40 @@ void Interpreter::continue_pending_unwind(Label const& resume_label)
     }
 }
 
+void ExecutionStatistics::dump() const
+{
+    constexpr size_t max_entries_to_show = 15;
+
+    auto dump_top_entries = [&](auto const& counts, auto name_of) {
+        Vector<size_t> indices;
+        for (size_t i = 0; i < counts.size(); ++i) {
+            if (counts[i] != 0)
+                indices.append(i);
+        }
+        quick_sort(indices, [&](auto a, auto b) { return counts[a] > counts[b]; });
+        for (size_t i = 0; i < min(indices.size(), max_entries_to_show); ++i) {
+            auto count = counts[indices[i]];
+            warnln("{:>12} {:>5.1}% {}", count, 100.0 * count / executed_instructions, name_of(indices[i]));
+        }
+    };
+
+    warnln("Executed {} instructions", executed_instructions);
+    if (executed_instructions == 0)
+        return;
+
+    warnln("Most executed instructions:");
+    dump_top_entries(instruction_counts, [](size_t index) {
+        return String(Instruction::type_name(static_cast<Instruction::Type>(index)));
+    });
+
+    warnln("Most executed pairs of instructions:");
+    dump_top_entries(pair_counts, [](size_t index) {
+        return String::formatted("{}, {}",
+            Instruction::type_name(static_cast<Instruction::Type>(index / Instruction::type_count)),
+            Instruction::type_name(static_cast<Instruction::Type>(index % Instruction::type_count)));
+    });
+}
+
 AK::Array<OwnPtr<PassManager>, static_cast<UnderlyingType<Interpreter::OptimizationLevel>>(Interpreter::OptimizationLevel::__Count)> Interpreter::s_optimization_pipelines {};
 
 Bytecode::PassManager& Interpreter::optimization_pipeline(Interpreter::OptimizationLevel level)
@@ -191,6 +290,14 @@ Bytecode::PassManager& Interpreter::optimization_pipeline(Interpreter::Optimizat
         pm->add<Passes::MergeBlocks>();
         pm->add<Passes::GenerateCFG>();
         pm->add<Passes::PlaceBlocks>();
+        pm->add<Passes::EliminateRedundantLoadsAndStores>();
+        pm->add<Passes::GenerateCFG>();
+        pm->add<Passes::GenerateLiveness>();
+        pm->add<Passes::AllocateRegisters>();
+        pm->add<Passes::EliminateRedundantLoadsAndStores>();
+        pm->add<Passes::GenerateLiveness>();
+        pm->add<Passes::EliminateDeadStores>();
+        pm->add<Passes::CombineInstructions>();
     } else {
         VERIFY_NOT_REACHED();
     }
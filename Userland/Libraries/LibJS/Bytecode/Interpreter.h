@@ -8,6 +8,8 @@
 
 #include "Generator.h"
 #include "PassManager.h"
+#include <AK/Array.h>
+#include <LibJS/Bytecode/Instruction.h>
 #include <LibJS/Bytecode/Label.h>
 #include <LibJS/Bytecode/Register.h>
 #include <LibJS/Forward.h>
@@ -20,6 +22,28 @@ namespace JS::Bytecode {
 
 using RegisterWindow = Vector<Value>;
 
+// What the interpreter has executed, for finding out which instructions are worth making faster
+// or combining into one.
+struct ExecutionStatistics {
+    void record(Instruction::Type type)
+    {
+        ++executed_instructions;
+        ++instruction_counts[to_underlying(type)];
+        if (previous_type.has_value())
+            ++pair_counts[to_underlying(*previous_type) * Instruction::type_count + to_underlying(type)];
+        previous_type = type;
+    }
+
+    void dump() const;
+
+    u64 executed_instructions { 0 };
+    AK::Array<u64, Instruction::type_count> instruction_counts {};
+
+    // How often each instruction was directly followed by each other instruction in the same block.
+    AK::Array<u64, Instruction::type_count * Instruction::type_count> pair_counts {};
+    Optional<Instruction::Type> previous_type;
+};
+
 class Interpreter {
 public:
     explicit Interpreter(GlobalObject&);
@@ -67,9 +91,15 @@ public:
     };
     static Bytecode::PassManager& optimization_pipeline(OptimizationLevel = OptimizationLevel::Default);
 
+    void enable_statistics() { m_statistics = make<ExecutionStatistics>(); }
+    ExecutionStatistics const* statistics() const { return m_statistics; }
+
 private:
     RegisterWindow& registers() { return m_register_windows.last(); }
 
+    // Keeps the statistics and the sampling profiler up to date. This is only called while one of them is enabled.
+    void instrument(Instruction::Type, BasicBlock const&, size_t offset);
+
     static AK::Array<OwnPtr<PassManager>, static_cast<UnderlyingType<Interpreter::OptimizationLevel>>(Interpreter::OptimizationLevel::__Count)> s_optimization_pipelines;
 
     VM& m_vm;
@@ -81,6 +111,7 @@ private:
     Executable const* m_current_executable { nullptr };
     Vector<UnwindInfo> m_unwind_contexts;
     Handle<Exception> m_saved_exception;
+    OwnPtr<ExecutionStatistics> m_statistics;
 };
 
 }
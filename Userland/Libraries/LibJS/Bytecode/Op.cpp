@@ -215,26 +215,65 @@ void ConcatString::execute_impl(Bytecode::Interpreter& interpreter) const
     interpreter.reg(m_lhs) = add(interpreter.global_object(), interpreter.reg(m_lhs), interpreter.accumulator());
 }
 
+static void get_variable(Bytecode::Interpreter& interpreter, StringTableIndex identifier)
+{
+    interpreter.accumulator() = interpreter.vm().get_variable(interpreter.current_executable().get_string(identifier), interpreter.global_object());
+}
+
 void GetVariable::execute_impl(Bytecode::Interpreter& interpreter) const
 {
-    interpreter.accumulator() = interpreter.vm().get_variable(interpreter.current_executable().get_string(m_identifier), interpreter.global_object());
+    get_variable(interpreter, m_identifier);
+}
+
+static void set_variable(Bytecode::Interpreter& interpreter, StringTableIndex identifier)
+{
+    interpreter.vm().set_variable(interpreter.current_executable().get_string(identifier), interpreter.accumulator(), interpreter.global_object());
 }
 
 void SetVariable::execute_impl(Bytecode::Interpreter& interpreter) const
 {
-    interpreter.vm().set_variable(interpreter.current_executable().get_string(m_identifier), interpreter.accumulator(), interpreter.global_object());
+    set_variable(interpreter, m_identifier);
+}
+
+static void get_by_id(Bytecode::Interpreter& interpreter, StringTableIndex property, size_t cache_index)
+{
+    auto* object = interpreter.accumulator().to_object(interpreter.global_object());
+    if (!object)
+        return;
+
+    auto& cache = interpreter.current_executable().property_lookup_caches[cache_index];
+    if (auto value = cache.get(*object); value.has_value()) {
+        interpreter.accumulator() = *value;
+        return;
+    }
+
+    PropertyName property_name = interpreter.current_executable().get_string(property);
+    interpreter.accumulator() = object->get(property_name);
+    if (!interpreter.vm().exception())
+        cache.fill_for_get(*object, property_name);
 }
 
 void GetById::execute_impl(Bytecode::Interpreter& interpreter) const
 {
-    if (auto* object = interpreter.accumulator().to_object(interpreter.global_object()))
-        interpreter.accumulator() = object->get(interpreter.current_executable().get_string(m_property));
+    get_by_id(interpreter, m_property, m_cache_index);
 }
 
 void PutById::execute_impl(Bytecode::Interpreter& interpreter) const
 {
-    if (auto* object = interpreter.reg(m_base).to_object(interpreter.global_object()))
-        object->set(interpreter.current_executable().get_string(m_property), interpreter.accumulator(), true);
+    auto* object = interpreter.reg(m_base).to_object(interpreter.global_object());
+    if (!object)
+        return;
+
+    auto& cache = interpreter.current_executable().property_lookup_caches[m_cache_index];
+    if (cache.put(*object, interpreter.accumulator()))
+        return;
+
+    // Adding a property gives the object a new shape, which isn't worth remembering here.
+    auto const* shape_before_put = &object->shape();
+    PropertyName property_name = interpreter.current_executable().get_string(m_property);
+    object->set(property_name, interpreter.accumulator(), true);
+    if (!interpreter.vm().exception() && &object->shape() == shape_before_put)
+        cache.fill_for_put(*object, property_name);
 }
 
 void Jump::execute_impl(Bytecode::Interpreter& interpreter) const
@@ -295,17 +334,20 @@ void Call::execute_impl(Bytecode::Interpreter& interpreter) const
 
     Value return_value;
 
-    if (m_argument_count == 0 && m_type == CallType::Call) {
-        return_value = interpreter.vm().call(function, this_value);
+    if (m_type == CallType::Call) {
+        // The arguments are still in our registers, which keeps them alive, so they don't have to be
+        // registered with the heap while we pass them on.
+        Vector<Value, 8> argument_values;
+        argument_values.ensure_capacity(m_argument_count);
+        for (size_t i = 0; i < m_argument_count; ++i)
+            argument_values.unchecked_append(interpreter.reg(m_arguments[i]));
+        return_value = interpreter.vm().call(function, this_value, Span<Value const> { argument_values.span() });
     } else {
         MarkedValueList argument_values { interpreter.vm().heap() };
         for (size_t i = 0; i < m_argument_count; ++i) {
             argument_values.append(interpreter.reg(m_arguments[i]));
         }
-        if (m_type == CallType::Call)
-            return_value = interpreter.vm().call(function, this_value, move(argument_values));
-        else
-            return_value = interpreter.vm().construct(function, function, move(argument_values));
+        return_value = interpreter.vm().construct(function, function, move(argument_values));
     }
 
     interpreter.accumulator() = return_value;
@@ -314,7 +356,7 @@ void Call::execute_impl(Bytecode::Interpreter& interpreter) const
 void NewFunction::execute_impl(Bytecode::Interpreter& interpreter) const
 {
     auto& vm = interpreter.vm();
-    interpreter.accumulator() = OrdinaryFunctionObject::create(interpreter.global_object(), m_function_node.name(), m_function_node.body(), m_function_node.parameters(), m_function_node.function_length(), vm.lexical_environment(), m_function_node.kind(), m_function_node.is_strict_mode(), m_function_node.is_arrow_function());
+    interpreter.accumulator() = OrdinaryFunctionObject::create(interpreter.global_object(), m_function_node, vm.lexical_environment(), m_function_node.is_strict_mode());
 }
 
 void Return::execute_impl(Bytecode::Interpreter& interpreter) const
@@ -322,7 +364,7 @@ void Return::execute_impl(Bytecode::Interpreter& interpreter) const
     interpreter.do_return(interpreter.accumulator().value_or(js_undefined()));
 }
 
-void Increment::execute_impl(Bytecode::Interpreter& interpreter) const
+static void increment(Bytecode::Interpreter& interpreter)
 {
     auto old_value = interpreter.accumulator().to_numeric(interpreter.global_object());
     if (interpreter.vm().exception())
@@ -334,7 +376,12 @@ void Increment::execute_impl(Bytecode::Interpreter& interpreter) const
         interpreter.accumulator() = js_bigint(interpreter.vm().heap(), old_value.as_bigint().big_integer().plus(Crypto::SignedBigInteger { 1 }));
 }
 
-void Decrement::execute_impl(Bytecode::Interpreter& interpreter) const
+void Increment::execute_impl(Bytecode::Interpreter& interpreter) const
+{
+    increment(interpreter);
+}
+
+static void decrement(Bytecode::Interpreter& interpreter)
 {
     auto old_value = interpreter.accumulator().to_numeric(interpreter.global_object());
     if (interpreter.vm().exception())
@@ -346,6 +393,11 @@ void Decrement::execute_impl(Bytecode::Interpreter& interpreter) const
         interpreter.accumulator() = js_bigint(interpreter.vm().heap(), old_value.as_bigint().big_integer().minus(Crypto::SignedBigInteger { 1 }));
 }
 
+void Decrement::execute_impl(Bytecode::Interpreter& interpreter) const
+{
+    decrement(interpreter);
+}
+
 void Throw::execute_impl(Bytecode::Interpreter& interpreter) const
 {
     interpreter.vm().throw_exception(interpreter.global_object(), interpreter.accumulator());
@@ -460,6 +512,56 @@ void NewClass::execute_impl(Bytecode::Interpreter&) const
     TODO();
 }
 
+// The second half of a superinstruction is skipped if the first one throws, just like the second
+// instruction would be.
+
+void GetVariableAndStore::execute_impl(Bytecode::Interpreter& interpreter) const
+{
+    get_variable(interpreter, m_identifier);
+    if (!interpreter.vm().exception())
+        interpreter.reg(m_dst) = interpreter.accumulator();
+}
+
+void GetByIdAndStore::execute_impl(Bytecode::Interpreter& interpreter) const
+{
+    get_by_id(interpreter, m_property, m_cache_index);
+    if (!interpreter.vm().exception())
+        interpreter.reg(m_dst) = interpreter.accumulator();
+}
+
+#define JS_DEFINE_UPDATE_AND_SET_VARIABLE_OP(OpTitleCase, UpdateOp, update_op_snake_case)                            \
+    void OpTitleCase::execute_impl(Bytecode::Interpreter& interpreter) const                                         \
+    {                                                                                                                \
+        update_op_snake_case(interpreter);                                                                           \
+        if (!interpreter.vm().exception())                                                                           \
+            set_variable(interpreter, m_identifier);                                                                 \
+    }                                                                                                                \
+    String OpTitleCase::to_string_impl(Bytecode::Executable const& executable) const                                 \
+    {                                                                                                                \
+        return String::formatted(#OpTitleCase " {} ({})", m_identifier, executable.string_table->get(m_identifier)); \
+    }
+
+JS_ENUMERATE_UPDATE_AND_SET_VARIABLE_OPS(JS_DEFINE_UPDATE_AND_SET_VARIABLE_OP)
+
+#define JS_DEFINE_COMPARE_AND_JUMP_OP(OpTitleCase, CompareOp, compare_op_snake_case)                                             \
+    void OpTitleCase::execute_impl(Bytecode::Interpreter& interpreter) const                                                     \
+    {                                                                                                                            \
+        auto result = compare_op_snake_case(interpreter.global_object(), interpreter.reg(m_lhs_reg), interpreter.accumulator()); \
+        if (interpreter.vm().exception())                                                                                        \
+            return;                                                                                                              \
+        interpreter.accumulator() = result;                                                                                      \
+        if (result.as_bool())                                                                                                    \
+            interpreter.jump(*m_true_target);                                                                                    \
+        else                                                                                                                     \
+            interpreter.jump(*m_false_target);                                                                                   \
+    }                                                                                                                            \
+    String OpTitleCase::to_string_impl(Bytecode::Executable const&) const                                                        \
+    {                                                                                                                            \
+        return String::formatted(#OpTitleCase " {} true:{} false:{}", m_lhs_reg, *m_true_target, *m_false_target);               \
+    }
+
+JS_ENUMERATE_COMPARE_AND_JUMP_OPS(JS_DEFINE_COMPARE_AND_JUMP_OP)
+
 String Load::to_string_impl(Bytecode::Executable const&) const
 {
     return String::formatted("Load {}", m_src);
@@ -549,12 +651,12 @@ String SetVariable::to_string_impl(Bytecode::Executable const& executable) const
 
 String PutById::to_string_impl(Bytecode::Executable const& executable) const
 {
-    return String::formatted("PutById base:{}, property:{} ({})", m_base, m_property, executable.string_table->get(m_property));
+    return String::formatted("PutById base:{}, property:{} ({}) [cache: {}]", m_base, m_property, executable.string_table->get(m_property), executable.property_lookup_caches[m_cache_index].to_string());
 }
 
 String GetById::to_string_impl(Bytecode::Executable const& executable) const
 {
-    return String::formatted("GetById {} ({})", m_property, executable.string_table->get(m_property));
+    return String::formatted("GetById {} ({}) [cache: {}]", m_property, executable.string_table->get(m_property), executable.property_lookup_caches[m_cache_index].to_string());
 }
 
 String Jump::to_string_impl(Bytecode::Executable const&) const
@@ -700,4 +802,14 @@ String IteratorResultValue::to_string_impl(Executable const&) const
     return "IteratorResultValue";
 }
 
+String GetVariableAndStore::to_string_impl(Bytecode::Executable const& executable) const
+{
+    return String::formatted("GetVariableAndStore {} ({}) {}", m_identifier, executable.string_table->get(m_identifier), m_dst);
+}
+
+String GetByIdAndStore::to_string_impl(Bytecode::Executable const& executable) const
+{
+    return String::formatted("GetByIdAndStore {} ({}) {} [cache: {}]", m_property, executable.string_table->get(m_property), m_dst, executable.property_lookup_caches[m_cache_index].to_string());
+}
+
 }
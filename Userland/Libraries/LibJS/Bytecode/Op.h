@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <AK/Function.h>
 #include <LibCrypto/BigInt/SignedBigInteger.h>
 #include <LibJS/Bytecode/Instruction.h>
 #include <LibJS/Bytecode/Label.h>
@@ -30,6 +31,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const& visitor) { visitor(m_src, RegisterAccess::Read); }
 
 private:
     Register m_src;
@@ -46,6 +48,9 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
+
+    Value value() const { return m_value; }
 
 private:
     Value m_value;
@@ -62,6 +67,9 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const& visitor) { visitor(m_dst, RegisterAccess::Write); }
+
+    Register dst() const { return m_dst; }
 
 private:
     Register m_dst;
@@ -103,6 +111,12 @@ private:
         void execute_impl(Bytecode::Interpreter&) const;                       \
         String to_string_impl(Bytecode::Executable const&) const;              \
         void replace_references_impl(BasicBlock const&, BasicBlock const&) { } \
+        void visit_registers_impl(RegisterVisitor const& visitor)              \
+        {                                                                      \
+            visitor(m_lhs_reg, RegisterAccess::Read);                          \
+        }                                                                      \
+                                                                               \
+        Register lhs() const { return m_lhs_reg; }                             \
                                                                                \
     private:                                                                   \
         Register m_lhs_reg;                                                    \
@@ -129,6 +143,7 @@ JS_ENUMERATE_COMMON_BINARY_OPS(JS_DECLARE_COMMON_BINARY_OP)
         void execute_impl(Bytecode::Interpreter&) const;                       \
         String to_string_impl(Bytecode::Executable const&) const;              \
         void replace_references_impl(BasicBlock const&, BasicBlock const&) { } \
+        void visit_registers_impl(RegisterVisitor const&) { }                  \
     };
 
 JS_ENUMERATE_COMMON_UNARY_OPS(JS_DECLARE_COMMON_UNARY_OP)
@@ -145,6 +160,9 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
+
+    StringTableIndex string() const { return m_string; }
 
 private:
     StringTableIndex m_string;
@@ -160,6 +178,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
 };
 
 class NewRegExp final : public Instruction {
@@ -174,6 +193,10 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
+
+    StringTableIndex source_index() const { return m_source_index; }
+    StringTableIndex flags_index() const { return m_flags_index; }
 
 private:
     StringTableIndex m_source_index;
@@ -195,9 +218,17 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const& visitor)
+    {
+        visitor(m_from_object, RegisterAccess::Read);
+        for (size_t i = 0; i < m_excluded_names_count; i++)
+            visitor(m_excluded_names[i], RegisterAccess::Read);
+    }
 
     size_t length_impl() const { return sizeof(*this) + sizeof(Register) * m_excluded_names_count; }
 
+    size_t excluded_names_count() const { return m_excluded_names_count; }
+
 private:
     Register m_from_object;
     size_t m_excluded_names_count { 0 };
@@ -215,6 +246,9 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
+
+    Crypto::SignedBigInteger const& bigint() const { return m_bigint; }
 
 private:
     Crypto::SignedBigInteger m_bigint;
@@ -240,12 +274,19 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const& visitor)
+    {
+        for (size_t i = 0; i < m_element_count; ++i)
+            visitor(m_elements[i], RegisterAccess::Read);
+    }
 
     size_t length_impl() const
     {
         return sizeof(*this) + sizeof(Register) * m_element_count;
     }
 
+    size_t element_count() const { return m_element_count; }
+
 private:
     size_t m_element_count { 0 };
     Register m_elements[];
@@ -261,6 +302,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
 };
 
 class ConcatString final : public Instruction {
@@ -274,6 +316,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const& visitor) { visitor(m_lhs, RegisterAccess::ReadWrite); }
 
 private:
     Register m_lhs;
@@ -290,6 +333,9 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
+
+    StringTableIndex identifier() const { return m_identifier; }
 
 private:
     StringTableIndex m_identifier;
@@ -306,6 +352,9 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
+
+    StringTableIndex identifier() const { return m_identifier; }
 
 private:
     StringTableIndex m_identifier;
@@ -313,36 +362,48 @@ private:
 
 class GetById final : public Instruction {
 public:
-    explicit GetById(StringTableIndex property)
+    GetById(StringTableIndex property, size_t cache_index)
         : Instruction(Type::GetById)
         , m_property(property)
+        , m_cache_index(cache_index)
     {
     }
 
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
+
+    StringTableIndex property() const { return m_property; }
+    size_t cache_index() const { return m_cache_index; }
 
 private:
     StringTableIndex m_property;
+    size_t m_cache_index { 0 };
 };
 
 class PutById final : public Instruction {
 public:
-    explicit PutById(Register base, StringTableIndex property)
+    PutById(Register base, StringTableIndex property, size_t cache_index)
         : Instruction(Type::PutById)
         , m_base(base)
         , m_property(property)
+        , m_cache_index(cache_index)
     {
     }
 
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const& visitor) { visitor(m_base, RegisterAccess::Read); }
+
+    StringTableIndex property() const { return m_property; }
+    size_t cache_index() const { return m_cache_index; }
 
 private:
     Register m_base;
     StringTableIndex m_property;
+    size_t m_cache_index { 0 };
 };
 
 class GetByValue final : public Instruction {
@@ -356,6 +417,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const& visitor) { visitor(m_base, RegisterAccess::Read); }
 
 private:
     Register m_base;
@@ -373,6 +435,11 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const& visitor)
+    {
+        visitor(m_base, RegisterAccess::Read);
+        visitor(m_property, RegisterAccess::Read);
+    }
 
 private:
     Register m_base;
@@ -406,6 +473,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&);
+    void visit_registers_impl(RegisterVisitor const&) { }
 
     auto& true_target() const { return m_true_target; }
     auto& false_target() const { return m_false_target; }
@@ -470,12 +538,22 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const& visitor)
+    {
+        visitor(m_callee, RegisterAccess::Read);
+        visitor(m_this_value, RegisterAccess::Read);
+        for (size_t i = 0; i < m_argument_count; ++i)
+            visitor(m_arguments[i], RegisterAccess::Read);
+    }
 
     size_t length_impl() const
     {
         return sizeof(*this) + sizeof(Register) * m_argument_count;
     }
 
+    CallType call_type() const { return m_type; }
+    size_t argument_count() const { return m_argument_count; }
+
 private:
     Register m_callee;
     Register m_this_value;
@@ -495,6 +573,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
 
 private:
     ClassExpression const& m_class_expression;
@@ -511,6 +590,9 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
+
+    FunctionNode const& function_node() const { return m_function_node; }
 
 private:
     FunctionNode const& m_function_node;
@@ -528,6 +610,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
 };
 
 class Increment final : public Instruction {
@@ -540,6 +623,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
 };
 
 class Decrement final : public Instruction {
@@ -552,6 +636,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
 };
 
 class Throw final : public Instruction {
@@ -566,6 +651,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
 };
 
 class EnterUnwindContext final : public Instruction {
@@ -583,6 +669,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&);
+    void visit_registers_impl(RegisterVisitor const&) { }
 
     auto& entry_point() const { return m_entry_point; }
     auto& handler_target() const { return m_handler_target; }
@@ -604,6 +691,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
 };
 
 class ContinuePendingUnwind final : public Instruction {
@@ -619,6 +707,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&);
+    void visit_registers_impl(RegisterVisitor const&) { }
 
     auto& resume_target() const { return m_resume_target; }
 
@@ -644,6 +733,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&);
+    void visit_registers_impl(RegisterVisitor const&) { }
 
     auto& continuation() const { return m_continuation_label; }
 
@@ -662,6 +752,9 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
+
+    HashMap<u32, Variable> const& variables() const { return m_variables; }
 
 private:
     HashMap<u32, Variable> m_variables;
@@ -677,6 +770,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
 };
 
 class IteratorNext final : public Instruction {
@@ -689,6 +783,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
 };
 
 class IteratorResultDone final : public Instruction {
@@ -701,6 +796,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
 };
 
 class IteratorResultValue final : public Instruction {
@@ -713,8 +809,123 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const&) { }
+};
+
+// The instructions below are superinstructions: each of them does the same thing as a sequence of two
+// instructions that is common enough to be worth dispatching only once. The generator never emits
+// them, they are created by the CombineInstructions pass.
+
+// GetVariable followed by Store.
+class GetVariableAndStore final : public Instruction {
+public:
+    GetVariableAndStore(StringTableIndex identifier, Register dst)
+        : Instruction(Type::GetVariableAndStore)
+        , m_identifier(identifier)
+        , m_dst(dst)
+    {
+    }
+
+    void execute_impl(Bytecode::Interpreter&) const;
+    String to_string_impl(Bytecode::Executable const&) const;
+    void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const& visitor) { visitor(m_dst, RegisterAccess::Write); }
+
+    StringTableIndex identifier() const { return m_identifier; }
+
+private:
+    StringTableIndex m_identifier;
+    Register m_dst;
+};
+
+// GetById followed by Store, which is how a method is looked up before it is called.
+class GetByIdAndStore final : public Instruction {
+public:
+    GetByIdAndStore(StringTableIndex property, size_t cache_index, Register dst)
+        : Instruction(Type::GetByIdAndStore)
+        , m_property(property)
+        , m_cache_index(cache_index)
+        , m_dst(dst)
+    {
+    }
+
+    void execute_impl(Bytecode::Interpreter&) const;
+    String to_string_impl(Bytecode::Executable const&) const;
+    void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_registers_impl(RegisterVisitor const& visitor) { visitor(m_dst, RegisterAccess::Write); }
+
+    StringTableIndex property() const { return m_property; }
+    size_t cache_index() const { return m_cache_index; }
+
+private:
+    StringTableIndex m_property;
+    size_t m_cache_index { 0 };
+    Register m_dst;
 };
 
+// Increment or Decrement followed by SetVariable, as in "i++".
+#define JS_ENUMERATE_UPDATE_AND_SET_VARIABLE_OPS(O)  \
+    O(IncrementAndSetVariable, Increment, increment) \
+    O(DecrementAndSetVariable, Decrement, decrement)
+
+#define JS_DECLARE_UPDATE_AND_SET_VARIABLE_OP(OpTitleCase, UpdateOp, update_op_snake_case) \
+    class OpTitleCase final : public Instruction {                                         \
+    public:                                                                                \
+        explicit OpTitleCase(StringTableIndex identifier)                                  \
+            : Instruction(Type::OpTitleCase)                                               \
+            , m_identifier(identifier)                                                     \
+        {                                                                                  \
+        }                                                                                  \
+                                                                                           \
+        void execute_impl(Bytecode::Interpreter&) const;                                   \
+        String to_string_impl(Bytecode::Executable const&) const;                          \
+        void replace_references_impl(BasicBlock const&, BasicBlock const&) { }             \
+        void visit_registers_impl(RegisterVisitor const&) { }                              \
+                                                                                           \
+        StringTableIndex identifier() const { return m_identifier; }                       \
+                                                                                           \
+    private:                                                                               \
+        StringTableIndex m_identifier;                                                     \
+    };
+
+JS_ENUMERATE_UPDATE_AND_SET_VARIABLE_OPS(JS_DECLARE_UPDATE_AND_SET_VARIABLE_OP)
+#undef JS_DECLARE_UPDATE_AND_SET_VARIABLE_OP
+
+// A comparison followed by JumpConditional. The result of the comparison is left in the accumulator,
+// in case the code that is jumped to needs it.
+#define JS_ENUMERATE_COMPARE_AND_JUMP_OPS(O)                         \
+    O(JumpGreaterThan, GreaterThan, greater_than)                    \
+    O(JumpGreaterThanEquals, GreaterThanEquals, greater_than_equals) \
+    O(JumpLessThan, LessThan, less_than)                             \
+    O(JumpLessThanEquals, LessThanEquals, less_than_equals)          \
+    O(JumpAbstractInequals, AbstractInequals, abstract_inequals)     \
+    O(JumpAbstractEquals, AbstractEquals, abstract_equals)           \
+    O(JumpTypedInequals, TypedInequals, typed_inequals)              \
+    O(JumpTypedEquals, TypedEquals, typed_equals)
+
+#define JS_DECLARE_COMPARE_AND_JUMP_OP(OpTitleCase, CompareOp, compare_op_snake_case)            \
+    class OpTitleCase final : public Jump {                                                      \
+    public:                                                                                      \
+        OpTitleCase(Register lhs_reg, Optional<Label> true_target, Optional<Label> false_target) \
+            : Jump(Type::OpTitleCase, move(true_target), move(false_target))                     \
+            , m_lhs_reg(lhs_reg)                                                                 \
+        {                                                                                        \
+        }                                                                                        \
+                                                                                                 \
+        void execute_impl(Bytecode::Interpreter&) const;                                         \
+        String to_string_impl(Bytecode::Executable const&) const;                                \
+        void visit_registers_impl(RegisterVisitor const& visitor)                                \
+        {                                                                                        \
+            visitor(m_lhs_reg, RegisterAccess::Read);                                            \
+        }                                                                                        \
+                                                                                                 \
+    private:                                                                                     \
+        Register m_lhs_reg;                                                                      \
+    };
+
+JS_ENUMERATE_COMPARE_AND_JUMP_OPS(JS_DECLARE_COMPARE_AND_JUMP_OP)
+#undef JS_DECLARE_COMPARE_AND_JUMP_OP
+
 }
 
 namespace JS::Bytecode {
@@ -749,6 +960,21 @@ ALWAYS_INLINE void Instruction::replace_references(BasicBlock const& from, Basic
 #undef __BYTECODE_OP
 }
 
+ALWAYS_INLINE void Instruction::visit_registers(RegisterVisitor const& visitor)
+{
+#define __BYTECODE_OP(op)       \
+    case Instruction::Type::op: \
+        return static_cast<Bytecode::Op::op&>(*this).visit_registers_impl(visitor);
+
+    switch (type()) {
+        ENUMERATE_BYTECODE_OPS(__BYTECODE_OP)
+    default:
+        VERIFY_NOT_REACHED();
+    }
+
+#undef __BYTECODE_OP
+}
+
 ALWAYS_INLINE size_t Instruction::length() const
 {
     if (type() == Type::Call)
@@ -770,6 +996,16 @@ ALWAYS_INLINE size_t Instruction::length() const
 #undef __BYTECODE_OP
 }
 
+// Like Instruction::length(), for when the type of the instruction is known at compile time.
+template<typename OpType>
+ALWAYS_INLINE size_t instruction_length(OpType const& instruction)
+{
+    if constexpr (requires { instruction.length_impl(); })
+        return instruction.length_impl();
+    else
+        return sizeof(OpType);
+}
+
 ALWAYS_INLINE bool Instruction::is_terminator() const
 {
 #define __BYTECODE_OP(op) \
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/QuickSort.h>
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+static bool is_allocatable(Register const& reg)
+{
+    return reg.index() > Register::global_object_index;
+}
+
+static u32 register_of(Instruction& instruction)
+{
+    Optional<u32> index;
+    instruction.visit_registers([&](Register& reg, RegisterAccess) { index = reg.index(); });
+    return *index;
+}
+
+// The generator hands out a new register for almost every temporary value. This pass gives registers that
+// are never live at the same time the same slot in the register window, and shrinks the window to fit.
+// A register that is copied into another one through the accumulator gets the same slot as the other one
+// if their lifetimes allow it, which turns the copy into a Load and a Store of the same register that
+// EliminateRedundantLoadsAndStores can remove.
+void AllocateRegisters::perform(PassPipelineExecutable& executable)
+{
+    started();
+
+    VERIFY(executable.liveness.has_value());
+    auto liveness = executable.liveness.release_value();
+
+    HashMap<u32, HashTable<u32>> interference;
+    HashMap<u32, Vector<u32>> copies;
+    HashTable<u32> all_registers;
+
+    auto interfere = [&](u32 a, u32 b) {
+        interference.ensure(a).set(b);
+        interference.ensure(b).set(a);
+    };
+
+    for (auto& block : executable.executable.basic_blocks) {
+        Vector<Instruction*> instructions;
+        InstructionStreamIterator it { block.instruction_stream() };
+        while (!it.at_end()) {
+            instructions.append(const_cast<Instruction*>(&*it));
+            ++it;
+        }
+
+        auto live = liveness.live_out.get(&block).value_or({});
+        for (size_t i = instructions.size(); i > 0; --i) {
+            auto& instruction = *instructions[i - 1];
+
+            // A Store right after a Load copies one register into another, and the two hold the same value
+            // afterwards, so they don't interfere just because the source is still live.
+            Optional<u32> copied_register;
+            if (instruction.type() == Instruction::Type::Store && i > 1 && instructions[i - 2]->type() == Instruction::Type::Load) {
+                auto source = register_of(*instructions[i - 2]);
+                auto destination = register_of(instruction);
+                if (source > Register::global_object_index && destination > Register::global_object_index && source != destination) {
+                    copied_register = source;
+                    copies.ensure(destination).append(source);
+                    copies.ensure(source).append(destination);
+                }
+            }
+
+            Vector<u32, 4> uses;
+            instruction.visit_registers([&](Register& reg, RegisterAccess access) {
+                if (!is_allocatable(reg))
+                    return;
+                all_registers.set(reg.index());
+                if (access != RegisterAccess::Write)
+                    uses.append(reg.index());
+                if (access == RegisterAccess::Read)
+                    return;
+                for (auto live_register : live) {
+                    if (live_register != reg.index() && live_register != copied_register)
+                        interfere(reg.index(), live_register);
+                }
+                live.remove(reg.index());
+            });
+            for (auto use : uses)
+                live.set(use);
+        }
+    }
+
+    // Pinned registers keep a slot to themselves, everyone else gets the lowest slot that none of the
+    // registers it interferes with has, preferring the slot of a register it is copied from or to.
+    Vector<u32> registers;
+    for (auto reg : all_registers)
+        registers.append(reg);
+    quick_sort(registers);
+
+    HashMap<u32, u32> slots;
+    HashTable<u32> pinned_slots;
+    u32 next_slot = Register::global_object_index + 1;
+    for (auto reg : registers) {
+        if (!liveness.pinned.contains(reg))
+            continue;
+        slots.set(reg, next_slot);
+        pinned_slots.set(next_slot);
+        ++next_slot;
+    }
+
+    for (auto reg : registers) {
+        if (liveness.pinned.contains(reg))
+            continue;
+
+        HashTable<u32> taken_slots;
+        for (auto other : interference.get(reg).value_or({})) {
+            if (auto slot = slots.get(other); slot.has_value())
+                taken_slots.set(*slot);
+        }
+        auto is_free = [&](u32 slot) { return !taken_slots.contains(slot) && !pinned_slots.contains(slot); };
+
+        Optional<u32> chosen_slot;
+        for (auto other : copies.get(reg).value_or({})) {
+            if (auto slot = slots.get(other); slot.has_value() && is_free(*slot)) {
+                chosen_slot = *slot;
+                break;
+            }
+        }
+        if (!chosen_slot.has_value()) {
+            u32 slot = Register::global_object_index + 1;
+            while (!is_free(slot))
+                ++slot;
+            chosen_slot = slot;
+        }
+        slots.set(reg, *chosen_slot);
+        next_slot = max(next_slot, *chosen_slot + 1);
+    }
+
+    for (auto& block : executable.executable.basic_blocks) {
+        InstructionStreamIterator it { block.instruction_stream() };
+        while (!it.at_end()) {
+            auto& instruction = const_cast<Instruction&>(*it);
+            ++it;
+            instruction.visit_registers([&](Register& reg, RegisterAccess) {
+                if (is_allocatable(reg))
+                    reg = Register(slots.get(reg.index()).value());
+            });
+        }
+    }
+
+    executable.executable.number_of_registers = next_slot;
+
+    finished();
+}
+
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+template<typename OpType, typename... Args>
+static void replace_with(BasicBlock& block, size_t offset, size_t length, Args... args)
+{
+    new (block.replace_instructions(offset, length, sizeof(OpType))) OpType(args...);
+}
+
+// Replaces the pair of instructions at the given offset with a superinstruction, if there is one for them.
+static bool combine(BasicBlock& block, size_t offset, size_t length, Instruction const& first, Instruction const& second)
+{
+    if (second.type() == Instruction::Type::Store) {
+        auto dst = static_cast<Op::Store const&>(second).dst();
+        if (first.type() == Instruction::Type::GetVariable) {
+            replace_with<Op::GetVariableAndStore>(block, offset, length, static_cast<Op::GetVariable const&>(first).identifier(), dst);
+            return true;
+        }
+        if (first.type() == Instruction::Type::GetById) {
+            auto& get_by_id = static_cast<Op::GetById const&>(first);
+            replace_with<Op::GetByIdAndStore>(block, offset, length, get_by_id.property(), get_by_id.cache_index(), dst);
+            return true;
+        }
+        return false;
+    }
+
+    if (second.type() == Instruction::Type::SetVariable) {
+        auto identifier = static_cast<Op::SetVariable const&>(second).identifier();
+        if (first.type() == Instruction::Type::Increment) {
+            replace_with<Op::IncrementAndSetVariable>(block, offset, length, identifier);
+            return true;
+        }
+        if (first.type() == Instruction::Type::Decrement) {
+            replace_with<Op::DecrementAndSetVariable>(block, offset, length, identifier);
+            return true;
+        }
+        return false;
+    }
+
+    if (second.type() == Instruction::Type::JumpConditional) {
+        auto& jump = static_cast<Op::JumpConditional const&>(second);
+        Optional<Label> true_target = jump.true_target();
+        Optional<Label> false_target = jump.false_target();
+        switch (first.type()) {
+#define __COMPARE_AND_JUMP_OP(OpTitleCase, CompareOp, compare_op_snake_case)                                                             \
+    case Instruction::Type::CompareOp:                                                                                                   \
+        replace_with<Op::OpTitleCase>(block, offset, length, static_cast<Op::CompareOp const&>(first).lhs(), true_target, false_target); \
+        return true;
+            JS_ENUMERATE_COMPARE_AND_JUMP_OPS(__COMPARE_AND_JUMP_OP)
+#undef __COMPARE_AND_JUMP_OP
+        default:
+            return false;
+        }
+    }
+
+    return false;
+}
+
+// Replaces the most common pairs of instructions with superinstructions that do the same thing, so that
+// the interpreter only has to dispatch once for them. The pairs were picked by running some benchmarks
+// with js --bytecode-statistics. This changes the instructions in place, so it has to run last.
+void CombineInstructions::perform(PassPipelineExecutable& executable)
+{
+    started();
+
+    for (auto& block : executable.executable.basic_blocks) {
+        Vector<size_t> offsets;
+        InstructionStreamIterator it { block.instruction_stream() };
+        while (!it.at_end()) {
+            offsets.append(it.offset());
+            ++it;
+        }
+        offsets.append(block.size());
+
+        // Go backwards, so that replacing a pair doesn't move the instructions that are still to be looked at.
+        for (size_t i = offsets.size() - 1; i >= 2;) {
+            auto first_offset = offsets[i - 2];
+            auto second_offset = offsets[i - 1];
+            auto& first = *reinterpret_cast<Instruction const*>(block.instruction_stream().offset(first_offset));
+            auto& second = *reinterpret_cast<Instruction const*>(block.instruction_stream().offset(second_offset));
+            if (combine(block, first_offset, offsets[i] - first_offset, first, second))
+                i -= 2;
+            else
+                i -= 1;
+        }
+    }
+
+    finished();
+}
+
+}
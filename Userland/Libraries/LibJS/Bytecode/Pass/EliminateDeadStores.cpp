@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/QuickSort.h>
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+// Removes Stores to registers that are never read again before they're overwritten.
+void EliminateDeadStores::perform(PassPipelineExecutable& executable)
+{
+    started();
+
+    VERIFY(executable.liveness.has_value());
+    auto liveness = executable.liveness.release_value();
+
+    for (auto& block : executable.executable.basic_blocks) {
+        Vector<Instruction*> instructions;
+        Vector<size_t> offsets;
+        InstructionStreamIterator it { block.instruction_stream() };
+        while (!it.at_end()) {
+            instructions.append(const_cast<Instruction*>(&*it));
+            offsets.append(it.offset());
+            ++it;
+        }
+
+        Vector<size_t> dead_stores;
+        auto live = liveness.live_out.get(&block).value_or({});
+        for (size_t i = instructions.size(); i > 0; --i) {
+            auto& instruction = *instructions[i - 1];
+            bool is_dead_store = false;
+            Vector<u32, 4> uses;
+            instruction.visit_registers([&](Register& reg, RegisterAccess access) {
+                if (reg.index() <= Register::global_object_index)
+                    return;
+                if (access != RegisterAccess::Write) {
+                    uses.append(reg.index());
+                    return;
+                }
+                if (instruction.type() == Instruction::Type::Store && !live.contains(reg.index()) && !liveness.pinned.contains(reg.index()))
+                    is_dead_store = true;
+                live.remove(reg.index());
+            });
+            for (auto use : uses)
+                live.set(use);
+            if (is_dead_store)
+                dead_stores.append(offsets[i - 1]);
+        }
+
+        quick_sort(dead_stores);
+        block.remove_instructions(dead_stores);
+    }
+
+    finished();
+}
+
+}
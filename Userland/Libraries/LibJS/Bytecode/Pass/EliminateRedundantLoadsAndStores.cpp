@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/QuickSort.h>
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+// Instructions that put a new value in the accumulator without looking at the old one.
+static bool overwrites_accumulator(Instruction const& instruction)
+{
+    switch (instruction.type()) {
+    case Instruction::Type::Load:
+    case Instruction::Type::LoadImmediate:
+    case Instruction::Type::NewBigInt:
+    case Instruction::Type::NewString:
+    case Instruction::Type::NewObject:
+    case Instruction::Type::NewArray:
+    case Instruction::Type::NewFunction:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Removes the accumulator shuffling the generator leaves behind: a Load of a register the accumulator
+// already holds, a Store of the accumulator into a register that already holds it, and a Load whose
+// value is thrown away by the next instruction. This only looks at one block at a time.
+void EliminateRedundantLoadsAndStores::perform(PassPipelineExecutable& executable)
+{
+    started();
+
+    for (auto& block : executable.executable.basic_blocks) {
+        Vector<size_t> redundant_instructions;
+
+        // The registers that are known to hold the same value as the accumulator.
+        Vector<u32, 4> copies_of_accumulator;
+        Optional<size_t> pending_load;
+
+        InstructionStreamIterator it { block.instruction_stream() };
+        while (!it.at_end()) {
+            auto offset = it.offset();
+            auto& instruction = const_cast<Instruction&>(*it);
+            ++it;
+
+            Optional<u32> index;
+            if (instruction.type() == Instruction::Type::Load || instruction.type() == Instruction::Type::Store) {
+                instruction.visit_registers([&](Register& reg, RegisterAccess) { index = reg.index(); });
+                if (*index <= Register::global_object_index)
+                    index.clear();
+            }
+
+            if (index.has_value() && copies_of_accumulator.contains_slow(*index)) {
+                redundant_instructions.append(offset);
+                continue;
+            }
+
+            if (pending_load.has_value() && overwrites_accumulator(instruction))
+                redundant_instructions.append(*pending_load);
+            pending_load.clear();
+
+            if (index.has_value()) {
+                if (instruction.type() == Instruction::Type::Load) {
+                    copies_of_accumulator.clear();
+                    pending_load = offset;
+                }
+                copies_of_accumulator.append(*index);
+                continue;
+            }
+
+            // Everything else might change the accumulator, and a few instructions write to registers too.
+            copies_of_accumulator.clear();
+        }
+
+        quick_sort(redundant_instructions);
+        block.remove_instructions(redundant_instructions);
+    }
+
+    finished();
+}
+
+}
@@ -58,7 +58,12 @@ void GenerateCFG::perform(PassPipelineExecutable& executable)
             continue;
         }
 
-        if (instruction.type() == Instruction::Type::JumpConditional || instruction.type() == Instruction::Type::JumpNullish || instruction.type() == Instruction::Type::JumpUndefined) {
+        bool is_conditional_jump = instruction.type() == Instruction::Type::JumpConditional || instruction.type() == Instruction::Type::JumpNullish || instruction.type() == Instruction::Type::JumpUndefined;
+#define __COMPARE_AND_JUMP_OP(OpTitleCase, ...) is_conditional_jump |= instruction.type() == Instruction::Type::OpTitleCase;
+        JS_ENUMERATE_COMPARE_AND_JUMP_OPS(__COMPARE_AND_JUMP_OP)
+#undef __COMPARE_AND_JUMP_OP
+
+        if (is_conditional_jump) {
             auto& true_target = static_cast<Op::Jump const&>(instruction).true_target();
             enter_label(true_target, current_block);
             auto& false_target = static_cast<Op::Jump const&>(instruction).false_target();
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+// The accumulator and the global object are used implicitly by most instructions, so they are left alone.
+static bool is_allocatable(Register const& reg)
+{
+    return reg.index() > Register::global_object_index;
+}
+
+void GenerateLiveness::perform(PassPipelineExecutable& executable)
+{
+    started();
+
+    VERIFY(executable.cfg.has_value());
+    VERIFY(executable.exported_blocks.has_value());
+    auto& cfg = *executable.cfg;
+    auto& blocks = executable.executable.basic_blocks;
+
+    RegisterLiveness liveness;
+    HashMap<BasicBlock const*, HashTable<u32>> uses;
+    HashMap<BasicBlock const*, HashTable<u32>> defs;
+    HashTable<u32> all_registers;
+    Vector<BasicBlock const*> handler_blocks;
+
+    for (auto& block : blocks) {
+        auto& block_uses = uses.ensure(&block);
+        auto& block_defs = defs.ensure(&block);
+        InstructionStreamIterator it { block.instruction_stream() };
+        while (!it.at_end()) {
+            auto& instruction = const_cast<Instruction&>(*it);
+            ++it;
+            instruction.visit_registers([&](Register& reg, RegisterAccess access) {
+                if (!is_allocatable(reg))
+                    return;
+                all_registers.set(reg.index());
+                if (access != RegisterAccess::Write && !block_defs.contains(reg.index()))
+                    block_uses.set(reg.index());
+                if (access != RegisterAccess::Read)
+                    block_defs.set(reg.index());
+            });
+            if (instruction.type() == Instruction::Type::EnterUnwindContext) {
+                auto& enter = static_cast<Op::EnterUnwindContext const&>(instruction);
+                if (enter.handler_target().has_value())
+                    handler_blocks.append(&enter.handler_target()->block());
+                if (enter.finalizer_target().has_value())
+                    handler_blocks.append(&enter.finalizer_target()->block());
+            }
+        }
+        liveness.live_in.set(&block, block_uses);
+        liveness.live_out.set(&block, {});
+    }
+
+    // Iterate backwards until nothing changes: a register is live out of a block if it is live into one
+    // of its successors, and live into a block if it is used before it is written, or live out of it and
+    // not written at all.
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (size_t i = blocks.size(); i > 0; --i) {
+            auto const* block = &blocks[i - 1];
+            auto& live_out = liveness.live_out.find(block)->value;
+            auto& live_in = liveness.live_in.find(block)->value;
+            auto& block_defs = defs.find(block)->value;
+            auto propagate = [&](HashTable<u32> const& successor_live_in) {
+                for (auto reg : successor_live_in) {
+                    if (live_out.set(reg) != AK::HashSetResult::InsertedNewEntry)
+                        continue;
+                    if (!block_defs.contains(reg))
+                        live_in.set(reg);
+                    changed = true;
+                }
+            };
+            for (auto* successor : cfg.get(block).value_or({})) {
+                // A block that loops back to itself adds to the set it's reading from.
+                if (successor == block)
+                    propagate(HashTable<u32>(live_in));
+                else
+                    propagate(liveness.live_in.find(successor)->value);
+            }
+        }
+    }
+
+    // Anything live at the start of the executable is read before it's written, and registers that
+    // survive into an exception handler can be overwritten by any instruction that's covered by it.
+    for (auto reg : liveness.live_in.get(&blocks.first()).value_or({}))
+        liveness.pinned.set(reg);
+    for (auto* block : handler_blocks) {
+        for (auto reg : liveness.live_in.get(block).value_or({}))
+            liveness.pinned.set(reg);
+    }
+
+    // Generators are resumed in the middle of their code with a copy of the registers they started with,
+    // so don't try to be clever about them at all.
+    if (!executable.exported_blocks->is_empty())
+        liveness.pinned = move(all_registers);
+
+    executable.liveness = move(liveness);
+
+    finished();
+}
+
+}
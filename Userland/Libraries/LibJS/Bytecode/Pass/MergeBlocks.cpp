@@ -8,6 +8,15 @@
 
 namespace JS::Bytecode::Passes {
 
+static bool ends_in_unconditional_jump(BasicBlock const& block)
+{
+    for (InstructionStreamIterator it { block.instruction_stream() }; !it.at_end(); ++it) {
+        if ((*it).is_terminator())
+            return (*it).type() == Instruction::Type::Jump;
+    }
+    return false;
+}
+
 void MergeBlocks::perform(PassPipelineExecutable& executable)
 {
     started();
@@ -43,6 +52,11 @@ void MergeBlocks::perform(PassPipelineExecutable& executable)
             }
         }
 
+        // The terminator is dropped when the blocks are merged, so it must not do anything but jump to the successor,
+        // unlike ContinuePendingUnwind, which rethrows a pending exception.
+        if (!ends_in_unconditional_jump(*entry.key))
+            continue;
+
         if (auto cfg_entry = inverted_cfg.get(*entry.value.begin()); cfg_entry.has_value()) {
             auto& predecssor_entry = *cfg_entry;
             if (predecssor_entry.size() != 1)
@@ -75,7 +89,7 @@ void MergeBlocks::perform(PassPipelineExecutable& executable)
             if (!first_successor_position.has_value())
                 first_successor_position = it.index();
         }
-        for (auto& block : executable.executable.basic_blocks) {
+        auto replace_references_in = [&](BasicBlock const& block) {
             InstructionStreamIterator it { block.instruction_stream() };
             while (!it.at_end()) {
                 auto& instruction = *it;
@@ -83,7 +97,12 @@ void MergeBlocks::perform(PassPipelineExecutable& executable)
                 for (auto& entry : blocks)
                     const_cast<Instruction&>(instruction).replace_references(*entry, replacement);
             }
-        }
+        };
+        for (auto& block : executable.executable.basic_blocks)
+            replace_references_in(block);
+        // A merged block isn't part of the executable yet, but it has the instructions of the blocks it replaces,
+        // so it can jump to one of them too (like the body of a do-while loop jumping back to itself).
+        replace_references_in(replacement);
         return first_successor_position;
     };
 
@@ -150,6 +169,10 @@ void MergeBlocks::perform(PassPipelineExecutable& executable)
             }
             __builtin_memcpy(block.next_slot(), entry->instruction_stream().data(), copy_end);
             block.grow(copy_end);
+            block.copy_source_map_from(*entry, copy_end);
+            // The copied instructions can own things like the variables of PushDeclarativeEnvironment, which
+            // must not be destroyed along with the block they were copied from.
+            const_cast<BasicBlock&>(*entry).release_instructions(copy_end);
         }
 
         auto first_successor_position = replace_blocks(successors, *new_block);
@@ -13,11 +13,23 @@
 
 namespace JS::Bytecode {
 
+struct RegisterLiveness {
+    HashMap<BasicBlock const*, HashTable<u32>> live_in;
+    HashMap<BasicBlock const*, HashTable<u32>> live_out;
+
+    // Registers that can be read after control arrives somewhere without following an edge of the CFG,
+    // like an exception handler that is entered from the middle of a block. They have to keep their
+    // value all the time, so they can't share their slot with another register, and stores to them
+    // are never dead.
+    HashTable<u32> pinned;
+};
+
 struct PassPipelineExecutable {
     Executable& executable;
     Optional<HashMap<BasicBlock const*, HashTable<BasicBlock const*>>> cfg {};
     Optional<HashMap<BasicBlock const*, HashTable<BasicBlock const*>>> inverted_cfg {};
     Optional<HashTable<BasicBlock const*>> exported_blocks {};
+    Optional<RegisterLiveness> liveness {};
 };
 
 class Pass {
@@ -121,6 +133,51 @@ private:
     virtual void perform(PassPipelineExecutable&) override;
 };
 
+class GenerateLiveness : public Pass {
+public:
+    GenerateLiveness() = default;
+    ~GenerateLiveness() override = default;
+
+private:
+    virtual void perform(PassPipelineExecutable&) override;
+};
+
+class AllocateRegisters : public Pass {
+public:
+    AllocateRegisters() = default;
+    ~AllocateRegisters() override = default;
+
+private:
+    virtual void perform(PassPipelineExecutable&) override;
+};
+
+class EliminateDeadStores : public Pass {
+public:
+    EliminateDeadStores() = default;
+    ~EliminateDeadStores() override = default;
+
+private:
+    virtual void perform(PassPipelineExecutable&) override;
+};
+
+class EliminateRedundantLoadsAndStores : public Pass {
+public:
+    EliminateRedundantLoadsAndStores() = default;
+    ~EliminateRedundantLoadsAndStores() override = default;
+
+private:
+    virtual void perform(PassPipelineExecutable&) override;
+};
+
+class CombineInstructions : public Pass {
+public:
+    CombineInstructions() = default;
+    ~CombineInstructions() override = default;
+
+private:
+    virtual void perform(PassPipelineExecutable&) override;
+};
+
 class DumpCFG : public Pass {
 public:
     DumpCFG(FILE* file)
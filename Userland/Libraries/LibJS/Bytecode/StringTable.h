@@ -20,11 +20,16 @@ class StringTable {
 
 public:
     StringTable() = default;
+    explicit StringTable(Vector<String> strings)
+        : m_strings(move(strings))
+    {
+    }
 
     StringTableIndex insert(StringView string);
     String const& get(StringTableIndex) const;
     void dump() const;
     bool is_empty() const { return m_strings.is_empty(); }
+    Vector<String> const& strings() const { return m_strings; }
 
 private:
     Vector<String> m_strings;
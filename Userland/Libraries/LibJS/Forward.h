@@ -153,6 +153,7 @@ class PropertyAttributes;
 class PropertyDescriptor;
 class PropertyName;
 class Reference;
+class SamplingProfiler;
 class ScopeNode;
 class Shape;
 class Statement;
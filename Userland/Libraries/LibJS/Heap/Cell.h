@@ -9,6 +9,7 @@
 #include <AK/Format.h>
 #include <AK/Forward.h>
 #include <AK/Noncopyable.h>
+#include <AK/Platform.h>
 #include <AK/String.h>
 #include <AK/TypeCasts.h>
 #include <LibJS/Forward.h>
@@ -34,6 +35,38 @@ public:
     State state() const { return m_state; }
     void set_state(State state) { m_state = state; }
 
+    // Cells start out young, and are promoted to the old generation once they survive a collection.
+    bool is_old() const { return m_old; }
+    void set_old(bool b) { m_old = b; }
+
+    // An old cell is remembered if it may point to young cells, so a minor collection has to look at it.
+    bool is_remembered() const { return m_remembered; }
+    void set_remembered(bool b) { m_remembered = b; }
+
+    bool has_write_barriers() const { return m_has_write_barriers; }
+    void set_has_write_barriers(bool b) { m_has_write_barriers = b; }
+
+    // Must be called when an existing cell starts pointing to another cell, see has_write_barriers<T>.
+    // It also keeps incremental marking from missing the cell: a marked cell never points to an unmarked one.
+    ALWAYS_INLINE void write_barrier(Cell const* cell)
+    {
+        if (!cell)
+            return;
+        if (m_old && !m_remembered && !cell->m_old)
+            did_store_young_cell();
+        if (m_mark && !cell->m_mark)
+            did_store_unmarked_cell(const_cast<Cell&>(*cell));
+    }
+    void write_barrier(Value);
+
+    // For stores whose value isn't known up front, like handing out mutable access to a container.
+    // Marked cells are always old, so remembering them is also enough to have incremental marking look at them again.
+    ALWAYS_INLINE void write_barrier()
+    {
+        if (m_old && !m_remembered)
+            did_store_young_cell();
+    }
+
     virtual const char* class_name() const = 0;
 
     class Visitor {
@@ -60,10 +93,22 @@ protected:
     Cell() { }
 
 private:
+    void did_store_young_cell();
+    void did_store_unmarked_cell(Cell&);
+
     bool m_mark : 1 { false };
-    State m_state : 7 { State::Live };
+    bool m_old : 1 { false };
+    bool m_remembered : 1 { false };
+    bool m_has_write_barriers : 1 { false };
+    State m_state : 4 { State::Live };
 };
 
+// Minor collections only trace young cells, starting from the roots and from the remembered old cells.
+// A cell type can specialize this to true if every store of a cell pointer into an existing cell of that
+// exact type goes through Cell::write_barrier(). Old cells of all other types are always remembered.
+template<typename T>
+inline constexpr bool has_write_barriers = false;
+
 }
 
 template<>
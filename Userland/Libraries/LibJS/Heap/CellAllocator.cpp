@@ -23,6 +23,10 @@ CellAllocator::~CellAllocator()
 
 Cell* CellAllocator::allocate_cell(Heap& heap)
 {
+    // Sweeping a block that's waiting for it is cheaper than asking for a new one.
+    while (m_usable_blocks.is_empty() && has_unswept_blocks())
+        sweep_one_block(heap);
+
     if (m_usable_blocks.is_empty()) {
         auto block = HeapBlock::create_with_cell_size(heap, m_cell_size);
         m_usable_blocks.append(*block.leak_ptr());
@@ -37,6 +41,11 @@ Cell* CellAllocator::allocate_cell(Heap& heap)
 }
 
 void CellAllocator::block_did_become_empty(Badge<Heap>, HeapBlock& block)
+{
+    free_block(block);
+}
+
+void CellAllocator::free_block(HeapBlock& block)
 {
     auto& heap = block.heap();
     block.m_list_node.remove();
@@ -51,4 +60,35 @@ void CellAllocator::block_did_become_usable(Badge<Heap>, HeapBlock& block)
     m_usable_blocks.append(block);
 }
 
+size_t CellAllocator::start_lazy_sweep(Badge<Heap>)
+{
+    VERIFY(m_unswept_blocks.is_empty());
+    size_t block_count = 0;
+    for (auto* list : { &m_full_blocks, &m_usable_blocks }) {
+        while (!list->is_empty()) {
+            auto& block = *list->first();
+            block.set_needs_sweep(true);
+            m_unswept_blocks.append(block);
+            ++block_count;
+        }
+    }
+    return block_count;
+}
+
+void CellAllocator::sweep_next_block(Badge<Heap>, Heap& heap)
+{
+    sweep_one_block(heap);
+}
+
+void CellAllocator::sweep_one_block(Heap& heap)
+{
+    auto& block = *m_unswept_blocks.first();
+    if (!heap.sweep_block({}, block))
+        free_block(block);
+    else if (block.is_full())
+        m_full_blocks.append(block);
+    else
+        m_usable_blocks.append(block);
+}
+
 }
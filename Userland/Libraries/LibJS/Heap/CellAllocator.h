@@ -34,18 +34,30 @@ public:
             if (callback(block) == IterationDecision::Break)
                 return IterationDecision::Break;
         }
+        for (auto& block : m_unswept_blocks) {
+            if (callback(block) == IterationDecision::Break)
+                return IterationDecision::Break;
+        }
         return IterationDecision::Continue;
     }
 
     void block_did_become_empty(Badge<Heap>, HeapBlock&);
     void block_did_become_usable(Badge<Heap>, HeapBlock&);
 
+    size_t start_lazy_sweep(Badge<Heap>);
+    bool has_unswept_blocks() const { return !m_unswept_blocks.is_empty(); }
+    void sweep_next_block(Badge<Heap>, Heap&);
+
 private:
+    void sweep_one_block(Heap&);
+    void free_block(HeapBlock&);
+
     const size_t m_cell_size;
 
     typedef IntrusiveList<HeapBlock, RawPtr<HeapBlock>, &HeapBlock::m_list_node> BlockList;
     BlockList m_full_blocks;
     BlockList m_usable_blocks;
+    BlockList m_unswept_blocks;
 };
 
 }
@@ -6,6 +6,7 @@
 
 #include <AK/Badge.h>
 #include <AK/Debug.h>
+#include <AK/HashMap.h>
 #include <AK/HashTable.h>
 #include <AK/StackInfo.h>
 #include <AK/TemporaryChange.h>
@@ -35,6 +36,8 @@ Heap::Heap(VM& vm)
     m_allocators.append(make<CellAllocator>(512));
     m_allocators.append(make<CellAllocator>(1024));
     m_allocators.append(make<CellAllocator>(3072));
+
+    update_gc_thresholds();
 }
 
 Heap::~Heap()
@@ -56,15 +59,19 @@ Cell* Heap::allocate_cell(size_t size)
 {
     if (should_collect_on_every_allocation()) {
         collect_garbage();
-    } else if (m_allocations_since_last_gc > m_max_allocations_between_gc) {
-        m_allocations_since_last_gc = 0;
-        collect_garbage();
-    } else {
-        ++m_allocations_since_last_gc;
+    } else if (m_bytes_allocated_since_last_gc >= m_young_generation_size_limit) {
+        m_bytes_allocated_since_last_gc = 0;
+        collect_garbage(CollectionType::CollectYoungGeneration);
     }
 
     auto& allocator = allocator_for_size(size);
-    return allocator.allocate_cell(*this);
+    m_bytes_allocated_since_last_gc += allocator.cell_size();
+    auto* cell = allocator.allocate_cell(*this);
+    // Everything is traced while marking, cells that are allocated in the meantime are promoted if they're reached
+    // and swept along with everything else otherwise.
+    if (!m_is_marking_incrementally)
+        m_young_cells.append(cell);
+    return cell;
 }
 
 void Heap::collect_garbage(CollectionType collection_type, bool print_report)
@@ -72,18 +79,96 @@ void Heap::collect_garbage(CollectionType collection_type, bool print_report)
     VERIFY(!m_collecting_garbage);
     TemporaryChange change(m_collecting_garbage, true);
 
-    Core::ElapsedTimer collection_measurement_timer;
-    collection_measurement_timer.start();
-    if (collection_type == CollectionType::CollectGarbage) {
-        if (m_gc_deferrals) {
-            m_should_gc_when_deferral_ends = true;
-            return;
+    if (collection_type != CollectionType::CollectEverything && m_gc_deferrals) {
+        m_should_gc_when_deferral_ends = true;
+        return;
+    }
+
+    Core::ElapsedTimer pause_timer(true);
+    pause_timer.start();
+
+    switch (collection_type) {
+    case CollectionType::CollectYoungGeneration:
+        // Cells are never moved, since the conservative stack scan can't update the pointers it finds. Instead,
+        // survivors of a collection are promoted to the old generation where they are, and minor collections
+        // only trace and sweep the cells allocated since the last collection. Once enough cells have been
+        // promoted, a major collection is started, and it's done in small steps from here on.
+        if (!m_is_marking_incrementally) {
+            if (sweep_incrementally(pause_timer, incremental_step_budget_us) || !should_start_major_collection()) {
+                collect_young_generation(print_report, pause_timer);
+                return;
+            }
+            start_marking();
         }
-        HashTable<Cell*> roots;
-        gather_roots(roots);
-        mark_live_cells(roots);
+        // Marking has to get through cells faster than they're allocated, or it would never finish.
+        if (mark_incrementally(pause_timer, incremental_step_budget_us, 2 * m_young_generation_size_limit))
+            finish_marking();
+        record_pause(m_incremental_pause_times, pause_timer.elapsed_time().to_microseconds());
+        return;
+    case CollectionType::CollectGarbage:
+        if (!m_is_marking_incrementally)
+            start_marking();
+        finish_marking();
+        finish_sweeping();
+        break;
+    case CollectionType::CollectEverything:
+        if (m_is_marking_incrementally)
+            abort_marking();
+        finish_sweeping();
+        for (auto* cell : m_remembered_cells)
+            cell->set_remembered(false);
+        m_remembered_cells.clear();
+        m_young_cells.clear();
+        remove_dead_cells_from_weak_containers();
+        start_sweeping();
+        finish_sweeping();
+        break;
+    }
+
+    auto time_spent = pause_timer.elapsed_time().to_microseconds();
+    record_pause(m_major_pause_times, time_spent);
+
+    if (print_report) {
+        size_t live_block_count = 0;
+        for_each_block([&](auto&) {
+            ++live_block_count;
+            return IterationDecision::Continue;
+        });
+
+        auto& statistics = m_sweep_statistics;
+        dbgln("Garbage collection report (major)");
+        dbgln("=============================================");
+        dbgln("     Time spent: {} us", time_spent);
+        dbgln("     Live cells: {} ({} bytes)", statistics.live_cells, statistics.live_cell_bytes);
+        dbgln("Collected cells: {} ({} bytes)", statistics.collected_cells, statistics.collected_cell_bytes);
+        dbgln("    Live blocks: {} ({} bytes)", live_block_count, live_block_count * HeapBlock::block_size);
+        dbgln("   Freed blocks: {} ({} bytes)", statistics.freed_blocks, statistics.freed_blocks * HeapBlock::block_size);
+        dbgln("External memory: {} bytes", m_external_bytes);
+        dbgln("Next major GC at {} cell bytes or {} external bytes", m_cell_bytes_threshold, m_external_bytes_threshold);
+        print_pause_times();
+        dbgln("=============================================");
     }
-    sweep_dead_cells(print_report, collection_measurement_timer);
+}
+
+bool Heap::perform_incremental_gc_work(Time const& budget)
+{
+    if (m_collecting_garbage || m_gc_deferrals)
+        return true;
+    TemporaryChange change(m_collecting_garbage, true);
+
+    Core::ElapsedTimer pause_timer(true);
+    pause_timer.start();
+
+    bool has_work_left;
+    if (m_is_marking_incrementally) {
+        if (mark_incrementally(pause_timer, budget.to_microseconds(), 0))
+            finish_marking();
+        has_work_left = true;
+    } else {
+        has_work_left = sweep_incrementally(pause_timer, budget.to_microseconds());
+    }
+    record_pause(m_incremental_pause_times, pause_timer.elapsed_time().to_microseconds());
+    return has_work_left;
 }
 
 void Heap::gather_roots(HashTable<Cell*>& roots)
@@ -94,8 +179,8 @@ void Heap::gather_roots(HashTable<Cell*>& roots)
     for (auto* handle : m_handles)
         roots.set(handle->cell());
 
-    for (auto* list : m_marked_value_lists) {
-        for (auto& value : list->values()) {
+    for (auto& list : m_marked_value_lists) {
+        for (auto& value : list.values()) {
             if (value.is_cell())
                 roots.set(&value.as_cell());
         }
@@ -121,7 +206,7 @@ __attribute__((no_sanitize("address"))) void Heap::gather_conservative_roots(Has
 
     auto* raw_jmp_buf = reinterpret_cast<FlatPtr const*>(buf);
 
-    for (size_t i = 0; i < ((size_t)sizeof(buf)) / sizeof(FlatPtr); i += sizeof(FlatPtr))
+    for (size_t i = 0; i < ((size_t)sizeof(buf)) / sizeof(FlatPtr); ++i)
         possible_pointers.set(raw_jmp_buf[i]);
 
     auto stack_reference = bit_cast<FlatPtr>(&dummy);
@@ -145,7 +230,7 @@ __attribute__((no_sanitize("address"))) void Heap::gather_conservative_roots(Has
         auto* possible_heap_block = HeapBlock::from_cell(reinterpret_cast<const Cell*>(possible_pointer));
         if (all_live_heap_blocks.contains(possible_heap_block)) {
             if (auto* cell = possible_heap_block->cell_from_possible_pointer(possible_pointer)) {
-                if (cell->state() == Cell::State::Live) {
+                if (cell->state() == Cell::State::Live && !is_dead_but_unswept(*cell)) {
                     dbgln_if(HEAP_DEBUG, "  ?-> {}", (const void*)cell);
                     roots.set(cell);
                 } else {
@@ -158,104 +243,391 @@ __attribute__((no_sanitize("address"))) void Heap::gather_conservative_roots(Has
 
 class MarkingVisitor final : public Cell::Visitor {
 public:
-    MarkingVisitor() { }
+    MarkingVisitor(Vector<Cell*>& mark_stack, bool young_generation_only)
+        : m_mark_stack(mark_stack)
+        , m_young_generation_only(young_generation_only)
+    {
+    }
 
+    // Cells are visited from a stack rather than recursively, since some object graphs (like the ropes
+    // built by concatenating strings in a loop) are far deeper than the native stack.
     virtual void visit_impl(Cell& cell)
     {
         if (cell.is_marked())
             return;
+        if (m_young_generation_only && cell.is_old())
+            return;
         dbgln_if(HEAP_DEBUG, "  ! {}", &cell);
         cell.set_marked(true);
-        cell.visit_edges(*this);
+        m_mark_stack.append(&cell);
     }
+
+private:
+    Vector<Cell*>& m_mark_stack;
+    bool m_young_generation_only { false };
 };
 
-void Heap::mark_live_cells(const HashTable<Cell*>& roots)
+void Heap::drain_mark_stack(bool young_generation_only, Core::ElapsedTimer const* timer, i64 budget_us, size_t minimum_bytes)
+{
+    MarkingVisitor visitor(m_mark_stack, young_generation_only);
+    size_t visited_cells = 0;
+    size_t visited_bytes = 0;
+    while (!m_mark_stack.is_empty()) {
+        auto* cell = m_mark_stack.take_last();
+        // Everything that's marked survives the collection, and remembering the survivors without write
+        // barriers right away means the rescan at the end of marking doesn't have to look for them.
+        promote(*cell);
+        cell->visit_edges(visitor);
+        if (!timer)
+            continue;
+        visited_bytes += HeapBlock::from_cell(cell)->cell_size();
+        if (++visited_cells % 256 == 0 && visited_bytes >= minimum_bytes && timer->elapsed_time().to_microseconds() >= budget_us)
+            return;
+    }
+}
+
+void Heap::collect_young_generation(bool print_report, Core::ElapsedTimer const& pause_timer)
+{
+    dbgln_if(HEAP_DEBUG, "collect_young_generation:");
+    TemporaryChange change(m_is_collecting_young_generation, true);
+
+    HashTable<Cell*> roots;
+    gather_roots(roots);
+
+    MarkingVisitor visitor(m_mark_stack, true);
+    for (auto* root : roots)
+        visitor.visit(root);
+    for (auto* cell : m_remembered_cells)
+        cell->visit_edges(visitor);
+    drain_mark_stack(true);
+
+    remove_dead_cells_from_weak_containers();
+
+    HashMap<HeapBlock*, bool> blocks_with_swept_cells;
+    size_t collected_cells = 0;
+    size_t promoted_cells = 0;
+    size_t promoted_bytes = 0;
+
+    for (auto* cell : m_young_cells) {
+        VERIFY(cell->state() == Cell::State::Live);
+        if (cell->is_marked()) {
+            cell->set_marked(false);
+            ++promoted_cells;
+            promoted_bytes += HeapBlock::from_cell(cell)->cell_size();
+            continue;
+        }
+        dbgln_if(HEAP_DEBUG, "  ~ {}", cell);
+        auto* block = HeapBlock::from_cell(cell);
+        if (!blocks_with_swept_cells.contains(block))
+            blocks_with_swept_cells.set(block, block->is_full());
+        block->deallocate(cell);
+        ++collected_cells;
+    }
+    m_young_cells.clear_with_capacity();
+
+    // Everything that was young is old now, so the only old cells that can point to young cells are the
+    // ones without write barriers.
+    m_remembered_cells.remove_all_matching([](Cell* cell) {
+        if (!cell->has_write_barriers())
+            return false;
+        cell->set_remembered(false);
+        return true;
+    });
+
+    size_t freed_blocks = 0;
+    for (auto& it : blocks_with_swept_cells) {
+        auto& block = *it.key;
+        VERIFY(!block.needs_sweep());
+        bool block_has_live_cells = false;
+        block.for_each_cell_in_state<Cell::State::Live>([&](Cell*) {
+            block_has_live_cells = true;
+        });
+        if (!block_has_live_cells) {
+            allocator_for_size(block.cell_size()).block_did_become_empty({}, block);
+            ++freed_blocks;
+        } else if (it.value) {
+            allocator_for_size(block.cell_size()).block_did_become_usable({}, block);
+        }
+    }
+
+    m_bytes_promoted_since_last_major_gc += promoted_bytes;
+
+    auto time_spent = pause_timer.elapsed_time().to_microseconds();
+    record_pause(m_minor_pause_times, time_spent);
+
+    if (print_report) {
+        dbgln("Garbage collection report (minor)");
+        dbgln("=============================================");
+        dbgln("     Time spent: {} us", time_spent);
+        dbgln(" Promoted cells: {} ({} bytes)", promoted_cells, promoted_bytes);
+        dbgln("Collected cells: {}", collected_cells);
+        dbgln(" Remembered set: {} cells", m_remembered_cells.size());
+        dbgln("   Freed blocks: {} ({} bytes)", freed_blocks, freed_blocks * HeapBlock::block_size);
+        print_pause_times();
+        dbgln("=============================================");
+    }
+}
+
+void Heap::start_marking()
 {
-    dbgln_if(HEAP_DEBUG, "mark_live_cells:");
-    MarkingVisitor visitor;
+    dbgln_if(HEAP_DEBUG, "start_marking:");
+    VERIFY(!m_is_marking_incrementally);
+
+    // Marks left over from the last major collection are only cleared by sweeping.
+    finish_sweeping();
+
+    // Every survivor ends up in the old generation, and the remembered set is rebuilt while marking.
+    for (auto* cell : m_remembered_cells)
+        cell->set_remembered(false);
+    m_remembered_cells.clear();
+    m_young_cells.clear();
+
+    m_is_marking_incrementally = true;
+
+    HashTable<Cell*> roots;
+    gather_roots(roots);
+    MarkingVisitor visitor(m_mark_stack, false);
     for (auto* root : roots)
         visitor.visit(root);
 }
 
-void Heap::sweep_dead_cells(bool print_report, const Core::ElapsedTimer& measurement_timer)
+bool Heap::mark_incrementally(Core::ElapsedTimer const& timer, i64 budget_us, size_t minimum_bytes)
 {
-    dbgln_if(HEAP_DEBUG, "sweep_dead_cells:");
-    Vector<HeapBlock*, 32> empty_blocks;
-    Vector<HeapBlock*, 32> full_blocks_that_became_usable;
-    Vector<Cell*> swept_cells;
+    VERIFY(m_is_marking_incrementally);
+    drain_mark_stack(false, &timer, budget_us, minimum_bytes);
+    return m_mark_stack.is_empty();
+}
 
-    size_t collected_cells = 0;
-    size_t live_cells = 0;
-    size_t collected_cell_bytes = 0;
-    size_t live_cell_bytes = 0;
+void Heap::finish_marking()
+{
+    dbgln_if(HEAP_DEBUG, "finish_marking:");
+    VERIFY(m_is_marking_incrementally);
+
+    // The roots may have changed since marking started, and so may the remembered cells: that's every marked
+    // cell without write barriers, and every cell with write barriers that was stored into without knowing what
+    // was stored. They're all visited again before the last of the marking is done.
+    HashTable<Cell*> roots;
+    gather_roots(roots);
+    MarkingVisitor visitor(m_mark_stack, false);
+    for (auto* root : roots)
+        visitor.visit(root);
+    for (auto* cell : m_remembered_cells) {
+        if (cell->is_marked())
+            cell->visit_edges(visitor);
+    }
+    drain_mark_stack(false);
+
+    // Cells with write barriers may have been remembered while marking, but there's nothing young left now.
+    m_remembered_cells.remove_all_matching([](Cell* cell) {
+        if (!cell->has_write_barriers())
+            return false;
+        cell->set_remembered(false);
+        return true;
+    });
 
-    auto should_store_swept_cells = !m_weak_containers.is_empty();
+    m_is_marking_incrementally = false;
+    m_bytes_promoted_since_last_major_gc = 0;
+
+    remove_dead_cells_from_weak_containers();
+    start_sweeping();
+}
+
+void Heap::abort_marking()
+{
+    VERIFY(m_is_marking_incrementally);
+    m_is_marking_incrementally = false;
+    m_mark_stack.clear();
     for_each_block([&](auto& block) {
-        bool block_has_live_cells = false;
-        bool block_was_full = block.is_full();
-        block.template for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
-            if (!cell->is_marked()) {
-                dbgln_if(HEAP_DEBUG, "  ~ {}", cell);
-                if (should_store_swept_cells)
-                    swept_cells.append(cell);
-                block.deallocate(cell);
-                ++collected_cells;
-                collected_cell_bytes += block.cell_size();
-            } else {
-                cell->set_marked(false);
-                block_has_live_cells = true;
-                ++live_cells;
-                live_cell_bytes += block.cell_size();
-            }
+        block.template for_each_cell_in_state<Cell::State::Live>([](Cell* cell) {
+            cell->set_marked(false);
         });
-        if (!block_has_live_cells)
-            empty_blocks.append(&block);
-        else if (block_was_full != block.is_full())
-            full_blocks_that_became_usable.append(&block);
         return IterationDecision::Continue;
     });
+}
+
+void Heap::remove_dead_cells_from_weak_containers()
+{
+    for (auto* weak_container : m_weak_containers)
+        weak_container->remove_dead_cells({});
+}
+
+bool Heap::is_dead(Cell const& cell) const
+{
+    if (m_is_collecting_young_generation && cell.is_old())
+        return false;
+    return !cell.is_marked();
+}
+
+bool Heap::is_dead_but_unswept(Cell const& cell)
+{
+    return !cell.is_marked() && HeapBlock::from_cell(&cell)->needs_sweep();
+}
+
+void Heap::start_sweeping()
+{
+    dbgln_if(HEAP_DEBUG, "start_sweeping:");
+    VERIFY(!m_unswept_block_count);
+    m_sweep_statistics = {};
+    for (auto& allocator : m_allocators)
+        m_unswept_block_count += allocator->start_lazy_sweep({});
+    if (!m_unswept_block_count)
+        did_finish_sweeping();
+}
 
-    for (auto* block : empty_blocks) {
-        dbgln_if(HEAP_DEBUG, " - HeapBlock empty @ {}: cell_size={}", block, block->cell_size());
-        allocator_for_size(block->cell_size()).block_did_become_empty({}, *block);
+// Sweeping is done one block at a time, either when an allocator runs out of usable blocks, or a little
+// bit at every collection that's triggered by allocation. Returns whether there are blocks left to sweep.
+bool Heap::sweep_incrementally(Core::ElapsedTimer const& timer, i64 budget_us)
+{
+    for (auto& allocator : m_allocators) {
+        while (allocator->has_unswept_blocks()) {
+            if (timer.elapsed_time().to_microseconds() >= budget_us)
+                return true;
+            allocator->sweep_next_block({}, *this);
+        }
     }
+    return false;
+}
 
-    for (auto* block : full_blocks_that_became_usable) {
-        dbgln_if(HEAP_DEBUG, " - HeapBlock usable again @ {}: cell_size={}", block, block->cell_size());
-        allocator_for_size(block->cell_size()).block_did_become_usable({}, *block);
+void Heap::finish_sweeping()
+{
+    for (auto& allocator : m_allocators) {
+        while (allocator->has_unswept_blocks())
+            allocator->sweep_next_block({}, *this);
     }
+}
 
-    for (auto* weak_container : m_weak_containers)
-        weak_container->remove_swept_cells({}, swept_cells);
+bool Heap::sweep_block(Badge<CellAllocator>, HeapBlock& block)
+{
+    dbgln_if(HEAP_DEBUG, "sweep_block: {} cell_size={}", &block, block.cell_size());
+    VERIFY(block.needs_sweep());
+    block.set_needs_sweep(false);
+
+    bool block_has_live_cells = false;
+    block.for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
+        if (!cell->is_marked()) {
+            dbgln_if(HEAP_DEBUG, "  ~ {}", cell);
+            block.deallocate(cell);
+            ++m_sweep_statistics.collected_cells;
+            m_sweep_statistics.collected_cell_bytes += block.cell_size();
+        } else {
+            cell->set_marked(false);
+            block_has_live_cells = true;
+            ++m_sweep_statistics.live_cells;
+            m_sweep_statistics.live_cell_bytes += block.cell_size();
+        }
+    });
+    if (!block_has_live_cells)
+        ++m_sweep_statistics.freed_blocks;
+    if (!--m_unswept_block_count)
+        did_finish_sweeping();
+    return block_has_live_cells;
+}
 
-    if constexpr (HEAP_DEBUG) {
-        for_each_block([&](auto& block) {
-            dbgln(" > Live HeapBlock @ {}: cell_size={}", &block, block.cell_size());
-            return IterationDecision::Continue;
-        });
-    }
+void Heap::did_finish_sweeping()
+{
+    // The destructors of the dead cells have run by now, so the external memory they held is gone as well.
+    m_live_cell_bytes_after_last_major_gc = m_sweep_statistics.live_cell_bytes;
+    m_external_bytes_after_last_major_gc = m_external_bytes;
+    update_gc_thresholds();
+}
 
-    int time_spent = measurement_timer.elapsed();
+void Heap::update_gc_thresholds()
+{
+    m_cell_bytes_threshold = max(static_cast<size_t>(m_live_cell_bytes_after_last_major_gc * m_heap_growth_factor), m_minimum_heap_size);
+    m_external_bytes_threshold = max(static_cast<size_t>(m_external_bytes_after_last_major_gc * m_heap_growth_factor), m_minimum_heap_size);
 
-    if (print_report) {
-        size_t live_block_count = 0;
-        for_each_block([&](auto&) {
-            ++live_block_count;
-            return IterationDecision::Continue;
-        });
+    // Leave room for a few minor collections before the next major one. Most cells die young, and a
+    // bigger young generation only makes each minor collection sweep more of them.
+    auto headroom = m_cell_bytes_threshold - m_live_cell_bytes_after_last_major_gc;
+    m_young_generation_size_limit = clamp(headroom / 4, 256 * KiB, 16 * MiB);
+}
 
-        dbgln("Garbage collection report");
-        dbgln("=============================================");
-        dbgln("     Time spent: {} ms", time_spent);
-        dbgln("     Live cells: {} ({} bytes)", live_cells, live_cell_bytes);
-        dbgln("Collected cells: {} ({} bytes)", collected_cells, collected_cell_bytes);
-        dbgln("    Live blocks: {} ({} bytes)", live_block_count, live_block_count * HeapBlock::block_size);
-        dbgln("   Freed blocks: {} ({} bytes)", empty_blocks.size(), empty_blocks.size() * HeapBlock::block_size);
-        dbgln("=============================================");
+bool Heap::should_start_major_collection() const
+{
+    if (m_live_cell_bytes_after_last_major_gc + m_bytes_promoted_since_last_major_gc >= m_cell_bytes_threshold)
+        return true;
+    return m_external_bytes >= m_external_bytes_threshold;
+}
+
+void Heap::set_heap_growth_factor(double factor)
+{
+    VERIFY(factor > 1.0);
+    m_heap_growth_factor = factor;
+    update_gc_thresholds();
+}
+
+void Heap::set_minimum_heap_size(size_t size)
+{
+    m_minimum_heap_size = size;
+    update_gc_thresholds();
+}
+
+void Heap::did_allocate_external_memory(size_t size)
+{
+    m_external_bytes += size;
+    m_bytes_allocated_since_last_gc += size;
+}
+
+void Heap::did_free_external_memory(size_t size)
+{
+    VERIFY(m_external_bytes >= size);
+    m_external_bytes -= size;
+}
+
+void Heap::promote(Cell& cell)
+{
+    cell.set_old(true);
+    if (!cell.has_write_barriers() && !cell.is_remembered()) {
+        cell.set_remembered(true);
+        m_remembered_cells.append(&cell);
     }
 }
 
+void Heap::record_pause(PauseTimes& pause_times, i64 us)
+{
+    pause_times.record(us);
+    size_t bucket = 0;
+    while (bucket < pause_histogram_limits_us.size() && us >= pause_histogram_limits_us[bucket])
+        ++bucket;
+    ++m_pause_histogram[bucket];
+}
+
+void Heap::print_pause_times() const
+{
+    auto print = [](StringView name, PauseTimes const& pause_times) {
+        dbgln("{}: {} collections, {} us total, {} us max", name, pause_times.count, pause_times.total_us, pause_times.max_us);
+    };
+    print("   Minor pauses"sv, m_minor_pause_times);
+    print("    Incremental"sv, m_incremental_pause_times);
+    print("   Major pauses"sv, m_major_pause_times);
+
+    dbgln(" Pause histogram:");
+    for (size_t i = 0; i < m_pause_histogram.size(); ++i) {
+        if (i < pause_histogram_limits_us.size())
+            dbgln("       < {:>5} us: {}", pause_histogram_limits_us[i], m_pause_histogram[i]);
+        else
+            dbgln("      >= {:>5} us: {}", pause_histogram_limits_us[pause_histogram_limits_us.size() - 1], m_pause_histogram[i]);
+    }
+}
+
+void Heap::did_store_young_cell(Badge<Cell>, Cell& cell)
+{
+    VERIFY(cell.is_old());
+    VERIFY(!cell.is_remembered());
+    cell.set_remembered(true);
+    m_remembered_cells.append(&cell);
+}
+
+void Heap::did_store_unmarked_cell(Badge<Cell>, Cell& cell)
+{
+    // Marks are only meaningful while marking, the cell storing the pointer may just be waiting to be swept.
+    if (!m_is_marking_incrementally)
+        return;
+    VERIFY(!cell.is_marked());
+    cell.set_marked(true);
+    m_mark_stack.append(&cell);
+}
+
 void Heap::did_create_handle(Badge<HandleImpl>, HandleImpl& impl)
 {
     VERIFY(!m_handles.contains(&impl));
@@ -270,14 +642,12 @@ void Heap::did_destroy_handle(Badge<HandleImpl>, HandleImpl& impl)
 
 void Heap::did_create_marked_value_list(Badge<MarkedValueList>, MarkedValueList& list)
 {
-    VERIFY(!m_marked_value_lists.contains(&list));
-    m_marked_value_lists.set(&list);
+    m_marked_value_lists.append(list);
 }
 
 void Heap::did_destroy_marked_value_list(Badge<MarkedValueList>, MarkedValueList& list)
 {
-    VERIFY(m_marked_value_lists.contains(&list));
-    m_marked_value_lists.remove(&list);
+    m_marked_value_lists.remove(list);
 }
 
 void Heap::did_create_weak_container(Badge<WeakContainer>, WeakContainer& set)
@@ -304,9 +674,19 @@ void Heap::undefer_gc(Badge<DeferGC>)
 
     if (!m_gc_deferrals) {
         if (m_should_gc_when_deferral_ends)
-            collect_garbage();
+            collect_garbage(CollectionType::CollectYoungGeneration);
         m_should_gc_when_deferral_ends = false;
     }
 }
 
+void Cell::did_store_young_cell()
+{
+    heap().did_store_young_cell({}, *this);
+}
+
+void Cell::did_store_unmarked_cell(Cell& cell)
+{
+    heap().did_store_unmarked_cell({}, cell);
+}
+
 }
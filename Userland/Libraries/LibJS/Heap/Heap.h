@@ -6,10 +6,13 @@
 
 #pragma once
 
+#include <AK/Array.h>
+#include <AK/Badge.h>
 #include <AK/HashTable.h>
 #include <AK/Noncopyable.h>
 #include <AK/NonnullOwnPtr.h>
 #include <AK/Types.h>
+#include <AK/Time.h>
 #include <AK/Vector.h>
 #include <LibCore/Forward.h>
 #include <LibJS/Forward.h>
@@ -17,6 +20,7 @@
 #include <LibJS/Heap/Cell.h>
 #include <LibJS/Heap/CellAllocator.h>
 #include <LibJS/Heap/Handle.h>
+#include <LibJS/Runtime/MarkedValueList.h>
 #include <LibJS/Runtime/Object.h>
 
 namespace JS {
@@ -34,7 +38,9 @@ public:
     {
         auto* memory = allocate_cell(sizeof(T));
         new (memory) T(forward<Args>(args)...);
-        return static_cast<T*>(memory);
+        auto* cell = static_cast<T*>(memory);
+        cell->set_has_write_barriers(has_write_barriers<T>);
+        return cell;
     }
 
     template<typename T, typename... Args>
@@ -43,6 +49,7 @@ public:
         auto* memory = allocate_cell(sizeof(T));
         new (memory) T(forward<Args>(args)...);
         auto* cell = static_cast<T*>(memory);
+        cell->set_has_write_barriers(has_write_barriers<T>);
         constexpr bool is_object = IsBaseOf<Object, T>;
         if constexpr (is_object)
             static_cast<Object*>(cell)->disable_transitions();
@@ -53,17 +60,43 @@ public:
     }
 
     enum class CollectionType {
+        CollectYoungGeneration,
         CollectGarbage,
         CollectEverything,
     };
 
     void collect_garbage(CollectionType = CollectionType::CollectGarbage, bool print_report = false);
 
+    // Does up to `budget` worth of the marking or sweeping that's left over from the last allocation-triggered
+    // collection, so an embedder can get it done while it's idle. Returns whether there's more to do.
+    bool perform_incremental_gc_work(Time const& budget);
+
+    // A cell that wasn't marked by the last major collection, but whose block hasn't been swept yet.
+    // Code that finds cells by other means than following pointers from live cells must ignore these.
+    static bool is_dead_but_unswept(Cell const&);
+
+    // Whether a cell wasn't reached by the collection that's currently asking weak containers to remove dead cells.
+    bool is_dead(Cell const&) const;
+
     VM& vm() { return m_vm; }
 
     bool should_collect_on_every_allocation() const { return m_should_collect_on_every_allocation; }
     void set_should_collect_on_every_allocation(bool b) { m_should_collect_on_every_allocation = b; }
 
+    // A major collection is started once the old generation has grown to this multiple of the cell bytes that
+    // survived the last one, or the memory held outside of the heap has grown to this multiple of what was held
+    // after the last one. Neither threshold goes below the minimum heap size.
+    double heap_growth_factor() const { return m_heap_growth_factor; }
+    void set_heap_growth_factor(double);
+    size_t minimum_heap_size() const { return m_minimum_heap_size; }
+    void set_minimum_heap_size(size_t);
+
+    // Cells that own memory outside of the heap (like the data of an ArrayBuffer) report it here, so it counts
+    // towards when the next collection happens.
+    void did_allocate_external_memory(size_t);
+    void did_free_external_memory(size_t);
+    size_t external_memory_size() const { return m_external_bytes; }
+
     void did_create_handle(Badge<HandleImpl>, HandleImpl&);
     void did_destroy_handle(Badge<HandleImpl>, HandleImpl&);
 
@@ -78,13 +111,31 @@ public:
 
     BlockAllocator& block_allocator() { return m_block_allocator; }
 
+    void did_store_young_cell(Badge<Cell>, Cell&);
+    void did_store_unmarked_cell(Badge<Cell>, Cell&);
+
+    bool sweep_block(Badge<CellAllocator>, HeapBlock&);
+
 private:
     Cell* allocate_cell(size_t);
 
     void gather_roots(HashTable<Cell*>&);
     void gather_conservative_roots(HashTable<Cell*>&);
-    void mark_live_cells(const HashTable<Cell*>& live_cells);
-    void sweep_dead_cells(bool print_report, const Core::ElapsedTimer&);
+    void drain_mark_stack(bool young_generation_only, Core::ElapsedTimer const* = nullptr, i64 budget_us = 0, size_t minimum_bytes = 0);
+    void collect_young_generation(bool print_report, Core::ElapsedTimer const&);
+    void start_marking();
+    bool mark_incrementally(Core::ElapsedTimer const&, i64 budget_us, size_t minimum_bytes);
+    void finish_marking();
+    void abort_marking();
+    void remove_dead_cells_from_weak_containers();
+    void start_sweeping();
+    bool sweep_incrementally(Core::ElapsedTimer const&, i64 budget_us);
+    void finish_sweeping();
+    void did_finish_sweeping();
+    void update_gc_thresholds();
+    bool should_start_major_collection() const;
+    void promote(Cell&);
+    void print_pause_times() const;
 
     CellAllocator& allocator_for_size(size_t);
 
@@ -97,8 +148,75 @@ private:
         }
     }
 
-    size_t m_max_allocations_between_gc { 10000 };
-    size_t m_allocations_since_last_gc { 0 };
+    double m_heap_growth_factor { 2.0 };
+    size_t m_minimum_heap_size { 4 * MiB };
+
+    // Cell and external bytes allocated since the last collection. Once this reaches the young generation's
+    // share of the headroom until the next major collection, it's time for a minor one.
+    size_t m_bytes_allocated_since_last_gc { 0 };
+    size_t m_young_generation_size_limit { 0 };
+
+    size_t m_external_bytes { 0 };
+
+    // Every cell allocated since the last collection, which is what a minor collection sweeps.
+    Vector<Cell*> m_young_cells;
+
+    // Old cells that may point to young ones: cells without write barriers are always in here, and cells
+    // with write barriers are added when they store a pointer to a young cell.
+    Vector<Cell*> m_remembered_cells;
+
+    // What survived the last major collection is known once all of its blocks have been swept, everything
+    // promoted by minor collections since then is added on top of that.
+    size_t m_live_cell_bytes_after_last_major_gc { 0 };
+    size_t m_external_bytes_after_last_major_gc { 0 };
+    size_t m_bytes_promoted_since_last_major_gc { 0 };
+    size_t m_cell_bytes_threshold { 0 };
+    size_t m_external_bytes_threshold { 0 };
+
+    // Marking for a major collection that was triggered by allocation is spread out over several pauses
+    // of about this long. Cells allocated in the meantime are left alone, since minor collections are
+    // suspended until marking is done.
+    static constexpr i64 incremental_step_budget_us = 1000;
+
+    bool m_is_marking_incrementally { false };
+    bool m_is_collecting_young_generation { false };
+
+    // Cells that are marked (gray) but whose edges haven't been visited yet. The invariant is that no
+    // marked cell whose edges have been visited (black) points to an unmarked one (white): write barriers
+    // mark the cell that's stored, and cells that can't tell are remembered and visited again at the end.
+    Vector<Cell*> m_mark_stack;
+
+    struct SweepStatistics {
+        size_t live_cells { 0 };
+        size_t live_cell_bytes { 0 };
+        size_t collected_cells { 0 };
+        size_t collected_cell_bytes { 0 };
+        size_t freed_blocks { 0 };
+    };
+    SweepStatistics m_sweep_statistics;
+    size_t m_unswept_block_count { 0 };
+
+    struct PauseTimes {
+        void record(i64 us)
+        {
+            ++count;
+            total_us += us;
+            max_us = max(max_us, us);
+        }
+
+        size_t count { 0 };
+        i64 total_us { 0 };
+        i64 max_us { 0 };
+    };
+    PauseTimes m_minor_pause_times;
+    PauseTimes m_incremental_pause_times;
+    PauseTimes m_major_pause_times;
+
+    void record_pause(PauseTimes&, i64 us);
+
+    // Upper bounds of the buckets of the pause time histogram, the last bucket has everything else.
+    static constexpr AK::Array<i64, 9> pause_histogram_limits_us { 100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000 };
+    AK::Array<size_t, pause_histogram_limits_us.size() + 1> m_pause_histogram {};
 
     bool m_should_collect_on_every_allocation { false };
 
@@ -107,7 +225,7 @@ private:
     Vector<NonnullOwnPtr<CellAllocator>> m_allocators;
     HashTable<HandleImpl*> m_handles;
 
-    HashTable<MarkedValueList*> m_marked_value_lists;
+    MarkedValueList::List m_marked_value_lists;
 
     HashTable<WeakContainer*> m_weak_containers;
 
@@ -30,6 +30,10 @@ public:
     size_t cell_count() const { return (block_size - sizeof(HeapBlock)) / m_cell_size; }
     bool is_full() const { return !has_lazy_freelist() && !m_freelist; }
 
+    // Set between the end of marking and the block getting swept, its unmarked cells are dead but not freed yet.
+    bool needs_sweep() const { return m_needs_sweep; }
+    void set_needs_sweep(bool b) { m_needs_sweep = b; }
+
     ALWAYS_INLINE Cell* allocate()
     {
         Cell* allocated_cell = nullptr;
@@ -110,6 +114,7 @@ private:
     size_t m_cell_size { 0 };
     size_t m_next_lazy_freelist_index { 0 };
     FreelistEntry* m_freelist { nullptr };
+    bool m_needs_sweep { false };
     alignas(Cell) u8 m_storage[];
 
 public:
@@ -88,7 +88,7 @@ void Interpreter::enter_scope(const ScopeNode& scope_node, ScopeType scope_type,
             lexical_environment()->put_into_environment(declaration.name(), { js_undefined(), DeclarationKind::Var });
         }
         for (auto& declaration : scope_node.functions()) {
-            auto* function = OrdinaryFunctionObject::create(global_object, declaration.name(), declaration.body(), declaration.parameters(), declaration.function_length(), lexical_environment(), declaration.kind(), declaration.is_strict_mode());
+            auto* function = OrdinaryFunctionObject::create(global_object, declaration, lexical_environment(), declaration.is_strict_mode());
             vm().set_variable(declaration.name(), function, global_object);
         }
     });
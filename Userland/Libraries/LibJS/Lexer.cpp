@@ -18,9 +18,10 @@ HashMap<String, TokenType> Lexer::s_three_char_tokens;
 HashMap<String, TokenType> Lexer::s_two_char_tokens;
 HashMap<char, TokenType> Lexer::s_single_char_tokens;
 
-Lexer::Lexer(StringView source, StringView filename, size_t line_number, size_t line_column)
+Lexer::Lexer(StringView source, StringView filename, size_t line_number, size_t line_column, size_t offset)
     : m_source(source)
-    , m_current_token(TokenType::Eof, {}, StringView(nullptr), StringView(nullptr), filename, 0, 0)
+    , m_position(offset)
+    , m_current_token(TokenType::Eof, {}, StringView(nullptr), StringView(nullptr), filename, 0, 0, 0)
     , m_filename(filename)
     , m_line_number(line_number)
     , m_line_column(line_column)
@@ -659,7 +660,8 @@ Token Lexer::next()
         m_source.substring_view(value_start - 1, m_position - value_start),
         m_filename,
         value_start_line_number,
-        value_start_column_number);
+        value_start_column_number,
+        value_start - 1);
 
     if constexpr (LEXER_DEBUG) {
         dbgln("------------------------------");
@@ -16,7 +16,7 @@ namespace JS {
 
 class Lexer {
 public:
-    explicit Lexer(StringView source, StringView filename = "(unknown)", size_t line_number = 1, size_t line_column = 0);
+    explicit Lexer(StringView source, StringView filename = "(unknown)", size_t line_number = 1, size_t line_column = 0, size_t offset = 0);
 
     Token next();
 
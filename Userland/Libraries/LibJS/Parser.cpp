@@ -1508,16 +1508,103 @@ NonnullRefPtr<FunctionNodeType> Parser::parse_function_node(u8 parse_options)
     m_state.function_parameters.append(parameters);
 
     bool is_strict = false;
-    auto body = parse_block_statement(is_strict);
+    RefPtr<BlockStatement> body;
+    RefPtr<LazyFunctionBody> lazy_body;
+    // Methods and arrow functions are left alone, they are small and usually called soon anyway.
+    if (m_parses_functions_lazily && (parse_options & FunctionNodeParseOptions::CheckForFunctionAndName) && can_skip_function_body(is_strict)) {
+        lazy_body = skip_function_body();
+    } else {
+        body = parse_block_statement(is_strict);
+        scope.add_to_scope_node(*body);
+    }
 
     m_state.function_parameters.take_last();
 
-    scope.add_to_scope_node(body);
-
-    return create_ast_node<FunctionNodeType>(
+    auto function_node = create_ast_node<FunctionNodeType>(
         { m_state.current_token.filename(), rule_start.position(), position() },
         name, move(body), move(parameters), function_length,
         is_generator ? FunctionKind::Generator : FunctionKind::Regular, is_strict);
+    if (lazy_body)
+        function_node->set_lazy_body(lazy_body.release_nonnull());
+    return function_node;
+}
+
+// We have to know whether a function is strict before we call it, so look ahead for a "use strict" directive.
+// If it's not obvious whether there is one, the body has to be parsed right away.
+bool Parser::can_skip_function_body(bool& is_strict) const
+{
+    if (!match(TokenType::CurlyOpen))
+        return false;
+
+    is_strict = m_state.strict_mode;
+    if (is_strict)
+        return true;
+
+    auto lexer = m_state.lexer;
+    auto first_token = lexer.next();
+    if (first_token.type() != TokenType::StringLiteral || (first_token.value() != "'use strict'" && first_token.value() != "\"use strict\""))
+        return true;
+
+    auto second_token = lexer.next();
+    if (second_token.type() != TokenType::Semicolon && second_token.type() != TokenType::CurlyClose)
+        return false;
+    is_strict = true;
+    return true;
+}
+
+NonnullRefPtr<LazyFunctionBody> Parser::skip_function_body()
+{
+    if (m_lazy_function_source.is_null()) {
+        m_lazy_function_source = m_state.lexer.source();
+        m_lazy_function_filename = m_state.lexer.filename();
+    }
+    auto lazy_body = create<LazyFunctionBody>(m_lazy_function_source, m_lazy_function_filename, position(), m_state.strict_mode, m_state.in_generator_function_context);
+
+    consume(TokenType::CurlyOpen);
+    // The lexer gives the braces of template literal substitutions their own token types, so counting the
+    // curly braces is enough to find the end of the body.
+    size_t depth = 1;
+    while (depth > 0) {
+        switch (m_state.current_token.type()) {
+        case TokenType::CurlyOpen:
+            ++depth;
+            break;
+        case TokenType::CurlyClose:
+            --depth;
+            break;
+        case TokenType::Eof:
+            expected("}");
+            return lazy_body;
+        case TokenType::Invalid:
+        case TokenType::UnterminatedRegexLiteral:
+        case TokenType::UnterminatedStringLiteral:
+        case TokenType::UnterminatedTemplateLiteral:
+            expected("valid token");
+            break;
+        default:
+            break;
+        }
+        consume();
+    }
+    return lazy_body;
+}
+
+NonnullRefPtr<BlockStatement> Parser::parse_lazy_function_body(LazyFunctionBody const& lazy_body)
+{
+    // Functions inside the body are skipped over again, and share its copy of the source.
+    m_parses_functions_lazily = true;
+    m_lazy_function_source = lazy_body.source();
+    m_lazy_function_filename = lazy_body.filename();
+
+    m_state.strict_mode = lazy_body.is_in_strict_mode_context();
+    m_state.in_function_context = true;
+    m_state.in_generator_function_context = lazy_body.is_in_generator_function_context();
+
+    ScopePusher scope(*this, ScopePusher::Var, Parser::Scope::Function);
+    bool is_strict = false;
+    auto body = parse_block_statement(is_strict);
+    scope.add_to_scope_node(body);
+    return body;
 }
 
 Vector<FunctionNode::Parameter> Parser::parse_formal_parameters(int& function_length, u8 parse_options)
@@ -2377,7 +2464,8 @@ Position Parser::position() const
 {
     return {
         m_state.current_token.line_number(),
-        m_state.current_token.line_column()
+        m_state.current_token.line_column(),
+        m_state.current_token.offset()
     };
 }
 
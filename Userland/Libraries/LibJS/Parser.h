@@ -39,6 +39,12 @@ public:
 
     NonnullRefPtr<Program> parse_program(bool starts_in_strict_mode = false);
 
+    // Only checks that the braces in the bodies of functions match up, and parses them when they are first
+    // called. This saves a lot of time and memory on scripts that define many functions they never call,
+    // but syntax errors in a function body are only reported once the function runs.
+    void set_parses_functions_lazily(bool parses_functions_lazily) { m_parses_functions_lazily = parses_functions_lazily; }
+    NonnullRefPtr<BlockStatement> parse_lazy_function_body(LazyFunctionBody const&);
+
     template<typename FunctionNodeType>
     NonnullRefPtr<FunctionNodeType> parse_function_node(u8 parse_options = FunctionNodeParseOptions::CheckForFunctionAndName);
     Vector<FunctionNode::Parameter> parse_formal_parameters(int& function_length, u8 parse_options = 0);
@@ -160,6 +166,8 @@ private:
     Token consume(TokenType type);
     Token consume_and_validate_numeric_literal();
     void consume_or_insert_semicolon();
+    bool can_skip_function_body(bool& is_strict) const;
+    NonnullRefPtr<LazyFunctionBody> skip_function_body();
     void save_state();
     void load_state();
     void discard_saved_state();
@@ -260,5 +268,10 @@ private:
     FlyString m_filename;
     Vector<ParserState> m_saved_state;
     HashMap<Position, TokenMemoization, PositionKeyTraits> m_token_memoizations;
+
+    bool m_parses_functions_lazily { false };
+    // Lazily parsed functions share a copy of the source, since the lexer doesn't own it.
+    String m_lazy_function_source;
+    String m_lazy_function_filename;
 };
 }
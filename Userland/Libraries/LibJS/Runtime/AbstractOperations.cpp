@@ -403,7 +403,7 @@ Value perform_eval(Value x, GlobalObject& caller_realm, CallerMode strict_caller
 }
 
 // 10.4.4.6 CreateUnmappedArgumentsObject ( argumentsList ), https://tc39.es/ecma262/#sec-createunmappedargumentsobject
-Object* create_unmapped_arguments_object(GlobalObject& global_object, Vector<Value> const& arguments)
+Object* create_unmapped_arguments_object(GlobalObject& global_object, Span<Value const> arguments)
 {
     auto& vm = global_object.vm();
 
@@ -450,7 +450,7 @@ Object* create_unmapped_arguments_object(GlobalObject& global_object, Vector<Val
 }
 
 // 10.4.4.7 CreateMappedArgumentsObject ( func, formals, argumentsList, env ), https://tc39.es/ecma262/#sec-createmappedargumentsobject
-Object* create_mapped_arguments_object(GlobalObject& global_object, FunctionObject& function, Vector<FunctionNode::Parameter> const& formals, Vector<Value> const& arguments, Environment& environment)
+Object* create_mapped_arguments_object(GlobalObject& global_object, FunctionObject& function, Vector<FunctionNode::Parameter> const& formals, Span<Value const> arguments, Environment& environment)
 {
     auto& vm = global_object.vm();
 
@@ -33,4 +33,7 @@ private:
     bool m_length_writable { true };
 };
 
+template<>
+inline constexpr bool has_write_barriers<Array> = true;
+
 }
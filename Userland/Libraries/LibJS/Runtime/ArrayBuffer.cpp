@@ -24,6 +24,7 @@ ArrayBuffer::ArrayBuffer(size_t byte_size, Object& prototype)
     , m_buffer(ByteBuffer::create_zeroed(byte_size))
     , m_detach_key(js_undefined())
 {
+    heap().did_allocate_external_memory(byte_size);
 }
 
 ArrayBuffer::ArrayBuffer(ByteBuffer* buffer, Object& prototype)
@@ -35,6 +36,15 @@ ArrayBuffer::ArrayBuffer(ByteBuffer* buffer, Object& prototype)
 
 ArrayBuffer::~ArrayBuffer()
 {
+    if (m_buffer.has<ByteBuffer>())
+        heap().did_free_external_memory(m_buffer.get<ByteBuffer>().size());
+}
+
+void ArrayBuffer::detach_buffer()
+{
+    if (m_buffer.has<ByteBuffer>())
+        heap().did_free_external_memory(m_buffer.get<ByteBuffer>().size());
+    m_buffer = Empty {};
 }
 
 void ArrayBuffer::visit_edges(Cell::Visitor& visitor)
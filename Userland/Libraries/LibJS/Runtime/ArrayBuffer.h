@@ -34,7 +34,7 @@ public:
     Value detach_key() const { return m_detach_key; }
     void set_detach_key(Value detach_key) { m_detach_key = detach_key; }
 
-    void detach_buffer() { m_buffer = Empty {}; }
+    void detach_buffer();
     bool is_detached() const { return m_buffer.has<Empty>(); }
 
     enum Order {
@@ -9,6 +9,7 @@
 
 #include <AK/Function.h>
 #include <AK/HashTable.h>
+#include <AK/QuickSort.h>
 #include <AK/ScopeGuard.h>
 #include <AK/StringBuilder.h>
 #include <LibJS/Runtime/AbstractOperations.h>
@@ -26,6 +27,26 @@ namespace JS {
 
 static HashTable<Object*> s_array_join_seen_objects;
 
+// If the object is an array that keeps its elements unboxed, every index below its length is an own data
+// property, so HasProperty() is true and Get() can't run any code. Callbacks can change the array under
+// our feet, so this has to be asked again for every index.
+static Optional<Value> packed_array_element(Object const& object, size_t index)
+{
+    if (!is<Array>(object))
+        return {};
+    auto& indexed_properties = object.indexed_properties();
+    if (index >= indexed_properties.array_like_size())
+        return {};
+    switch (indexed_properties.element_kind()) {
+    case ElementKind::PackedInt32:
+        return Value(indexed_properties.packed_int32_elements()[index]);
+    case ElementKind::PackedDouble:
+        return Value(indexed_properties.packed_double_elements()[index]);
+    default:
+        return {};
+    }
+}
+
 ArrayPrototype::ArrayPrototype(GlobalObject& global_object)
     : Array(*global_object.object_prototype())
 {
@@ -251,6 +272,13 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::for_each)
     // 4. Let k be 0.
     // 5. Repeat, while k < len,
     for (size_t k = 0; k < length; ++k) {
+        if (auto k_value = packed_array_element(*object, k); k_value.has_value()) {
+            (void)vm.call(callback_function.as_function(), this_arg, *k_value, Value(k), object);
+            if (vm.exception())
+                return {};
+            continue;
+        }
+
         // a. Let Pk be ! ToString(𝔽(k)).
         auto property_name = PropertyName { k };
 
@@ -309,6 +337,16 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::map)
     // 5. Let k be 0.
     // 6. Repeat, while k < len,
     for (size_t k = 0; k < length; ++k) {
+        if (auto k_value = packed_array_element(*object, k); k_value.has_value()) {
+            auto mapped_value = vm.call(callback_function.as_function(), this_arg, *k_value, Value(k), object);
+            if (vm.exception())
+                return {};
+            array->create_data_property_or_throw(k, mapped_value);
+            if (vm.exception())
+                return {};
+            continue;
+        }
+
         // a. Let Pk be ! ToString(𝔽(k)).
         auto property_name = PropertyName { k };
 
@@ -780,6 +818,53 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::slice)
     return new_array;
 }
 
+// Strict equality between a number and an unboxed element is plain numeric equality, and nothing that isn't a
+// number can equal one, so the elements can be scanned directly. Returns -1 if nothing matches, and an empty
+// Optional if the array doesn't keep its elements unboxed, or has become shorter than it was.
+static Optional<Value> index_of_in_packed_array(IndexedProperties const& indexed_properties, Value search_element, size_t start, size_t end)
+{
+    auto kind = indexed_properties.element_kind();
+    if (kind != ElementKind::PackedInt32 && kind != ElementKind::PackedDouble)
+        return {};
+    if (end > indexed_properties.array_like_size())
+        return {};
+    if (!search_element.is_number())
+        return Value(-1);
+
+    auto needle = search_element.as_double();
+
+    if (kind == ElementKind::PackedDouble) {
+        auto elements = indexed_properties.packed_double_elements();
+        for (size_t i = start; i < end; ++i) {
+            if (elements[i] == needle)
+                return Value(i);
+        }
+        return Value(-1);
+    }
+
+    // This also takes care of NaN, and lets -0 find 0.
+    if (!(needle >= NumericLimits<i32>::min() && needle <= NumericLimits<i32>::max()) || trunc(needle) != needle)
+        return Value(-1);
+    auto int_needle = static_cast<i32>(needle);
+    auto elements = indexed_properties.packed_int32_elements();
+
+    // Compare a few elements at a time without branching, which the compiler can turn into vector compares.
+    constexpr size_t chunk_size = 8;
+    size_t i = start;
+    for (; i + chunk_size <= end; i += chunk_size) {
+        bool any_match = false;
+        for (size_t j = 0; j < chunk_size; ++j)
+            any_match |= elements[i + j] == int_needle;
+        if (any_match)
+            break;
+    }
+    for (; i < end; ++i) {
+        if (elements[i] == int_needle)
+            return Value(i);
+    }
+    return Value(-1);
+}
+
 // 23.1.3.14 Array.prototype.indexOf ( searchElement [ , fromIndex ] ), https://tc39.es/ecma262/#sec-array.prototype.indexof
 JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::index_of)
 {
@@ -831,6 +916,11 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::index_of)
         k = max((i32)length + (i32)n, 0);
     }
 
+    if (is<Array>(*object) && k < length) {
+        if (auto result = index_of_in_packed_array(object->indexed_properties(), search_element, k, length); result.has_value())
+            return *result;
+    }
+
     // 10. Repeat, while k < len,
     for (; k < length; ++k) {
         auto property_name = PropertyName { k };
@@ -1233,6 +1323,26 @@ static void array_merge_sort(VM& vm, GlobalObject& global_object, FunctionObject
     }
 }
 
+// Without a comparefn, elements are ordered by comparing their string representations. For int32s, that is
+// a plain character comparison of their decimal digits, which doesn't need any strings to be created.
+static bool int32_less_than_as_string(i32 a, i32 b)
+{
+    auto to_decimal = [](i32 value, char (&buffer)[11]) -> StringView {
+        size_t position = sizeof(buffer);
+        u32 magnitude = value < 0 ? -static_cast<u32>(value) : value;
+        do {
+            buffer[--position] = '0' + magnitude % 10;
+            magnitude /= 10;
+        } while (magnitude != 0);
+        if (value < 0)
+            buffer[--position] = '-';
+        return { buffer + position, sizeof(buffer) - position };
+    };
+    char a_buffer[11];
+    char b_buffer[11];
+    return to_decimal(a, a_buffer) < to_decimal(b, b_buffer);
+}
+
 // 23.1.3.27 Array.prototype.sort ( comparefn ), https://tc39.es/ecma262/#sec-array.prototype.sort
 JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::sort)
 {
@@ -1250,6 +1360,16 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::sort)
     if (vm.exception())
         return {};
 
+    // Equal int32s have the same string representation, so there is nothing for a stable sort to preserve.
+    if (callback.is_undefined() && is<Array>(*object)) {
+        auto& indexed_properties = object->indexed_properties();
+        if (indexed_properties.element_kind() == ElementKind::PackedInt32 && indexed_properties.array_like_size() == length) {
+            auto elements = indexed_properties.packed_int32_elements();
+            quick_sort(elements, int32_less_than_as_string);
+            return object;
+        }
+    }
+
     MarkedValueList items(vm.heap());
     for (size_t k = 0; k < length; ++k) {
         auto k_present = object->has_property(k);
@@ -25,6 +25,9 @@ private:
     Crypto::SignedBigInteger m_big_integer;
 };
 
+template<>
+inline constexpr bool has_write_barriers<BigInt> = true;
+
 BigInt* js_bigint(Heap&, Crypto::SignedBigInteger);
 
 }
@@ -49,6 +49,7 @@ Optional<Variable> DeclarativeEnvironment::get_from_environment(FlyString const&
 
 bool DeclarativeEnvironment::put_into_environment(FlyString const& name, Variable variable)
 {
+    write_barrier(variable.value);
     m_variables.set(name, variable);
     return true;
 }
@@ -98,6 +99,7 @@ void DeclarativeEnvironment::initialize_binding(GlobalObject&, FlyString const&
     auto it = m_bindings.find(name);
     VERIFY(it != m_bindings.end());
     VERIFY(it->value.initialized == false);
+    write_barrier(value);
     it->value.value = value;
     it->value.initialized = true;
 }
@@ -125,6 +127,7 @@ void DeclarativeEnvironment::set_mutable_binding(GlobalObject& global_object, Fl
     }
 
     if (it->value.mutable_) {
+        write_barrier(value);
         it->value.value = value;
     } else {
         if (strict) {
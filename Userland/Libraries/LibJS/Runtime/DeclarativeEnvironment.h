@@ -59,4 +59,7 @@ private:
 template<>
 inline bool Environment::fast_is<DeclarativeEnvironment>() const { return is_declarative_environment(); }
 
+template<>
+inline constexpr bool has_write_barriers<DeclarativeEnvironment> = true;
+
 }
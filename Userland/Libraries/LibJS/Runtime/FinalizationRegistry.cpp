@@ -42,19 +42,20 @@ bool FinalizationRegistry::remove_by_token(Object& unregister_token)
     return removed;
 }
 
-void FinalizationRegistry::remove_swept_cells(Badge<Heap>, Vector<Cell*>& cells)
+void FinalizationRegistry::remove_dead_cells(Badge<Heap>)
 {
-    auto any_cells_were_swept = false;
-    for (auto cell : cells) {
-        for (auto& record : m_records) {
-            if (record.target != cell)
-                continue;
-            record.target = nullptr;
-            any_cells_were_swept = true;
-            break;
-        }
+    // The registry itself is about to be swept, so there's no one left to call the cleanup callback.
+    if (is_dead(*this))
+        return;
+
+    auto any_cells_were_removed = false;
+    for (auto& record : m_records) {
+        if (!record.target || !is_dead(*record.target))
+            continue;
+        record.target = nullptr;
+        any_cells_were_removed = true;
     }
-    if (any_cells_were_swept)
+    if (any_cells_were_removed)
         vm().enqueue_finalization_registry_cleanup_job(*this);
 }
 
@@ -28,6 +28,12 @@ void FunctionEnvironment::visit_edges(Visitor& visitor)
     visitor.visit(m_function_object);
 }
 
+void FunctionEnvironment::set_function_object(FunctionObject& function)
+{
+    write_barrier(&function);
+    m_function_object = &function;
+}
+
 // 9.1.1.3.5 GetSuperBase ( ), https://tc39.es/ecma262/#sec-getsuperbase
 Value FunctionEnvironment::get_super_base() const
 {
@@ -75,6 +81,7 @@ Value FunctionEnvironment::bind_this_value(GlobalObject& global_object, Value th
         vm().throw_exception<ReferenceError>(global_object, ErrorType::ThisIsAlreadyInitialized);
         return {};
     }
+    write_barrier(this_value);
     m_this_value = this_value;
     m_this_binding_status = ThisBindingStatus::Initialized;
     return this_value;
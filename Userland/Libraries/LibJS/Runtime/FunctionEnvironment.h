@@ -25,10 +25,18 @@ public:
 
     // [[ThisValue]]
     Value this_value() const { return m_this_value; }
-    void set_this_value(Value value) { m_this_value = value; }
+    void set_this_value(Value value)
+    {
+        write_barrier(value);
+        m_this_value = value;
+    }
 
     // Not a standard operation.
-    void replace_this_binding(Value this_value) { m_this_value = this_value; }
+    void replace_this_binding(Value this_value)
+    {
+        write_barrier(this_value);
+        m_this_value = this_value;
+    }
 
     // [[ThisBindingStatus]]
     ThisBindingStatus this_binding_status() const { return m_this_binding_status; }
@@ -37,11 +45,15 @@ public:
     // [[FunctionObject]]
     FunctionObject& function_object() { return *m_function_object; }
     FunctionObject const& function_object() const { return *m_function_object; }
-    void set_function_object(FunctionObject& function) { m_function_object = &function; }
+    void set_function_object(FunctionObject& function);
 
     // [[NewTarget]]
     Value new_target() const { return m_new_target; }
-    void set_new_target(Value new_target) { m_new_target = new_target; }
+    void set_new_target(Value new_target)
+    {
+        write_barrier(new_target);
+        m_new_target = new_target;
+    }
 
     // Abstract operations
     Value get_super_base() const;
@@ -63,4 +75,7 @@ private:
 template<>
 inline bool Environment::fast_is<FunctionEnvironment>() const { return is_function_environment(); }
 
+template<>
+inline constexpr bool has_write_barriers<FunctionEnvironment> = true;
+
 }
@@ -98,12 +98,9 @@ JS_DEFINE_NATIVE_FUNCTION(FunctionPrototype::call)
     }
     auto& function = static_cast<FunctionObject&>(*this_object);
     auto this_arg = vm.argument(0);
-    MarkedValueList arguments(vm.heap());
-    if (vm.argument_count() > 1) {
-        for (size_t i = 1; i < vm.argument_count(); ++i)
-            arguments.append(vm.argument(i));
-    }
-    return vm.call(function, this_arg, move(arguments));
+    // Our own arguments stay alive while the function runs, so we can pass them on without copying them first.
+    Span<Value const> arguments = vm.running_execution_context().arguments;
+    return vm.call(function, this_arg, arguments.size() > 1 ? arguments.slice(1) : Span<Value const> {});
 }
 
 // 20.2.3.5 Function.prototype.toString ( ), https://tc39.es/ecma262/#sec-function.prototype.tostring
@@ -213,6 +213,29 @@ void IndexedPropertyIterator::skip_empty_indices()
     m_index = m_indexed_properties.array_like_size();
 }
 
+IndexedProperties::IndexedProperties(Vector<Value> values)
+{
+    auto all_values_are = [&](auto predicate) {
+        for (auto& value : values) {
+            if (!predicate(value))
+                return false;
+        }
+        return true;
+    };
+
+    if (all_values_are(PackedInt32IndexedPropertyStorage::can_hold))
+        m_storage = make<PackedInt32IndexedPropertyStorage>();
+    else if (all_values_are(PackedDoubleIndexedPropertyStorage::can_hold))
+        m_storage = make<PackedDoubleIndexedPropertyStorage>();
+    else
+        m_storage = make<SimpleIndexedPropertyStorage>(move(values));
+
+    if (m_storage->is_packed_storage()) {
+        for (size_t i = 0; i < values.size(); ++i)
+            m_storage->put(i, values[i]);
+    }
+}
+
 Optional<ValueAndAttributes> IndexedProperties::get(u32 index) const
 {
     return m_storage->get(index);
@@ -220,6 +243,14 @@ Optional<ValueAndAttributes> IndexedProperties::get(u32 index) const
 
 void IndexedProperties::put(u32 index, Value value, PropertyAttributes attributes)
 {
+    if (m_storage->is_packed_storage()) {
+        // Leaving a hole, or storing something that isn't a number, takes boxed Values.
+        if (attributes != default_attributes || index > array_like_size() || !value.is_number())
+            switch_to_simple_storage();
+        else if (element_kind() == ElementKind::PackedInt32 && !PackedInt32IndexedPropertyStorage::can_hold(value))
+            switch_to_packed_double_storage();
+    }
+
     if (m_storage->is_simple_storage() && (attributes != default_attributes || index > (array_like_size() + SPARSE_ARRAY_HOLE_THRESHOLD))) {
         switch_to_generic_storage();
     }
@@ -230,6 +261,8 @@ void IndexedProperties::put(u32 index, Value value, PropertyAttributes attribute
 void IndexedProperties::remove(u32 index)
 {
     VERIFY(m_storage->has_index(index));
+    if (m_storage->is_packed_storage())
+        switch_to_simple_storage();
     m_storage->remove(index);
 }
 
@@ -253,6 +286,9 @@ bool IndexedProperties::set_array_like_size(size_t new_size)
 {
     auto current_array_like_size = array_like_size();
 
+    if (m_storage->is_packed_storage() && new_size > current_array_like_size)
+        switch_to_simple_storage();
+
     // We can't use simple storage for lengths that don't fit in an i32.
     // Also, to avoid gigantic unused storage allocations, let's put an (arbitrary) 4M cap on simple storage here.
     // This prevents something like "a = []; a.length = 0x80000000;" from allocating 2G entries.
@@ -267,6 +303,8 @@ bool IndexedProperties::set_array_like_size(size_t new_size)
 
 size_t IndexedProperties::real_size() const
 {
+    if (m_storage->is_packed_storage())
+        return array_like_size();
     if (m_storage->is_simple_storage()) {
         auto& packed_elements = static_cast<const SimpleIndexedPropertyStorage&>(*m_storage).elements();
         size_t size = 0;
@@ -281,6 +319,13 @@ size_t IndexedProperties::real_size() const
 
 Vector<u32> IndexedProperties::indices() const
 {
+    if (m_storage->is_packed_storage()) {
+        Vector<u32> indices;
+        indices.ensure_capacity(array_like_size());
+        for (size_t i = 0; i < array_like_size(); ++i)
+            indices.unchecked_append(i);
+        return indices;
+    }
     if (m_storage->is_simple_storage()) {
         const auto& storage = static_cast<const SimpleIndexedPropertyStorage&>(*m_storage);
         const auto& elements = storage.elements();
@@ -298,8 +343,29 @@ Vector<u32> IndexedProperties::indices() const
     return indices;
 }
 
+void IndexedProperties::switch_to_packed_double_storage()
+{
+    VERIFY(element_kind() == ElementKind::PackedInt32);
+    auto new_storage = make<PackedDoubleIndexedPropertyStorage>();
+    for (auto element : packed_int32_elements())
+        new_storage->put(new_storage->size(), Value(element));
+    m_storage = move(new_storage);
+}
+
+void IndexedProperties::switch_to_simple_storage()
+{
+    VERIFY(m_storage->is_packed_storage());
+    Vector<Value> values;
+    values.ensure_capacity(array_like_size());
+    for (size_t i = 0; i < array_like_size(); ++i)
+        values.unchecked_append(m_storage->get(i)->value);
+    m_storage = make<SimpleIndexedPropertyStorage>(move(values));
+}
+
 void IndexedProperties::switch_to_generic_storage()
 {
+    if (m_storage->is_packed_storage())
+        switch_to_simple_storage();
     auto& storage = static_cast<SimpleIndexedPropertyStorage&>(*m_storage);
     m_storage = make<GenericIndexedPropertyStorage>(move(storage));
 }
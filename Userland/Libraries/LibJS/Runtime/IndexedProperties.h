@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/NonnullOwnPtr.h>
+#include <AK/Span.h>
 #include <LibJS/Runtime/Shape.h>
 #include <LibJS/Runtime/Value.h>
 
@@ -21,6 +22,16 @@ class IndexedProperties;
 class IndexedPropertyIterator;
 class GenericIndexedPropertyStorage;
 
+// Storage starts out holding unboxed int32s, and moves on to unboxed doubles, then to Values and then to
+// a hash map as soon as something is stored that the current kind can't hold. It never moves back.
+// Only the Generic kind can have attributes other than the default ones, and the packed kinds have no holes.
+enum class ElementKind : u8 {
+    PackedInt32,
+    PackedDouble,
+    Simple,
+    Generic,
+};
+
 class IndexedPropertyStorage {
 public:
     virtual ~IndexedPropertyStorage() {};
@@ -37,9 +48,73 @@ public:
     virtual size_t array_like_size() const = 0;
     virtual bool set_array_like_size(size_t new_size) = 0;
 
-    virtual bool is_simple_storage() const { return false; }
+    virtual ElementKind element_kind() const = 0;
+    bool is_simple_storage() const { return element_kind() == ElementKind::Simple; }
+    bool is_packed_storage() const { return element_kind() == ElementKind::PackedInt32 || element_kind() == ElementKind::PackedDouble; }
 };
 
+template<typename T>
+class PackedIndexedPropertyStorage final : public IndexedPropertyStorage {
+public:
+    virtual bool has_index(u32 index) const override { return index < m_elements.size(); }
+
+    virtual Optional<ValueAndAttributes> get(u32 index) const override
+    {
+        if (index >= m_elements.size())
+            return {};
+        return ValueAndAttributes { Value(m_elements[index]), default_attributes };
+    }
+
+    static bool can_hold(Value value)
+    {
+        if constexpr (IsSame<T, i32>)
+            return value.type() == Value::Type::Int32;
+        else
+            return value.is_number();
+    }
+
+    virtual void put(u32 index, Value value, PropertyAttributes attributes = default_attributes) override
+    {
+        VERIFY(attributes == default_attributes);
+        VERIFY(index <= m_elements.size());
+        VERIFY(can_hold(value));
+        T element;
+        if constexpr (IsSame<T, i32>)
+            element = value.as_i32();
+        else
+            element = value.as_double();
+        if (index == m_elements.size())
+            m_elements.append(element);
+        else
+            m_elements[index] = element;
+    }
+
+    virtual void remove(u32) override { VERIFY_NOT_REACHED(); }
+
+    virtual ValueAndAttributes take_first() override { return { Value(m_elements.take_first()), default_attributes }; }
+    virtual ValueAndAttributes take_last() override { return { Value(m_elements.take_last()), default_attributes }; }
+
+    virtual size_t size() const override { return m_elements.size(); }
+    virtual size_t array_like_size() const override { return m_elements.size(); }
+    virtual bool set_array_like_size(size_t new_size) override
+    {
+        VERIFY(new_size <= m_elements.size());
+        m_elements.shrink(new_size);
+        return true;
+    }
+
+    virtual ElementKind element_kind() const override { return IsSame<T, i32> ? ElementKind::PackedInt32 : ElementKind::PackedDouble; }
+
+    Span<T const> elements() const { return m_elements.span(); }
+    Span<T> elements() { return m_elements.span(); }
+
+private:
+    Vector<T> m_elements;
+};
+
+using PackedInt32IndexedPropertyStorage = PackedIndexedPropertyStorage<i32>;
+using PackedDoubleIndexedPropertyStorage = PackedIndexedPropertyStorage<double>;
+
 class SimpleIndexedPropertyStorage final : public IndexedPropertyStorage {
 public:
     SimpleIndexedPropertyStorage() = default;
@@ -57,7 +132,7 @@ public:
     virtual size_t array_like_size() const override { return m_array_size; }
     virtual bool set_array_like_size(size_t new_size) override;
 
-    virtual bool is_simple_storage() const override { return true; }
+    virtual ElementKind element_kind() const override { return ElementKind::Simple; }
     const Vector<Value>& elements() const { return m_packed_elements; }
 
 private:
@@ -85,6 +160,8 @@ public:
     virtual size_t array_like_size() const override { return m_array_size; }
     virtual bool set_array_like_size(size_t new_size) override;
 
+    virtual ElementKind element_kind() const override { return ElementKind::Generic; }
+
     const HashMap<u32, ValueAndAttributes>& sparse_elements() const { return m_sparse_elements; }
 
 private:
@@ -114,10 +191,7 @@ class IndexedProperties {
 public:
     IndexedProperties() = default;
 
-    explicit IndexedProperties(Vector<Value> values)
-        : m_storage(make<SimpleIndexedPropertyStorage>(move(values)))
-    {
-    }
+    explicit IndexedProperties(Vector<Value> values);
 
     bool has_index(u32 index) const { return m_storage->has_index(index); }
     Optional<ValueAndAttributes> get(u32 index) const;
@@ -140,9 +214,31 @@ public:
 
     Vector<u32> indices() const;
 
+    ElementKind element_kind() const { return m_storage->element_kind(); }
+
+    // Every index below the length is an own, writable data property holding one of these.
+    Span<i32 const> packed_int32_elements() const
+    {
+        VERIFY(element_kind() == ElementKind::PackedInt32);
+        return static_cast<PackedInt32IndexedPropertyStorage const&>(*m_storage).elements();
+    }
+    Span<i32> packed_int32_elements()
+    {
+        VERIFY(element_kind() == ElementKind::PackedInt32);
+        return static_cast<PackedInt32IndexedPropertyStorage&>(*m_storage).elements();
+    }
+    Span<double const> packed_double_elements() const
+    {
+        VERIFY(element_kind() == ElementKind::PackedDouble);
+        return static_cast<PackedDoubleIndexedPropertyStorage const&>(*m_storage).elements();
+    }
+
+    // Calls the callback for every value that could be a cell, which unboxed numbers never are.
     template<typename Callback>
-    void for_each_value(Callback callback)
+    void for_each_value_that_may_be_a_cell(Callback callback)
     {
+        if (m_storage->is_packed_storage())
+            return;
         if (m_storage->is_simple_storage()) {
             for (auto& value : static_cast<SimpleIndexedPropertyStorage&>(*m_storage).elements())
                 callback(value);
@@ -153,9 +249,11 @@ public:
     }
 
 private:
+    void switch_to_packed_double_storage();
+    void switch_to_simple_storage();
     void switch_to_generic_storage();
 
-    NonnullOwnPtr<IndexedPropertyStorage> m_storage { make<SimpleIndexedPropertyStorage>() };
+    NonnullOwnPtr<IndexedPropertyStorage> m_storage { make<PackedInt32IndexedPropertyStorage>() };
 };
 
 }
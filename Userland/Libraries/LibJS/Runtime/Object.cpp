@@ -541,7 +541,7 @@ bool Object::internal_set_prototype_of(Object* new_prototype)
     if (shape.is_unique())
         shape.set_prototype_without_transition(new_prototype);
     else
-        m_shape = shape.create_prototype_transition(new_prototype);
+        set_shape(*shape.create_prototype_transition(new_prototype));
 
     // 10. Return true.
     return true;
@@ -941,6 +941,7 @@ void Object::storage_set(PropertyName const& property_name, ValueAndAttributes c
     VERIFY(property_name.is_valid());
 
     auto [value, attributes] = value_and_attributes;
+    write_barrier(value);
 
     if (property_name.is_number()) {
         auto index = property_name.as_number();
@@ -1029,6 +1030,7 @@ void Object::storage_delete(PropertyName const& property_name)
 void Object::set_shape(Shape& new_shape)
 {
     m_storage.resize(new_shape.property_count());
+    write_barrier(&new_shape);
     m_shape = &new_shape;
 }
 
@@ -1082,7 +1084,7 @@ void Object::ensure_shape_is_unique()
     if (shape().is_unique())
         return;
 
-    m_shape = m_shape->create_unique_clone();
+    set_shape(*m_shape->create_unique_clone());
 }
 
 // Simple side-effect free property lookup, following the prototype chain. Non-standard.
@@ -1193,7 +1195,7 @@ void Object::visit_edges(Cell::Visitor& visitor)
     for (auto& value : m_storage)
         visitor.visit(value);
 
-    m_indexed_properties.for_each_value([&visitor](auto& value) {
+    m_indexed_properties.for_each_value_that_may_be_a_cell([&visitor](auto& value) {
         visitor.visit(value);
     });
 }
@@ -143,6 +143,10 @@ public:
     // B.3.7 The [[IsHTMLDDA]] Internal Slot, https://tc39.es/ecma262/#sec-IsHTMLDDA-internal-slot
     virtual bool is_htmldda() const { return false; }
 
+    // Non-standard: Objects whose internal methods can get or set named properties without going through
+    // their shape and storage must return true here, so that the inline caches of the bytecode leave them alone.
+    virtual bool has_exotic_property_access() const { return false; }
+
     bool has_parameter_map() const { return m_has_parameter_map; }
     void set_has_parameter_map() { m_has_parameter_map = true; }
 
@@ -151,10 +155,24 @@ public:
     virtual Value value_of() const { return Value(const_cast<Object*>(this)); }
 
     Value get_direct(size_t index) const { return m_storage[index]; }
+    void put_direct(size_t index, Value value)
+    {
+        write_barrier(value);
+        m_storage[index] = value;
+    }
 
     const IndexedProperties& indexed_properties() const { return m_indexed_properties; }
-    IndexedProperties& indexed_properties() { return m_indexed_properties; }
-    void set_indexed_property_elements(Vector<Value>&& values) { m_indexed_properties = IndexedProperties(move(values)); }
+    IndexedProperties& indexed_properties()
+    {
+        // Whatever the caller is going to store in there, we don't get to see it.
+        write_barrier();
+        return m_indexed_properties;
+    }
+    void set_indexed_property_elements(Vector<Value>&& values)
+    {
+        write_barrier();
+        m_indexed_properties = IndexedProperties(move(values));
+    }
 
     [[nodiscard]] Value invoke_internal(const StringOrSymbol& property_name, Optional<MarkedValueList> arguments);
 
@@ -210,6 +228,11 @@ private:
     IndexedProperties m_indexed_properties;
 };
 
+// Every store into an Object goes through storage_set(), put_direct() or set_shape(), or asks for mutable
+// access to its indexed properties. Subclasses with their own pointers need to be audited separately.
+template<>
+inline constexpr bool has_write_barriers<Object> = true;
+
 template<>
 [[nodiscard]] ALWAYS_INLINE Value Object::invoke(const StringOrSymbol& property_name, MarkedValueList arguments) { return invoke_internal(property_name, move(arguments)); }
 
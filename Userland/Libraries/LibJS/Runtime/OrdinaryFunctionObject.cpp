@@ -24,24 +24,38 @@
 
 namespace JS {
 
-OrdinaryFunctionObject* OrdinaryFunctionObject::create(GlobalObject& global_object, const FlyString& name, const Statement& body, Vector<FunctionNode::Parameter> parameters, i32 m_function_length, Environment* parent_scope, FunctionKind kind, bool is_strict, bool is_arrow_function)
+static Object* function_prototype_for_kind(GlobalObject& global_object, FunctionKind kind)
 {
-    Object* prototype = nullptr;
     switch (kind) {
     case FunctionKind::Regular:
-        prototype = global_object.function_prototype();
-        break;
+        return global_object.function_prototype();
     case FunctionKind::Generator:
-        prototype = global_object.generator_function_prototype();
-        break;
+        return global_object.generator_function_prototype();
     }
-    return global_object.heap().allocate<OrdinaryFunctionObject>(global_object, global_object, name, body, move(parameters), m_function_length, parent_scope, *prototype, kind, is_strict, is_arrow_function);
+    VERIFY_NOT_REACHED();
+}
+
+OrdinaryFunctionObject* OrdinaryFunctionObject::create(GlobalObject& global_object, const FlyString& name, const Statement& body, Vector<FunctionNode::Parameter> parameters, i32 m_function_length, Environment* parent_scope, FunctionKind kind, bool is_strict, bool is_arrow_function)
+{
+    auto* prototype = function_prototype_for_kind(global_object, kind);
+    return global_object.heap().allocate<OrdinaryFunctionObject>(global_object, global_object, name, body, nullptr, move(parameters), m_function_length, parent_scope, *prototype, kind, is_strict, is_arrow_function);
+}
+
+// Unlike the overload above, this doesn't need the body of the function yet, so it can be parsed lazily.
+OrdinaryFunctionObject* OrdinaryFunctionObject::create(GlobalObject& global_object, FunctionNode const& function_node, Environment* parent_scope, bool is_strict)
+{
+    auto* prototype = function_prototype_for_kind(global_object, function_node.kind());
+    RefPtr<Statement> body;
+    if (!function_node.lazy_body())
+        body = function_node.body();
+    return global_object.heap().allocate<OrdinaryFunctionObject>(global_object, global_object, function_node.name(), move(body), function_node.lazy_body(), function_node.parameters(), function_node.function_length(), parent_scope, *prototype, function_node.kind(), is_strict, function_node.is_arrow_function());
 }
 
-OrdinaryFunctionObject::OrdinaryFunctionObject(GlobalObject& global_object, const FlyString& name, const Statement& body, Vector<FunctionNode::Parameter> parameters, i32 function_length, Environment* parent_scope, Object& prototype, FunctionKind kind, bool is_strict, bool is_arrow_function)
+OrdinaryFunctionObject::OrdinaryFunctionObject(GlobalObject& global_object, const FlyString& name, RefPtr<Statement> body, RefPtr<LazyFunctionBody> lazy_body, Vector<FunctionNode::Parameter> parameters, i32 function_length, Environment* parent_scope, Object& prototype, FunctionKind kind, bool is_strict, bool is_arrow_function)
     : FunctionObject(is_arrow_function ? vm().this_value(global_object) : Value(), {}, prototype)
     , m_name(name)
-    , m_body(body)
+    , m_body(move(body))
+    , m_lazy_body(move(lazy_body))
     , m_parameters(move(parameters))
     , m_environment(parent_scope)
     , m_realm(&global_object)
@@ -114,8 +128,9 @@ FunctionEnvironment* OrdinaryFunctionObject::create_environment(FunctionObject&
             });
     }
 
-    if (is<ScopeNode>(body())) {
-        for (auto& declaration : static_cast<const ScopeNode&>(body()).variables()) {
+    // If the body has a syntax error, execute_function_body() will throw it in a moment.
+    if (ensure_body_is_parsed() && is<ScopeNode>(*m_body)) {
+        for (auto& declaration : static_cast<const ScopeNode&>(*m_body).variables()) {
             for (auto& declarator : declaration.declarations()) {
                 declarator.target().visit(
                     [&](const NonnullRefPtr<Identifier>& id) {
@@ -139,10 +154,24 @@ FunctionEnvironment* OrdinaryFunctionObject::create_environment(FunctionObject&
     return environment;
 }
 
+bool OrdinaryFunctionObject::ensure_body_is_parsed()
+{
+    if (m_body)
+        return true;
+    VERIFY(m_lazy_body);
+    m_body = m_lazy_body->parse();
+    return !m_body.is_null();
+}
+
 Value OrdinaryFunctionObject::execute_function_body()
 {
     auto& vm = this->vm();
 
+    if (!ensure_body_is_parsed()) {
+        vm.throw_exception<SyntaxError>(global_object(), m_lazy_body->error());
+        return {};
+    }
+
     Interpreter* ast_interpreter = nullptr;
     auto* bytecode_interpreter = Bytecode::Interpreter::current();
 
@@ -181,7 +210,7 @@ Value OrdinaryFunctionObject::execute_function_body()
     if (bytecode_interpreter) {
         prepare_arguments();
         if (!m_bytecode_executable.has_value()) {
-            m_bytecode_executable = Bytecode::Generator::generate(m_body, m_kind == FunctionKind::Generator);
+            m_bytecode_executable = Bytecode::Generator::generate(*m_body, m_kind == FunctionKind::Generator);
             auto& passes = JS::Bytecode::Interpreter::optimization_pipeline();
             passes.perform(*m_bytecode_executable);
             if constexpr (JS_BYTECODE_DEBUG) {
@@ -212,7 +241,7 @@ Value OrdinaryFunctionObject::execute_function_body()
         if (vm.exception())
             return {};
 
-        return ast_interpreter->execute_statement(global_object(), m_body, ScopeType::Function);
+        return ast_interpreter->execute_statement(global_object(), *m_body, ScopeType::Function);
     }
 }
 
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/StringBuilder.h>
 #include <LibJS/Runtime/PrimitiveString.h>
 #include <LibJS/Runtime/VM.h>
 
@@ -11,11 +12,59 @@ namespace JS {
 
 PrimitiveString::PrimitiveString(String string)
     : m_string(move(string))
+    , m_length(m_string.length())
+{
+    // This is only an estimate, since the same StringImpl may well be shared by several strings.
+    heap().did_allocate_external_memory(m_length);
+}
+
+PrimitiveString::PrimitiveString(PrimitiveString& lhs, PrimitiveString& rhs)
+    : m_is_rope(true)
+    , m_lhs(&lhs)
+    , m_rhs(&rhs)
+    , m_length(lhs.length() + rhs.length())
 {
 }
 
 PrimitiveString::~PrimitiveString()
 {
+    if (!m_is_rope)
+        heap().did_free_external_memory(m_length);
+}
+
+void PrimitiveString::visit_edges(Cell::Visitor& visitor)
+{
+    Cell::visit_edges(visitor);
+    if (m_is_rope) {
+        visitor.visit(m_lhs);
+        visitor.visit(m_rhs);
+    }
+}
+
+void PrimitiveString::resolve_rope() const
+{
+    VERIFY(m_is_rope);
+
+    // Ropes built in a loop are as deep as the number of iterations, so walk them without recursing.
+    StringBuilder builder(m_length);
+    Vector<PrimitiveString const*> pieces;
+    pieces.append(m_rhs);
+    pieces.append(m_lhs);
+    while (!pieces.is_empty()) {
+        auto const* current = pieces.take_last();
+        if (current->m_is_rope) {
+            pieces.append(current->m_rhs);
+            pieces.append(current->m_lhs);
+            continue;
+        }
+        builder.append(current->m_string);
+    }
+
+    m_string = builder.build();
+    heap().did_allocate_external_memory(m_length);
+    m_is_rope = false;
+    m_lhs = nullptr;
+    m_rhs = nullptr;
 }
 
 PrimitiveString* js_string(Heap& heap, String string)
@@ -34,4 +83,21 @@ PrimitiveString* js_string(VM& vm, String string)
     return js_string(vm.heap(), move(string));
 }
 
+PrimitiveString* js_rope_string(VM& vm, PrimitiveString& lhs, PrimitiveString& rhs)
+{
+    if (lhs.length() == 0)
+        return &rhs;
+    if (rhs.length() == 0)
+        return &lhs;
+
+    if (lhs.length() + rhs.length() < PrimitiveString::min_rope_length) {
+        StringBuilder builder(lhs.length() + rhs.length());
+        builder.append(lhs.string());
+        builder.append(rhs.string());
+        return js_string(vm, builder.build());
+    }
+
+    return vm.heap().allocate_without_global_object<PrimitiveString>(lhs, rhs);
+}
+
 }
@@ -11,20 +11,47 @@
 
 namespace JS {
 
+// A PrimitiveString is either a flat string, or a rope: the lazy concatenation of two other strings.
+// Concatenating strings in a loop only links the pieces together, and the rope is flattened into a
+// single String the first time someone needs to look at its characters.
 class PrimitiveString final : public Cell {
 public:
+    // Concatenations shorter than this are cheaper to copy than to keep around as a rope.
+    static constexpr size_t min_rope_length = 32;
+
     explicit PrimitiveString(String);
+    PrimitiveString(PrimitiveString& lhs, PrimitiveString& rhs);
     virtual ~PrimitiveString();
 
-    const String& string() const { return m_string; }
+    bool is_rope() const { return m_is_rope; }
+    size_t length() const { return m_length; }
+
+    const String& string() const
+    {
+        if (m_is_rope)
+            resolve_rope();
+        return m_string;
+    }
 
 private:
     virtual const char* class_name() const override { return "PrimitiveString"; }
+    virtual void visit_edges(Cell::Visitor&) override;
 
-    String m_string;
+    void resolve_rope() const;
+
+    mutable bool m_is_rope { false };
+    mutable PrimitiveString* m_lhs { nullptr };
+    mutable PrimitiveString* m_rhs { nullptr };
+    mutable String m_string;
+    size_t m_length { 0 };
 };
 
+// The halves of a rope are only ever set by the constructor.
+template<>
+inline constexpr bool has_write_barriers<PrimitiveString> = true;
+
 PrimitiveString* js_string(Heap&, String);
 PrimitiveString* js_string(VM&, String);
+PrimitiveString* js_rope_string(VM&, PrimitiveString& lhs, PrimitiveString& rhs);
 
 }
@@ -50,6 +50,7 @@ private:
 
     virtual bool is_function() const override { return m_target.is_function(); }
     virtual bool is_proxy_object() const final { return true; }
+    virtual bool has_exotic_property_access() const final { return true; }
 
     Object& m_target;
     Object& m_handler;
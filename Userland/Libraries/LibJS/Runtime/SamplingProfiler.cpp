@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/JsonArraySerializer.h>
+#include <AK/JsonObjectSerializer.h>
+#include <AK/QuickSort.h>
+#include <AK/StringBuilder.h>
+#include <LibJS/Runtime/NativeFunction.h>
+#include <LibJS/Runtime/OrdinaryFunctionObject.h>
+#include <LibJS/Runtime/SamplingProfiler.h>
+#include <LibJS/Runtime/VM.h>
+#include <unistd.h>
+
+namespace JS {
+
+SamplingProfiler::SamplingProfiler(VM& vm, Time interval)
+    : m_vm(vm)
+    , m_interval(interval)
+{
+    VERIFY(!m_vm.sampling_profiler());
+    m_vm.set_sampling_profiler({}, this);
+    m_timer.start();
+
+    auto interval_in_microseconds = max<i64>(m_interval.to_microseconds(), 1);
+    m_thread = Threading::Thread::construct([this, interval_in_microseconds] {
+        while (!m_should_stop.load(AK::memory_order_relaxed)) {
+            usleep(interval_in_microseconds);
+            m_sample_is_pending.store(true, AK::memory_order_relaxed);
+        }
+        return 0;
+    },
+        "JS profiler");
+    m_thread->start();
+}
+
+SamplingProfiler::~SamplingProfiler()
+{
+    stop();
+}
+
+void SamplingProfiler::stop()
+{
+    if (!m_thread)
+        return;
+    m_should_stop.store(true, AK::memory_order_relaxed);
+    (void)m_thread->join();
+    m_thread = nullptr;
+    m_sample_is_pending.store(false, AK::memory_order_relaxed);
+    m_vm.set_sampling_profiler({}, nullptr);
+}
+
+static String format_source_range(SourceRange const& source_range)
+{
+    if (source_range.filename.is_empty() || source_range.filename == "(unknown)"sv)
+        return String::formatted("{}:{}", source_range.start.line, source_range.start.column);
+    return String::formatted("{}:{}:{}", source_range.filename, source_range.start.line, source_range.start.column);
+}
+
+static String frame_name_for(ExecutionContext const& context)
+{
+    auto* function = context.function;
+    if (!function)
+        return "(global)";
+
+    String name = function->name();
+    if (name.is_empty())
+        name = "(anonymous)";
+
+    if (function->is_ordinary_function_object()) {
+        if (auto* body = static_cast<OrdinaryFunctionObject const*>(function)->body())
+            return String::formatted("{} ({})", name, format_source_range(body->source_range()));
+    } else if (is<NativeFunction>(*function)) {
+        return String::formatted("{} (native)", name);
+    }
+    return name;
+}
+
+u32 SamplingProfiler::intern_frame(String const& name)
+{
+    if (auto it = m_frame_indices.find(name); it != m_frame_indices.end())
+        return it->value;
+    u32 index = m_frame_names.size();
+    m_frame_names.append(name);
+    m_frame_indices.set(name, index);
+    return index;
+}
+
+void SamplingProfiler::take_sample(SourceRange const* leaf_source_range, StringView leaf_instruction)
+{
+    m_sample_is_pending.store(false, AK::memory_order_relaxed);
+
+    Sample sample;
+    sample.timestamp_in_microseconds = m_timer.elapsed_time().to_microseconds();
+    for (auto* context : m_vm.execution_context_stack())
+        sample.frames.append(intern_frame(frame_name_for(*context)));
+    if (leaf_source_range)
+        sample.frames.append(intern_frame(String::formatted("line {}", format_source_range(*leaf_source_range))));
+    if (!leaf_instruction.is_empty())
+        sample.frames.append(intern_frame(leaf_instruction));
+    m_samples.append(move(sample));
+}
+
+String SamplingProfiler::to_folded_stacks() const
+{
+    // Semicolons separate the frames, so they can't appear in their names.
+    auto sanitized_frame_names = m_frame_names;
+    for (auto& name : sanitized_frame_names)
+        name.replace(";", ",", true);
+
+    HashMap<String, size_t> counts;
+    for (auto& sample : m_samples) {
+        StringBuilder builder;
+        for (size_t i = 0; i < sample.frames.size(); ++i) {
+            if (i != 0)
+                builder.append(';');
+            builder.append(sanitized_frame_names[sample.frames[i]]);
+        }
+        auto stack = builder.to_string();
+        counts.set(stack, counts.get(stack).value_or(0) + 1);
+    }
+
+    Vector<String> stacks;
+    for (auto& it : counts)
+        stacks.append(it.key);
+    quick_sort(stacks);
+
+    StringBuilder builder;
+    for (auto& stack : stacks)
+        builder.appendff("{} {}\n", stack, counts.get(stack).value());
+    return builder.to_string();
+}
+
+String SamplingProfiler::to_chrome_trace() const
+{
+    StringBuilder builder;
+    {
+        JsonObjectSerializer object(builder);
+        auto events = object.add_array("traceEvents");
+
+        // Consecutive samples that share the outer part of their call stack extend the same events, so a
+        // function that ran for a while shows up as one long event instead of one per sample.
+        struct OpenFrame {
+            u32 frame { 0 };
+            i64 start { 0 };
+        };
+        Vector<OpenFrame> open_frames;
+        auto close_frames_down_to = [&](size_t depth, i64 end) {
+            while (open_frames.size() > depth) {
+                auto open_frame = open_frames.take_last();
+                auto event = events.add_object();
+                event.add("name", m_frame_names[open_frame.frame]);
+                event.add("cat", "js");
+                event.add("ph", "X");
+                event.add("ts", open_frame.start);
+                event.add("dur", end - open_frame.start);
+                event.add("pid", 1);
+                event.add("tid", 1);
+            }
+        };
+
+        for (auto& sample : m_samples) {
+            size_t common_depth = 0;
+            while (common_depth < open_frames.size() && common_depth < sample.frames.size() && open_frames[common_depth].frame == sample.frames[common_depth])
+                ++common_depth;
+            close_frames_down_to(common_depth, sample.timestamp_in_microseconds);
+            for (size_t i = common_depth; i < sample.frames.size(); ++i)
+                open_frames.append({ sample.frames[i], sample.timestamp_in_microseconds });
+        }
+        if (!m_samples.is_empty())
+            close_frames_down_to(0, m_samples.last().timestamp_in_microseconds + m_interval.to_microseconds());
+
+        events.finish();
+        object.add("displayTimeUnit", "ms");
+    }
+    return builder.to_string();
+}
+
+}
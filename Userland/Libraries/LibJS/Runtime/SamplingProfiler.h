@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/HashMap.h>
+#include <AK/String.h>
+#include <AK/Time.h>
+#include <AK/Vector.h>
+#include <LibCore/ElapsedTimer.h>
+#include <LibJS/Forward.h>
+#include <LibJS/SourceRange.h>
+#include <LibThreading/Thread.h>
+
+namespace JS {
+
+// Periodically records the JavaScript call stack of a VM, so that we can tell where a script spends its time.
+//
+// Interrupting the interpreter at an arbitrary point would leave us looking at a half-updated call stack, so
+// a timer thread only asks for a sample, and the interpreters take it the next time they start a statement
+// (or an instruction, in bytecode mode) while one is pending.
+class SamplingProfiler {
+    AK_MAKE_NONCOPYABLE(SamplingProfiler);
+    AK_MAKE_NONMOVABLE(SamplingProfiler);
+
+public:
+    explicit SamplingProfiler(VM&, Time interval = Time::from_milliseconds(1));
+    ~SamplingProfiler();
+
+    void stop();
+    bool is_running() const { return !m_thread.is_null(); }
+
+    bool has_pending_sample() const { return m_sample_is_pending.load(AK::memory_order_relaxed); }
+
+    // The leaf is the statement that's about to run, and the bytecode instruction if there is one.
+    void take_sample(SourceRange const* leaf_source_range, StringView leaf_instruction = {});
+
+    size_t sample_count() const { return m_samples.size(); }
+
+    // One line per distinct call stack, with the frames separated by semicolons and followed by the number of
+    // samples that were taken in it. This is the input format of flamegraph.pl and friends.
+    String to_folded_stacks() const;
+
+    // The Trace Event Format that chrome://tracing and Perfetto can load.
+    String to_chrome_trace() const;
+
+private:
+    struct Sample {
+        i64 timestamp_in_microseconds { 0 };
+        Vector<u32> frames;
+    };
+
+    u32 intern_frame(String const&);
+
+    VM& m_vm;
+    Time m_interval;
+    Core::ElapsedTimer m_timer { true };
+    RefPtr<Threading::Thread> m_thread;
+    Atomic<bool> m_sample_is_pending { false };
+    Atomic<bool> m_should_stop { false };
+
+    Vector<String> m_frame_names;
+    HashMap<String, u32> m_frame_indices;
+    Vector<Sample> m_samples;
+};
+
+}
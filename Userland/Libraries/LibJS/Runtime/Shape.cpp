@@ -5,6 +5,7 @@
  */
 
 #include <LibJS/Heap/DeferGC.h>
+#include <LibJS/Heap/Heap.h>
 #include <LibJS/Runtime/GlobalObject.h>
 #include <LibJS/Runtime/Shape.h>
 
@@ -28,7 +29,7 @@ Shape* Shape::get_or_prune_cached_forward_transition(TransitionKey const& key)
     auto it = m_forward_transitions.find(key);
     if (it == m_forward_transitions.end())
         return nullptr;
-    if (!it->value) {
+    if (!it->value || Heap::is_dead_but_unswept(*it->value)) {
         // The cached forward transition has gone stale (from garbage collection). Prune it.
         m_forward_transitions.remove(it);
         return nullptr;
@@ -180,6 +181,8 @@ void Shape::add_property_to_unique_shape(const StringOrSymbol& property_name, Pr
     VERIFY(is_unique());
     VERIFY(m_property_table);
     VERIFY(!m_property_table->contains(property_name));
+    if (property_name.is_symbol())
+        write_barrier(property_name.as_symbol());
     m_property_table->set(property_name, { m_property_table->size(), attributes });
     ++m_property_count;
 }
@@ -211,6 +214,8 @@ void Shape::add_property_without_transition(StringOrSymbol const& property_name,
 {
     VERIFY(property_name.is_valid());
     ensure_property_table();
+    if (property_name.is_symbol())
+        write_barrier(property_name.as_symbol());
     if (m_property_table->set(property_name, { m_property_count, attributes }) == AK::HashSetResult::InsertedNewEntry)
         ++m_property_count;
 }
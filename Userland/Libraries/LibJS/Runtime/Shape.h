@@ -79,7 +79,11 @@ public:
 
     Vector<Property> property_table_ordered() const;
 
-    void set_prototype_without_transition(Object* new_prototype) { m_prototype = new_prototype; }
+    void set_prototype_without_transition(Object* new_prototype)
+    {
+        write_barrier(new_prototype);
+        m_prototype = new_prototype;
+    }
 
     void remove_property_from_unique_shape(const StringOrSymbol&, size_t offset);
     void add_property_to_unique_shape(const StringOrSymbol&, PropertyAttributes attributes);
@@ -107,6 +111,9 @@ private:
     size_t m_property_count { 0 };
 };
 
+template<>
+inline constexpr bool has_write_barriers<Shape> = true;
+
 }
 
 template<>
@@ -412,18 +412,19 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::trim_end)
 // 22.1.3.4 String.prototype.concat ( ...args ), https://tc39.es/ecma262/#sec-string.prototype.concat
 JS_DEFINE_NATIVE_FUNCTION(StringPrototype::concat)
 {
-    auto string = ak_string_from(vm, global_object);
-    if (!string.has_value())
+    auto this_value = require_object_coercible(global_object, vm.this_value(global_object));
+    if (vm.exception())
+        return {};
+    auto* result = this_value.to_primitive_string(global_object);
+    if (vm.exception())
         return {};
-    StringBuilder builder;
-    builder.append(*string);
     for (size_t i = 0; i < vm.argument_count(); ++i) {
-        auto string_argument = vm.argument(i).to_string(global_object);
+        auto* string_argument = vm.argument(i).to_primitive_string(global_object);
         if (vm.exception())
             return {};
-        builder.append(string_argument);
+        result = js_rope_string(vm, *result, *string_argument);
     }
-    return js_string(vm, builder.to_string());
+    return result;
 }
 
 // 22.1.3.23 String.prototype.substring ( start, end ), https://tc39.es/ecma262/#sec-string.prototype.substring
@@ -453,6 +453,9 @@ protected:
 
 private:
     virtual bool is_typed_array() const final { return true; }
+
+    // Canonical numeric strings like "Infinity" or "NaN" are never looked up in the shape.
+    virtual bool has_exotic_property_access() const final { return true; }
 };
 
 #define JS_DECLARE_TYPED_ARRAY(ClassName, snake_name, PrototypeName, ConstructorName, Type) \
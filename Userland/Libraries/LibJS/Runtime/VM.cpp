@@ -457,9 +457,10 @@ Value VM::construct(FunctionObject& function, FunctionObject& new_target, Option
     if (auto* interpreter = interpreter_if_exists())
         callee_context.current_node = interpreter->current_node();
 
-    callee_context.arguments = function.bound_arguments();
+    if (!function.bound_arguments().is_empty())
+        callee_context.arguments.append(function.bound_arguments().data(), function.bound_arguments().size());
     if (arguments.has_value())
-        callee_context.arguments.extend(arguments.value().values());
+        callee_context.arguments.append(arguments->data(), arguments->size());
 
     if (auto* environment = callee_context.lexical_environment) {
         auto& function_environment = verify_cast<FunctionEnvironment>(*environment);
@@ -587,7 +588,7 @@ void VM::prepare_for_ordinary_call(FunctionObject& function, ExecutionContext& c
     // 15. Return calleeContext. (See NOTE above about how contexts are allocated on the C++ stack.)
 }
 
-Value VM::call_internal(FunctionObject& function, Value this_value, Optional<MarkedValueList> arguments)
+Value VM::call_internal(FunctionObject& function, Value this_value, Span<Value const> arguments)
 {
     VERIFY(!exception());
     VERIFY(!this_value.is_empty());
@@ -605,9 +606,9 @@ Value VM::call_internal(FunctionObject& function, Value this_value, Optional<Mar
         callee_context.current_node = interpreter->current_node();
 
     callee_context.this_value = function.bound_this().value_or(this_value);
-    callee_context.arguments = function.bound_arguments();
-    if (arguments.has_value())
-        callee_context.arguments.extend(arguments.value().values());
+    if (!function.bound_arguments().is_empty())
+        callee_context.arguments.append(function.bound_arguments().data(), function.bound_arguments().size());
+    callee_context.arguments.append(arguments.data(), arguments.size());
 
     if (auto* environment = callee_context.lexical_environment) {
         auto& function_environment = verify_cast<FunctionEnvironment>(*environment);
@@ -47,7 +47,8 @@ struct ExecutionContext {
     FlyString function_name;
     FunctionObject* function { nullptr };
     Value this_value;
-    Vector<Value> arguments;
+    // Most calls pass only a few arguments, so they fit in here without a heap allocation.
+    Vector<Value, 8> arguments;
     Object* arguments_object { nullptr };
     Environment* lexical_environment { nullptr };
     Environment* variable_environment { nullptr };
@@ -62,6 +63,10 @@ public:
     Heap& heap() { return m_heap; }
     const Heap& heap() const { return m_heap; }
 
+    // When the heap starts a major collection, see Heap::heap_growth_factor().
+    void set_heap_growth_factor(double factor) { m_heap.set_heap_growth_factor(factor); }
+    void set_minimum_heap_size(size_t size) { m_heap.set_minimum_heap_size(size); }
+
     Interpreter& interpreter();
     Interpreter* interpreter_if_exists();
 
@@ -170,6 +175,9 @@ public:
 
     const StackInfo& stack_info() const { return m_stack_info; };
 
+    SamplingProfiler* sampling_profiler() { return m_sampling_profiler; }
+    void set_sampling_profiler(Badge<SamplingProfiler>, SamplingProfiler* profiler) { m_sampling_profiler = profiler; }
+
     bool underscore_is_last_value() const { return m_underscore_is_last_value; }
     void set_underscore_is_last_value(bool b) { m_underscore_is_last_value = b; }
 
@@ -235,9 +243,9 @@ public:
     [[nodiscard]] ALWAYS_INLINE Value call(FunctionObject& function, Value this_value, Args... args)
     {
         if constexpr (sizeof...(Args) > 0) {
-            MarkedValueList arglist { heap() };
-            (..., arglist.append(move(args)));
-            return call(function, this_value, move(arglist));
+            // The garbage collector scans the stack conservatively, so the arguments are safe in here.
+            AK::Array<Value, sizeof...(Args)> arguments { move(args)... };
+            return call(function, this_value, Span<Value const> { arguments.span() });
         }
 
         return call(function, this_value);
@@ -260,7 +268,7 @@ public:
 private:
     VM();
 
-    [[nodiscard]] Value call_internal(FunctionObject&, Value this_value, Optional<MarkedValueList> arguments);
+    [[nodiscard]] Value call_internal(FunctionObject&, Value this_value, Span<Value const> arguments);
     void prepare_for_ordinary_call(FunctionObject&, ExecutionContext& callee_context, Value new_target);
 
     Exception* m_exception { nullptr };
@@ -292,17 +300,23 @@ private:
 
     bool m_underscore_is_last_value { false };
 
+    SamplingProfiler* m_sampling_profiler { nullptr };
+
     u32 m_execution_generation { 0 };
 };
 
+// The arguments must be kept alive by the caller, for example by living in registers or on the stack.
+template<>
+[[nodiscard]] ALWAYS_INLINE Value VM::call(FunctionObject& function, Value this_value, Span<Value const> arguments) { return call_internal(function, this_value, arguments); }
+
 template<>
-[[nodiscard]] ALWAYS_INLINE Value VM::call(FunctionObject& function, Value this_value, MarkedValueList arguments) { return call_internal(function, this_value, move(arguments)); }
+[[nodiscard]] ALWAYS_INLINE Value VM::call(FunctionObject& function, Value this_value, MarkedValueList arguments) { return call_internal(function, this_value, arguments.span()); }
 
 template<>
-[[nodiscard]] ALWAYS_INLINE Value VM::call(FunctionObject& function, Value this_value, Optional<MarkedValueList> arguments) { return call_internal(function, this_value, move(arguments)); }
+[[nodiscard]] ALWAYS_INLINE Value VM::call(FunctionObject& function, Value this_value, Optional<MarkedValueList> arguments) { return call_internal(function, this_value, arguments.has_value() ? arguments->span() : Span<Value const> {}); }
 
 template<>
-[[nodiscard]] ALWAYS_INLINE Value VM::call(FunctionObject& function, Value this_value) { return call(function, this_value, Optional<MarkedValueList> {}); }
+[[nodiscard]] ALWAYS_INLINE Value VM::call(FunctionObject& function, Value this_value) { return call_internal(function, this_value, {}); }
 
 ALWAYS_INLINE Heap& Cell::heap() const
 {
@@ -349,6 +349,12 @@ inline Value js_negative_infinity()
     return Value(-INFINITY);
 }
 
+ALWAYS_INLINE void Cell::write_barrier(Value value)
+{
+    if (value.is_cell())
+        write_barrier(&value.as_cell());
+}
+
 inline void Cell::Visitor::visit(Value value)
 {
     if (value.is_cell())
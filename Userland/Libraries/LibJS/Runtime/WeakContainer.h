@@ -22,9 +22,12 @@ public:
         deregister();
     }
 
-    virtual void remove_swept_cells(Badge<Heap>, Vector<Cell*>&) = 0;
+    // Called after marking, before any of the cells that weren't reached are swept.
+    virtual void remove_dead_cells(Badge<Heap>) = 0;
 
 protected:
+    bool is_dead(Cell const& cell) const { return m_heap.is_dead(cell); }
+
     void deregister()
     {
         if (!m_registered)
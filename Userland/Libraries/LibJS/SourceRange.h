@@ -13,6 +13,7 @@ namespace JS {
 struct Position {
     size_t line { 0 };
     size_t column { 0 };
+    size_t offset { 0 };
 };
 
 struct SourceRange {
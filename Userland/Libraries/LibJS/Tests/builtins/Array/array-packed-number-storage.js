@@ -0,0 +1,119 @@
+describe("arrays of numbers keep behaving like arrays", () => {
+    test("storing other kinds of values", () => {
+        var a = [1, 2, 3];
+        a.push(4.5);
+        expect(a).toEqual([1, 2, 3, 4.5]);
+        a[1] = -0;
+        expect(Object.is(a[1], -0)).toBeTrue();
+        a.push("foo");
+        expect(a).toEqual([1, -0, 3, 4.5, "foo"]);
+        a[0] = NaN;
+        expect(a[0]).toBeNaN();
+    });
+
+    test("holes", () => {
+        var a = [1, 2, 3];
+        a[5] = 6;
+        expect(a).toHaveLength(6);
+        expect(3 in a).toBeFalse();
+        expect(a[3]).toBeUndefined();
+
+        var b = [1, 2, 3];
+        delete b[1];
+        expect(1 in b).toBeFalse();
+        expect(b).toHaveLength(3);
+
+        var c = [1, 2, 3];
+        c.length = 5;
+        expect(c).toHaveLength(5);
+        expect(4 in c).toBeFalse();
+        c.length = 1;
+        expect(c).toEqual([1]);
+    });
+
+    test("holes are looked up on the prototype", () => {
+        var a = [1, 2, 3];
+        a.length = 4;
+        Array.prototype[3] = 42;
+        try {
+            expect(a.indexOf(42)).toBe(3);
+            var seen = [];
+            a.forEach(value => seen.push(value));
+            expect(seen).toEqual([1, 2, 3, 42]);
+        } finally {
+            delete Array.prototype[3];
+        }
+    });
+
+    test("property attributes", () => {
+        var a = [1, 2, 3];
+        Object.defineProperty(a, 1, { value: 5, writable: false });
+        a[1] = 6;
+        expect(a[1]).toBe(5);
+        Object.freeze(a);
+        expect(Object.isFrozen(a)).toBeTrue();
+    });
+
+    test("shift, pop and spread", () => {
+        var a = [1, 2.5, 3];
+        expect(a.shift()).toBe(1);
+        expect(a.pop()).toBe(3);
+        expect([...a]).toEqual([2.5]);
+    });
+});
+
+describe("fast paths", () => {
+    test("indexOf", () => {
+        var ints = [];
+        for (var i = 0; i < 100; ++i) ints.push(i * 2);
+        expect(ints.indexOf(0)).toBe(0);
+        expect(ints.indexOf(-0)).toBe(0);
+        expect(ints.indexOf(198)).toBe(99);
+        expect(ints.indexOf(42, 22)).toBe(-1);
+        expect(ints.indexOf(42, -80)).toBe(21);
+        expect(ints.indexOf(3)).toBe(-1);
+        expect(ints.indexOf(4.5)).toBe(-1);
+        expect(ints.indexOf(NaN)).toBe(-1);
+        expect(ints.indexOf("2")).toBe(-1);
+
+        var doubles = [0.5, -0, NaN, Infinity];
+        expect(doubles.indexOf(0)).toBe(1);
+        expect(doubles.indexOf(NaN)).toBe(-1);
+        expect(doubles.indexOf(Infinity)).toBe(3);
+        expect(doubles.indexOf(0.5)).toBe(0);
+    });
+
+    test("indexOf with a fromIndex that shrinks the array", () => {
+        var a = [1, 2, 3, 4];
+        var fromIndex = {
+            valueOf() {
+                a.length = 2;
+                return 0;
+            },
+        };
+        expect(a.indexOf(4, fromIndex)).toBe(-1);
+    });
+
+    test("forEach and map with a callback that changes the array", () => {
+        var a = [1, 2, 3, 4];
+        var seen = [];
+        a.forEach((value, index) => {
+            seen.push(value);
+            if (index === 0) a[2] = "three";
+            if (index === 1) a.pop();
+        });
+        expect(seen).toEqual([1, 2, "three"]);
+
+        var b = [1, 2, 3];
+        expect(b.map(value => value * 2.5)).toEqual([2.5, 5, 7.5]);
+    });
+
+    test("sort without a comparator sorts by string", () => {
+        expect([10, 9, 1, -1, -10, 100, 0, 2147483647, -2147483648].sort()).toEqual([
+            -1, -10, -2147483648, 0, 1, 10, 100, 2147483647, 9,
+        ]);
+        expect([3, 1, 2].sort((a, b) => b - a)).toEqual([3, 2, 1]);
+        expect([1.5, 10, 2].sort()).toEqual([1.5, 10, 2]);
+        expect([].sort()).toEqual([]);
+    });
+});
@@ -0,0 +1,62 @@
+test("concatenating short strings", () => {
+    expect("foo" + "bar").toBe("foobar");
+    expect("" + "bar").toBe("bar");
+    expect("foo" + "").toBe("foo");
+    expect("foo" + 1 + 2).toBe("foo12");
+    expect(1 + 2 + "foo").toBe("3foo");
+});
+
+test("concatenating long strings", () => {
+    const a = "a".repeat(100);
+    const b = "b".repeat(100);
+    const s = a + b;
+    expect(s.length).toBe(200);
+    expect(s).toBe("a".repeat(100) + "b".repeat(100));
+    expect(s.startsWith(a)).toBeTrue();
+    expect(s.endsWith(b)).toBeTrue();
+    expect(s[99]).toBe("a");
+    expect(s[100]).toBe("b");
+    expect(s.charAt(150)).toBe("b");
+});
+
+test("building a string in a loop", () => {
+    let s = "";
+    for (let i = 0; i < 10000; ++i) s += "x" + (i % 10);
+    expect(s.length).toBe(20000);
+    expect(s.substring(0, 6)).toBe("x0x1x2");
+    expect(s.substring(19996)).toBe("x8x9");
+
+    let t = "";
+    for (let i = 0; i < 10000; ++i) t = t + "x" + (i % 10);
+    expect(t).toBe(s);
+});
+
+test("using a concatenated string as a property key", () => {
+    const key = "k".repeat(50) + "v".repeat(50);
+    const o = {};
+    o[key] = 1;
+    expect(o["k".repeat(50) + "v".repeat(50)]).toBe(1);
+    expect(Object.keys(o)[0]).toBe(key);
+});
+
+test("concatenating a string with itself", () => {
+    let s = "abcdefghijklmnopqrstuvwxyz0123456789";
+    for (let i = 0; i < 10; ++i) s = s + s;
+    expect(s.length).toBe(36 * 1024);
+    expect(s.indexOf("9a")).toBe(35);
+});
+
+test("template literals", () => {
+    let s = "";
+    for (let i = 0; i < 1000; ++i) s = `${s}<li>${i}</li>`;
+    expect(s.startsWith("<li>0</li><li>1</li>")).toBeTrue();
+    expect(s.endsWith("<li>999</li>")).toBeTrue();
+    const long = "y".repeat(40);
+    expect(`a${long}b${long}c`).toBe("a" + long + "b" + long + "c");
+});
+
+test("String.prototype.concat", () => {
+    const long = "z".repeat(40);
+    expect("a".concat(long, 1, long)).toBe("a" + long + "1" + long);
+    expect(String.prototype.concat.call(42, long)).toBe("42" + long);
+});
@@ -431,6 +431,28 @@ private:
     String m_column_name;
 };
 
+class FunctionCallExpression : public Expression {
+public:
+    FunctionCallExpression(String name, NonnullRefPtrVector<Expression> arguments, bool is_distinct, bool is_star)
+        : m_name(move(name))
+        , m_arguments(move(arguments))
+        , m_is_distinct(is_distinct)
+        , m_is_star(is_star)
+    {
+    }
+
+    const String& name() const { return m_name; }
+    const NonnullRefPtrVector<Expression>& arguments() const { return m_arguments; }
+    bool is_distinct() const { return m_is_distinct; }
+    bool is_star() const { return m_is_star; }
+
+private:
+    String m_name;
+    NonnullRefPtrVector<Expression> m_arguments;
+    bool m_is_distinct;
+    bool m_is_star;
+};
+
 enum class UnaryOperator {
     Minus,
     Plus,
@@ -474,6 +496,40 @@ enum class BinaryOperator {
     Or,
 };
 
+constexpr int binary_operator_precedence(BinaryOperator type)
+{
+    // https://sqlite.org/lang_expr.html - See "2. Operators, and Parse-Affecting Attributes"
+    switch (type) {
+    case BinaryOperator::Concatenate:
+        return 8;
+    case BinaryOperator::Multiplication:
+    case BinaryOperator::Division:
+    case BinaryOperator::Modulo:
+        return 7;
+    case BinaryOperator::Plus:
+    case BinaryOperator::Minus:
+        return 6;
+    case BinaryOperator::ShiftLeft:
+    case BinaryOperator::ShiftRight:
+    case BinaryOperator::BitwiseAnd:
+    case BinaryOperator::BitwiseOr:
+        return 5;
+    case BinaryOperator::LessThan:
+    case BinaryOperator::LessThanEquals:
+    case BinaryOperator::GreaterThan:
+    case BinaryOperator::GreaterThanEquals:
+        return 4;
+    case BinaryOperator::Equals:
+    case BinaryOperator::NotEquals:
+        return 3;
+    case BinaryOperator::And:
+        return 2;
+    case BinaryOperator::Or:
+        return 1;
+    }
+    VERIFY_NOT_REACHED();
+}
+
 class BinaryOperatorExpression : public NestedDoubleExpression {
 public:
     BinaryOperatorExpression(BinaryOperator type, NonnullRefPtr<Expression> lhs, NonnullRefPtr<Expression> rhs)
@@ -720,6 +776,58 @@ private:
     bool m_is_error_if_table_exists;
 };
 
+enum class IndexType {
+    BTree,
+    Hash,
+};
+
+class IndexedColumn : public ASTNode {
+public:
+    IndexedColumn(String column_name, Order order)
+        : m_column_name(move(column_name))
+        , m_order(order)
+    {
+    }
+
+    const String& column_name() const { return m_column_name; }
+    Order order() const { return m_order; }
+
+private:
+    String m_column_name;
+    Order m_order;
+};
+
+class CreateIndex : public Statement {
+public:
+    CreateIndex(String schema_name, String index_name, String table_name, IndexType index_type, NonnullRefPtrVector<IndexedColumn> indexed_columns, bool is_unique, bool is_error_if_index_exists)
+        : m_schema_name(move(schema_name))
+        , m_index_name(move(index_name))
+        , m_table_name(move(table_name))
+        , m_index_type(index_type)
+        , m_indexed_columns(move(indexed_columns))
+        , m_is_unique(is_unique)
+        , m_is_error_if_index_exists(is_error_if_index_exists)
+    {
+    }
+
+    const String& schema_name() const { return m_schema_name; }
+    const String& index_name() const { return m_index_name; }
+    const String& table_name() const { return m_table_name; }
+    IndexType index_type() const { return m_index_type; }
+    const NonnullRefPtrVector<IndexedColumn>& indexed_columns() const { return m_indexed_columns; }
+    bool is_unique() const { return m_is_unique; }
+    bool is_error_if_index_exists() const { return m_is_error_if_index_exists; }
+
+private:
+    String m_schema_name;
+    String m_index_name;
+    String m_table_name;
+    IndexType m_index_type;
+    NonnullRefPtrVector<IndexedColumn> m_indexed_columns;
+    bool m_is_unique;
+    bool m_is_error_if_index_exists;
+};
+
 class AlterTable : public Statement {
 public:
     const String& schema_name() const { return m_schema_name; }
@@ -975,4 +1083,30 @@ private:
     RefPtr<LimitClause> m_limit_clause;
 };
 
+class Explain : public Statement {
+public:
+    explicit Explain(NonnullRefPtr<Statement> statement)
+        : m_statement(move(statement))
+    {
+    }
+
+    const NonnullRefPtr<Statement>& statement() const { return m_statement; }
+
+private:
+    NonnullRefPtr<Statement> m_statement;
+};
+
+class Vacuum : public Statement {
+public:
+    explicit Vacuum(String schema_name)
+        : m_schema_name(move(schema_name))
+    {
+    }
+
+    const String& schema_name() const { return m_schema_name; }
+
+private:
+    String m_schema_name;
+};
+
 }
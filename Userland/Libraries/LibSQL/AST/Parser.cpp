@@ -37,7 +37,7 @@ NonnullRefPtr<Statement> Parser::parse_statement()
 {
     switch (m_parser_state.m_token.type()) {
     case TokenType::Create:
-        return parse_create_table_statement();
+        return parse_create_statement();
     case TokenType::Alter:
         return parse_alter_table_statement();
     case TokenType::Drop:
@@ -50,8 +50,12 @@ NonnullRefPtr<Statement> Parser::parse_statement()
         return parse_delete_statement({});
     case TokenType::Select:
         return parse_select_statement({});
+    case TokenType::Explain:
+        return parse_explain_statement();
+    case TokenType::Vacuum:
+        return parse_vacuum_statement();
     default:
-        expected("CREATE, ALTER, DROP, INSERT, UPDATE, DELETE, or SELECT");
+        expected("CREATE, ALTER, DROP, INSERT, UPDATE, DELETE, SELECT, EXPLAIN, or VACUUM");
         return create_ast_node<ErrorStatement>();
     }
 }
@@ -73,11 +77,19 @@ NonnullRefPtr<Statement> Parser::parse_statement_with_expression_list(RefPtr<Com
     }
 }
 
-NonnullRefPtr<CreateTable> Parser::parse_create_table_statement()
+NonnullRefPtr<Statement> Parser::parse_create_statement()
 {
-    // https://sqlite.org/lang_createtable.html
     consume(TokenType::Create);
 
+    if (match(TokenType::Unique) || match(TokenType::Index))
+        return parse_create_index_statement();
+
+    return parse_create_table_statement();
+}
+
+NonnullRefPtr<CreateTable> Parser::parse_create_table_statement()
+{
+    // https://sqlite.org/lang_createtable.html
     bool is_temporary = false;
     if (consume_if(TokenType::Temp) || consume_if(TokenType::Temporary))
         is_temporary = true;
@@ -108,6 +120,49 @@ NonnullRefPtr<CreateTable> Parser::parse_create_table_statement()
     return create_ast_node<CreateTable>(move(schema_name), move(table_name), move(column_definitions), is_temporary, is_error_if_table_exists);
 }
 
+NonnullRefPtr<CreateIndex> Parser::parse_create_index_statement()
+{
+    // https://sqlite.org/lang_createindex.html
+    bool is_unique = consume_if(TokenType::Unique);
+    consume(TokenType::Index);
+
+    bool is_error_if_index_exists = true;
+    if (consume_if(TokenType::If)) {
+        consume(TokenType::Not);
+        consume(TokenType::Exists);
+        is_error_if_index_exists = false;
+    }
+
+    String schema_name;
+    String index_name;
+    parse_schema_and_table_name(schema_name, index_name);
+
+    consume(TokenType::On);
+    auto table_name = consume(TokenType::Identifier).value();
+
+    // Not part of SQLite: USING selects the kind of index, like it does in PostgreSQL.
+    auto index_type = IndexType::BTree;
+    if (consume_if(TokenType::Using)) {
+        auto method = consume(TokenType::Identifier).value();
+        if (method == "HASH"sv)
+            index_type = IndexType::Hash;
+        else if (method != "BTREE"sv)
+            syntax_error(String::formatted("Unknown index type {}, expected BTREE or HASH", method));
+    }
+
+    NonnullRefPtrVector<IndexedColumn> indexed_columns;
+    parse_comma_separated_list(true, [&]() {
+        auto column_name = consume(TokenType::Identifier).value();
+        Order order = consume_if(TokenType::Desc) ? Order::Descending : Order::Ascending;
+        consume_if(TokenType::Asc); // ASC is the default, so ignore it if specified.
+        indexed_columns.append(create_ast_node<IndexedColumn>(move(column_name), order));
+    });
+
+    // FIXME: Parse partial indexes ('WHERE' clause).
+
+    return create_ast_node<CreateIndex>(move(schema_name), move(index_name), move(table_name), index_type, move(indexed_columns), is_unique, is_error_if_index_exists);
+}
+
 NonnullRefPtr<AlterTable> Parser::parse_alter_table_statement()
 {
     // https://sqlite.org/lang_altertable.html
@@ -335,6 +390,43 @@ NonnullRefPtr<Select> Parser::parse_select_statement(RefPtr<CommonTableExpressio
     return create_ast_node<Select>(move(common_table_expression_list), select_all, move(result_column_list), move(table_or_subquery_list), move(where_clause), move(group_by_clause), move(ordering_term_list), move(limit_clause));
 }
 
+NonnullRefPtr<Explain> Parser::parse_explain_statement()
+{
+    // https://sqlite.org/lang_explain.html
+    consume(TokenType::Explain);
+
+    // There is no bytecode to explain, so EXPLAIN always describes the query plan.
+    if (consume_if(TokenType::Query))
+        consume(TokenType::Plan);
+
+    if (match(TokenType::With)) {
+        auto common_table_expression_list = parse_common_table_expression_list();
+        if (!common_table_expression_list)
+            return create_ast_node<Explain>(create_ast_node<ErrorStatement>());
+        return create_ast_node<Explain>(parse_statement_with_expression_list(move(common_table_expression_list)));
+    }
+
+    if (match(TokenType::Explain)) {
+        expected("statement");
+        return create_ast_node<Explain>(create_ast_node<ErrorStatement>());
+    }
+
+    return create_ast_node<Explain>(parse_statement());
+}
+
+NonnullRefPtr<Vacuum> Parser::parse_vacuum_statement()
+{
+    // https://sqlite.org/lang_vacuum.html
+    consume(TokenType::Vacuum);
+
+    // FIXME: VACUUM INTO is not supported.
+    String schema_name;
+    if (match(TokenType::Identifier))
+        schema_name = consume().value();
+
+    return create_ast_node<Vacuum>(move(schema_name));
+}
+
 RefPtr<CommonTableExpressionList> Parser::parse_common_table_expression_list()
 {
     consume(TokenType::With);
@@ -353,11 +445,6 @@ RefPtr<CommonTableExpressionList> Parser::parse_common_table_expression_list()
 
 NonnullRefPtr<Expression> Parser::parse_expression()
 {
-    if (++m_parser_state.m_current_expression_depth > Limits::maximum_expression_tree_depth) {
-        syntax_error(String::formatted("Exceeded maximum expression tree depth of {}", Limits::maximum_expression_tree_depth));
-        return create_ast_node<ErrorExpression>();
-    }
-
     // https://sqlite.org/lang_expr.html
     auto expression = parse_primary_expression();
 
@@ -365,15 +452,20 @@ NonnullRefPtr<Expression> Parser::parse_expression()
         expression = parse_secondary_expression(move(expression));
 
     // FIXME: Parse 'bind-parameter'.
-    // FIXME: Parse 'function-name'.
     // FIXME: Parse 'raise-function'.
 
-    --m_parser_state.m_current_expression_depth;
     return expression;
 }
 
 NonnullRefPtr<Expression> Parser::parse_primary_expression()
 {
+    // Every level of nesting, including the operands of unary operators, goes through here.
+    ScopeGuard guard([&]() { --m_parser_state.m_current_expression_depth; });
+    if (++m_parser_state.m_current_expression_depth > Limits::maximum_expression_tree_depth) {
+        syntax_error(String::formatted("Exceeded maximum expression tree depth of {}", Limits::maximum_expression_tree_depth));
+        return create_ast_node<ErrorExpression>();
+    }
+
     if (auto expression = parse_literal_value_expression(); expression.has_value())
         return move(expression.value());
 
@@ -502,6 +594,9 @@ Optional<NonnullRefPtr<Expression>> Parser::parse_column_name_expression(String
     else
         first_identifier = move(with_parsed_identifier);
 
+    if (!with_parsed_period && match(TokenType::ParenOpen))
+        return parse_function_call_expression(move(first_identifier));
+
     String schema_name;
     String table_name;
     String column_name;
@@ -524,16 +619,36 @@ Optional<NonnullRefPtr<Expression>> Parser::parse_column_name_expression(String
     return create_ast_node<ColumnNameExpression>(move(schema_name), move(table_name), move(column_name));
 }
 
+NonnullRefPtr<Expression> Parser::parse_function_call_expression(String function_name)
+{
+    // https://sqlite.org/syntax/expr.html - See "function-name"
+    consume(TokenType::ParenOpen);
+
+    if (consume_if(TokenType::Asterisk)) {
+        consume(TokenType::ParenClose);
+        return create_ast_node<FunctionCallExpression>(move(function_name), NonnullRefPtrVector<Expression> {}, false, true);
+    }
+
+    bool is_distinct = consume_if(TokenType::Distinct);
+    NonnullRefPtrVector<Expression> arguments;
+    if (!match(TokenType::ParenClose))
+        parse_comma_separated_list(false, [&]() { arguments.append(parse_expression()); });
+    consume(TokenType::ParenClose);
+
+    return create_ast_node<FunctionCallExpression>(move(function_name), move(arguments), is_distinct, false);
+}
+
 Optional<NonnullRefPtr<Expression>> Parser::parse_unary_operator_expression()
 {
+    // Unary minus, plus, and bitwise not bind tighter than any binary operator, so they only take a primary expression.
     if (consume_if(TokenType::Minus))
-        return create_ast_node<UnaryOperatorExpression>(UnaryOperator::Minus, parse_expression());
+        return create_ast_node<UnaryOperatorExpression>(UnaryOperator::Minus, parse_primary_expression());
 
     if (consume_if(TokenType::Plus))
-        return create_ast_node<UnaryOperatorExpression>(UnaryOperator::Plus, parse_expression());
+        return create_ast_node<UnaryOperatorExpression>(UnaryOperator::Plus, parse_primary_expression());
 
     if (consume_if(TokenType::Tilde))
-        return create_ast_node<UnaryOperatorExpression>(UnaryOperator::BitwiseNot, parse_expression());
+        return create_ast_node<UnaryOperatorExpression>(UnaryOperator::BitwiseNot, parse_primary_expression());
 
     if (consume_if(TokenType::Not)) {
         if (match(TokenType::Exists))
@@ -548,62 +663,76 @@ Optional<NonnullRefPtr<Expression>> Parser::parse_unary_operator_expression()
 Optional<NonnullRefPtr<Expression>> Parser::parse_binary_operator_expression(NonnullRefPtr<Expression> lhs)
 {
     if (consume_if(TokenType::DoublePipe))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::Concatenate, move(lhs), parse_expression());
+        return create_binary_operator_expression(BinaryOperator::Concatenate, move(lhs), parse_expression());
 
     if (consume_if(TokenType::Asterisk))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::Multiplication, move(lhs), parse_expression());
+        return create_binary_operator_expression(BinaryOperator::Multiplication, move(lhs), parse_expression());
 
     if (consume_if(TokenType::Divide))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::Division, move(lhs), parse_expression());
+        return create_binary_operator_expression(BinaryOperator::Division, move(lhs), parse_expression());
 
     if (consume_if(TokenType::Modulus))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::Modulo, move(lhs), parse_expression());
+        return create_binary_operator_expression(BinaryOperator::Modulo, move(lhs), parse_expression());
 
     if (consume_if(TokenType::Plus))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::Plus, move(lhs), parse_expression());
+        return create_binary_operator_expression(BinaryOperator::Plus, move(lhs), parse_expression());
 
     if (consume_if(TokenType::Minus))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::Minus, move(lhs), parse_expression());
+        return create_binary_operator_expression(BinaryOperator::Minus, move(lhs), parse_expression());
 
     if (consume_if(TokenType::ShiftLeft))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::ShiftLeft, move(lhs), parse_expression());
+        return create_binary_operator_expression(BinaryOperator::ShiftLeft, move(lhs), parse_expression());
 
     if (consume_if(TokenType::ShiftRight))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::ShiftRight, move(lhs), parse_expression());
+        return create_binary_operator_expression(BinaryOperator::ShiftRight, move(lhs), parse_expression());
 
     if (consume_if(TokenType::Ampersand))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::BitwiseAnd, move(lhs), parse_expression());
+        return create_binary_operator_expression(BinaryOperator::BitwiseAnd, move(lhs), parse_expression());
 
     if (consume_if(TokenType::Pipe))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::BitwiseOr, move(lhs), parse_expression());
+        return create_binary_operator_expression(BinaryOperator::BitwiseOr, move(lhs), parse_expression());
 
     if (consume_if(TokenType::LessThan))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::LessThan, move(lhs), parse_expression());
+        return create_binary_operator_expression(BinaryOperator::LessThan, move(lhs), parse_expression());
 
     if (consume_if(TokenType::LessThanEquals))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::LessThanEquals, move(lhs), parse_expression());
+        return create_binary_operator_expression(BinaryOperator::LessThanEquals, move(lhs), parse_expression());
 
     if (consume_if(TokenType::GreaterThan))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::GreaterThan, move(lhs), parse_expression());
+        return create_binary_operator_expression(BinaryOperator::GreaterThan, move(lhs), parse_expression());
 
     if (consume_if(TokenType::GreaterThanEquals))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::GreaterThanEquals, move(lhs), parse_expression());
+        return create_binary_operator_expression(BinaryOperator::GreaterThanEquals, move(lhs), parse_expression());
 
     if (consume_if(TokenType::Equals) || consume_if(TokenType::EqualsEquals))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::Equals, move(lhs), parse_expression());
+        return create_binary_operator_expression(BinaryOperator::Equals, move(lhs), parse_expression());
 
     if (consume_if(TokenType::NotEquals1) || consume_if(TokenType::NotEquals2))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::NotEquals, move(lhs), parse_expression());
+        return create_binary_operator_expression(BinaryOperator::NotEquals, move(lhs), parse_expression());
 
     if (consume_if(TokenType::And))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::And, move(lhs), parse_expression());
+        return create_binary_operator_expression(BinaryOperator::And, move(lhs), parse_expression());
 
     if (consume_if(TokenType::Or))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::Or, move(lhs), parse_expression());
+        return create_binary_operator_expression(BinaryOperator::Or, move(lhs), parse_expression());
 
     return {};
 }
 
+NonnullRefPtr<Expression> Parser::create_binary_operator_expression(BinaryOperator type, NonnullRefPtr<Expression> lhs, NonnullRefPtr<Expression> rhs)
+{
+    // The right-hand side was parsed as a full expression, so "1 * 2 + 3" arrives here as "1 * (2 + 3)". If the operator at
+    // the top of the right-hand side binds less tightly than (or as tightly as) this one, rotate the tree so this operator
+    // takes that operator's left operand instead. This yields the precedence and left-associativity SQLite specifies.
+    if (is<BinaryOperatorExpression>(*rhs)) {
+        const auto& binary = static_cast<const BinaryOperatorExpression&>(*rhs);
+        if (binary_operator_precedence(binary.type()) <= binary_operator_precedence(type))
+            return create_ast_node<BinaryOperatorExpression>(binary.type(), create_binary_operator_expression(type, move(lhs), binary.lhs()), binary.rhs());
+    }
+
+    return create_ast_node<BinaryOperatorExpression>(type, move(lhs), move(rhs));
+}
+
 Optional<NonnullRefPtr<Expression>> Parser::parse_chained_expression()
 {
     if (!consume_if(TokenType::ParenOpen))
@@ -934,9 +1063,14 @@ NonnullRefPtr<ResultColumn> Parser::parse_result_column()
             return create_ast_node<ResultColumn>(move(table_name));
     }
 
-    auto expression = table_name.is_null()
-        ? parse_expression()
-        : static_cast<NonnullRefPtr<Expression>>(*parse_column_name_expression(move(table_name), parsed_period));
+    bool parsed_identifier = !table_name.is_null();
+    auto expression = parsed_identifier
+        ? static_cast<NonnullRefPtr<Expression>>(*parse_column_name_expression(move(table_name), parsed_period))
+        : parse_expression();
+
+    // parse_column_name_expression() only parses the column name itself, so pick up the rest of an expression like "a + 1".
+    if (parsed_identifier && match_secondary_expression())
+        expression = parse_secondary_expression(move(expression));
 
     String column_alias;
     if (consume_if(TokenType::As) || match(TokenType::Identifier))
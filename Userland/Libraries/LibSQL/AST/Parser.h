@@ -36,6 +36,7 @@ public:
 
     NonnullRefPtr<Statement> next_statement();
 
+    bool is_eof() const { return m_parser_state.m_token.type() == TokenType::Eof; }
     bool has_errors() const { return m_parser_state.m_errors.size(); }
     const Vector<Error>& errors() const { return m_parser_state.m_errors; }
 
@@ -55,13 +56,17 @@ private:
 
     NonnullRefPtr<Statement> parse_statement();
     NonnullRefPtr<Statement> parse_statement_with_expression_list(RefPtr<CommonTableExpressionList>);
+    NonnullRefPtr<Statement> parse_create_statement();
     NonnullRefPtr<CreateTable> parse_create_table_statement();
+    NonnullRefPtr<CreateIndex> parse_create_index_statement();
     NonnullRefPtr<AlterTable> parse_alter_table_statement();
     NonnullRefPtr<DropTable> parse_drop_table_statement();
     NonnullRefPtr<Insert> parse_insert_statement(RefPtr<CommonTableExpressionList>);
     NonnullRefPtr<Update> parse_update_statement(RefPtr<CommonTableExpressionList>);
     NonnullRefPtr<Delete> parse_delete_statement(RefPtr<CommonTableExpressionList>);
     NonnullRefPtr<Select> parse_select_statement(RefPtr<CommonTableExpressionList>);
+    NonnullRefPtr<Explain> parse_explain_statement();
+    NonnullRefPtr<Vacuum> parse_vacuum_statement();
     RefPtr<CommonTableExpressionList> parse_common_table_expression_list();
 
     NonnullRefPtr<Expression> parse_primary_expression();
@@ -71,6 +76,8 @@ private:
     Optional<NonnullRefPtr<Expression>> parse_column_name_expression(String with_parsed_identifier = {}, bool with_parsed_period = false);
     Optional<NonnullRefPtr<Expression>> parse_unary_operator_expression();
     Optional<NonnullRefPtr<Expression>> parse_binary_operator_expression(NonnullRefPtr<Expression> lhs);
+    NonnullRefPtr<Expression> create_binary_operator_expression(BinaryOperator, NonnullRefPtr<Expression> lhs, NonnullRefPtr<Expression> rhs);
+    NonnullRefPtr<Expression> parse_function_call_expression(String function_name);
     Optional<NonnullRefPtr<Expression>> parse_chained_expression();
     Optional<NonnullRefPtr<Expression>> parse_cast_expression();
     Optional<NonnullRefPtr<Expression>> parse_case_expression();
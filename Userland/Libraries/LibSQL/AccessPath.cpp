@@ -0,0 +1,299 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/HashMap.h>
+#include <AK/TypeCasts.h>
+#include <LibSQL/AccessPath.h>
+#include <LibSQL/Database.h>
+#include <LibSQL/Evaluator.h>
+#include <LibSQL/Heap.h>
+#include <LibSQL/Meta.h>
+#include <math.h>
+
+namespace SQL {
+
+namespace {
+
+// The fraction of the rows a range bound on a key part is assumed to keep, when nothing better is known.
+constexpr double range_selectivity = 1.0 / 3.0;
+
+// What the conditions on a single column of the table say about its value.
+struct ColumnBounds {
+    Optional<Value> equal;
+    Optional<Value> lower;
+    bool lower_inclusive { true };
+    Optional<Value> upper;
+    bool upper_inclusive { true };
+};
+
+using Bounds = HashMap<String, ColumnBounds>;
+
+}
+
+static AST::Expression const& unwrap(AST::Expression const& expression)
+{
+    if (is<AST::ChainedExpression>(expression)) {
+        auto& chain = static_cast<AST::ChainedExpression const&>(expression);
+        if (chain.expressions().size() == 1)
+            return unwrap(chain.expressions()[0]);
+    }
+    return expression;
+}
+
+static ColumnDef const* column_of(AST::Expression const& expression, TableDef const& table, String const& alias)
+{
+    auto& unwrapped = unwrap(expression);
+    if (!is<AST::ColumnNameExpression>(unwrapped))
+        return nullptr;
+    auto& column_name = static_cast<AST::ColumnNameExpression const&>(unwrapped);
+    if (!column_name.schema_name().is_null() || (!column_name.table_name().is_null() && column_name.table_name() != alias))
+        return nullptr;
+    for (auto& column : table.columns()) {
+        if (column.name() == column_name.column_name())
+            return &column;
+    }
+    return nullptr;
+}
+
+// Index keys can only be bounded by constants of the type of the indexed column. Integer
+// constants are converted when compared with a float column, so they qualify as well.
+static Optional<Value> constant_of(AST::Expression const& expression, SQLType type)
+{
+    Evaluator evaluator;
+    if (evaluator.bind(expression).has_value())
+        return {};
+    auto value = evaluator.evaluate(expression, Tuple());
+    if (value.is_null())
+        return {};
+    if (value.type() == type)
+        return value;
+    if (type == SQLType::Float && value.type() == SQLType::Integer)
+        return float_value(value.to_double().value());
+    return {};
+}
+
+static void add_lower_bound(ColumnBounds& bounds, Value const& value, bool inclusive)
+{
+    if (!bounds.lower.has_value() || value > bounds.lower.value() || (value == bounds.lower.value() && !inclusive)) {
+        bounds.lower = value;
+        bounds.lower_inclusive = inclusive;
+    }
+}
+
+static void add_upper_bound(ColumnBounds& bounds, Value const& value, bool inclusive)
+{
+    if (!bounds.upper.has_value() || value < bounds.upper.value() || (value == bounds.upper.value() && !inclusive)) {
+        bounds.upper = value;
+        bounds.upper_inclusive = inclusive;
+    }
+}
+
+static AST::BinaryOperator flip(AST::BinaryOperator op)
+{
+    switch (op) {
+    case AST::BinaryOperator::LessThan:
+        return AST::BinaryOperator::GreaterThan;
+    case AST::BinaryOperator::LessThanEquals:
+        return AST::BinaryOperator::GreaterThanEquals;
+    case AST::BinaryOperator::GreaterThan:
+        return AST::BinaryOperator::LessThan;
+    case AST::BinaryOperator::GreaterThanEquals:
+        return AST::BinaryOperator::LessThanEquals;
+    default:
+        return op;
+    }
+}
+
+// Collects the `column <op> constant` and `column BETWEEN constant AND constant` conditions.
+static void collect_bounds(AST::Expression const& condition, TableDef const& table, String const& alias, Bounds& bounds)
+{
+    auto& expression = unwrap(condition);
+
+    if (is<AST::BetweenExpression>(expression)) {
+        auto& between = static_cast<AST::BetweenExpression const&>(expression);
+        auto* column = column_of(between.expression(), table, alias);
+        if (!column || between.invert_expression())
+            return;
+        auto lower = constant_of(between.lhs(), column->type());
+        auto upper = constant_of(between.rhs(), column->type());
+        if (!lower.has_value() || !upper.has_value())
+            return;
+        auto& column_bounds = bounds.ensure(column->name());
+        add_lower_bound(column_bounds, lower.value(), true);
+        add_upper_bound(column_bounds, upper.value(), true);
+        return;
+    }
+
+    if (!is<AST::BinaryOperatorExpression>(expression))
+        return;
+    auto& binary = static_cast<AST::BinaryOperatorExpression const&>(expression);
+    auto op = binary.type();
+    auto* column = column_of(binary.lhs(), table, alias);
+    auto* constant = binary.rhs().ptr();
+    if (!column) {
+        column = column_of(binary.rhs(), table, alias);
+        constant = binary.lhs().ptr();
+        op = flip(op);
+    }
+    if (!column)
+        return;
+    auto value = constant_of(*constant, column->type());
+    if (!value.has_value())
+        return;
+
+    auto& column_bounds = bounds.ensure(column->name());
+    switch (op) {
+    case AST::BinaryOperator::Equals:
+        if (!column_bounds.equal.has_value())
+            column_bounds.equal = value.release_value();
+        break;
+    case AST::BinaryOperator::LessThan:
+    case AST::BinaryOperator::LessThanEquals:
+        add_upper_bound(column_bounds, value.value(), op == AST::BinaryOperator::LessThanEquals);
+        break;
+    case AST::BinaryOperator::GreaterThan:
+    case AST::BinaryOperator::GreaterThanEquals:
+        add_lower_bound(column_bounds, value.value(), op == AST::BinaryOperator::GreaterThanEquals);
+        break;
+    default:
+        break;
+    }
+}
+
+// The number of index entries that fit in a B-Tree node, and the number of levels needed to hold all rows.
+static double btree_fanout(IndexDef const& index, u32 block_size)
+{
+    auto entry_size = index.to_tuple_descriptor().data_length() + sizeof(u32);
+    return max(2.0, static_cast<double>(block_size - 2 * sizeof(u32)) / static_cast<double>(entry_size));
+}
+
+static double btree_depth(IndexDef const& index, u32 block_size, double rows)
+{
+    if (rows <= 1)
+        return 1;
+    return max(1.0, ceil(log(rows) / log(btree_fanout(index, block_size))));
+}
+
+static Optional<AccessPath> index_access_path(Database& database, IndexDef& index, Bounds const& bounds, double table_rows)
+{
+    auto key_definition = index.key_definition();
+    AccessPath path;
+    path.index = index;
+
+    size_t bound_parts = 0;
+    for (auto& part : key_definition) {
+        auto column_bounds = bounds.get(part.name());
+        if (!column_bounds.has_value() || !column_bounds->equal.has_value())
+            break;
+        path.range.prefix.append(column_bounds->equal.value());
+        bound_parts++;
+    }
+
+    if (index.index_type() == AST::IndexType::Hash) {
+        if (bound_parts < index.size())
+            return {};
+        path.type = AccessPath::Type::IndexLookup;
+        path.estimated_rows = 1;
+        path.cost = 1 + path.estimated_rows;
+        return path;
+    }
+
+    auto depth = btree_depth(index, database.block_size(), table_rows);
+    if (bound_parts == index.size() && index.unique()) {
+        path.type = AccessPath::Type::IndexLookup;
+        path.estimated_rows = 1;
+        path.cost = depth + path.estimated_rows;
+        return path;
+    }
+
+    auto selectivity = 1.0;
+    if (bound_parts > 0) {
+        auto distinct_keys = max(1.0, static_cast<double>(database.distinct_keys(index)));
+        selectivity = pow(1.0 / distinct_keys, static_cast<double>(bound_parts) / static_cast<double>(index.size()));
+    }
+    if (bound_parts < index.size()) {
+        if (auto column_bounds = bounds.get(key_definition[bound_parts].name()); column_bounds.has_value()) {
+            if (column_bounds->lower.has_value()) {
+                path.range.lower = column_bounds->lower;
+                path.range.lower_inclusive = column_bounds->lower_inclusive;
+                selectivity *= range_selectivity;
+            }
+            if (column_bounds->upper.has_value()) {
+                path.range.upper = column_bounds->upper;
+                path.range.upper_inclusive = column_bounds->upper_inclusive;
+                selectivity *= range_selectivity;
+            }
+        }
+    }
+    if (selectivity >= 1.0)
+        return {};
+
+    path.type = AccessPath::Type::IndexRangeScan;
+    path.estimated_rows = table_rows * selectivity;
+    path.cost = depth + path.estimated_rows / btree_fanout(index, database.block_size()) + path.estimated_rows;
+    return path;
+}
+
+AccessPath choose_access_path(Database& database, TableDef& table, String const& alias, NonnullRefPtrVector<AST::Expression> const& conditions)
+{
+    auto table_rows = static_cast<double>(database.row_count(table));
+    AccessPath best;
+    best.estimated_rows = table_rows;
+    best.cost = table_rows;
+
+    Bounds bounds;
+    for (auto& condition : conditions)
+        collect_bounds(condition, table, alias, bounds);
+    if (bounds.is_empty())
+        return best;
+
+    for (auto& index : table.indexes()) {
+        auto path = index_access_path(database, index, bounds, table_rows);
+        if (path.has_value() && path->cost < best.cost)
+            best = path.release_value();
+    }
+    return best;
+}
+
+Optional<AccessPath> ordered_access_path(Database& database, TableDef& table, String const& column_name)
+{
+    auto table_rows = static_cast<double>(database.row_count(table));
+    for (auto& index : table.indexes()) {
+        if (index.index_type() != AST::IndexType::BTree)
+            continue;
+        auto key_definition = index.key_definition();
+        auto& first_part = key_definition.first();
+        if (first_part.name() != column_name || first_part.sort_order() != AST::Order::Ascending)
+            continue;
+        AccessPath path;
+        path.type = AccessPath::Type::IndexRangeScan;
+        path.index = index;
+        path.estimated_rows = table_rows;
+        path.cost = btree_depth(index, database.block_size(), table_rows) + table_rows / btree_fanout(index, database.block_size()) + table_rows;
+        return path;
+    }
+    return {};
+}
+
+NonnullOwnPtr<Operator> create_scan(Database& database, NonnullRefPtr<TableDef> table, String const& alias, AccessPath const& path)
+{
+    OwnPtr<Operator> scan;
+    switch (path.type) {
+    case AccessPath::Type::TableScan:
+        scan = make<TableScan>(database, move(table), alias);
+        break;
+    case AccessPath::Type::IndexLookup:
+        scan = make<IndexLookup>(database, move(table), alias, *path.index, path.range.prefix);
+        break;
+    case AccessPath::Type::IndexRangeScan:
+        scan = make<IndexRangeScan>(database, move(table), alias, *path.index, path.range);
+        break;
+    }
+    scan->set_estimate({ path.estimated_rows, path.cost });
+    return scan.release_nonnull();
+}
+
+}
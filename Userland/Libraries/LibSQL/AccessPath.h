@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/NonnullOwnPtr.h>
+#include <AK/NonnullRefPtrVector.h>
+#include <AK/RefPtr.h>
+#include <AK/String.h>
+#include <LibSQL/AST/AST.h>
+#include <LibSQL/Forward.h>
+#include <LibSQL/Operator.h>
+
+namespace SQL {
+
+/**
+ * An AccessPath describes how the rows of a single table are read: by
+ * scanning the whole table, by looking up a single key in a unique index,
+ * or by scanning a range of a B-Tree index.
+ *
+ * choose_access_path() looks at the conditions of the WHERE clause that only
+ * refer to the table, and estimates the cost of every access path they make
+ * possible from the row count of the table and the number of distinct keys
+ * in its indexes. The cost is measured in the number of blocks read. The
+ * conditions are never consumed: the caller is expected to still filter the
+ * rows produced by the access path.
+ *
+ * ordered_access_path() returns a scan of a whole B-Tree index whose first
+ * key part is the given column, if the table has one. Its rows are sorted on
+ * that column, which is what a MergeJoin needs.
+ */
+struct AccessPath {
+    enum class Type {
+        TableScan,
+        IndexLookup,
+        IndexRangeScan,
+    };
+
+    Type type { Type::TableScan };
+    RefPtr<IndexDef> index;
+    IndexRange range;
+    double estimated_rows { 0 };
+    double cost { 0 };
+};
+
+AccessPath choose_access_path(Database&, TableDef&, String const& alias, NonnullRefPtrVector<AST::Expression> const& conditions);
+Optional<AccessPath> ordered_access_path(Database&, TableDef&, String const& column_name);
+NonnullOwnPtr<Operator> create_scan(Database&, NonnullRefPtr<TableDef>, String const& alias, AccessPath const&);
+
+}
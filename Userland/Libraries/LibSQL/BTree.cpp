@@ -34,6 +34,8 @@ BTreeIterator BTree::end()
     return BTreeIterator(nullptr, -1);
 }
 
+// The root is pinned in the page cache for as long as it is the root. If its block has only been
+// written to the log so far, it gets pinned when it's committed.
 void BTree::initialize_root()
 {
     if (pointer()) {
@@ -43,25 +45,56 @@ void BTree::initialize_root()
             m_root = make<TreeNode>(*this, nullptr, pointer(), buffer, offset);
         } else {
             m_root = make<TreeNode>(*this, nullptr, pointer());
+            add_to_write_ahead_log(m_root);
         }
+    } else if (heap().is_snapshot()) {
+        // A snapshot can't write, and the tree was still empty when it was taken:
+        m_root = make<TreeNode>(*this, nullptr, 0u);
     } else {
         set_pointer(new_record_pointer());
         m_root = make<TreeNode>(*this, nullptr, pointer());
+        // Write the empty root right away. Blocks that were never written are handed out
+        // again when the Heap is reopened.
+        add_to_write_ahead_log(m_root);
         if (on_new_root)
             on_new_root();
     }
+    if (pointer())
+        pin_block(pointer());
 }
 
+// The old root stays pinned if it's an internal node, like all other internal nodes.
 TreeNode* BTree::new_root()
 {
+    if (m_root->is_leaf())
+        unpin_block(m_root->pointer());
     set_pointer(new_record_pointer());
     m_root = make<TreeNode>(*this, nullptr, m_root.leak_ptr(), pointer());
     add_to_write_ahead_log(m_root->as_index_node());
+    pin_block(pointer());
     if (on_new_root)
         on_new_root();
     return m_root;
 }
 
+// Called when the root lost its last key because its two children were merged. The merged child
+// becomes the new root, and the tree gets one level shallower.
+void BTree::collapse_root()
+{
+    VERIFY(m_root && !m_root->is_leaf() && m_root->size() == 0);
+    auto old_root = m_root->pointer();
+    VERIFY(m_root->down_node(0));
+    OwnPtr<TreeNode> child = move(m_root->m_down[0].m_node);
+    child->m_up = nullptr;
+    m_root = move(child);
+    free_block(old_root);
+    set_pointer(m_root->pointer());
+    pin_block(pointer());
+    add_to_write_ahead_log(m_root->as_index_node());
+    if (on_new_root)
+        on_new_root();
+}
+
 bool BTree::insert(Key const& key)
 {
     if (!m_root)
@@ -70,6 +103,122 @@ bool BTree::insert(Key const& key)
     return m_root->insert(key);
 }
 
+bool BTree::remove(Key const& key)
+{
+    if (!m_root)
+        initialize_root();
+    VERIFY(m_root);
+    return m_root->remove(key);
+}
+
+// Builds the tree from `count` keys, which next_key() has to produce in ascending order. First the
+// leaves are written, then the levels of internal nodes above them, and finally the root. Every node is
+// filled with keys until its serialized form would take more than the fill factor of a block, so that
+// later inserts don't immediately split it. The key following a node, except for the last node of the
+// level, moves up to the next level to separate the node from its right neighbour.
+//
+// Only an empty tree can be bulk loaded. For any other tree, false is returned and no keys are consumed.
+bool BTree::bulk_load(size_t count, Function<Key()> const& next_key, double fill_factor)
+{
+    if (!m_root)
+        initialize_root();
+    VERIFY(m_root);
+    if (m_root->size() > 0)
+        return false;
+
+    auto budget = static_cast<size_t>(static_cast<double>(block_size()) * clamp(fill_factor, 0.1, 1.0));
+    auto fill_node = [](TreeNode& node, Vector<Key> const& entries, Vector<u32> const& down) {
+        node.m_is_leaf = down[0] == 0;
+        node.m_entries = entries;
+        node.m_down.clear();
+        for (auto pointer : down)
+            node.m_down.empend(&node, pointer);
+    };
+
+    // A level of the tree is built from the down pointer to the left of its first key, and `level_count`
+    // pairs of a key and the down pointer to its right. All down pointers in the leaf level are 0. Returns
+    // true if the level fits in a single node, which then becomes the root.
+    Vector<u32> children;
+    Vector<Key> separators;
+    auto build_level = [&](size_t level_count, u32 first_down, Function<Key(size_t)> const& key_at, Function<u32(size_t)> const& down_at) {
+        auto is_leaf = first_down == 0;
+        Vector<u32> nodes;
+        Vector<Key> node_separators;
+        Vector<Key> entries;
+        Vector<u32> down;
+        ByteBuffer previous;
+        size_t length = 0;
+
+        auto start_node = [&](u32 left) {
+            entries.clear();
+            down.clear();
+            down.append(left);
+            previous.clear();
+            length = max_varint_length(sizeof(u32)) + (is_leaf ? 0 : varint_length(left));
+        };
+        auto finish_node = [&]() {
+            TreeNode node(*this, nullptr, new_record_pointer());
+            fill_node(node, entries, down);
+            add_to_write_ahead_log(&node);
+            nodes.append(node.pointer());
+        };
+        auto append = [&](Key const& key, u32 right, ByteBuffer&& encoded) {
+            length += prefix_compressed_length(previous, encoded) + (is_leaf ? 0 : varint_length(right));
+            entries.append(key);
+            down.append(right);
+            previous = move(encoded);
+        };
+
+        start_node(first_down);
+        for (auto ix = 0u; ix < level_count; ix++) {
+            auto key = key_at(ix);
+            auto right = down_at(ix);
+            ByteBuffer encoded;
+            key.serialize(encoded);
+            auto entry_length = prefix_compressed_length(previous, encoded) + (is_leaf ? 0 : varint_length(right));
+            if (entries.size() < 2 || length + entry_length <= budget) {
+                append(key, right, move(encoded));
+                continue;
+            }
+            if (ix < level_count - 1) {
+                finish_node();
+                node_separators.append(key);
+                start_node(right);
+                continue;
+            }
+            // The last key can't move up, because the node to its right would be empty. The last
+            // key of the full node moves up instead:
+            auto separator = entries.take_last();
+            auto separator_down = down.take_last();
+            finish_node();
+            node_separators.append(separator);
+            start_node(separator_down);
+            encoded.clear();
+            key.serialize(encoded);
+            append(key, right, move(encoded));
+        }
+
+        if (nodes.is_empty()) {
+            // The root keeps its block, so the tree doesn't get a new root pointer:
+            fill_node(*m_root, entries, down);
+            add_to_write_ahead_log(m_root);
+            return true;
+        }
+        finish_node();
+        children = move(nodes);
+        separators = move(node_separators);
+        return false;
+    };
+
+    auto is_root = build_level(count, 0, [&](size_t) { return next_key(); }, [](size_t) { return 0u; });
+    while (!is_root) {
+        auto level_children = move(children);
+        auto level_separators = move(separators);
+        is_root = build_level(level_separators.size(), level_children[0], [&](size_t ix) { return level_separators[ix]; }, [&](size_t ix) { return level_children[ix + 1]; });
+    }
+    return true;
+}
+
 bool BTree::update_key_pointer(Key const& key)
 {
     if (!m_root)
@@ -103,6 +252,27 @@ BTreeIterator BTree::find(Key const& key)
     return end();
 }
 
+// Returns the first entry that is not less than the key. Like in find(), only the
+// leading non-NULL values of the key are compared, so the key can be a prefix.
+BTreeIterator BTree::lower_bound(Key const& key)
+{
+    if (!m_root)
+        initialize_root();
+    VERIFY(m_root);
+    auto ret = end();
+    for (TreeNode* node = m_root.ptr(); node;) {
+        auto ix = 0u;
+        while (ix < node->size() && (*node)[ix].match(key) < 0)
+            ix++;
+        if (ix < node->size())
+            ret = BTreeIterator(node, (int)ix);
+        if (node->is_leaf())
+            break;
+        node = node->down_node(ix);
+    }
+    return ret;
+}
+
 void BTree::list_tree()
 {
     if (!m_root)
@@ -22,6 +22,8 @@
 
 namespace SQL {
 
+constexpr static double DEFAULT_BULK_LOAD_FILL_FACTOR = 0.9;
+
 /**
  * The BTree class models a B-Tree index. It contains a collection of
  * Key objects organized in TreeNode objects. Keys can be inserted,
@@ -29,6 +31,15 @@ namespace SQL {
  * a tree have the same underlying structure. A BTree's TreeNodes and
  * the keys it includes are lazily loaded from the Heap when needed.
  *
+ * When a key is removed, a node that is left less than a quarter full is
+ * merged with a sibling if the two fit in a single block, and the block of
+ * the sibling is returned to the Heap. Otherwise a node that is left empty
+ * borrows a key from its sibling through their parent.
+ *
+ * An empty BTree can also be bulk loaded from keys that are already sorted.
+ * This builds the tree bottom-up, writing every node exactly once, instead
+ * of splitting nodes over and over again as keys are inserted one by one.
+ *
  * The classes implementing the B-Tree functionality are BTree, TreeNode,
  * BTreeIterator, and DownPointer (a smart pointer-like helper class).
  */
@@ -48,6 +59,7 @@ private:
     TreeNode* m_owner;
     u32 m_pointer { 0 };
     OwnPtr<TreeNode> m_node { nullptr };
+    friend BTree;
     friend TreeNode;
 };
 
@@ -66,9 +78,11 @@ public:
     [[nodiscard]] TreeNode* down_node(size_t);
     [[nodiscard]] bool is_leaf() const { return m_is_leaf; }
 
-    [[nodiscard]] size_t max_keys_in_node();
+    [[nodiscard]] size_t length() const;
+    [[nodiscard]] bool is_overfull() const;
     Key const& operator[](size_t) const;
     bool insert(Key const&);
+    bool remove(Key const&);
     bool update_key_pointer(Key const&);
     TreeNode* node_for(Key const&);
     Optional<u32> get(Key&);
@@ -81,6 +95,10 @@ private:
     bool insert_in_leaf(Key const&);
     void just_insert(Key const&, TreeNode* = nullptr);
     void split();
+    void write_or_split();
+    [[nodiscard]] bool is_underfull() const;
+    [[nodiscard]] size_t child_index(TreeNode const*) const;
+    void rebalance();
     void list_node(int);
 
     BTree& m_tree;
@@ -101,9 +119,12 @@ public:
 
     u32 root() const { return (m_root) ? m_root->pointer() : 0; }
     bool insert(Key const&);
+    bool remove(Key const&);
+    bool bulk_load(size_t count, Function<Key()> const& next_key, double fill_factor = DEFAULT_BULK_LOAD_FILL_FACTOR);
     bool update_key_pointer(Key const&);
     Optional<u32> get(Key&);
     BTreeIterator find(Key const& key);
+    BTreeIterator lower_bound(Key const& key);
     BTreeIterator begin();
     static BTreeIterator end();
     void list_tree();
@@ -115,6 +136,7 @@ private:
     BTree(Heap& heap, TupleDescriptor const&, u32 pointer);
     void initialize_root();
     TreeNode* new_root();
+    void collapse_root();
     OwnPtr<TreeNode> m_root { nullptr };
 
     friend BTreeIterator;
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibSQL/BulkLoader.h>
+#include <LibSQL/Database.h>
+#include <LibSQL/Meta.h>
+#include <LibSQL/Row.h>
+
+namespace SQL {
+
+BulkLoader::BulkLoader(Database& database, NonnullRefPtr<TableDef> table, double fill_factor, size_t sort_memory_budget)
+    : m_database(database)
+    , m_table(move(table))
+    , m_indexes(m_table->indexes())
+    , m_fill_factor(fill_factor)
+    , m_first_row(m_table->pointer())
+{
+    // The sorters share the memory budget:
+    for (auto& index : m_indexes)
+        m_entries.append(make<ExternalSorter>(m_database->get_index(index).descriptor(), sort_memory_budget / m_indexes.size()));
+}
+
+void BulkLoader::append(Row& row)
+{
+    VERIFY(!m_finished);
+    VERIFY(row.table() == m_table.ptr());
+
+    // Rows are linked newest first, like the rows added by Database::insert:
+    row.set_pointer(m_database->m_heap->new_record_pointer());
+    row.next_pointer(m_first_row);
+    m_database->update(row);
+    m_first_row = row.pointer();
+
+    for (auto ix = 0u; ix < m_indexes.size(); ix++)
+        m_entries[ix].append(m_database->index_entry(m_indexes[ix], row));
+    m_rows++;
+}
+
+bool BulkLoader::finish()
+{
+    VERIFY(!m_finished);
+    m_finished = true;
+    if (!m_rows)
+        return true;
+
+    for (auto ix = 0u; ix < m_indexes.size(); ix++) {
+        if (m_indexes[ix].unique() && !m_database->check_unique(m_indexes[ix], m_entries[ix], true)) {
+            // The rows were never linked into the table, so their blocks can be reused:
+            for (auto pointer = m_first_row; pointer != m_table->pointer();) {
+                auto next = m_database->read_row(m_table, pointer).next_pointer();
+                m_database->m_heap->free_block(pointer);
+                pointer = next;
+            }
+            return false;
+        }
+    }
+    for (auto ix = 0u; ix < m_indexes.size(); ix++)
+        m_database->load_index(m_indexes[ix], m_entries[ix], m_fill_factor);
+
+    m_database->set_first_row(m_table, m_first_row);
+    m_database->set_statistic(m_table, m_database->statistic(m_table) + m_rows);
+    return true;
+}
+
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Noncopyable.h>
+#include <AK/NonnullOwnPtrVector.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/NonnullRefPtrVector.h>
+#include <LibSQL/BTree.h>
+#include <LibSQL/ExternalSorter.h>
+#include <LibSQL/Forward.h>
+
+namespace SQL {
+
+/**
+ * A BulkLoader adds a large number of rows to a table in one go. Rows are
+ * written when they are appended, but they are only linked into the table
+ * by finish(). The entries for the indexes of the table are collected in
+ * an ExternalSorter per index. finish() builds empty B-Tree indexes
+ * bottom-up from those sorted entries, with their nodes filled up to the
+ * fill factor, and inserts the entries into other indexes in key order.
+ *
+ * If the new rows violate a UNIQUE index, finish() returns false, and the
+ * table and its indexes are left as they were. The blocks of the new rows
+ * are freed.
+ */
+class BulkLoader {
+    AK_MAKE_NONCOPYABLE(BulkLoader);
+    AK_MAKE_NONMOVABLE(BulkLoader);
+
+public:
+    BulkLoader(Database&, NonnullRefPtr<TableDef>, double fill_factor = DEFAULT_BULK_LOAD_FILL_FACTOR, size_t sort_memory_budget = DEFAULT_SORT_MEMORY_BUDGET);
+
+    void append(Row&);
+    bool finish();
+
+    [[nodiscard]] size_t rows() const { return m_rows; }
+
+private:
+    NonnullRefPtr<Database> m_database;
+    NonnullRefPtr<TableDef> m_table;
+    NonnullRefPtrVector<IndexDef> m_indexes;
+    NonnullOwnPtrVector<ExternalSorter> m_entries;
+    double m_fill_factor { DEFAULT_BULK_LOAD_FILL_FACTOR };
+    u32 m_first_row { 0 };
+    size_t m_rows { 0 };
+    bool m_finished { false };
+};
+
+}
@@ -4,25 +4,82 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Debug.h>
 #include <AK/Format.h>
+#include <AK/HashTable.h>
+#include <AK/QuickSort.h>
 #include <AK/RefPtr.h>
 #include <AK/String.h>
 
 #include <LibSQL/BTree.h>
+#include <LibSQL/BulkLoader.h>
 #include <LibSQL/Database.h>
+#include <LibSQL/ExternalSorter.h>
+#include <LibSQL/HashIndex.h>
 #include <LibSQL/Heap.h>
 #include <LibSQL/Meta.h>
 #include <LibSQL/Row.h>
 #include <LibSQL/Tuple.h>
+#include <stdio.h>
+#include <unistd.h>
 
 namespace SQL {
 
-Database::Database(String name)
-    : m_heap(Heap::construct(name))
-    , m_schemas(BTree::construct(*m_heap, SchemaDef::index_def()->to_tuple_descriptor(), m_heap->schemas_root()))
-    , m_tables(BTree::construct(*m_heap, TableDef::index_def()->to_tuple_descriptor(), m_heap->tables_root()))
-    , m_table_columns(BTree::construct(*m_heap, ColumnDef::index_def()->to_tuple_descriptor(), m_heap->table_columns_root()))
+// Statistics are stored in a B-Tree keyed by the hash of the table or index
+// they describe. The value of a statistic is kept in the pointer of its key.
+static NonnullRefPtr<IndexDef> statistics_index_def()
 {
+    NonnullRefPtr<IndexDef> s_index_def = IndexDef::construct("$statistics", true, 0);
+    if (!s_index_def->size()) {
+        s_index_def->append_column("relation_hash", SQLType::Integer, AST::Order::Ascending);
+    }
+    return s_index_def;
+}
+
+// The entries of a non-unique B-Tree index end with the pointer of their row, which makes them unique.
+static TupleDescriptor storage_descriptor(IndexDef const& index)
+{
+    auto descriptor = index.to_tuple_descriptor();
+    if (index.index_type() == AST::IndexType::BTree && !index.unique())
+        descriptor.append({ "$row", SQLType::Integer, AST::Order::Ascending });
+    return descriptor;
+}
+
+static bool same_key_values(Key const& key, Key const& other, size_t parts)
+{
+    for (auto ix = 0u; ix < parts; ix++) {
+        if (key[ix].compare(other[ix]) != 0)
+            return false;
+    }
+    return true;
+}
+
+Database::Database(String name, u32 block_size)
+    : m_heap(Heap::construct(move(name), block_size))
+{
+    initialize_catalog();
+}
+
+Database::Database(Heap& heap)
+    : m_heap(heap)
+{
+    initialize_catalog();
+}
+
+// Can be called on any thread, as long as this Database isn't being vacuumed.
+NonnullRefPtr<Database> Database::snapshot()
+{
+    return Database::construct(*m_heap->snapshot());
+}
+
+void Database::initialize_catalog()
+{
+    m_schemas = BTree::construct(*m_heap, SchemaDef::index_def()->to_tuple_descriptor(), m_heap->schemas_root());
+    m_tables = BTree::construct(*m_heap, TableDef::index_def()->to_tuple_descriptor(), m_heap->tables_root());
+    m_table_columns = BTree::construct(*m_heap, ColumnDef::index_def()->to_tuple_descriptor(), m_heap->table_columns_root());
+    m_table_indexes = BTree::construct(*m_heap, IndexDef::index_def()->to_tuple_descriptor(), m_heap->indexes_root());
+    m_statistics = BTree::construct(*m_heap, statistics_index_def()->to_tuple_descriptor(), m_heap->statistics_root());
+
     m_schemas->on_new_root = [&]() {
         m_heap->set_schemas_root(m_schemas->root());
     };
@@ -32,6 +89,100 @@ Database::Database(String name)
     m_table_columns->on_new_root = [&]() {
         m_heap->set_table_columns_root(m_table_columns->root());
     };
+    m_table_indexes->on_new_root = [&]() {
+        m_heap->set_indexes_root(m_table_indexes->root());
+    };
+    m_statistics->on_new_root = [&]() {
+        m_heap->set_statistics_root(m_statistics->root());
+    };
+}
+
+// Rebuilds the database into a new file next to it, which then replaces it. The rows of every table
+// are copied oldest first using a BulkLoader, and the indexes are built bottom-up afterwards, so the
+// new file has no free blocks, and its B-Tree nodes are packed to the bulk load fill factor. Tables
+// and indexes looked up before are stale afterwards, and have to be looked up again. Returns false
+// without doing anything if snapshots of the database are open, which still read the old file.
+bool Database::vacuum()
+{
+    VERIFY(!is_snapshot());
+    if (m_heap->open_snapshots())
+        return false;
+    commit();
+    auto file_name = m_heap->name();
+    auto vacuum_name = String::formatted("{}-vacuum", file_name);
+    unlink(vacuum_name.characters());
+    unlink(String::formatted("{}-wal", vacuum_name).characters());
+
+    {
+        auto copy = Database::construct(vacuum_name, block_size());
+        for (auto schema_iterator = m_schemas->begin(); !schema_iterator.is_end(); schema_iterator++) {
+            auto schema_name = (*schema_iterator)["schema_name"].to_string().value();
+            auto schema = get_schema(schema_name);
+            VERIFY(schema);
+            copy->add_schema(SchemaDef::construct(schema_name));
+            auto new_schema = copy->get_schema(schema_name);
+
+            auto schema_hash = schema->key().hash();
+            Vector<String> table_names;
+            for (auto table_iterator = m_tables->find(TableDef::make_key(*schema));
+                 !table_iterator.is_end() && ((*table_iterator)["schema_hash"].to_u32().value() == schema_hash);
+                 table_iterator++) {
+                table_names.append((*table_iterator)["table_name"].to_string().value());
+            }
+
+            for (auto& table_name : table_names) {
+                auto table = get_table(schema_name, table_name);
+                VERIFY(table);
+                auto new_table_def = TableDef::construct(new_schema, table_name);
+                for (auto& column : table->columns())
+                    new_table_def->append_column(column.name(), column.type());
+                copy->add_table(new_table_def);
+                auto new_table = copy->get_table(schema_name, table_name);
+                VERIFY(new_table);
+
+                Vector<u32> row_pointers;
+                for (auto pointer = table->pointer(); pointer;) {
+                    row_pointers.append(pointer);
+                    pointer = read_row(table, pointer).next_pointer();
+                }
+                BulkLoader loader(copy, new_table.release_nonnull());
+                for (auto ix = row_pointers.size(); ix > 0; ix--) {
+                    auto row = read_row(table, row_pointers[ix - 1]);
+                    Row new_row(copy->get_table(schema_name, table_name));
+                    for (auto column = 0u; column < row.length(); column++)
+                        new_row[column] = row[column];
+                    loader.append(new_row);
+                }
+                VERIFY(loader.finish());
+
+                for (auto& index : table->indexes()) {
+                    auto new_index = IndexDef::construct(copy->get_table(schema_name, table_name).ptr(), index.name(), index.unique(), 0, index.index_type());
+                    for (auto& part : index.key_definition())
+                        new_index->append_column(part.name(), part.type());
+                    VERIFY(copy->add_index(new_index));
+                }
+            }
+        }
+        copy->commit();
+    }
+
+    // Closing the Heap checkpoints its write-ahead log, so the file can be replaced:
+    m_index_cache.clear();
+    m_table_cache.clear();
+    m_schema_cache.clear();
+    m_schemas = nullptr;
+    m_tables = nullptr;
+    m_table_columns = nullptr;
+    m_table_indexes = nullptr;
+    m_statistics = nullptr;
+    m_heap = nullptr;
+    if (rename(vacuum_name.characters(), file_name.characters()) < 0) {
+        perror("rename");
+        VERIFY_NOT_REACHED();
+    }
+    m_heap = Heap::construct(file_name);
+    initialize_catalog();
+    return true;
 }
 
 void Database::add_schema(SchemaDef const& schema)
@@ -54,7 +205,7 @@ RefPtr<SchemaDef> Database::get_schema(String const& schema_name)
         return schema_def_opt.value();
     auto schema_iterator = m_schemas->find(key);
     if (schema_iterator.is_end() || (*schema_iterator != key)) {
-        warnln("Schema {} not found", schema_name);
+        dbgln_if(SQL_DEBUG, "Schema {} not found", schema_name);
         return nullptr;
     }
     auto ret = SchemaDef::construct(*schema_iterator);
@@ -85,7 +236,7 @@ RefPtr<TableDef> Database::get_table(String const& schema, String const& name)
         return table_def_opt.value();
     auto table_iterator = m_tables->find(key);
     if (table_iterator.is_end() || (*table_iterator != key)) {
-        warnln("Table {} not found", name);
+        dbgln_if(SQL_DEBUG, "Table {} not found", name);
         return nullptr;
     }
     auto schema_def = get_schema(schema);
@@ -101,9 +252,241 @@ RefPtr<TableDef> Database::get_table(String const& schema, String const& name)
          column_iterator++) {
         ret->append_column(*column_iterator);
     }
+
+    for (auto index_iterator = m_table_indexes->find(IndexDef::make_key(*ret));
+         !index_iterator.is_end() && ((*index_iterator)["table_hash"].to_u32().value() == hash);
+         index_iterator++) {
+        auto& index = ret->append_index(*index_iterator);
+        auto index_hash = index.hash();
+        for (auto part_iterator = m_table_columns->find(ColumnDef::make_key(index));
+             !part_iterator.is_end() && ((*part_iterator)["table_hash"].to_u32().value() == index_hash);
+             part_iterator++) {
+            index.append_column(*part_iterator);
+        }
+    }
     return ret;
 }
 
+// Adds the index to the catalog, and fills it with the rows already in its table. Returns
+// false without changing anything if a unique index would get duplicate keys.
+bool Database::add_index(IndexDef& index)
+{
+    auto* table = dynamic_cast<TableDef*>(index.parent());
+    VERIFY(table);
+    VERIFY(m_table_cache.get(table->key().hash()).has_value());
+
+    ExternalSorter entries(storage_descriptor(index));
+    for (auto pointer = table->pointer(); pointer;) {
+        auto row = read_row(table, pointer);
+        entries.append(index_entry(index, row));
+        pointer = row.next_pointer();
+    }
+    if (index.unique() && !check_unique(index, entries, false)) {
+        index.remove_from_parent();
+        return false;
+    }
+
+    if (index.index_type() == AST::IndexType::Hash)
+        index.set_pointer(m_heap->new_record_pointer());
+    m_table_indexes->insert(index.key());
+    for (auto& part : index.key_definition())
+        m_table_columns->insert(part.key());
+    table->append_index(index);
+    load_index(index, entries, DEFAULT_BULK_LOAD_FILL_FACTOR);
+    return true;
+}
+
+Index& Database::get_index(IndexDef& index)
+{
+    auto hash = index.hash();
+    if (auto it = m_index_cache.find(hash); it != m_index_cache.end())
+        return *it->value;
+
+    RefPtr<Index> storage;
+    if (index.index_type() == AST::IndexType::Hash) {
+        VERIFY(index.pointer());
+        storage = HashIndex::construct(*m_heap, index.to_tuple_descriptor(), index.pointer());
+    } else {
+        auto btree = BTree::construct(*m_heap, storage_descriptor(index), index.pointer());
+        btree->on_new_root = [this, index = NonnullRefPtr<IndexDef>(index), &btree = *btree]() mutable {
+            index->set_pointer(btree.root());
+            VERIFY(m_table_indexes->update_key_pointer(index->key()));
+        };
+        storage = move(btree);
+    }
+    m_index_cache.set(hash, storage);
+    return *storage;
+}
+
+RefPtr<BTree> Database::get_btree(IndexDef& index)
+{
+    if (index.index_type() != AST::IndexType::BTree)
+        return nullptr;
+    return static_cast<BTree*>(&get_index(index));
+}
+
+RefPtr<HashIndex> Database::get_hash_index(IndexDef& index)
+{
+    if (index.index_type() != AST::IndexType::Hash)
+        return nullptr;
+    return static_cast<HashIndex*>(&get_index(index));
+}
+
+Key Database::index_key(IndexDef& index, Row const& row)
+{
+    Key key(storage_descriptor(index));
+    for (auto& part : index.key_definition())
+        key[part.name()] = row[part.name()];
+    return key;
+}
+
+// The entry for the row as it is stored in the index.
+Key Database::index_entry(IndexDef& index, Row const& row)
+{
+    auto key = index_key(index, row);
+    key.set_pointer(row.pointer());
+    if (index.index_type() == AST::IndexType::BTree && !index.unique())
+        key["$row"] = row.pointer();
+    return key;
+}
+
+bool Database::contains_key(IndexDef& index, Key& key)
+{
+    if (auto hash_index = get_hash_index(index); hash_index)
+        return hash_index->get(key).has_value();
+    return !get_btree(index)->find(key).is_end();
+}
+
+void Database::insert_into_index(IndexDef& index, Row const& row)
+{
+    auto entry = index_entry(index, row);
+    if (auto hash_index = get_hash_index(index); hash_index) {
+        hash_index->insert(entry);
+        return;
+    }
+
+    auto btree = get_btree(index);
+    if (!index.unique() && btree->find(index_key(index, row)).is_end())
+        set_statistic(index, statistic(index) + 1);
+    btree->insert(entry);
+}
+
+void Database::remove_from_index(IndexDef& index, Row const& row)
+{
+    auto entry = index_entry(index, row);
+    if (auto hash_index = get_hash_index(index); hash_index) {
+        hash_index->remove(entry);
+        return;
+    }
+
+    auto btree = get_btree(index);
+    VERIFY(btree->remove(entry));
+    if (!index.unique() && btree->find(index_key(index, row)).is_end())
+        set_statistic(index, statistic(index) - 1);
+}
+
+// Checks that the sorted entries don't hold the same key twice and, if asked to, that none
+// of their keys are in the index already.
+bool Database::check_unique(IndexDef& index, ExternalSorter& entries, bool check_existing_entries)
+{
+    VERIFY(index.unique());
+    entries.rewind();
+    Optional<Key> previous;
+    for (auto entry = entries.next(); entry.has_value(); entry = entries.next()) {
+        if (previous.has_value() && previous->compare(entry.value()) == 0)
+            return false;
+        if (check_existing_entries && contains_key(index, entry.value()))
+            return false;
+        previous = entry.release_value();
+    }
+    return true;
+}
+
+// Adds the sorted entries to the index. An empty B-Tree index is built bottom-up.
+void Database::load_index(IndexDef& index, ExternalSorter& entries, double fill_factor)
+{
+    entries.rewind();
+    if (auto hash_index = get_hash_index(index); hash_index) {
+        for (auto entry = entries.next(); entry.has_value(); entry = entries.next())
+            hash_index->insert(entry.value());
+        return;
+    }
+
+    // Entries with the same key values are next to each other, so a new distinct key is found by
+    // comparing every entry with the previous one, and then with the index if it wasn't empty.
+    auto btree = get_btree(index);
+    auto distinct_keys = index.unique() ? 0u : statistic(index);
+    Optional<Key> previous;
+    auto count_distinct_keys = [&](Key const& entry, bool index_was_empty) {
+        if (index.unique())
+            return;
+        auto is_new = !previous.has_value() || !same_key_values(previous.value(), entry, index.size());
+        if (is_new && !index_was_empty) {
+            Key key = entry;
+            key[index.size()].set_null();
+            is_new = btree->find(key).is_end();
+        }
+        if (is_new)
+            distinct_keys++;
+        previous = entry;
+    };
+
+    auto loaded = btree->bulk_load(
+        entries.size(), [&]() {
+            auto entry = entries.next().release_value();
+            count_distinct_keys(entry, true);
+            return entry;
+        },
+        fill_factor);
+    if (!loaded) {
+        for (auto entry = entries.next(); entry.has_value(); entry = entries.next()) {
+            count_distinct_keys(entry.value(), false);
+            btree->insert(entry.value());
+        }
+    }
+    if (!index.unique())
+        set_statistic(index, distinct_keys);
+}
+
+void Database::set_first_row(TableDef& table, u32 pointer)
+{
+    auto table_key = table.key();
+    table_key.set_pointer(pointer);
+    VERIFY(m_tables->update_key_pointer(table_key));
+    table.set_pointer(pointer);
+}
+
+u32 Database::row_count(TableDef const& table)
+{
+    return statistic(table);
+}
+
+u32 Database::distinct_keys(IndexDef& index)
+{
+    if (index.unique())
+        return row_count(*dynamic_cast<TableDef const*>(index.parent_relation()));
+    return statistic(index);
+}
+
+u32 Database::statistic(Relation const& relation)
+{
+    Key key(statistics_index_def());
+    key["relation_hash"] = relation.hash();
+    auto iterator = m_statistics->find(key);
+    if (iterator.is_end())
+        return 0;
+    return (*iterator).pointer();
+}
+
+void Database::set_statistic(Relation const& relation, u32 value)
+{
+    Key key(statistics_index_def());
+    key["relation_hash"] = relation.hash();
+    key.set_pointer(value);
+    if (!m_statistics->update_key_pointer(key))
+        m_statistics->insert(key);
+}
+
 Vector<Row> Database::select_all(TableDef const& table)
 {
     VERIFY(m_table_cache.get(table.key().hash()).has_value());
@@ -117,6 +500,15 @@ Vector<Row> Database::select_all(TableDef const& table)
     return ret;
 }
 
+Row Database::read_row(RefPtr<TableDef> table, u32 pointer)
+{
+    VERIFY(pointer);
+    auto buffer_or_error = m_heap->read_block(pointer);
+    if (buffer_or_error.is_error())
+        VERIFY_NOT_REACHED();
+    return Row(move(table), pointer, buffer_or_error.value());
+}
+
 Vector<Row> Database::match(TableDef const& table, Key const& key)
 {
     VERIFY(m_table_cache.get(table.key().hash()).has_value());
@@ -129,29 +521,78 @@ Vector<Row> Database::match(TableDef const& table, Key const& key)
         if (buffer_or_error.is_error())
             VERIFY_NOT_REACHED();
         Row row(table, pointer, buffer_or_error.value());
+        pointer = row.next_pointer();
         if (row.match(key))
             ret.append(row);
-        pointer = ret.last().next_pointer();
     }
     return ret;
 }
 
 bool Database::insert(Row& row)
 {
-    VERIFY(m_table_cache.get(row.table()->key().hash()).has_value());
+    auto table = row.table();
+    VERIFY(m_table_cache.get(table->key().hash()).has_value());
+
+    // Check the unique indexes first, so a rejected row doesn't leave anything behind:
+    for (auto& index : table->indexes()) {
+        if (!index.unique())
+            continue;
+        auto key = index_key(index, row);
+        if (contains_key(index, key))
+            return false;
+    }
+
     row.set_pointer(m_heap->new_record_pointer());
-    row.next_pointer(row.table()->pointer());
+    row.next_pointer(table->pointer());
     update(row);
 
-    // TODO update indexes defined on table.
+    for (auto& index : table->indexes())
+        insert_into_index(index, row);
 
-    auto table_key = row.table()->key();
-    table_key.set_pointer(row.pointer());
-    VERIFY(m_tables->update_key_pointer(table_key));
-    row.table()->set_pointer(row.pointer());
+    set_first_row(*table, row.pointer());
+    set_statistic(*table, statistic(*table) + 1);
     return true;
 }
 
+// Removes the rows from the table and its indexes, and returns their blocks to the Heap. The rows
+// are unlinked from the list of rows of the table in a single pass over it.
+void Database::remove(TableDef& table, Vector<u32> const& row_pointers)
+{
+    VERIFY(m_table_cache.get(table.key().hash()).has_value());
+    if (row_pointers.is_empty())
+        return;
+    HashTable<u32> removed;
+    for (auto pointer : row_pointers)
+        removed.set(pointer);
+
+    auto first_row = table.pointer();
+    Optional<Row> previous;
+    u32 removed_rows = 0;
+    for (auto pointer = table.pointer(); pointer;) {
+        auto row = read_row(table, pointer);
+        pointer = row.next_pointer();
+        if (!removed.contains(row.pointer())) {
+            previous = move(row);
+            continue;
+        }
+
+        if (previous.has_value()) {
+            previous->next_pointer(pointer);
+            update(previous.value());
+        } else {
+            first_row = pointer;
+        }
+        for (auto& index : table.indexes())
+            remove_from_index(index, row);
+        m_heap->free_block(row.pointer());
+        removed_rows++;
+    }
+
+    if (first_row != table.pointer())
+        set_first_row(table, first_row);
+    set_statistic(table, statistic(table) - removed_rows);
+}
+
 bool Database::update(Row& tuple)
 {
     VERIFY(m_table_cache.get(tuple.table()->key().hash()).has_value());
@@ -18,15 +18,42 @@ namespace SQL {
  * A Database object logically connects a Heap with the SQL data we want
  * to store in it. It has BTree pointers for B-Trees holding the definitions
  * of tables, columns, indexes, and other SQL objects.
+ *
+ * The indexes defined on a table are kept up to date when rows are inserted.
+ * The Database also maintains the statistics the query planner uses to pick
+ * between scanning a table and using one of its indexes: the number of rows
+ * in every table, and the number of distinct keys in every non-unique index.
+ *
+ * Large numbers of rows are better added using a BulkLoader, which builds
+ * empty indexes bottom-up instead of inserting their keys one by one. This
+ * is also how an index is built when it is added to a table that already
+ * has rows.
+ *
+ * The blocks of removed rows, and of index nodes merged by the removal of
+ * their keys, go on the free list of the Heap, to be reused by the next
+ * inserts. vacuum() rebuilds the whole database into a new file without
+ * free blocks.
+ *
+ * snapshot() returns a read-only Database, which sees the database as it was
+ * at the last commit(). A snapshot has its own catalog and index objects on
+ * top of a snapshot of the Heap, so it can be read on another thread while
+ * this Database goes on inserting and removing rows, without either of them
+ * waiting for the other. Writing to a snapshot is not allowed, and a database
+ * can't be vacuumed while snapshots of it are open.
  */
 class Database : public Core::Object {
     C_OBJECT(Database);
 
 public:
-    explicit Database(String);
+    explicit Database(String, u32 block_size = DEFAULT_BLOCK_SIZE);
     ~Database() override = default;
 
     void commit() { m_heap->flush(); }
+    bool vacuum();
+    NonnullRefPtr<Database> snapshot();
+    [[nodiscard]] bool is_snapshot() const { return m_heap->is_snapshot(); }
+    [[nodiscard]] Heap const& heap() const { return *m_heap; }
+    [[nodiscard]] u32 block_size() const { return m_heap->block_size(); }
 
     void add_schema(SchemaDef const&);
     static Key get_schema_key(String const&);
@@ -36,19 +63,48 @@ public:
     static Key get_table_key(String const&, String const&);
     RefPtr<TableDef> get_table(String const&, String const&);
 
+    bool add_index(IndexDef&);
+    RefPtr<BTree> get_btree(IndexDef&);
+    RefPtr<HashIndex> get_hash_index(IndexDef&);
+
     Vector<Row> select_all(TableDef const&);
+    Row read_row(RefPtr<TableDef>, u32);
     Vector<Row> match(TableDef const&, Key const&);
     bool insert(Row&);
     bool update(Row&);
+    void remove(TableDef&, Vector<u32> const& row_pointers);
+
+    u32 row_count(TableDef const&);
+    u32 distinct_keys(IndexDef&);
 
 private:
+    explicit Database(Heap&);
+
+    void initialize_catalog();
+    Index& get_index(IndexDef&);
+    Key index_key(IndexDef&, Row const&);
+    Key index_entry(IndexDef&, Row const&);
+    bool contains_key(IndexDef&, Key&);
+    void insert_into_index(IndexDef&, Row const&);
+    void remove_from_index(IndexDef&, Row const&);
+    bool check_unique(IndexDef&, ExternalSorter&, bool check_existing_entries);
+    void load_index(IndexDef&, ExternalSorter&, double fill_factor);
+    void set_first_row(TableDef&, u32);
+    u32 statistic(Relation const&);
+    void set_statistic(Relation const&, u32);
+
     RefPtr<Heap> m_heap;
     RefPtr<BTree> m_schemas;
     RefPtr<BTree> m_tables;
     RefPtr<BTree> m_table_columns;
+    RefPtr<BTree> m_table_indexes;
+    RefPtr<BTree> m_statistics;
 
     HashMap<u32, RefPtr<SchemaDef>> m_schema_cache;
     HashMap<u32, RefPtr<TableDef>> m_table_cache;
+    HashMap<u32, RefPtr<Index>> m_index_cache;
+
+    friend BulkLoader;
 };
 
 }
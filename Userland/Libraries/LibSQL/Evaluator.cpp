@@ -0,0 +1,677 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/BitCast.h>
+#include <AK/NumericLimits.h>
+#include <AK/StringBuilder.h>
+#include <AK/TypeCasts.h>
+#include <LibSQL/Evaluator.h>
+#include <ctype.h>
+#include <math.h>
+
+namespace SQL {
+
+template<typename Callback>
+static void for_each_child(AST::Expression const& expression, Callback callback)
+{
+    if (auto* in_chain = dynamic_cast<AST::InChainedExpression const*>(&expression)) {
+        callback(*in_chain->expression());
+        for (auto& element : in_chain->expression_chain()->expressions())
+            callback(element);
+        return;
+    }
+    if (auto* nested = dynamic_cast<AST::NestedExpression const*>(&expression))
+        callback(*nested->expression());
+    if (auto* nested = dynamic_cast<AST::NestedDoubleExpression const*>(&expression)) {
+        callback(*nested->lhs());
+        callback(*nested->rhs());
+    }
+    if (auto* between = dynamic_cast<AST::BetweenExpression const*>(&expression))
+        callback(*between->expression());
+    if (auto* match = dynamic_cast<AST::MatchExpression const*>(&expression); match && match->escape())
+        callback(*match->escape());
+    if (auto* chain = dynamic_cast<AST::ChainedExpression const*>(&expression)) {
+        for (auto& element : chain->expressions())
+            callback(element);
+    }
+    if (auto* call = dynamic_cast<AST::FunctionCallExpression const*>(&expression)) {
+        for (auto& argument : call->arguments())
+            callback(argument);
+    }
+    if (auto* case_expression = dynamic_cast<AST::CaseExpression const*>(&expression)) {
+        if (case_expression->case_expression())
+            callback(*case_expression->case_expression());
+        for (auto& clause : case_expression->when_then_clauses()) {
+            callback(*clause.when);
+            callback(*clause.then);
+        }
+        if (case_expression->else_expression())
+            callback(*case_expression->else_expression());
+    }
+}
+
+static bool is_scalar_function(String const& name, size_t argument_count)
+{
+    if (name.is_one_of("ABS", "LENGTH", "LOWER", "UPPER"))
+        return argument_count == 1;
+    if (name == "IFNULL")
+        return argument_count == 2;
+    if (name.is_one_of("COALESCE", "MIN", "MAX"))
+        return argument_count >= 2;
+    return false;
+}
+
+Evaluator::Evaluator(Vector<OperatorColumn> columns)
+    : m_columns(move(columns))
+{
+}
+
+void Evaluator::substitute(AST::Expression const& expression, size_t column_index)
+{
+    VERIFY(column_index < m_columns.size());
+    m_bindings.set(&expression, column_index);
+}
+
+Optional<String> Evaluator::bind(AST::Expression const& expression)
+{
+    if (m_bindings.contains(&expression))
+        return {};
+
+    if (is<AST::ColumnNameExpression>(expression))
+        return bind_column(static_cast<AST::ColumnNameExpression const&>(expression));
+
+    if (is<AST::FunctionCallExpression>(expression)) {
+        auto& call = static_cast<AST::FunctionCallExpression const&>(expression);
+        if (is_aggregate_function(call.name()) && !is_scalar_function(call.name(), call.arguments().size()))
+            return String::formatted("Misuse of aggregate function {}()", call.name());
+        if (call.is_star() || call.is_distinct() || !is_scalar_function(call.name(), call.arguments().size()))
+            return String::formatted("No such function: {}() with {} arguments", call.name(), call.arguments().size());
+    }
+
+    if (is<AST::ChainedExpression>(expression) && static_cast<AST::ChainedExpression const&>(expression).expressions().size() != 1)
+        return "Row values are not supported";
+
+    if (is<AST::MatchExpression>(expression)) {
+        auto type = static_cast<AST::MatchExpression const&>(expression).type();
+        if (type != AST::MatchOperator::Like && type != AST::MatchOperator::Glob)
+            return "MATCH and REGEXP are not supported";
+    }
+
+    if (is<AST::ErrorExpression>(expression) || is<AST::BlobLiteral>(expression) || is<AST::ExistsExpression>(expression)
+        || is<AST::InSelectionExpression>(expression) || is<AST::InTableExpression>(expression))
+        return "Unsupported expression";
+
+    Optional<String> error;
+    for_each_child(expression, [&](AST::Expression const& child) {
+        if (!error.has_value())
+            error = bind(child);
+    });
+    return error;
+}
+
+Optional<String> Evaluator::bind_column(AST::ColumnNameExpression const& column)
+{
+    Optional<size_t> found;
+    for (auto ix = 0u; ix < m_columns.size(); ix++) {
+        auto& candidate = m_columns[ix];
+        if (candidate.column_name != column.column_name())
+            continue;
+        if (!column.table_name().is_null() && candidate.table_name != column.table_name())
+            continue;
+        if (found.has_value())
+            return String::formatted("Ambiguous column name: {}", column.column_name());
+        found = ix;
+    }
+
+    if (!found.has_value()) {
+        if (column.table_name().is_null())
+            return String::formatted("No such column: {}", column.column_name());
+        return String::formatted("No such column: {}.{}", column.table_name(), column.column_name());
+    }
+
+    m_bindings.set(&column, found.value());
+    return {};
+}
+
+Optional<size_t> Evaluator::column_index(AST::Expression const& expression) const
+{
+    if (!is<AST::ColumnNameExpression>(expression))
+        return {};
+    return m_bindings.get(&expression);
+}
+
+Value null_value()
+{
+    return Value(SQLType::Text);
+}
+
+Value integer_value(i64 integer)
+{
+    if (integer < NumericLimits<int>::min() || integer > NumericLimits<int>::max())
+        return float_value(static_cast<double>(integer));
+    Value value(SQLType::Integer);
+    value = static_cast<int>(integer);
+    return value;
+}
+
+Value float_value(double number)
+{
+    Value value(SQLType::Float);
+    value = number;
+    return value;
+}
+
+Value text_value(String const& string)
+{
+    Value value(SQLType::Text);
+    value = string;
+    return value;
+}
+
+static Value boolean_value(bool boolean)
+{
+    return integer_value(boolean ? 1 : 0);
+}
+
+Value to_numeric(Value const& value)
+{
+    if (value.is_null() || value.type() != SQLType::Text)
+        return value;
+    auto string = value.to_string().value();
+    if (auto integer = string.to_int(); integer.has_value())
+        return integer_value(integer.value());
+    if (auto number = value.to_double(); number.has_value())
+        return float_value(number.value());
+    return integer_value(0);
+}
+
+static i64 to_i64(Value const& numeric)
+{
+    if (numeric.type() == SQLType::Integer)
+        return numeric.to_int().value();
+    return static_cast<i64>(numeric.to_double().value());
+}
+
+Optional<bool> to_boolean(Value const& value)
+{
+    if (value.is_null())
+        return {};
+    return to_numeric(value).to_double().value() != 0.0;
+}
+
+int compare_values(Value const& lhs, Value const& rhs)
+{
+    // NULLs sort first, then numbers, then text.
+    auto rank = [](Value const& value) {
+        if (value.is_null())
+            return 0;
+        return value.type() == SQLType::Text ? 2 : 1;
+    };
+
+    auto lhs_rank = rank(lhs);
+    auto rhs_rank = rank(rhs);
+    if (lhs_rank != rhs_rank)
+        return lhs_rank < rhs_rank ? -1 : 1;
+
+    switch (lhs_rank) {
+    case 0:
+        return 0;
+    case 1: {
+        if (lhs.type() == SQLType::Integer && rhs.type() == SQLType::Integer) {
+            auto a = lhs.to_int().value();
+            auto b = rhs.to_int().value();
+            return (a == b) ? 0 : ((a < b) ? -1 : 1);
+        }
+        auto a = lhs.to_double().value();
+        auto b = rhs.to_double().value();
+        return (a == b) ? 0 : ((a < b) ? -1 : 1);
+    }
+    default: {
+        auto a = lhs.to_string().value();
+        auto b = rhs.to_string().value();
+        return (a == b) ? 0 : ((a < b) ? -1 : 1);
+    }
+    }
+}
+
+bool values_equal(Value const& lhs, Value const& rhs)
+{
+    return compare_values(lhs, rhs) == 0;
+}
+
+int compare_tuples(Tuple const& lhs, Tuple const& rhs)
+{
+    auto count = min(lhs.length(), rhs.length());
+    for (auto ix = 0u; ix < count; ix++) {
+        if (auto ret = compare_values(lhs[ix], rhs[ix]); ret != 0)
+            return ret;
+    }
+    return 0;
+}
+
+u32 hash_value(Value const& value)
+{
+    if (value.is_null())
+        return 0;
+    switch (value.type()) {
+    case SQLType::Float: {
+        // 1.0 and 1 compare equal, so they have to hash the same as well:
+        auto number = value.to_double().value();
+        if (number == trunc(number) && number >= NumericLimits<int>::min() && number <= NumericLimits<int>::max())
+            return int_hash(static_cast<int>(number));
+        return u64_hash(bit_cast<u64>(number));
+    }
+    case SQLType::Integer:
+        return int_hash(value.to_int().value());
+    default:
+        return value.hash();
+    }
+}
+
+u32 hash_tuple(Tuple const& tuple)
+{
+    u32 ret = 0;
+    for (auto ix = 0u; ix < tuple.length(); ix++)
+        ret = pair_int_hash(ret, hash_value(tuple[ix]));
+    return ret;
+}
+
+SQLType sql_type_for(String const& type_name)
+{
+    // https://sqlite.org/datatype3.html - See "3.1. Determination Of Column Affinity"
+    if (type_name.contains("INT"))
+        return SQLType::Integer;
+    if (type_name.contains("CHAR") || type_name.contains("CLOB") || type_name.contains("TEXT"))
+        return SQLType::Text;
+    if (type_name.contains("REAL") || type_name.contains("FLOA") || type_name.contains("DOUB") || type_name.contains("NUMERIC") || type_name.contains("DECIMAL"))
+        return SQLType::Float;
+    return SQLType::Text;
+}
+
+bool is_aggregate_function(String const& name)
+{
+    return name.is_one_of("COUNT", "SUM", "TOTAL", "AVG", "MIN", "MAX");
+}
+
+Optional<String> collect_aggregate_calls(AST::Expression const& expression, Vector<AST::FunctionCallExpression const*>& calls)
+{
+    if (is<AST::FunctionCallExpression>(expression)) {
+        auto& call = static_cast<AST::FunctionCallExpression const&>(expression);
+        if (is_aggregate_function(call.name()) && !is_scalar_function(call.name(), call.arguments().size())) {
+            if (call.is_star() ? (call.name() != "COUNT") : (call.arguments().size() != 1))
+                return String::formatted("Wrong number of arguments to function {}()", call.name());
+            for (auto& argument : call.arguments()) {
+                Vector<AST::FunctionCallExpression const*> nested;
+                if (auto error = collect_aggregate_calls(argument, nested); error.has_value())
+                    return error;
+                if (!nested.is_empty())
+                    return String::formatted("Misuse of aggregate function {}()", nested.first()->name());
+            }
+            calls.append(&call);
+            return {};
+        }
+    }
+
+    Optional<String> error;
+    for_each_child(expression, [&](AST::Expression const& child) {
+        if (!error.has_value())
+            error = collect_aggregate_calls(child, calls);
+    });
+    return error;
+}
+
+static Value evaluate_arithmetic(AST::BinaryOperator op, Value const& lhs_value, Value const& rhs_value)
+{
+    auto lhs = to_numeric(lhs_value);
+    auto rhs = to_numeric(rhs_value);
+
+    switch (op) {
+    case AST::BinaryOperator::ShiftLeft:
+        return integer_value(to_i64(lhs) << to_i64(rhs));
+    case AST::BinaryOperator::ShiftRight:
+        return integer_value(to_i64(lhs) >> to_i64(rhs));
+    case AST::BinaryOperator::BitwiseAnd:
+        return integer_value(to_i64(lhs) & to_i64(rhs));
+    case AST::BinaryOperator::BitwiseOr:
+        return integer_value(to_i64(lhs) | to_i64(rhs));
+    case AST::BinaryOperator::Modulo:
+        if (to_i64(rhs) == 0)
+            return null_value();
+        return integer_value(to_i64(lhs) % to_i64(rhs));
+    default:
+        break;
+    }
+
+    if (lhs.type() == SQLType::Integer && rhs.type() == SQLType::Integer) {
+        i64 a = lhs.to_int().value();
+        i64 b = rhs.to_int().value();
+        switch (op) {
+        case AST::BinaryOperator::Plus:
+            return integer_value(a + b);
+        case AST::BinaryOperator::Minus:
+            return integer_value(a - b);
+        case AST::BinaryOperator::Multiplication:
+            return integer_value(a * b);
+        case AST::BinaryOperator::Division:
+            if (b == 0)
+                return null_value();
+            return integer_value(a / b);
+        default:
+            VERIFY_NOT_REACHED();
+        }
+    }
+
+    auto a = lhs.to_double().value();
+    auto b = rhs.to_double().value();
+    switch (op) {
+    case AST::BinaryOperator::Plus:
+        return float_value(a + b);
+    case AST::BinaryOperator::Minus:
+        return float_value(a - b);
+    case AST::BinaryOperator::Multiplication:
+        return float_value(a * b);
+    case AST::BinaryOperator::Division:
+        if (b == 0.0)
+            return null_value();
+        return float_value(a / b);
+    default:
+        VERIFY_NOT_REACHED();
+    }
+}
+
+static bool like(StringView text, StringView pattern, Optional<char> escape)
+{
+    // https://sqlite.org/lang_expr.html#like - Case-insensitive for ASCII characters.
+    if (pattern.is_empty())
+        return text.is_empty();
+
+    auto pattern_char = pattern[0];
+    if (escape.has_value() && pattern_char == escape.value() && pattern.length() > 1) {
+        if (text.is_empty() || tolower(text[0]) != tolower(pattern[1]))
+            return false;
+        return like(text.substring_view(1), pattern.substring_view(2), escape);
+    }
+    if (pattern_char == '%') {
+        for (auto ix = 0u; ix <= text.length(); ix++) {
+            if (like(text.substring_view(ix), pattern.substring_view(1), escape))
+                return true;
+        }
+        return false;
+    }
+    if (text.is_empty())
+        return false;
+    if (pattern_char != '_' && tolower(text[0]) != tolower(pattern_char))
+        return false;
+    return like(text.substring_view(1), pattern.substring_view(1), escape);
+}
+
+static bool glob(StringView text, StringView pattern)
+{
+    // https://sqlite.org/lang_expr.html#glob - Case-sensitive, with Unix file globbing syntax.
+    if (pattern.is_empty())
+        return text.is_empty();
+    if (pattern[0] == '*') {
+        for (auto ix = 0u; ix <= text.length(); ix++) {
+            if (glob(text.substring_view(ix), pattern.substring_view(1)))
+                return true;
+        }
+        return false;
+    }
+    if (text.is_empty())
+        return false;
+    if (pattern[0] != '?' && text[0] != pattern[0])
+        return false;
+    return glob(text.substring_view(1), pattern.substring_view(1));
+}
+
+static Value evaluate_function(AST::FunctionCallExpression const& call, Vector<Value> const& arguments)
+{
+    auto const& name = call.name();
+
+    if (name.is_one_of("COALESCE", "IFNULL")) {
+        for (auto& argument : arguments) {
+            if (!argument.is_null())
+                return argument;
+        }
+        return null_value();
+    }
+
+    if (name.is_one_of("MIN", "MAX")) {
+        Optional<size_t> result;
+        for (auto ix = 0u; ix < arguments.size(); ix++) {
+            if (arguments[ix].is_null())
+                return null_value();
+            auto ret = result.has_value() ? compare_values(arguments[ix], arguments[result.value()]) : 0;
+            if (!result.has_value() || (name == "MIN" ? ret < 0 : ret > 0))
+                result = ix;
+        }
+        return arguments[result.value()];
+    }
+
+    auto const& argument = arguments[0];
+    if (argument.is_null())
+        return null_value();
+
+    if (name == "ABS") {
+        auto numeric = to_numeric(argument);
+        if (numeric.type() == SQLType::Integer) {
+            i64 integer = numeric.to_int().value();
+            return integer_value(integer < 0 ? -integer : integer);
+        }
+        return float_value(fabs(numeric.to_double().value()));
+    }
+    if (name == "LENGTH")
+        return integer_value(argument.to_string().value().length());
+    if (name == "LOWER")
+        return text_value(argument.to_string().value().to_lowercase());
+    if (name == "UPPER")
+        return text_value(argument.to_string().value().to_uppercase());
+    VERIFY_NOT_REACHED();
+}
+
+Value Evaluator::evaluate(AST::Expression const& expression, Tuple const& row) const
+{
+    if (auto binding = m_bindings.get(&expression); binding.has_value())
+        return row[binding.value()];
+
+    if (is<AST::NumericLiteral>(expression)) {
+        auto number = static_cast<AST::NumericLiteral const&>(expression).value();
+        if (number == trunc(number) && fabs(number) < 1e18)
+            return integer_value(static_cast<i64>(number));
+        return float_value(number);
+    }
+
+    if (is<AST::StringLiteral>(expression))
+        return text_value(static_cast<AST::StringLiteral const&>(expression).value());
+
+    if (is<AST::NullLiteral>(expression))
+        return null_value();
+
+    if (is<AST::ChainedExpression>(expression))
+        return evaluate(static_cast<AST::ChainedExpression const&>(expression).expressions().first(), row);
+
+    if (is<AST::CollateExpression>(expression))
+        return evaluate(*static_cast<AST::CollateExpression const&>(expression).expression(), row);
+
+    if (is<AST::UnaryOperatorExpression>(expression)) {
+        auto& unary = static_cast<AST::UnaryOperatorExpression const&>(expression);
+        auto value = evaluate(*unary.expression(), row);
+        if (value.is_null())
+            return value;
+        switch (unary.type()) {
+        case AST::UnaryOperator::Plus:
+            return value;
+        case AST::UnaryOperator::Minus: {
+            auto numeric = to_numeric(value);
+            if (numeric.type() == SQLType::Integer)
+                return integer_value(-static_cast<i64>(numeric.to_int().value()));
+            return float_value(-numeric.to_double().value());
+        }
+        case AST::UnaryOperator::Not:
+            return boolean_value(!to_boolean(value).value());
+        case AST::UnaryOperator::BitwiseNot:
+            return integer_value(~to_i64(to_numeric(value)));
+        }
+        VERIFY_NOT_REACHED();
+    }
+
+    if (is<AST::BinaryOperatorExpression>(expression)) {
+        auto& binary = static_cast<AST::BinaryOperatorExpression const&>(expression);
+        auto lhs = evaluate(*binary.lhs(), row);
+
+        // AND and OR use three-valued logic, and only evaluate their right-hand side if they have to.
+        if (binary.type() == AST::BinaryOperator::And || binary.type() == AST::BinaryOperator::Or) {
+            bool is_and = binary.type() == AST::BinaryOperator::And;
+            auto lhs_boolean = to_boolean(lhs);
+            if (lhs_boolean.has_value() && lhs_boolean.value() != is_and)
+                return boolean_value(!is_and);
+            auto rhs_boolean = to_boolean(evaluate(*binary.rhs(), row));
+            if (rhs_boolean.has_value() && rhs_boolean.value() != is_and)
+                return boolean_value(!is_and);
+            if (!lhs_boolean.has_value() || !rhs_boolean.has_value())
+                return null_value();
+            return boolean_value(is_and);
+        }
+
+        auto rhs = evaluate(*binary.rhs(), row);
+        if (lhs.is_null() || rhs.is_null())
+            return null_value();
+
+        switch (binary.type()) {
+        case AST::BinaryOperator::Concatenate:
+            return text_value(String::formatted("{}{}", lhs.to_string().value(), rhs.to_string().value()));
+        case AST::BinaryOperator::Equals:
+            return boolean_value(compare_values(lhs, rhs) == 0);
+        case AST::BinaryOperator::NotEquals:
+            return boolean_value(compare_values(lhs, rhs) != 0);
+        case AST::BinaryOperator::LessThan:
+            return boolean_value(compare_values(lhs, rhs) < 0);
+        case AST::BinaryOperator::LessThanEquals:
+            return boolean_value(compare_values(lhs, rhs) <= 0);
+        case AST::BinaryOperator::GreaterThan:
+            return boolean_value(compare_values(lhs, rhs) > 0);
+        case AST::BinaryOperator::GreaterThanEquals:
+            return boolean_value(compare_values(lhs, rhs) >= 0);
+        default:
+            return evaluate_arithmetic(binary.type(), lhs, rhs);
+        }
+    }
+
+    if (is<AST::NullExpression>(expression)) {
+        auto& null_expression = static_cast<AST::NullExpression const&>(expression);
+        return boolean_value(evaluate(*null_expression.expression(), row).is_null() != null_expression.invert_expression());
+    }
+
+    if (is<AST::IsExpression>(expression)) {
+        auto& is_expression = static_cast<AST::IsExpression const&>(expression);
+        auto equal = values_equal(evaluate(*is_expression.lhs(), row), evaluate(*is_expression.rhs(), row));
+        return boolean_value(equal != is_expression.invert_expression());
+    }
+
+    if (is<AST::BetweenExpression>(expression)) {
+        auto& between = static_cast<AST::BetweenExpression const&>(expression);
+        auto value = evaluate(*between.expression(), row);
+        auto lower = evaluate(*between.lhs(), row);
+        auto upper = evaluate(*between.rhs(), row);
+        if (value.is_null() || lower.is_null() || upper.is_null())
+            return null_value();
+        auto in_range = compare_values(value, lower) >= 0 && compare_values(value, upper) <= 0;
+        return boolean_value(in_range != between.invert_expression());
+    }
+
+    if (is<AST::InChainedExpression>(expression)) {
+        auto& in = static_cast<AST::InChainedExpression const&>(expression);
+        auto value = evaluate(*in.expression(), row);
+        if (value.is_null())
+            return null_value();
+        bool saw_null = false;
+        for (auto& element : in.expression_chain()->expressions()) {
+            auto candidate = evaluate(element, row);
+            if (candidate.is_null())
+                saw_null = true;
+            else if (values_equal(value, candidate))
+                return boolean_value(!in.invert_expression());
+        }
+        if (saw_null)
+            return null_value();
+        return boolean_value(in.invert_expression());
+    }
+
+    if (is<AST::MatchExpression>(expression)) {
+        auto& match = static_cast<AST::MatchExpression const&>(expression);
+        auto text = evaluate(*match.lhs(), row);
+        auto pattern = evaluate(*match.rhs(), row);
+        if (text.is_null() || pattern.is_null())
+            return null_value();
+        bool matched;
+        if (match.type() == AST::MatchOperator::Like) {
+            Optional<char> escape;
+            if (match.escape()) {
+                auto escape_value = evaluate(*match.escape(), row);
+                if (!escape_value.is_null() && !escape_value.to_string().value().is_empty())
+                    escape = escape_value.to_string().value()[0];
+            }
+            matched = like(text.to_string().value(), pattern.to_string().value(), escape);
+        } else {
+            matched = glob(text.to_string().value(), pattern.to_string().value());
+        }
+        return boolean_value(matched != match.invert_expression());
+    }
+
+    if (is<AST::CastExpression>(expression)) {
+        auto& cast = static_cast<AST::CastExpression const&>(expression);
+        auto value = evaluate(*cast.expression(), row);
+        if (value.is_null())
+            return value;
+        switch (sql_type_for(cast.type_name()->name())) {
+        case SQLType::Integer:
+            return integer_value(to_i64(to_numeric(value)));
+        case SQLType::Float:
+            return float_value(to_numeric(value).to_double().value());
+        default:
+            return text_value(value.to_string().value());
+        }
+    }
+
+    if (is<AST::CaseExpression>(expression)) {
+        auto& case_expression = static_cast<AST::CaseExpression const&>(expression);
+        Optional<Value> base;
+        if (case_expression.case_expression())
+            base = evaluate(*case_expression.case_expression(), row);
+        for (auto& clause : case_expression.when_then_clauses()) {
+            bool matched;
+            if (base.has_value()) {
+                auto when = evaluate(*clause.when, row);
+                matched = !base->is_null() && !when.is_null() && values_equal(base.value(), when);
+            } else {
+                matched = is_true(*clause.when, row);
+            }
+            if (matched)
+                return evaluate(*clause.then, row);
+        }
+        if (case_expression.else_expression())
+            return evaluate(*case_expression.else_expression(), row);
+        return null_value();
+    }
+
+    if (is<AST::FunctionCallExpression>(expression)) {
+        auto& call = static_cast<AST::FunctionCallExpression const&>(expression);
+        Vector<Value> arguments;
+        for (auto& argument : call.arguments())
+            arguments.append(evaluate(argument, row));
+        return evaluate_function(call, arguments);
+    }
+
+    // bind() rejects everything else.
+    VERIFY_NOT_REACHED();
+}
+
+bool Evaluator::is_true(AST::Expression const& expression, Tuple const& row) const
+{
+    return to_boolean(evaluate(expression, row)).value_or(false);
+}
+
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/Optional.h>
+#include <AK/String.h>
+#include <AK/Vector.h>
+#include <LibSQL/AST/AST.h>
+#include <LibSQL/Forward.h>
+#include <LibSQL/Tuple.h>
+#include <LibSQL/Type.h>
+#include <LibSQL/Value.h>
+
+namespace SQL {
+
+/**
+ * An OperatorColumn names one of the values in the tuples produced by an
+ * Operator. The table name is the name or alias of the table the column
+ * came from, and is empty for computed columns.
+ */
+struct OperatorColumn {
+    String table_name;
+    String column_name;
+};
+
+/**
+ * An Evaluator computes the value of AST expressions against tuples with a
+ * fixed layout, described by a list of OperatorColumns.
+ *
+ * Expressions have to be bound before they can be evaluated. Binding resolves
+ * column names to positions in the tuple once, so evaluating an expression for
+ * every row of a table doesn't need any name lookups. Binding fails if the
+ * expression references unknown or ambiguous columns, or uses constructs the
+ * evaluator doesn't support.
+ *
+ * Subexpressions can also be substituted by a column of the input tuple. This
+ * is used above aggregation, where aggregate function calls and grouping keys
+ * have already been computed by the aggregation operator.
+ *
+ * Evaluation follows SQLite semantics where it matters: NULL propagates
+ * through operators, comparisons use three-valued logic, and text is
+ * converted to numbers in arithmetic.
+ */
+class Evaluator {
+public:
+    explicit Evaluator(Vector<OperatorColumn> columns = {});
+
+    [[nodiscard]] Vector<OperatorColumn> const& columns() const { return m_columns; }
+
+    Optional<String> bind(AST::Expression const&);
+    void substitute(AST::Expression const&, size_t column_index);
+
+    [[nodiscard]] Value evaluate(AST::Expression const&, Tuple const&) const;
+    [[nodiscard]] bool is_true(AST::Expression const&, Tuple const&) const;
+
+    // The position of the column a bound expression refers to, if the expression is a column name.
+    [[nodiscard]] Optional<size_t> column_index(AST::Expression const&) const;
+
+private:
+    Optional<String> bind_column(AST::ColumnNameExpression const&);
+
+    Vector<OperatorColumn> m_columns;
+    HashMap<AST::Expression const*, size_t> m_bindings;
+};
+
+Value null_value();
+Value integer_value(i64);
+Value float_value(double);
+Value text_value(String const&);
+
+Value to_numeric(Value const&);
+Optional<bool> to_boolean(Value const&);
+int compare_values(Value const&, Value const&);
+bool values_equal(Value const&, Value const&);
+int compare_tuples(Tuple const&, Tuple const&);
+u32 hash_value(Value const&);
+u32 hash_tuple(Tuple const&);
+
+SQLType sql_type_for(String const& type_name);
+bool is_aggregate_function(String const& name);
+Optional<String> collect_aggregate_calls(AST::Expression const&, Vector<AST::FunctionCallExpression const*>&);
+
+}
@@ -0,0 +1,673 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/TypeCasts.h>
+#include <LibSQL/AccessPath.h>
+#include <LibSQL/Executor.h>
+#include <LibSQL/Meta.h>
+#include <LibSQL/Row.h>
+
+namespace SQL {
+
+constexpr static char const* default_schema_name = "DEFAULT";
+
+static String schema_name_or_default(String const& schema_name)
+{
+    return schema_name.is_null() ? default_schema_name : schema_name;
+}
+
+static void split_conjuncts(NonnullRefPtr<AST::Expression> const& expression, NonnullRefPtrVector<AST::Expression>& conjuncts)
+{
+    if (is<AST::BinaryOperatorExpression>(*expression)) {
+        auto& binary = static_cast<AST::BinaryOperatorExpression const&>(*expression);
+        if (binary.type() == AST::BinaryOperator::And) {
+            split_conjuncts(binary.lhs(), conjuncts);
+            split_conjuncts(binary.rhs(), conjuncts);
+            return;
+        }
+    }
+    if (is<AST::ChainedExpression>(*expression)) {
+        auto& chain = static_cast<AST::ChainedExpression const&>(*expression);
+        if (chain.expressions().size() == 1) {
+            split_conjuncts(chain.expressions().ptr_at(0), conjuncts);
+            return;
+        }
+    }
+    conjuncts.append(expression);
+}
+
+static void flatten_sources(AST::TableOrSubquery const& source, Vector<AST::TableOrSubquery const*>& sources)
+{
+    if (source.is_subquery()) {
+        for (auto& nested : source.subqueries())
+            flatten_sources(nested, sources);
+        return;
+    }
+    sources.append(&source);
+}
+
+// Takes the conditions out of `conjuncts` that can be evaluated against the evaluator's columns, and binds them.
+static NonnullRefPtrVector<AST::Expression> take_applicable_conjuncts(NonnullRefPtrVector<AST::Expression>& conjuncts, Evaluator& evaluator)
+{
+    NonnullRefPtrVector<AST::Expression> applicable;
+    for (size_t ix = 0; ix < conjuncts.size();) {
+        if (!evaluator.bind(conjuncts[ix]).has_value()) {
+            applicable.append(conjuncts.take(ix));
+            continue;
+        }
+        ix++;
+    }
+    return applicable;
+}
+
+// Returns the columns that conditions equate with an expression on other tables. These are the columns
+// the table can be joined on.
+static Vector<String> join_columns_of(NonnullRefPtrVector<AST::Expression> const& conjuncts, Vector<OperatorColumn> const& columns)
+{
+    Vector<String> join_columns;
+    auto add_if_join_column = [&](AST::Expression const& side, AST::Expression const& other) {
+        if (!is<AST::ColumnNameExpression>(side))
+            return;
+        Evaluator evaluator(columns);
+        if (evaluator.bind(side).has_value() || !evaluator.bind(other).has_value())
+            return;
+        join_columns.append(columns[evaluator.column_index(side).value()].column_name);
+    };
+
+    for (auto& conjunct : conjuncts) {
+        if (!is<AST::BinaryOperatorExpression>(conjunct))
+            continue;
+        auto& binary = static_cast<AST::BinaryOperatorExpression const&>(conjunct);
+        if (binary.type() != AST::BinaryOperator::Equals)
+            continue;
+        add_if_join_column(binary.lhs(), binary.rhs());
+        add_if_join_column(binary.rhs(), binary.lhs());
+    }
+    return join_columns;
+}
+
+static Result<Optional<i64>, String> evaluate_constant(AST::Expression const& expression)
+{
+    Evaluator evaluator;
+    if (auto error = evaluator.bind(expression); error.has_value())
+        return error.release_value();
+    auto value = to_numeric(evaluator.evaluate(expression, Tuple()));
+    if (value.is_null())
+        return Optional<i64> {};
+    return Optional<i64> { static_cast<i64>(value.to_double().value()) };
+}
+
+Executor::Executor(Database& database)
+    : m_database(database)
+{
+}
+
+Result<OwnPtr<Operator>, String> Executor::execute(AST::Statement const& statement)
+{
+    m_rows_affected = 0;
+
+    if (is<AST::Select>(statement)) {
+        auto plan_or_error = plan(static_cast<AST::Select const&>(statement));
+        if (plan_or_error.is_error())
+            return plan_or_error.release_error();
+        return OwnPtr<Operator>(plan_or_error.release_value());
+    }
+
+    if (is<AST::Explain>(statement)) {
+        auto plan_or_error = execute_explain(static_cast<AST::Explain const&>(statement));
+        if (plan_or_error.is_error())
+            return plan_or_error.release_error();
+        return OwnPtr<Operator>(plan_or_error.release_value());
+    }
+
+    if (m_database->is_snapshot())
+        return String("A snapshot of a database is read-only");
+
+    Optional<String> error;
+    if (is<AST::CreateTable>(statement))
+        error = execute_create_table(static_cast<AST::CreateTable const&>(statement));
+    else if (is<AST::CreateIndex>(statement))
+        error = execute_create_index(static_cast<AST::CreateIndex const&>(statement));
+    else if (is<AST::Insert>(statement))
+        error = execute_insert(static_cast<AST::Insert const&>(statement));
+    else if (is<AST::Delete>(statement))
+        error = execute_delete(static_cast<AST::Delete const&>(statement));
+    else if (is<AST::Vacuum>(statement))
+        error = execute_vacuum(static_cast<AST::Vacuum const&>(statement));
+    else
+        error = "Statement is not supported yet";
+
+    if (error.has_value())
+        return error.release_value();
+    m_database->commit();
+    return OwnPtr<Operator> {};
+}
+
+Result<NonnullOwnPtr<Operator>, String> Executor::plan(AST::Select const& select)
+{
+    return plan_select(select, {});
+}
+
+// Plans the scan of a single table in the FROM clause, and the filter applying the conjuncts that only refer to that table.
+Result<NonnullOwnPtr<Operator>, String> Executor::plan_table(AST::TableOrSubquery const& source, NonnullRefPtrVector<AST::Expression>& conjuncts, CommonTableExpressions const& common_table_expressions)
+{
+    VERIFY(source.is_table());
+    auto alias = source.table_alias().is_null() ? source.table_name() : source.table_alias();
+
+    if (source.schema_name().is_null()) {
+        if (auto common_table_expression = common_table_expressions.get(source.table_name()); common_table_expression.has_value()) {
+            auto& definition = *common_table_expression.value();
+            auto plan_or_error = plan_select(definition.select_statement(), common_table_expressions);
+            if (plan_or_error.is_error())
+                return plan_or_error.release_error();
+            auto plan = plan_or_error.release_value();
+            if (!definition.column_names().is_empty()) {
+                if (definition.column_names().size() != plan->columns().size())
+                    return String::formatted("Table {} has {} values for {} columns", definition.table_name(), plan->columns().size(), definition.column_names().size());
+                plan->set_column_names(definition.column_names());
+            }
+            plan->set_table_name(alias);
+
+            Evaluator evaluator(plan->columns());
+            auto filters = take_applicable_conjuncts(conjuncts, evaluator);
+            if (!filters.is_empty())
+                plan = make<Filter>(move(plan), move(filters), move(evaluator));
+            return plan;
+        }
+    }
+
+    auto table = m_database->get_table(schema_name_or_default(source.schema_name()), source.table_name());
+    if (!table)
+        return String::formatted("No such table: {}", source.table_name());
+
+    // The filters stay in the plan even when an index is used, because an index range does not always
+    // cover a condition exactly.
+    Evaluator evaluator(TableScan(m_database, *table, alias).columns());
+    auto filters = take_applicable_conjuncts(conjuncts, evaluator);
+    auto access_path = choose_access_path(m_database, *table, alias, filters);
+    // Without a better way to read the table, reading it in the order of an index on a column it is joined
+    // on allows for a MergeJoin.
+    if (access_path.type == AccessPath::Type::TableScan) {
+        for (auto& column_name : join_columns_of(conjuncts, evaluator.columns())) {
+            if (auto ordered_path = ordered_access_path(m_database, *table, column_name); ordered_path.has_value()) {
+                access_path = ordered_path.release_value();
+                break;
+            }
+        }
+    }
+    auto plan = create_scan(m_database, table.release_nonnull(), alias, access_path);
+    if (!filters.is_empty())
+        plan = make<Filter>(move(plan), move(filters), move(evaluator));
+    return plan;
+}
+
+// Joins the tables planned so far with the next table. Conditions equating an expression on the left
+// with an expression on the right allow a MergeJoin, if both sides are sorted on a pair of such columns,
+// or a HashJoin otherwise. Without them, every pair of tuples has to be tried by a NestedLoopJoin.
+NonnullOwnPtr<Operator> Executor::plan_join(NonnullOwnPtr<Operator> left, NonnullOwnPtr<Operator> right, NonnullRefPtrVector<AST::Expression> conditions, Evaluator evaluator)
+{
+    JoinKeys left_keys { {}, Evaluator(left->columns()) };
+    JoinKeys right_keys { {}, Evaluator(right->columns()) };
+    NonnullRefPtrVector<AST::Expression> key_conditions;
+    NonnullRefPtrVector<AST::Expression> other_conditions;
+    for (auto& condition : conditions) {
+        if (is<AST::BinaryOperatorExpression>(condition)) {
+            auto& binary = static_cast<AST::BinaryOperatorExpression const&>(condition);
+            if (binary.type() == AST::BinaryOperator::Equals) {
+                if (!left_keys.evaluator.bind(binary.lhs()).has_value() && !right_keys.evaluator.bind(binary.rhs()).has_value()) {
+                    left_keys.expressions.append(binary.lhs());
+                    right_keys.expressions.append(binary.rhs());
+                    key_conditions.append(condition);
+                    continue;
+                }
+                if (!left_keys.evaluator.bind(binary.rhs()).has_value() && !right_keys.evaluator.bind(binary.lhs()).has_value()) {
+                    left_keys.expressions.append(binary.rhs());
+                    right_keys.expressions.append(binary.lhs());
+                    key_conditions.append(condition);
+                    continue;
+                }
+            }
+        }
+        other_conditions.append(condition);
+    }
+
+    if (key_conditions.is_empty())
+        return make<NestedLoopJoin>(move(left), move(right), move(conditions), move(evaluator));
+
+    auto left_ordering = left->ordering();
+    auto right_ordering = right->ordering();
+    for (auto ix = 0u; ix < key_conditions.size() && !left_ordering.is_empty() && !right_ordering.is_empty(); ix++) {
+        auto left_column = left_keys.evaluator.column_index(left_keys.expressions[ix]);
+        auto right_column = right_keys.evaluator.column_index(right_keys.expressions[ix]);
+        if (!left_column.has_value() || left_column.value() != left_ordering.first())
+            continue;
+        if (!right_column.has_value() || right_column.value() != right_ordering.first())
+            continue;
+
+        // Any other keys are checked like the other conditions. They are bound already.
+        for (auto other = 0u; other < key_conditions.size(); other++) {
+            if (other != ix)
+                other_conditions.append(key_conditions[other]);
+        }
+        return make<MergeJoin>(move(left), move(right), left_column.value(), right_column.value(), move(other_conditions), move(evaluator));
+    }
+
+    return make<HashJoin>(move(left), move(right), move(left_keys), move(right_keys), move(other_conditions), move(evaluator), m_join_memory_budget);
+}
+
+Result<NonnullOwnPtr<Operator>, String> Executor::plan_select(AST::Select const& select, CommonTableExpressions common_table_expressions)
+{
+    if (auto const& list = select.common_table_expression_list(); list) {
+        if (list->recursive())
+            return String { "Recursive common table expressions are not supported" };
+        for (auto& common_table_expression : list->common_table_expressions())
+            common_table_expressions.set(common_table_expression.table_name(), common_table_expression);
+    }
+
+    // FROM and WHERE: Join the tables left to right. Every WHERE condition is applied at the lowest
+    // point in the plan where all of the columns it references are available.
+    NonnullRefPtrVector<AST::Expression> conjuncts;
+    if (auto const& where_clause = select.where_clause(); where_clause)
+        split_conjuncts(*where_clause, conjuncts);
+
+    Vector<AST::TableOrSubquery const*> sources;
+    for (auto& source : select.table_or_subquery_list())
+        flatten_sources(source, sources);
+
+    OwnPtr<Operator> plan;
+    if (sources.is_empty())
+        plan = make<SingleRow>();
+
+    for (auto* source : sources) {
+        if (!source->is_table())
+            return String { "Subqueries are not supported" };
+        auto source_or_error = plan_table(*source, conjuncts, common_table_expressions);
+        if (source_or_error.is_error())
+            return source_or_error.release_error();
+        NonnullOwnPtr<Operator> source_plan = source_or_error.release_value();
+
+        if (!plan) {
+            plan = move(source_plan);
+            continue;
+        }
+
+        Vector<OperatorColumn> joined_columns;
+        joined_columns.extend(plan->columns());
+        joined_columns.extend(source_plan->columns());
+        Evaluator join_evaluator(move(joined_columns));
+        auto join_conditions = take_applicable_conjuncts(conjuncts, join_evaluator);
+        plan = plan_join(plan.release_nonnull(), move(source_plan), move(join_conditions), move(join_evaluator));
+    }
+
+    if (!conjuncts.is_empty()) {
+        Evaluator evaluator(plan->columns());
+        if (auto error = evaluator.bind(conjuncts.first()); error.has_value())
+            return error.release_value();
+        plan = make<Filter>(plan.release_nonnull(), move(conjuncts), move(evaluator));
+    }
+
+    // Result columns. A '*' expands into references to the columns of all the tables in the FROM clause.
+    NonnullRefPtrVector<AST::Expression> expressions;
+    Vector<OperatorColumn> result_columns;
+    Vector<String> aliases;
+    for (auto& result_column : select.result_column_list()) {
+        if (result_column.type() == AST::ResultType::Expression) {
+            auto& expression = *result_column.expression();
+            expressions.append(expression);
+            aliases.append(result_column.column_alias());
+            if (!result_column.column_alias().is_null())
+                result_columns.append({ {}, result_column.column_alias() });
+            else if (is<AST::ColumnNameExpression>(expression))
+                result_columns.append({ {}, static_cast<AST::ColumnNameExpression const&>(expression).column_name() });
+            else
+                result_columns.append({});
+            continue;
+        }
+
+        bool found = false;
+        for (auto& column : plan->columns()) {
+            if (result_column.type() == AST::ResultType::Table && column.table_name != result_column.table_name())
+                continue;
+            expressions.append(AST::create_ast_node<AST::ColumnNameExpression>(String {}, column.table_name, column.column_name));
+            aliases.append({});
+            result_columns.append({ {}, column.column_name });
+            found = true;
+        }
+        if (!found && result_column.type() == AST::ResultType::Table)
+            return String::formatted("No such table: {}", result_column.table_name());
+        if (!found)
+            return String { "No tables specified" };
+    }
+
+    // ORDER BY terms can refer to result columns by alias or by position.
+    Vector<SortKey> sort_keys;
+    for (auto& term : select.ordering_term_list()) {
+        RefPtr<AST::Expression> expression = term.expression();
+        if (is<AST::NumericLiteral>(*expression)) {
+            auto position = static_cast<AST::NumericLiteral const&>(*expression).value();
+            if (position < 1 || position > expressions.size() || position != (size_t)position)
+                return String::formatted("ORDER BY term out of range - should be between 1 and {}", expressions.size());
+            expression = expressions[(size_t)position - 1];
+        } else if (is<AST::ColumnNameExpression>(*expression)) {
+            auto& column = static_cast<AST::ColumnNameExpression const&>(*expression);
+            if (column.table_name().is_null()) {
+                for (auto ix = 0u; ix < aliases.size(); ix++) {
+                    if (aliases[ix] == column.column_name()) {
+                        expression = expressions[ix];
+                        break;
+                    }
+                }
+            }
+        }
+        sort_keys.append({ expression.release_nonnull(), term.order(), term.nulls() });
+    }
+
+    // GROUP BY and aggregate functions: Everything evaluated above the aggregation refers to its output.
+    Vector<AST::FunctionCallExpression const*> aggregates;
+    for (auto& expression : expressions) {
+        if (auto error = collect_aggregate_calls(expression, aggregates); error.has_value())
+            return error.release_value();
+    }
+    RefPtr<AST::Expression> having;
+    NonnullRefPtrVector<AST::Expression> group_by;
+    if (auto const& group_by_clause = select.group_by_clause(); group_by_clause) {
+        group_by = group_by_clause->group_by_list();
+        having = group_by_clause->having_clause();
+        if (having) {
+            if (auto error = collect_aggregate_calls(*having, aggregates); error.has_value())
+                return error.release_value();
+        }
+    }
+    for (auto& sort_key : sort_keys) {
+        if (auto error = collect_aggregate_calls(sort_key.expression, aggregates); error.has_value())
+            return error.release_value();
+    }
+
+    Evaluator evaluator(plan->columns());
+    if (!group_by.is_empty() || !aggregates.is_empty()) {
+        for (auto& expression : group_by) {
+            if (auto error = evaluator.bind(expression); error.has_value())
+                return error.release_value();
+        }
+        for (auto* aggregate : aggregates) {
+            for (auto& argument : aggregate->arguments()) {
+                if (auto error = evaluator.bind(argument); error.has_value())
+                    return error.release_value();
+            }
+        }
+
+        auto group_count = group_by.size();
+        plan = make<HashAggregate>(plan.release_nonnull(), group_by, aggregates, move(evaluator));
+        evaluator = Evaluator(plan->columns());
+        for (auto ix = 0u; ix < group_count; ix++)
+            evaluator.substitute(group_by[ix], ix);
+        for (auto ix = 0u; ix < aggregates.size(); ix++)
+            evaluator.substitute(*aggregates[ix], group_count + ix);
+
+        if (having) {
+            if (auto error = evaluator.bind(*having); error.has_value())
+                return error.release_value();
+            NonnullRefPtrVector<AST::Expression> predicates;
+            predicates.append(having.release_nonnull());
+            plan = make<Filter>(plan.release_nonnull(), move(predicates), evaluator);
+        }
+    }
+
+    for (auto& expression : expressions) {
+        if (auto error = evaluator.bind(expression); error.has_value())
+            return error.release_value();
+    }
+
+    if (!sort_keys.is_empty()) {
+        for (auto& sort_key : sort_keys) {
+            if (auto error = evaluator.bind(sort_key.expression); error.has_value())
+                return error.release_value();
+        }
+        plan = make<Sort>(plan.release_nonnull(), move(sort_keys), evaluator);
+    }
+
+    plan = make<Projection>(plan.release_nonnull(), move(expressions), move(result_columns), move(evaluator));
+
+    if (!select.select_all())
+        plan = make<Distinct>(plan.release_nonnull());
+
+    if (auto const& limit_clause = select.limit_clause(); limit_clause) {
+        auto limit_or_error = evaluate_constant(limit_clause->limit_expression());
+        if (limit_or_error.is_error())
+            return limit_or_error.release_error();
+        auto limit = limit_or_error.release_value();
+
+        Optional<i64> offset;
+        if (limit_clause->offset_expression()) {
+            auto offset_or_error = evaluate_constant(*limit_clause->offset_expression());
+            if (offset_or_error.is_error())
+                return offset_or_error.release_error();
+            offset = offset_or_error.release_value();
+        }
+
+        // A negative limit means there is no limit.
+        Optional<size_t> row_limit;
+        if (limit.has_value() && limit.value() >= 0)
+            row_limit = static_cast<size_t>(limit.value());
+        auto row_offset = (offset.has_value() && offset.value() > 0) ? static_cast<size_t>(offset.value()) : 0u;
+        plan = make<Limit>(plan.release_nonnull(), row_limit, row_offset);
+    }
+
+    return plan.release_nonnull();
+}
+
+Result<NonnullOwnPtr<Operator>, String> Executor::execute_explain(AST::Explain const& explain_statement)
+{
+    if (!is<AST::Select>(*explain_statement.statement()))
+        return String { "Only SELECT statements can be explained" };
+    auto plan_or_error = plan(static_cast<AST::Select const&>(*explain_statement.statement()));
+    if (plan_or_error.is_error())
+        return plan_or_error.release_error();
+
+    Vector<Tuple> lines;
+    for (auto& line : explain(*plan_or_error.value())) {
+        Tuple tuple;
+        tuple.append(text_value(line));
+        lines.append(move(tuple));
+    }
+    return NonnullOwnPtr<Operator>(make<Values>(Vector<OperatorColumn> { { {}, "PLAN" } }, move(lines)));
+}
+
+Optional<String> Executor::execute_create_table(AST::CreateTable const& create_table)
+{
+    if (create_table.has_selection())
+        return "CREATE TABLE ... AS SELECT is not supported yet";
+
+    auto schema_name = schema_name_or_default(create_table.schema_name());
+    auto schema = m_database->get_schema(schema_name);
+    if (!schema) {
+        if (!create_table.schema_name().is_null())
+            return String::formatted("No such schema: {}", schema_name);
+        schema = SchemaDef::construct(schema_name);
+        m_database->add_schema(*schema);
+    }
+
+    if (m_database->get_table(schema_name, create_table.table_name())) {
+        if (create_table.is_error_if_table_exists())
+            return String::formatted("Table {} already exists", create_table.table_name());
+        return {};
+    }
+
+    auto table = TableDef::construct(schema, create_table.table_name());
+    for (auto& column : create_table.columns())
+        table->append_column(column.name(), sql_type_for(column.type_name()->name()));
+    m_database->add_table(table);
+    return {};
+}
+
+Optional<String> Executor::execute_create_index(AST::CreateIndex const& create_index)
+{
+    auto table = m_database->get_table(schema_name_or_default(create_index.schema_name()), create_index.table_name());
+    if (!table)
+        return String::formatted("No such table: {}", create_index.table_name());
+
+    for (auto& index : table->indexes()) {
+        if (index.name() == create_index.index_name()) {
+            if (create_index.is_error_if_index_exists())
+                return String::formatted("Index {} already exists", create_index.index_name());
+            return {};
+        }
+    }
+
+    auto is_hash = create_index.index_type() == AST::IndexType::Hash;
+    // FIXME: Hash indexes can only hold a single row per key.
+    if (is_hash && !create_index.is_unique())
+        return String { "Hash indexes must be UNIQUE" };
+
+    auto index = IndexDef::construct(table.ptr(), create_index.index_name(), create_index.is_unique(), 0, create_index.index_type());
+    auto table_columns = table->columns();
+    for (auto& indexed_column : create_index.indexed_columns()) {
+        // FIXME: The catalog does not store the sort order of key parts yet.
+        if (indexed_column.order() == AST::Order::Descending)
+            return String { "Descending index columns are not supported yet" };
+
+        ColumnDef const* column = nullptr;
+        for (auto& table_column : table_columns) {
+            if (table_column.name() == indexed_column.column_name())
+                column = &table_column;
+        }
+        if (!column)
+            return String::formatted("Table {} has no column named {}", create_index.table_name(), indexed_column.column_name());
+        if (is_hash && column->type() == SQLType::Float)
+            return String::formatted("Column {} is a float column, which cannot be part of a hash index", column->name());
+        index->append_column(column->name(), column->type());
+    }
+
+    if (!m_database->add_index(index))
+        return String { "UNIQUE constraint failed" };
+    return {};
+}
+
+Optional<String> Executor::execute_insert(AST::Insert const& insert)
+{
+    if (insert.default_values())
+        return "INSERT ... DEFAULT VALUES is not supported yet";
+
+    auto table = m_database->get_table(schema_name_or_default(insert.schema_name()), insert.table_name());
+    if (!table)
+        return String::formatted("No such table: {}", insert.table_name());
+
+    auto table_columns = table->columns();
+    Vector<size_t> positions;
+    if (insert.column_names().is_empty()) {
+        for (auto ix = 0u; ix < table_columns.size(); ix++)
+            positions.append(ix);
+    } else {
+        for (auto& column_name : insert.column_names()) {
+            Optional<size_t> position;
+            for (auto ix = 0u; ix < table_columns.size(); ix++) {
+                if (table_columns[ix].name() == column_name)
+                    position = ix;
+            }
+            if (!position.has_value())
+                return String::formatted("Table {} has no column named {}", insert.table_name(), column_name);
+            positions.append(position.value());
+        }
+    }
+
+    auto insert_values = [&](Tuple const& values) -> Optional<String> {
+        if (values.length() != positions.size())
+            return String::formatted("{} values for {} columns", values.length(), positions.size());
+
+        // Columns that are not given a value are NULL:
+        Row row(table);
+        for (auto ix = 0u; ix < positions.size(); ix++) {
+            auto& value = values[ix];
+            auto& column = table_columns[positions[ix]];
+            if (!row[positions[ix]].can_cast(value))
+                return String::formatted("Cannot store '{}' in column {} of type {}", value.to_string().value(), column.name(), row[positions[ix]].type_name());
+            row[positions[ix]] = value;
+        }
+
+        if (!m_database->insert(row))
+            return String::formatted("UNIQUE constraint failed on table {}", table->name());
+        m_rows_affected++;
+        return {};
+    };
+
+    if (insert.has_selection()) {
+        auto plan_or_error = plan(*insert.select_statement());
+        if (plan_or_error.is_error())
+            return plan_or_error.release_error();
+        // The selected rows are collected first, so that the rows being inserted don't show up in the
+        // selection, and don't invalidate the index iterators the selection may be using.
+        auto plan = plan_or_error.release_value();
+        Vector<Tuple> tuples;
+        for (auto tuple = plan->next(); tuple.has_value(); tuple = plan->next())
+            tuples.append(tuple.release_value());
+        for (auto& tuple : tuples) {
+            if (auto error = insert_values(tuple); error.has_value())
+                return error;
+        }
+        return {};
+    }
+
+    Evaluator evaluator;
+    for (auto& chained_expression : insert.chained_expressions()) {
+        Tuple values;
+        for (auto& expression : chained_expression.expressions()) {
+            if (auto error = evaluator.bind(expression); error.has_value())
+                return error;
+            values.append(evaluator.evaluate(expression, Tuple()));
+        }
+        if (auto error = insert_values(values); error.has_value())
+            return error;
+    }
+    return {};
+}
+
+Optional<String> Executor::execute_delete(AST::Delete const& delete_statement)
+{
+    if (delete_statement.common_table_expression_list())
+        return "DELETE with common table expressions is not supported yet";
+    if (delete_statement.returning_clause())
+        return "DELETE ... RETURNING is not supported yet";
+
+    auto const& qualified_table_name = *delete_statement.qualified_table_name();
+    auto table = m_database->get_table(schema_name_or_default(qualified_table_name.schema_name()), qualified_table_name.table_name());
+    if (!table)
+        return String::formatted("No such table: {}", qualified_table_name.table_name());
+    auto alias = qualified_table_name.alias().is_null() ? qualified_table_name.table_name() : qualified_table_name.alias();
+
+    // The rows to delete are found like the rows of a single table SELECT, using the cheapest access path.
+    NonnullRefPtrVector<AST::Expression> conjuncts;
+    if (auto const& where_clause = delete_statement.where_clause(); where_clause)
+        split_conjuncts(*where_clause, conjuncts);
+    Evaluator evaluator(TableScan(m_database, *table, alias).columns());
+    for (auto& conjunct : conjuncts) {
+        if (auto error = evaluator.bind(conjunct); error.has_value())
+            return error.release_value();
+    }
+    auto access_path = choose_access_path(m_database, *table, alias, conjuncts);
+    NonnullOwnPtr<Operator> plan = create_scan(m_database, *table, alias, access_path);
+    if (!conjuncts.is_empty())
+        plan = make<Filter>(move(plan), move(conjuncts), move(evaluator));
+
+    // The rows are collected first, because removing them invalidates the index iterators the plan may be using.
+    Vector<u32> row_pointers;
+    for (auto tuple = plan->next(); tuple.has_value(); tuple = plan->next())
+        row_pointers.append(tuple->pointer());
+    m_database->remove(*table, row_pointers);
+    m_rows_affected = row_pointers.size();
+    return {};
+}
+
+Optional<String> Executor::execute_vacuum(AST::Vacuum const& vacuum)
+{
+    // All schemas live in the same file, so vacuuming one of them vacuums all of them.
+    if (!vacuum.schema_name().is_null() && !m_database->get_schema(vacuum.schema_name()))
+        return String::formatted("No such schema: {}", vacuum.schema_name());
+    if (!m_database->vacuum())
+        return String("Can't vacuum a database while snapshots of it are open");
+    return {};
+}
+
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/OwnPtr.h>
+#include <AK/Result.h>
+#include <AK/String.h>
+#include <LibSQL/AST/AST.h>
+#include <LibSQL/Database.h>
+#include <LibSQL/Forward.h>
+#include <LibSQL/Operator.h>
+
+namespace SQL {
+
+/**
+ * The Executor runs parsed SQL statements against a Database.
+ *
+ * SELECT statements are lowered into a tree of Operators: scans of the tables
+ * in the FROM clause, joined left to right, with every WHERE condition applied
+ * as soon as all the columns it references are available. Every table is read
+ * using the cheapest access path its conditions allow, which may be one of its
+ * indexes. Tables joined on equal columns are merged if both are read in the
+ * order of the joined columns, and hashed otherwise. A HashJoin that exceeds
+ * the join memory budget spills to a temporary file. Then come grouping and aggregation, HAVING, ORDER BY, the projection
+ * of the result columns, DISTINCT, and finally LIMIT and OFFSET. Rows are
+ * produced on demand when the caller pulls them from the returned operator.
+ *
+ * EXPLAIN produces the plan of a SELECT statement as rows of text, one line
+ * per operator.
+ *
+ * CREATE TABLE, CREATE INDEX, INSERT and DELETE are executed immediately and
+ * committed. VACUUM rebuilds the database file, which makes any plan still
+ * holding on to its tables stale.
+ *
+ * An Executor running on a snapshot of a Database can only run SELECT and
+ * EXPLAIN statements.
+ */
+class Executor {
+public:
+    explicit Executor(Database&);
+
+    Result<OwnPtr<Operator>, String> execute(AST::Statement const&);
+    Result<NonnullOwnPtr<Operator>, String> plan(AST::Select const&);
+
+    [[nodiscard]] size_t rows_affected() const { return m_rows_affected; }
+    [[nodiscard]] size_t join_memory_budget() const { return m_join_memory_budget; }
+    void set_join_memory_budget(size_t budget) { m_join_memory_budget = budget; }
+
+private:
+    using CommonTableExpressions = HashMap<String, NonnullRefPtr<AST::CommonTableExpression>>;
+
+    Result<NonnullOwnPtr<Operator>, String> plan_select(AST::Select const&, CommonTableExpressions);
+    Result<NonnullOwnPtr<Operator>, String> plan_table(AST::TableOrSubquery const&, NonnullRefPtrVector<AST::Expression>& conjuncts, CommonTableExpressions const&);
+    NonnullOwnPtr<Operator> plan_join(NonnullOwnPtr<Operator> left, NonnullOwnPtr<Operator> right, NonnullRefPtrVector<AST::Expression> conditions, Evaluator);
+    Result<NonnullOwnPtr<Operator>, String> execute_explain(AST::Explain const&);
+    Optional<String> execute_create_table(AST::CreateTable const&);
+    Optional<String> execute_create_index(AST::CreateIndex const&);
+    Optional<String> execute_insert(AST::Insert const&);
+    Optional<String> execute_delete(AST::Delete const&);
+    Optional<String> execute_vacuum(AST::Vacuum const&);
+
+    NonnullRefPtr<Database> m_database;
+    size_t m_rows_affected { 0 };
+    size_t m_join_memory_budget { DEFAULT_JOIN_MEMORY_BUDGET };
+};
+
+}
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Format.h>
+#include <AK/QuickSort.h>
+#include <LibSQL/ExternalSorter.h>
+#include <LibSQL/Meta.h>
+#include <LibSQL/Serialize.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+namespace SQL {
+
+// Runs are written and read back in chunks of this size:
+constexpr static size_t RUN_CHUNK_SIZE = 64 * KiB;
+
+ExternalSorter::ExternalSorter(TupleDescriptor const& descriptor, size_t memory_budget)
+    : m_descriptor(descriptor)
+    , m_memory_budget(memory_budget)
+{
+}
+
+ExternalSorter::~ExternalSorter()
+{
+    if (m_fd >= 0)
+        close(m_fd);
+}
+
+void ExternalSorter::append(Key const& key)
+{
+    VERIFY(!m_reading);
+    m_keys.append(key);
+    m_size++;
+    m_memory_used += key.data_length();
+    if (m_memory_used > m_memory_budget)
+        spill();
+}
+
+// Sorts the positions of the keys instead of the keys themselves, since keys are expensive to move around.
+void ExternalSorter::sort_in_memory()
+{
+    m_order.clear();
+    m_order.ensure_capacity(m_keys.size());
+    for (auto ix = 0u; ix < m_keys.size(); ix++)
+        m_order.append(ix);
+    quick_sort(m_order, [&](size_t a, size_t b) { return m_keys[a].compare(m_keys[b]) < 0; });
+}
+
+void ExternalSorter::spill()
+{
+    if (m_fd < 0) {
+        char path[] = "/tmp/sql-sort-XXXXXX";
+        m_fd = mkstemp(path);
+        if (m_fd < 0) {
+            warnln("Could not create a temporary file to sort keys in. Sorting in memory instead.");
+            m_memory_budget = NumericLimits<size_t>::max();
+            return;
+        }
+        unlink(path);
+    }
+
+    sort_in_memory();
+    Run run;
+    run.start = m_file_size;
+
+    // Every key is preceded by its serialized length:
+    ByteBuffer buffer;
+    for (auto ix : m_order) {
+        ByteBuffer key_buffer;
+        m_keys[ix].serialize(key_buffer);
+        serialize_to<u32>(buffer, key_buffer.size());
+        buffer.append(key_buffer.data(), key_buffer.size());
+        if (buffer.size() >= RUN_CHUNK_SIZE) {
+            if (!write(buffer))
+                VERIFY_NOT_REACHED();
+            buffer.clear();
+        }
+    }
+    if (!write(buffer))
+        VERIFY_NOT_REACHED();
+
+    run.end = m_file_size;
+    m_runs.append(move(run));
+    m_keys.clear();
+    m_order.clear();
+    m_memory_used = 0;
+}
+
+bool ExternalSorter::write(ByteBuffer const& buffer)
+{
+    size_t written = 0;
+    while (written < buffer.size()) {
+        auto rc = pwrite(m_fd, buffer.data() + written, buffer.size() - written, m_file_size);
+        if (rc <= 0) {
+            perror("pwrite");
+            return false;
+        }
+        written += rc;
+        m_file_size += rc;
+    }
+    return true;
+}
+
+// Makes sure the buffer of the run holds at least `size` unread bytes, reading the next chunk of the run if it doesn't.
+bool ExternalSorter::fill(Run& run, size_t size)
+{
+    if (run.offset + size <= run.buffer.size())
+        return true;
+    run.position += run.offset;
+    auto remaining = static_cast<size_t>(run.end - run.position);
+    if (remaining < size)
+        return false;
+    auto chunk_size = max(size, min(remaining, RUN_CHUNK_SIZE));
+    run.buffer.resize(chunk_size);
+    size_t read = 0;
+    while (read < chunk_size) {
+        auto rc = pread(m_fd, run.buffer.data() + read, chunk_size - read, run.position + read);
+        if (rc <= 0) {
+            perror("pread");
+            VERIFY_NOT_REACHED();
+        }
+        read += rc;
+    }
+    run.offset = 0;
+    return true;
+}
+
+Optional<Key> ExternalSorter::read_key(Run& run)
+{
+    if (!fill(run, sizeof(u32)))
+        return {};
+    u32 size;
+    deserialize_from<u32>(run.buffer, run.offset, size);
+    VERIFY(fill(run, size));
+    return Key(m_descriptor, run.buffer, run.offset);
+}
+
+Optional<Key> ExternalSorter::next_in_memory()
+{
+    if (m_position >= m_order.size())
+        return {};
+    return m_keys[m_order[m_position++]];
+}
+
+void ExternalSorter::rewind()
+{
+    if (!m_reading) {
+        m_reading = true;
+        sort_in_memory();
+    }
+    m_position = 0;
+    m_memory_head = next_in_memory();
+    for (auto& run : m_runs) {
+        run.position = run.start;
+        run.buffer.clear();
+        run.offset = 0;
+        run.head = read_key(run);
+    }
+}
+
+Optional<Key> ExternalSorter::next()
+{
+    if (!m_reading)
+        rewind();
+    if (m_runs.is_empty())
+        return exchange(m_memory_head, next_in_memory());
+
+    // Merge the runs by taking the smallest of their first keys. There are normally few runs,
+    // so they are simply compared one by one.
+    Run* smallest = nullptr;
+    for (auto& run : m_runs) {
+        if (run.head.has_value() && (!smallest || run.head.value() < smallest->head.value()))
+            smallest = &run;
+    }
+    if (m_memory_head.has_value() && (!smallest || m_memory_head.value() < smallest->head.value()))
+        return exchange(m_memory_head, next_in_memory());
+    if (!smallest)
+        return {};
+    return exchange(smallest->head, read_key(*smallest));
+}
+
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/Noncopyable.h>
+#include <AK/Optional.h>
+#include <AK/Types.h>
+#include <AK/Vector.h>
+#include <LibSQL/Key.h>
+#include <LibSQL/TupleDescriptor.h>
+#include <sys/types.h>
+
+namespace SQL {
+
+constexpr static size_t DEFAULT_SORT_MEMORY_BUDGET = 16 * MiB;
+
+/**
+ * An ExternalSorter sorts a stream of Keys which doesn't necessarily fit in
+ * memory. Keys are collected in memory until their serialized size exceeds
+ * the memory budget. They are then sorted, and written to a temporary file
+ * as a sorted run. Reading the keys back using next() merges the runs, and
+ * the keys still in memory, into a single stream in ascending order.
+ *
+ * Once next() has been called, no more keys can be appended. rewind()
+ * restarts the stream at the smallest key.
+ */
+class ExternalSorter {
+    AK_MAKE_NONCOPYABLE(ExternalSorter);
+    AK_MAKE_NONMOVABLE(ExternalSorter);
+
+public:
+    explicit ExternalSorter(TupleDescriptor const&, size_t memory_budget = DEFAULT_SORT_MEMORY_BUDGET);
+    ~ExternalSorter();
+
+    void append(Key const&);
+    Optional<Key> next();
+    void rewind();
+
+    [[nodiscard]] TupleDescriptor const& descriptor() const { return m_descriptor; }
+    [[nodiscard]] size_t size() const { return m_size; }
+    [[nodiscard]] size_t runs() const { return m_runs.size(); }
+
+private:
+    struct Run {
+        off_t start { 0 };
+        off_t end { 0 };
+        off_t position { 0 };
+        ByteBuffer buffer;
+        size_t offset { 0 };
+        Optional<Key> head;
+    };
+
+    void sort_in_memory();
+    void spill();
+    bool write(ByteBuffer const&);
+    bool fill(Run&, size_t);
+    Optional<Key> read_key(Run&);
+    Optional<Key> next_in_memory();
+
+    TupleDescriptor m_descriptor;
+    size_t m_memory_budget { DEFAULT_SORT_MEMORY_BUDGET };
+    size_t m_memory_used { 0 };
+    size_t m_size { 0 };
+    bool m_reading { false };
+
+    Vector<Key> m_keys;
+    Vector<size_t> m_order;
+    size_t m_position { 0 };
+    Optional<Key> m_memory_head;
+
+    int m_fd { -1 };
+    off_t m_file_size { 0 };
+    Vector<Run> m_runs;
+};
+
+}
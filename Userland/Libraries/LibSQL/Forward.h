@@ -9,8 +9,12 @@
 namespace SQL {
 class BTree;
 class BTreeIterator;
+class BulkLoader;
 class ColumnDef;
 class Database;
+class Evaluator;
+class Executor;
+class ExternalSorter;
 class HashBucket;
 class HashDirectoryNode;
 class HashIndex;
@@ -21,7 +25,9 @@ class IndexNode;
 class IndexDef;
 class Key;
 class KeyPartDef;
+class Operator;
 class Row;
+class SpillFile;
 class TableDef;
 class TreeNode;
 class Tuple;
@@ -45,6 +51,7 @@ class ColumnDefinition;
 class ColumnNameExpression;
 class CommonTableExpression;
 class CommonTableExpressionList;
+class CreateIndex;
 class CreateTable;
 class Delete;
 class DropColumn;
@@ -52,9 +59,12 @@ class DropTable;
 class ErrorExpression;
 class ErrorStatement;
 class ExistsExpression;
+class Explain;
 class Expression;
+class FunctionCallExpression;
 class GroupByClause;
 class InChainedExpression;
+class IndexedColumn;
 class InSelectionExpression;
 class Insert;
 class InTableExpression;
@@ -85,4 +95,5 @@ class Token;
 class TypeName;
 class UnaryOperatorExpression;
 class Update;
+class Vacuum;
 }
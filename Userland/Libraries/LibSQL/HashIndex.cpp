@@ -118,7 +118,7 @@ void HashBucket::inflate()
 size_t HashBucket::max_entries_in_bucket() const
 {
     auto key_size = m_hash_index.descriptor().data_length() + sizeof(u32);
-    return (BLOCKSIZE - 2 * sizeof(u32)) / key_size;
+    return (m_hash_index.block_size() - 2 * sizeof(u32)) / key_size;
 }
 
 Optional<u32> HashBucket::get(Key& key)
@@ -146,6 +146,17 @@ bool HashBucket::insert(Key const& key)
     return true;
 }
 
+bool HashBucket::remove(Key const& key)
+{
+    inflate();
+    auto optional_index = find_key_in_bucket(key);
+    if (!optional_index.has_value())
+        return false;
+    m_entries.remove(optional_index.value());
+    m_hash_index.add_to_write_ahead_log(this);
+    return true;
+}
+
 Optional<size_t> HashBucket::find_key_in_bucket(Key const& key)
 {
     for (auto ix = 0u; ix < size(); ix++) {
@@ -207,6 +218,7 @@ HashIndex::HashIndex(Heap& heap, TupleDescriptor const& descriptor, u32 first_no
         do {
             VERIFY(this->heap().has_block(pointer));
             auto buffer = read_block(pointer);
+            pin_block(pointer);
             auto node = HashDirectoryNode(*this, pointer, buffer);
             if (node.is_last())
                 break;
@@ -295,7 +307,7 @@ void HashIndex::expand()
 
 void HashIndex::write_directory_to_write_ahead_log()
 {
-    auto num_nodes_required = (size() / HashDirectoryNode::max_pointers_in_node()) + 1;
+    auto num_nodes_required = (size() / max_pointers_in_node()) + 1;
     while (m_nodes.size() < num_nodes_required)
         m_nodes.append(new_record_pointer());
 
@@ -336,6 +348,11 @@ bool HashIndex::insert(Key const& key)
     return true;
 }
 
+bool HashIndex::remove(Key const& key)
+{
+    return get_bucket(key.hash() % size())->remove(key);
+}
+
 HashIndexIterator HashIndex::begin()
 {
     return HashIndexIterator(get_bucket(0));
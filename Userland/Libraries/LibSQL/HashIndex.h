@@ -28,6 +28,7 @@ public:
     ~HashBucket() override = default;
     Optional<u32> get(Key&);
     bool insert(Key const&);
+    bool remove(Key const&);
     Vector<Key> const& entries()
     {
         inflate();
@@ -75,6 +76,7 @@ public:
     Optional<u32> get(Key&);
     bool insert(Key const&);
     bool insert(Key const&& entry) { return insert(entry); }
+    bool remove(Key const&);
     HashIndexIterator find(Key const&);
     HashIndexIterator begin();
     static HashIndexIterator end();
@@ -95,6 +97,7 @@ private:
     HashBucket* append_bucket(u32 index, u32 local_depth, u32 pointer);
     HashBucket* get_bucket_for_insert(Key const&);
     [[nodiscard]] HashBucket* get_bucket_by_index(u32 index);
+    [[nodiscard]] size_t max_pointers_in_node() const { return (block_size() - 3 * sizeof(u32)) / (2 * sizeof(u32)); }
 
     u32 m_global_depth { 1 };
     Vector<u32> m_nodes;
@@ -113,7 +116,7 @@ public:
     IndexNode* as_index_node() override { return dynamic_cast<IndexNode*>(this); }
     [[nodiscard]] u32 number_of_pointers() const { return min(max_pointers_in_node(), m_hash_index.size() - m_offset); }
     [[nodiscard]] bool is_last() const { return m_is_last; }
-    static constexpr size_t max_pointers_in_node() { return (BLOCKSIZE - 3 * sizeof(u32)) / (2 * sizeof(u32)); }
+    [[nodiscard]] size_t max_pointers_in_node() const { return m_hash_index.max_pointers_in_node(); }
 
 private:
     HashIndex& m_hash_index;
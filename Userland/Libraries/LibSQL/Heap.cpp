@@ -10,13 +10,18 @@
 #include <LibCore/IODevice.h>
 #include <LibSQL/Heap.h>
 #include <LibSQL/Serialize.h>
+#include <errno.h>
+#include <string.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <unistd.h>
 
 namespace SQL {
 
-Heap::Heap(String file_name)
+Heap::Heap(String file_name, u32 block_size)
+    : m_block_size(block_size)
 {
+    VERIFY(is_valid_block_size(block_size));
     set_name(move(file_name));
     size_t file_size = 0;
     struct stat stat_buffer;
@@ -28,8 +33,6 @@ Heap::Heap(String file_name)
     } else {
         file_size = stat_buffer.st_size;
     }
-    if (file_size > 0)
-        m_next_block = m_end_of_file = file_size / BLOCKSIZE;
 
     auto file_or_error = Core::File::open(name(), Core::OpenMode::ReadWrite);
     if (file_or_error.is_error()) {
@@ -37,45 +40,152 @@ Heap::Heap(String file_name)
         VERIFY_NOT_REACHED();
     }
     m_file = file_or_error.value();
+
+    // The block size of an existing file is whatever it was created with,
+    // and is needed before any block, or the write-ahead log, can be read:
+    if (file_size > 0) {
+        read_block_size();
+        m_next_block = m_end_of_file = file_size / m_block_size;
+    }
+    m_page_cache = PageCache(DEFAULT_PAGE_CACHE_BUDGET, m_block_size);
+
+    if (!open_write_ahead_log())
+        VERIFY_NOT_REACHED();
+    replay_write_ahead_log();
+
     if (file_size > 0)
         read_zero_block();
     else
         initialize_zero_block();
 }
 
+// A snapshot shares the files of its parent, and gets a copy of the index of
+// its log, holding the frames of all transactions committed so far:
+Heap::Heap(Heap& parent)
+    : Core::Object(nullptr)
+    , m_block_size(parent.m_block_size)
+{
+    set_name(parent.name());
+    {
+        Threading::Locker locker(parent.m_lock);
+        m_parent = parent;
+        m_file = parent.m_file;
+        m_wal_file = parent.m_wal_file;
+        m_wal_index = parent.m_wal_index;
+        m_end_of_file = parent.m_end_of_file;
+        parent.m_snapshots++;
+    }
+    // Blocks added since the last checkpoint only exist in the log:
+    for (auto& entry : m_wal_index) {
+        if (entry.key >= m_end_of_file)
+            m_end_of_file = entry.key + 1;
+    }
+    m_next_block = m_end_of_file;
+    m_page_cache = PageCache(parent.m_page_cache.budget(), m_block_size);
+    read_zero_block();
+}
+
+Heap::~Heap()
+{
+    if (is_snapshot()) {
+        Threading::Locker locker(m_parent->m_lock);
+        m_parent->m_snapshots--;
+        return;
+    }
+    flush();
+    if (checkpoint())
+        unlink(wal_name().characters());
+}
+
+NonnullRefPtr<Heap> Heap::snapshot()
+{
+    VERIFY(!is_snapshot());
+    return Heap::construct(*this);
+}
+
+u32 Heap::open_snapshots() const
+{
+    Threading::Locker locker(m_lock);
+    return m_snapshots;
+}
+
+// pread() doesn't move the offset of the file, which the Heap may be using
+// to write the file on another thread.
+static Result<ByteBuffer, String> read_at(Core::File& file, off_t offset, size_t size)
+{
+    auto buffer = ByteBuffer::create_uninitialized(size);
+    size_t nread = 0;
+    while (nread < size) {
+        auto rc = pread(file.fd(), buffer.offset_pointer(nread), size - nread, offset + (off_t)nread);
+        if (rc < 0 && errno == EINTR)
+            continue;
+        if (rc <= 0)
+            return String(rc < 0 ? strerror(errno) : "Unexpected end of file");
+        nread += rc;
+    }
+    return buffer;
+}
+
 Result<ByteBuffer, String> Heap::read_block(u32 block)
 {
-    auto buffer_or_empty = m_write_ahead_log.get(block);
+    auto buffer_or_empty = m_dirty_blocks.get(block);
     if (buffer_or_empty.has_value())
         return buffer_or_empty.value();
 
     VERIFY(block < m_next_block);
+    auto cached = m_page_cache.get(block);
+    if (cached.has_value())
+        return cached.release_value();
+
+    auto frame = m_wal_index.get(block);
+    if (frame.has_value()) {
+        dbgln_if(SQL_DEBUG, "Read heap block {} from log frame {}", block, frame.value());
+        auto buffer_or_error = read_frame(frame.value());
+        if (!buffer_or_error.is_error())
+            m_page_cache.put(block, buffer_or_error.value());
+        return buffer_or_error;
+    }
+
     dbgln_if(SQL_DEBUG, "Read heap block {}", block);
-    if (!seek_block(block))
-        VERIFY_NOT_REACHED();
-    auto ret = m_file->read(BLOCKSIZE);
-    if (ret.is_empty())
-        return String("Could not read block");
-    return ret;
+    auto buffer_or_error = read_at(*m_file, (off_t)block * m_block_size, m_block_size);
+    if (buffer_or_error.is_error())
+        return String::formatted("Could not read block {}: {}", block, buffer_or_error.error());
+    m_blocks_read++;
+    m_page_cache.put(block, buffer_or_error.value());
+    return buffer_or_error;
 }
 
 bool Heap::write_block(u32 block, ByteBuffer& buffer)
 {
+    VERIFY(!is_snapshot());
     VERIFY(block < m_next_block);
+    Threading::Locker locker(m_lock);
+    if (block > m_end_of_file) {
+        // Blocks can be handed out by new_record_pointer() and never be
+        // written. Fill the hole, so the block ends up at the right offset:
+        auto filler = ByteBuffer::create_zeroed(m_block_size);
+        while (block > m_end_of_file) {
+            if (!write_block(m_end_of_file, filler))
+                return false;
+        }
+    }
     if (!seek_block(block))
         VERIFY_NOT_REACHED();
     dbgln_if(SQL_DEBUG, "Write heap block {} size {}", block, buffer.size());
-    VERIFY(buffer.size() <= BLOCKSIZE);
+    VERIFY(buffer.size() <= m_block_size);
     auto sz = buffer.size();
-    if (sz < BLOCKSIZE) {
-        buffer.resize(BLOCKSIZE);
-        memset(buffer.offset_pointer((int)sz), 0, BLOCKSIZE - sz);
+    if (sz < m_block_size) {
+        buffer.resize(m_block_size);
+        memset(buffer.offset_pointer((int)sz), 0, m_block_size - sz);
     }
     if (m_file->write(buffer.data(), (int)buffer.size())) {
         if (block == m_end_of_file)
             m_end_of_file++;
+        m_blocks_written++;
+        m_page_cache.put(block, buffer);
         return true;
     }
+    m_page_cache.invalidate(block);
     return false;
 }
 
@@ -92,7 +202,7 @@ bool Heap::seek_block(u32 block)
         warnln("Seeking block {} of file {} which is beyond the end of the file", block, name());
         return false;
     } else {
-        if (!m_file->seek(block * BLOCKSIZE)) {
+        if (!m_file->seek((off_t)block * m_block_size)) {
             warnln("Could not seek block {} of file {}. The current size is {} blocks",
                 block, name(), m_end_of_file);
             return false;
@@ -103,6 +213,7 @@ bool Heap::seek_block(u32 block)
 
 u32 Heap::new_record_pointer()
 {
+    VERIFY(!is_snapshot());
     if (m_free_list) {
         auto block_or_error = read_block(m_free_list);
         if (block_or_error.is_error()) {
@@ -112,28 +223,233 @@ u32 Heap::new_record_pointer()
         auto new_pointer = m_free_list;
         size_t offset = 0;
         deserialize_from<u32>(block_or_error.value(), offset, m_free_list);
+        if (m_free_blocks)
+            m_free_blocks--;
         update_zero_block();
         return new_pointer;
     }
     return m_next_block++;
 }
 
+void Heap::free_block(u32 block)
+{
+    VERIFY(block > 0 && block < m_next_block);
+    dbgln_if(SQL_DEBUG, "Free heap block {}", block);
+    ByteBuffer buffer;
+    serialize_to<u32>(buffer, m_free_list);
+    add_to_wal(block, buffer);
+    m_page_cache.unpin(block);
+    m_page_cache.invalidate(block);
+    m_free_list = block;
+    m_free_blocks++;
+    update_zero_block();
+}
+
+// A frame in the write-ahead log consists of a header followed by the
+// contents of one block. The header holds a magic number, the number of the
+// block, the number of frames in the transaction if this is its last frame
+// (0 otherwise), and a checksum. The checksum covers the header fields, the
+// block contents, and the checksum of the previous frame, so a torn write
+// or a frame left over from an earlier log invalidates the rest of the log.
+constexpr static u32 WAL_FRAME_MAGIC = 0x4c415753; // "SWAL"
+constexpr static int WAL_FRAME_HEADER_SIZE = 4 * sizeof(u32);
+
+size_t Heap::wal_frame_size() const
+{
+    return WAL_FRAME_HEADER_SIZE + m_block_size;
+}
+
+static u32 frame_checksum(u32 previous, u32 block, u32 commit_size, u8 const* data, u32 block_size)
+{
+    u32 s1 = previous ^ block;
+    u32 s2 = commit_size;
+    for (auto ix = 0u; ix < block_size; ix += 2 * sizeof(u32)) {
+        u32 words[2];
+        memcpy(words, data + ix, sizeof(words));
+        s1 += words[0] + s2;
+        s2 += words[1] + s1;
+    }
+    return s1 ^ s2;
+}
+
+bool Heap::open_write_ahead_log()
+{
+    auto file_or_error = Core::File::open(wal_name(), Core::OpenMode::ReadWrite);
+    if (file_or_error.is_error()) {
+        warnln("Couldn't open write-ahead log '{}': {}", wal_name(), file_or_error.error());
+        return false;
+    }
+    m_wal_file = file_or_error.value();
+    return true;
+}
+
+void Heap::replay_write_ahead_log()
+{
+    if (!m_wal_file->seek(0))
+        VERIFY_NOT_REACHED();
+
+    HashMap<u32, u32> uncommitted;
+    u32 checksum = 0;
+    u32 frame = 0;
+    while (true) {
+        auto buffer = m_wal_file->read(wal_frame_size());
+        if (buffer.size() < wal_frame_size())
+            break;
+        size_t offset = 0;
+        u32 magic;
+        u32 block;
+        u32 commit_size;
+        u32 frame_checksum_on_disk;
+        deserialize_from<u32>(buffer, offset, magic);
+        deserialize_from<u32>(buffer, offset, block);
+        deserialize_from<u32>(buffer, offset, commit_size);
+        deserialize_from<u32>(buffer, offset, frame_checksum_on_disk);
+        if (magic != WAL_FRAME_MAGIC)
+            break;
+        checksum = frame_checksum(checksum, block, commit_size, buffer.offset_pointer(WAL_FRAME_HEADER_SIZE), m_block_size);
+        if (checksum != frame_checksum_on_disk) {
+            warnln("Checksum mismatch in frame {} of write-ahead log {}", frame, wal_name());
+            break;
+        }
+        uncommitted.set(block, frame++);
+        if (commit_size) {
+            for (auto& entry : uncommitted)
+                m_wal_index.set(entry.key, entry.value);
+            uncommitted.clear();
+            m_wal_frames = frame;
+            m_wal_checksum = checksum;
+        }
+    }
+    if (!uncommitted.is_empty())
+        dbgln_if(SQL_DEBUG, "Discarding {} uncommitted frames from {}", uncommitted.size(), wal_name());
+    if (m_wal_index.is_empty()) {
+        m_wal_file->truncate(0);
+        return;
+    }
+
+    dbgln_if(SQL_DEBUG, "Replaying {} blocks from {}", m_wal_index.size(), wal_name());
+    for (auto& entry : m_wal_index) {
+        if (entry.key >= m_next_block)
+            m_next_block = entry.key + 1;
+    }
+    if (!checkpoint())
+        VERIFY_NOT_REACHED();
+}
+
+Result<ByteBuffer, String> Heap::read_frame(u32 frame)
+{
+    auto buffer_or_error = read_at(*m_wal_file, (off_t)frame * wal_frame_size() + WAL_FRAME_HEADER_SIZE, m_block_size);
+    if (buffer_or_error.is_error())
+        return String::formatted("Could not read write-ahead log frame {}: {}", frame, buffer_or_error.error());
+    m_blocks_read++;
+    return buffer_or_error;
+}
+
 void Heap::flush()
 {
+    if (m_dirty_blocks.is_empty())
+        return;
     Vector<u32> blocks;
-    for (auto& wal_entry : m_write_ahead_log) {
-        blocks.append(wal_entry.key);
+    for (auto& entry : m_dirty_blocks) {
+        blocks.append(entry.key);
     }
     quick_sort(blocks);
-    for (auto& block : blocks) {
-        auto buffer_or_empty = m_write_ahead_log.get(block);
-        if (buffer_or_empty->is_empty()) {
+
+    // Build all frames of the transaction in one buffer, so the commit
+    // costs a single write:
+    ByteBuffer frames;
+    frames.ensure_capacity(blocks.size() * wal_frame_size());
+    for (auto ix = 0u; ix < blocks.size(); ix++) {
+        auto block = blocks[ix];
+        auto& buffer = m_dirty_blocks.find(block)->value;
+        VERIFY(!buffer.is_empty() && buffer.size() <= m_block_size);
+        if (buffer.size() < m_block_size) {
+            auto sz = buffer.size();
+            buffer.resize(m_block_size);
+            memset(buffer.offset_pointer((int)sz), 0, m_block_size - sz);
+        }
+        u32 commit_size = (ix == blocks.size() - 1) ? (u32)blocks.size() : 0u;
+        m_wal_checksum = frame_checksum(m_wal_checksum, block, commit_size, buffer.data(), m_block_size);
+        serialize_to<u32>(frames, WAL_FRAME_MAGIC);
+        serialize_to<u32>(frames, block);
+        serialize_to<u32>(frames, commit_size);
+        serialize_to<u32>(frames, m_wal_checksum);
+        frames.append(buffer.data(), m_block_size);
+    }
+
+    dbgln_if(SQL_DEBUG, "Committing {} blocks to {}", blocks.size(), wal_name());
+    {
+        Threading::Locker locker(m_lock);
+        if (!m_wal_file->seek((off_t)m_wal_frames * wal_frame_size()) || !m_wal_file->write(frames.data(), (int)frames.size())) {
+            warnln("Could not write to write-ahead log {}: {}", wal_name(), m_wal_file->error_string());
             VERIFY_NOT_REACHED();
         }
-        dbgln_if(SQL_DEBUG, "Flushing block {} to {}", block, name());
-        write_block(block, buffer_or_empty.value());
+        for (auto block : blocks) {
+            m_wal_index.set(block, m_wal_frames++);
+            m_page_cache.put(block, m_dirty_blocks.find(block)->value);
+        }
+        m_blocks_written += blocks.size();
+        m_dirty_blocks.clear();
+    }
+
+    if (++m_unsynced_commits >= m_sync_interval)
+        sync();
+    if (m_wal_frames >= m_checkpoint_threshold)
+        checkpoint();
+}
+
+bool Heap::sync()
+{
+    if (!m_unsynced_commits)
+        return true;
+    dbgln_if(SQL_DEBUG, "Syncing {} commits in {}", m_unsynced_commits, wal_name());
+    if (fsync(m_wal_file->fd()) < 0) {
+        perror("fsync");
+        return false;
+    }
+    m_unsynced_commits = 0;
+    return true;
+}
+
+bool Heap::checkpoint()
+{
+    Threading::Locker locker(m_lock);
+    if (m_snapshots) {
+        dbgln_if(SQL_DEBUG, "Not checkpointing {}, {} snapshots are open", wal_name(), m_snapshots);
+        return false;
+    }
+    if (!sync())
+        return false;
+    if (m_wal_index.is_empty())
+        return true;
+
+    Vector<u32> blocks;
+    for (auto& entry : m_wal_index) {
+        blocks.append(entry.key);
+    }
+    quick_sort(blocks);
+    dbgln_if(SQL_DEBUG, "Checkpointing {} blocks from {} into {}", blocks.size(), wal_name(), name());
+    for (auto block : blocks) {
+        auto buffer_or_error = read_frame(m_wal_index.get(block).value());
+        if (buffer_or_error.is_error()) {
+            warnln("Could not checkpoint block {}: {}", block, buffer_or_error.error());
+            return false;
+        }
+        if (!write_block(block, buffer_or_error.value()))
+            return false;
     }
-    m_write_ahead_log.clear();
+    if (fsync(m_file->fd()) < 0) {
+        perror("fsync");
+        return false;
+    }
+
+    // The database file now holds everything in the log, so it can be reset:
+    if (!m_wal_file->truncate(0))
+        return false;
+    m_wal_index.clear();
+    m_wal_frames = 0;
+    m_wal_checksum = 0;
+    return true;
 }
 
 constexpr static const char* FILE_ID = "SerenitySQL ";
@@ -143,6 +459,31 @@ constexpr static int TABLES_ROOT_OFFSET = 20;
 constexpr static int TABLE_COLUMNS_ROOT_OFFSET = 24;
 constexpr static int FREE_LIST_OFFSET = 28;
 constexpr static int USER_VALUES_OFFSET = 32;
+// The roots added after the user values read as 0 (an empty tree) from files written before they existed:
+constexpr static int INDEXES_ROOT_OFFSET = USER_VALUES_OFFSET + 16 * sizeof(u32);
+constexpr static int STATISTICS_ROOT_OFFSET = INDEXES_ROOT_OFFSET + sizeof(u32);
+constexpr static int BLOCK_SIZE_OFFSET = STATISTICS_ROOT_OFFSET + sizeof(u32);
+constexpr static int FREE_BLOCKS_OFFSET = BLOCK_SIZE_OFFSET + sizeof(u32);
+constexpr static int ZERO_BLOCK_HEADER_SIZE = FREE_BLOCKS_OFFSET + sizeof(u32);
+
+void Heap::read_block_size()
+{
+    if (!m_file->seek(0))
+        VERIFY_NOT_REACHED();
+    auto header = m_file->read(ZERO_BLOCK_HEADER_SIZE);
+    if (header.size() != ZERO_BLOCK_HEADER_SIZE || memcmp(header.data(), FILE_ID, strlen(FILE_ID)) != 0) {
+        warnln("Corrupt zero page in {}", name());
+        VERIFY_NOT_REACHED();
+    }
+    u32 block_size;
+    memcpy(&block_size, header.offset_pointer(BLOCK_SIZE_OFFSET), sizeof(u32));
+    // Files written before the block size was stored have 1 KiB blocks. The
+    // version check in read_zero_block() refuses those anyway, but the zero
+    // block has to be read first:
+    if (!is_valid_block_size(block_size))
+        block_size = MIN_BLOCK_SIZE;
+    m_block_size = block_size;
+}
 
 void Heap::read_zero_block()
 {
@@ -160,14 +501,25 @@ void Heap::read_zero_block()
     dbgln_if(SQL_DEBUG, "Read zero block from {}", name());
     memcpy(&m_version, buffer.offset_pointer(VERSION_OFFSET), sizeof(u32));
     dbgln_if(SQL_DEBUG, "Version: {}.{}", (m_version & 0xFFFF0000) >> 16, (m_version & 0x0000FFFF));
+    if (m_version != FORMAT_VERSION) {
+        warnln("{} has storage format version {}.{}, which is not supported. The supported version is {}.{}",
+            name(), (m_version & 0xFFFF0000) >> 16, (m_version & 0x0000FFFF),
+            (FORMAT_VERSION & 0xFFFF0000) >> 16, (FORMAT_VERSION & 0x0000FFFF));
+        VERIFY_NOT_REACHED();
+    }
     memcpy(&m_schemas_root, buffer.offset_pointer(SCHEMAS_ROOT_OFFSET), sizeof(u32));
     dbgln_if(SQL_DEBUG, "Schemas root node: {}", m_tables_root);
     memcpy(&m_tables_root, buffer.offset_pointer(TABLES_ROOT_OFFSET), sizeof(u32));
     dbgln_if(SQL_DEBUG, "Tables root node: {}", m_tables_root);
     memcpy(&m_table_columns_root, buffer.offset_pointer(TABLE_COLUMNS_ROOT_OFFSET), sizeof(u32));
     dbgln_if(SQL_DEBUG, "Table columns root node: {}", m_table_columns_root);
+    memcpy(&m_indexes_root, buffer.offset_pointer(INDEXES_ROOT_OFFSET), sizeof(u32));
+    dbgln_if(SQL_DEBUG, "Indexes root node: {}", m_indexes_root);
+    memcpy(&m_statistics_root, buffer.offset_pointer(STATISTICS_ROOT_OFFSET), sizeof(u32));
+    dbgln_if(SQL_DEBUG, "Statistics root node: {}", m_statistics_root);
     memcpy(&m_free_list, buffer.offset_pointer(FREE_LIST_OFFSET), sizeof(u32));
-    dbgln_if(SQL_DEBUG, "Free list: {}", m_free_list);
+    memcpy(&m_free_blocks, buffer.offset_pointer(FREE_BLOCKS_OFFSET), sizeof(u32));
+    dbgln_if(SQL_DEBUG, "Free list: {} ({} blocks)", m_free_list, m_free_blocks);
     memcpy(m_user_values.data(), buffer.offset_pointer(USER_VALUES_OFFSET), m_user_values.size() * sizeof(u32));
     for (auto ix = 0u; ix < m_user_values.size(); ix++) {
         if (m_user_values[ix]) {
@@ -176,21 +528,23 @@ void Heap::read_zero_block()
     }
 }
 
-void Heap::update_zero_block()
+ByteBuffer Heap::zero_block() const
 {
     dbgln_if(SQL_DEBUG, "Write zero block to {}", name());
     dbgln_if(SQL_DEBUG, "Version: {}.{}", (m_version & 0xFFFF0000) >> 16, (m_version & 0x0000FFFF));
     dbgln_if(SQL_DEBUG, "Schemas root node: {}", m_schemas_root);
     dbgln_if(SQL_DEBUG, "Tables root node: {}", m_tables_root);
     dbgln_if(SQL_DEBUG, "Table Columns root node: {}", m_table_columns_root);
-    dbgln_if(SQL_DEBUG, "Free list: {}", m_free_list);
+    dbgln_if(SQL_DEBUG, "Indexes root node: {}", m_indexes_root);
+    dbgln_if(SQL_DEBUG, "Statistics root node: {}", m_statistics_root);
+    dbgln_if(SQL_DEBUG, "Free list: {} ({} blocks)", m_free_list, m_free_blocks);
     for (auto ix = 0u; ix < m_user_values.size(); ix++) {
         if (m_user_values[ix]) {
             dbgln_if(SQL_DEBUG, "User value {}: {}", ix, m_user_values[ix]);
         }
     }
 
-    auto buffer = ByteBuffer::create_zeroed(BLOCKSIZE);
+    auto buffer = ByteBuffer::create_zeroed(m_block_size);
     buffer.overwrite(0, FILE_ID, strlen(FILE_ID));
     buffer.overwrite(VERSION_OFFSET, &m_version, sizeof(u32));
     buffer.overwrite(SCHEMAS_ROOT_OFFSET, &m_schemas_root, sizeof(u32));
@@ -198,22 +552,40 @@ void Heap::update_zero_block()
     buffer.overwrite(TABLE_COLUMNS_ROOT_OFFSET, &m_table_columns_root, sizeof(u32));
     buffer.overwrite(FREE_LIST_OFFSET, &m_free_list, sizeof(u32));
     buffer.overwrite(USER_VALUES_OFFSET, m_user_values.data(), m_user_values.size() * sizeof(u32));
+    buffer.overwrite(INDEXES_ROOT_OFFSET, &m_indexes_root, sizeof(u32));
+    buffer.overwrite(STATISTICS_ROOT_OFFSET, &m_statistics_root, sizeof(u32));
+    buffer.overwrite(BLOCK_SIZE_OFFSET, &m_block_size, sizeof(u32));
+    buffer.overwrite(FREE_BLOCKS_OFFSET, &m_free_blocks, sizeof(u32));
+    return buffer;
+}
 
+void Heap::update_zero_block()
+{
+    auto buffer = zero_block();
     add_to_wal(0, buffer);
 }
 
 void Heap::initialize_zero_block()
 {
-    m_version = 0x00000001;
+    m_version = FORMAT_VERSION;
     m_schemas_root = 0;
     m_tables_root = 0;
     m_table_columns_root = 0;
+    m_indexes_root = 0;
+    m_statistics_root = 0;
     m_next_block = 1;
     m_free_list = 0;
+    m_free_blocks = 0;
     for (auto& user : m_user_values) {
         user = 0u;
     }
-    update_zero_block();
+
+    // The zero block of a new file is written straight away, so that the
+    // block size is known when the file is opened again, even when nothing
+    // else was ever committed:
+    auto buffer = zero_block();
+    if (!write_block(0, buffer))
+        VERIFY_NOT_REACHED();
 }
 
 }
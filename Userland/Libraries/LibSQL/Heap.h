@@ -13,11 +13,25 @@
 #include <LibCore/File.h>
 #include <LibCore/Object.h>
 #include <LibSQL/Meta.h>
+#include <LibSQL/PageCache.h>
 #include <LibSQL/Serialize.h>
+#include <LibThreading/Lock.h>
 
 namespace SQL {
 
-constexpr static u32 BLOCKSIZE = 1024;
+// The size of the blocks of a Heap is chosen when the Heap is created, and
+// is stored in the zero block. It is a power of two between MIN_BLOCK_SIZE
+// and MAX_BLOCK_SIZE.
+constexpr static u32 MIN_BLOCK_SIZE = 1024;
+constexpr static u32 MAX_BLOCK_SIZE = 16384;
+constexpr static u32 DEFAULT_BLOCK_SIZE = 4096;
+// The version of the storage format, stored in the zero block. Version 0.2
+// introduced the compact tuple and B-Tree node encodings, version 0.3 the
+// configurable block size and the free block count.
+constexpr static u32 FORMAT_VERSION = 0x00000003;
+constexpr static size_t DEFAULT_PAGE_CACHE_BUDGET = 4 * MiB;
+constexpr static u32 DEFAULT_SYNC_INTERVAL = 1;
+constexpr static u32 DEFAULT_CHECKPOINT_THRESHOLD = 1000;
 
 /**
  * A Heap is a logical container for database (SQL) data. Conceptually a
@@ -29,18 +43,61 @@ constexpr static u32 BLOCKSIZE = 1024;
  * assumed that a single SQL database is backed by a single Heap.
  *
  * Currently only B-Trees and tuple stores are implemented.
+ *
+ * Blocks read from or written to the backing file are kept in a PageCache,
+ * so that hot blocks don't cost a seek and a read every time they are used.
+ *
+ * Changes are not written to the database file directly. Blocks added
+ * using add_to_wal() are kept in memory until flush() is called. flush()
+ * commits them by appending them as checksummed frames to a write-ahead log
+ * file next to the database file, and fsync's the log before it returns. The
+ * log is copied back into the database file (checkpointed) once it holds
+ * checkpoint_threshold() frames, and when the Heap is closed. When a Heap is
+ * opened, committed transactions found in a leftover log are replayed into
+ * the database file.
+ *
+ * set_sync_interval() relaxes durability for speed: with an interval of N,
+ * the log is only fsync'ed once every N commits, so flush() returns before
+ * its commit is on disk, and a crash can lose up to the last N - 1 commits.
+ * The checksums make sure that what's left is still a consistent database.
+ * The interval is 1 unless it is changed, which makes every commit durable.
+ *
+ * Blocks that are no longer used are returned with free_block(). Free blocks
+ * form a linked list through their first four bytes, with the head of the
+ * list stored in the zero block. new_record_pointer() hands out blocks from
+ * this list before it grows the file.
+ *
+ * snapshot() returns a read-only Heap holding the blocks as they were at the
+ * last commit. Blocks are never overwritten in the log, so a snapshot only
+ * needs a copy of the index of the log, and reads the blocks that aren't in
+ * it from the database file. To keep those intact, the log isn't
+ * checkpointed while snapshots are open, and just keeps growing. Snapshots
+ * can be taken and read on other threads while the Heap is being written,
+ * which is why all reads of the files use pread() instead of seeking.
  */
 class Heap : public Core::Object {
     C_OBJECT(Heap);
 
 public:
-    explicit Heap(String);
-    virtual ~Heap() override { flush(); }
+    explicit Heap(String, u32 block_size = DEFAULT_BLOCK_SIZE);
+    virtual ~Heap() override;
+
+    static bool is_valid_block_size(u32 block_size)
+    {
+        return block_size >= MIN_BLOCK_SIZE && block_size <= MAX_BLOCK_SIZE && (block_size & (block_size - 1)) == 0;
+    }
+
+    NonnullRefPtr<Heap> snapshot();
+    [[nodiscard]] bool is_snapshot() const { return !m_parent.is_null(); }
+    [[nodiscard]] u32 open_snapshots() const;
 
     u32 size() const { return m_end_of_file; }
+    [[nodiscard]] u32 block_size() const { return m_block_size; }
     Result<ByteBuffer, String> read_block(u32);
     bool write_block(u32, ByteBuffer&);
     u32 new_record_pointer();
+    void free_block(u32);
+    [[nodiscard]] u32 free_blocks() const { return m_free_blocks; }
     [[nodiscard]] bool has_block(u32 block) const { return block < size(); }
 
     u32 schemas_root() const { return m_schemas_root; }
@@ -66,6 +123,23 @@ public:
         m_table_columns_root = root;
         update_zero_block();
     }
+
+    u32 indexes_root() const { return m_indexes_root; }
+
+    void set_indexes_root(u32 root)
+    {
+        m_indexes_root = root;
+        update_zero_block();
+    }
+
+    u32 statistics_root() const { return m_statistics_root; }
+
+    void set_statistics_root(u32 root)
+    {
+        m_statistics_root = root;
+        update_zero_block();
+    }
+
     u32 version() const { return m_version; }
 
     u32 user_value(size_t index) const
@@ -81,25 +155,73 @@ public:
         update_zero_block();
     }
 
-    void add_to_wal(u32 block, ByteBuffer& buffer) { m_write_ahead_log.set(block, buffer); }
+    void add_to_wal(u32 block, ByteBuffer& buffer)
+    {
+        VERIFY(!is_snapshot());
+        m_dirty_blocks.set(block, buffer);
+    }
     void flush();
+    bool sync();
+    bool checkpoint();
+
+    String wal_name() const { return String::formatted("{}-wal", name()); }
+    [[nodiscard]] u32 wal_frames() const { return m_wal_frames; }
+    [[nodiscard]] u32 sync_interval() const { return m_sync_interval; }
+    void set_sync_interval(u32 commits) { m_sync_interval = max(commits, 1u); }
+    [[nodiscard]] u32 checkpoint_threshold() const { return m_checkpoint_threshold; }
+    void set_checkpoint_threshold(u32 frames) { m_checkpoint_threshold = frames; }
+
+    PageCache const& page_cache() const { return m_page_cache; }
+    void set_page_cache_budget(size_t budget) { m_page_cache.set_budget(budget); }
+    bool pin_block(u32 block) { return m_page_cache.pin(block); }
+    void unpin_block(u32 block) { m_page_cache.unpin(block); }
+    [[nodiscard]] u64 blocks_read() const { return m_blocks_read; }
+    [[nodiscard]] u64 blocks_written() const { return m_blocks_written; }
 
 private:
+    explicit Heap(Heap& parent);
+
     bool seek_block(u32);
+    bool open_write_ahead_log();
+    void replay_write_ahead_log();
+    Result<ByteBuffer, String> read_frame(u32);
+    [[nodiscard]] size_t wal_frame_size() const;
+    void read_block_size();
     void read_zero_block();
+    ByteBuffer zero_block() const;
     void initialize_zero_block();
     void update_zero_block();
 
     RefPtr<Core::File> m_file;
+    u32 m_block_size { DEFAULT_BLOCK_SIZE };
     u32 m_free_list { 0 };
+    u32 m_free_blocks { 0 };
     u32 m_next_block { 1 };
     u32 m_end_of_file { 1 };
     u32 m_schemas_root { 0 };
     u32 m_tables_root { 0 };
     u32 m_table_columns_root { 0 };
-    u32 m_version { 0x00000001 };
+    u32 m_indexes_root { 0 };
+    u32 m_statistics_root { 0 };
+    u32 m_version { FORMAT_VERSION };
     Array<u32, 16> m_user_values;
-    HashMap<u32, ByteBuffer> m_write_ahead_log;
+    HashMap<u32, ByteBuffer> m_dirty_blocks;
+    RefPtr<Core::File> m_wal_file;
+    HashMap<u32, u32> m_wal_index;
+    u32 m_wal_frames { 0 };
+    u32 m_wal_checksum { 0 };
+    u32 m_unsynced_commits { 0 };
+    u32 m_sync_interval { DEFAULT_SYNC_INTERVAL };
+    u32 m_checkpoint_threshold { DEFAULT_CHECKPOINT_THRESHOLD };
+    PageCache m_page_cache { DEFAULT_PAGE_CACHE_BUDGET, DEFAULT_BLOCK_SIZE };
+    u64 m_blocks_read { 0 };
+    u64 m_blocks_written { 0 };
+
+    // Guards the state snapshots copy from their parent: the log index, the
+    // end of the file, and the number of open snapshots.
+    mutable Threading::Lock m_lock;
+    RefPtr<Heap> m_parent;
+    u32 m_snapshots { 0 };
 };
 
 }
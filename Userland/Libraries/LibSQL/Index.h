@@ -41,6 +41,7 @@ public:
     [[nodiscard]] bool duplicates_allowed() const { return !m_unique; }
     [[nodiscard]] bool unique() const { return m_unique; }
     [[nodiscard]] u32 pointer() const { return m_pointer; }
+    [[nodiscard]] u32 block_size() const { return m_heap.block_size(); }
 
 protected:
     Index(Heap& heap, TupleDescriptor const&, bool unique, u32 pointer);
@@ -50,7 +51,10 @@ protected:
     [[nodiscard]] Heap& heap() { return m_heap; }
     void set_pointer(u32 pointer) { m_pointer = pointer; }
     u32 new_record_pointer() { return m_heap.new_record_pointer(); }
+    void free_block(u32 block) { m_heap.free_block(block); }
     ByteBuffer read_block(u32);
+    bool pin_block(u32 block) { return m_heap.pin_block(block); }
+    void unpin_block(u32 block) { m_heap.unpin_block(block); }
     void add_to_write_ahead_log(IndexNode*);
 
 private:
@@ -66,6 +66,14 @@ Key ColumnDef::make_key(TableDef const& table_def)
     return key;
 }
 
+Key ColumnDef::make_key(IndexDef const& index_def)
+{
+    // The key parts of an index are stored like the columns of a table.
+    Key key(ColumnDef::index_def());
+    key["table_hash"] = index_def.key().hash();
+    return key;
+}
+
 NonnullRefPtr<IndexDef> ColumnDef::index_def()
 {
     NonnullRefPtr<IndexDef> s_index_def = IndexDef::construct("$column", true, 0);
@@ -84,10 +92,11 @@ KeyPartDef::KeyPartDef(IndexDef* index, String name, SQLType sql_type, AST::Orde
 {
 }
 
-IndexDef::IndexDef(TableDef* table, String name, bool unique, u32 pointer)
+IndexDef::IndexDef(TableDef* table, String name, bool unique, u32 pointer, AST::IndexType index_type)
     : Relation(move(name), pointer, table)
     , m_key_definition()
     , m_unique(unique)
+    , m_index_type(index_type)
 {
 }
 
@@ -102,6 +111,13 @@ void IndexDef::append_column(String name, SQLType sql_type, AST::Order sort_orde
     m_key_definition.append(part);
 }
 
+void IndexDef::append_column(Key const& column)
+{
+    append_column(
+        (String)column["column_name"],
+        (SQLType)((int)column["column_type"]));
+}
+
 TupleDescriptor IndexDef::to_tuple_descriptor() const
 {
     TupleDescriptor ret;
@@ -117,6 +133,8 @@ Key IndexDef::key() const
     key["table_hash"] = parent_relation()->key().hash();
     key["index_name"] = name();
     key["unique"] = unique() ? 1 : 0;
+    key["index_type"] = (int)index_type();
+    key.set_pointer(pointer());
     return key;
 }
 
@@ -134,6 +152,7 @@ NonnullRefPtr<IndexDef> IndexDef::index_def()
         s_index_def->append_column("table_hash", SQLType::Integer, AST::Order::Ascending);
         s_index_def->append_column("index_name", SQLType::Text, AST::Order::Ascending);
         s_index_def->append_column("unique", SQLType::Integer, AST::Order::Ascending);
+        s_index_def->append_column("index_type", SQLType::Integer, AST::Order::Ascending);
     }
     return s_index_def;
 }
@@ -176,6 +195,23 @@ void TableDef::append_column(Key const& column)
         (SQLType)((int)column["column_type"]));
 }
 
+void TableDef::append_index(IndexDef& index)
+{
+    VERIFY(index.parent() == this);
+    m_indexes.append(index);
+}
+
+IndexDef& TableDef::append_index(Key const& index)
+{
+    auto index_def = IndexDef::construct(this,
+        (String)index["index_name"],
+        (int)index["unique"] != 0,
+        index.pointer(),
+        (AST::IndexType)((int)index["index_type"]));
+    m_indexes.append(index_def);
+    return *index_def;
+}
+
 Key TableDef::make_key(SchemaDef const& schema_def)
 {
     return TableDef::make_key(schema_def.key());
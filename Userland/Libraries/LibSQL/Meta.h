@@ -77,6 +77,7 @@ public:
     size_t column_number() const { return m_index; }
     static NonnullRefPtr<IndexDef> index_def();
     static Key make_key(TableDef const&);
+    static Key make_key(IndexDef const&);
 
 protected:
     ColumnDef(Relation*, size_t, String, SQLType);
@@ -105,19 +106,22 @@ public:
 
     NonnullRefPtrVector<KeyPartDef> key_definition() const { return m_key_definition; }
     bool unique() const { return m_unique; }
+    AST::IndexType index_type() const { return m_index_type; }
     [[nodiscard]] size_t size() const { return m_key_definition.size(); }
     void append_column(String, SQLType, AST::Order = AST::Order::Ascending);
+    void append_column(Key const&);
     Key key() const override;
     [[nodiscard]] TupleDescriptor to_tuple_descriptor() const;
     static NonnullRefPtr<IndexDef> index_def();
     static Key make_key(TableDef const& table_def);
 
 private:
-    IndexDef(TableDef*, String, bool unique = true, u32 pointer = 0);
+    IndexDef(TableDef*, String, bool unique = true, u32 pointer = 0, AST::IndexType = AST::IndexType::BTree);
     explicit IndexDef(String, bool unique = true, u32 pointer = 0);
 
     NonnullRefPtrVector<KeyPartDef> m_key_definition;
     bool m_unique { false };
+    AST::IndexType m_index_type { AST::IndexType::BTree };
 
     friend TableDef;
 };
@@ -129,6 +133,8 @@ public:
     Key key() const override;
     void append_column(String, SQLType);
     void append_column(Key const&);
+    void append_index(IndexDef&);
+    IndexDef& append_index(Key const&);
     size_t num_columns() { return m_columns.size(); }
     size_t num_indexes() { return m_indexes.size(); }
     NonnullRefPtrVector<ColumnDef> columns() const { return m_columns; }
@@ -0,0 +1,978 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/HashFunctions.h>
+#include <AK/QuickSort.h>
+#include <AK/StringBuilder.h>
+#include <LibSQL/Database.h>
+#include <LibSQL/HashIndex.h>
+#include <LibSQL/Meta.h>
+#include <LibSQL/Operator.h>
+#include <LibSQL/Row.h>
+
+namespace SQL {
+
+static Tuple concatenate(Tuple const& lhs, Tuple const& rhs)
+{
+    Tuple ret;
+    for (auto ix = 0u; ix < lhs.length(); ix++)
+        ret.append(lhs[ix]);
+    for (auto ix = 0u; ix < rhs.length(); ix++)
+        ret.append(rhs[ix]);
+    return ret;
+}
+
+void Operator::set_table_name(String const& table_name)
+{
+    for (auto& column : m_columns)
+        column.table_name = table_name;
+}
+
+void Operator::set_column_names(Vector<String> const& column_names)
+{
+    VERIFY(column_names.size() == m_columns.size());
+    for (auto ix = 0u; ix < m_columns.size(); ix++)
+        m_columns[ix].column_name = column_names[ix];
+}
+
+static void explain(Operator const& op, size_t depth, Vector<String>& lines)
+{
+    StringBuilder builder;
+    for (auto ix = 0u; ix < depth; ix++)
+        builder.append("  ");
+    builder.append(op.name());
+    if (auto details = op.details(); !details.is_empty()) {
+        builder.append(' ');
+        builder.append(details);
+    }
+    if (auto const& estimate = op.estimate(); estimate.has_value())
+        builder.appendff(" (rows={}, cost={})", static_cast<u64>(estimate->rows + 0.5), static_cast<u64>(estimate->cost + 0.5));
+    lines.append(builder.build());
+
+    for (auto* input : op.inputs())
+        explain(*input, depth + 1, lines);
+}
+
+Vector<String> explain(Operator const& op)
+{
+    Vector<String> lines;
+    explain(op, 0, lines);
+    return lines;
+}
+
+static String literal(Value const& value)
+{
+    if (value.is_null())
+        return "NULL";
+    if (value.type() == SQLType::Text)
+        return String::formatted("'{}'", value.to_string().value());
+    return value.to_string().value();
+}
+
+static String describe_table(TableDef const& table, String const& alias)
+{
+    if (alias == table.name())
+        return table.name();
+    return String::formatted("{} AS {}", table.name(), alias);
+}
+
+static String describe_index(IndexDef const& index)
+{
+    return String::formatted("USING {}INDEX {}", (index.index_type() == AST::IndexType::Hash) ? "HASH " : "", index.name());
+}
+
+static Vector<OperatorColumn> table_columns(TableDef const& table, String const& alias)
+{
+    Vector<OperatorColumn> columns;
+    for (auto& column : table.columns())
+        columns.append({ alias, column.name() });
+    return columns;
+}
+
+TableScan::TableScan(Database& database, NonnullRefPtr<TableDef> table, String const& alias)
+    : Operator(table_columns(table, alias))
+    , m_database(database)
+    , m_table(move(table))
+    , m_alias(alias)
+    , m_pointer(m_table->pointer())
+{
+}
+
+String TableScan::details() const
+{
+    return describe_table(m_table, m_alias);
+}
+
+Optional<Tuple> TableScan::next()
+{
+    if (!m_pointer)
+        return {};
+    auto row = m_database->read_row(m_table, m_pointer);
+    m_pointer = row.next_pointer();
+    return Tuple(row);
+}
+
+void TableScan::rewind()
+{
+    m_pointer = m_table->pointer();
+}
+
+IndexLookup::IndexLookup(Database& database, NonnullRefPtr<TableDef> table, String const& alias, NonnullRefPtr<IndexDef> index, Vector<Value> key)
+    : Operator(table_columns(table, alias))
+    , m_database(database)
+    , m_table(move(table))
+    , m_alias(alias)
+    , m_index(move(index))
+    , m_key(move(key))
+{
+    VERIFY(m_index->unique() && m_key.size() == m_index->size());
+}
+
+Optional<Tuple> IndexLookup::next()
+{
+    if (m_done)
+        return {};
+    m_done = true;
+
+    Optional<u32> pointer;
+    if (auto hash_index = m_database->get_hash_index(m_index); hash_index) {
+        Key key(hash_index->descriptor());
+        for (auto ix = 0u; ix < m_key.size(); ix++)
+            key[ix] = m_key[ix];
+        pointer = hash_index->get(key);
+    } else {
+        auto btree = m_database->get_btree(m_index);
+        Key key(btree->descriptor());
+        for (auto ix = 0u; ix < m_key.size(); ix++)
+            key[ix] = m_key[ix];
+        if (auto iterator = btree->find(key); !iterator.is_end())
+            pointer = (*iterator).pointer();
+    }
+    if (!pointer.has_value())
+        return {};
+    return Tuple(m_database->read_row(m_table, pointer.value()));
+}
+
+String IndexLookup::details() const
+{
+    auto key_definition = m_index->key_definition();
+    Vector<String> conditions;
+    for (auto ix = 0u; ix < m_key.size(); ix++)
+        conditions.append(String::formatted("{} = {}", key_definition[ix].name(), literal(m_key[ix])));
+    return String::formatted("{} {} ({})", describe_table(m_table, m_alias), describe_index(m_index), String::join(" AND ", conditions));
+}
+
+IndexRangeScan::IndexRangeScan(Database& database, NonnullRefPtr<TableDef> table, String const& alias, NonnullRefPtr<IndexDef> index, IndexRange range)
+    : Operator(table_columns(table, alias))
+    , m_database(database)
+    , m_table(move(table))
+    , m_alias(alias)
+    , m_index(move(index))
+    , m_btree(m_database->get_btree(m_index))
+    , m_range(move(range))
+{
+    VERIFY(m_btree);
+    VERIFY(m_range.prefix.size() + ((m_range.lower.has_value() || m_range.upper.has_value()) ? 1 : 0) <= m_index->size());
+}
+
+// Builds a key holding the prefix values and the given value for the next key part. Parts
+// without a value are NULL, and are ignored when the key is matched against the index entries.
+Key IndexRangeScan::make_key(Optional<Value> const& next_part) const
+{
+    Key key(m_btree->descriptor());
+    for (auto ix = 0u; ix < m_range.prefix.size(); ix++)
+        key[ix] = m_range.prefix[ix];
+    if (next_part.has_value())
+        key[m_range.prefix.size()] = next_part.value();
+    return key;
+}
+
+void IndexRangeScan::seek()
+{
+    auto lower_key = make_key(m_range.lower);
+    m_iterator = m_btree->lower_bound(lower_key);
+    if (m_range.lower.has_value() && !m_range.lower_inclusive) {
+        while (!m_iterator->is_end() && (**m_iterator).match(lower_key) == 0)
+            ++(*m_iterator);
+    }
+}
+
+Optional<Tuple> IndexRangeScan::next()
+{
+    if (!m_iterator.has_value())
+        seek();
+    auto& iterator = m_iterator.value();
+    if (iterator.is_end())
+        return {};
+
+    auto const& entry = *iterator;
+    if (entry.match(make_key({})) != 0)
+        return {};
+    if (m_range.upper.has_value()) {
+        auto ret = entry.match(make_key(m_range.upper));
+        if (ret > 0 || (ret == 0 && !m_range.upper_inclusive))
+            return {};
+    }
+    auto pointer = entry.pointer();
+    ++iterator;
+    return Tuple(m_database->read_row(m_table, pointer));
+}
+
+String IndexRangeScan::details() const
+{
+    auto key_definition = m_index->key_definition();
+    Vector<String> conditions;
+    for (auto ix = 0u; ix < m_range.prefix.size(); ix++)
+        conditions.append(String::formatted("{} = {}", key_definition[ix].name(), literal(m_range.prefix[ix])));
+    if (m_range.lower.has_value())
+        conditions.append(String::formatted("{} {} {}", key_definition[m_range.prefix.size()].name(), m_range.lower_inclusive ? ">=" : ">", literal(m_range.lower.value())));
+    if (m_range.upper.has_value())
+        conditions.append(String::formatted("{} {} {}", key_definition[m_range.prefix.size()].name(), m_range.upper_inclusive ? "<=" : "<", literal(m_range.upper.value())));
+    if (conditions.is_empty())
+        return String::formatted("{} {}", describe_table(m_table, m_alias), describe_index(m_index));
+    return String::formatted("{} {} ({})", describe_table(m_table, m_alias), describe_index(m_index), String::join(" AND ", conditions));
+}
+
+// Entries with equal values for the leading key parts are sorted on the next key part. So the rows are
+// sorted on the columns of the key parts, up to the first part that is sorted in descending order.
+Vector<size_t> IndexRangeScan::ordering() const
+{
+    Vector<size_t> ordering;
+    auto columns = m_table->columns();
+    for (auto& part : m_index->key_definition()) {
+        if (part.sort_order() != AST::Order::Ascending)
+            break;
+        Optional<size_t> column;
+        for (auto ix = 0u; ix < columns.size(); ix++) {
+            if (columns[ix].name() == part.name()) {
+                column = ix;
+                break;
+            }
+        }
+        if (!column.has_value())
+            break;
+        ordering.append(column.value());
+    }
+    return ordering;
+}
+
+Optional<Tuple> SingleRow::next()
+{
+    if (m_done)
+        return {};
+    m_done = true;
+    return Tuple();
+}
+
+static bool all_true(Evaluator const& evaluator, NonnullRefPtrVector<AST::Expression> const& predicates, Tuple const& tuple)
+{
+    for (auto& predicate : predicates) {
+        if (!evaluator.is_true(predicate, tuple))
+            return false;
+    }
+    return true;
+}
+
+Filter::Filter(NonnullOwnPtr<Operator> input, NonnullRefPtrVector<AST::Expression> predicates, Evaluator evaluator)
+    : Operator(input->columns())
+    , m_input(move(input))
+    , m_predicates(move(predicates))
+    , m_evaluator(move(evaluator))
+{
+}
+
+Optional<Tuple> Filter::next()
+{
+    for (auto tuple = m_input->next(); tuple.has_value(); tuple = m_input->next()) {
+        if (all_true(m_evaluator, m_predicates, tuple.value()))
+            return tuple;
+    }
+    return {};
+}
+
+static Vector<OperatorColumn> join_columns(Operator const& outer, Operator const& inner)
+{
+    Vector<OperatorColumn> columns;
+    columns.extend(outer.columns());
+    columns.extend(inner.columns());
+    return columns;
+}
+
+NestedLoopJoin::NestedLoopJoin(NonnullOwnPtr<Operator> outer, NonnullOwnPtr<Operator> inner, NonnullRefPtrVector<AST::Expression> conditions, Evaluator evaluator)
+    : Operator(join_columns(*outer, *inner))
+    , m_outer(move(outer))
+    , m_inner(move(inner))
+    , m_conditions(move(conditions))
+    , m_evaluator(move(evaluator))
+{
+}
+
+Optional<Tuple> NestedLoopJoin::next()
+{
+    while (true) {
+        if (!m_outer_tuple.has_value()) {
+            m_outer_tuple = m_outer->next();
+            if (!m_outer_tuple.has_value())
+                return {};
+            m_inner->rewind();
+        }
+        for (auto inner_tuple = m_inner->next(); inner_tuple.has_value(); inner_tuple = m_inner->next()) {
+            auto joined = concatenate(m_outer_tuple.value(), inner_tuple.value());
+            if (all_true(m_evaluator, m_conditions, joined))
+                return joined;
+        }
+        m_outer_tuple.clear();
+    }
+}
+
+void NestedLoopJoin::rewind()
+{
+    m_outer->rewind();
+    m_outer_tuple.clear();
+}
+
+static String describe_column(OperatorColumn const& column)
+{
+    if (column.table_name.is_empty())
+        return column.column_name;
+    return String::formatted("{}.{}", column.table_name, column.column_name);
+}
+
+// An estimate of the memory a tuple takes, to keep track of a memory budget.
+static size_t memory_size(Tuple const& tuple)
+{
+    auto size = sizeof(Tuple);
+    for (auto ix = 0u; ix < tuple.length(); ix++)
+        size += sizeof(Value) + tuple[ix].size();
+    return size;
+}
+
+Optional<Tuple> JoinKeys::evaluate(Tuple const& tuple) const
+{
+    Tuple key;
+    for (auto& expression : expressions) {
+        auto value = evaluator.evaluate(expression, tuple);
+        if (value.is_null())
+            return {};
+        key.append(value);
+    }
+    return key;
+}
+
+// A partition that overflows is split this many ways. Partitions at the maximum depth are loaded whatever their size.
+constexpr static u32 hash_join_fan_out = 16;
+constexpr static u32 hash_join_max_depth = 3;
+
+static u32 partition_of(Tuple const& key, u32 level)
+{
+    return pair_int_hash(hash_tuple(key), level) % hash_join_fan_out;
+}
+
+HashJoin::HashJoin(NonnullOwnPtr<Operator> probe, NonnullOwnPtr<Operator> build, JoinKeys probe_keys, JoinKeys build_keys, NonnullRefPtrVector<AST::Expression> conditions, Evaluator evaluator, size_t memory_budget)
+    : Operator(join_columns(*probe, *build))
+    , m_probe(move(probe))
+    , m_build(move(build))
+    , m_probe_keys(move(probe_keys))
+    , m_build_keys(move(build_keys))
+    , m_conditions(move(conditions))
+    , m_evaluator(move(evaluator))
+    , m_memory_budget(memory_budget)
+{
+    VERIFY(!m_probe_keys.expressions.is_empty());
+    VERIFY(m_probe_keys.expressions.size() == m_build_keys.expressions.size());
+}
+
+String HashJoin::details() const
+{
+    auto describe_key = [](JoinKeys const& keys, size_t ix) -> String {
+        auto column = keys.evaluator.column_index(keys.expressions[ix]);
+        if (!column.has_value())
+            return "(expression)";
+        return describe_column(keys.evaluator.columns()[column.value()]);
+    };
+
+    Vector<String> keys;
+    for (auto ix = 0u; ix < m_probe_keys.expressions.size(); ix++)
+        keys.append(String::formatted("{} = {}", describe_key(m_probe_keys, ix), describe_key(m_build_keys, ix)));
+    return String::formatted("ON {}", String::join(" AND ", keys));
+}
+
+// Returns false if the table has grown beyond the memory budget.
+bool HashJoin::add_to_table(Tuple tuple, Tuple key)
+{
+    m_table_size += memory_size(tuple) + memory_size(key);
+    m_table.ensure(hash_tuple(key)).append({ move(key), move(tuple) });
+    return m_table_size <= m_memory_budget;
+}
+
+void HashJoin::clear_table()
+{
+    m_matches = nullptr;
+    m_table.clear();
+    m_table_size = 0;
+}
+
+void HashJoin::build()
+{
+    m_built = true;
+    for (auto tuple = m_build->next(); tuple.has_value(); tuple = m_build->next()) {
+        auto key = m_build_keys.evaluate(tuple.value());
+        if (!key.has_value())
+            continue;
+        if (add_to_table(tuple.release_value(), key.release_value()))
+            continue;
+
+        m_spill_file = SpillFile::create();
+        if (!m_spill_file) {
+            warnln("Could not create a temporary file for a hash join. Joining in memory instead.");
+            m_memory_budget = NumericLimits<size_t>::max();
+            continue;
+        }
+        // The rest of the build input, and all of the probe input, go straight to the partitions:
+        partition([&]() { return m_build->next(); }, [&]() { return m_probe->next(); }, 0);
+        load_next_partition();
+        return;
+    }
+    m_probing_input = true;
+}
+
+// Splits the tuples in the hash table and the tuples from the inputs into partitions, and adds those
+// to the partitions still to be joined.
+void HashJoin::partition(Function<Optional<Tuple>()> const& build_input, Function<Optional<Tuple>()> const& probe_input, u32 level)
+{
+    Vector<Partition> partitions;
+    for (auto ix = 0u; ix < hash_join_fan_out; ix++)
+        partitions.append({ m_spill_file->create_run(), m_spill_file->create_run(), level });
+    m_partitions_created += hash_join_fan_out;
+
+    for (auto& bucket : m_table) {
+        for (auto& entry : bucket.value)
+            m_spill_file->append(partitions[partition_of(entry.key, level)].build_run, entry.tuple);
+    }
+    clear_table();
+    for (auto tuple = build_input(); tuple.has_value(); tuple = build_input()) {
+        if (auto key = m_build_keys.evaluate(tuple.value()); key.has_value())
+            m_spill_file->append(partitions[partition_of(key.value(), level)].build_run, tuple.value());
+    }
+    for (auto tuple = probe_input(); tuple.has_value(); tuple = probe_input()) {
+        if (auto key = m_probe_keys.evaluate(tuple.value()); key.has_value())
+            m_spill_file->append(partitions[partition_of(key.value(), level)].probe_run, tuple.value());
+    }
+
+    // Partitions are taken from the back, so they are added in reverse to be joined in order:
+    for (auto ix = partitions.size(); ix > 0; ix--) {
+        auto& created = partitions[ix - 1];
+        m_spill_file->finish(created.build_run);
+        m_spill_file->finish(created.probe_run);
+        m_partitions.append(created);
+    }
+}
+
+// Reads the build side of the next partition into the hash table, and makes its probe side the input to probe it with.
+bool HashJoin::load_next_partition()
+{
+    if (m_probe_run.has_value())
+        m_spill_file->discard(m_probe_run.release_value());
+
+    while (!m_partitions.is_empty()) {
+        auto current = m_partitions.take_last();
+        clear_table();
+        if (m_spill_file->tuples(current.build_run) == 0 || m_spill_file->tuples(current.probe_run) == 0) {
+            m_spill_file->discard(current.build_run);
+            m_spill_file->discard(current.probe_run);
+            continue;
+        }
+
+        bool fits = true;
+        for (auto tuple = m_spill_file->next(current.build_run); tuple.has_value(); tuple = m_spill_file->next(current.build_run)) {
+            auto key = m_build_keys.evaluate(tuple.value());
+            VERIFY(key.has_value());
+            if (!add_to_table(tuple.release_value(), key.release_value()) && current.level + 1 < hash_join_max_depth) {
+                fits = false;
+                break;
+            }
+        }
+        if (fits) {
+            m_spill_file->discard(current.build_run);
+            m_probe_run = current.probe_run;
+            return true;
+        }
+
+        partition([&]() { return m_spill_file->next(current.build_run); }, [&]() { return m_spill_file->next(current.probe_run); }, current.level + 1);
+        m_spill_file->discard(current.build_run);
+        m_spill_file->discard(current.probe_run);
+    }
+    return false;
+}
+
+Optional<Tuple> HashJoin::next_probe_tuple()
+{
+    if (m_probing_input)
+        return m_probe->next();
+    if (m_probe_run.has_value())
+        return m_spill_file->next(m_probe_run.value());
+    return {};
+}
+
+Optional<Tuple> HashJoin::next()
+{
+    if (!m_built)
+        build();
+
+    while (true) {
+        while (m_matches && m_match_index < m_matches->size()) {
+            auto& entry = m_matches->at(m_match_index++);
+            if (compare_tuples(entry.key, m_probe_key) != 0)
+                continue;
+            auto joined = concatenate(m_probe_tuple.value(), entry.tuple);
+            if (all_true(m_evaluator, m_conditions, joined))
+                return joined;
+        }
+        m_matches = nullptr;
+
+        auto tuple = next_probe_tuple();
+        if (!tuple.has_value()) {
+            m_probing_input = false;
+            if (!load_next_partition())
+                return {};
+            continue;
+        }
+        auto key = m_probe_keys.evaluate(tuple.value());
+        if (!key.has_value())
+            continue;
+        auto bucket = m_table.find(hash_tuple(key.value()));
+        if (bucket == m_table.end())
+            continue;
+        m_probe_tuple = tuple.release_value();
+        m_probe_key = key.release_value();
+        m_matches = &bucket->value;
+        m_match_index = 0;
+    }
+}
+
+void HashJoin::rewind()
+{
+    m_matches = nullptr;
+    m_probe->rewind();
+    if (m_built && !m_spill_file) {
+        m_probing_input = true;
+        return;
+    }
+
+    // The partitions were consumed while joining them, so everything has to be done again:
+    m_build->rewind();
+    clear_table();
+    m_partitions.clear();
+    m_probe_run.clear();
+    m_spill_file = nullptr;
+    m_built = false;
+    m_probing_input = false;
+}
+
+MergeJoin::MergeJoin(NonnullOwnPtr<Operator> left, NonnullOwnPtr<Operator> right, size_t left_column, size_t right_column, NonnullRefPtrVector<AST::Expression> conditions, Evaluator evaluator)
+    : Operator(join_columns(*left, *right))
+    , m_left(move(left))
+    , m_right(move(right))
+    , m_left_column(left_column)
+    , m_right_column(right_column)
+    , m_conditions(move(conditions))
+    , m_evaluator(move(evaluator))
+{
+    VERIFY(m_left_column < m_left->columns().size());
+    VERIFY(m_right_column < m_right->columns().size());
+}
+
+String MergeJoin::details() const
+{
+    return String::formatted("ON {} = {}", describe_column(m_left->columns()[m_left_column]), describe_column(m_right->columns()[m_right_column]));
+}
+
+// NULL keys sort first, but never match anything, so they are skipped.
+Optional<Tuple> MergeJoin::next_left()
+{
+    for (auto tuple = m_left->next(); tuple.has_value(); tuple = m_left->next()) {
+        if (!(*tuple)[m_left_column].is_null())
+            return tuple;
+    }
+    return {};
+}
+
+Optional<Tuple> MergeJoin::next_right()
+{
+    for (auto tuple = m_right->next(); tuple.has_value(); tuple = m_right->next()) {
+        if (!(*tuple)[m_right_column].is_null())
+            return tuple;
+    }
+    return {};
+}
+
+Optional<Tuple> MergeJoin::next()
+{
+    if (!m_started) {
+        m_started = true;
+        m_left_tuple = next_left();
+        m_right_tuple = next_right();
+    }
+
+    while (m_left_tuple.has_value()) {
+        auto& left = m_left_tuple.value();
+
+        // The right tuples with the key of the previous left tuple are kept, for the next left tuples with the same key:
+        if (!m_group.is_empty() && compare_values(left[m_left_column], m_group.first()[m_right_column]) == 0) {
+            while (m_group_index < m_group.size()) {
+                auto joined = concatenate(left, m_group[m_group_index++]);
+                if (all_true(m_evaluator, m_conditions, joined))
+                    return joined;
+            }
+            m_left_tuple = next_left();
+            m_group_index = 0;
+            continue;
+        }
+        m_group.clear();
+        m_group_index = 0;
+
+        if (!m_right_tuple.has_value())
+            return {};
+        auto cmp = compare_values(left[m_left_column], (*m_right_tuple)[m_right_column]);
+        if (cmp < 0) {
+            m_left_tuple = next_left();
+        } else if (cmp > 0) {
+            m_right_tuple = next_right();
+        } else {
+            while (m_right_tuple.has_value() && compare_values((*m_right_tuple)[m_right_column], left[m_left_column]) == 0) {
+                m_group.append(m_right_tuple.release_value());
+                m_right_tuple = next_right();
+            }
+        }
+    }
+    return {};
+}
+
+void MergeJoin::rewind()
+{
+    m_left->rewind();
+    m_right->rewind();
+    m_started = false;
+    m_left_tuple.clear();
+    m_right_tuple.clear();
+    m_group.clear();
+    m_group_index = 0;
+}
+
+Projection::Projection(NonnullOwnPtr<Operator> input, NonnullRefPtrVector<AST::Expression> expressions, Vector<OperatorColumn> columns, Evaluator evaluator)
+    : Operator(move(columns))
+    , m_input(move(input))
+    , m_expressions(move(expressions))
+    , m_evaluator(move(evaluator))
+{
+    VERIFY(m_expressions.size() == this->columns().size());
+}
+
+Optional<Tuple> Projection::next()
+{
+    auto tuple = m_input->next();
+    if (!tuple.has_value())
+        return {};
+    Tuple ret;
+    for (auto& expression : m_expressions)
+        ret.append(m_evaluator.evaluate(expression, tuple.value()));
+    return ret;
+}
+
+Sort::Sort(NonnullOwnPtr<Operator> input, Vector<SortKey> keys, Evaluator evaluator)
+    : Operator(input->columns())
+    , m_input(move(input))
+    , m_keys(move(keys))
+    , m_evaluator(move(evaluator))
+{
+}
+
+void Sort::materialize()
+{
+    Vector<Tuple> sort_keys;
+    for (auto tuple = m_input->next(); tuple.has_value(); tuple = m_input->next()) {
+        Tuple key;
+        for (auto& sort_key : m_keys)
+            key.append(m_evaluator.evaluate(*sort_key.expression, tuple.value()));
+        sort_keys.append(move(key));
+        m_order.append(m_rows.size());
+        m_rows.append(tuple.release_value());
+    }
+
+    // Sort positions rather than the rows themselves, so the rows don't get copied around. Ties are
+    // broken on the input position, which makes the sort stable.
+    quick_sort(m_order, [&](size_t a, size_t b) {
+        for (auto ix = 0u; ix < m_keys.size(); ix++) {
+            auto const& lhs = sort_keys[a][ix];
+            auto const& rhs = sort_keys[b][ix];
+            int ret;
+            if (lhs.is_null() != rhs.is_null())
+                ret = (lhs.is_null() == (m_keys[ix].nulls == AST::Nulls::First)) ? -1 : 1;
+            else if ((ret = compare_values(lhs, rhs)) != 0 && m_keys[ix].order == AST::Order::Descending)
+                ret = -ret;
+            if (ret != 0)
+                return ret < 0;
+        }
+        return a < b;
+    });
+    m_materialized = true;
+}
+
+Optional<Tuple> Sort::next()
+{
+    if (!m_materialized)
+        materialize();
+    if (m_position >= m_order.size())
+        return {};
+    return m_rows[m_order[m_position++]];
+}
+
+Limit::Limit(NonnullOwnPtr<Operator> input, Optional<size_t> limit, size_t offset)
+    : Operator(input->columns())
+    , m_input(move(input))
+    , m_limit(limit)
+    , m_offset(offset)
+{
+}
+
+String Limit::details() const
+{
+    StringBuilder builder;
+    if (m_limit.has_value())
+        builder.appendff("LIMIT {}", m_limit.value());
+    if (m_offset > 0)
+        builder.appendff("{}OFFSET {}", m_limit.has_value() ? " " : "", m_offset);
+    return builder.build();
+}
+
+Optional<Tuple> Limit::next()
+{
+    // Once the limit is reached, stop pulling from the input altogether.
+    if (m_limit.has_value() && m_produced >= m_limit.value())
+        return {};
+    if (!m_skipped) {
+        for (auto ix = 0u; ix < m_offset; ix++) {
+            if (!m_input->next().has_value())
+                break;
+        }
+        m_skipped = true;
+    }
+    auto tuple = m_input->next();
+    if (tuple.has_value())
+        m_produced++;
+    return tuple;
+}
+
+void Limit::rewind()
+{
+    m_input->rewind();
+    m_produced = 0;
+    m_skipped = false;
+}
+
+static Vector<OperatorColumn> aggregate_columns(Operator const& input, NonnullRefPtrVector<AST::Expression> const& group_by, size_t aggregate_count)
+{
+    Vector<OperatorColumn> columns;
+    for (auto& expression : group_by) {
+        // Grouping on a plain column keeps that column's name, so it can still be referenced by name above the aggregation.
+        if (is<AST::ColumnNameExpression>(expression)) {
+            auto& column = static_cast<AST::ColumnNameExpression const&>(expression);
+            String table_name = column.table_name();
+            if (table_name.is_null()) {
+                for (auto& input_column : input.columns()) {
+                    if (input_column.column_name == column.column_name()) {
+                        table_name = input_column.table_name;
+                        break;
+                    }
+                }
+            }
+            columns.append({ table_name, column.column_name() });
+        } else {
+            columns.append({});
+        }
+    }
+    for (auto ix = 0u; ix < aggregate_count; ix++)
+        columns.append({});
+    return columns;
+}
+
+HashAggregate::HashAggregate(NonnullOwnPtr<Operator> input, NonnullRefPtrVector<AST::Expression> group_by, Vector<AST::FunctionCallExpression const*> aggregates, Evaluator evaluator)
+    : Operator(aggregate_columns(*input, group_by, aggregates.size()))
+    , m_input(move(input))
+    , m_group_by(move(group_by))
+    , m_aggregates(move(aggregates))
+    , m_evaluator(move(evaluator))
+{
+}
+
+void HashAggregate::accumulate(AST::FunctionCallExpression const& call, AggregateState& state, Tuple const& tuple)
+{
+    if (call.is_star()) {
+        state.count++;
+        return;
+    }
+
+    auto value = m_evaluator.evaluate(call.arguments().first(), tuple);
+    if (value.is_null())
+        return;
+
+    if (call.is_distinct()) {
+        auto hash = hash_value(value);
+        auto& bucket = state.distinct_values.ensure(hash);
+        for (auto& seen : bucket) {
+            if (values_equal(seen, value))
+                return;
+        }
+        bucket.append(value);
+    }
+
+    state.count++;
+    if (call.name().is_one_of("SUM", "TOTAL", "AVG")) {
+        auto numeric = to_numeric(value);
+        if (numeric.type() == SQLType::Integer) {
+            state.integer_sum += numeric.to_int().value();
+        } else {
+            state.all_integers = false;
+            state.float_sum += numeric.to_double().value();
+        }
+    } else if (call.name().is_one_of("MIN", "MAX")) {
+        if (!state.extreme.has_value()) {
+            state.extreme = value;
+        } else {
+            auto ret = compare_values(value, state.extreme.value());
+            if (call.name() == "MIN" ? ret < 0 : ret > 0)
+                state.extreme = value;
+        }
+    }
+}
+
+Value HashAggregate::finish(AST::FunctionCallExpression const& call, AggregateState const& state) const
+{
+    auto const& name = call.name();
+    if (name == "COUNT")
+        return integer_value(state.count);
+    if (name.is_one_of("MIN", "MAX"))
+        return state.extreme.has_value() ? state.extreme.value() : null_value();
+
+    auto total = static_cast<double>(state.integer_sum) + state.float_sum;
+    if (name == "TOTAL")
+        return float_value(total);
+    if (state.count == 0)
+        return null_value();
+    if (name == "AVG")
+        return float_value(total / static_cast<double>(state.count));
+    VERIFY(name == "SUM");
+    if (state.all_integers)
+        return integer_value(state.integer_sum);
+    return float_value(total);
+}
+
+void HashAggregate::materialize()
+{
+    Vector<Group> groups;
+    HashMap<u32, Vector<size_t>> buckets;
+
+    auto new_group = [&](Tuple key) {
+        groups.append({ move(key), {} });
+        groups.last().states.resize(m_aggregates.size());
+        return groups.size() - 1;
+    };
+
+    if (m_group_by.is_empty())
+        new_group({});
+
+    for (auto tuple = m_input->next(); tuple.has_value(); tuple = m_input->next()) {
+        size_t group_index = 0;
+        if (!m_group_by.is_empty()) {
+            Tuple key;
+            for (auto& expression : m_group_by)
+                key.append(m_evaluator.evaluate(expression, tuple.value()));
+
+            auto& bucket = buckets.ensure(hash_tuple(key));
+            Optional<size_t> found;
+            for (auto candidate : bucket) {
+                if (compare_tuples(groups[candidate].key, key) == 0) {
+                    found = candidate;
+                    break;
+                }
+            }
+            if (!found.has_value()) {
+                found = new_group(move(key));
+                bucket.append(found.value());
+            }
+            group_index = found.value();
+        }
+
+        auto& group = groups[group_index];
+        for (auto ix = 0u; ix < m_aggregates.size(); ix++)
+            accumulate(*m_aggregates[ix], group.states[ix], tuple.value());
+    }
+
+    for (auto& group : groups) {
+        Tuple result;
+        for (auto ix = 0u; ix < group.key.length(); ix++)
+            result.append(group.key[ix]);
+        for (auto ix = 0u; ix < m_aggregates.size(); ix++)
+            result.append(finish(*m_aggregates[ix], group.states[ix]));
+        m_results.append(move(result));
+    }
+    m_materialized = true;
+}
+
+Optional<Tuple> HashAggregate::next()
+{
+    if (!m_materialized)
+        materialize();
+    if (m_position >= m_results.size())
+        return {};
+    return m_results[m_position++];
+}
+
+Distinct::Distinct(NonnullOwnPtr<Operator> input)
+    : Operator(input->columns())
+    , m_input(move(input))
+{
+}
+
+Optional<Tuple> Distinct::next()
+{
+    for (auto tuple = m_input->next(); tuple.has_value(); tuple = m_input->next()) {
+        auto& bucket = m_seen.ensure(hash_tuple(tuple.value()));
+        bool seen = false;
+        for (auto& candidate : bucket) {
+            if (compare_tuples(candidate, tuple.value()) == 0 && candidate.length() == tuple->length()) {
+                seen = true;
+                break;
+            }
+        }
+        if (!seen) {
+            bucket.append(tuple.value());
+            return tuple;
+        }
+    }
+    return {};
+}
+
+void Distinct::rewind()
+{
+    m_input->rewind();
+    m_seen.clear();
+}
+
+Values::Values(Vector<OperatorColumn> columns, Vector<Tuple> tuples)
+    : Operator(move(columns))
+    , m_tuples(move(tuples))
+{
+}
+
+Optional<Tuple> Values::next()
+{
+    if (m_position >= m_tuples.size())
+        return {};
+    return m_tuples[m_position++];
+}
+
+}
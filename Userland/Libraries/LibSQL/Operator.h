@@ -0,0 +1,450 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/NonnullRefPtrVector.h>
+#include <AK/Optional.h>
+#include <AK/String.h>
+#include <AK/Vector.h>
+#include <LibSQL/AST/AST.h>
+#include <LibSQL/BTree.h>
+#include <LibSQL/Evaluator.h>
+#include <LibSQL/Forward.h>
+#include <LibSQL/Key.h>
+#include <LibSQL/SpillFile.h>
+#include <LibSQL/Tuple.h>
+
+namespace SQL {
+
+constexpr static size_t DEFAULT_JOIN_MEMORY_BUDGET = 16 * MiB;
+
+/**
+ * Operators are the nodes of a query execution plan. Every operator produces
+ * a stream of tuples, which the operator above it pulls one at a time by
+ * calling next(). Nothing is computed before it is asked for, so a LIMIT at
+ * the top of a plan stops the table scans at the bottom as soon as it has
+ * seen enough rows. Only Sort and HashAggregate need to see all of their
+ * input, and HashJoin all of its build input, before they can produce their
+ * first tuple.
+ *
+ * rewind() restarts the stream from the beginning. This is what the inner
+ * side of a NestedLoopJoin uses to scan its input once per outer tuple.
+ *
+ * ordering() lists the columns the tuples are known to be sorted on, in
+ * ascending order. A MergeJoin can only be planned on top of inputs that
+ * are sorted on the columns they are joined on.
+ *
+ * name(), details(), inputs() and the planner's estimate describe the plan
+ * for EXPLAIN.
+ */
+class Operator {
+public:
+    struct Estimate {
+        double rows { 0 };
+        double cost { 0 };
+    };
+
+    virtual ~Operator() = default;
+
+    virtual Optional<Tuple> next() = 0;
+    virtual void rewind() = 0;
+    [[nodiscard]] virtual String name() const = 0;
+    [[nodiscard]] virtual String details() const { return {}; }
+    [[nodiscard]] virtual Vector<Operator const*> inputs() const { return {}; }
+    [[nodiscard]] virtual Vector<size_t> ordering() const { return {}; }
+
+    [[nodiscard]] Vector<OperatorColumn> const& columns() const { return m_columns; }
+    void set_table_name(String const&);
+    void set_column_names(Vector<String> const&);
+
+    [[nodiscard]] Optional<Estimate> const& estimate() const { return m_estimate; }
+    void set_estimate(Estimate estimate) { m_estimate = estimate; }
+
+protected:
+    explicit Operator(Vector<OperatorColumn> columns)
+        : m_columns(move(columns))
+    {
+    }
+
+private:
+    Vector<OperatorColumn> m_columns;
+    Optional<Estimate> m_estimate;
+};
+
+Vector<String> explain(Operator const&);
+
+class TableScan final : public Operator {
+public:
+    TableScan(Database&, NonnullRefPtr<TableDef>, String const& alias);
+
+    Optional<Tuple> next() override;
+    void rewind() override;
+    [[nodiscard]] String name() const override { return "TableScan"; }
+    [[nodiscard]] String details() const override;
+
+private:
+    NonnullRefPtr<Database> m_database;
+    NonnullRefPtr<TableDef> m_table;
+    String m_alias;
+    u32 m_pointer { 0 };
+};
+
+/**
+ * An IndexRange selects the entries of an index whose leading key parts are
+ * equal to the prefix values, and whose next key part, if lower or upper are
+ * given, lies within those bounds.
+ */
+struct IndexRange {
+    Vector<Value> prefix;
+    Optional<Value> lower;
+    bool lower_inclusive { true };
+    Optional<Value> upper;
+    bool upper_inclusive { true };
+};
+
+// Produces the row with the given full key of a unique index, if there is one.
+class IndexLookup final : public Operator {
+public:
+    IndexLookup(Database&, NonnullRefPtr<TableDef>, String const& alias, NonnullRefPtr<IndexDef>, Vector<Value> key);
+
+    Optional<Tuple> next() override;
+    void rewind() override { m_done = false; }
+    [[nodiscard]] String name() const override { return "IndexLookup"; }
+    [[nodiscard]] String details() const override;
+
+private:
+    NonnullRefPtr<Database> m_database;
+    NonnullRefPtr<TableDef> m_table;
+    String m_alias;
+    NonnullRefPtr<IndexDef> m_index;
+    Vector<Value> m_key;
+    bool m_done { false };
+};
+
+// Produces the rows in an IndexRange of a B-Tree index, in index order.
+class IndexRangeScan final : public Operator {
+public:
+    IndexRangeScan(Database&, NonnullRefPtr<TableDef>, String const& alias, NonnullRefPtr<IndexDef>, IndexRange);
+
+    Optional<Tuple> next() override;
+    void rewind() override { m_iterator.clear(); }
+    [[nodiscard]] String name() const override { return "IndexRangeScan"; }
+    [[nodiscard]] String details() const override;
+    [[nodiscard]] Vector<size_t> ordering() const override;
+
+private:
+    Key make_key(Optional<Value> const& next_part) const;
+    void seek();
+
+    NonnullRefPtr<Database> m_database;
+    NonnullRefPtr<TableDef> m_table;
+    String m_alias;
+    NonnullRefPtr<IndexDef> m_index;
+    RefPtr<BTree> m_btree;
+    IndexRange m_range;
+    Optional<BTreeIterator> m_iterator;
+};
+
+class SingleRow final : public Operator {
+public:
+    SingleRow()
+        : Operator({})
+    {
+    }
+
+    Optional<Tuple> next() override;
+    void rewind() override { m_done = false; }
+    [[nodiscard]] String name() const override { return "SingleRow"; }
+
+private:
+    bool m_done { false };
+};
+
+class Filter final : public Operator {
+public:
+    Filter(NonnullOwnPtr<Operator>, NonnullRefPtrVector<AST::Expression> predicates, Evaluator);
+
+    Optional<Tuple> next() override;
+    void rewind() override { m_input->rewind(); }
+    [[nodiscard]] String name() const override { return "Filter"; }
+    [[nodiscard]] Vector<Operator const*> inputs() const override { return { m_input.ptr() }; }
+    [[nodiscard]] Vector<size_t> ordering() const override { return m_input->ordering(); }
+
+private:
+    NonnullOwnPtr<Operator> m_input;
+    NonnullRefPtrVector<AST::Expression> m_predicates;
+    Evaluator m_evaluator;
+};
+
+class NestedLoopJoin final : public Operator {
+public:
+    NestedLoopJoin(NonnullOwnPtr<Operator> outer, NonnullOwnPtr<Operator> inner, NonnullRefPtrVector<AST::Expression> conditions, Evaluator);
+
+    Optional<Tuple> next() override;
+    void rewind() override;
+    [[nodiscard]] String name() const override { return "NestedLoopJoin"; }
+    [[nodiscard]] Vector<Operator const*> inputs() const override { return { m_outer.ptr(), m_inner.ptr() }; }
+    [[nodiscard]] Vector<size_t> ordering() const override { return m_outer->ordering(); }
+
+private:
+    NonnullOwnPtr<Operator> m_outer;
+    NonnullOwnPtr<Operator> m_inner;
+    Optional<Tuple> m_outer_tuple;
+    NonnullRefPtrVector<AST::Expression> m_conditions;
+    Evaluator m_evaluator;
+};
+
+// The expressions one input of a join is joined on, bound to the columns of that input.
+struct JoinKeys {
+    NonnullRefPtrVector<AST::Expression> expressions;
+    Evaluator evaluator;
+
+    // The values of the key expressions for a tuple, or nothing if any of them is NULL. NULL never equals anything.
+    Optional<Tuple> evaluate(Tuple const&) const;
+};
+
+/**
+ * HashJoin joins two inputs on the equality of one or more pairs of key
+ * expressions. It reads the build input (the right one) into a hash table,
+ * and then looks up the build tuples matching every tuple of the probe input
+ * (the left one). The other join conditions are applied to the joined tuples.
+ *
+ * When the hash table grows beyond the memory budget, both inputs are split
+ * on the hash of their keys into partitions, which are written to a
+ * SpillFile. Matching partitions are then joined one pair at a time. A
+ * build partition that still doesn't fit is split again using a different
+ * hash, up to a fixed depth. Beyond that, all of its keys are probably the
+ * same, and it is loaded whatever its size.
+ */
+class HashJoin final : public Operator {
+public:
+    HashJoin(NonnullOwnPtr<Operator> probe, NonnullOwnPtr<Operator> build, JoinKeys probe_keys, JoinKeys build_keys, NonnullRefPtrVector<AST::Expression> conditions, Evaluator, size_t memory_budget = DEFAULT_JOIN_MEMORY_BUDGET);
+
+    Optional<Tuple> next() override;
+    void rewind() override;
+    [[nodiscard]] String name() const override { return "HashJoin"; }
+    [[nodiscard]] String details() const override;
+    [[nodiscard]] Vector<Operator const*> inputs() const override { return { m_probe.ptr(), m_build.ptr() }; }
+
+    [[nodiscard]] size_t partitions() const { return m_partitions_created; }
+
+private:
+    struct Entry {
+        Tuple key;
+        Tuple tuple;
+    };
+
+    struct Partition {
+        size_t build_run { 0 };
+        size_t probe_run { 0 };
+        u32 level { 0 };
+    };
+
+    void build();
+    bool add_to_table(Tuple, Tuple key);
+    void clear_table();
+    void partition(Function<Optional<Tuple>()> const& build_input, Function<Optional<Tuple>()> const& probe_input, u32 level);
+    bool load_next_partition();
+    Optional<Tuple> next_probe_tuple();
+
+    NonnullOwnPtr<Operator> m_probe;
+    NonnullOwnPtr<Operator> m_build;
+    JoinKeys m_probe_keys;
+    JoinKeys m_build_keys;
+    NonnullRefPtrVector<AST::Expression> m_conditions;
+    Evaluator m_evaluator;
+    size_t m_memory_budget { DEFAULT_JOIN_MEMORY_BUDGET };
+
+    bool m_built { false };
+    HashMap<u32, Vector<Entry>> m_table;
+    size_t m_table_size { 0 };
+
+    bool m_probing_input { false };
+    Optional<Tuple> m_probe_tuple;
+    Tuple m_probe_key;
+    Vector<Entry> const* m_matches { nullptr };
+    size_t m_match_index { 0 };
+
+    OwnPtr<SpillFile> m_spill_file;
+    Vector<Partition> m_partitions;
+    Optional<size_t> m_probe_run;
+    size_t m_partitions_created { 0 };
+};
+
+/**
+ * MergeJoin joins two inputs that are both sorted on the column they are
+ * joined on, like scans of B-Tree indexes on those columns, by stepping
+ * through them side by side. Only the right tuples with the current key are
+ * held in memory. The other join conditions are applied to the joined
+ * tuples. The output is sorted like the left input.
+ */
+class MergeJoin final : public Operator {
+public:
+    MergeJoin(NonnullOwnPtr<Operator> left, NonnullOwnPtr<Operator> right, size_t left_column, size_t right_column, NonnullRefPtrVector<AST::Expression> conditions, Evaluator);
+
+    Optional<Tuple> next() override;
+    void rewind() override;
+    [[nodiscard]] String name() const override { return "MergeJoin"; }
+    [[nodiscard]] String details() const override;
+    [[nodiscard]] Vector<Operator const*> inputs() const override { return { m_left.ptr(), m_right.ptr() }; }
+    [[nodiscard]] Vector<size_t> ordering() const override { return m_left->ordering(); }
+
+private:
+    Optional<Tuple> next_left();
+    Optional<Tuple> next_right();
+
+    NonnullOwnPtr<Operator> m_left;
+    NonnullOwnPtr<Operator> m_right;
+    size_t m_left_column { 0 };
+    size_t m_right_column { 0 };
+    NonnullRefPtrVector<AST::Expression> m_conditions;
+    Evaluator m_evaluator;
+
+    bool m_started { false };
+    Optional<Tuple> m_left_tuple;
+    Optional<Tuple> m_right_tuple;
+    Vector<Tuple> m_group;
+    size_t m_group_index { 0 };
+};
+
+class Projection final : public Operator {
+public:
+    Projection(NonnullOwnPtr<Operator>, NonnullRefPtrVector<AST::Expression>, Vector<OperatorColumn>, Evaluator);
+
+    Optional<Tuple> next() override;
+    void rewind() override { m_input->rewind(); }
+    [[nodiscard]] String name() const override { return "Projection"; }
+    [[nodiscard]] Vector<Operator const*> inputs() const override { return { m_input.ptr() }; }
+
+private:
+    NonnullOwnPtr<Operator> m_input;
+    NonnullRefPtrVector<AST::Expression> m_expressions;
+    Evaluator m_evaluator;
+};
+
+struct SortKey {
+    NonnullRefPtr<AST::Expression> expression;
+    AST::Order order { AST::Order::Ascending };
+    AST::Nulls nulls { AST::Nulls::First };
+};
+
+class Sort final : public Operator {
+public:
+    Sort(NonnullOwnPtr<Operator>, Vector<SortKey>, Evaluator);
+
+    Optional<Tuple> next() override;
+    void rewind() override { m_position = 0; }
+    [[nodiscard]] String name() const override { return "Sort"; }
+    [[nodiscard]] Vector<Operator const*> inputs() const override { return { m_input.ptr() }; }
+
+private:
+    void materialize();
+
+    NonnullOwnPtr<Operator> m_input;
+    Vector<SortKey> m_keys;
+    Evaluator m_evaluator;
+    bool m_materialized { false };
+    Vector<Tuple> m_rows;
+    Vector<size_t> m_order;
+    size_t m_position { 0 };
+};
+
+class Limit final : public Operator {
+public:
+    Limit(NonnullOwnPtr<Operator>, Optional<size_t> limit, size_t offset);
+
+    Optional<Tuple> next() override;
+    void rewind() override;
+    [[nodiscard]] String name() const override { return "Limit"; }
+    [[nodiscard]] String details() const override;
+    [[nodiscard]] Vector<Operator const*> inputs() const override { return { m_input.ptr() }; }
+    [[nodiscard]] Vector<size_t> ordering() const override { return m_input->ordering(); }
+
+private:
+    NonnullOwnPtr<Operator> m_input;
+    Optional<size_t> m_limit;
+    size_t m_offset { 0 };
+    size_t m_produced { 0 };
+    bool m_skipped { false };
+};
+
+/**
+ * HashAggregate groups its input on the values of the grouping expressions,
+ * and computes aggregate functions over each group. It produces one tuple per
+ * group, holding the grouping values followed by the aggregate values, in
+ * the order the groups were first seen. Without grouping expressions, all
+ * input forms a single group, which exists even if there is no input at all.
+ */
+class HashAggregate final : public Operator {
+public:
+    HashAggregate(NonnullOwnPtr<Operator>, NonnullRefPtrVector<AST::Expression> group_by, Vector<AST::FunctionCallExpression const*> aggregates, Evaluator);
+
+    Optional<Tuple> next() override;
+    void rewind() override { m_position = 0; }
+    [[nodiscard]] String name() const override { return "HashAggregate"; }
+    [[nodiscard]] Vector<Operator const*> inputs() const override { return { m_input.ptr() }; }
+
+private:
+    struct AggregateState {
+        i64 count { 0 };
+        bool all_integers { true };
+        i64 integer_sum { 0 };
+        double float_sum { 0.0 };
+        Optional<Value> extreme;
+        HashMap<u32, Vector<Value>> distinct_values;
+    };
+
+    struct Group {
+        Tuple key;
+        Vector<AggregateState> states;
+    };
+
+    void materialize();
+    void accumulate(AST::FunctionCallExpression const&, AggregateState&, Tuple const&);
+    Value finish(AST::FunctionCallExpression const&, AggregateState const&) const;
+
+    NonnullOwnPtr<Operator> m_input;
+    NonnullRefPtrVector<AST::Expression> m_group_by;
+    Vector<AST::FunctionCallExpression const*> m_aggregates;
+    Evaluator m_evaluator;
+    bool m_materialized { false };
+    Vector<Tuple> m_results;
+    size_t m_position { 0 };
+};
+
+class Distinct final : public Operator {
+public:
+    explicit Distinct(NonnullOwnPtr<Operator>);
+
+    Optional<Tuple> next() override;
+    void rewind() override;
+    [[nodiscard]] String name() const override { return "Distinct"; }
+    [[nodiscard]] Vector<Operator const*> inputs() const override { return { m_input.ptr() }; }
+
+private:
+    NonnullOwnPtr<Operator> m_input;
+    HashMap<u32, Vector<Tuple>> m_seen;
+};
+
+// Produces a fixed list of tuples.
+class Values final : public Operator {
+public:
+    Values(Vector<OperatorColumn>, Vector<Tuple>);
+
+    Optional<Tuple> next() override;
+    void rewind() override { m_position = 0; }
+    [[nodiscard]] String name() const override { return "Values"; }
+
+private:
+    Vector<Tuple> m_tuples;
+    size_t m_position { 0 };
+};
+
+}
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <AK/Format.h>
+#include <LibSQL/PageCache.h>
+
+namespace SQL {
+
+PageCache::PageCache(size_t budget, size_t page_size)
+    : m_budget(budget)
+    , m_page_size(page_size)
+{
+    VERIFY(m_page_size > 0);
+}
+
+Optional<ByteBuffer> PageCache::get(u32 block)
+{
+    auto slot = m_index.get(block);
+    if (!slot.has_value()) {
+        m_misses++;
+        return {};
+    }
+    m_hits++;
+    auto& entry = m_entries[slot.value()];
+    entry.referenced = true;
+    return entry.buffer;
+}
+
+void PageCache::put(u32 block, ByteBuffer const& buffer)
+{
+    if (!capacity())
+        return;
+    auto slot = m_index.get(block);
+    if (slot.has_value()) {
+        auto& entry = m_entries[slot.value()];
+        entry.buffer = buffer;
+        entry.referenced = true;
+        return;
+    }
+    if (m_entries.size() >= capacity()) {
+        auto victim = find_victim();
+        if (!victim.has_value())
+            return;
+        evict(victim.value());
+        m_evictions++;
+    }
+    auto pinned = m_pending_pins.remove(block);
+    if (pinned)
+        m_pinned++;
+    m_index.set(block, m_entries.size());
+    m_entries.append({ block, buffer, true, pinned });
+}
+
+void PageCache::invalidate(u32 block)
+{
+    auto slot = m_index.get(block);
+    if (slot.has_value())
+        evict(slot.value());
+}
+
+bool PageCache::pin(u32 block)
+{
+    auto slot = m_index.get(block);
+    if ((slot.has_value() && m_entries[slot.value()].pinned) || m_pending_pins.contains(block))
+        return true;
+    if (2 * (m_pinned + m_pending_pins.size() + 1) > capacity())
+        return false;
+    dbgln_if(SQL_DEBUG, "Pinning block {} in page cache", block);
+    if (!slot.has_value()) {
+        m_pending_pins.set(block);
+        return true;
+    }
+    m_entries[slot.value()].pinned = true;
+    m_pinned++;
+    return true;
+}
+
+void PageCache::unpin(u32 block)
+{
+    m_pending_pins.remove(block);
+    auto slot = m_index.get(block);
+    if (!slot.has_value())
+        return;
+    auto& entry = m_entries[slot.value()];
+    if (entry.pinned) {
+        entry.pinned = false;
+        m_pinned--;
+    }
+}
+
+void PageCache::clear()
+{
+    m_entries.clear();
+    m_index.clear();
+    m_hand = 0;
+    m_pinned = 0;
+    m_pending_pins.clear();
+}
+
+void PageCache::set_budget(size_t budget)
+{
+    m_budget = budget;
+    while (m_entries.size() > capacity()) {
+        auto victim = find_victim();
+        if (!victim.has_value()) {
+            // Everything that's left is pinned. Give up the pins; the budget
+            // is what the user asked for.
+            for (auto& entry : m_entries)
+                entry.pinned = false;
+            m_pinned = 0;
+            m_pending_pins.clear();
+            continue;
+        }
+        evict(victim.value());
+        m_evictions++;
+    }
+}
+
+Optional<size_t> PageCache::find_victim()
+{
+    if (m_entries.is_empty())
+        return {};
+
+    // Two full sweeps of the clock: the first one clears the referenced
+    // bits, so the second one is guaranteed to find an entry unless all
+    // entries are pinned.
+    for (auto step = 0u; step < 2 * m_entries.size(); step++) {
+        if (m_hand >= m_entries.size())
+            m_hand = 0;
+        auto& entry = m_entries[m_hand];
+        if (!entry.pinned) {
+            if (!entry.referenced)
+                return m_hand;
+            entry.referenced = false;
+        }
+        m_hand++;
+    }
+    return {};
+}
+
+void PageCache::evict(size_t slot)
+{
+    VERIFY(slot < m_entries.size());
+    auto& entry = m_entries[slot];
+    dbgln_if(SQL_DEBUG, "Dropping block {} from page cache", entry.block);
+    if (entry.pinned)
+        m_pinned--;
+    m_index.remove(entry.block);
+
+    // Keep the entries packed by moving the last entry into the freed slot:
+    auto last = m_entries.size() - 1;
+    if (slot != last) {
+        m_entries[slot] = move(m_entries[last]);
+        m_index.set(m_entries[slot].block, slot);
+    }
+    m_entries.take_last();
+}
+
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/HashMap.h>
+#include <AK/HashTable.h>
+#include <AK/Optional.h>
+#include <AK/Vector.h>
+
+namespace SQL {
+
+/**
+ * A PageCache keeps copies of recently used Heap blocks in memory, so that
+ * repeated reads of the same block don't have to go back to the file. The
+ * cache has a budget in bytes. When the budget is exhausted, blocks are
+ * evicted using the CLOCK algorithm, which approximates LRU without having
+ * to reorder a list on every hit.
+ *
+ * Blocks can be pinned. Pinned blocks are never evicted; this is used for
+ * the root and internal nodes of B-Trees, which are touched by every lookup.
+ * At most half of the budget can be pinned, so a big tree can't crowd out
+ * the leaves. A block that isn't cached yet, like a new root that has only
+ * been written to the write-ahead log, is pinned once it is put into the
+ * cache.
+ */
+class PageCache {
+public:
+    explicit PageCache(size_t budget, size_t page_size);
+
+    Optional<ByteBuffer> get(u32 block);
+    void put(u32 block, ByteBuffer const&);
+    void invalidate(u32 block);
+    bool pin(u32 block);
+    void unpin(u32 block);
+    void clear();
+
+    [[nodiscard]] size_t budget() const { return m_budget; }
+    void set_budget(size_t);
+    [[nodiscard]] size_t capacity() const { return m_budget / m_page_size; }
+    [[nodiscard]] size_t size() const { return m_index.size(); }
+    [[nodiscard]] size_t pinned() const { return m_pinned; }
+    [[nodiscard]] u64 hits() const { return m_hits; }
+    [[nodiscard]] u64 misses() const { return m_misses; }
+    [[nodiscard]] u64 evictions() const { return m_evictions; }
+    void reset_statistics() { m_hits = m_misses = m_evictions = 0; }
+
+private:
+    struct Entry {
+        u32 block { 0 };
+        ByteBuffer buffer;
+        bool referenced { false };
+        bool pinned { false };
+    };
+
+    Optional<size_t> find_victim();
+    void evict(size_t slot);
+
+    size_t m_budget;
+    size_t m_page_size;
+    Vector<Entry> m_entries;
+    HashMap<u32, size_t> m_index;
+    size_t m_hand { 0 };
+    size_t m_pinned { 0 };
+    HashTable<u32> m_pending_pins;
+    u64 m_hits { 0 };
+    u64 m_misses { 0 };
+    u64 m_evictions { 0 };
+};
+
+}
@@ -29,18 +29,19 @@ Row::Row(RefPtr<TableDef> table)
 
 Row::Row(RefPtr<TableDef> table, u32 pointer, ByteBuffer& buffer)
     : Tuple(table->to_tuple_descriptor())
+    , m_table(table)
 {
     // FIXME Sanitize constructor situation in Tuple so this can be better
     size_t offset = 0;
     deserialize(buffer, offset);
-    deserialize_from<u32>(buffer, offset, m_next_pointer);
+    deserialize_varint_from(buffer, offset, m_next_pointer);
     set_pointer(pointer);
 }
 
 void Row::serialize(ByteBuffer& buffer) const
 {
     Tuple::serialize(buffer);
-    serialize_to<u32>(buffer, next_pointer());
+    serialize_varint_to(buffer, next_pointer());
 }
 
 void Row::copy_from(Row const& other)
@@ -35,7 +35,7 @@ public:
     void next_pointer(u32 ptr) { m_next_pointer = ptr; }
     RefPtr<TableDef> table() const { return m_table; }
     virtual void serialize(ByteBuffer&) const override;
-    [[nodiscard]] virtual size_t data_length() const override { return Tuple::data_length() + sizeof(u32); }
+    [[nodiscard]] virtual size_t data_length() const override { return Tuple::data_length() + max_varint_length(sizeof(u32)); }
 
 protected:
     void copy_from(Row const&);
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/ByteBuffer.h>
+#include <AK/Span.h>
 #include <string.h>
 
 namespace SQL {
@@ -25,4 +26,101 @@ void serialize_to(ByteBuffer& buffer, T const& t)
     buffer.append(&t, sizeof(T));
 }
 
+// Unsigned integers can be stored as varints: seven bits per byte, least
+// significant bits first, with the high bit set on every byte but the last.
+// Small values, like most row pointers and lengths, take a single byte.
+constexpr size_t max_varint_length(size_t bytes)
+{
+    return (8 * bytes + 6) / 7;
+}
+
+template<typename T>
+void deserialize_varint_from(ByteBuffer& buffer, size_t& at_offset, T& t)
+{
+    static_assert(IsUnsigned<T>);
+    t = 0;
+    for (size_t shift = 0;; shift += 7) {
+        VERIFY(shift < 8 * sizeof(T));
+        auto byte = buffer[at_offset++];
+        t |= static_cast<T>(byte & 0x7f) << shift;
+        if (!(byte & 0x80))
+            return;
+    }
+}
+
+template<typename T>
+void serialize_varint_to(ByteBuffer& buffer, T t)
+{
+    static_assert(IsUnsigned<T>);
+    u8 bytes[max_varint_length(sizeof(T))];
+    size_t length = 0;
+    for (; t >= 0x80; t >>= 7)
+        bytes[length++] = static_cast<u8>(t | 0x80);
+    bytes[length++] = static_cast<u8>(t);
+    buffer.append(bytes, length);
+}
+
+template<typename T>
+constexpr size_t varint_length(T t)
+{
+    static_assert(IsUnsigned<T>);
+    size_t length = 1;
+    for (; t >= 0x80; t >>= 7)
+        length++;
+    return length;
+}
+
+// Signed integers are zigzag encoded first, so that values close to zero
+// have short varints whatever their sign.
+constexpr u32 zigzag_encode(i32 value)
+{
+    return (static_cast<u32>(value) << 1) ^ static_cast<u32>(value >> 31);
+}
+
+constexpr i32 zigzag_decode(u32 value)
+{
+    return static_cast<i32>((value >> 1) ^ (~(value & 1) + 1));
+}
+
+// Sorted keys tend to start with the same bytes as the key before them.
+// A prefix compressed byte string is stored as the number of leading bytes
+// it shares with the previous one, followed by the length and the bytes of
+// the rest.
+inline size_t shared_prefix_length(ReadonlyBytes previous, ReadonlyBytes bytes)
+{
+    size_t length = 0;
+    while (length < previous.size() && length < bytes.size() && previous[length] == bytes[length])
+        length++;
+    return length;
+}
+
+inline size_t prefix_compressed_length(ReadonlyBytes previous, ReadonlyBytes bytes)
+{
+    auto shared = shared_prefix_length(previous, bytes);
+    auto suffix = bytes.size() - shared;
+    return varint_length(shared) + varint_length(suffix) + suffix;
+}
+
+inline void serialize_prefix_compressed_to(ByteBuffer& buffer, ReadonlyBytes previous, ReadonlyBytes bytes)
+{
+    auto shared = shared_prefix_length(previous, bytes);
+    serialize_varint_to(buffer, shared);
+    serialize_varint_to(buffer, bytes.size() - shared);
+    buffer.append(bytes.offset(shared), bytes.size() - shared);
+}
+
+// `bytes` holds the previous byte string when this is called, and is replaced by the next one.
+inline void deserialize_prefix_compressed_from(ByteBuffer& buffer, size_t& at_offset, ByteBuffer& bytes)
+{
+    size_t shared;
+    size_t suffix;
+    deserialize_varint_from(buffer, at_offset, shared);
+    deserialize_varint_from(buffer, at_offset, suffix);
+    VERIFY(shared <= bytes.size());
+    bytes.resize(shared + suffix);
+    if (suffix > 0)
+        bytes.overwrite(shared, buffer.offset_pointer((int)at_offset), suffix);
+    at_offset += suffix;
+}
+
 }
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Format.h>
+#include <LibSQL/Serialize.h>
+#include <LibSQL/SpillFile.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+namespace SQL {
+
+// Runs are written to the file once they have buffered this many bytes. Many
+// runs can be written at the same time, so this is kept smaller than the
+// chunks of an ExternalSorter.
+constexpr static size_t SPILL_CHUNK_SIZE = 32 * KiB;
+
+OwnPtr<SpillFile> SpillFile::create()
+{
+    char path[] = "/tmp/sql-spill-XXXXXX";
+    auto fd = mkstemp(path);
+    if (fd < 0) {
+        perror("mkstemp");
+        return {};
+    }
+    unlink(path);
+    return adopt_own(*new SpillFile(fd));
+}
+
+SpillFile::SpillFile(int fd)
+    : m_fd(fd)
+{
+}
+
+SpillFile::~SpillFile()
+{
+    close(m_fd);
+}
+
+size_t SpillFile::create_run()
+{
+    m_runs.empend();
+    return m_runs.size() - 1;
+}
+
+// A tuple is stored as its serialized length, the number of values, and then
+// every value as a byte holding its type and a NULL flag, followed by the
+// serialized value if it isn't NULL.
+void SpillFile::append(size_t run_index, Tuple const& tuple)
+{
+    auto& run = m_runs[run_index];
+    VERIFY(!run.finished);
+
+    ByteBuffer buffer;
+    serialize_varint_to(buffer, static_cast<u32>(tuple.length()));
+    for (auto ix = 0u; ix < tuple.length(); ix++) {
+        auto& value = tuple[ix];
+        u8 tag = (static_cast<u8>(value.type()) << 1) | (value.is_null() ? 1 : 0);
+        serialize_to(buffer, tag);
+        if (!value.is_null())
+            value.serialize(buffer);
+    }
+    serialize_to<u32>(run.buffer, buffer.size());
+    run.buffer.append(buffer.data(), buffer.size());
+    run.tuples++;
+
+    // A chunk always holds whole tuples, so it can be read back on its own:
+    if (run.buffer.size() >= SPILL_CHUNK_SIZE)
+        write_chunk(run);
+}
+
+void SpillFile::write_chunk(Run& run)
+{
+    if (run.buffer.is_empty())
+        return;
+    size_t written = 0;
+    while (written < run.buffer.size()) {
+        auto rc = pwrite(m_fd, run.buffer.data() + written, run.buffer.size() - written, m_file_size + written);
+        if (rc <= 0) {
+            perror("pwrite");
+            VERIFY_NOT_REACHED();
+        }
+        written += rc;
+    }
+    run.chunks.append({ m_file_size, run.buffer.size() });
+    m_file_size += written;
+    run.buffer.clear();
+}
+
+void SpillFile::finish(size_t run_index)
+{
+    auto& run = m_runs[run_index];
+    VERIFY(!run.finished);
+    write_chunk(run);
+    run.finished = true;
+}
+
+bool SpillFile::read_chunk(Run& run)
+{
+    if (run.next_chunk >= run.chunks.size())
+        return false;
+    auto& chunk = run.chunks[run.next_chunk++];
+    run.buffer.resize(chunk.size);
+    size_t read = 0;
+    while (read < chunk.size) {
+        auto rc = pread(m_fd, run.buffer.data() + read, chunk.size - read, chunk.position + read);
+        if (rc <= 0) {
+            perror("pread");
+            VERIFY_NOT_REACHED();
+        }
+        read += rc;
+    }
+    run.offset = 0;
+    return true;
+}
+
+Optional<Tuple> SpillFile::next(size_t run_index)
+{
+    auto& run = m_runs[run_index];
+    VERIFY(run.finished);
+    if (run.offset >= run.buffer.size() && !read_chunk(run))
+        return {};
+
+    u32 size;
+    deserialize_from<u32>(run.buffer, run.offset, size);
+    auto end = run.offset + size;
+    u32 length;
+    deserialize_varint_from(run.buffer, run.offset, length);
+    Tuple tuple;
+    for (auto ix = 0u; ix < length; ix++) {
+        u8 tag;
+        deserialize_from<u8>(run.buffer, run.offset, tag);
+        auto type = static_cast<SQLType>(tag >> 1);
+        if (tag & 1)
+            tuple.append(Value(type));
+        else
+            tuple.append(Value(type, run.buffer, run.offset));
+    }
+    VERIFY(run.offset == end);
+    return tuple;
+}
+
+// Drops what is left of a run. Its chunks stay in the file, which only shrinks when it is closed.
+void SpillFile::discard(size_t run_index)
+{
+    auto& run = m_runs[run_index];
+    run.chunks.clear();
+    run.buffer.clear();
+    run.offset = 0;
+    run.next_chunk = 0;
+    run.finished = true;
+}
+
+}
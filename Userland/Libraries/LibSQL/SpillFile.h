@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/Noncopyable.h>
+#include <AK/OwnPtr.h>
+#include <AK/Optional.h>
+#include <AK/Types.h>
+#include <AK/Vector.h>
+#include <LibSQL/Tuple.h>
+#include <sys/types.h>
+
+namespace SQL {
+
+/**
+ * A SpillFile holds tuples that don't fit in memory, like the partitions of
+ * a HashJoin that has run out of its memory budget. It is backed by a
+ * temporary file, which is removed right after it is created, so that it
+ * disappears when the SpillFile is destroyed or the process dies.
+ *
+ * The tuples are appended to runs, and several runs can be written at the
+ * same time. A run is buffered in memory and written to the file in chunks,
+ * so a run is a list of chunks which can be anywhere in the file. Once a run
+ * is finished, its tuples can be read back in the order they were appended.
+ *
+ * Tuples are stored with the types of their values, so tuples without a
+ * descriptor, like the ones flowing between Operators, can be spilled.
+ */
+class SpillFile {
+    AK_MAKE_NONCOPYABLE(SpillFile);
+    AK_MAKE_NONMOVABLE(SpillFile);
+
+public:
+    static OwnPtr<SpillFile> create();
+    ~SpillFile();
+
+    size_t create_run();
+    void append(size_t run, Tuple const&);
+    void finish(size_t run);
+    Optional<Tuple> next(size_t run);
+    void discard(size_t run);
+
+    [[nodiscard]] size_t tuples(size_t run) const { return m_runs[run].tuples; }
+    [[nodiscard]] off_t size() const { return m_file_size; }
+
+private:
+    explicit SpillFile(int fd);
+
+    struct Chunk {
+        off_t position { 0 };
+        size_t size { 0 };
+    };
+
+    struct Run {
+        Vector<Chunk> chunks;
+        ByteBuffer buffer;
+        size_t offset { 0 };
+        size_t next_chunk { 0 };
+        size_t tuples { 0 };
+        bool finished { false };
+    };
+
+    void write_chunk(Run&);
+    bool read_chunk(Run&);
+
+    int m_fd { -1 };
+    off_t m_file_size { 0 };
+    Vector<Run> m_runs;
+};
+
+}
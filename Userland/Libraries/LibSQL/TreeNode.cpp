@@ -64,6 +64,11 @@ void DownPointer::inflate()
     auto buffer = m_owner->tree().read_block(m_pointer);
     size_t offset = 0;
     m_node = make<TreeNode>(m_owner->tree(), m_owner, m_pointer, buffer, offset);
+
+    // Internal nodes are visited by every lookup passing through this part
+    // of the tree, so keep them in the page cache:
+    if (!m_node->is_leaf())
+        m_owner->tree().pin_block(m_pointer);
 }
 
 TreeNode::TreeNode(BTree& tree, TreeNode* up, u32 pointer)
@@ -110,27 +115,30 @@ TreeNode::TreeNode(BTree& tree, TreeNode* up, u32 pointer, ByteBuffer& buffer, s
     , m_entries()
     , m_down()
 {
-    u32 nodes;
-    deserialize_from<u32>(buffer, at_offset, nodes);
+    u32 header;
+    deserialize_varint_from(buffer, at_offset, header);
+    auto nodes = header >> 1;
+    // A node without keys is always a leaf, which still has the down pointer to the right of its (absent) keys:
+    m_is_leaf = (header & 1) || nodes == 0;
     dbgln_if(SQL_DEBUG, "Deserializing node. Size {}", nodes);
-    if (nodes > 0) {
-        for (u32 i = 0; i < nodes; i++) {
-            u32 left;
-            deserialize_from<u32>(buffer, at_offset, left);
-            dbgln_if(SQL_DEBUG, "Down[{}] {}", i, left);
-            if (!m_down.is_empty())
-                VERIFY((left == 0) == m_is_leaf);
-            else
-                m_is_leaf = (left == 0);
-            m_entries.append(Key(m_tree.descriptor(), buffer, at_offset));
-            m_down.empend(this, left);
-        }
-        u32 right;
-        deserialize_from<u32>(buffer, at_offset, right);
-        dbgln_if(SQL_DEBUG, "Right {}", right);
-        VERIFY((right == 0) == m_is_leaf);
-        m_down.empend(this, right);
+    ByteBuffer entry;
+    for (u32 i = 0; i < nodes; i++) {
+        u32 left = 0;
+        if (!m_is_leaf)
+            deserialize_varint_from(buffer, at_offset, left);
+        dbgln_if(SQL_DEBUG, "Down[{}] {}", i, left);
+        VERIFY((left == 0) == m_is_leaf);
+        deserialize_prefix_compressed_from(buffer, at_offset, entry);
+        size_t entry_offset = 0;
+        m_entries.append(Key(m_tree.descriptor(), entry, entry_offset));
+        m_down.empend(this, left);
     }
+    u32 right = 0;
+    if (!m_is_leaf)
+        deserialize_varint_from(buffer, at_offset, right);
+    dbgln_if(SQL_DEBUG, "Right {}", right);
+    VERIFY((right == 0) == m_is_leaf);
+    m_down.empend(this, right);
 }
 
 bool TreeNode::insert(Key const& key)
@@ -141,13 +149,47 @@ bool TreeNode::insert(Key const& key)
     return insert_in_leaf(key);
 }
 
+bool TreeNode::remove(Key const& key)
+{
+    dbgln_if(SQL_DEBUG, "[#{}] REMOVE({})", pointer(), key.to_string());
+    for (auto ix = 0u; ix < size(); ix++) {
+        if (key < m_entries[ix]) {
+            if (is_leaf())
+                return false;
+            return down_node(ix)->remove(key);
+        }
+        if (key != m_entries[ix])
+            continue;
+        if (is_leaf()) {
+            m_entries.remove(ix);
+            m_down.remove(ix + 1);
+            rebalance();
+            return true;
+        }
+
+        // The key is replaced by its predecessor, the last key of the rightmost leaf to its left. That
+        // leaf then lost a key, so it is the node that may have to be rebalanced:
+        auto* leaf = down_node(ix);
+        while (!leaf->is_leaf())
+            leaf = leaf->down_node(leaf->size());
+        m_entries[ix] = leaf->m_entries.take_last();
+        leaf->m_down.take_last();
+        write_or_split();
+        leaf->rebalance();
+        return true;
+    }
+    if (is_leaf())
+        return false;
+    return down_node(size())->remove(key);
+}
+
 bool TreeNode::update_key_pointer(Key const& key)
 {
     dbgln_if(SQL_DEBUG, "[#{}] UPDATE({}, {})", pointer(), key.to_string(), key.pointer());
-    if (!is_leaf())
-        return node_for(key)->update_key_pointer(key);
-
     for (auto ix = 0u; ix < size(); ix++) {
+        // Keys are not only stored in the leaves, so the key can be in this node:
+        if (!is_leaf() && key < m_entries[ix])
+            return down_node(ix)->update_key_pointer(key);
         if (key == m_entries[ix]) {
             dbgln_if(SQL_DEBUG, "[#{}] {} == {}",
                 pointer(), key.to_string(), m_entries[ix].to_string());
@@ -159,6 +201,8 @@ bool TreeNode::update_key_pointer(Key const& key)
             return true;
         }
     }
+    if (!is_leaf())
+        return down_node(size())->update_key_pointer(key);
     return false;
 }
 
@@ -179,14 +223,44 @@ bool TreeNode::insert_in_leaf(Key const& key)
     return true;
 }
 
-size_t TreeNode::max_keys_in_node()
+size_t TreeNode::length() const
+{
+    ByteBuffer buffer;
+    serialize(buffer);
+    return buffer.size();
+}
+
+// Keys take a variable number of bytes, so a node is full when it doesn't fit
+// in its block anymore, rather than when it holds a fixed number of keys. A
+// node needs at least three keys to be split, because both halves keep at
+// least one of them when the median moves up.
+bool TreeNode::is_overfull() const
+{
+    return size() >= 3 && length() > m_tree.block_size();
+}
+
+bool TreeNode::is_underfull() const
 {
-    auto descriptor = m_tree.descriptor();
-    auto key_size = descriptor.data_length() + sizeof(u32);
-    auto ret = (BLOCKSIZE - 2 * sizeof(u32)) / key_size;
-    if ((ret % 2) == 0)
-        --ret;
-    return ret;
+    return size() == 0 || length() < m_tree.block_size() / 4;
+}
+
+size_t TreeNode::child_index(TreeNode const* child) const
+{
+    for (auto ix = 0u; ix < m_down.size(); ix++) {
+        if (m_down[ix].m_node.ptr() == child)
+            return ix;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+void TreeNode::write_or_split()
+{
+    if (is_overfull()) {
+        split();
+    } else {
+        dump_if(SQL_DEBUG, "To WAL");
+        tree().add_to_write_ahead_log(this);
+    }
 }
 
 Key const& TreeNode::operator[](size_t ix) const
@@ -249,8 +323,9 @@ Optional<u32> TreeNode::get(Key& key)
         }
     }
     if (m_entries.is_empty()) {
-        dbgln_if(SQL_DEBUG, "[#{}] {} Empty node??", pointer(), key.to_string());
-        VERIFY_NOT_REACHED();
+        // Only the root of an empty tree has no keys:
+        VERIFY(is_leaf() && !m_up);
+        return {};
     }
     if (is_leaf()) {
         dbgln_if(SQL_DEBUG, "[#{}] {} > {} -> 0",
@@ -263,20 +338,26 @@ Optional<u32> TreeNode::get(Key& key)
     return down_node(size())->get(key);
 }
 
+// A node is serialized as a varint holding its number of keys and a leaf
+// flag, followed by its keys in order, each prefix compressed against the
+// one before it. Internal nodes store their down pointers as varints in
+// between the keys. Leaves don't store them, as they are all 0.
 void TreeNode::serialize(ByteBuffer& buffer) const
 {
-    u32 sz = size();
-    serialize_to<u32>(buffer, sz);
-    if (sz > 0) {
-        for (auto ix = 0u; ix < size(); ix++) {
-            auto& entry = m_entries[ix];
-            dbgln_if(SQL_DEBUG, "Serializing Left[{}] = {}", ix, m_down[ix].pointer());
-            serialize_to<u32>(buffer, is_leaf() ? 0u : m_down[ix].pointer());
-            entry.serialize(buffer);
-        }
-        dbgln_if(SQL_DEBUG, "Serializing Right = {}", m_down[size()].pointer());
-        serialize_to<u32>(buffer, is_leaf() ? 0u : m_down[size()].pointer());
+    serialize_varint_to(buffer, static_cast<u32>((size() << 1) | (is_leaf() ? 1 : 0)));
+    ByteBuffer previous;
+    for (auto ix = 0u; ix < size(); ix++) {
+        dbgln_if(SQL_DEBUG, "Serializing Left[{}] = {}", ix, m_down[ix].pointer());
+        if (!is_leaf())
+            serialize_varint_to(buffer, m_down[ix].pointer());
+        ByteBuffer entry;
+        m_entries[ix].serialize(entry);
+        serialize_prefix_compressed_to(buffer, previous, entry);
+        previous = move(entry);
     }
+    dbgln_if(SQL_DEBUG, "Serializing Right = {}", m_down[size()].pointer());
+    if (!is_leaf())
+        serialize_varint_to(buffer, m_down[size()].pointer());
 }
 
 void TreeNode::just_insert(Key const& key, TreeNode* right)
@@ -289,24 +370,13 @@ void TreeNode::just_insert(Key const& key, TreeNode* right)
             m_entries.insert(ix, key);
             VERIFY(is_leaf() == (right == nullptr));
             m_down.insert(ix + 1, DownPointer(this, right));
-            if (size() > max_keys_in_node()) {
-                split();
-            } else {
-                dump_if(SQL_DEBUG, "To WAL");
-                tree().add_to_write_ahead_log(this);
-            }
+            write_or_split();
             return;
         }
     }
     m_entries.append(key);
     m_down.empend(this, right);
-
-    if (size() > max_keys_in_node()) {
-        split();
-    } else {
-        dump_if(SQL_DEBUG, "To WAL");
-        tree().add_to_write_ahead_log(this);
-    }
+    write_or_split();
 }
 
 void TreeNode::split()
@@ -316,16 +386,18 @@ void TreeNode::split()
         // Make new m_up. This is the new root node.
         m_up = m_tree.new_root();
 
+    auto split_index = size() / 2 + 1;
+
     // Take the left pointer for the new node:
-    DownPointer left = m_down.take(max_keys_in_node() / 2 + 1);
+    DownPointer left = m_down.take(split_index);
 
     // Create the new right node:
     auto* new_node = new TreeNode(tree(), m_up, left);
 
     // Move the rightmost keys from this node to the new right node:
-    while (m_entries.size() > max_keys_in_node() / 2 + 1) {
-        auto entry = m_entries.take(max_keys_in_node() / 2 + 1);
-        auto down = m_down.take(max_keys_in_node() / 2 + 1);
+    while (m_entries.size() > split_index) {
+        auto entry = m_entries.take(split_index);
+        auto down = m_down.take(split_index);
 
         // Reparent to new right node:
         if (down.m_node != nullptr) {
@@ -343,10 +415,91 @@ void TreeNode::split()
     tree().add_to_write_ahead_log(this);
     new_node->dump_if(SQL_DEBUG, "Split Right to WAL");
     tree().add_to_write_ahead_log(new_node);
+    if (!new_node->is_leaf())
+        tree().pin_block(new_node->pointer());
 
     m_up->just_insert(median, new_node);
 }
 
+// Called after a key was taken out of this node. A node that has become
+// underfull is merged with its right sibling, or with its left sibling if it
+// is the rightmost child of its parent. Merging pulls the key separating the
+// two nodes down from the parent, which then may have to be rebalanced in
+// turn. If the two nodes don't fit in a single block, an empty node takes
+// the separator from the parent instead, and the nearest key of the sibling
+// replaces it.
+void TreeNode::rebalance()
+{
+    if (!m_up) {
+        if (!is_leaf() && size() == 0) {
+            tree().collapse_root();
+            return;
+        }
+        dump_if(SQL_DEBUG, "To WAL");
+        tree().add_to_write_ahead_log(this);
+        return;
+    }
+    if (!is_underfull()) {
+        dump_if(SQL_DEBUG, "To WAL");
+        tree().add_to_write_ahead_log(this);
+        return;
+    }
+
+    auto* parent = m_up;
+    auto ix = parent->child_index(this);
+    auto separator_index = (ix < parent->size()) ? ix : ix - 1;
+    auto* left = parent->down_node(separator_index);
+    auto* right = parent->down_node(separator_index + 1);
+    auto& separator = parent->m_entries[separator_index];
+
+    ByteBuffer encoded_separator;
+    separator.serialize(encoded_separator);
+    if (left->length() + right->length() + encoded_separator.size() + max_varint_length(sizeof(u32)) <= tree().block_size()) {
+        dump_if(SQL_DEBUG, String::formatted("Merging #{} and #{}", left->pointer(), right->pointer()));
+        left->m_entries.append(separator);
+        for (auto& entry : right->m_entries)
+            left->m_entries.append(entry);
+        for (auto& down : right->m_down) {
+            if (down.m_node != nullptr)
+                down.m_node->m_up = left;
+            left->m_down.append(DownPointer(left, down));
+        }
+        tree().add_to_write_ahead_log(left);
+
+        // Dropping the down pointer to the right node destroys it, which may be this node:
+        tree().free_block(right->pointer());
+        parent->m_entries.remove(separator_index);
+        parent->m_down.remove(separator_index + 1);
+        parent->rebalance();
+        return;
+    }
+
+    if (size() == 0) {
+        if (this == left) {
+            m_entries.append(separator);
+            auto down = right->m_down.take_first();
+            if (down.m_node != nullptr)
+                down.m_node->m_up = this;
+            m_down.append(DownPointer(this, down));
+            separator = right->m_entries.take_first();
+        } else {
+            m_entries.prepend(separator);
+            auto down = left->m_down.take_last();
+            if (down.m_node != nullptr)
+                down.m_node->m_up = this;
+            m_down.prepend(DownPointer(this, down));
+            separator = left->m_entries.take_last();
+        }
+        tree().add_to_write_ahead_log(left);
+        tree().add_to_write_ahead_log(right);
+        parent->write_or_split();
+        return;
+    }
+
+    dump_if(SQL_DEBUG, "To WAL");
+    tree().add_to_write_ahead_log(this);
+}
+
 void TreeNode::dump_if(int flag, String&& msg)
 {
     if (!flag)
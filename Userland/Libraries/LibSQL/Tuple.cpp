@@ -44,23 +44,37 @@ Tuple::Tuple(TupleDescriptor const& descriptor, ByteBuffer& buffer)
     deserialize(buffer, offset);
 }
 
+// A tuple is serialized as a bitmap with a bit set for every NULL value,
+// followed by the values that are not NULL, and the pointer as a varint.
+// The pointer comes last, so that the serialized forms of keys that sort
+// next to each other start with the same bytes.
 void Tuple::deserialize(ByteBuffer& buffer, size_t& offset)
 {
     dbgln_if(SQL_DEBUG, "deserialize tuple at offset {}", offset);
-    deserialize_from<u32>(buffer, offset, m_pointer);
-    dbgln_if(SQL_DEBUG, "pointer: {}", m_pointer);
+    auto null_bitmap = offset;
+    offset += null_bitmap_length();
     m_data.clear();
-    for (auto& part : m_descriptor) {
+    for (auto ix = 0u; ix < m_descriptor.size(); ix++) {
+        auto& part = m_descriptor[ix];
+        if (buffer[null_bitmap + ix / 8] & (1 << (ix % 8))) {
+            m_data.append(Value(part.type));
+            dbgln_if(SQL_DEBUG, "Deserialized element {} = (null)", part.name);
+            continue;
+        }
         m_data.append(Value(part.type, buffer, offset));
         dbgln_if(SQL_DEBUG, "Deserialized element {} = {}", part.name, m_data.last().to_string().value());
     }
+    deserialize_varint_from(buffer, offset, m_pointer);
+    dbgln_if(SQL_DEBUG, "pointer: {}", m_pointer);
 }
 
 void Tuple::serialize(ByteBuffer& buffer) const
 {
     VERIFY(m_descriptor.size() == m_data.size());
     dbgln_if(SQL_DEBUG, "Serializing tuple pointer {}", pointer());
-    serialize_to<u32>(buffer, pointer());
+    auto null_bitmap = buffer.size();
+    buffer.resize(null_bitmap + null_bitmap_length());
+    memset(buffer.offset_pointer((int)null_bitmap), 0, null_bitmap_length());
     for (auto ix = 0u; ix < m_descriptor.size(); ix++) {
         auto& key_part = m_data[ix];
         if constexpr (SQL_DEBUG) {
@@ -68,8 +82,13 @@ void Tuple::serialize(ByteBuffer& buffer) const
             auto& key_part_definition = m_descriptor[ix];
             dbgln("Serialized part {} = {}", key_part_definition.name, (str_opt.has_value()) ? str_opt.value() : "(null)");
         }
+        if (key_part.is_null()) {
+            buffer[null_bitmap + ix / 8] |= 1 << (ix % 8);
+            continue;
+        }
         key_part.serialize(buffer);
     }
+    serialize_varint_to(buffer, pointer());
 }
 
 Tuple::Tuple(Tuple const& other)
@@ -65,7 +65,7 @@ public:
     void set_pointer(u32 ptr) { m_pointer = ptr; }
 
     [[nodiscard]] size_t size() const;
-    [[nodiscard]] size_t length() const { return m_descriptor.size(); }
+    [[nodiscard]] size_t length() const { return m_data.size(); }
     [[nodiscard]] TupleDescriptor descriptor() const { return m_descriptor; }
     [[nodiscard]] int compare(Tuple const&) const;
     [[nodiscard]] int match(Tuple const&) const;
@@ -79,6 +79,8 @@ protected:
     void deserialize(ByteBuffer&, size_t&);
 
 private:
+    [[nodiscard]] size_t null_bitmap_length() const { return (m_descriptor.size() + 7) / 8; }
+
     TupleDescriptor m_descriptor;
     Vector<Value> m_data;
     u32 m_pointer { 0 };
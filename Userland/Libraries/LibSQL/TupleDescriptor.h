@@ -8,6 +8,7 @@
 
 #include <AK/Vector.h>
 #include <LibSQL/AST/AST.h>
+#include <LibSQL/Serialize.h>
 #include <LibSQL/Type.h>
 
 namespace SQL {
@@ -26,9 +27,11 @@ public:
     TupleDescriptor(TupleDescriptor const&) = default;
     ~TupleDescriptor() = default;
 
+    // The maximum number of bytes a tuple with this descriptor takes when it
+    // is serialized: the NULL bitmap, the values, and the pointer.
     [[nodiscard]] size_t data_length() const
     {
-        size_t sz = sizeof(u32);
+        size_t sz = (size() + 7) / 8 + max_varint_length(sizeof(u32));
         for (auto& part : *this) {
             sz += size_of(part.type);
         }
@@ -11,9 +11,12 @@
 
 namespace SQL {
 
-#define ENUMERATE_SQL_TYPES(S)                   \
-    S("text", 0, Text, String, 64 + sizeof(int)) \
-    S("int", 1, Integer, int, sizeof(int))       \
+// The last column is the maximum number of bytes a value of the type takes
+// when it is serialized: a text value is stored as a one byte length and at
+// most 63 characters, and an integer as a varint of up to five bytes.
+#define ENUMERATE_SQL_TYPES(S)             \
+    S("text", 0, Text, String, 64)         \
+    S("int", 1, Integer, int, 5)           \
     S("float", 2, Float, double, sizeof(double))
 
 enum class SQLType {
@@ -4,8 +4,10 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibSQL/Serialize.h>
 #include <LibSQL/Value.h>
 #include <cstring>
+#include <math.h>
 
 namespace SQL {
 
@@ -100,6 +102,16 @@ Value::operator String() const
     return str.value();
 }
 
+// NULL sorts before any other value.
+int Value::compare(Value const& other) const
+{
+    if (is_null())
+        return other.is_null() ? 0 : -1;
+    if (other.is_null())
+        return 1;
+    return m_compare(other);
+}
+
 Optional<int> Value::to_int() const
 {
     if (!m_is_null) {
@@ -197,24 +209,20 @@ void Value::setup_text()
 {
     m_impl = String("");
     m_type_name = []() { return "Text"; };
-    m_size = []() { return 64 + sizeof(int); };
+    m_size = []() { return size_of(SQLType::Text); };
 
     m_deserialize = [&](ByteBuffer& buffer, size_t& at_offset) {
-        int len;
-        memcpy(&len, buffer.offset_pointer((int)at_offset), sizeof(int));
-        at_offset += sizeof(int);
-        m_impl = String((const char*)buffer.offset_pointer((int)at_offset));
-        at_offset += 64;
+        size_t len;
+        deserialize_varint_from(buffer, at_offset, len);
+        m_impl = String((const char*)buffer.offset_pointer((int)at_offset), len);
+        at_offset += len;
     };
 
+    // Text is stored without padding, and is truncated to 63 characters:
     m_serialize = [&](ByteBuffer& buffer) {
-        char zeroes[64];
-
-        int len = min((int)m_impl.get<String>().length(), 63);
-        buffer.append(&len, sizeof(int));
+        auto len = min(m_impl.get<String>().length(), static_cast<size_t>(63));
+        serialize_varint_to(buffer, len);
         buffer.append(m_impl.get<String>().characters(), len);
-        memset(zeroes, 0, 64);
-        buffer.append(zeroes, 64 - len);
     };
 
     m_assign_value = [&](Value const& other) {
@@ -277,15 +285,16 @@ void Value::setup_int()
 {
     m_impl.set<int>(0);
     m_type_name = []() { return "Integer"; };
-    m_size = []() { return sizeof(int); };
+    m_size = []() { return size_of(SQLType::Integer); };
 
     m_deserialize = [&](ByteBuffer& buffer, size_t& at_offset) {
-        memcpy(m_impl.get_pointer<int>(), buffer.offset_pointer((int)at_offset), sizeof(int));
-        at_offset += sizeof(int);
+        u32 encoded;
+        deserialize_varint_from(buffer, at_offset, encoded);
+        m_impl.set<int>(zigzag_decode(encoded));
     };
 
     m_serialize = [&](ByteBuffer& buffer) {
-        buffer.append(m_impl.get_pointer<int>(), sizeof(int));
+        serialize_varint_to(buffer, zigzag_encode(m_impl.get<int>()));
     };
 
     m_assign_value = [&](Value const& other) {
@@ -327,7 +336,11 @@ void Value::setup_int()
         if (!casted.has_value()) {
             return 1;
         }
-        return m_impl.get<int>() - casted.value();
+        // Not a subtraction, which overflows for values far apart:
+        auto value = m_impl.get<int>();
+        if (value == casted.value())
+            return 0;
+        return (value < casted.value()) ? -1 : 1;
     };
 
     m_can_cast = [](Value const& other) -> bool {
@@ -344,7 +357,7 @@ void Value::setup_float()
 {
     m_impl.set<double>(0.0);
     m_type_name = []() { return "Float"; };
-    m_size = []() { return sizeof(double); };
+    m_size = []() { return size_of(SQLType::Float); };
 
     m_deserialize = [&](ByteBuffer& buffer, size_t& at_offset) {
         memcpy(m_impl.get_pointer<double>(), buffer.offset_pointer((int)at_offset), sizeof(double));
@@ -396,7 +409,7 @@ void Value::setup_float()
             return 1;
         }
         auto diff = m_impl.get<double>() - casted.value();
-        return (diff < NumericLimits<double>::epsilon()) ? 0 : ((diff > 0) ? 1 : -1);
+        return (fabs(diff) < NumericLimits<double>::epsilon()) ? 0 : ((diff > 0) ? 1 : -1);
     };
 
     m_can_cast = [](Value const& other) -> bool {
@@ -57,20 +57,20 @@ public:
     [[nodiscard]] SQLType type() const { return m_type; }
     [[nodiscard]] const char* type_name() const { return m_type_name(); }
     [[nodiscard]] size_t size() const { return m_size(); }
-    [[nodiscard]] int compare(Value const& other) const { return m_compare(other); }
+    [[nodiscard]] int compare(Value const& other) const;
     [[nodiscard]] bool is_null() const { return m_is_null; }
     [[nodiscard]] bool can_cast(Value const&) const;
     [[nodiscard]] u32 hash() const { return (is_null()) ? 0 : m_hash(); }
 
-    bool operator==(Value const& other) const { return m_compare(other) == 0; }
+    bool operator==(Value const& other) const { return compare(other) == 0; }
     bool operator==(String const& other) const;
     bool operator==(int other) const;
     bool operator==(double other) const;
-    bool operator!=(Value const& other) const { return m_compare(other) != 0; }
-    bool operator<(Value const& other) const { return m_compare(other) < 0; }
-    bool operator<=(Value const& other) const { return m_compare(other) <= 0; }
-    bool operator>(Value const& other) const { return m_compare(other) > 0; }
-    bool operator>=(Value const& other) const { return m_compare(other) >= 0; }
+    bool operator!=(Value const& other) const { return compare(other) != 0; }
+    bool operator<(Value const& other) const { return compare(other) < 0; }
+    bool operator<=(Value const& other) const { return compare(other) <= 0; }
+    bool operator>(Value const& other) const { return compare(other) > 0; }
+    bool operator>=(Value const& other) const { return compare(other) >= 0; }
 
     void serialize(ByteBuffer& buffer) const
     {
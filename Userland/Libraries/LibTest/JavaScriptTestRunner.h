@@ -109,6 +109,7 @@ extern RefPtr<JS::VM> g_vm;
 extern bool g_collect_on_every_allocation;
 extern bool g_run_bytecode;
 extern bool g_dump_bytecode;
+extern bool g_parse_functions_lazily;
 extern String g_currently_running_test;
 struct FunctionWithLength {
     JS::Value (*function)(JS::VM&, JS::GlobalObject&);
@@ -204,6 +205,7 @@ inline AK::Result<NonnullRefPtr<JS::Program>, ParserError> parse_file(const Stri
     file->close();
 
     auto parser = JS::Parser(JS::Lexer(test_file_string));
+    parser.set_parses_functions_lazily(g_parse_functions_lazily);
     auto program = parser.parse_program();
 
     if (parser.has_errors()) {
@@ -306,14 +308,8 @@ inline JSFileResult TestRunner::run_file_test(const String& test_path)
 
     if (g_run_bytecode) {
         auto unit = JS::Bytecode::Generator::generate(*m_test_program);
-        if (g_dump_bytecode) {
-            for (auto& block : unit.basic_blocks)
-                block.dump(unit);
-            if (!unit.string_table->is_empty()) {
-                outln();
-                unit.string_table->dump();
-            }
-        }
+        if (g_dump_bytecode)
+            unit.dump();
 
         JS::Bytecode::Interpreter bytecode_interpreter(interpreter->global_object());
         bytecode_interpreter.run(unit);
@@ -328,14 +324,8 @@ inline JSFileResult TestRunner::run_file_test(const String& test_path)
         return { test_path, file_program.error() };
     if (g_run_bytecode) {
         auto unit = JS::Bytecode::Generator::generate(*file_program.value());
-        if (g_dump_bytecode) {
-            for (auto& block : unit.basic_blocks)
-                block.dump(unit);
-            if (!unit.string_table->is_empty()) {
-                outln();
-                unit.string_table->dump();
-            }
-        }
+        if (g_dump_bytecode)
+            unit.dump();
 
         JS::Bytecode::Interpreter bytecode_interpreter(interpreter->global_object());
         bytecode_interpreter.run(unit);
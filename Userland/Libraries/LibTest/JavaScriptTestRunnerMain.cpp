@@ -20,6 +20,7 @@ RefPtr<::JS::VM> g_vm;
 bool g_collect_on_every_allocation = false;
 bool g_run_bytecode = false;
 bool g_dump_bytecode = false;
+bool g_parse_functions_lazily = false;
 String g_currently_running_test;
 HashMap<String, FunctionWithLength> s_exposed_global_functions;
 Function<void()> g_main_hook;
@@ -111,6 +112,7 @@ int main(int argc, char** argv)
     args_parser.add_option(g_collect_on_every_allocation, "Collect garbage after every allocation", "collect-often", 'g');
     args_parser.add_option(g_run_bytecode, "Use the bytecode interpreter", "run-bytecode", 'b');
     args_parser.add_option(g_dump_bytecode, "Dump the bytecode", "dump-bytecode", 'd');
+    args_parser.add_option(g_parse_functions_lazily, "Only parse the body of a function when it is first called", "lazy-parse", 'L');
     args_parser.add_option(test_glob, "Only run tests matching the given glob", "filter", 'f', "glob");
     for (auto& entry : g_extra_args)
         args_parser.add_option(*entry.key, entry.value.get<0>().characters(), entry.value.get<1>().characters(), entry.value.get<2>());
@@ -12,6 +12,42 @@
 
 namespace Wasm {
 
+u64 value_to_slot(Value const& value)
+{
+    return value.value().visit(
+        [](Reference const& reference) -> u64 {
+            return reference.ref().visit(
+                [](Reference::Null const&) -> u64 { return 0; },
+                [](auto const& reference) -> u64 { return reference.address.value() + 1; });
+        },
+        [](auto value) -> u64 { return to_slot(value); });
+}
+
+Value value_from_slot(ValueType const& type, u64 slot)
+{
+    switch (type.kind()) {
+    case ValueType::I32:
+        return Value { from_slot<i32>(slot) };
+    case ValueType::I64:
+        return Value { from_slot<i64>(slot) };
+    case ValueType::F32:
+        return Value { from_slot<float>(slot) };
+    case ValueType::F64:
+        return Value { from_slot<double>(slot) };
+    case ValueType::FunctionReference:
+    case ValueType::NullFunctionReference:
+        if (slot == 0)
+            return Value { Reference { Reference::Null { ValueType(ValueType::FunctionReference) } } };
+        return Value { Reference { Reference::Func { { slot - 1 } } } };
+    case ValueType::ExternReference:
+    case ValueType::NullExternReference:
+        if (slot == 0)
+            return Value { Reference { Reference::Null { ValueType(ValueType::ExternReference) } } };
+        return Value { Reference { Reference::Extern { { slot - 1 } } } };
+    }
+    VERIFY_NOT_REACHED();
+}
+
 Optional<FunctionAddress> Store::allocate(ModuleInstance& module, Module::Function const& function)
 {
     FunctionAddress address { m_functions.size() };
@@ -130,7 +166,6 @@ InstantiationResult AbstractMachine::instantiate(Module const& module, Vector<Ex
             Configuration config { m_store };
             config.set_frame(Frame {
                 auxiliary_instance,
-                Vector<Value> {},
                 entry.expression(),
                 1,
             });
@@ -148,6 +183,17 @@ InstantiationResult AbstractMachine::instantiate(Module const& module, Vector<Ex
     if (auto result = allocate_all_initial_phase(module, main_module_instance, externs, global_values); result.has_value())
         return result.release_value();
 
+    // Now that everything the functions can refer to exists, validate them and work out their branch targets.
+    auto& functions = main_module_instance.functions();
+    auto first_defined_function = functions.size() - module.functions().size();
+    for (size_t index = first_defined_function; index < functions.size(); ++index) {
+        auto& function = m_store.get(functions[index])->get<WasmFunction>();
+        auto lowered = LoweredExpression::lower_function(m_store, main_module_instance, function.type(), function.code());
+        if (lowered.is_error())
+            return InstantiationError { String::formatted("Function {} failed validation: {}", index, lowered.error()) };
+        function.set_lowered(lowered.release_value());
+    }
+
     module.for_each_section_of_type<ElementSection>([&](ElementSection const& section) {
         for (auto& segment : section.segments()) {
             Vector<Reference> references;
@@ -155,7 +201,6 @@ InstantiationResult AbstractMachine::instantiate(Module const& module, Vector<Ex
                 Configuration config { m_store };
                 config.set_frame(Frame {
                     main_module_instance,
-                    Vector<Value> {},
                     entry,
                     entry.instructions().size(),
                 });
@@ -176,7 +221,7 @@ InstantiationResult AbstractMachine::instantiate(Module const& module, Vector<Ex
                         return IterationDecision::Continue;
                     }
                     // FIXME: type-check the reference.
-                    references.prepend(reference.release_value());
+                    references.append(reference.release_value());
                 }
             }
             elements.append(move(references));
@@ -206,7 +251,6 @@ InstantiationResult AbstractMachine::instantiate(Module const& module, Vector<Ex
             Configuration config { m_store };
             config.set_frame(Frame {
                 main_module_instance,
-                Vector<Value> {},
                 active_ptr->expression,
                 1,
             });
@@ -264,7 +308,6 @@ InstantiationResult AbstractMachine::instantiate(Module const& module, Vector<Ex
                     Configuration config { m_store };
                     config.set_frame(Frame {
                         main_module_instance,
-                        Vector<Value> {},
                         data.offset,
                         1,
                     });
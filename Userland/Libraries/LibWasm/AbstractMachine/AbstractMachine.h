@@ -11,6 +11,7 @@
 #include <AK/HashTable.h>
 #include <AK/OwnPtr.h>
 #include <AK/Result.h>
+#include <LibWasm/AbstractMachine/Lowering.h>
 #include <LibWasm/Types.h>
 
 namespace Wasm {
@@ -192,6 +193,36 @@ private:
     ValueType m_type;
 };
 
+// The interpreter keeps values in untagged 64-bit slots, and relies on validation to know what's in them.
+// Integers and floats are stored as their bits (zero-extended if they're 32-bit), and references
+// as their address plus one, so that a null reference is zero.
+u64 value_to_slot(Value const&);
+Value value_from_slot(ValueType const&, u64 slot);
+
+template<typename T>
+ALWAYS_INLINE static u64 to_slot(T value)
+{
+    if constexpr (IsSame<T, float>)
+        return bit_cast<u32>(value);
+    else if constexpr (IsSame<T, double>)
+        return bit_cast<u64>(value);
+    else if constexpr (sizeof(T) <= sizeof(u32))
+        return static_cast<u32>(value);
+    else
+        return static_cast<u64>(value);
+}
+
+template<typename T>
+ALWAYS_INLINE static T from_slot(u64 slot)
+{
+    if constexpr (IsSame<T, float>)
+        return bit_cast<float>(static_cast<u32>(slot));
+    else if constexpr (IsSame<T, double>)
+        return bit_cast<double>(slot);
+    else
+        return static_cast<T>(slot);
+}
+
 struct Trap {
     String reason;
 };
@@ -291,10 +322,15 @@ public:
     auto& module() const { return m_module; }
     auto& code() const { return m_code; }
 
+    // This is set once the module has been validated, which happens before any of its functions can be called.
+    LoweredExpression const* lowered() const { return m_lowered.ptr(); }
+    void set_lowered(NonnullOwnPtr<LoweredExpression> lowered) { m_lowered = move(lowered); }
+
 private:
     FunctionType m_type;
     ModuleInstance const& m_module;
     Module::Function const& m_code;
+    OwnPtr<LoweredExpression> m_lowered;
 };
 
 class HostFunction {
@@ -433,62 +469,78 @@ private:
     Vector<ElementInstance> m_elements;
 };
 
-class Label {
-public:
-    explicit Label(size_t arity, InstructionPointer continuation)
-        : m_arity(arity)
-        , m_continuation(continuation)
-    {
-    }
-
-    auto continuation() const { return m_continuation; }
-    auto arity() const { return m_arity; }
-
-private:
-    size_t m_arity { 0 };
-    InstructionPointer m_continuation { 0 };
-};
-
 class Frame {
 public:
-    explicit Frame(ModuleInstance const& module, Vector<Value> locals, Expression const& expression, size_t arity)
+    explicit Frame(ModuleInstance const& module, Expression const& expression, size_t arity)
         : m_module(module)
-        , m_locals(move(locals))
         , m_expression(expression)
         , m_arity(arity)
     {
     }
 
+    explicit Frame(ModuleInstance const& module, LoweredExpression const& lowered, size_t locals_base)
+        : m_module(module)
+        , m_expression(lowered.expression())
+        , m_lowered(&lowered)
+        , m_arity(lowered.result_types().size())
+        , m_locals_base(locals_base)
+    {
+    }
+
     auto& module() const { return m_module; }
-    auto& locals() const { return m_locals; }
-    auto& locals() { return m_locals; }
     auto& expression() const { return m_expression; }
     auto arity() const { return m_arity; }
+    auto* lowered() const { return m_lowered; }
+
+    // Where the frame's locals start on the value stack, followed by its operands.
+    auto locals_base() const { return m_locals_base; }
+    auto stack_base() const { return m_locals_base + m_lowered->local_types().size(); }
 
 private:
+    friend class Configuration;
+
     ModuleInstance const& m_module;
-    Vector<Value> m_locals;
     Expression const& m_expression;
+    LoweredExpression const* m_lowered { nullptr };
+    // Expressions that aren't functions are lowered when they're run, so the frame owns their lowered form.
+    OwnPtr<LoweredExpression> m_owned_lowered;
     size_t m_arity { 0 };
+    size_t m_locals_base { 0 };
 };
 
 class Stack {
 public:
-    using EntryType = Variant<Value, Label, Frame>;
     Stack() = default;
 
-    [[nodiscard]] ALWAYS_INLINE bool is_empty() const { return m_data.is_empty(); }
-    ALWAYS_INLINE void push(EntryType entry) { m_data.append(move(entry)); }
-    ALWAYS_INLINE auto pop() { return m_data.take_last(); }
-    ALWAYS_INLINE auto& peek() const { return m_data.last(); }
+    // Frames reserve room for as many values as their expression can push, so none of these have to check for it.
+    ALWAYS_INLINE void push(u64 value) { m_data.unchecked_append(value); }
+    template<typename T>
+    ALWAYS_INLINE void push(T value) { push(to_slot(value)); }
+    ALWAYS_INLINE u64 pop() { return m_data.take_last(); }
+    template<typename T>
+    ALWAYS_INLINE T pop() { return from_slot<T>(pop()); }
     ALWAYS_INLINE auto& peek() { return m_data.last(); }
+    template<typename T>
+    ALWAYS_INLINE T peek() const { return from_slot<T>(m_data.last()); }
 
+    // Drops everything above the given height, except for the topmost values that are kept.
+    ALWAYS_INLINE void unwind(size_t height, size_t kept_values)
+    {
+        auto first_kept_value = m_data.size() - kept_values;
+        if (first_kept_value != height) {
+            for (size_t i = 0; i < kept_values; ++i)
+                m_data[height + i] = m_data[first_kept_value + i];
+        }
+        m_data.shrink(height + kept_values, true);
+    }
+
+    [[nodiscard]] ALWAYS_INLINE bool is_empty() const { return m_data.is_empty(); }
     ALWAYS_INLINE auto size() const { return m_data.size(); }
     ALWAYS_INLINE auto& entries() const { return m_data; }
     ALWAYS_INLINE auto& entries() { return m_data; }
 
 private:
-    Vector<EntryType, 1024> m_data;
+    Vector<u64, 1024> m_data;
 };
 
 using InstantiationResult = AK::Result<NonnullOwnPtr<ModuleInstance>, InstantiationError>;
@@ -13,6 +13,13 @@
 #include <limits.h>
 #include <math.h>
 
+// Labels as values are a GNU extension, which both GCC and Clang support.
+#if defined(__GNUC__) || defined(__clang__)
+#    define WASM_COMPUTED_GOTO 1
+#else
+#    define WASM_COMPUTED_GOTO 0
+#endif
+
 namespace Wasm {
 
 #define TRAP_IF_NOT(x)                                                                         \
@@ -30,7 +37,7 @@ namespace Wasm {
         }                                                                                      \
     } while (false)
 
-void BytecodeInterpreter::interpret(Configuration& configuration)
+void BytecodeInterpreter::step_through_instructions(Configuration& configuration)
 {
     m_trap.clear();
     auto& instructions = configuration.frame().expression().instructions();
@@ -53,81 +60,66 @@ void BytecodeInterpreter::interpret(Configuration& configuration)
     }
 }
 
-void BytecodeInterpreter::branch_to_label(Configuration& configuration, LabelIndex index)
+void BytecodeInterpreter::branch_to(Configuration& configuration, BranchTarget const& target)
 {
-    dbgln_if(WASM_TRACE_DEBUG, "Branch to label with index {}...", index.value());
-    auto label = configuration.nth_label(index.value());
-    TRAP_IF_NOT(label.has_value());
-    dbgln_if(WASM_TRACE_DEBUG, "...which is actually IP {}, and has {} result(s)", label->continuation().value(), label->arity());
-    auto results = pop_values(configuration, label->arity());
-
-    size_t drop_count = index.value() + 1;
-    for (; !configuration.stack().is_empty();) {
-        auto& entry = configuration.stack().peek();
-        if (entry.has<Label>()) {
-            if (--drop_count == 0)
-                break;
-        }
-        configuration.stack().pop();
-    }
-
-    for (auto& result : results)
-        configuration.stack().push(move(result));
+    dbgln_if(WASM_TRACE_DEBUG, "Branch to IP {}, with {} result(s)", target.ip.value(), target.arity);
+    configuration.stack().unwind(configuration.frame().stack_base() + target.stack_height, target.arity);
+    configuration.ip() = target.ip;
+}
 
-    configuration.ip() = label->continuation();
+static MemoryInstance* memory_of(Configuration& configuration, ModuleInstance const& module)
+{
+    if (module.memories().is_empty())
+        return nullptr;
+    return configuration.store().get(module.memories().first());
 }
 
 template<typename ReadType, typename PushType>
-void BytecodeInterpreter::load_and_push(Configuration& configuration, Instruction const& instruction)
+void BytecodeInterpreter::load_and_push(Configuration& configuration, MemoryInstance* memory, u32 offset)
 {
-    auto& address = configuration.frame().module().memories().first();
-    auto memory = configuration.store().get(address);
     if (!memory) {
         m_trap = Trap { "Nonexistent memory" };
         return;
     }
-    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
-    TRAP_IF_NOT(!configuration.stack().is_empty());
-    auto& entry = configuration.stack().peek();
-    TRAP_IF_NOT(entry.has<Value>());
-    auto base = entry.get<Value>().to<i32>();
-    if (!base.has_value()) {
+    auto instance_address = static_cast<u64>(configuration.stack().peek<u32>()) + offset;
+    if (instance_address + sizeof(ReadType) > memory->size()) {
         m_trap = Trap { "Memory access out of bounds" };
-        return;
-    }
-    auto instance_address = base.value() + static_cast<i64>(arg.offset);
-    if (instance_address < 0 || static_cast<u64>(instance_address + sizeof(ReadType)) > memory->size()) {
-        m_trap = Trap { "Memory access out of bounds" };
-        dbgln("LibWasm: Memory access out of bounds (expected 0 <= {} and {} <= {})", instance_address, instance_address + sizeof(ReadType), memory->size());
+        dbgln("LibWasm: Memory access out of bounds (expected {} <= {})", instance_address + sizeof(ReadType), memory->size());
         return;
     }
     dbgln_if(WASM_TRACE_DEBUG, "load({} : {}) -> stack", instance_address, sizeof(ReadType));
     auto slice = memory->data().bytes().slice(instance_address, sizeof(ReadType));
-    configuration.stack().peek() = Value(static_cast<PushType>(read_value<ReadType>(slice)));
+    configuration.stack().peek() = to_slot(static_cast<PushType>(read_value<ReadType>(slice)));
 }
 
-void BytecodeInterpreter::store_to_memory(Configuration& configuration, Instruction const& instruction, ReadonlyBytes data)
+void BytecodeInterpreter::store_to_memory(Configuration& configuration, MemoryInstance* memory, u32 offset, ReadonlyBytes data)
 {
-    auto& address = configuration.frame().module().memories().first();
-    auto memory = configuration.store().get(address);
     TRAP_IF_NOT(memory);
-    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
-    TRAP_IF_NOT(!configuration.stack().is_empty());
-    auto entry = configuration.stack().pop();
-    TRAP_IF_NOT(entry.has<Value>());
-    auto base = entry.get<Value>().to<i32>();
-    TRAP_IF_NOT(base.has_value());
-    auto instance_address = base.value() + static_cast<i64>(arg.offset);
-    if (instance_address < 0 || static_cast<u64>(instance_address + data.size()) > memory->size()) {
+    auto instance_address = static_cast<u64>(configuration.stack().pop<u32>()) + offset;
+    if (instance_address + data.size() > memory->size()) {
         m_trap = Trap { "Memory access out of bounds" };
-        dbgln("LibWasm: Memory access out of bounds (expected 0 <= {} and {} <= {})", instance_address, instance_address + data.size(), memory->size());
+        dbgln("LibWasm: Memory access out of bounds (expected {} <= {})", instance_address + data.size(), memory->size());
         return;
     }
     dbgln_if(WASM_TRACE_DEBUG, "tempoaray({}b) -> store({})", data.size(), instance_address);
     data.copy_to(memory->data().bytes().slice(instance_address, data.size()));
 }
 
-void BytecodeInterpreter::call_address(Configuration& configuration, FunctionAddress address)
+static bool types_match(FunctionType const& a, FunctionType const& b)
+{
+    auto kinds_match = [](Vector<ValueType> const& a, Vector<ValueType> const& b) {
+        if (a.size() != b.size())
+            return false;
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (a[i].kind() != b[i].kind())
+                return false;
+        }
+        return true;
+    };
+    return kinds_match(a.parameters(), b.parameters()) && kinds_match(a.results(), b.results());
+}
+
+void BytecodeInterpreter::call_address(Configuration& configuration, FunctionAddress address, FunctionType const* expected_type)
 {
     TRAP_IF_NOT(configuration.depth() <= Constants::max_allowed_call_stack_depth);
 
@@ -136,22 +128,31 @@ void BytecodeInterpreter::call_address(Configuration& configuration, FunctionAdd
     FunctionType const* type { nullptr };
     instance->visit([&](auto const& function) { type = &function.type(); });
     TRAP_IF_NOT(type);
-    TRAP_IF_NOT(configuration.stack().entries().size() > type->parameters().size());
-    Vector<Value> args;
-    args.ensure_capacity(type->parameters().size());
-    auto span = configuration.stack().entries().span().slice_from_end(type->parameters().size());
-    for (auto& entry : span) {
-        auto* ptr = entry.get_pointer<Value>();
-        TRAP_IF_NOT(ptr != nullptr);
-        args.unchecked_append(*ptr);
+    // The stack only stays consistent if the function takes and returns what the caller was validated against.
+    TRAP_IF_NOT(!expected_type || types_match(*type, *expected_type));
+
+    if (auto* function = instance->get_pointer<WasmFunction>()) {
+        TRAP_IF_NOT(function->lowered());
+        CallFrameHandle handle { *this, configuration };
+        configuration.enter_function(*function);
+        interpret(configuration);
+        if (!m_trap.has_value())
+            configuration.leave_function();
+        return;
     }
 
-    configuration.stack().entries().remove(configuration.stack().size() - span.size(), span.size());
+    auto& parameters = type->parameters();
+    auto first_argument = configuration.stack().size() - parameters.size();
+    Vector<Value> args;
+    args.ensure_capacity(parameters.size());
+    for (size_t i = 0; i < parameters.size(); ++i)
+        args.unchecked_append(value_from_slot(parameters[i], configuration.stack().entries()[first_argument + i]));
+    configuration.stack().entries().shrink(first_argument, true);
 
     Result result { Trap { ""sv } };
     {
         CallFrameHandle handle { *this, configuration };
-        result = configuration.call(*this, address, move(args));
+        result = instance->get<HostFunction>().function()(configuration, args);
     }
 
     if (result.is_trap()) {
@@ -159,100 +160,258 @@ void BytecodeInterpreter::call_address(Configuration& configuration, FunctionAdd
         return;
     }
 
-    configuration.stack().entries().ensure_capacity(configuration.stack().size() + result.values().size());
+    TRAP_IF_NOT(result.values().size() == type->results().size());
     for (auto& entry : result.values())
-        configuration.stack().entries().unchecked_append(move(entry));
+        configuration.stack().push(value_to_slot(entry));
 }
 
-#define BINARY_NUMERIC_OPERATION(type, operator, cast, ...)                                       \
-    do {                                                                                          \
-        TRAP_IF_NOT(!configuration.stack().is_empty());                                           \
-        auto rhs_entry = configuration.stack().pop();                                             \
-        auto& lhs_entry = configuration.stack().peek();                                           \
-        TRAP_IF_NOT(rhs_entry.has<Value>());                                                      \
-        TRAP_IF_NOT(lhs_entry.has<Value>());                                                      \
-        auto rhs = rhs_entry.get<Value>().to<type>();                                             \
-        auto lhs = lhs_entry.get<Value>().to<type>();                                             \
-        TRAP_IF_NOT(lhs.has_value());                                                             \
-        TRAP_IF_NOT(rhs.has_value());                                                             \
-        __VA_ARGS__;                                                                              \
-        auto result = lhs.value() operator rhs.value();                                           \
-        dbgln_if(WASM_TRACE_DEBUG, "{} {} {} = {}", lhs.value(), #operator, rhs.value(), result); \
-        configuration.stack().peek() = Value(cast(result));                                       \
-        return;                                                                                   \
+void BytecodeInterpreter::call_table_element(Configuration& configuration, TableAddress table_address, FunctionType const& expected_type)
+{
+    auto table_instance = configuration.store().get(table_address);
+    TRAP_IF_NOT(table_instance);
+    auto index = configuration.stack().pop<u32>();
+    TRAP_IF_NOT(index < table_instance->elements().size());
+    auto element = table_instance->elements()[index];
+    TRAP_IF_NOT(element.has_value());
+    TRAP_IF_NOT(element->ref().has<Reference::Func>());
+    auto address = element->ref().get<Reference::Func>().address;
+    dbgln_if(WASM_TRACE_DEBUG, "call_indirect({} -> {})", index, address.value());
+    call_address(configuration, address, &expected_type);
+}
+
+#define BINARY_NUMERIC_OPERATION(type, operator, cast, ...)                       \
+    do {                                                                          \
+        auto rhs = configuration.stack().pop<type>();                             \
+        auto lhs = configuration.stack().peek<type>();                            \
+        __VA_ARGS__;                                                              \
+        auto result = lhs operator rhs;                                           \
+        dbgln_if(WASM_TRACE_DEBUG, "{} {} {} = {}", lhs, #operator, rhs, result); \
+        configuration.stack().peek() = to_slot(cast(result));                     \
     } while (false)
 
-#define OVF_CHECKED_BINARY_NUMERIC_OPERATION(type, operator, cast, ...)                            \
-    do {                                                                                           \
-        TRAP_IF_NOT(!configuration.stack().is_empty());                                            \
-        auto rhs_entry = configuration.stack().pop();                                              \
-        auto& lhs_entry = configuration.stack().peek();                                            \
-        TRAP_IF_NOT(rhs_entry.has<Value>());                                                       \
-        TRAP_IF_NOT(lhs_entry.has<Value>());                                                       \
-        auto rhs = rhs_entry.get<Value>().to<type>();                                              \
-        auto ulhs = lhs_entry.get<Value>().to<type>();                                             \
-        TRAP_IF_NOT(ulhs.has_value());                                                             \
-        TRAP_IF_NOT(rhs.has_value());                                                              \
-        dbgln_if(WASM_TRACE_DEBUG, "{} {} {} = ??", ulhs.value(), #operator, rhs.value());         \
-        __VA_ARGS__;                                                                               \
-        Checked<type> lhs = ulhs.value();                                                          \
-        lhs operator##= rhs.value();                                                               \
-        TRAP_IF_NOT(!lhs.has_overflow());                                                          \
-        auto result = lhs.value();                                                                 \
-        dbgln_if(WASM_TRACE_DEBUG, "{} {} {} = {}", ulhs.value(), #operator, rhs.value(), result); \
-        configuration.stack().peek() = Value(cast(result));                                        \
-        return;                                                                                    \
+#define OVF_CHECKED_BINARY_NUMERIC_OPERATION(type, operator, cast, ...)            \
+    do {                                                                           \
+        auto rhs = configuration.stack().pop<type>();                              \
+        auto ulhs = configuration.stack().peek<type>();                            \
+        dbgln_if(WASM_TRACE_DEBUG, "{} {} {} = ??", ulhs, #operator, rhs);         \
+        __VA_ARGS__;                                                               \
+        Checked<type> lhs = ulhs;                                                  \
+        lhs operator##= rhs;                                                       \
+        TRAP_IF_NOT(!lhs.has_overflow());                                          \
+        auto result = lhs.value();                                                 \
+        dbgln_if(WASM_TRACE_DEBUG, "{} {} {} = {}", ulhs, #operator, rhs, result); \
+        configuration.stack().peek() = to_slot(cast(result));                      \
     } while (false)
 
-#define BINARY_PREFIX_NUMERIC_OPERATION(type, operation, cast, ...)                                 \
-    do {                                                                                            \
-        TRAP_IF_NOT(!configuration.stack().is_empty());                                             \
-        auto rhs_entry = configuration.stack().pop();                                               \
-        auto& lhs_entry = configuration.stack().peek();                                             \
-        TRAP_IF_NOT(rhs_entry.has<Value>());                                                        \
-        TRAP_IF_NOT(lhs_entry.has<Value>());                                                        \
-        auto rhs = rhs_entry.get<Value>().to<type>();                                               \
-        auto lhs = lhs_entry.get<Value>().to<type>();                                               \
-        TRAP_IF_NOT(lhs.has_value());                                                               \
-        TRAP_IF_NOT(rhs.has_value());                                                               \
-        auto result = operation(lhs.value(), rhs.value());                                          \
-        dbgln_if(WASM_TRACE_DEBUG, "{}({} {}) = {}", #operation, lhs.value(), rhs.value(), result); \
-        configuration.stack().peek() = Value(cast(result));                                         \
-        return;                                                                                     \
+#define BINARY_PREFIX_NUMERIC_OPERATION(type, operation, cast, ...)                 \
+    do {                                                                            \
+        auto rhs = configuration.stack().pop<type>();                               \
+        auto lhs = configuration.stack().peek<type>();                              \
+        __VA_ARGS__;                                                                \
+        auto result = operation(lhs, rhs);                                          \
+        dbgln_if(WASM_TRACE_DEBUG, "{}({} {}) = {}", #operation, lhs, rhs, result); \
+        configuration.stack().peek() = to_slot(cast(result));                       \
     } while (false)
 
-#define UNARY_MAP(pop_type, operation, ...)                                               \
-    do {                                                                                  \
-        TRAP_IF_NOT(!configuration.stack().is_empty());                                   \
-        auto& entry = configuration.stack().peek();                                       \
-        TRAP_IF_NOT(entry.has<Value>());                                                  \
-        auto value = entry.get<Value>().to<pop_type>();                                   \
-        TRAP_IF_NOT(value.has_value());                                                   \
-        auto result = operation(value.value());                                           \
-        dbgln_if(WASM_TRACE_DEBUG, "map({}) {} = {}", #operation, value.value(), result); \
-        configuration.stack().peek() = Value(__VA_ARGS__(result));                        \
-        return;                                                                           \
+#define UNARY_MAP(pop_type, operation, ...)                                       \
+    do {                                                                          \
+        auto value = configuration.stack().peek<pop_type>();                      \
+        auto result = operation(value);                                           \
+        dbgln_if(WASM_TRACE_DEBUG, "map({}) {} = {}", #operation, value, result); \
+        configuration.stack().peek() = to_slot(__VA_ARGS__(result));              \
     } while (false)
 
 #define UNARY_NUMERIC_OPERATION(type, operation) \
     UNARY_MAP(type, operation, type)
 
-#define LOAD_AND_PUSH(read_type, push_type)                                     \
-    do {                                                                        \
-        return load_and_push<read_type, push_type>(configuration, instruction); \
-    } while (false)
+#define LOAD_AND_PUSH(read_type, push_type)                            \
+    load_and_push<read_type, push_type>(configuration, memory, offset)
 
 #define POP_AND_STORE(pop_type, store_type)                                                   \
     do {                                                                                      \
-        TRAP_IF_NOT(!configuration.stack().is_empty());                                       \
-        auto entry = configuration.stack().pop();                                             \
-        TRAP_IF_NOT(entry.has<Value>());                                                      \
-        auto value = ConvertToRaw<store_type> {}(*entry.get<Value>().to<pop_type>());         \
+        auto value = ConvertToRaw<store_type> {}(configuration.stack().pop<pop_type>());      \
         dbgln_if(WASM_TRACE_DEBUG, "stack({}) -> temporary({}b)", value, sizeof(store_type)); \
-        store_to_memory(configuration, instruction, { &value, sizeof(store_type) });          \
-        return;                                                                               \
+        store_to_memory(configuration, memory, offset, { &value, sizeof(store_type) });       \
+    } while (false)
+
+#define SELECT()                                         \
+    do {                                                 \
+        auto value = configuration.stack().pop<i32>();   \
+        dbgln_if(WASM_TRACE_DEBUG, "select({})", value); \
+        auto rhs = configuration.stack().pop();          \
+        if (value == 0)                                  \
+            configuration.stack().peek() = rhs;          \
     } while (false)
 
+// The instructions that look the same in both encodings, so both interpreter loops can share their handlers.
+// A handler returns from the loop if it traps.
+#define ENUMERATE_STACK_INSTRUCTION_HANDLERS(H)                                                                                            \
+    H(i32_eqz, UNARY_NUMERIC_OPERATION(i32, 0 ==))                                                                                         \
+    H(i32_eq, BINARY_NUMERIC_OPERATION(i32, ==, i32))                                                                                      \
+    H(i32_ne, BINARY_NUMERIC_OPERATION(i32, !=, i32))                                                                                      \
+    H(i32_lts, BINARY_NUMERIC_OPERATION(i32, <, i32))                                                                                      \
+    H(i32_ltu, BINARY_NUMERIC_OPERATION(u32, <, i32))                                                                                      \
+    H(i32_gts, BINARY_NUMERIC_OPERATION(i32, >, i32))                                                                                      \
+    H(i32_gtu, BINARY_NUMERIC_OPERATION(u32, >, i32))                                                                                      \
+    H(i32_les, BINARY_NUMERIC_OPERATION(i32, <=, i32))                                                                                     \
+    H(i32_leu, BINARY_NUMERIC_OPERATION(u32, <=, i32))                                                                                     \
+    H(i32_ges, BINARY_NUMERIC_OPERATION(i32, >=, i32))                                                                                     \
+    H(i32_geu, BINARY_NUMERIC_OPERATION(u32, >=, i32))                                                                                     \
+    H(i64_eqz, UNARY_NUMERIC_OPERATION(i64, 0ull ==))                                                                                      \
+    H(i64_eq, BINARY_NUMERIC_OPERATION(i64, ==, i32))                                                                                      \
+    H(i64_ne, BINARY_NUMERIC_OPERATION(i64, !=, i32))                                                                                      \
+    H(i64_lts, BINARY_NUMERIC_OPERATION(i64, <, i32))                                                                                      \
+    H(i64_ltu, BINARY_NUMERIC_OPERATION(u64, <, i32))                                                                                      \
+    H(i64_gts, BINARY_NUMERIC_OPERATION(i64, >, i32))                                                                                      \
+    H(i64_gtu, BINARY_NUMERIC_OPERATION(u64, >, i32))                                                                                      \
+    H(i64_les, BINARY_NUMERIC_OPERATION(i64, <=, i32))                                                                                     \
+    H(i64_leu, BINARY_NUMERIC_OPERATION(u64, <=, i32))                                                                                     \
+    H(i64_ges, BINARY_NUMERIC_OPERATION(i64, >=, i32))                                                                                     \
+    H(i64_geu, BINARY_NUMERIC_OPERATION(u64, >=, i32))                                                                                     \
+    H(f32_eq, BINARY_NUMERIC_OPERATION(float, ==, i32))                                                                                    \
+    H(f32_ne, BINARY_NUMERIC_OPERATION(float, !=, i32))                                                                                    \
+    H(f32_lt, BINARY_NUMERIC_OPERATION(float, <, i32))                                                                                     \
+    H(f32_gt, BINARY_NUMERIC_OPERATION(float, >, i32))                                                                                     \
+    H(f32_le, BINARY_NUMERIC_OPERATION(float, <=, i32))                                                                                    \
+    H(f32_ge, BINARY_NUMERIC_OPERATION(float, >=, i32))                                                                                    \
+    H(f64_eq, BINARY_NUMERIC_OPERATION(double, ==, i32))                                                                                   \
+    H(f64_ne, BINARY_NUMERIC_OPERATION(double, !=, i32))                                                                                   \
+    H(f64_lt, BINARY_NUMERIC_OPERATION(double, <, i32))                                                                                    \
+    H(f64_gt, BINARY_NUMERIC_OPERATION(double, >, i32))                                                                                    \
+    H(f64_le, BINARY_NUMERIC_OPERATION(double, <=, i32))                                                                                   \
+    H(f64_ge, BINARY_NUMERIC_OPERATION(double, >=, i32))                                                                                   \
+    H(i32_clz, UNARY_NUMERIC_OPERATION(i32, clz))                                                                                          \
+    H(i32_ctz, UNARY_NUMERIC_OPERATION(i32, ctz))                                                                                          \
+    H(i32_popcnt, UNARY_NUMERIC_OPERATION(i32, __builtin_popcount))                                                                        \
+    H(i32_add, BINARY_NUMERIC_OPERATION(u32, +, i32))                                                                                      \
+    H(i32_sub, BINARY_NUMERIC_OPERATION(u32, -, i32))                                                                                      \
+    H(i32_mul, BINARY_NUMERIC_OPERATION(u32, *, i32))                                                                                      \
+    H(i32_divs, OVF_CHECKED_BINARY_NUMERIC_OPERATION(i32, /, i32, TRAP_IF_NOT(rhs != 0)))                                                  \
+    H(i32_divu, BINARY_NUMERIC_OPERATION(u32, /, i32, TRAP_IF_NOT(rhs != 0)))                                                              \
+    H(i32_rems, BINARY_PREFIX_NUMERIC_OPERATION(i32, signed_remainder, i32, TRAP_IF_NOT(rhs != 0)))                                        \
+    H(i32_remu, BINARY_NUMERIC_OPERATION(u32, %, i32, TRAP_IF_NOT(rhs != 0)))                                                              \
+    H(i32_and, BINARY_NUMERIC_OPERATION(i32, &, i32))                                                                                      \
+    H(i32_or, BINARY_NUMERIC_OPERATION(i32, |, i32))                                                                                       \
+    H(i32_xor, BINARY_NUMERIC_OPERATION(i32, ^, i32))                                                                                      \
+    H(i32_shl, BINARY_PREFIX_NUMERIC_OPERATION(u32, shift_left, i32))                                                                      \
+    H(i32_shrs, BINARY_PREFIX_NUMERIC_OPERATION(i32, shift_right, i32))                                                                    \
+    H(i32_shru, BINARY_PREFIX_NUMERIC_OPERATION(u32, shift_right, i32))                                                                    \
+    H(i32_rotl, BINARY_PREFIX_NUMERIC_OPERATION(u32, rotl, i32))                                                                           \
+    H(i32_rotr, BINARY_PREFIX_NUMERIC_OPERATION(u32, rotr, i32))                                                                           \
+    H(i64_clz, UNARY_NUMERIC_OPERATION(i64, clz))                                                                                          \
+    H(i64_ctz, UNARY_NUMERIC_OPERATION(i64, ctz))                                                                                          \
+    H(i64_popcnt, UNARY_NUMERIC_OPERATION(i64, __builtin_popcountll))                                                                      \
+    H(i64_add, BINARY_NUMERIC_OPERATION(u64, +, i64))                                                                                      \
+    H(i64_sub, BINARY_NUMERIC_OPERATION(u64, -, i64))                                                                                      \
+    H(i64_mul, BINARY_NUMERIC_OPERATION(u64, *, i64))                                                                                      \
+    H(i64_divs, OVF_CHECKED_BINARY_NUMERIC_OPERATION(i64, /, i64, TRAP_IF_NOT(rhs != 0)))                                                  \
+    H(i64_divu, BINARY_NUMERIC_OPERATION(u64, /, i64, TRAP_IF_NOT(rhs != 0)))                                                              \
+    H(i64_rems, BINARY_PREFIX_NUMERIC_OPERATION(i64, signed_remainder, i64, TRAP_IF_NOT(rhs != 0)))                                        \
+    H(i64_remu, BINARY_NUMERIC_OPERATION(u64, %, i64, TRAP_IF_NOT(rhs != 0)))                                                              \
+    H(i64_and, BINARY_NUMERIC_OPERATION(i64, &, i64))                                                                                      \
+    H(i64_or, BINARY_NUMERIC_OPERATION(i64, |, i64))                                                                                       \
+    H(i64_xor, BINARY_NUMERIC_OPERATION(i64, ^, i64))                                                                                      \
+    H(i64_shl, BINARY_PREFIX_NUMERIC_OPERATION(u64, shift_left, i64))                                                                      \
+    H(i64_shrs, BINARY_PREFIX_NUMERIC_OPERATION(i64, shift_right, i64))                                                                    \
+    H(i64_shru, BINARY_PREFIX_NUMERIC_OPERATION(u64, shift_right, i64))                                                                    \
+    H(i64_rotl, BINARY_PREFIX_NUMERIC_OPERATION(u64, rotl, i64))                                                                           \
+    H(i64_rotr, BINARY_PREFIX_NUMERIC_OPERATION(u64, rotr, i64))                                                                           \
+    H(f32_abs, UNARY_NUMERIC_OPERATION(float, fabsf))                                                                                      \
+    H(f32_neg, UNARY_NUMERIC_OPERATION(float, -))                                                                                          \
+    H(f32_ceil, UNARY_NUMERIC_OPERATION(float, ceilf))                                                                                     \
+    H(f32_floor, UNARY_NUMERIC_OPERATION(float, floorf))                                                                                   \
+    H(f32_trunc, UNARY_NUMERIC_OPERATION(float, truncf))                                                                                   \
+    H(f32_nearest, UNARY_NUMERIC_OPERATION(float, nearbyintf))                                                                             \
+    H(f32_sqrt, UNARY_NUMERIC_OPERATION(float, sqrtf))                                                                                     \
+    H(f32_add, BINARY_NUMERIC_OPERATION(float, +, float))                                                                                  \
+    H(f32_sub, BINARY_NUMERIC_OPERATION(float, -, float))                                                                                  \
+    H(f32_mul, BINARY_NUMERIC_OPERATION(float, *, float))                                                                                  \
+    H(f32_div, BINARY_NUMERIC_OPERATION(float, /, float))                                                                                  \
+    H(f32_min, BINARY_PREFIX_NUMERIC_OPERATION(float, float_min, float))                                                                   \
+    H(f32_max, BINARY_PREFIX_NUMERIC_OPERATION(float, float_max, float))                                                                   \
+    H(f32_copysign, BINARY_PREFIX_NUMERIC_OPERATION(float, copysignf, float))                                                              \
+    H(f64_abs, UNARY_NUMERIC_OPERATION(double, fabs))                                                                                      \
+    H(f64_neg, UNARY_NUMERIC_OPERATION(double, -))                                                                                         \
+    H(f64_ceil, UNARY_NUMERIC_OPERATION(double, ceil))                                                                                     \
+    H(f64_floor, UNARY_NUMERIC_OPERATION(double, floor))                                                                                   \
+    H(f64_trunc, UNARY_NUMERIC_OPERATION(double, trunc))                                                                                   \
+    H(f64_nearest, UNARY_NUMERIC_OPERATION(double, nearbyint))                                                                             \
+    H(f64_sqrt, UNARY_NUMERIC_OPERATION(double, sqrt))                                                                                     \
+    H(f64_add, BINARY_NUMERIC_OPERATION(double, +, double))                                                                                \
+    H(f64_sub, BINARY_NUMERIC_OPERATION(double, -, double))                                                                                \
+    H(f64_mul, BINARY_NUMERIC_OPERATION(double, *, double))                                                                                \
+    H(f64_div, BINARY_NUMERIC_OPERATION(double, /, double))                                                                                \
+    H(f64_min, BINARY_PREFIX_NUMERIC_OPERATION(double, float_min, double))                                                                 \
+    H(f64_max, BINARY_PREFIX_NUMERIC_OPERATION(double, float_max, double))                                                                 \
+    H(f64_copysign, BINARY_PREFIX_NUMERIC_OPERATION(double, copysign, double))                                                             \
+    H(i32_wrap_i64, UNARY_MAP(i64, i32, i32))                                                                                              \
+    H(i32_trunc_sf32, auto fn = [this](auto& value) { return checked_signed_truncate<float, i32>(value); }; UNARY_MAP(float, fn, i32))     \
+    H(i32_trunc_uf32, auto fn = [this](auto& value) { return checked_unsigned_truncate<float, i32>(value); }; UNARY_MAP(float, fn, i32))   \
+    H(i32_trunc_sf64, auto fn = [this](auto& value) { return checked_signed_truncate<double, i32>(value); }; UNARY_MAP(double, fn, i32))   \
+    H(i32_trunc_uf64, auto fn = [this](auto& value) { return checked_unsigned_truncate<double, i32>(value); }; UNARY_MAP(double, fn, i32)) \
+    H(i64_trunc_sf32, auto fn = [this](auto& value) { return checked_signed_truncate<float, i64>(value); }; UNARY_MAP(float, fn, i64))     \
+    H(i64_trunc_uf32, auto fn = [this](auto& value) { return checked_unsigned_truncate<float, i64>(value); }; UNARY_MAP(float, fn, i64))   \
+    H(i64_trunc_sf64, auto fn = [this](auto& value) { return checked_signed_truncate<double, i64>(value); }; UNARY_MAP(double, fn, i64))   \
+    H(i64_trunc_uf64, auto fn = [this](auto& value) { return checked_unsigned_truncate<double, i64>(value); }; UNARY_MAP(double, fn, i64)) \
+    H(i64_extend_si32, UNARY_MAP(i32, i64, i64))                                                                                           \
+    H(i64_extend_ui32, UNARY_MAP(u32, i64, i64))                                                                                           \
+    H(f32_convert_si32, UNARY_MAP(i32, float, float))                                                                                      \
+    H(f32_convert_ui32, UNARY_MAP(u32, float, float))                                                                                      \
+    H(f32_convert_si64, UNARY_MAP(i64, float, float))                                                                                      \
+    H(f32_convert_ui64, UNARY_MAP(u64, float, float))                                                                                      \
+    H(f32_demote_f64, UNARY_MAP(double, float, float))                                                                                     \
+    H(f64_convert_si32, UNARY_MAP(i32, double, double))                                                                                    \
+    H(f64_convert_ui32, UNARY_MAP(u32, double, double))                                                                                    \
+    H(f64_convert_si64, UNARY_MAP(i64, double, double))                                                                                    \
+    H(f64_convert_ui64, UNARY_MAP(u64, double, double))                                                                                    \
+    H(f64_promote_f32, UNARY_MAP(float, double, double))                                                                                   \
+    H(i32_reinterpret_f32, UNARY_MAP(float, bit_cast<i32>, i32))                                                                           \
+    H(i64_reinterpret_f64, UNARY_MAP(double, bit_cast<i64>, i64))                                                                          \
+    H(f32_reinterpret_i32, UNARY_MAP(i32, bit_cast<float>, float))                                                                         \
+    H(f64_reinterpret_i64, UNARY_MAP(i64, bit_cast<double>, double))                                                                       \
+    H(i32_extend8_s, UNARY_MAP(i32, (extend_signed<i8, i32>), i32))                                                                        \
+    H(i32_extend16_s, UNARY_MAP(i32, (extend_signed<i16, i32>), i32))                                                                      \
+    H(i64_extend8_s, UNARY_MAP(i64, (extend_signed<i8, i64>), i64))                                                                        \
+    H(i64_extend16_s, UNARY_MAP(i64, (extend_signed<i16, i64>), i64))                                                                      \
+    H(i64_extend32_s, UNARY_MAP(i64, (extend_signed<i32, i64>), i64))                                                                      \
+    H(i32_trunc_sat_f32_s, UNARY_MAP(float, saturating_truncate<i32>, i32))                                                                \
+    H(i32_trunc_sat_f32_u, UNARY_MAP(float, saturating_truncate<u32>, i32))                                                                \
+    H(i32_trunc_sat_f64_s, UNARY_MAP(double, saturating_truncate<i32>, i32))                                                               \
+    H(i32_trunc_sat_f64_u, UNARY_MAP(double, saturating_truncate<u32>, i32))                                                               \
+    H(i64_trunc_sat_f32_s, UNARY_MAP(float, saturating_truncate<i64>, i64))                                                                \
+    H(i64_trunc_sat_f32_u, UNARY_MAP(float, saturating_truncate<u64>, i64))                                                                \
+    H(i64_trunc_sat_f64_s, UNARY_MAP(double, saturating_truncate<i64>, i64))                                                               \
+    H(i64_trunc_sat_f64_u, UNARY_MAP(double, saturating_truncate<u64>, i64))                                                               \
+    H(ref_is_null, configuration.stack().peek() = to_slot(configuration.stack().peek() == 0 ? 1 : 0))                                      \
+    H(drop, configuration.stack().pop())                                                                                                   \
+    H(select, SELECT())
+
+// These expect the memory and the offset in `memory` and `offset`.
+#define ENUMERATE_MEMORY_INSTRUCTION_HANDLERS(H) \
+    H(i32_load, LOAD_AND_PUSH(i32, i32))         \
+    H(i64_load, LOAD_AND_PUSH(i64, i64))         \
+    H(f32_load, LOAD_AND_PUSH(float, float))     \
+    H(f64_load, LOAD_AND_PUSH(double, double))   \
+    H(i32_load8_s, LOAD_AND_PUSH(i8, i32))       \
+    H(i32_load8_u, LOAD_AND_PUSH(u8, i32))       \
+    H(i32_load16_s, LOAD_AND_PUSH(i16, i32))     \
+    H(i32_load16_u, LOAD_AND_PUSH(u16, i32))     \
+    H(i64_load8_s, LOAD_AND_PUSH(i8, i64))       \
+    H(i64_load8_u, LOAD_AND_PUSH(u8, i64))       \
+    H(i64_load16_s, LOAD_AND_PUSH(i16, i64))     \
+    H(i64_load16_u, LOAD_AND_PUSH(u16, i64))     \
+    H(i64_load32_s, LOAD_AND_PUSH(i32, i64))     \
+    H(i64_load32_u, LOAD_AND_PUSH(u32, i64))     \
+    H(i32_store, POP_AND_STORE(i32, i32))        \
+    H(i64_store, POP_AND_STORE(i64, i64))        \
+    H(f32_store, POP_AND_STORE(float, float))    \
+    H(f64_store, POP_AND_STORE(double, double))  \
+    H(i32_store8, POP_AND_STORE(i32, i8))        \
+    H(i32_store16, POP_AND_STORE(i32, i16))      \
+    H(i64_store8, POP_AND_STORE(i64, i8))        \
+    H(i64_store16, POP_AND_STORE(i64, i16))      \
+    H(i64_store32, POP_AND_STORE(i64, i32))
+
 template<typename T>
 T BytecodeInterpreter::read_value(ReadonlyBytes data)
 {
@@ -367,21 +526,6 @@ MakeUnsigned<T> BytecodeInterpreter::checked_unsigned_truncate(V value)
     return true;
 }
 
-Vector<Value> BytecodeInterpreter::pop_values(Configuration& configuration, size_t count)
-{
-    Vector<Value> results;
-    results.resize(count);
-
-    for (size_t i = 0; i < count; ++i) {
-        auto top_of_stack = configuration.stack().pop();
-        if (auto value = top_of_stack.get_pointer<Value>())
-            results[i] = move(*value);
-        else
-            TRAP_IF_NOT_NORETURN(value);
-    }
-    return results;
-}
-
 template<typename T, typename R>
 ALWAYS_INLINE static T rotl(T value, R shift)
 {
@@ -474,6 +618,8 @@ ALWAYS_INLINE static T float_max(T lhs, T rhs)
         return lhs > 0 ? lhs : rhs;
     if (isinf(rhs))
         return rhs > 0 ? rhs : lhs;
+    if (lhs == rhs)
+        return signbit(lhs) ? rhs : lhs;
     return max(lhs, rhs);
 }
 
@@ -488,9 +634,315 @@ ALWAYS_INLINE static T float_min(T lhs, T rhs)
         return lhs > 0 ? rhs : lhs;
     if (isinf(rhs))
         return rhs > 0 ? lhs : rhs;
+    if (lhs == rhs)
+        return signbit(lhs) ? lhs : rhs;
     return min(lhs, rhs);
 }
 
+template<typename T>
+ALWAYS_INLINE static T signed_remainder(T lhs, T rhs)
+{
+    // The remainder is always zero when dividing by -1, which spares us the overflow of MIN % -1.
+    if (rhs == -1)
+        return 0;
+    return lhs % rhs;
+}
+
+template<typename T>
+ALWAYS_INLINE static T shift_left(T value, T count)
+{
+    return value << (count & (CHAR_BIT * sizeof(T) - 1));
+}
+
+template<typename T>
+ALWAYS_INLINE static T shift_right(T value, T count)
+{
+    return value >> (count & (CHAR_BIT * sizeof(T) - 1));
+}
+
+void BytecodeInterpreter::interpret(Configuration& configuration)
+{
+    m_trap.clear();
+
+    // Nothing here may hold on to the frame itself, since calls can move it around when they add theirs.
+    auto* lowered = configuration.frame().lowered();
+    TRAP_IF_NOT(lowered);
+
+    if (m_jit_threshold.has_value()) {
+        if (auto* compiled_function = JIT::compiled_function_for(*lowered, configuration, *m_jit_threshold)) {
+            if (auto trap = compiled_function->run(*this, configuration); trap.has_value())
+                m_trap = trap.release_value();
+            return;
+        }
+    }
+
+    auto& module = configuration.frame().module();
+    auto& stack = configuration.stack();
+    auto locals_base = configuration.frame().locals_base();
+    auto stack_base = configuration.frame().stack_base();
+    auto* instructions = lowered->lowered_instructions().data();
+    auto* pc = instructions;
+    u64 taken_branches = 0;
+
+    // Callees can grow the stack, and anything could happen to the memories, so these have to be reloaded after calls.
+    u64* locals = stack.entries().data() + locals_base;
+    auto* memory = memory_of(configuration, module);
+
+#define BRANCH(target_ip, stack_height, arity)                                                               \
+    do {                                                                                                     \
+        if (++taken_branches > Constants::max_allowed_taken_branches_per_call) [[unlikely]] {                \
+            m_trap = Trap { "Exceeded maximum allowed number of branches" };                                 \
+            return;                                                                                          \
+        }                                                                                                    \
+        dbgln_if(WASM_TRACE_DEBUG, "Branch to lowered instruction {}, with {} result(s)", target_ip, arity); \
+        stack.unwind(stack_base + (stack_height), (arity));                                                  \
+        pc = instructions + (target_ip);                                                                     \
+        DISPATCH();                                                                                          \
+    } while (false)
+
+#define AFTER_CALL()                                   \
+    do {                                               \
+        if (m_trap.has_value())                        \
+            return;                                    \
+        locals = stack.entries().data() + locals_base; \
+        memory = memory_of(configuration, module);     \
+        NEXT();                                        \
+    } while (false)
+
+#define NEXT()      \
+    do {            \
+        ++pc;       \
+        DISPATCH(); \
+    } while (false)
+
+#if WASM_COMPUTED_GOTO
+    static void const* const dispatch_table[] = {
+#    define __ENUMERATE_WASM_LOWERED_INSTRUCTION(name) &&handle_##name,
+        ENUMERATE_WASM_LOWERED_INSTRUCTIONS(__ENUMERATE_WASM_LOWERED_INSTRUCTION)
+#    undef __ENUMERATE_WASM_LOWERED_INSTRUCTION
+    };
+    // Every handler jumps to the next one through its own indirect jump, which gives the branch predictor
+    // a lot more to go on than a single switch would.
+#    define HANDLER(name) handle_##name:
+#    define DISPATCH() goto* dispatch_table[to_underlying(pc->opcode)]
+    DISPATCH();
+#else
+#    define HANDLER(name) case LoweredOpCode::name:
+#    define DISPATCH() goto dispatch
+dispatch:
+    switch (pc->opcode) {
+#endif
+
+    HANDLER(unreachable)
+    {
+        m_trap = Trap { "Unreachable" };
+        return;
+    }
+    HANDLER(unimplemented)
+    {
+        auto opcode = lowered->expression().instructions()[pc->argument].opcode();
+        dbgln("Instruction '{}' not implemented", instruction_name(opcode));
+        m_trap = Trap { String::formatted("Unimplemented instruction {}", instruction_name(opcode)) };
+        return;
+    }
+    HANDLER(constant)
+    {
+        stack.push(pc->immediate);
+        NEXT();
+    }
+    HANDLER(jump)
+    {
+        pc = instructions + pc->argument;
+        DISPATCH();
+    }
+    HANDLER(jump_if_zero)
+    {
+        if (stack.pop<i32>() == 0)
+            pc = instructions + pc->argument;
+        else
+            ++pc;
+        DISPATCH();
+    }
+    HANDLER(br)
+    {
+        BRANCH(pc->argument, pc->branch_stack_height(), pc->branch_arity());
+    }
+    HANDLER(br_if)
+    {
+        if (stack.pop<i32>() == 0)
+            NEXT();
+        BRANCH(pc->argument, pc->branch_stack_height(), pc->branch_arity());
+    }
+    HANDLER(br_table)
+    {
+        size_t index = stack.pop<u32>();
+        if (index >= pc->immediate)
+            index = pc->immediate - 1;
+        auto& target = lowered->lowered_branch_tables()[pc->argument + index];
+        BRANCH(target.ip.value(), target.stack_height, target.arity);
+    }
+    HANDLER(return_)
+    {
+        // The caller picks the results up from the top of the stack.
+        return;
+    }
+    HANDLER(call)
+    {
+        dbgln_if(WASM_TRACE_DEBUG, "call({})", pc->immediate);
+        call_address(configuration, FunctionAddress { pc->immediate });
+        AFTER_CALL();
+    }
+    HANDLER(call_indirect)
+    {
+        call_table_element(configuration, TableAddress { pc->immediate }, module.types()[pc->argument]);
+        AFTER_CALL();
+    }
+    HANDLER(local_get)
+    {
+        stack.push(locals[pc->argument]);
+        NEXT();
+    }
+    HANDLER(local_set)
+    {
+        locals[pc->argument] = stack.pop();
+        NEXT();
+    }
+    HANDLER(local_tee)
+    {
+        locals[pc->argument] = stack.peek();
+        NEXT();
+    }
+    HANDLER(global_get)
+    {
+        auto global = configuration.store().get(GlobalAddress { pc->immediate });
+        stack.push(value_to_slot(global->value()));
+        NEXT();
+    }
+    HANDLER(global_set)
+    {
+        auto global = configuration.store().get(GlobalAddress { pc->immediate });
+        global->set_value(value_from_slot(global->value().type(), stack.pop()));
+        NEXT();
+    }
+    HANDLER(memory_size)
+    {
+        TRAP_IF_NOT(memory);
+        stack.push(static_cast<i32>(memory->size() / Constants::page_size));
+        NEXT();
+    }
+    HANDLER(memory_grow)
+    {
+        TRAP_IF_NOT(memory);
+        i32 old_pages = memory->size() / Constants::page_size;
+        auto new_pages = stack.peek<u32>();
+        if (memory->grow(static_cast<u64>(new_pages) * Constants::page_size))
+            stack.peek() = to_slot(old_pages);
+        else
+            stack.peek() = to_slot(-1);
+        NEXT();
+    }
+
+#define __ENUMERATE_MEMORY_INSTRUCTION_HANDLER(name, ...) \
+    HANDLER(name)                                         \
+    {                                                     \
+        auto offset = pc->argument;                       \
+        __VA_ARGS__;                                      \
+        if (m_trap.has_value()) [[unlikely]]              \
+            return;                                       \
+        NEXT();                                           \
+    }
+    ENUMERATE_MEMORY_INSTRUCTION_HANDLERS(__ENUMERATE_MEMORY_INSTRUCTION_HANDLER)
+#undef __ENUMERATE_MEMORY_INSTRUCTION_HANDLER
+
+#define __ENUMERATE_STACK_INSTRUCTION_HANDLER(name, ...) \
+    HANDLER(name)                                        \
+    {                                                    \
+        __VA_ARGS__;                                     \
+        NEXT();                                          \
+    }
+    ENUMERATE_STACK_INSTRUCTION_HANDLERS(__ENUMERATE_STACK_INSTRUCTION_HANDLER)
+#undef __ENUMERATE_STACK_INSTRUCTION_HANDLER
+
+#if !WASM_COMPUTED_GOTO
+    }
+    VERIFY_NOT_REACHED();
+#endif
+
+#undef HANDLER
+#undef DISPATCH
+#undef NEXT
+#undef AFTER_CALL
+#undef BRANCH
+}
+
+void BytecodeInterpreter::interpret_lowered_instruction(Configuration& configuration, LoweredInstruction const& instruction)
+{
+    auto& module = configuration.frame().module();
+    switch (instruction.opcode) {
+    case LoweredOpCode::unreachable:
+        m_trap = Trap { "Unreachable" };
+        return;
+    case LoweredOpCode::unimplemented: {
+        auto opcode = configuration.frame().expression().instructions()[instruction.argument].opcode();
+        dbgln("Instruction '{}' not implemented", instruction_name(opcode));
+        m_trap = Trap { String::formatted("Unimplemented instruction {}", instruction_name(opcode)) };
+        return;
+    }
+    case LoweredOpCode::call:
+        call_address(configuration, FunctionAddress { instruction.immediate });
+        return;
+    case LoweredOpCode::call_indirect:
+        call_table_element(configuration, TableAddress { instruction.immediate }, module.types()[instruction.argument]);
+        return;
+    case LoweredOpCode::global_get: {
+        auto global = configuration.store().get(GlobalAddress { instruction.immediate });
+        configuration.stack().push(value_to_slot(global->value()));
+        return;
+    }
+    case LoweredOpCode::global_set: {
+        auto global = configuration.store().get(GlobalAddress { instruction.immediate });
+        global->set_value(value_from_slot(global->value().type(), configuration.stack().pop()));
+        return;
+    }
+    case LoweredOpCode::memory_size: {
+        auto* memory = memory_of(configuration, module);
+        TRAP_IF_NOT(memory);
+        configuration.stack().push(static_cast<i32>(memory->size() / Constants::page_size));
+        return;
+    }
+    case LoweredOpCode::memory_grow: {
+        auto* memory = memory_of(configuration, module);
+        TRAP_IF_NOT(memory);
+        i32 old_pages = memory->size() / Constants::page_size;
+        auto new_pages = configuration.stack().peek<u32>();
+        if (memory->grow(static_cast<u64>(new_pages) * Constants::page_size))
+            configuration.stack().peek() = to_slot(old_pages);
+        else
+            configuration.stack().peek() = to_slot(-1);
+        return;
+    }
+#define __ENUMERATE_MEMORY_INSTRUCTION_HANDLER(name, ...) \
+    case LoweredOpCode::name: {                           \
+        auto* memory = memory_of(configuration, module);  \
+        auto offset = instruction.argument;               \
+        __VA_ARGS__;                                      \
+        return;                                           \
+    }
+        ENUMERATE_MEMORY_INSTRUCTION_HANDLERS(__ENUMERATE_MEMORY_INSTRUCTION_HANDLER)
+#undef __ENUMERATE_MEMORY_INSTRUCTION_HANDLER
+#define __ENUMERATE_STACK_INSTRUCTION_HANDLER(name, ...) \
+    case LoweredOpCode::name: {                          \
+        __VA_ARGS__;                                     \
+        return;                                          \
+    }
+        ENUMERATE_STACK_INSTRUCTION_HANDLERS(__ENUMERATE_STACK_INSTRUCTION_HANDLER)
+#undef __ENUMERATE_STACK_INSTRUCTION_HANDLER
+    default:
+        // Branches only make sense in the middle of an expression.
+        VERIFY_NOT_REACHED();
+    }
+}
+
 void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPointer& ip, Instruction const& instruction)
 {
     dbgln_if(WASM_TRACE_DEBUG, "Executing instruction {} at ip {}", instruction_name(instruction.opcode()), ip.value());
@@ -502,127 +954,51 @@ void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPoi
     case Instructions::nop.value():
         return;
     case Instructions::local_get.value():
-        configuration.stack().push(Value(configuration.frame().locals()[instruction.arguments().get<LocalIndex>().value()]));
+        configuration.stack().push(configuration.stack().entries()[configuration.frame().locals_base() + instruction.arguments().get<LocalIndex>().value()]);
         return;
-    case Instructions::local_set.value(): {
-        TRAP_IF_NOT(!configuration.stack().is_empty());
-        auto entry = configuration.stack().pop();
-        TRAP_IF_NOT(entry.has<Value>());
-        configuration.frame().locals()[instruction.arguments().get<LocalIndex>().value()] = move(entry.get<Value>());
+    case Instructions::local_set.value():
+        configuration.stack().entries()[configuration.frame().locals_base() + instruction.arguments().get<LocalIndex>().value()] = configuration.stack().pop();
         return;
-    }
     case Instructions::i32_const.value():
-        configuration.stack().push(Value(ValueType { ValueType::I32 }, static_cast<i64>(instruction.arguments().get<i32>())));
+        configuration.stack().push(instruction.arguments().get<i32>());
         return;
     case Instructions::i64_const.value():
-        configuration.stack().push(Value(ValueType { ValueType::I64 }, instruction.arguments().get<i64>()));
+        configuration.stack().push(instruction.arguments().get<i64>());
         return;
     case Instructions::f32_const.value():
-        configuration.stack().push(Value(ValueType { ValueType::F32 }, static_cast<double>(instruction.arguments().get<float>())));
+        configuration.stack().push(instruction.arguments().get<float>());
         return;
     case Instructions::f64_const.value():
-        configuration.stack().push(Value(ValueType { ValueType::F64 }, instruction.arguments().get<double>()));
+        configuration.stack().push(instruction.arguments().get<double>());
         return;
-    case Instructions::block.value(): {
-        size_t arity = 0;
-        auto& args = instruction.arguments().get<Instruction::StructuredInstructionArgs>();
-        if (args.block_type.kind() != BlockType::Empty)
-            arity = 1;
-        configuration.stack().push(Label(arity, args.end_ip));
+    case Instructions::block.value():
+    case Instructions::loop.value():
+    case Instructions::structured_end.value():
+        // Branches already know where they go and how much of the stack they keep, so blocks don't do anything here.
         return;
-    }
-    case Instructions::loop.value(): {
-        size_t arity = 0;
-        auto& args = instruction.arguments().get<Instruction::StructuredInstructionArgs>();
-        if (args.block_type.kind() != BlockType::Empty)
-            arity = 1;
-        configuration.stack().push(Label(arity, ip.value() + 1));
+    case Instructions::if_.value():
+        if (configuration.stack().pop<i32>() == 0)
+            configuration.ip() = configuration.frame().lowered()->branch_target(ip).ip;
         return;
-    }
-    case Instructions::if_.value(): {
-        size_t arity = 0;
-        auto& args = instruction.arguments().get<Instruction::StructuredInstructionArgs>();
-        if (args.block_type.kind() != BlockType::Empty)
-            arity = 1;
-
-        TRAP_IF_NOT(!configuration.stack().is_empty());
-        auto entry = configuration.stack().pop();
-        TRAP_IF_NOT(entry.has<Value>());
-        auto value = entry.get<Value>().to<i32>();
-        TRAP_IF_NOT(value.has_value());
-        auto end_label = Label(arity, args.end_ip.value());
-        if (value.value() == 0) {
-            if (args.else_ip.has_value()) {
-                configuration.ip() = args.else_ip.value();
-                configuration.stack().push(move(end_label));
-            } else {
-                configuration.ip() = args.end_ip.value() + 1;
-            }
-        } else {
-            configuration.stack().push(move(end_label));
-        }
-        return;
-    }
-    case Instructions::structured_end.value():
-    case Instructions::structured_else.value(): {
-        auto label = configuration.nth_label(0);
-        TRAP_IF_NOT(label.has_value());
-        size_t end = configuration.stack().size() - label->arity() - 1;
-        size_t start = end;
-        while (start > 0 && start < configuration.stack().size() && !configuration.stack().entries()[start].has<Label>())
-            --start;
-
-        configuration.stack().entries().remove(start, end - start + 1);
-
-        if (instruction.opcode() == Instructions::structured_end)
-            return;
-
-        // Jump to the end label
-        configuration.ip() = label->continuation();
+    case Instructions::structured_else.value():
+        configuration.ip() = configuration.frame().lowered()->branch_target(ip).ip;
         return;
-    }
-    case Instructions::return_.value(): {
-        auto& frame = configuration.frame();
-        size_t end = configuration.stack().size() - frame.arity();
-        size_t start = end;
-        for (; start + 1 > 0 && start < configuration.stack().size(); --start) {
-            auto& entry = configuration.stack().entries()[start];
-            if (entry.has<Frame>()) {
-                // Leave the frame, _and_ its label.
-                start += 2;
-                break;
-            }
-        }
-
-        configuration.stack().entries().remove(start, end - start);
-
-        // Jump past the call/indirect instruction
+    case Instructions::return_.value():
+        // The caller picks the results up from the top of the stack.
         configuration.ip() = configuration.frame().expression().instructions().size();
         return;
-    }
     case Instructions::br.value():
-        return branch_to_label(configuration, instruction.arguments().get<LabelIndex>());
-    case Instructions::br_if.value(): {
-        TRAP_IF_NOT(!configuration.stack().is_empty());
-        auto entry = configuration.stack().pop();
-        TRAP_IF_NOT(entry.has<Value>());
-        if (entry.get<Value>().to<i32>().value_or(0) == 0)
+        return branch_to(configuration, configuration.frame().lowered()->branch_target(ip));
+    case Instructions::br_if.value():
+        if (configuration.stack().pop<i32>() == 0)
             return;
-        return branch_to_label(configuration, instruction.arguments().get<LabelIndex>());
-    }
+        return branch_to(configuration, configuration.frame().lowered()->branch_target(ip));
     case Instructions::br_table.value(): {
-        auto& arguments = instruction.arguments().get<Instruction::TableBranchArgs>();
-        TRAP_IF_NOT(!configuration.stack().is_empty());
-        auto entry = configuration.stack().pop();
-        TRAP_IF_NOT(entry.has<Value>());
-        auto maybe_i = entry.get<Value>().to<i32>();
-        TRAP_IF_NOT(maybe_i.has_value());
-        if (0 <= *maybe_i) {
-            size_t i = *maybe_i;
-            if (i < arguments.labels.size())
-                return branch_to_label(configuration, arguments.labels[i]);
-        }
-        return branch_to_label(configuration, arguments.default_);
+        auto targets = configuration.frame().lowered()->branch_table(ip);
+        size_t index = configuration.stack().pop<u32>();
+        if (index >= targets.size())
+            index = targets.size() - 1;
+        return branch_to(configuration, targets[index]);
     }
     case Instructions::call.value(): {
         auto index = instruction.arguments().get<FunctionIndex>();
@@ -636,77 +1012,22 @@ void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPoi
         auto& args = instruction.arguments().get<Instruction::IndirectCallArgs>();
         TRAP_IF_NOT(args.table.value() < configuration.frame().module().tables().size());
         auto table_address = configuration.frame().module().tables()[args.table.value()];
-        auto table_instance = configuration.store().get(table_address);
-        TRAP_IF_NOT(!configuration.stack().is_empty());
-        auto entry = configuration.stack().pop();
-        TRAP_IF_NOT(entry.has<Value>());
-        auto index = entry.get<Value>().to<i32>();
-        TRAP_IF_NOT(index.has_value());
-        TRAP_IF_NOT(index.value() >= 0);
-        TRAP_IF_NOT(static_cast<size_t>(index.value()) < table_instance->elements().size());
-        auto element = table_instance->elements()[index.value()];
-        TRAP_IF_NOT(element.has_value());
-        TRAP_IF_NOT(element->ref().has<Reference::Func>());
-        auto address = element->ref().get<Reference::Func>().address;
-        dbgln_if(WASM_TRACE_DEBUG, "call_indirect({} -> {})", index.value(), address.value());
-        call_address(configuration, address);
+        call_table_element(configuration, table_address, configuration.frame().module().types()[args.type.value()]);
         return;
     }
-    case Instructions::i32_load.value():
-        LOAD_AND_PUSH(i32, i32);
-    case Instructions::i64_load.value():
-        LOAD_AND_PUSH(i64, i64);
-    case Instructions::f32_load.value():
-        LOAD_AND_PUSH(float, float);
-    case Instructions::f64_load.value():
-        LOAD_AND_PUSH(double, double);
-    case Instructions::i32_load8_s.value():
-        LOAD_AND_PUSH(i8, i32);
-    case Instructions::i32_load8_u.value():
-        LOAD_AND_PUSH(u8, i32);
-    case Instructions::i32_load16_s.value():
-        LOAD_AND_PUSH(i16, i32);
-    case Instructions::i32_load16_u.value():
-        LOAD_AND_PUSH(u16, i32);
-    case Instructions::i64_load8_s.value():
-        LOAD_AND_PUSH(i8, i64);
-    case Instructions::i64_load8_u.value():
-        LOAD_AND_PUSH(u8, i64);
-    case Instructions::i64_load16_s.value():
-        LOAD_AND_PUSH(i16, i64);
-    case Instructions::i64_load16_u.value():
-        LOAD_AND_PUSH(u16, i64);
-    case Instructions::i64_load32_s.value():
-        LOAD_AND_PUSH(i32, i64);
-    case Instructions::i64_load32_u.value():
-        LOAD_AND_PUSH(u32, i64);
-    case Instructions::i32_store.value():
-        POP_AND_STORE(i32, i32);
-    case Instructions::i64_store.value():
-        POP_AND_STORE(i64, i64);
-    case Instructions::f32_store.value():
-        POP_AND_STORE(float, float);
-    case Instructions::f64_store.value():
-        POP_AND_STORE(double, double);
-    case Instructions::i32_store8.value():
-        POP_AND_STORE(i32, i8);
-    case Instructions::i32_store16.value():
-        POP_AND_STORE(i32, i16);
-    case Instructions::i64_store8.value():
-        POP_AND_STORE(i64, i8);
-    case Instructions::i64_store16.value():
-        POP_AND_STORE(i64, i16);
-    case Instructions::i64_store32.value():
-        POP_AND_STORE(i64, i32);
+#define __ENUMERATE_MEMORY_INSTRUCTION_HANDLER(name, ...)                                \
+    case Instructions::name.value(): {                                                   \
+        auto* memory = memory_of(configuration, configuration.frame().module());         \
+        auto offset = instruction.arguments().get<Instruction::MemoryArgument>().offset; \
+        __VA_ARGS__;                                                                     \
+        return;                                                                          \
+    }
+        ENUMERATE_MEMORY_INSTRUCTION_HANDLERS(__ENUMERATE_MEMORY_INSTRUCTION_HANDLER)
+#undef __ENUMERATE_MEMORY_INSTRUCTION_HANDLER
     case Instructions::local_tee.value(): {
-        TRAP_IF_NOT(!configuration.stack().is_empty());
-        auto& entry = configuration.stack().peek();
-        TRAP_IF_NOT(entry.has<Value>());
-        auto value = entry.get<Value>();
         auto local_index = instruction.arguments().get<LocalIndex>();
-        TRAP_IF_NOT(configuration.frame().locals().size() > local_index.value());
         dbgln_if(WASM_TRACE_DEBUG, "stack:peek -> locals({})", local_index.value());
-        configuration.frame().locals()[local_index.value()] = move(value);
+        configuration.stack().entries()[configuration.frame().locals_base() + local_index.value()] = configuration.stack().peek();
         return;
     }
     case Instructions::global_get.value(): {
@@ -715,20 +1036,16 @@ void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPoi
         auto address = configuration.frame().module().globals()[global_index.value()];
         dbgln_if(WASM_TRACE_DEBUG, "global({}) -> stack", address.value());
         auto global = configuration.store().get(address);
-        configuration.stack().push(Value(global->value()));
+        configuration.stack().push(value_to_slot(global->value()));
         return;
     }
     case Instructions::global_set.value(): {
         auto global_index = instruction.arguments().get<GlobalIndex>();
         TRAP_IF_NOT(configuration.frame().module().globals().size() > global_index.value());
         auto address = configuration.frame().module().globals()[global_index.value()];
-        TRAP_IF_NOT(!configuration.stack().is_empty());
-        auto entry = configuration.stack().pop();
-        TRAP_IF_NOT(entry.has<Value>());
-        auto value = entry.get<Value>();
         dbgln_if(WASM_TRACE_DEBUG, "stack -> global({})", address.value());
         auto global = configuration.store().get(address);
-        global->set_value(move(value));
+        global->set_value(value_from_slot(global->value().type(), configuration.stack().pop()));
         return;
     }
     case Instructions::memory_size.value(): {
@@ -737,7 +1054,7 @@ void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPoi
         auto instance = configuration.store().get(address);
         auto pages = instance->size() / Constants::page_size;
         dbgln_if(WASM_TRACE_DEBUG, "memory.size -> stack({})", pages);
-        configuration.stack().push(Value((i32)pages));
+        configuration.stack().push(static_cast<i32>(pages));
         return;
     }
     case Instructions::memory_grow.value(): {
@@ -745,354 +1062,38 @@ void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPoi
         auto address = configuration.frame().module().memories()[0];
         auto instance = configuration.store().get(address);
         i32 old_pages = instance->size() / Constants::page_size;
-        TRAP_IF_NOT(!configuration.stack().is_empty());
-        auto& entry = configuration.stack().peek();
-        TRAP_IF_NOT(entry.has<Value>());
-        auto new_pages = entry.get<Value>().to<i32>();
-        TRAP_IF_NOT(new_pages.has_value());
-        dbgln_if(WASM_TRACE_DEBUG, "memory.grow({}), previously {} pages...", *new_pages, old_pages);
-        if (instance->grow(new_pages.value() * Constants::page_size))
-            configuration.stack().peek() = Value((i32)old_pages);
+        auto new_pages = configuration.stack().peek<u32>();
+        dbgln_if(WASM_TRACE_DEBUG, "memory.grow({}), previously {} pages...", new_pages, old_pages);
+        if (instance->grow(static_cast<u64>(new_pages) * Constants::page_size))
+            configuration.stack().peek() = to_slot(old_pages);
         else
-            configuration.stack().peek() = Value((i32)-1);
+            configuration.stack().peek() = to_slot(-1);
         return;
     }
     case Instructions::table_get.value():
     case Instructions::table_set.value():
         goto unimplemented;
-    case Instructions::ref_null.value(): {
-        auto type = instruction.arguments().get<ValueType>();
-        TRAP_IF_NOT(type.is_reference());
-        configuration.stack().push(Value(Reference(Reference::Null { type })));
+    case Instructions::ref_null.value():
+        configuration.stack().push(value_to_slot(Value(Reference(Reference::Null { instruction.arguments().get<ValueType>() }))));
         return;
-    };
     case Instructions::ref_func.value(): {
         auto index = instruction.arguments().get<FunctionIndex>().value();
         auto& functions = configuration.frame().module().functions();
         TRAP_IF_NOT(functions.size() > index);
-        auto address = functions[index];
-        configuration.stack().push(Value(ValueType(ValueType::FunctionReference), address.value()));
+        configuration.stack().push(value_to_slot(Value(Reference(Reference::Func { functions[index] }))));
         return;
     }
-    case Instructions::ref_is_null.value(): {
-        TRAP_IF_NOT(!configuration.stack().is_empty());
-        auto top = configuration.stack().peek().get_pointer<Value>();
-        TRAP_IF_NOT(top);
-        TRAP_IF_NOT(top->type().is_reference());
-        auto is_null = top->to<Reference::Null>().has_value();
-        configuration.stack().peek() = Value(ValueType(ValueType::I32), static_cast<u64>(is_null ? 1 : 0));
-        return;
-    }
-    case Instructions::drop.value():
-        TRAP_IF_NOT(!configuration.stack().is_empty());
-        configuration.stack().pop();
-        return;
-    case Instructions::select.value():
-    case Instructions::select_typed.value(): {
+    case Instructions::select_typed.value():
         // Note: The type seems to only be used for validation.
-        TRAP_IF_NOT(!configuration.stack().is_empty());
-        auto entry = configuration.stack().pop();
-        TRAP_IF_NOT(entry.has<Value>());
-        auto value = entry.get<Value>().to<i32>();
-        TRAP_IF_NOT(value.has_value());
-        dbgln_if(WASM_TRACE_DEBUG, "select({})", value.value());
-        auto rhs_entry = configuration.stack().pop();
-        TRAP_IF_NOT(rhs_entry.has<Value>());
-        auto& lhs_entry = configuration.stack().peek();
-        TRAP_IF_NOT(lhs_entry.has<Value>());
-        auto rhs = move(rhs_entry.get<Value>());
-        auto lhs = move(lhs_entry.get<Value>());
-        configuration.stack().peek() = value.value() != 0 ? move(lhs) : move(rhs);
+        SELECT();
         return;
+#define __ENUMERATE_STACK_INSTRUCTION_HANDLER(name, ...) \
+    case Instructions::name.value(): {                   \
+        __VA_ARGS__;                                     \
+        return;                                          \
     }
-    case Instructions::i32_eqz.value():
-        UNARY_NUMERIC_OPERATION(i32, 0 ==);
-    case Instructions::i32_eq.value():
-        BINARY_NUMERIC_OPERATION(i32, ==, i32);
-    case Instructions::i32_ne.value():
-        BINARY_NUMERIC_OPERATION(i32, !=, i32);
-    case Instructions::i32_lts.value():
-        BINARY_NUMERIC_OPERATION(i32, <, i32);
-    case Instructions::i32_ltu.value():
-        BINARY_NUMERIC_OPERATION(u32, <, i32);
-    case Instructions::i32_gts.value():
-        BINARY_NUMERIC_OPERATION(i32, >, i32);
-    case Instructions::i32_gtu.value():
-        BINARY_NUMERIC_OPERATION(u32, >, i32);
-    case Instructions::i32_les.value():
-        BINARY_NUMERIC_OPERATION(i32, <=, i32);
-    case Instructions::i32_leu.value():
-        BINARY_NUMERIC_OPERATION(u32, <=, i32);
-    case Instructions::i32_ges.value():
-        BINARY_NUMERIC_OPERATION(i32, >=, i32);
-    case Instructions::i32_geu.value():
-        BINARY_NUMERIC_OPERATION(u32, >=, i32);
-    case Instructions::i64_eqz.value():
-        UNARY_NUMERIC_OPERATION(i64, 0ull ==);
-    case Instructions::i64_eq.value():
-        BINARY_NUMERIC_OPERATION(i64, ==, i32);
-    case Instructions::i64_ne.value():
-        BINARY_NUMERIC_OPERATION(i64, !=, i32);
-    case Instructions::i64_lts.value():
-        BINARY_NUMERIC_OPERATION(i64, <, i32);
-    case Instructions::i64_ltu.value():
-        BINARY_NUMERIC_OPERATION(u64, <, i32);
-    case Instructions::i64_gts.value():
-        BINARY_NUMERIC_OPERATION(i64, >, i32);
-    case Instructions::i64_gtu.value():
-        BINARY_NUMERIC_OPERATION(u64, >, i32);
-    case Instructions::i64_les.value():
-        BINARY_NUMERIC_OPERATION(i64, <=, i32);
-    case Instructions::i64_leu.value():
-        BINARY_NUMERIC_OPERATION(u64, <=, i32);
-    case Instructions::i64_ges.value():
-        BINARY_NUMERIC_OPERATION(i64, >=, i32);
-    case Instructions::i64_geu.value():
-        BINARY_NUMERIC_OPERATION(u64, >=, i32);
-    case Instructions::f32_eq.value():
-        BINARY_NUMERIC_OPERATION(float, ==, i32);
-    case Instructions::f32_ne.value():
-        BINARY_NUMERIC_OPERATION(float, !=, i32);
-    case Instructions::f32_lt.value():
-        BINARY_NUMERIC_OPERATION(float, <, i32);
-    case Instructions::f32_gt.value():
-        BINARY_NUMERIC_OPERATION(float, >, i32);
-    case Instructions::f32_le.value():
-        BINARY_NUMERIC_OPERATION(float, <=, i32);
-    case Instructions::f32_ge.value():
-        BINARY_NUMERIC_OPERATION(float, >=, i32);
-    case Instructions::f64_eq.value():
-        BINARY_NUMERIC_OPERATION(double, ==, i32);
-    case Instructions::f64_ne.value():
-        BINARY_NUMERIC_OPERATION(double, !=, i32);
-    case Instructions::f64_lt.value():
-        BINARY_NUMERIC_OPERATION(double, <, i32);
-    case Instructions::f64_gt.value():
-        BINARY_NUMERIC_OPERATION(double, >, i32);
-    case Instructions::f64_le.value():
-        BINARY_NUMERIC_OPERATION(double, <=, i32);
-    case Instructions::f64_ge.value():
-        BINARY_NUMERIC_OPERATION(double, >, i32);
-    case Instructions::i32_clz.value():
-        UNARY_NUMERIC_OPERATION(i32, clz);
-    case Instructions::i32_ctz.value():
-        UNARY_NUMERIC_OPERATION(i32, ctz);
-    case Instructions::i32_popcnt.value():
-        UNARY_NUMERIC_OPERATION(i32, __builtin_popcount);
-    case Instructions::i32_add.value():
-        BINARY_NUMERIC_OPERATION(i32, +, i32);
-    case Instructions::i32_sub.value():
-        BINARY_NUMERIC_OPERATION(i32, -, i32);
-    case Instructions::i32_mul.value():
-        BINARY_NUMERIC_OPERATION(i32, *, i32);
-    case Instructions::i32_divs.value():
-        BINARY_NUMERIC_OPERATION(i32, /, i32, TRAP_IF_NOT(!(Checked<i32>(lhs.value()) /= rhs.value()).has_overflow()));
-    case Instructions::i32_divu.value():
-        BINARY_NUMERIC_OPERATION(u32, /, i32, TRAP_IF_NOT(rhs.value() != 0));
-    case Instructions::i32_rems.value():
-        BINARY_NUMERIC_OPERATION(i32, %, i32, TRAP_IF_NOT(!(Checked<i32>(lhs.value()) /= rhs.value()).has_overflow()));
-    case Instructions::i32_remu.value():
-        BINARY_NUMERIC_OPERATION(u32, %, i32, TRAP_IF_NOT(rhs.value() != 0));
-    case Instructions::i32_and.value():
-        BINARY_NUMERIC_OPERATION(i32, &, i32);
-    case Instructions::i32_or.value():
-        BINARY_NUMERIC_OPERATION(i32, |, i32);
-    case Instructions::i32_xor.value():
-        BINARY_NUMERIC_OPERATION(i32, ^, i32);
-    case Instructions::i32_shl.value():
-        BINARY_NUMERIC_OPERATION(i32, <<, i32);
-    case Instructions::i32_shrs.value():
-        BINARY_NUMERIC_OPERATION(i32, >>, i32);
-    case Instructions::i32_shru.value():
-        BINARY_NUMERIC_OPERATION(u32, >>, i32);
-    case Instructions::i32_rotl.value():
-        BINARY_PREFIX_NUMERIC_OPERATION(u32, rotl, i32);
-    case Instructions::i32_rotr.value():
-        BINARY_PREFIX_NUMERIC_OPERATION(u32, rotr, i32);
-    case Instructions::i64_clz.value():
-        UNARY_NUMERIC_OPERATION(i64, clz);
-    case Instructions::i64_ctz.value():
-        UNARY_NUMERIC_OPERATION(i64, ctz);
-    case Instructions::i64_popcnt.value():
-        UNARY_NUMERIC_OPERATION(i64, __builtin_popcountll);
-    case Instructions::i64_add.value():
-        BINARY_NUMERIC_OPERATION(i64, +, i64);
-    case Instructions::i64_sub.value():
-        BINARY_NUMERIC_OPERATION(i64, -, i64);
-    case Instructions::i64_mul.value():
-        BINARY_NUMERIC_OPERATION(i64, *, i64);
-    case Instructions::i64_divs.value():
-        OVF_CHECKED_BINARY_NUMERIC_OPERATION(i64, /, i64, TRAP_IF_NOT(rhs.value() != 0));
-    case Instructions::i64_divu.value():
-        OVF_CHECKED_BINARY_NUMERIC_OPERATION(u64, /, i64, TRAP_IF_NOT(rhs.value() != 0));
-    case Instructions::i64_rems.value():
-        BINARY_NUMERIC_OPERATION(i64, %, i64, TRAP_IF_NOT(!(Checked<i32>(lhs.value()) /= rhs.value()).has_overflow()));
-    case Instructions::i64_remu.value():
-        BINARY_NUMERIC_OPERATION(u64, %, i64, TRAP_IF_NOT(rhs.value() != 0));
-    case Instructions::i64_and.value():
-        BINARY_NUMERIC_OPERATION(i64, &, i64);
-    case Instructions::i64_or.value():
-        BINARY_NUMERIC_OPERATION(i64, |, i64);
-    case Instructions::i64_xor.value():
-        BINARY_NUMERIC_OPERATION(i64, ^, i64);
-    case Instructions::i64_shl.value():
-        BINARY_NUMERIC_OPERATION(i64, <<, i64);
-    case Instructions::i64_shrs.value():
-        BINARY_NUMERIC_OPERATION(i64, >>, i64);
-    case Instructions::i64_shru.value():
-        BINARY_NUMERIC_OPERATION(u64, >>, i64);
-    case Instructions::i64_rotl.value():
-        BINARY_PREFIX_NUMERIC_OPERATION(u64, rotl, i64);
-    case Instructions::i64_rotr.value():
-        BINARY_PREFIX_NUMERIC_OPERATION(u64, rotr, i64);
-    case Instructions::f32_abs.value():
-        UNARY_NUMERIC_OPERATION(float, fabsf);
-    case Instructions::f32_neg.value():
-        UNARY_NUMERIC_OPERATION(float, -);
-    case Instructions::f32_ceil.value():
-        UNARY_NUMERIC_OPERATION(float, ceilf);
-    case Instructions::f32_floor.value():
-        UNARY_NUMERIC_OPERATION(float, floorf);
-    case Instructions::f32_trunc.value():
-        UNARY_NUMERIC_OPERATION(float, truncf);
-    case Instructions::f32_nearest.value():
-        UNARY_NUMERIC_OPERATION(float, roundf);
-    case Instructions::f32_sqrt.value():
-        UNARY_NUMERIC_OPERATION(float, sqrtf);
-    case Instructions::f32_add.value():
-        BINARY_NUMERIC_OPERATION(float, +, float);
-    case Instructions::f32_sub.value():
-        BINARY_NUMERIC_OPERATION(float, -, float);
-    case Instructions::f32_mul.value():
-        BINARY_NUMERIC_OPERATION(float, *, float);
-    case Instructions::f32_div.value():
-        BINARY_NUMERIC_OPERATION(float, /, float);
-    case Instructions::f32_min.value():
-        BINARY_PREFIX_NUMERIC_OPERATION(float, float_min, float);
-    case Instructions::f32_max.value():
-        BINARY_PREFIX_NUMERIC_OPERATION(float, float_max, float);
-    case Instructions::f32_copysign.value():
-        BINARY_PREFIX_NUMERIC_OPERATION(float, copysignf, float);
-    case Instructions::f64_abs.value():
-        UNARY_NUMERIC_OPERATION(double, fabs);
-    case Instructions::f64_neg.value():
-        UNARY_NUMERIC_OPERATION(double, -);
-    case Instructions::f64_ceil.value():
-        UNARY_NUMERIC_OPERATION(double, ceil);
-    case Instructions::f64_floor.value():
-        UNARY_NUMERIC_OPERATION(double, floor);
-    case Instructions::f64_trunc.value():
-        UNARY_NUMERIC_OPERATION(double, trunc);
-    case Instructions::f64_nearest.value():
-        UNARY_NUMERIC_OPERATION(double, round);
-    case Instructions::f64_sqrt.value():
-        UNARY_NUMERIC_OPERATION(double, sqrt);
-    case Instructions::f64_add.value():
-        BINARY_NUMERIC_OPERATION(double, +, double);
-    case Instructions::f64_sub.value():
-        BINARY_NUMERIC_OPERATION(double, -, double);
-    case Instructions::f64_mul.value():
-        BINARY_NUMERIC_OPERATION(double, *, double);
-    case Instructions::f64_div.value():
-        BINARY_NUMERIC_OPERATION(double, /, double);
-    case Instructions::f64_min.value():
-        BINARY_PREFIX_NUMERIC_OPERATION(double, float_min, double);
-    case Instructions::f64_max.value():
-        BINARY_PREFIX_NUMERIC_OPERATION(double, float_max, double);
-    case Instructions::f64_copysign.value():
-        BINARY_PREFIX_NUMERIC_OPERATION(double, copysign, double);
-    case Instructions::i32_wrap_i64.value():
-        UNARY_MAP(i64, i32, i32);
-    case Instructions::i32_trunc_sf32.value(): {
-        auto fn = [this](auto& v) { return checked_signed_truncate<float, i32>(v); };
-        UNARY_MAP(float, fn, i32);
-    }
-    case Instructions::i32_trunc_uf32.value(): {
-        auto fn = [this](auto& value) { return checked_unsigned_truncate<float, i32>(value); };
-        UNARY_MAP(float, fn, i32);
-    }
-    case Instructions::i32_trunc_sf64.value(): {
-        auto fn = [this](auto& value) { return checked_signed_truncate<double, i32>(value); };
-        UNARY_MAP(double, fn, i32);
-    }
-    case Instructions::i32_trunc_uf64.value(): {
-        auto fn = [this](auto& value) { return checked_unsigned_truncate<double, i32>(value); };
-        UNARY_MAP(double, fn, i32);
-    }
-    case Instructions::i64_trunc_sf32.value(): {
-        auto fn = [this](auto& value) { return checked_signed_truncate<float, i64>(value); };
-        UNARY_MAP(float, fn, i64);
-    }
-    case Instructions::i64_trunc_uf32.value(): {
-        auto fn = [this](auto& value) { return checked_unsigned_truncate<float, i64>(value); };
-        UNARY_MAP(float, fn, i64);
-    }
-    case Instructions::i64_trunc_sf64.value(): {
-        auto fn = [this](auto& value) { return checked_signed_truncate<double, i64>(value); };
-        UNARY_MAP(double, fn, i64);
-    }
-    case Instructions::i64_trunc_uf64.value(): {
-        auto fn = [this](auto& value) { return checked_unsigned_truncate<double, i64>(value); };
-        UNARY_MAP(double, fn, i64);
-    }
-    case Instructions::i64_extend_si32.value():
-        UNARY_MAP(i32, i64, i64);
-    case Instructions::i64_extend_ui32.value():
-        UNARY_MAP(u32, i64, i64);
-    case Instructions::f32_convert_si32.value():
-        UNARY_MAP(i32, float, float);
-    case Instructions::f32_convert_ui32.value():
-        UNARY_MAP(u32, float, float);
-    case Instructions::f32_convert_si64.value():
-        UNARY_MAP(i64, float, float);
-    case Instructions::f32_convert_ui64.value():
-        UNARY_MAP(u32, float, float);
-    case Instructions::f32_demote_f64.value():
-        UNARY_MAP(double, float, float);
-    case Instructions::f64_convert_si32.value():
-        UNARY_MAP(i32, double, double);
-    case Instructions::f64_convert_ui32.value():
-        UNARY_MAP(u32, double, double);
-    case Instructions::f64_convert_si64.value():
-        UNARY_MAP(i64, double, double);
-    case Instructions::f64_convert_ui64.value():
-        UNARY_MAP(u64, double, double);
-    case Instructions::f64_promote_f32.value():
-        UNARY_MAP(float, double, double);
-    case Instructions::i32_reinterpret_f32.value():
-        UNARY_MAP(float, bit_cast<i32>, i32);
-    case Instructions::i64_reinterpret_f64.value():
-        UNARY_MAP(double, bit_cast<i64>, i64);
-    case Instructions::f32_reinterpret_i32.value():
-        UNARY_MAP(i32, bit_cast<float>, float);
-    case Instructions::f64_reinterpret_i64.value():
-        UNARY_MAP(i64, bit_cast<double>, double);
-    case Instructions::i32_extend8_s.value():
-        UNARY_MAP(i32, (extend_signed<i8, i32>), i32);
-    case Instructions::i32_extend16_s.value():
-        UNARY_MAP(i32, (extend_signed<i16, i32>), i32);
-    case Instructions::i64_extend8_s.value():
-        UNARY_MAP(i64, (extend_signed<i8, i64>), i64);
-    case Instructions::i64_extend16_s.value():
-        UNARY_MAP(i64, (extend_signed<i16, i64>), i64);
-    case Instructions::i64_extend32_s.value():
-        UNARY_MAP(i64, (extend_signed<i32, i64>), i64);
-    case Instructions::i32_trunc_sat_f32_s.value():
-        UNARY_MAP(float, saturating_truncate<i32>, i32);
-    case Instructions::i32_trunc_sat_f32_u.value():
-        UNARY_MAP(float, saturating_truncate<u32>, i32);
-    case Instructions::i32_trunc_sat_f64_s.value():
-        UNARY_MAP(double, saturating_truncate<i32>, i32);
-    case Instructions::i32_trunc_sat_f64_u.value():
-        UNARY_MAP(double, saturating_truncate<u32>, i32);
-    case Instructions::i64_trunc_sat_f32_s.value():
-        UNARY_MAP(float, saturating_truncate<i64>, i64);
-    case Instructions::i64_trunc_sat_f32_u.value():
-        UNARY_MAP(float, saturating_truncate<u64>, i64);
-    case Instructions::i64_trunc_sat_f64_s.value():
-        UNARY_MAP(double, saturating_truncate<i64>, i64);
-    case Instructions::i64_trunc_sat_f64_u.value():
-        UNARY_MAP(double, saturating_truncate<u64>, i64);
+        ENUMERATE_STACK_INSTRUCTION_HANDLERS(__ENUMERATE_STACK_INSTRUCTION_HANDLER)
+#undef __ENUMERATE_STACK_INSTRUCTION_HANDLER
     case Instructions::memory_init.value():
     case Instructions::data_drop.value():
     case Instructions::memory_copy.value():
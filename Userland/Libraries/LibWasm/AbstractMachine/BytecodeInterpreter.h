@@ -8,6 +8,7 @@
 
 #include <LibWasm/AbstractMachine/Configuration.h>
 #include <LibWasm/AbstractMachine/Interpreter.h>
+#include <LibWasm/JIT/Compiler.h>
 
 namespace Wasm {
 
@@ -31,13 +32,25 @@ struct BytecodeInterpreter : public Interpreter {
         BytecodeInterpreter& m_interpreter;
     };
 
+    // Runs a single lowered instruction that doesn't branch, with its operands on top of the stack. This is how
+    // compiled code gets the interpreter to do what it doesn't do itself.
+    void interpret_lowered_instruction(Configuration&, LoweredInstruction const&);
+
+    // How often an expression has to run before it's compiled to machine code, or empty to never compile anything.
+    void set_jit_threshold(Optional<size_t> threshold) { m_jit_threshold = threshold; }
+
 protected:
+    // Runs the frame's Instructions one at a time instead of its lowered form. This is a lot slower,
+    // but gives subclasses a chance to look at every instruction before and after it runs.
+    void step_through_instructions(Configuration&);
     virtual void interpret(Configuration&, InstructionPointer&, Instruction const&);
-    void branch_to_label(Configuration&, LabelIndex);
+    void branch_to(Configuration&, BranchTarget const&);
     template<typename ReadT, typename PushT>
-    void load_and_push(Configuration&, Instruction const&);
-    void store_to_memory(Configuration&, Instruction const&, ReadonlyBytes data);
-    void call_address(Configuration&, FunctionAddress);
+    void load_and_push(Configuration&, MemoryInstance*, u32 offset);
+    void store_to_memory(Configuration&, MemoryInstance*, u32 offset, ReadonlyBytes data);
+    // If the call goes through a table, the callee has to have the type the caller expects.
+    void call_address(Configuration&, FunctionAddress, FunctionType const* expected_type = nullptr);
+    void call_table_element(Configuration&, TableAddress, FunctionType const& expected_type);
 
     template<typename V, typename T>
     MakeUnsigned<T> checked_unsigned_truncate(V);
@@ -48,7 +61,6 @@ protected:
     template<typename T>
     T read_value(ReadonlyBytes data);
 
-    Vector<Value> pop_values(Configuration& configuration, size_t count);
     bool trap_if_not(bool value, StringView reason)
     {
         if (!value)
@@ -57,10 +69,12 @@ protected:
     }
 
     Optional<Trap> m_trap;
+    Optional<size_t> m_jit_threshold { JIT::default_threshold() };
 };
 
 struct DebuggerBytecodeInterpreter : public BytecodeInterpreter {
     virtual ~DebuggerBytecodeInterpreter() override = default;
+    virtual void interpret(Configuration& configuration) override { step_through_instructions(configuration); }
 
     Function<bool(Configuration&, InstructionPointer&, Instruction const&)> pre_interpret_hook;
     Function<bool(Configuration&, InstructionPointer&, Instruction const&, Interpreter const&)> post_interpret_hook;
@@ -4,36 +4,56 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/ScopeGuard.h>
 #include <LibWasm/AbstractMachine/Configuration.h>
 #include <LibWasm/AbstractMachine/Interpreter.h>
 #include <LibWasm/Printer/Printer.h>
 
 namespace Wasm {
 
-Optional<Label> Configuration::nth_label(size_t i)
+void Configuration::reserve_stack_for_frame(LoweredExpression const& lowered)
 {
-    for (size_t index = m_stack.size(); index > 0; --index) {
-        auto& entry = m_stack.entries()[index - 1];
-        if (auto ptr = entry.get_pointer<Label>()) {
-            if (i == 0)
-                return *ptr;
-            --i;
-        }
+    m_stack.entries().ensure_capacity(m_stack.size() + lowered.local_types().size() + lowered.max_stack_height());
+}
+
+void Configuration::set_frame(Frame&& frame)
+{
+    frame.m_locals_base = m_stack.size();
+    auto lowered = LoweredExpression::lower_constant_expression(m_store, frame.module(), frame.expression());
+    if (lowered.is_error()) {
+        m_lowering_error = lowered.release_error();
+    } else {
+        frame.m_owned_lowered = lowered.release_value();
+        frame.m_lowered = frame.m_owned_lowered.ptr();
+        reserve_stack_for_frame(*frame.m_lowered);
     }
-    return {};
+    m_frames.append(move(frame));
+    m_ip = 0;
 }
 
-void Configuration::unwind(Badge<CallFrameHandle>, CallFrameHandle const& frame_handle)
+void Configuration::enter_function(WasmFunction const& function)
 {
-    if (m_stack.size() == frame_handle.stack_size && frame_handle.frame_index == m_current_frame_index)
-        return;
+    auto& lowered = *function.lowered();
+    auto locals_base = m_stack.size() - function.type().parameters().size();
+    reserve_stack_for_frame(lowered);
+    for (size_t i = function.type().parameters().size(); i < lowered.local_types().size(); ++i)
+        m_stack.push(0ull);
+    m_frames.append(Frame { function.module(), lowered, locals_base });
+    m_ip = 0;
+}
+
+void Configuration::leave_function()
+{
+    m_stack.unwind(frame().locals_base(), frame().arity());
+    m_frames.take_last();
+}
 
-    VERIFY(m_stack.size() > frame_handle.stack_size);
-    m_stack.entries().remove(frame_handle.stack_size, m_stack.size() - frame_handle.stack_size);
-    m_current_frame_index = frame_handle.frame_index;
+void Configuration::unwind(Badge<CallFrameHandle>, CallFrameHandle const& frame_handle)
+{
+    VERIFY(m_frames.size() >= frame_handle.frame_count);
+    m_frames.shrink(frame_handle.frame_count, true);
     m_depth--;
     m_ip = frame_handle.ip;
-    VERIFY(m_stack.size() == frame_handle.stack_size);
 }
 
 Result Configuration::call(Interpreter& interpreter, FunctionAddress address, Vector<Value> arguments)
@@ -42,20 +62,16 @@ Result Configuration::call(Interpreter& interpreter, FunctionAddress address, Ve
     if (!function)
         return Trap {};
     if (auto* wasm_function = function->get_pointer<WasmFunction>()) {
-        Vector<Value> locals;
-        locals.ensure_capacity(arguments.size() + wasm_function->code().locals().size());
+        if (!wasm_function->lowered())
+            return Trap { "Call to a function that hasn't been validated" };
+        if (arguments.size() != wasm_function->type().parameters().size())
+            return Trap { "Call with the wrong number of arguments" };
+
+        m_stack.entries().ensure_capacity(m_stack.size() + arguments.size());
         for (auto& value : arguments)
-            locals.append(Value { value });
-        for (auto& type : wasm_function->code().locals())
-            locals.empend(type, 0ull);
-
-        set_frame(Frame {
-            wasm_function->module(),
-            move(locals),
-            wasm_function->code().body(),
-            wasm_function->type().results().size(),
-        });
-        m_ip = 0;
+            m_stack.push(value_to_slot(value));
+
+        enter_function(*wasm_function);
         return execute(interpreter);
     }
 
@@ -66,21 +82,25 @@ Result Configuration::call(Interpreter& interpreter, FunctionAddress address, Ve
 
 Result Configuration::execute(Interpreter& interpreter)
 {
+    if (m_lowering_error.has_value())
+        return Trap { m_lowering_error.release_value() };
+
+    auto locals_base = frame().locals_base();
+    ScopeGuard leave_frame = [&] {
+        m_stack.entries().shrink(locals_base, true);
+        m_frames.take_last();
+    };
+
     interpreter.interpret(*this);
     if (interpreter.did_trap())
         return Trap { interpreter.trap_reason() };
 
-    if (stack().size() <= frame().arity() + 1)
-        return Trap { "Not enough values to return from call" };
-
+    auto& result_types = frame().lowered()->result_types();
+    auto first_result = m_stack.size() - result_types.size();
     Vector<Value> results;
-    results.ensure_capacity(frame().arity());
-    for (size_t i = 0; i < frame().arity(); ++i)
-        results.append(move(stack().pop().get<Value>()));
-    auto label = stack().pop();
-    // ASSERT: label == current frame
-    if (!label.has<Label>())
-        return Trap { "Invalid stack configuration" };
+    results.ensure_capacity(result_types.size());
+    for (size_t i = 0; i < result_types.size(); ++i)
+        results.unchecked_append(value_from_slot(result_types[i], m_stack.entries()[first_result + i]));
     return Result { move(results) };
 }
 
@@ -92,20 +112,18 @@ void Configuration::dump_stack()
         Printer { memory_stream }.print(vs...);
         dbgln(format.view(), StringView(memory_stream.copy_into_contiguous_buffer()).trim_whitespace());
     };
-    for (auto const& entry : stack().entries()) {
-        entry.visit(
-            [&](Value const& v) {
-                print_value("    {}", v);
-            },
-            [&](Frame const& f) {
-                dbgln("    frame({})", f.arity());
-                for (auto& local : f.locals()) {
-                    print_value("        {}", local);
-                }
-            },
-            [](Label const& l) {
-                dbgln("    label({}) -> {}", l.arity(), l.continuation());
-            });
+    for (size_t frame_index = 0; frame_index < m_frames.size(); ++frame_index) {
+        auto& frame = m_frames[frame_index];
+        dbgln("    frame({})", frame.arity());
+        if (!frame.lowered())
+            continue;
+        auto& local_types = frame.lowered()->local_types();
+        for (size_t i = 0; i < local_types.size(); ++i)
+            print_value("        {}", value_from_slot(local_types[i], m_stack.entries()[frame.locals_base() + i]));
+        // The operands don't carry their types around, so all we can show are their bits.
+        auto end = frame_index + 1 < m_frames.size() ? m_frames[frame_index + 1].locals_base() : m_stack.size();
+        for (auto i = frame.stack_base(); i < end; ++i)
+            dbgln("    {:#x}", m_stack.entries()[i]);
     }
 }
 
@@ -17,16 +17,11 @@ public:
     {
     }
 
-    Optional<Label> nth_label(size_t);
-    void set_frame(Frame&& frame)
-    {
-        m_current_frame_index = m_stack.size();
-        Label label(frame.arity(), frame.expression().instructions().size());
-        m_stack.push(move(frame));
-        m_stack.push(label);
-    }
-    ALWAYS_INLINE auto& frame() const { return m_stack.entries()[m_current_frame_index].get<Frame>(); }
-    ALWAYS_INLINE auto& frame() { return m_stack.entries()[m_current_frame_index].get<Frame>(); }
+    // Sets up a frame for running an expression that isn't part of a function, like the initializer of a global.
+    void set_frame(Frame&&);
+    ALWAYS_INLINE auto& frame() const { return m_frames.last(); }
+    ALWAYS_INLINE auto& frame() { return m_frames.last(); }
+    ALWAYS_INLINE auto& frames() const { return m_frames; }
     ALWAYS_INLINE auto& ip() const { return m_ip; }
     ALWAYS_INLINE auto& ip() { return m_ip; }
     ALWAYS_INLINE auto& depth() const { return m_depth; }
@@ -36,10 +31,14 @@ public:
     ALWAYS_INLINE auto& store() const { return m_store; }
     ALWAYS_INLINE auto& store() { return m_store; }
 
+    // Sets up a frame for calling a function whose arguments are already on top of the stack.
+    void enter_function(WasmFunction const&);
+    // Leaves the current frame, and puts the function's results where its arguments used to be.
+    void leave_function();
+
     struct CallFrameHandle {
         explicit CallFrameHandle(Configuration& configuration)
-            : frame_index(configuration.m_current_frame_index)
-            , stack_size(configuration.m_stack.size())
+            : frame_count(configuration.m_frames.size())
             , ip(configuration.ip())
             , configuration(configuration)
         {
@@ -51,8 +50,7 @@ public:
             configuration.unwind({}, *this);
         }
 
-        size_t frame_index { 0 };
-        size_t stack_size { 0 };
+        size_t frame_count { 0 };
         InstructionPointer ip { 0 };
         Configuration& configuration;
     };
@@ -64,11 +62,14 @@ public:
     void dump_stack();
 
 private:
+    void reserve_stack_for_frame(LoweredExpression const&);
+
     Store& m_store;
-    size_t m_current_frame_index { 0 };
+    Vector<Frame, 16> m_frames;
     Stack m_stack;
     size_t m_depth { 0 };
     InstructionPointer m_ip;
+    Optional<String> m_lowering_error;
 };
 
 }
@@ -0,0 +1,951 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibWasm/AbstractMachine/AbstractMachine.h>
+#include <LibWasm/AbstractMachine/Lowering.h>
+#include <LibWasm/JIT/Compiler.h>
+#include <LibWasm/Opcode.h>
+
+namespace Wasm {
+
+static ValueType::Kind canonical_kind(ValueType const& type)
+{
+    switch (type.kind()) {
+    case ValueType::NullFunctionReference:
+        return ValueType::FunctionReference;
+    case ValueType::NullExternReference:
+        return ValueType::ExternReference;
+    default:
+        return type.kind();
+    }
+}
+
+// Validates an expression with the algorithm from the appendix of the spec, and works out the branch targets
+// and stack heights on the way: https://webassembly.github.io/spec/core/appendix/algorithm.html
+class ExpressionLowerer {
+public:
+    ExpressionLowerer(Store& store, ModuleInstance const& module, LoweredExpression& output)
+        : m_store(store)
+        , m_module(module)
+        , m_output(output)
+    {
+    }
+
+    bool lower_expression(Optional<Vector<ValueType>> const& expected_results);
+    String const& error() const { return m_error; }
+
+private:
+    // An empty entry is a value of unknown type, which only exists in unreachable code.
+    using StackEntry = Optional<ValueType::Kind>;
+
+    struct ControlFrame {
+        OpCode opcode;
+        InstructionPointer ip { 0 };
+        Vector<ValueType> parameters;
+        Vector<ValueType> results;
+        size_t height { 0 };
+        bool unreachable { false };
+        // The target an if goes to when its condition is false, as long as it hasn't seen its else.
+        Optional<u32> else_target;
+        // Targets that go to the end of the block, which isn't known until we get there.
+        Vector<u32> pending_targets;
+
+        auto& label_types() const { return opcode == Instructions::loop ? parameters : results; }
+    };
+
+    bool lower(Instruction const&);
+    void emit_lowered_instructions();
+
+    bool fail(String error)
+    {
+        m_error = String::formatted("{} (at instruction {})", error, m_ip);
+        return false;
+    }
+
+    void push(StackEntry entry)
+    {
+        m_operands.append(entry);
+        m_output.m_max_stack_height = max(m_output.m_max_stack_height, m_operands.size());
+    }
+    void push(ValueType const& type) { push(StackEntry { canonical_kind(type) }); }
+    void push_types(Vector<ValueType> const& types)
+    {
+        for (auto& type : types)
+            push(type);
+    }
+
+    bool pop(StackEntry& entry)
+    {
+        auto& frame = m_control.last();
+        if (m_operands.size() == frame.height) {
+            if (frame.unreachable) {
+                entry = {};
+                return true;
+            }
+            return fail("Not enough values on the stack");
+        }
+        entry = m_operands.take_last();
+        return true;
+    }
+    bool pop(ValueType::Kind expected)
+    {
+        StackEntry entry;
+        if (!pop(entry))
+            return false;
+        if (entry.has_value() && *entry != expected)
+            return fail(String::formatted("Expected {} on the stack, but found {}", ValueType::kind_name(expected), ValueType::kind_name(*entry)));
+        return true;
+    }
+    bool pop_types(Vector<ValueType> const& types, Vector<StackEntry>* popped_entries = nullptr)
+    {
+        for (size_t i = types.size(); i > 0; --i) {
+            StackEntry entry;
+            if (!pop(entry))
+                return false;
+            auto expected = canonical_kind(types[i - 1]);
+            if (entry.has_value() && *entry != expected)
+                return fail(String::formatted("Expected {} on the stack, but found {}", ValueType::kind_name(expected), ValueType::kind_name(*entry)));
+            if (popped_entries)
+                popped_entries->prepend(entry);
+        }
+        return true;
+    }
+
+    bool unary(ValueType::Kind operand, ValueType::Kind result)
+    {
+        if (!pop(operand))
+            return false;
+        push(result);
+        return true;
+    }
+    bool binary(ValueType::Kind operands, ValueType::Kind result)
+    {
+        if (!pop(operands) || !pop(operands))
+            return false;
+        push(result);
+        return true;
+    }
+    bool load(ValueType::Kind type)
+    {
+        if (m_module.memories().is_empty())
+            return fail("Memory access without a memory");
+        return unary(ValueType::I32, type);
+    }
+    bool store(ValueType::Kind type)
+    {
+        if (m_module.memories().is_empty())
+            return fail("Memory access without a memory");
+        return pop(type) && pop(ValueType::I32);
+    }
+
+    void push_control(OpCode opcode, Vector<ValueType> parameters, Vector<ValueType> results)
+    {
+        m_control.append(ControlFrame { opcode, m_ip, move(parameters), move(results), m_operands.size(), false, {}, {} });
+        push_types(m_control.last().parameters);
+    }
+    bool check_end_of_block(ControlFrame const& frame)
+    {
+        if (!pop_types(frame.results))
+            return false;
+        if (m_operands.size() != frame.height)
+            return fail("Block leaves extra values on the stack");
+        return true;
+    }
+    bool pop_control(ControlFrame& frame, InstructionPointer end_ip);
+
+    void mark_unreachable()
+    {
+        auto& frame = m_control.last();
+        m_operands.shrink(frame.height);
+        frame.unreachable = true;
+    }
+
+    u32 add_target(BranchTarget target)
+    {
+        m_output.m_branch_targets.append(target);
+        return m_output.m_branch_targets.size() - 1;
+    }
+    ControlFrame* label_frame(LabelIndex index)
+    {
+        if (index.value() >= m_control.size()) {
+            fail(String::formatted("Branch to nonexistent label {}", index.value()));
+            return nullptr;
+        }
+        return &m_control[m_control.size() - index.value() - 1];
+    }
+    u32 add_branch(ControlFrame& frame)
+    {
+        BranchTarget target { 0, static_cast<u32>(frame.height), static_cast<u32>(frame.label_types().size()) };
+        // A loop's label is at its start, so we already know where it is.
+        if (frame.opcode == Instructions::loop)
+            target.ip = frame.ip;
+        auto index = add_target(target);
+        if (frame.opcode != Instructions::loop)
+            frame.pending_targets.append(index);
+        return index;
+    }
+
+    bool block_signature(BlockType const&, Vector<ValueType>& parameters, Vector<ValueType>& results);
+    FunctionType const* function_type(FunctionIndex);
+    TableInstance const* table(TableIndex);
+    GlobalInstance const* global(GlobalIndex);
+
+    Store& m_store;
+    ModuleInstance const& m_module;
+    LoweredExpression& m_output;
+    Vector<StackEntry> m_operands;
+    Vector<ControlFrame> m_control;
+    size_t m_ip { 0 };
+    String m_error;
+};
+
+bool ExpressionLowerer::pop_control(ControlFrame& frame, InstructionPointer end_ip)
+{
+    auto& current = m_control.last();
+    if (!check_end_of_block(current))
+        return false;
+
+    if (current.else_target.has_value()) {
+        // Without an else, a false condition goes straight to the end, so the if must not change the types on the stack.
+        bool types_match = current.parameters.size() == current.results.size();
+        for (size_t i = 0; types_match && i < current.parameters.size(); ++i)
+            types_match = canonical_kind(current.parameters[i]) == canonical_kind(current.results[i]);
+        if (!types_match)
+            return fail("An if without an else must produce the values it consumes");
+        m_output.m_branch_targets[*current.else_target].ip = end_ip;
+    }
+
+    for (auto index : current.pending_targets)
+        m_output.m_branch_targets[index].ip = end_ip;
+
+    frame = m_control.take_last();
+    return true;
+}
+
+bool ExpressionLowerer::block_signature(BlockType const& block_type, Vector<ValueType>& parameters, Vector<ValueType>& results)
+{
+    switch (block_type.kind()) {
+    case BlockType::Empty:
+        return true;
+    case BlockType::Type:
+        results.append(block_type.value_type());
+        return true;
+    case BlockType::Index: {
+        auto index = block_type.type_index().value();
+        if (index >= m_module.types().size())
+            return fail(String::formatted("Block refers to nonexistent type {}", index));
+        auto& type = m_module.types()[index];
+        parameters.extend(type.parameters());
+        results.extend(type.results());
+        return true;
+    }
+    }
+    VERIFY_NOT_REACHED();
+}
+
+FunctionType const* ExpressionLowerer::function_type(FunctionIndex index)
+{
+    if (index.value() >= m_module.functions().size()) {
+        fail(String::formatted("Reference to nonexistent function {}", index.value()));
+        return nullptr;
+    }
+    auto* function = m_store.get(m_module.functions()[index.value()]);
+    if (!function) {
+        fail(String::formatted("Function {} does not exist in the store", index.value()));
+        return nullptr;
+    }
+    return function->visit([](auto const& function) { return &function.type(); });
+}
+
+TableInstance const* ExpressionLowerer::table(TableIndex index)
+{
+    TableInstance const* instance = nullptr;
+    if (index.value() < m_module.tables().size())
+        instance = m_store.get(m_module.tables()[index.value()]);
+    if (!instance)
+        fail(String::formatted("Reference to nonexistent table {}", index.value()));
+    return instance;
+}
+
+GlobalInstance const* ExpressionLowerer::global(GlobalIndex index)
+{
+    GlobalInstance const* instance = nullptr;
+    if (index.value() < m_module.globals().size())
+        instance = m_store.get(m_module.globals()[index.value()]);
+    if (!instance)
+        fail(String::formatted("Reference to nonexistent global {}", index.value()));
+    return instance;
+}
+
+bool ExpressionLowerer::lower_expression(Optional<Vector<ValueType>> const& expected_results)
+{
+    auto& instructions = m_output.m_expression.instructions();
+    m_output.m_branch_target_indices.resize(instructions.size());
+
+    // The expression itself behaves like a block that ends after its last instruction.
+    push_control(Instructions::block, {}, expected_results.value_or({}));
+
+    for (; m_ip < instructions.size(); ++m_ip) {
+        if (!lower(instructions[m_ip]))
+            return false;
+    }
+
+    if (m_control.size() != 1)
+        return fail("Expression ends inside a block");
+
+    if (!expected_results.has_value()) {
+        auto& frame = m_control.first();
+        for (auto& entry : m_operands) {
+            if (!entry.has_value())
+                return fail("Expression leaves a value of unknown type on the stack");
+            frame.results.empend(*entry);
+        }
+    }
+
+    ControlFrame frame;
+    if (!pop_control(frame, instructions.size()))
+        return false;
+    m_output.m_result_types = move(frame.results);
+    emit_lowered_instructions();
+    return true;
+}
+
+void ExpressionLowerer::emit_lowered_instructions()
+{
+    auto& instructions = m_output.m_expression.instructions();
+    auto& output = m_output.m_lowered_instructions;
+
+    // Instructions that aren't lowered go away, so every branch target needs the index of the next one that is.
+    Vector<u32> lowered_indices;
+    lowered_indices.ensure_capacity(instructions.size() + 1);
+    for (auto& instruction : instructions) {
+        lowered_indices.unchecked_append(output.size());
+        switch (instruction.opcode().value()) {
+        case Instructions::nop.value():
+        case Instructions::block.value():
+        case Instructions::loop.value():
+        case Instructions::structured_end.value():
+            break;
+        default:
+            output.empend();
+        }
+    }
+    lowered_indices.unchecked_append(output.size());
+    output.append({ LoweredOpCode::return_ });
+
+    auto lowered_target = [&](size_t ip) {
+        auto& target = m_output.m_branch_targets[m_output.m_branch_target_indices[ip]];
+        return BranchTarget { lowered_indices[target.ip.value()], target.stack_height, target.arity };
+    };
+    auto branch = [&](LoweredOpCode opcode, size_t ip) {
+        auto target = lowered_target(ip);
+        return LoweredInstruction { opcode, static_cast<u32>(target.ip.value()), (static_cast<u64>(target.stack_height) << 32) | target.arity };
+    };
+
+    for (size_t ip = 0; ip < instructions.size(); ++ip) {
+        auto& instruction = instructions[ip];
+        if (lowered_indices[ip] == lowered_indices[ip + 1])
+            continue;
+        auto& lowered = output[lowered_indices[ip]];
+
+        switch (instruction.opcode().value()) {
+        case Instructions::unreachable.value():
+            lowered = { LoweredOpCode::unreachable };
+            break;
+        case Instructions::i32_const.value():
+            lowered = { LoweredOpCode::constant, 0, to_slot(instruction.arguments().get<i32>()) };
+            break;
+        case Instructions::i64_const.value():
+            lowered = { LoweredOpCode::constant, 0, to_slot(instruction.arguments().get<i64>()) };
+            break;
+        case Instructions::f32_const.value():
+            lowered = { LoweredOpCode::constant, 0, to_slot(instruction.arguments().get<float>()) };
+            break;
+        case Instructions::f64_const.value():
+            lowered = { LoweredOpCode::constant, 0, to_slot(instruction.arguments().get<double>()) };
+            break;
+        case Instructions::ref_null.value():
+            lowered = { LoweredOpCode::constant, 0, value_to_slot(Value(Reference(Reference::Null { instruction.arguments().get<ValueType>() }))) };
+            break;
+        case Instructions::ref_func.value(): {
+            auto address = m_module.functions()[instruction.arguments().get<FunctionIndex>().value()];
+            lowered = { LoweredOpCode::constant, 0, value_to_slot(Value(Reference(Reference::Func { address }))) };
+            break;
+        }
+        case Instructions::if_.value():
+            lowered = { LoweredOpCode::jump_if_zero, static_cast<u32>(lowered_target(ip).ip.value()) };
+            break;
+        case Instructions::structured_else.value():
+            lowered = { LoweredOpCode::jump, static_cast<u32>(lowered_target(ip).ip.value()) };
+            break;
+        case Instructions::br.value():
+            lowered = branch(LoweredOpCode::br, ip);
+            break;
+        case Instructions::br_if.value():
+            lowered = branch(LoweredOpCode::br_if, ip);
+            break;
+        case Instructions::br_table.value(): {
+            auto& tables = m_output.m_lowered_branch_tables;
+            lowered = { LoweredOpCode::br_table, static_cast<u32>(tables.size()) };
+            for (auto& target : m_output.branch_table(ip))
+                tables.append({ lowered_indices[target.ip.value()], target.stack_height, target.arity });
+            lowered.immediate = tables.size() - lowered.argument;
+            break;
+        }
+        case Instructions::return_.value():
+            lowered = { LoweredOpCode::return_ };
+            break;
+        case Instructions::call.value(): {
+            auto address = m_module.functions()[instruction.arguments().get<FunctionIndex>().value()];
+            lowered = { LoweredOpCode::call, 0, address.value() };
+            break;
+        }
+        case Instructions::call_indirect.value(): {
+            auto& args = instruction.arguments().get<Instruction::IndirectCallArgs>();
+            lowered = { LoweredOpCode::call_indirect, static_cast<u32>(args.type.value()), m_module.tables()[args.table.value()].value() };
+            break;
+        }
+        case Instructions::local_get.value():
+            lowered = { LoweredOpCode::local_get, static_cast<u32>(instruction.arguments().get<LocalIndex>().value()) };
+            break;
+        case Instructions::local_set.value():
+            lowered = { LoweredOpCode::local_set, static_cast<u32>(instruction.arguments().get<LocalIndex>().value()) };
+            break;
+        case Instructions::local_tee.value():
+            lowered = { LoweredOpCode::local_tee, static_cast<u32>(instruction.arguments().get<LocalIndex>().value()) };
+            break;
+        case Instructions::global_get.value():
+            lowered = { LoweredOpCode::global_get, 0, m_module.globals()[instruction.arguments().get<GlobalIndex>().value()].value() };
+            break;
+        case Instructions::global_set.value():
+            lowered = { LoweredOpCode::global_set, 0, m_module.globals()[instruction.arguments().get<GlobalIndex>().value()].value() };
+            break;
+        case Instructions::memory_size.value():
+            lowered = { LoweredOpCode::memory_size };
+            break;
+        case Instructions::memory_grow.value():
+            lowered = { LoweredOpCode::memory_grow };
+            break;
+        case Instructions::select_typed.value():
+            lowered = { LoweredOpCode::select };
+            break;
+#define __ENUMERATE_WASM_MEMORY_INSTRUCTION(name)                                                             \
+    case Instructions::name.value():                                                                          \
+        lowered = { LoweredOpCode::name, instruction.arguments().get<Instruction::MemoryArgument>().offset }; \
+        break;
+            ENUMERATE_WASM_MEMORY_INSTRUCTIONS(__ENUMERATE_WASM_MEMORY_INSTRUCTION)
+#undef __ENUMERATE_WASM_MEMORY_INSTRUCTION
+#define __ENUMERATE_WASM_STACK_INSTRUCTION(name) \
+    case Instructions::name.value():             \
+        lowered = { LoweredOpCode::name };       \
+        break;
+            ENUMERATE_WASM_STACK_INSTRUCTIONS(__ENUMERATE_WASM_STACK_INSTRUCTION)
+#undef __ENUMERATE_WASM_STACK_INSTRUCTION
+        default:
+            lowered = { LoweredOpCode::unimplemented, static_cast<u32>(ip) };
+            break;
+        }
+    }
+}
+
+bool ExpressionLowerer::lower(Instruction const& instruction)
+{
+    constexpr auto I32 = ValueType::I32;
+    constexpr auto I64 = ValueType::I64;
+    constexpr auto F32 = ValueType::F32;
+    constexpr auto F64 = ValueType::F64;
+
+    switch (instruction.opcode().value()) {
+    case Instructions::unreachable.value():
+        mark_unreachable();
+        return true;
+    case Instructions::nop.value():
+        return true;
+    case Instructions::block.value():
+    case Instructions::loop.value():
+    case Instructions::if_.value(): {
+        auto& args = instruction.arguments().get<Instruction::StructuredInstructionArgs>();
+        Vector<ValueType> parameters;
+        Vector<ValueType> results;
+        if (!block_signature(args.block_type, parameters, results))
+            return false;
+        if (instruction.opcode() == Instructions::if_ && !pop(I32))
+            return false;
+        if (!pop_types(parameters))
+            return false;
+        push_control(instruction.opcode(), move(parameters), move(results));
+        auto& frame = m_control.last();
+        if (instruction.opcode() == Instructions::if_) {
+            auto index = add_target({ 0, static_cast<u32>(frame.height), 0 });
+            m_output.m_branch_target_indices[m_ip] = index;
+            frame.else_target = index;
+        }
+        return true;
+    }
+    case Instructions::structured_else.value(): {
+        auto& frame = m_control.last();
+        if (frame.opcode != Instructions::if_ || !frame.else_target.has_value())
+            return fail("Else outside of an if");
+        if (!check_end_of_block(frame))
+            return false;
+        m_output.m_branch_targets[*frame.else_target].ip = m_ip + 1;
+        frame.else_target.clear();
+        // Reaching the else from the then-branch jumps over the else-branch.
+        auto index = add_target({ 0, static_cast<u32>(frame.height), static_cast<u32>(frame.results.size()) });
+        m_output.m_branch_target_indices[m_ip] = index;
+        frame.pending_targets.append(index);
+        frame.unreachable = false;
+        push_types(frame.parameters);
+        return true;
+    }
+    case Instructions::structured_end.value(): {
+        if (m_control.size() == 1)
+            return fail("End without a matching block");
+        ControlFrame frame;
+        if (!pop_control(frame, m_ip + 1))
+            return false;
+        push_types(frame.results);
+        return true;
+    }
+    case Instructions::br.value():
+    case Instructions::br_if.value(): {
+        if (instruction.opcode() == Instructions::br_if && !pop(I32))
+            return false;
+        auto* frame = label_frame(instruction.arguments().get<LabelIndex>());
+        if (!frame || !pop_types(frame->label_types()))
+            return false;
+        m_output.m_branch_target_indices[m_ip] = add_branch(*frame);
+        if (instruction.opcode() == Instructions::br_if)
+            push_types(frame->label_types());
+        else
+            mark_unreachable();
+        return true;
+    }
+    case Instructions::br_table.value(): {
+        auto& args = instruction.arguments().get<Instruction::TableBranchArgs>();
+        if (!pop(I32))
+            return false;
+        auto* default_frame = label_frame(args.default_);
+        if (!default_frame)
+            return false;
+        auto arity = default_frame->label_types().size();
+        m_output.m_branch_target_indices[m_ip] = m_output.m_branch_targets.size();
+        for (auto& label : args.labels) {
+            auto* frame = label_frame(label);
+            if (!frame)
+                return false;
+            if (frame->label_types().size() != arity)
+                return fail("Labels of a br_table take different numbers of values");
+            Vector<StackEntry> entries;
+            if (!pop_types(frame->label_types(), &entries))
+                return false;
+            for (auto& entry : entries)
+                push(entry);
+            add_branch(*frame);
+        }
+        if (!pop_types(default_frame->label_types()))
+            return false;
+        add_branch(*default_frame);
+        mark_unreachable();
+        return true;
+    }
+    case Instructions::return_.value():
+        if (!pop_types(m_control.first().results))
+            return false;
+        mark_unreachable();
+        return true;
+    case Instructions::call.value(): {
+        auto* type = function_type(instruction.arguments().get<FunctionIndex>());
+        if (!type || !pop_types(type->parameters()))
+            return false;
+        push_types(type->results());
+        return true;
+    }
+    case Instructions::call_indirect.value(): {
+        auto& args = instruction.arguments().get<Instruction::IndirectCallArgs>();
+        auto* table_instance = table(args.table);
+        if (!table_instance)
+            return false;
+        if (canonical_kind(table_instance->type().element_type()) != ValueType::FunctionReference)
+            return fail("Indirect call through a table that doesn't hold functions");
+        if (args.type.value() >= m_module.types().size())
+            return fail(String::formatted("Indirect call with nonexistent type {}", args.type.value()));
+        auto& type = m_module.types()[args.type.value()];
+        if (!pop(I32) || !pop_types(type.parameters()))
+            return false;
+        push_types(type.results());
+        return true;
+    }
+    case Instructions::drop.value(): {
+        StackEntry entry;
+        return pop(entry);
+    }
+    case Instructions::select.value(): {
+        StackEntry lhs;
+        StackEntry rhs;
+        if (!pop(I32) || !pop(rhs) || !pop(lhs))
+            return false;
+        if (lhs.has_value() && rhs.has_value() && *lhs != *rhs)
+            return fail("Select between values of different types");
+        auto type = lhs.has_value() ? lhs : rhs;
+        if (type.has_value() && ValueType(*type).is_reference())
+            return fail("Select between references needs a type");
+        push(type);
+        return true;
+    }
+    case Instructions::select_typed.value(): {
+        auto& types = instruction.arguments().get<Vector<ValueType>>();
+        if (types.size() != 1)
+            return fail("Typed select must have exactly one type");
+        auto type = canonical_kind(types.first());
+        if (!pop(I32) || !pop(type) || !pop(type))
+            return false;
+        push(type);
+        return true;
+    }
+    case Instructions::local_get.value():
+    case Instructions::local_set.value():
+    case Instructions::local_tee.value(): {
+        auto index = instruction.arguments().get<LocalIndex>().value();
+        if (index >= m_output.m_local_types.size())
+            return fail(String::formatted("Reference to nonexistent local {}", index));
+        auto& type = m_output.m_local_types[index];
+        if (instruction.opcode() != Instructions::local_get && !pop(canonical_kind(type)))
+            return false;
+        if (instruction.opcode() != Instructions::local_set)
+            push(type);
+        return true;
+    }
+    case Instructions::global_get.value():
+    case Instructions::global_set.value(): {
+        auto* global_instance = global(instruction.arguments().get<GlobalIndex>());
+        if (!global_instance)
+            return false;
+        auto& type = global_instance->value().type();
+        if (instruction.opcode() == Instructions::global_get) {
+            push(type);
+            return true;
+        }
+        if (!global_instance->is_mutable())
+            return fail("Assignment to an immutable global");
+        return pop(canonical_kind(type));
+    }
+    case Instructions::table_get.value():
+    case Instructions::table_set.value(): {
+        auto* table_instance = table(instruction.arguments().get<TableIndex>());
+        if (!table_instance)
+            return false;
+        auto& type = table_instance->type().element_type();
+        if (instruction.opcode() == Instructions::table_get) {
+            if (!pop(I32))
+                return false;
+            push(type);
+            return true;
+        }
+        return pop(canonical_kind(type)) && pop(I32);
+    }
+    case Instructions::i32_load.value():
+    case Instructions::i32_load8_s.value():
+    case Instructions::i32_load8_u.value():
+    case Instructions::i32_load16_s.value():
+    case Instructions::i32_load16_u.value():
+        return load(I32);
+    case Instructions::i64_load.value():
+    case Instructions::i64_load8_s.value():
+    case Instructions::i64_load8_u.value():
+    case Instructions::i64_load16_s.value():
+    case Instructions::i64_load16_u.value():
+    case Instructions::i64_load32_s.value():
+    case Instructions::i64_load32_u.value():
+        return load(I64);
+    case Instructions::f32_load.value():
+        return load(F32);
+    case Instructions::f64_load.value():
+        return load(F64);
+    case Instructions::i32_store.value():
+    case Instructions::i32_store8.value():
+    case Instructions::i32_store16.value():
+        return store(I32);
+    case Instructions::i64_store.value():
+    case Instructions::i64_store8.value():
+    case Instructions::i64_store16.value():
+    case Instructions::i64_store32.value():
+        return store(I64);
+    case Instructions::f32_store.value():
+        return store(F32);
+    case Instructions::f64_store.value():
+        return store(F64);
+    case Instructions::memory_size.value():
+        if (m_module.memories().is_empty())
+            return fail("memory.size without a memory");
+        push(I32);
+        return true;
+    case Instructions::memory_grow.value():
+        if (m_module.memories().is_empty())
+            return fail("memory.grow without a memory");
+        return unary(I32, I32);
+    case Instructions::i32_const.value():
+        push(I32);
+        return true;
+    case Instructions::i64_const.value():
+        push(I64);
+        return true;
+    case Instructions::f32_const.value():
+        push(F32);
+        return true;
+    case Instructions::f64_const.value():
+        push(F64);
+        return true;
+    case Instructions::ref_null.value(): {
+        auto& type = instruction.arguments().get<ValueType>();
+        if (!type.is_reference())
+            return fail("ref.null of a type that isn't a reference");
+        push(type);
+        return true;
+    }
+    case Instructions::ref_is_null.value(): {
+        StackEntry entry;
+        if (!pop(entry))
+            return false;
+        if (entry.has_value() && !ValueType(*entry).is_reference())
+            return fail("ref.is_null of a value that isn't a reference");
+        push(I32);
+        return true;
+    }
+    case Instructions::ref_func.value():
+        if (!function_type(instruction.arguments().get<FunctionIndex>()))
+            return false;
+        push(ValueType::FunctionReference);
+        return true;
+    case Instructions::i32_eqz.value():
+    case Instructions::i32_clz.value():
+    case Instructions::i32_ctz.value():
+    case Instructions::i32_popcnt.value():
+    case Instructions::i32_extend8_s.value():
+    case Instructions::i32_extend16_s.value():
+        return unary(I32, I32);
+    case Instructions::i32_eq.value():
+    case Instructions::i32_ne.value():
+    case Instructions::i32_lts.value():
+    case Instructions::i32_ltu.value():
+    case Instructions::i32_gts.value():
+    case Instructions::i32_gtu.value():
+    case Instructions::i32_les.value():
+    case Instructions::i32_leu.value():
+    case Instructions::i32_ges.value():
+    case Instructions::i32_geu.value():
+    case Instructions::i32_add.value():
+    case Instructions::i32_sub.value():
+    case Instructions::i32_mul.value():
+    case Instructions::i32_divs.value():
+    case Instructions::i32_divu.value():
+    case Instructions::i32_rems.value():
+    case Instructions::i32_remu.value():
+    case Instructions::i32_and.value():
+    case Instructions::i32_or.value():
+    case Instructions::i32_xor.value():
+    case Instructions::i32_shl.value():
+    case Instructions::i32_shrs.value():
+    case Instructions::i32_shru.value():
+    case Instructions::i32_rotl.value():
+    case Instructions::i32_rotr.value():
+        return binary(I32, I32);
+    case Instructions::i64_eqz.value():
+    case Instructions::i32_wrap_i64.value():
+        return unary(I64, I32);
+    case Instructions::i64_clz.value():
+    case Instructions::i64_ctz.value():
+    case Instructions::i64_popcnt.value():
+    case Instructions::i64_extend8_s.value():
+    case Instructions::i64_extend16_s.value():
+    case Instructions::i64_extend32_s.value():
+        return unary(I64, I64);
+    case Instructions::i64_eq.value():
+    case Instructions::i64_ne.value():
+    case Instructions::i64_lts.value():
+    case Instructions::i64_ltu.value():
+    case Instructions::i64_gts.value():
+    case Instructions::i64_gtu.value():
+    case Instructions::i64_les.value():
+    case Instructions::i64_leu.value():
+    case Instructions::i64_ges.value():
+    case Instructions::i64_geu.value():
+        return binary(I64, I32);
+    case Instructions::i64_add.value():
+    case Instructions::i64_sub.value():
+    case Instructions::i64_mul.value():
+    case Instructions::i64_divs.value():
+    case Instructions::i64_divu.value():
+    case Instructions::i64_rems.value():
+    case Instructions::i64_remu.value():
+    case Instructions::i64_and.value():
+    case Instructions::i64_or.value():
+    case Instructions::i64_xor.value():
+    case Instructions::i64_shl.value():
+    case Instructions::i64_shrs.value():
+    case Instructions::i64_shru.value():
+    case Instructions::i64_rotl.value():
+    case Instructions::i64_rotr.value():
+        return binary(I64, I64);
+    case Instructions::f32_eq.value():
+    case Instructions::f32_ne.value():
+    case Instructions::f32_lt.value():
+    case Instructions::f32_gt.value():
+    case Instructions::f32_le.value():
+    case Instructions::f32_ge.value():
+        return binary(F32, I32);
+    case Instructions::f64_eq.value():
+    case Instructions::f64_ne.value():
+    case Instructions::f64_lt.value():
+    case Instructions::f64_gt.value():
+    case Instructions::f64_le.value():
+    case Instructions::f64_ge.value():
+        return binary(F64, I32);
+    case Instructions::f32_abs.value():
+    case Instructions::f32_neg.value():
+    case Instructions::f32_ceil.value():
+    case Instructions::f32_floor.value():
+    case Instructions::f32_trunc.value():
+    case Instructions::f32_nearest.value():
+    case Instructions::f32_sqrt.value():
+        return unary(F32, F32);
+    case Instructions::f32_add.value():
+    case Instructions::f32_sub.value():
+    case Instructions::f32_mul.value():
+    case Instructions::f32_div.value():
+    case Instructions::f32_min.value():
+    case Instructions::f32_max.value():
+    case Instructions::f32_copysign.value():
+        return binary(F32, F32);
+    case Instructions::f64_abs.value():
+    case Instructions::f64_neg.value():
+    case Instructions::f64_ceil.value():
+    case Instructions::f64_floor.value():
+    case Instructions::f64_trunc.value():
+    case Instructions::f64_nearest.value():
+    case Instructions::f64_sqrt.value():
+        return unary(F64, F64);
+    case Instructions::f64_add.value():
+    case Instructions::f64_sub.value():
+    case Instructions::f64_mul.value():
+    case Instructions::f64_div.value():
+    case Instructions::f64_min.value():
+    case Instructions::f64_max.value():
+    case Instructions::f64_copysign.value():
+        return binary(F64, F64);
+    case Instructions::i32_trunc_sf32.value():
+    case Instructions::i32_trunc_uf32.value():
+    case Instructions::i32_reinterpret_f32.value():
+    case Instructions::i32_trunc_sat_f32_s.value():
+    case Instructions::i32_trunc_sat_f32_u.value():
+        return unary(F32, I32);
+    case Instructions::i32_trunc_sf64.value():
+    case Instructions::i32_trunc_uf64.value():
+    case Instructions::i32_trunc_sat_f64_s.value():
+    case Instructions::i32_trunc_sat_f64_u.value():
+        return unary(F64, I32);
+    case Instructions::i64_extend_si32.value():
+    case Instructions::i64_extend_ui32.value():
+        return unary(I32, I64);
+    case Instructions::i64_trunc_sf32.value():
+    case Instructions::i64_trunc_uf32.value():
+    case Instructions::i64_trunc_sat_f32_s.value():
+    case Instructions::i64_trunc_sat_f32_u.value():
+        return unary(F32, I64);
+    case Instructions::i64_trunc_sf64.value():
+    case Instructions::i64_trunc_uf64.value():
+    case Instructions::i64_reinterpret_f64.value():
+    case Instructions::i64_trunc_sat_f64_s.value():
+    case Instructions::i64_trunc_sat_f64_u.value():
+        return unary(F64, I64);
+    case Instructions::f32_convert_si32.value():
+    case Instructions::f32_convert_ui32.value():
+    case Instructions::f32_reinterpret_i32.value():
+        return unary(I32, F32);
+    case Instructions::f32_convert_si64.value():
+    case Instructions::f32_convert_ui64.value():
+        return unary(I64, F32);
+    case Instructions::f32_demote_f64.value():
+        return unary(F64, F32);
+    case Instructions::f64_convert_si32.value():
+    case Instructions::f64_convert_ui32.value():
+        return unary(I32, F64);
+    case Instructions::f64_convert_si64.value():
+    case Instructions::f64_convert_ui64.value():
+    case Instructions::f64_reinterpret_i64.value():
+        return unary(I64, F64);
+    case Instructions::f64_promote_f32.value():
+        return unary(F32, F64);
+    case Instructions::memory_init.value():
+    case Instructions::memory_copy.value():
+    case Instructions::memory_fill.value():
+        if (m_module.memories().is_empty())
+            return fail("Bulk memory operation without a memory");
+        return pop(I32) && pop(I32) && pop(I32);
+    case Instructions::data_drop.value():
+    case Instructions::elem_drop.value():
+        return true;
+    case Instructions::table_init.value():
+        if (!table(instruction.arguments().get<Instruction::TableElementArgs>().table_index))
+            return false;
+        return pop(I32) && pop(I32) && pop(I32);
+    case Instructions::table_copy.value(): {
+        auto& args = instruction.arguments().get<Instruction::TableTableArgs>();
+        if (!table(args.lhs) || !table(args.rhs))
+            return false;
+        return pop(I32) && pop(I32) && pop(I32);
+    }
+    case Instructions::table_grow.value():
+    case Instructions::table_size.value():
+    case Instructions::table_fill.value(): {
+        auto* table_instance = table(instruction.arguments().get<TableIndex>());
+        if (!table_instance)
+            return false;
+        auto type = canonical_kind(table_instance->type().element_type());
+        if (instruction.opcode() == Instructions::table_grow) {
+            if (!pop(I32) || !pop(type))
+                return false;
+            push(I32);
+            return true;
+        }
+        if (instruction.opcode() == Instructions::table_size) {
+            push(I32);
+            return true;
+        }
+        return pop(I32) && pop(type) && pop(I32);
+    }
+    default:
+        return fail(String::formatted("Unknown instruction {:x}", instruction.opcode().value()));
+    }
+}
+
+LoweredExpression::~LoweredExpression() = default;
+LoweredExpression::JITState::JITState() = default;
+LoweredExpression::JITState::~JITState() = default;
+
+LoweredExpression::LoweringResult LoweredExpression::lower_function(Store& store, ModuleInstance const& module, FunctionType const& type, Module::Function const& function)
+{
+    auto lowered = adopt_own(*new LoweredExpression(function.body()));
+    lowered->m_local_types.extend(type.parameters());
+    lowered->m_local_types.extend(function.locals());
+
+    ExpressionLowerer lowerer { store, module, *lowered };
+    if (!lowerer.lower_expression(type.results()))
+        return lowerer.error();
+    return lowered;
+}
+
+LoweredExpression::LoweringResult LoweredExpression::lower_constant_expression(Store& store, ModuleInstance const& module, Expression const& expression)
+{
+    auto lowered = adopt_own(*new LoweredExpression(expression));
+
+    ExpressionLowerer lowerer { store, module, *lowered };
+    if (!lowerer.lower_expression({}))
+        return lowerer.error();
+    return lowered;
+}
+
+}
@@ -0,0 +1,312 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/NonnullOwnPtr.h>
+#include <AK/OwnPtr.h>
+#include <AK/Result.h>
+#include <AK/Span.h>
+#include <LibWasm/Types.h>
+
+namespace Wasm {
+
+class ModuleInstance;
+class Store;
+
+namespace JIT {
+class CompiledFunction;
+}
+
+struct BranchTarget {
+    InstructionPointer ip { 0 };
+    // Height of the operand stack (not counting the locals) that the branch unwinds to.
+    u32 stack_height { 0 };
+    // Number of values the branch carries over to its target.
+    u32 arity { 0 };
+};
+
+// Instructions that only work on the values on top of the stack, so they're the same in both encodings.
+#define ENUMERATE_WASM_STACK_INSTRUCTIONS(M) \
+    M(i32_eqz)                               \
+    M(i32_eq)                                \
+    M(i32_ne)                                \
+    M(i32_lts)                               \
+    M(i32_ltu)                               \
+    M(i32_gts)                               \
+    M(i32_gtu)                               \
+    M(i32_les)                               \
+    M(i32_leu)                               \
+    M(i32_ges)                               \
+    M(i32_geu)                               \
+    M(i64_eqz)                               \
+    M(i64_eq)                                \
+    M(i64_ne)                                \
+    M(i64_lts)                               \
+    M(i64_ltu)                               \
+    M(i64_gts)                               \
+    M(i64_gtu)                               \
+    M(i64_les)                               \
+    M(i64_leu)                               \
+    M(i64_ges)                               \
+    M(i64_geu)                               \
+    M(f32_eq)                                \
+    M(f32_ne)                                \
+    M(f32_lt)                                \
+    M(f32_gt)                                \
+    M(f32_le)                                \
+    M(f32_ge)                                \
+    M(f64_eq)                                \
+    M(f64_ne)                                \
+    M(f64_lt)                                \
+    M(f64_gt)                                \
+    M(f64_le)                                \
+    M(f64_ge)                                \
+    M(i32_clz)                               \
+    M(i32_ctz)                               \
+    M(i32_popcnt)                            \
+    M(i32_add)                               \
+    M(i32_sub)                               \
+    M(i32_mul)                               \
+    M(i32_divs)                              \
+    M(i32_divu)                              \
+    M(i32_rems)                              \
+    M(i32_remu)                              \
+    M(i32_and)                               \
+    M(i32_or)                                \
+    M(i32_xor)                               \
+    M(i32_shl)                               \
+    M(i32_shrs)                              \
+    M(i32_shru)                              \
+    M(i32_rotl)                              \
+    M(i32_rotr)                              \
+    M(i64_clz)                               \
+    M(i64_ctz)                               \
+    M(i64_popcnt)                            \
+    M(i64_add)                               \
+    M(i64_sub)                               \
+    M(i64_mul)                               \
+    M(i64_divs)                              \
+    M(i64_divu)                              \
+    M(i64_rems)                              \
+    M(i64_remu)                              \
+    M(i64_and)                               \
+    M(i64_or)                                \
+    M(i64_xor)                               \
+    M(i64_shl)                               \
+    M(i64_shrs)                              \
+    M(i64_shru)                              \
+    M(i64_rotl)                              \
+    M(i64_rotr)                              \
+    M(f32_abs)                               \
+    M(f32_neg)                               \
+    M(f32_ceil)                              \
+    M(f32_floor)                             \
+    M(f32_trunc)                             \
+    M(f32_nearest)                           \
+    M(f32_sqrt)                              \
+    M(f32_add)                               \
+    M(f32_sub)                               \
+    M(f32_mul)                               \
+    M(f32_div)                               \
+    M(f32_min)                               \
+    M(f32_max)                               \
+    M(f32_copysign)                          \
+    M(f64_abs)                               \
+    M(f64_neg)                               \
+    M(f64_ceil)                              \
+    M(f64_floor)                             \
+    M(f64_trunc)                             \
+    M(f64_nearest)                           \
+    M(f64_sqrt)                              \
+    M(f64_add)                               \
+    M(f64_sub)                               \
+    M(f64_mul)                               \
+    M(f64_div)                               \
+    M(f64_min)                               \
+    M(f64_max)                               \
+    M(f64_copysign)                          \
+    M(i32_wrap_i64)                          \
+    M(i32_trunc_sf32)                        \
+    M(i32_trunc_uf32)                        \
+    M(i32_trunc_sf64)                        \
+    M(i32_trunc_uf64)                        \
+    M(i64_extend_si32)                       \
+    M(i64_extend_ui32)                       \
+    M(i64_trunc_sf32)                        \
+    M(i64_trunc_uf32)                        \
+    M(i64_trunc_sf64)                        \
+    M(i64_trunc_uf64)                        \
+    M(f32_convert_si32)                      \
+    M(f32_convert_ui32)                      \
+    M(f32_convert_si64)                      \
+    M(f32_convert_ui64)                      \
+    M(f32_demote_f64)                        \
+    M(f64_convert_si32)                      \
+    M(f64_convert_ui32)                      \
+    M(f64_convert_si64)                      \
+    M(f64_convert_ui64)                      \
+    M(f64_promote_f32)                       \
+    M(i32_reinterpret_f32)                   \
+    M(i64_reinterpret_f64)                   \
+    M(f32_reinterpret_i32)                   \
+    M(f64_reinterpret_i64)                   \
+    M(i32_extend8_s)                         \
+    M(i32_extend16_s)                        \
+    M(i64_extend8_s)                         \
+    M(i64_extend16_s)                        \
+    M(i64_extend32_s)                        \
+    M(i32_trunc_sat_f32_s)                   \
+    M(i32_trunc_sat_f32_u)                   \
+    M(i32_trunc_sat_f64_s)                   \
+    M(i32_trunc_sat_f64_u)                   \
+    M(i64_trunc_sat_f32_s)                   \
+    M(i64_trunc_sat_f32_u)                   \
+    M(i64_trunc_sat_f64_s)                   \
+    M(i64_trunc_sat_f64_u)                   \
+    M(ref_is_null)                           \
+    M(drop)                                  \
+    M(select)
+
+// Instructions that take a memory offset as their argument.
+#define ENUMERATE_WASM_MEMORY_INSTRUCTIONS(M) \
+    M(i32_load)                               \
+    M(i64_load)                               \
+    M(f32_load)                               \
+    M(f64_load)                               \
+    M(i32_load8_s)                            \
+    M(i32_load8_u)                            \
+    M(i32_load16_s)                           \
+    M(i32_load16_u)                           \
+    M(i64_load8_s)                            \
+    M(i64_load8_u)                            \
+    M(i64_load16_s)                           \
+    M(i64_load16_u)                           \
+    M(i64_load32_s)                           \
+    M(i64_load32_u)                           \
+    M(i32_store)                              \
+    M(i64_store)                              \
+    M(f32_store)                              \
+    M(f64_store)                              \
+    M(i32_store8)                             \
+    M(i32_store16)                            \
+    M(i64_store8)                             \
+    M(i64_store16)                            \
+    M(i64_store32)
+
+// The rest have been rewritten into a form that doesn't need anything but the arguments of a LoweredInstruction.
+// Blocks, loops, ends and nops don't do anything at runtime, so they aren't lowered at all.
+#define ENUMERATE_WASM_LOWERED_INSTRUCTIONS(M) \
+    M(unreachable)                             \
+    M(unimplemented)                           \
+    M(constant)                                \
+    M(jump)                                    \
+    M(jump_if_zero)                            \
+    M(br)                                      \
+    M(br_if)                                   \
+    M(br_table)                                \
+    M(return_)                                 \
+    M(call)                                    \
+    M(call_indirect)                           \
+    M(local_get)                               \
+    M(local_set)                               \
+    M(local_tee)                               \
+    M(global_get)                              \
+    M(global_set)                              \
+    M(memory_size)                             \
+    M(memory_grow)                             \
+    ENUMERATE_WASM_MEMORY_INSTRUCTIONS(M)      \
+    ENUMERATE_WASM_STACK_INSTRUCTIONS(M)
+
+enum class LoweredOpCode : u32 {
+#define __ENUMERATE_WASM_LOWERED_INSTRUCTION(name) name,
+    ENUMERATE_WASM_LOWERED_INSTRUCTIONS(__ENUMERATE_WASM_LOWERED_INSTRUCTION)
+#undef __ENUMERATE_WASM_LOWERED_INSTRUCTION
+};
+
+// A fixed-size instruction with its arguments inline, so the interpreter can walk through a function
+// without touching anything but a flat array. What the arguments mean depends on the opcode:
+// - constant: the value, as a stack slot.
+// - jump, jump_if_zero: the index of the target instruction.
+// - br, br_if: the index of the target instruction, and the stack height and arity of the branch.
+// - br_table: the index of the first BranchTarget in LoweredExpression::lowered_branch_tables() and the number of them.
+// - call: the function address. call_indirect: the type index and the table address.
+// - local_*: the local index. global_*: the global address.
+// - loads and stores: the offset.
+// - unimplemented: the index of the original instruction, for error messages.
+struct LoweredInstruction {
+    LoweredOpCode opcode;
+    u32 argument { 0 };
+    u64 immediate { 0 };
+
+    u32 branch_stack_height() const { return immediate >> 32; }
+    u32 branch_arity() const { return static_cast<u32>(immediate); }
+};
+static_assert(sizeof(LoweredInstruction) == 16);
+
+// An expression that has been validated, along with everything the interpreter would otherwise have to
+// work out while running it: where each branch goes, how far it unwinds the stack, and how deep the stack can get.
+class LoweredExpression {
+public:
+    using LoweringResult = AK::Result<NonnullOwnPtr<LoweredExpression>, String>;
+
+    ~LoweredExpression();
+
+    static LoweringResult lower_function(Store&, ModuleInstance const&, FunctionType const&, Module::Function const&);
+    // Lowers an expression that isn't part of a function, like the initializer of a global.
+    // Its results are whatever values it leaves on the stack.
+    static LoweringResult lower_constant_expression(Store&, ModuleInstance const&, Expression const&);
+
+    auto& expression() const { return m_expression; }
+    auto& local_types() const { return m_local_types; }
+    auto& result_types() const { return m_result_types; }
+    auto max_stack_height() const { return m_max_stack_height; }
+
+    // The expression in the compact encoding, which always ends in a return_.
+    auto& lowered_instructions() const { return m_lowered_instructions; }
+    auto& lowered_branch_tables() const { return m_lowered_branch_tables; }
+
+    // The target of a br, br_if or else, or where an if goes when its condition is false.
+    BranchTarget const& branch_target(InstructionPointer ip) const { return m_branch_targets[m_branch_target_indices[ip.value()]]; }
+    // The targets of a br_table, with the default target last.
+    Span<BranchTarget const> branch_table(InstructionPointer ip) const
+    {
+        auto& arguments = m_expression.instructions()[ip.value()].arguments().get<Instruction::TableBranchArgs>();
+        return m_branch_targets.span().slice(m_branch_target_indices[ip.value()], arguments.labels.size() + 1);
+    }
+
+    // The JIT compiles expressions once they have been run often enough, see JIT::compiled_function_for().
+    // None of this changes what the expression does, so it can be updated through a const LoweredExpression.
+    struct JITState {
+        JITState();
+        ~JITState();
+
+        size_t run_count { 0 };
+        bool compilation_failed { false };
+        OwnPtr<JIT::CompiledFunction> compiled_function;
+    };
+    JITState& jit_state() const { return m_jit_state; }
+
+private:
+    friend class ExpressionLowerer;
+
+    explicit LoweredExpression(Expression const& expression)
+        : m_expression(expression)
+    {
+    }
+
+    Expression const& m_expression;
+    Vector<ValueType> m_local_types;
+    Vector<ValueType> m_result_types;
+    Vector<u32> m_branch_target_indices;
+    Vector<BranchTarget> m_branch_targets;
+    size_t m_max_stack_height { 0 };
+    Vector<LoweredInstruction> m_lowered_instructions;
+    Vector<BranchTarget> m_lowered_branch_tables;
+    mutable JITState m_jit_state;
+};
+
+}
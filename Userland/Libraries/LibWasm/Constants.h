@@ -40,5 +40,9 @@ static constexpr auto page_size = 64 * KiB;
 // These are not concretely defined by the spec, so the values are only defined by us.
 static constexpr auto max_allowed_call_stack_depth = 512;
 static constexpr auto max_allowed_executed_instructions_per_call = 256 * 1024 * 1024;
+// Only branches can run code more than once, so this is what the lowered form counts instead of instructions.
+static constexpr auto max_allowed_taken_branches_per_call = 32 * 1024 * 1024;
+// Functions are only worth compiling to machine code once they have been called this often.
+static constexpr auto jit_call_threshold = 100;
 
 }
@@ -0,0 +1,347 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/NumericLimits.h>
+#include <LibWasm/JIT/Assembler.h>
+
+namespace Wasm::JIT {
+
+static u8 low_bits(Assembler::Reg reg) { return to_underlying(reg) & 7; }
+static u8 extension_bit(Assembler::Reg reg) { return to_underlying(reg) >> 3; }
+static u8 float_prefix(Assembler::Size size) { return size == Assembler::Size::Qword ? 0xf2 : 0xf3; }
+
+void Assembler::emit32(u32 value)
+{
+    for (size_t i = 0; i < 4; ++i)
+        emit8(value >> (i * 8));
+}
+
+void Assembler::emit64(u64 value)
+{
+    for (size_t i = 0; i < 8; ++i)
+        emit8(value >> (i * 8));
+}
+
+void Assembler::emit_rex(bool wide, u8 reg, Operand const& operand, bool force)
+{
+    u8 rex = 0x40;
+    if (wide)
+        rex |= 0x08;
+    if (reg & 8)
+        rex |= 0x04;
+    if (operand.index.has_value())
+        rex |= extension_bit(*operand.index) << 1;
+    rex |= extension_bit(operand.base);
+    if (rex != 0x40 || force)
+        emit8(rex);
+}
+
+void Assembler::emit_modrm(u8 reg, Operand const& operand)
+{
+    reg = (reg & 7) << 3;
+    if (operand.is_register()) {
+        emit8(0xc0 | reg | low_bits(operand.base));
+        return;
+    }
+
+    // rbp and r13 can only be a base with a displacement, and rsp and r12 only with a SIB byte.
+    auto base = low_bits(operand.base);
+    u8 mod = 0x80;
+    if (operand.displacement == 0 && base != 5)
+        mod = 0x00;
+    else if (operand.displacement >= -128 && operand.displacement <= 127)
+        mod = 0x40;
+
+    if (operand.index.has_value()) {
+        emit8(mod | reg | 4);
+        emit8((operand.scale_shift << 6) | (low_bits(*operand.index) << 3) | base);
+    } else if (base == 4) {
+        emit8(mod | reg | 4);
+        emit8(0x24);
+    } else {
+        emit8(mod | reg | base);
+    }
+
+    if (mod == 0x40)
+        emit8(operand.displacement);
+    else if (mod == 0x80)
+        emit32(operand.displacement);
+}
+
+void Assembler::emit(Size size, std::initializer_list<u8> opcode, u8 reg, Operand const& operand, Optional<u8> prefix)
+{
+    if (prefix.has_value())
+        emit8(*prefix);
+    emit_rex(size == Size::Qword, reg, operand);
+    for (auto byte : opcode)
+        emit8(byte);
+    emit_modrm(reg, operand);
+}
+
+void Assembler::emit_jump_to(Label& label)
+{
+    if (label.offset.has_value()) {
+        emit32(*label.offset - (offset() + 4));
+        return;
+    }
+    label.pending_jumps.append(offset());
+    emit32(0);
+}
+
+void Assembler::bind(Label& label)
+{
+    label.offset = offset();
+    for (auto jump : label.pending_jumps) {
+        u32 relative_offset = offset() - (jump + 4);
+        for (size_t i = 0; i < 4; ++i)
+            m_code[jump + i] = relative_offset >> (i * 8);
+    }
+    label.pending_jumps.clear();
+}
+
+void Assembler::jump(Label& label)
+{
+    emit8(0xe9);
+    emit_jump_to(label);
+}
+
+void Assembler::jump_if(Condition condition, Label& label)
+{
+    emit8(0x0f);
+    emit8(0x80 | to_underlying(condition));
+    emit_jump_to(label);
+}
+
+void Assembler::jump(Reg reg)
+{
+    emit(Size::Dword, { 0xff }, 4, Operand::reg(reg));
+}
+
+void Assembler::call(Reg reg)
+{
+    emit(Size::Dword, { 0xff }, 2, Operand::reg(reg));
+}
+
+void Assembler::ret()
+{
+    emit8(0xc3);
+}
+
+void Assembler::push(Reg reg)
+{
+    if (extension_bit(reg))
+        emit8(0x41);
+    emit8(0x50 | low_bits(reg));
+}
+
+void Assembler::pop(Reg reg)
+{
+    if (extension_bit(reg))
+        emit8(0x41);
+    emit8(0x58 | low_bits(reg));
+}
+
+void Assembler::lea(Reg reg, Label& label)
+{
+    // This is rip-relative, which is what a memory operand without base or index means in 64-bit mode.
+    emit_rex(true, to_underlying(reg), Operand::reg(Reg::RAX));
+    emit8(0x8d);
+    emit8(((to_underlying(reg) & 7) << 3) | 5);
+    emit_jump_to(label);
+}
+
+void Assembler::lea(Reg reg, Operand const& operand)
+{
+    emit(Size::Qword, { 0x8d }, to_underlying(reg), operand);
+}
+
+void Assembler::mov(Size size, Operand const& destination, Operand const& source)
+{
+    if (destination.is_register()) {
+        emit(size, { 0x8b }, to_underlying(destination.base), source);
+        return;
+    }
+    VERIFY(source.is_register());
+    emit(size, { 0x89 }, to_underlying(source.base), destination);
+}
+
+void Assembler::mov(Reg reg, u64 immediate)
+{
+    if (immediate <= NumericLimits<u32>::max()) {
+        // Writing the lower half of a register clears the upper one.
+        emit_rex(false, 0, Operand::reg(reg));
+        emit8(0xb8 | low_bits(reg));
+        emit32(immediate);
+        return;
+    }
+    if (static_cast<i64>(immediate) >= NumericLimits<i32>::min() && static_cast<i64>(immediate) <= NumericLimits<i32>::max()) {
+        emit(Size::Qword, { 0xc7 }, 0, Operand::reg(reg));
+        emit32(immediate);
+        return;
+    }
+    emit_rex(true, 0, Operand::reg(reg));
+    emit8(0xb8 | low_bits(reg));
+    emit64(immediate);
+}
+
+void Assembler::store8(Operand const& destination, Reg reg)
+{
+    // Without a REX prefix, these would be ah, ch, dh and bh instead of spl, bpl, sil and dil.
+    auto needs_rex = reg >= Reg::RSP && reg <= Reg::RDI;
+    emit_rex(false, to_underlying(reg), destination, needs_rex);
+    emit8(0x88);
+    emit_modrm(to_underlying(reg), destination);
+}
+
+void Assembler::store16(Operand const& destination, Reg reg)
+{
+    emit(Size::Dword, { 0x89 }, to_underlying(reg), destination, 0x66);
+}
+
+void Assembler::movzx8(Reg reg, Operand const& operand)
+{
+    emit(Size::Dword, { 0x0f, 0xb6 }, to_underlying(reg), operand);
+}
+
+void Assembler::movzx16(Reg reg, Operand const& operand)
+{
+    emit(Size::Dword, { 0x0f, 0xb7 }, to_underlying(reg), operand);
+}
+
+void Assembler::movsx8(Size size, Reg reg, Operand const& operand)
+{
+    emit(size, { 0x0f, 0xbe }, to_underlying(reg), operand);
+}
+
+void Assembler::movsx16(Size size, Reg reg, Operand const& operand)
+{
+    emit(size, { 0x0f, 0xbf }, to_underlying(reg), operand);
+}
+
+void Assembler::movsxd(Reg reg, Operand const& operand)
+{
+    emit(Size::Qword, { 0x63 }, to_underlying(reg), operand);
+}
+
+void Assembler::alu(ALU operation, Size size, Reg destination, Operand const& source)
+{
+    emit(size, { static_cast<u8>(to_underlying(operation) * 8 + 3) }, to_underlying(destination), source);
+}
+
+void Assembler::alu(ALU operation, Size size, Operand const& destination, i32 immediate)
+{
+    if (immediate >= -128 && immediate <= 127) {
+        emit(size, { 0x83 }, to_underlying(operation), destination);
+        emit8(immediate);
+        return;
+    }
+    emit(size, { 0x81 }, to_underlying(operation), destination);
+    emit32(immediate);
+}
+
+void Assembler::test(Size size, Operand const& operand, Reg reg)
+{
+    emit(size, { 0x85 }, to_underlying(reg), operand);
+}
+
+void Assembler::imul(Size size, Reg reg, Operand const& operand)
+{
+    emit(size, { 0x0f, 0xaf }, to_underlying(reg), operand);
+}
+
+void Assembler::neg(Size size, Reg reg)
+{
+    emit(size, { 0xf7 }, 3, Operand::reg(reg));
+}
+
+void Assembler::idiv(Size size, Reg divisor)
+{
+    emit(size, { 0xf7 }, 7, Operand::reg(divisor));
+}
+
+void Assembler::div(Size size, Reg divisor)
+{
+    emit(size, { 0xf7 }, 6, Operand::reg(divisor));
+}
+
+void Assembler::sign_extend_accumulator(Size size)
+{
+    if (size == Size::Qword)
+        emit8(0x48);
+    emit8(0x99);
+}
+
+void Assembler::shift_by_cl(Shift operation, Size size, Reg reg)
+{
+    emit(size, { 0xd3 }, to_underlying(operation), Operand::reg(reg));
+}
+
+void Assembler::shift(Shift operation, Size size, Reg reg, u8 count)
+{
+    emit(size, { 0xc1 }, to_underlying(operation), Operand::reg(reg));
+    emit8(count);
+}
+
+void Assembler::bsr(Size size, Reg reg, Operand const& operand)
+{
+    emit(size, { 0x0f, 0xbd }, to_underlying(reg), operand);
+}
+
+void Assembler::bsf(Size size, Reg reg, Operand const& operand)
+{
+    emit(size, { 0x0f, 0xbc }, to_underlying(reg), operand);
+}
+
+void Assembler::cmov(Condition condition, Size size, Reg reg, Operand const& operand)
+{
+    emit(size, { 0x0f, static_cast<u8>(0x40 | to_underlying(condition)) }, to_underlying(reg), operand);
+}
+
+void Assembler::set(Condition condition, Reg reg)
+{
+    VERIFY(reg <= Reg::RBX);
+    emit(Size::Dword, { 0x0f, static_cast<u8>(0x90 | to_underlying(condition)) }, 0, Operand::reg(reg));
+}
+
+void Assembler::movd(Size size, XMM xmm, Reg reg)
+{
+    emit(size, { 0x0f, 0x6e }, to_underlying(xmm), Operand::reg(reg), 0x66);
+}
+
+void Assembler::movd(Size size, Reg reg, XMM xmm)
+{
+    emit(size, { 0x0f, 0x7e }, to_underlying(xmm), Operand::reg(reg), 0x66);
+}
+
+void Assembler::float_operation(FloatOperation operation, Size size, XMM destination, XMM source)
+{
+    emit(Size::Dword, { 0x0f, to_underlying(operation) }, to_underlying(destination), Operand::reg(static_cast<Reg>(source)), float_prefix(size));
+}
+
+void Assembler::ucomis(Size size, XMM lhs, XMM rhs)
+{
+    Optional<u8> prefix;
+    if (size == Size::Qword)
+        prefix = 0x66;
+    emit(Size::Dword, { 0x0f, 0x2e }, to_underlying(lhs), Operand::reg(static_cast<Reg>(rhs)), prefix);
+}
+
+void Assembler::convert_integer_to_float(Size float_size, Size integer_size, XMM xmm, Reg reg)
+{
+    emit(integer_size, { 0x0f, 0x2a }, to_underlying(xmm), Operand::reg(reg), float_prefix(float_size));
+}
+
+void Assembler::convert_float_to_float(Size from, XMM destination, XMM source)
+{
+    emit(Size::Dword, { 0x0f, 0x5a }, to_underlying(destination), Operand::reg(static_cast<Reg>(source)), float_prefix(from));
+}
+
+void Assembler::jump_table_entry(size_t table_offset, size_t target_offset)
+{
+    emit32(target_offset - table_offset);
+}
+
+}
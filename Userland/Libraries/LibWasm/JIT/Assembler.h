@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Optional.h>
+#include <AK/Types.h>
+#include <AK/Vector.h>
+
+namespace Wasm::JIT {
+
+// Just enough of an x86-64 assembler for the JIT: general purpose registers, two scalar SSE registers
+// to do float arithmetic in, and memory operands made of a base register, an optional scaled index and a displacement.
+class Assembler {
+public:
+    enum class Reg : u8 {
+        RAX = 0,
+        RCX,
+        RDX,
+        RBX,
+        RSP,
+        RBP,
+        RSI,
+        RDI,
+        R8,
+        R9,
+        R10,
+        R11,
+        R12,
+        R13,
+        R14,
+        R15,
+    };
+
+    enum class XMM : u8 {
+        XMM0 = 0,
+        XMM1,
+    };
+
+    enum class Condition : u8 {
+        Overflow = 0x0,
+        NotOverflow = 0x1,
+        Below = 0x2,
+        AboveOrEqual = 0x3,
+        Equal = 0x4,
+        NotEqual = 0x5,
+        BelowOrEqual = 0x6,
+        Above = 0x7,
+        Sign = 0x8,
+        NotSign = 0x9,
+        Parity = 0xa,
+        NotParity = 0xb,
+        Less = 0xc,
+        GreaterOrEqual = 0xd,
+        LessOrEqual = 0xe,
+        Greater = 0xf,
+    };
+
+    enum class Size : u8 {
+        Dword,
+        Qword,
+    };
+
+    // The value is the /digit the operation has in the 0x81 group, and its `op reg, r/m` opcode divided by 8.
+    enum class ALU : u8 {
+        Add = 0,
+        Or = 1,
+        And = 4,
+        Sub = 5,
+        Xor = 6,
+        Cmp = 7,
+    };
+
+    // The /digit of the operation in the 0xd3 group.
+    enum class Shift : u8 {
+        RotateLeft = 0,
+        RotateRight = 1,
+        Left = 4,
+        LogicalRight = 5,
+        ArithmeticRight = 7,
+    };
+
+    // The opcode of the operation after its 0xf2 (double) or 0xf3 (float) prefix and 0x0f.
+    enum class FloatOperation : u8 {
+        Sqrt = 0x51,
+        Add = 0x58,
+        Mul = 0x59,
+        Sub = 0x5c,
+        Div = 0x5e,
+    };
+
+    struct Operand {
+        enum class Kind : u8 {
+            Register,
+            Memory,
+        };
+
+        static Operand reg(Reg reg) { return { Kind::Register, reg, {}, 0, 0 }; }
+        static Operand mem(Reg base, i32 displacement = 0) { return { Kind::Memory, base, {}, 0, displacement }; }
+        static Operand indexed(Reg base, Reg index, u8 scale_shift = 0, i32 displacement = 0) { return { Kind::Memory, base, index, scale_shift, displacement }; }
+
+        bool is_register() const { return kind == Kind::Register; }
+
+        Kind kind;
+        // The register itself, or the base of the memory operand.
+        Reg base;
+        Optional<Reg> index;
+        u8 scale_shift;
+        i32 displacement;
+    };
+
+    // Jumps to a label that hasn't been bound yet are patched once it is.
+    struct Label {
+        Optional<size_t> offset;
+        Vector<size_t> pending_jumps;
+    };
+
+    auto& code() const { return m_code; }
+    size_t offset() const { return m_code.size(); }
+
+    void bind(Label&);
+    void jump(Label&);
+    void jump_if(Condition, Label&);
+    void jump(Reg);
+    void call(Reg);
+    void ret();
+    void push(Reg);
+    void pop(Reg);
+
+    // Loads the address of a label, for things like jump tables that sit in the code.
+    void lea(Reg, Label&);
+    void lea(Reg, Operand const&);
+
+    void mov(Size, Operand const& destination, Operand const& source);
+    void mov(Reg, u64 immediate);
+    // Stores the lowest byte or word of a register.
+    void store8(Operand const& destination, Reg);
+    void store16(Operand const& destination, Reg);
+    void movzx8(Reg, Operand const&);
+    void movzx16(Reg, Operand const&);
+    void movsx8(Size, Reg, Operand const&);
+    void movsx16(Size, Reg, Operand const&);
+    void movsxd(Reg, Operand const&);
+
+    void alu(ALU, Size, Reg destination, Operand const& source);
+    void alu(ALU, Size, Operand const& destination, i32 immediate);
+    void test(Size, Operand const&, Reg);
+    void imul(Size, Reg, Operand const&);
+    void neg(Size, Reg);
+    // Signed and unsigned division of rdx:rax, with the quotient in rax and the remainder in rdx.
+    void idiv(Size, Reg divisor);
+    void div(Size, Reg divisor);
+    // Sign-extends rax into rdx, for idiv.
+    void sign_extend_accumulator(Size);
+    void shift_by_cl(Shift, Size, Reg);
+    void shift(Shift, Size, Reg, u8 count);
+    void bsr(Size, Reg, Operand const&);
+    void bsf(Size, Reg, Operand const&);
+    void cmov(Condition, Size, Reg, Operand const&);
+    // Sets the lowest byte of the register to 0 or 1, so it had better be one that doesn't need a REX prefix.
+    void set(Condition, Reg);
+
+    void movd(Size, XMM, Reg);
+    void movd(Size, Reg, XMM);
+    void float_operation(FloatOperation, Size, XMM destination, XMM source);
+    // Sets the flags like an unsigned comparison would, and the parity flag if either side is NaN.
+    void ucomis(Size, XMM, XMM);
+    void convert_integer_to_float(Size float_size, Size integer_size, XMM, Reg);
+    void convert_float_to_float(Size from, XMM destination, XMM source);
+
+    // An entry of a jump table, as the offset of its target from the start of the table.
+    void jump_table_entry(size_t table_offset, size_t target_offset);
+
+private:
+    void emit8(u8 value) { m_code.append(value); }
+    void emit32(u32 value);
+    void emit64(u64 value);
+    void emit_rex(bool wide, u8 reg, Operand const&, bool force = false);
+    void emit_modrm(u8 reg, Operand const&);
+    void emit(Size, std::initializer_list<u8> opcode, u8 reg, Operand const&, Optional<u8> prefix = {});
+    void emit_jump_to(Label&);
+
+    Vector<u8> m_code;
+};
+
+}
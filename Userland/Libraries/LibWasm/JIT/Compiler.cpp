@@ -0,0 +1,1031 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <AK/Platform.h>
+#include <AK/StringView.h>
+#include <LibWasm/AbstractMachine/BytecodeInterpreter.h>
+#include <LibWasm/AbstractMachine/Configuration.h>
+#include <LibWasm/JIT/Assembler.h>
+#include <LibWasm/JIT/Compiler.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+// Serenity doesn't let memory become executable once it has been writable, so there's only a JIT for other x86-64 hosts for now.
+#if ARCH(X86_64) && !defined(__serenity__)
+#    define WASM_JIT_SUPPORTED 1
+#else
+#    define WASM_JIT_SUPPORTED 0
+#endif
+
+namespace Wasm::JIT {
+
+using Reg = Assembler::Reg;
+using XMM = Assembler::XMM;
+using Size = Assembler::Size;
+using Condition = Assembler::Condition;
+using Operand = Assembler::Operand;
+using ALU = Assembler::ALU;
+using Shift = Assembler::Shift;
+using FloatOperation = Assembler::FloatOperation;
+
+// Everything the machine code needs to know about the outside world. It keeps a pointer to this in a register.
+struct Context {
+    u64* locals;
+    u64* operands;
+    u8* memory_base;
+    u64 memory_size;
+    // How many operands were on the stack when the expression returned.
+    u64 height;
+    BytecodeInterpreter* interpreter;
+    Configuration* configuration;
+    ModuleInstance const* module;
+    size_t locals_base;
+
+    // The interpreter can grow the stack and the memory, so this has to be done every time it has run something.
+    void reload()
+    {
+        locals = configuration->stack().entries().data() + locals_base;
+        memory_base = nullptr;
+        memory_size = 0;
+        if (module->memories().is_empty())
+            return;
+        if (auto* memory = configuration->store().get(module->memories().first())) {
+            memory_base = memory->data().data();
+            memory_size = memory->size();
+        }
+    }
+};
+
+// What the machine code returns.
+enum class ExitStatus : u32 {
+    Returned,
+    // The interpreter has already set its trap.
+    TrappedInInterpreter,
+    Unreachable,
+    MemoryAccessOutOfBounds,
+    DivisionByZero,
+    IntegerOverflow,
+    TooManyBranches,
+    __Count,
+};
+
+// These have to be what the interpreter reports for the same trap, which for division is the condition it checks.
+static StringView trap_reason(ExitStatus status)
+{
+    switch (status) {
+    case ExitStatus::Unreachable:
+        return "Unreachable"sv;
+    case ExitStatus::MemoryAccessOutOfBounds:
+        return "Memory access out of bounds"sv;
+    case ExitStatus::DivisionByZero:
+        return "rhs != 0"sv;
+    case ExitStatus::IntegerOverflow:
+        return "!lhs.has_overflow()"sv;
+    case ExitStatus::TooManyBranches:
+        return "Exceeded maximum allowed number of branches"sv;
+    default:
+        VERIFY_NOT_REACHED();
+    }
+}
+
+// Runs an instruction that isn't compiled, by moving its operands over to the interpreter's stack and its results back.
+static u32 run_in_interpreter(Context* context, LoweredInstruction const* instruction, u64 height, u64 pops, u64 pushes)
+{
+    auto& stack = context->configuration->stack();
+    auto first_operand = height - pops;
+    for (auto i = first_operand; i < height; ++i)
+        stack.push(context->operands[i]);
+    context->interpreter->interpret_lowered_instruction(*context->configuration, *instruction);
+    if (context->interpreter->did_trap())
+        return to_underlying(ExitStatus::TrappedInInterpreter);
+    for (auto i = first_operand + pushes; i > first_operand; --i)
+        context->operands[i - 1] = stack.pop();
+    context->reload();
+    return to_underlying(ExitStatus::Returned);
+}
+
+// r12 to r15 and rbp hold what would otherwise have to be loaded from the context all the time, and rbx counts down the
+// branches that may still be taken. The operands closest to the bottom of the stack live in the registers listed in
+// operand_registers, and the rest in the operands array. rax, rcx, rdx and the SSE registers are scratch.
+static constexpr auto context_register = Reg::R12;
+static constexpr auto operands_register = Reg::R13;
+static constexpr auto locals_register = Reg::R14;
+static constexpr auto memory_base_register = Reg::R15;
+static constexpr auto memory_size_register = Reg::RBP;
+static constexpr auto branch_budget_register = Reg::RBX;
+static constexpr Array operand_registers { Reg::RSI, Reg::RDI, Reg::R8, Reg::R9, Reg::R10, Reg::R11 };
+static constexpr Array callee_saved_registers { Reg::RBP, Reg::RBX, Reg::R12, Reg::R13, Reg::R14, Reg::R15 };
+
+struct StackEffect {
+    u32 pops { 0 };
+    u32 pushes { 0 };
+};
+
+// Compiles a lowered expression in a single pass. The height of the operand stack is known for every reachable
+// instruction, so each operand has a fixed home and none of the interpreter's stack bookkeeping survives into the code.
+class Compiler {
+public:
+    Compiler(LoweredExpression const& lowered, Configuration& configuration)
+        : m_lowered(lowered)
+        , m_configuration(configuration)
+    {
+    }
+
+    Optional<Vector<u8>> compile();
+
+private:
+    bool compile(LoweredInstruction const&, u32 height);
+    Optional<StackEffect> stack_effect(LoweredInstruction const&) const;
+
+    Operand slot(u32 depth) const
+    {
+        if (depth < operand_registers.size())
+            return Operand::reg(operand_registers[depth]);
+        return spill_slot(depth);
+    }
+    static Operand spill_slot(u32 depth) { return Operand::mem(operands_register, depth * sizeof(u64)); }
+    static Operand local(u32 index) { return Operand::mem(locals_register, index * sizeof(u64)); }
+    static Operand context_field(size_t offset) { return Operand::mem(context_register, offset); }
+    static Operand memory_at_rax() { return Operand::indexed(memory_base_register, Reg::RAX); }
+
+    void load(Reg, u32 depth);
+    void store(u32 depth, Reg);
+    void move(u32 from_depth, u32 to_depth);
+    void spill_registers(u32 height);
+    void reload_registers(u32 height);
+
+    bool record_height(size_t target, u32 height);
+    bool branch(u32 height, BranchTarget const&);
+    void test_condition(u32 depth);
+    void compute_address(u32 depth, u32 offset, u32 size);
+    bool call_interpreter(LoweredInstruction const&, u32 height, Optional<u32>& next_height);
+    void emit_return(u32 height);
+
+    template<typename Callback>
+    void unary(u32 height, Callback);
+    template<typename Callback>
+    void binary(u32 height, Callback);
+    void compare(Condition, Size, u32 height);
+    void equals_zero(Size, u32 height);
+    void shift(Shift, Size, u32 height);
+    void divide(Size, bool is_signed, bool is_remainder, u32 height);
+    void count_zeros(Size, bool leading, u32 height);
+    void float_arithmetic(FloatOperation, Size, u32 height);
+    void float_compare(LoweredOpCode, Size, u32 height);
+    void convert_integer_to_float(Size float_size, Size integer_size, u32 height);
+    void convert_float_to_float(Size from, u32 height);
+
+    Assembler::Label& trap(ExitStatus status) { return m_trap_stubs[to_underlying(status)]; }
+
+    LoweredExpression const& m_lowered;
+    Configuration& m_configuration;
+    Assembler m_assembler;
+    size_t m_index { 0 };
+    Vector<Assembler::Label> m_labels;
+    // The height of the operand stack at each instruction, as long as something has been found to go there.
+    Vector<Optional<u32>> m_heights;
+    Assembler::Label m_exit;
+    Array<Assembler::Label, to_underlying(ExitStatus::__Count)> m_trap_stubs;
+};
+
+void Compiler::load(Reg reg, u32 depth)
+{
+    auto operand = slot(depth);
+    if (operand.is_register() && operand.base == reg)
+        return;
+    m_assembler.mov(Size::Qword, Operand::reg(reg), operand);
+}
+
+void Compiler::store(u32 depth, Reg reg)
+{
+    auto operand = slot(depth);
+    if (operand.is_register() && operand.base == reg)
+        return;
+    m_assembler.mov(Size::Qword, operand, Operand::reg(reg));
+}
+
+void Compiler::move(u32 from_depth, u32 to_depth)
+{
+    if (from_depth == to_depth)
+        return;
+    auto destination = slot(to_depth);
+    if (destination.is_register()) {
+        load(destination.base, from_depth);
+        return;
+    }
+    load(Reg::RAX, from_depth);
+    store(to_depth, Reg::RAX);
+}
+
+void Compiler::spill_registers(u32 height)
+{
+    for (u32 depth = 0; depth < min<u32>(height, operand_registers.size()); ++depth)
+        m_assembler.mov(Size::Qword, spill_slot(depth), slot(depth));
+}
+
+void Compiler::reload_registers(u32 height)
+{
+    for (u32 depth = 0; depth < min<u32>(height, operand_registers.size()); ++depth)
+        m_assembler.mov(Size::Qword, slot(depth), spill_slot(depth));
+}
+
+bool Compiler::record_height(size_t target, u32 height)
+{
+    if (target >= m_heights.size())
+        return false;
+    // Validation makes sure every way to an instruction leaves the same number of values on the stack.
+    if (m_heights[target].has_value())
+        return *m_heights[target] == height;
+    // We've already skipped this instruction for being unreachable, so this has to be coming from dead code.
+    if (target <= m_index)
+        return false;
+    m_heights[target] = height;
+    return true;
+}
+
+bool Compiler::branch(u32 height, BranchTarget const& target)
+{
+    if (target.stack_height + target.arity > height)
+        return false;
+    m_assembler.alu(ALU::Sub, Size::Qword, Operand::reg(branch_budget_register), 1);
+    m_assembler.jump_if(Condition::Below, trap(ExitStatus::TooManyBranches));
+    for (u32 i = 0; i < target.arity; ++i)
+        move(height - target.arity + i, target.stack_height + i);
+    if (!record_height(target.ip.value(), target.stack_height + target.arity))
+        return false;
+    m_assembler.jump(m_labels[target.ip.value()]);
+    return true;
+}
+
+void Compiler::test_condition(u32 depth)
+{
+    auto operand = slot(depth);
+    if (operand.is_register())
+        m_assembler.test(Size::Dword, operand, operand.base);
+    else
+        m_assembler.alu(ALU::Cmp, Size::Dword, operand, 0);
+}
+
+// Leaves the address of the access in rax, once it's sure that all of it is inside the memory.
+void Compiler::compute_address(u32 depth, u32 offset, u32 size)
+{
+    m_assembler.mov(Size::Dword, Operand::reg(Reg::RAX), slot(depth));
+    if (offset > static_cast<u32>(NumericLimits<i32>::max())) {
+        m_assembler.mov(Reg::RCX, offset);
+        m_assembler.alu(ALU::Add, Size::Qword, Reg::RAX, Operand::reg(Reg::RCX));
+    } else if (offset != 0) {
+        m_assembler.alu(ALU::Add, Size::Qword, Operand::reg(Reg::RAX), static_cast<i32>(offset));
+    }
+    m_assembler.lea(Reg::RDX, Operand::mem(Reg::RAX, size));
+    m_assembler.alu(ALU::Cmp, Size::Qword, Reg::RDX, Operand::reg(memory_size_register));
+    m_assembler.jump_if(Condition::Above, trap(ExitStatus::MemoryAccessOutOfBounds));
+}
+
+bool Compiler::call_interpreter(LoweredInstruction const& instruction, u32 height, Optional<u32>& next_height)
+{
+    auto effect = stack_effect(instruction);
+    if (!effect.has_value() || effect->pops > height)
+        return false;
+
+    spill_registers(height);
+    m_assembler.mov(Size::Qword, Operand::reg(Reg::RDI), Operand::reg(context_register));
+    m_assembler.mov(Reg::RSI, bit_cast<FlatPtr>(&instruction));
+    m_assembler.mov(Reg::RDX, height);
+    m_assembler.mov(Reg::RCX, effect->pops);
+    m_assembler.mov(Reg::R8, effect->pushes);
+    m_assembler.mov(Reg::RAX, bit_cast<FlatPtr>(&run_in_interpreter));
+    m_assembler.call(Reg::RAX);
+    m_assembler.test(Size::Dword, Operand::reg(Reg::RAX), Reg::RAX);
+    m_assembler.jump_if(Condition::NotEqual, m_exit);
+
+    if (instruction.opcode == LoweredOpCode::unimplemented) {
+        // The interpreter always traps on these, so this is never reached.
+        m_assembler.jump(trap(ExitStatus::Unreachable));
+        return true;
+    }
+
+    m_assembler.mov(Size::Qword, Operand::reg(locals_register), context_field(offsetof(Context, locals)));
+    m_assembler.mov(Size::Qword, Operand::reg(memory_base_register), context_field(offsetof(Context, memory_base)));
+    m_assembler.mov(Size::Qword, Operand::reg(memory_size_register), context_field(offsetof(Context, memory_size)));
+    next_height = height - effect->pops + effect->pushes;
+    reload_registers(*next_height);
+    return true;
+}
+
+void Compiler::emit_return(u32 height)
+{
+    // CompiledFunction::run() picks the results up from the operands array.
+    auto arity = m_lowered.result_types().size();
+    for (auto depth = height - arity; depth < height; ++depth) {
+        if (slot(depth).is_register())
+            m_assembler.mov(Size::Qword, spill_slot(depth), slot(depth));
+    }
+    m_assembler.mov(Reg::RAX, height);
+    m_assembler.mov(Size::Qword, context_field(offsetof(Context, height)), Operand::reg(Reg::RAX));
+    m_assembler.alu(ALU::Xor, Size::Dword, Reg::RAX, Operand::reg(Reg::RAX));
+    m_assembler.jump(m_exit);
+}
+
+template<typename Callback>
+void Compiler::unary(u32 height, Callback callback)
+{
+    load(Reg::RAX, height - 1);
+    callback();
+    store(height - 1, Reg::RAX);
+}
+
+// The callback gets the register with the left hand side in it, which is also where the result has to go.
+template<typename Callback>
+void Compiler::binary(u32 height, Callback callback)
+{
+    auto lhs = slot(height - 2);
+    if (lhs.is_register()) {
+        callback(lhs.base, slot(height - 1));
+        return;
+    }
+    load(Reg::RAX, height - 2);
+    callback(Reg::RAX, slot(height - 1));
+    store(height - 2, Reg::RAX);
+}
+
+void Compiler::compare(Condition condition, Size size, u32 height)
+{
+    load(Reg::RAX, height - 2);
+    m_assembler.alu(ALU::Cmp, size, Reg::RAX, slot(height - 1));
+    m_assembler.set(condition, Reg::RAX);
+    m_assembler.movzx8(Reg::RAX, Operand::reg(Reg::RAX));
+    store(height - 2, Reg::RAX);
+}
+
+void Compiler::equals_zero(Size size, u32 height)
+{
+    unary(height, [&] {
+        m_assembler.test(size, Operand::reg(Reg::RAX), Reg::RAX);
+        m_assembler.set(Condition::Equal, Reg::RAX);
+        m_assembler.movzx8(Reg::RAX, Operand::reg(Reg::RAX));
+    });
+}
+
+void Compiler::shift(Shift operation, Size size, u32 height)
+{
+    // The CPU only looks at as many bits of the count as wasm does.
+    load(Reg::RCX, height - 1);
+    load(Reg::RAX, height - 2);
+    m_assembler.shift_by_cl(operation, size, Reg::RAX);
+    store(height - 2, Reg::RAX);
+}
+
+void Compiler::divide(Size size, bool is_signed, bool is_remainder, u32 height)
+{
+    Assembler::Label done;
+    load(Reg::RCX, height - 1);
+    m_assembler.test(size, Operand::reg(Reg::RCX), Reg::RCX);
+    m_assembler.jump_if(Condition::Equal, trap(ExitStatus::DivisionByZero));
+    load(Reg::RAX, height - 2);
+    if (is_signed) {
+        // The smallest value divided by -1 doesn't fit, and makes idiv fault even if all we want is the remainder.
+        Assembler::Label divide;
+        m_assembler.alu(ALU::Cmp, size, Operand::reg(Reg::RCX), -1);
+        m_assembler.jump_if(Condition::NotEqual, divide);
+        if (is_remainder) {
+            m_assembler.alu(ALU::Xor, Size::Dword, Reg::RAX, Operand::reg(Reg::RAX));
+            m_assembler.jump(done);
+        } else if (size == Size::Dword) {
+            m_assembler.alu(ALU::Cmp, Size::Dword, Operand::reg(Reg::RAX), NumericLimits<i32>::min());
+            m_assembler.jump_if(Condition::Equal, trap(ExitStatus::IntegerOverflow));
+        } else {
+            m_assembler.mov(Reg::RDX, bit_cast<u64>(NumericLimits<i64>::min()));
+            m_assembler.alu(ALU::Cmp, Size::Qword, Reg::RAX, Operand::reg(Reg::RDX));
+            m_assembler.jump_if(Condition::Equal, trap(ExitStatus::IntegerOverflow));
+        }
+        m_assembler.bind(divide);
+        m_assembler.sign_extend_accumulator(size);
+        m_assembler.idiv(size, Reg::RCX);
+    } else {
+        m_assembler.alu(ALU::Xor, Size::Dword, Reg::RDX, Operand::reg(Reg::RDX));
+        m_assembler.div(size, Reg::RCX);
+    }
+    if (is_remainder)
+        m_assembler.mov(Size::Qword, Operand::reg(Reg::RAX), Operand::reg(Reg::RDX));
+    m_assembler.bind(done);
+    store(height - 2, Reg::RAX);
+}
+
+void Compiler::count_zeros(Size size, bool leading, u32 height)
+{
+    u32 bits = size == Size::Dword ? 32 : 64;
+    unary(height, [&] {
+        if (leading) {
+            // bsr gives us the index of the highest set bit, and leaves the destination alone if there isn't one.
+            m_assembler.mov(Reg::RCX, size == Size::Dword ? NumericLimits<u32>::max() : NumericLimits<u64>::max());
+            m_assembler.bsr(size, Reg::RAX, Operand::reg(Reg::RAX));
+            m_assembler.cmov(Condition::Equal, size, Reg::RAX, Operand::reg(Reg::RCX));
+            m_assembler.neg(size, Reg::RAX);
+            m_assembler.alu(ALU::Add, size, Operand::reg(Reg::RAX), bits - 1);
+        } else {
+            m_assembler.mov(Reg::RCX, bits);
+            m_assembler.bsf(size, Reg::RAX, Operand::reg(Reg::RAX));
+            m_assembler.cmov(Condition::Equal, size, Reg::RAX, Operand::reg(Reg::RCX));
+        }
+    });
+}
+
+void Compiler::float_arithmetic(FloatOperation operation, Size size, u32 height)
+{
+    if (operation == FloatOperation::Sqrt) {
+        unary(height, [&] {
+            m_assembler.movd(size, XMM::XMM0, Reg::RAX);
+            m_assembler.float_operation(operation, size, XMM::XMM0, XMM::XMM0);
+            m_assembler.movd(size, Reg::RAX, XMM::XMM0);
+        });
+        return;
+    }
+    load(Reg::RAX, height - 2);
+    load(Reg::RCX, height - 1);
+    m_assembler.movd(size, XMM::XMM0, Reg::RAX);
+    m_assembler.movd(size, XMM::XMM1, Reg::RCX);
+    m_assembler.float_operation(operation, size, XMM::XMM0, XMM::XMM1);
+    m_assembler.movd(size, Reg::RAX, XMM::XMM0);
+    store(height - 2, Reg::RAX);
+}
+
+void Compiler::float_compare(LoweredOpCode opcode, Size size, u32 height)
+{
+    load(Reg::RAX, height - 2);
+    load(Reg::RCX, height - 1);
+    m_assembler.movd(size, XMM::XMM0, Reg::RAX);
+    m_assembler.movd(size, XMM::XMM1, Reg::RCX);
+    m_assembler.alu(ALU::Xor, Size::Dword, Reg::RAX, Operand::reg(Reg::RAX));
+    m_assembler.alu(ALU::Xor, Size::Dword, Reg::RCX, Operand::reg(Reg::RCX));
+
+    // A comparison with NaN is unordered, which sets the zero, parity and carry flags, and only != may be true then.
+    // So everything but == and != is turned into a > or >=, which the carry flag takes care of.
+    switch (opcode) {
+    case LoweredOpCode::f32_eq:
+    case LoweredOpCode::f64_eq:
+        m_assembler.ucomis(size, XMM::XMM0, XMM::XMM1);
+        m_assembler.set(Condition::Equal, Reg::RAX);
+        m_assembler.set(Condition::NotParity, Reg::RCX);
+        m_assembler.alu(ALU::And, Size::Dword, Reg::RAX, Operand::reg(Reg::RCX));
+        break;
+    case LoweredOpCode::f32_ne:
+    case LoweredOpCode::f64_ne:
+        m_assembler.ucomis(size, XMM::XMM0, XMM::XMM1);
+        m_assembler.set(Condition::NotEqual, Reg::RAX);
+        m_assembler.set(Condition::Parity, Reg::RCX);
+        m_assembler.alu(ALU::Or, Size::Dword, Reg::RAX, Operand::reg(Reg::RCX));
+        break;
+    case LoweredOpCode::f32_lt:
+    case LoweredOpCode::f64_lt:
+        m_assembler.ucomis(size, XMM::XMM1, XMM::XMM0);
+        m_assembler.set(Condition::Above, Reg::RAX);
+        break;
+    case LoweredOpCode::f32_gt:
+    case LoweredOpCode::f64_gt:
+        m_assembler.ucomis(size, XMM::XMM0, XMM::XMM1);
+        m_assembler.set(Condition::Above, Reg::RAX);
+        break;
+    case LoweredOpCode::f32_le:
+    case LoweredOpCode::f64_le:
+        m_assembler.ucomis(size, XMM::XMM1, XMM::XMM0);
+        m_assembler.set(Condition::AboveOrEqual, Reg::RAX);
+        break;
+    case LoweredOpCode::f32_ge:
+    case LoweredOpCode::f64_ge:
+        m_assembler.ucomis(size, XMM::XMM0, XMM::XMM1);
+        m_assembler.set(Condition::AboveOrEqual, Reg::RAX);
+        break;
+    default:
+        VERIFY_NOT_REACHED();
+    }
+    store(height - 2, Reg::RAX);
+}
+
+void Compiler::convert_integer_to_float(Size float_size, Size integer_size, u32 height)
+{
+    unary(height, [&] {
+        m_assembler.convert_integer_to_float(float_size, integer_size, XMM::XMM0, Reg::RAX);
+        m_assembler.movd(float_size, Reg::RAX, XMM::XMM0);
+    });
+}
+
+void Compiler::convert_float_to_float(Size from, u32 height)
+{
+    auto to = from == Size::Dword ? Size::Qword : Size::Dword;
+    unary(height, [&] {
+        m_assembler.movd(from, XMM::XMM0, Reg::RAX);
+        m_assembler.convert_float_to_float(from, XMM::XMM0, XMM::XMM0);
+        m_assembler.movd(to, Reg::RAX, XMM::XMM0);
+    });
+}
+
+// Only needed for the instructions that are left to the interpreter.
+Optional<StackEffect> Compiler::stack_effect(LoweredInstruction const& instruction) const
+{
+    switch (instruction.opcode) {
+    case LoweredOpCode::unimplemented:
+        return StackEffect {};
+    case LoweredOpCode::call: {
+        auto* function = m_configuration.store().get(FunctionAddress { instruction.immediate });
+        if (!function)
+            return {};
+        auto* type = function->visit([](auto const& function) { return &function.type(); });
+        return StackEffect { static_cast<u32>(type->parameters().size()), static_cast<u32>(type->results().size()) };
+    }
+    case LoweredOpCode::call_indirect: {
+        auto& types = m_configuration.frame().module().types();
+        if (instruction.argument >= types.size())
+            return {};
+        auto& type = types[instruction.argument];
+        return StackEffect { static_cast<u32>(type.parameters().size() + 1), static_cast<u32>(type.results().size()) };
+    }
+    case LoweredOpCode::global_get:
+    case LoweredOpCode::memory_size:
+        return StackEffect { 0, 1 };
+    case LoweredOpCode::global_set:
+        return StackEffect { 1, 0 };
+    case LoweredOpCode::f32_min:
+    case LoweredOpCode::f32_max:
+    case LoweredOpCode::f32_copysign:
+    case LoweredOpCode::f64_min:
+    case LoweredOpCode::f64_max:
+    case LoweredOpCode::f64_copysign:
+        return StackEffect { 2, 1 };
+    case LoweredOpCode::memory_grow:
+    case LoweredOpCode::i32_popcnt:
+    case LoweredOpCode::i64_popcnt:
+    case LoweredOpCode::f32_ceil:
+    case LoweredOpCode::f32_floor:
+    case LoweredOpCode::f32_trunc:
+    case LoweredOpCode::f32_nearest:
+    case LoweredOpCode::f64_ceil:
+    case LoweredOpCode::f64_floor:
+    case LoweredOpCode::f64_trunc:
+    case LoweredOpCode::f64_nearest:
+    case LoweredOpCode::i32_trunc_sf32:
+    case LoweredOpCode::i32_trunc_uf32:
+    case LoweredOpCode::i32_trunc_sf64:
+    case LoweredOpCode::i32_trunc_uf64:
+    case LoweredOpCode::i64_trunc_sf32:
+    case LoweredOpCode::i64_trunc_uf32:
+    case LoweredOpCode::i64_trunc_sf64:
+    case LoweredOpCode::i64_trunc_uf64:
+    case LoweredOpCode::i32_trunc_sat_f32_s:
+    case LoweredOpCode::i32_trunc_sat_f32_u:
+    case LoweredOpCode::i32_trunc_sat_f64_s:
+    case LoweredOpCode::i32_trunc_sat_f64_u:
+    case LoweredOpCode::i64_trunc_sat_f32_s:
+    case LoweredOpCode::i64_trunc_sat_f32_u:
+    case LoweredOpCode::i64_trunc_sat_f64_s:
+    case LoweredOpCode::i64_trunc_sat_f64_u:
+    case LoweredOpCode::f32_convert_ui64:
+    case LoweredOpCode::f64_convert_ui64:
+        return StackEffect { 1, 1 };
+    default:
+        return {};
+    }
+}
+
+bool Compiler::compile(LoweredInstruction const& instruction, u32 height)
+{
+    // How many values are left on the stack for the next instruction, unless this one never gets there.
+    Optional<u32> next_height;
+    auto pops_and_pushes = [&](u32 pops, u32 pushes) {
+        if (height < pops)
+            return false;
+        next_height = height - pops + pushes;
+        return true;
+    };
+
+    switch (instruction.opcode) {
+    case LoweredOpCode::unreachable:
+        m_assembler.jump(trap(ExitStatus::Unreachable));
+        break;
+    case LoweredOpCode::constant: {
+        auto destination = slot(height);
+        if (destination.is_register()) {
+            m_assembler.mov(destination.base, instruction.immediate);
+        } else {
+            m_assembler.mov(Reg::RAX, instruction.immediate);
+            store(height, Reg::RAX);
+        }
+        next_height = height + 1;
+        break;
+    }
+    case LoweredOpCode::jump:
+        if (!record_height(instruction.argument, height))
+            return false;
+        m_assembler.jump(m_labels[instruction.argument]);
+        break;
+    case LoweredOpCode::jump_if_zero:
+        if (!pops_and_pushes(1, 0))
+            return false;
+        test_condition(height - 1);
+        if (!record_height(instruction.argument, height - 1))
+            return false;
+        m_assembler.jump_if(Condition::Equal, m_labels[instruction.argument]);
+        break;
+    case LoweredOpCode::br:
+        if (!branch(height, { instruction.argument, instruction.branch_stack_height(), instruction.branch_arity() }))
+            return false;
+        break;
+    case LoweredOpCode::br_if: {
+        if (!pops_and_pushes(1, 0))
+            return false;
+        Assembler::Label not_taken;
+        test_condition(height - 1);
+        m_assembler.jump_if(Condition::Equal, not_taken);
+        if (!branch(height - 1, { instruction.argument, instruction.branch_stack_height(), instruction.branch_arity() }))
+            return false;
+        m_assembler.bind(not_taken);
+        break;
+    }
+    case LoweredOpCode::br_table: {
+        if (height < 1 || instruction.immediate == 0)
+            return false;
+        auto targets = m_lowered.lowered_branch_tables().span().slice(instruction.argument, instruction.immediate);
+        // Indices past the end go to the default target, which is the last one.
+        m_assembler.mov(Size::Dword, Operand::reg(Reg::RAX), slot(height - 1));
+        m_assembler.mov(Reg::RCX, targets.size() - 1);
+        m_assembler.alu(ALU::Cmp, Size::Dword, Reg::RAX, Operand::reg(Reg::RCX));
+        m_assembler.cmov(Condition::Above, Size::Dword, Reg::RAX, Operand::reg(Reg::RCX));
+        Assembler::Label table;
+        m_assembler.lea(Reg::RCX, table);
+        m_assembler.movsxd(Reg::RAX, Operand::indexed(Reg::RCX, Reg::RAX, 2));
+        m_assembler.alu(ALU::Add, Size::Qword, Reg::RAX, Operand::reg(Reg::RCX));
+        m_assembler.jump(Reg::RAX);
+
+        Vector<size_t> target_offsets;
+        target_offsets.ensure_capacity(targets.size());
+        for (auto& target : targets) {
+            target_offsets.unchecked_append(m_assembler.offset());
+            if (!branch(height - 1, target))
+                return false;
+        }
+        m_assembler.bind(table);
+        for (auto offset : target_offsets)
+            m_assembler.jump_table_entry(*table.offset, offset);
+        break;
+    }
+    case LoweredOpCode::return_:
+        if (height < m_lowered.result_types().size())
+            return false;
+        emit_return(height);
+        break;
+    case LoweredOpCode::local_get: {
+        auto destination = slot(height);
+        if (destination.is_register()) {
+            m_assembler.mov(Size::Qword, destination, local(instruction.argument));
+        } else {
+            m_assembler.mov(Size::Qword, Operand::reg(Reg::RAX), local(instruction.argument));
+            store(height, Reg::RAX);
+        }
+        next_height = height + 1;
+        break;
+    }
+    case LoweredOpCode::local_set:
+    case LoweredOpCode::local_tee: {
+        if (!pops_and_pushes(1, instruction.opcode == LoweredOpCode::local_tee ? 1 : 0))
+            return false;
+        auto source = slot(height - 1);
+        if (!source.is_register()) {
+            load(Reg::RAX, height - 1);
+            source = Operand::reg(Reg::RAX);
+        }
+        m_assembler.mov(Size::Qword, local(instruction.argument), source);
+        break;
+    }
+    case LoweredOpCode::drop:
+        if (!pops_and_pushes(1, 0))
+            return false;
+        break;
+    case LoweredOpCode::select:
+        if (!pops_and_pushes(3, 1))
+            return false;
+        load(Reg::RCX, height - 1);
+        load(Reg::RAX, height - 3);
+        m_assembler.test(Size::Dword, Operand::reg(Reg::RCX), Reg::RCX);
+        m_assembler.cmov(Condition::Equal, Size::Qword, Reg::RAX, slot(height - 2));
+        store(height - 3, Reg::RAX);
+        break;
+
+#define __ENUMERATE_LOAD(name, access_size, ...)                        \
+    case LoweredOpCode::name:                                           \
+        if (!pops_and_pushes(1, 1))                                     \
+            return false;                                               \
+        compute_address(height - 1, instruction.argument, access_size); \
+        __VA_ARGS__;                                                    \
+        store(height - 1, Reg::RAX);                                    \
+        break;
+        __ENUMERATE_LOAD(i32_load, 4, m_assembler.mov(Size::Dword, Operand::reg(Reg::RAX), memory_at_rax()))
+        __ENUMERATE_LOAD(i64_load, 8, m_assembler.mov(Size::Qword, Operand::reg(Reg::RAX), memory_at_rax()))
+        __ENUMERATE_LOAD(f32_load, 4, m_assembler.mov(Size::Dword, Operand::reg(Reg::RAX), memory_at_rax()))
+        __ENUMERATE_LOAD(f64_load, 8, m_assembler.mov(Size::Qword, Operand::reg(Reg::RAX), memory_at_rax()))
+        __ENUMERATE_LOAD(i32_load8_s, 1, m_assembler.movsx8(Size::Dword, Reg::RAX, memory_at_rax()))
+        __ENUMERATE_LOAD(i32_load8_u, 1, m_assembler.movzx8(Reg::RAX, memory_at_rax()))
+        __ENUMERATE_LOAD(i32_load16_s, 2, m_assembler.movsx16(Size::Dword, Reg::RAX, memory_at_rax()))
+        __ENUMERATE_LOAD(i32_load16_u, 2, m_assembler.movzx16(Reg::RAX, memory_at_rax()))
+        __ENUMERATE_LOAD(i64_load8_s, 1, m_assembler.movsx8(Size::Qword, Reg::RAX, memory_at_rax()))
+        __ENUMERATE_LOAD(i64_load8_u, 1, m_assembler.movzx8(Reg::RAX, memory_at_rax()))
+        __ENUMERATE_LOAD(i64_load16_s, 2, m_assembler.movsx16(Size::Qword, Reg::RAX, memory_at_rax()))
+        __ENUMERATE_LOAD(i64_load16_u, 2, m_assembler.movzx16(Reg::RAX, memory_at_rax()))
+        __ENUMERATE_LOAD(i64_load32_s, 4, m_assembler.movsxd(Reg::RAX, memory_at_rax()))
+        __ENUMERATE_LOAD(i64_load32_u, 4, m_assembler.mov(Size::Dword, Operand::reg(Reg::RAX), memory_at_rax()))
+#undef __ENUMERATE_LOAD
+
+#define __ENUMERATE_STORE(name, access_size, ...)                       \
+    case LoweredOpCode::name:                                           \
+        if (!pops_and_pushes(2, 0))                                     \
+            return false;                                               \
+        compute_address(height - 2, instruction.argument, access_size); \
+        load(Reg::RCX, height - 1);                                     \
+        __VA_ARGS__;                                                    \
+        break;
+        __ENUMERATE_STORE(i32_store, 4, m_assembler.mov(Size::Dword, memory_at_rax(), Operand::reg(Reg::RCX)))
+        __ENUMERATE_STORE(i64_store, 8, m_assembler.mov(Size::Qword, memory_at_rax(), Operand::reg(Reg::RCX)))
+        __ENUMERATE_STORE(f32_store, 4, m_assembler.mov(Size::Dword, memory_at_rax(), Operand::reg(Reg::RCX)))
+        __ENUMERATE_STORE(f64_store, 8, m_assembler.mov(Size::Qword, memory_at_rax(), Operand::reg(Reg::RCX)))
+        __ENUMERATE_STORE(i32_store8, 1, m_assembler.store8(memory_at_rax(), Reg::RCX))
+        __ENUMERATE_STORE(i32_store16, 2, m_assembler.store16(memory_at_rax(), Reg::RCX))
+        __ENUMERATE_STORE(i64_store8, 1, m_assembler.store8(memory_at_rax(), Reg::RCX))
+        __ENUMERATE_STORE(i64_store16, 2, m_assembler.store16(memory_at_rax(), Reg::RCX))
+        __ENUMERATE_STORE(i64_store32, 4, m_assembler.mov(Size::Dword, memory_at_rax(), Operand::reg(Reg::RCX)))
+#undef __ENUMERATE_STORE
+
+#define __ENUMERATE_BINARY(name, ...) \
+    case LoweredOpCode::name:         \
+        if (!pops_and_pushes(2, 1))   \
+            return false;             \
+        __VA_ARGS__;                  \
+        break;
+        __ENUMERATE_BINARY(i32_eq, compare(Condition::Equal, Size::Dword, height))
+        __ENUMERATE_BINARY(i32_ne, compare(Condition::NotEqual, Size::Dword, height))
+        __ENUMERATE_BINARY(i32_lts, compare(Condition::Less, Size::Dword, height))
+        __ENUMERATE_BINARY(i32_ltu, compare(Condition::Below, Size::Dword, height))
+        __ENUMERATE_BINARY(i32_gts, compare(Condition::Greater, Size::Dword, height))
+        __ENUMERATE_BINARY(i32_gtu, compare(Condition::Above, Size::Dword, height))
+        __ENUMERATE_BINARY(i32_les, compare(Condition::LessOrEqual, Size::Dword, height))
+        __ENUMERATE_BINARY(i32_leu, compare(Condition::BelowOrEqual, Size::Dword, height))
+        __ENUMERATE_BINARY(i32_ges, compare(Condition::GreaterOrEqual, Size::Dword, height))
+        __ENUMERATE_BINARY(i32_geu, compare(Condition::AboveOrEqual, Size::Dword, height))
+        __ENUMERATE_BINARY(i64_eq, compare(Condition::Equal, Size::Qword, height))
+        __ENUMERATE_BINARY(i64_ne, compare(Condition::NotEqual, Size::Qword, height))
+        __ENUMERATE_BINARY(i64_lts, compare(Condition::Less, Size::Qword, height))
+        __ENUMERATE_BINARY(i64_ltu, compare(Condition::Below, Size::Qword, height))
+        __ENUMERATE_BINARY(i64_gts, compare(Condition::Greater, Size::Qword, height))
+        __ENUMERATE_BINARY(i64_gtu, compare(Condition::Above, Size::Qword, height))
+        __ENUMERATE_BINARY(i64_les, compare(Condition::LessOrEqual, Size::Qword, height))
+        __ENUMERATE_BINARY(i64_leu, compare(Condition::BelowOrEqual, Size::Qword, height))
+        __ENUMERATE_BINARY(i64_ges, compare(Condition::GreaterOrEqual, Size::Qword, height))
+        __ENUMERATE_BINARY(i64_geu, compare(Condition::AboveOrEqual, Size::Qword, height))
+        __ENUMERATE_BINARY(f32_eq, float_compare(instruction.opcode, Size::Dword, height))
+        __ENUMERATE_BINARY(f32_ne, float_compare(instruction.opcode, Size::Dword, height))
+        __ENUMERATE_BINARY(f32_lt, float_compare(instruction.opcode, Size::Dword, height))
+        __ENUMERATE_BINARY(f32_gt, float_compare(instruction.opcode, Size::Dword, height))
+        __ENUMERATE_BINARY(f32_le, float_compare(instruction.opcode, Size::Dword, height))
+        __ENUMERATE_BINARY(f32_ge, float_compare(instruction.opcode, Size::Dword, height))
+        __ENUMERATE_BINARY(f64_eq, float_compare(instruction.opcode, Size::Qword, height))
+        __ENUMERATE_BINARY(f64_ne, float_compare(instruction.opcode, Size::Qword, height))
+        __ENUMERATE_BINARY(f64_lt, float_compare(instruction.opcode, Size::Qword, height))
+        __ENUMERATE_BINARY(f64_gt, float_compare(instruction.opcode, Size::Qword, height))
+        __ENUMERATE_BINARY(f64_le, float_compare(instruction.opcode, Size::Qword, height))
+        __ENUMERATE_BINARY(f64_ge, float_compare(instruction.opcode, Size::Qword, height))
+        __ENUMERATE_BINARY(i32_add, binary(height, [&](Reg lhs, Operand rhs) { m_assembler.alu(ALU::Add, Size::Dword, lhs, rhs); }))
+        __ENUMERATE_BINARY(i32_sub, binary(height, [&](Reg lhs, Operand rhs) { m_assembler.alu(ALU::Sub, Size::Dword, lhs, rhs); }))
+        __ENUMERATE_BINARY(i32_mul, binary(height, [&](Reg lhs, Operand rhs) { m_assembler.imul(Size::Dword, lhs, rhs); }))
+        __ENUMERATE_BINARY(i32_divs, divide(Size::Dword, true, false, height))
+        __ENUMERATE_BINARY(i32_divu, divide(Size::Dword, false, false, height))
+        __ENUMERATE_BINARY(i32_rems, divide(Size::Dword, true, true, height))
+        __ENUMERATE_BINARY(i32_remu, divide(Size::Dword, false, true, height))
+        __ENUMERATE_BINARY(i32_and, binary(height, [&](Reg lhs, Operand rhs) { m_assembler.alu(ALU::And, Size::Dword, lhs, rhs); }))
+        __ENUMERATE_BINARY(i32_or, binary(height, [&](Reg lhs, Operand rhs) { m_assembler.alu(ALU::Or, Size::Dword, lhs, rhs); }))
+        __ENUMERATE_BINARY(i32_xor, binary(height, [&](Reg lhs, Operand rhs) { m_assembler.alu(ALU::Xor, Size::Dword, lhs, rhs); }))
+        __ENUMERATE_BINARY(i32_shl, shift(Shift::Left, Size::Dword, height))
+        __ENUMERATE_BINARY(i32_shrs, shift(Shift::ArithmeticRight, Size::Dword, height))
+        __ENUMERATE_BINARY(i32_shru, shift(Shift::LogicalRight, Size::Dword, height))
+        __ENUMERATE_BINARY(i32_rotl, shift(Shift::RotateLeft, Size::Dword, height))
+        __ENUMERATE_BINARY(i32_rotr, shift(Shift::RotateRight, Size::Dword, height))
+        __ENUMERATE_BINARY(i64_add, binary(height, [&](Reg lhs, Operand rhs) { m_assembler.alu(ALU::Add, Size::Qword, lhs, rhs); }))
+        __ENUMERATE_BINARY(i64_sub, binary(height, [&](Reg lhs, Operand rhs) { m_assembler.alu(ALU::Sub, Size::Qword, lhs, rhs); }))
+        __ENUMERATE_BINARY(i64_mul, binary(height, [&](Reg lhs, Operand rhs) { m_assembler.imul(Size::Qword, lhs, rhs); }))
+        __ENUMERATE_BINARY(i64_divs, divide(Size::Qword, true, false, height))
+        __ENUMERATE_BINARY(i64_divu, divide(Size::Qword, false, false, height))
+        __ENUMERATE_BINARY(i64_rems, divide(Size::Qword, true, true, height))
+        __ENUMERATE_BINARY(i64_remu, divide(Size::Qword, false, true, height))
+        __ENUMERATE_BINARY(i64_and, binary(height, [&](Reg lhs, Operand rhs) { m_assembler.alu(ALU::And, Size::Qword, lhs, rhs); }))
+        __ENUMERATE_BINARY(i64_or, binary(height, [&](Reg lhs, Operand rhs) { m_assembler.alu(ALU::Or, Size::Qword, lhs, rhs); }))
+        __ENUMERATE_BINARY(i64_xor, binary(height, [&](Reg lhs, Operand rhs) { m_assembler.alu(ALU::Xor, Size::Qword, lhs, rhs); }))
+        __ENUMERATE_BINARY(i64_shl, shift(Shift::Left, Size::Qword, height))
+        __ENUMERATE_BINARY(i64_shrs, shift(Shift::ArithmeticRight, Size::Qword, height))
+        __ENUMERATE_BINARY(i64_shru, shift(Shift::LogicalRight, Size::Qword, height))
+        __ENUMERATE_BINARY(i64_rotl, shift(Shift::RotateLeft, Size::Qword, height))
+        __ENUMERATE_BINARY(i64_rotr, shift(Shift::RotateRight, Size::Qword, height))
+        __ENUMERATE_BINARY(f32_add, float_arithmetic(FloatOperation::Add, Size::Dword, height))
+        __ENUMERATE_BINARY(f32_sub, float_arithmetic(FloatOperation::Sub, Size::Dword, height))
+        __ENUMERATE_BINARY(f32_mul, float_arithmetic(FloatOperation::Mul, Size::Dword, height))
+        __ENUMERATE_BINARY(f32_div, float_arithmetic(FloatOperation::Div, Size::Dword, height))
+        __ENUMERATE_BINARY(f64_add, float_arithmetic(FloatOperation::Add, Size::Qword, height))
+        __ENUMERATE_BINARY(f64_sub, float_arithmetic(FloatOperation::Sub, Size::Qword, height))
+        __ENUMERATE_BINARY(f64_mul, float_arithmetic(FloatOperation::Mul, Size::Qword, height))
+        __ENUMERATE_BINARY(f64_div, float_arithmetic(FloatOperation::Div, Size::Qword, height))
+#undef __ENUMERATE_BINARY
+
+// i32 values and the bits of f32 values are kept zero-extended, which makes some of the conversions between them free.
+#define __ENUMERATE_UNARY(name, ...) \
+    case LoweredOpCode::name:        \
+        if (!pops_and_pushes(1, 1))  \
+            return false;            \
+        __VA_ARGS__;                 \
+        break;
+        __ENUMERATE_UNARY(i32_eqz, equals_zero(Size::Dword, height))
+        __ENUMERATE_UNARY(i64_eqz, equals_zero(Size::Qword, height))
+        __ENUMERATE_UNARY(ref_is_null, equals_zero(Size::Qword, height))
+        __ENUMERATE_UNARY(i32_clz, count_zeros(Size::Dword, true, height))
+        __ENUMERATE_UNARY(i32_ctz, count_zeros(Size::Dword, false, height))
+        __ENUMERATE_UNARY(i64_clz, count_zeros(Size::Qword, true, height))
+        __ENUMERATE_UNARY(i64_ctz, count_zeros(Size::Qword, false, height))
+        __ENUMERATE_UNARY(f32_abs, unary(height, [&] { m_assembler.alu(ALU::And, Size::Dword, Operand::reg(Reg::RAX), NumericLimits<i32>::max()); }))
+        __ENUMERATE_UNARY(f32_neg, unary(height, [&] { m_assembler.alu(ALU::Xor, Size::Dword, Operand::reg(Reg::RAX), NumericLimits<i32>::min()); }))
+        __ENUMERATE_UNARY(f32_sqrt, float_arithmetic(FloatOperation::Sqrt, Size::Dword, height))
+        __ENUMERATE_UNARY(f64_abs, unary(height, [&] {
+            m_assembler.shift(Shift::Left, Size::Qword, Reg::RAX, 1);
+            m_assembler.shift(Shift::LogicalRight, Size::Qword, Reg::RAX, 1);
+        }))
+        __ENUMERATE_UNARY(f64_neg, unary(height, [&] {
+            m_assembler.mov(Reg::RCX, bit_cast<u64>(NumericLimits<i64>::min()));
+            m_assembler.alu(ALU::Xor, Size::Qword, Reg::RAX, Operand::reg(Reg::RCX));
+        }))
+        __ENUMERATE_UNARY(f64_sqrt, float_arithmetic(FloatOperation::Sqrt, Size::Qword, height))
+        __ENUMERATE_UNARY(i32_wrap_i64, unary(height, [&] { m_assembler.mov(Size::Dword, Operand::reg(Reg::RAX), Operand::reg(Reg::RAX)); }))
+        __ENUMERATE_UNARY(i64_extend_si32, unary(height, [&] { m_assembler.movsxd(Reg::RAX, Operand::reg(Reg::RAX)); }))
+        __ENUMERATE_UNARY(i64_extend_ui32, )
+        __ENUMERATE_UNARY(f32_convert_si32, convert_integer_to_float(Size::Dword, Size::Dword, height))
+        __ENUMERATE_UNARY(f32_convert_ui32, convert_integer_to_float(Size::Dword, Size::Qword, height))
+        __ENUMERATE_UNARY(f32_convert_si64, convert_integer_to_float(Size::Dword, Size::Qword, height))
+        __ENUMERATE_UNARY(f32_demote_f64, convert_float_to_float(Size::Qword, height))
+        __ENUMERATE_UNARY(f64_convert_si32, convert_integer_to_float(Size::Qword, Size::Dword, height))
+        __ENUMERATE_UNARY(f64_convert_ui32, convert_integer_to_float(Size::Qword, Size::Qword, height))
+        __ENUMERATE_UNARY(f64_convert_si64, convert_integer_to_float(Size::Qword, Size::Qword, height))
+        __ENUMERATE_UNARY(f64_promote_f32, convert_float_to_float(Size::Dword, height))
+        __ENUMERATE_UNARY(i32_reinterpret_f32, )
+        __ENUMERATE_UNARY(i64_reinterpret_f64, )
+        __ENUMERATE_UNARY(f32_reinterpret_i32, )
+        __ENUMERATE_UNARY(f64_reinterpret_i64, )
+        __ENUMERATE_UNARY(i32_extend8_s, unary(height, [&] { m_assembler.movsx8(Size::Dword, Reg::RAX, Operand::reg(Reg::RAX)); }))
+        __ENUMERATE_UNARY(i32_extend16_s, unary(height, [&] { m_assembler.movsx16(Size::Dword, Reg::RAX, Operand::reg(Reg::RAX)); }))
+        __ENUMERATE_UNARY(i64_extend8_s, unary(height, [&] { m_assembler.movsx8(Size::Qword, Reg::RAX, Operand::reg(Reg::RAX)); }))
+        __ENUMERATE_UNARY(i64_extend16_s, unary(height, [&] { m_assembler.movsx16(Size::Qword, Reg::RAX, Operand::reg(Reg::RAX)); }))
+        __ENUMERATE_UNARY(i64_extend32_s, unary(height, [&] { m_assembler.movsxd(Reg::RAX, Operand::reg(Reg::RAX)); }))
+#undef __ENUMERATE_UNARY
+
+    default:
+        // Calls, globals, memory.size and memory.grow, and the numeric instructions that aren't worth compiling.
+        if (!call_interpreter(instruction, height, next_height))
+            return false;
+        break;
+    }
+
+    if (next_height.has_value())
+        return record_height(m_index + 1, *next_height);
+    return true;
+}
+
+Optional<Vector<u8>> Compiler::compile()
+{
+    auto& instructions = m_lowered.lowered_instructions();
+    m_labels.resize(instructions.size());
+    m_heights.resize(instructions.size());
+    m_heights[0] = 0;
+
+    for (auto reg : callee_saved_registers)
+        m_assembler.push(reg);
+    // The return address and six pushes leave the stack 8 bytes away from the alignment that calls need.
+    m_assembler.alu(ALU::Sub, Size::Qword, Operand::reg(Reg::RSP), 8);
+    m_assembler.mov(Size::Qword, Operand::reg(context_register), Operand::reg(Reg::RDI));
+    m_assembler.mov(Size::Qword, Operand::reg(operands_register), context_field(offsetof(Context, operands)));
+    m_assembler.mov(Size::Qword, Operand::reg(locals_register), context_field(offsetof(Context, locals)));
+    m_assembler.mov(Size::Qword, Operand::reg(memory_base_register), context_field(offsetof(Context, memory_base)));
+    m_assembler.mov(Size::Qword, Operand::reg(memory_size_register), context_field(offsetof(Context, memory_size)));
+    m_assembler.mov(branch_budget_register, Constants::max_allowed_taken_branches_per_call);
+
+    for (m_index = 0; m_index < instructions.size(); ++m_index) {
+        m_assembler.bind(m_labels[m_index]);
+        // If we don't know how high the stack is here, nothing can get here either.
+        if (!m_heights[m_index].has_value())
+            continue;
+        if (!compile(instructions[m_index], *m_heights[m_index]))
+            return {};
+    }
+
+    for (size_t i = 0; i < m_trap_stubs.size(); ++i) {
+        auto& stub = m_trap_stubs[i];
+        if (stub.pending_jumps.is_empty())
+            continue;
+        m_assembler.bind(stub);
+        m_assembler.mov(Reg::RAX, i);
+        m_assembler.jump(m_exit);
+    }
+
+    m_assembler.bind(m_exit);
+    m_assembler.alu(ALU::Add, Size::Qword, Operand::reg(Reg::RSP), 8);
+    for (size_t i = callee_saved_registers.size(); i > 0; --i)
+        m_assembler.pop(callee_saved_registers[i - 1]);
+    m_assembler.ret();
+    return m_assembler.code();
+}
+
+OwnPtr<CompiledFunction> CompiledFunction::create(Vector<u8> const& code, size_t operand_count, size_t result_count)
+{
+    auto* memory = mmap(nullptr, code.size(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED)
+        return {};
+    memcpy(memory, code.data(), code.size());
+    if (mprotect(memory, code.size(), PROT_READ | PROT_EXEC) < 0) {
+        munmap(memory, code.size());
+        return {};
+    }
+    return adopt_own(*new CompiledFunction(memory, code.size(), operand_count, result_count));
+}
+
+CompiledFunction::~CompiledFunction()
+{
+    munmap(m_code, m_size);
+}
+
+Optional<Trap> CompiledFunction::run(BytecodeInterpreter& interpreter, Configuration& configuration) const
+{
+    Vector<u64, 32> operands;
+    operands.resize(m_operand_count);
+
+    Context context {};
+    context.operands = operands.data();
+    context.interpreter = &interpreter;
+    context.configuration = &configuration;
+    context.module = &configuration.frame().module();
+    context.locals_base = configuration.frame().locals_base();
+    context.reload();
+
+    using Entry = u32 (*)(Context*);
+    auto status = static_cast<ExitStatus>(bit_cast<Entry>(m_code)(&context));
+    switch (status) {
+    case ExitStatus::Returned: {
+        // The caller picks the results up from the top of the stack, like it would after the interpreter.
+        auto& stack = configuration.stack();
+        for (auto i = context.height - m_result_count; i < context.height; ++i)
+            stack.push(operands[i]);
+        return {};
+    }
+    case ExitStatus::TrappedInInterpreter:
+        return {};
+    default:
+        return Trap { trap_reason(status) };
+    }
+}
+
+bool is_supported()
+{
+    return WASM_JIT_SUPPORTED;
+}
+
+Optional<size_t> default_threshold()
+{
+#if WASM_JIT_SUPPORTED
+    auto* value = getenv("WASM_JIT_THRESHOLD");
+    if (!value)
+        return Constants::jit_call_threshold;
+    // Anything but a number turns the JIT off.
+    if (auto threshold = StringView { value }.to_uint(); threshold.has_value())
+        return *threshold;
+#endif
+    return {};
+}
+
+CompiledFunction const* compiled_function_for(LoweredExpression const& lowered, Configuration& configuration, size_t threshold)
+{
+#if WASM_JIT_SUPPORTED
+    auto& state = lowered.jit_state();
+    if (state.compiled_function)
+        return state.compiled_function.ptr();
+    if (state.compilation_failed || ++state.run_count < threshold)
+        return nullptr;
+
+    auto code = Compiler { lowered, configuration }.compile();
+    if (code.has_value())
+        state.compiled_function = CompiledFunction::create(*code, lowered.max_stack_height(), lowered.result_types().size());
+    state.compilation_failed = !state.compiled_function;
+    return state.compiled_function.ptr();
+#else
+    (void)lowered;
+    (void)configuration;
+    (void)threshold;
+    return nullptr;
+#endif
+}
+
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Optional.h>
+#include <AK/OwnPtr.h>
+#include <AK/Vector.h>
+#include <LibWasm/AbstractMachine/AbstractMachine.h>
+
+namespace Wasm {
+
+struct BytecodeInterpreter;
+class Configuration;
+
+}
+
+namespace Wasm::JIT {
+
+// Machine code for a lowered expression. It keeps its locals where the interpreter does, and runs everything
+// it doesn't compile itself (calls in particular) through the interpreter, so compiled and interpreted
+// functions can call each other freely.
+class CompiledFunction {
+public:
+    static OwnPtr<CompiledFunction> create(Vector<u8> const& code, size_t operand_count, size_t result_count);
+    ~CompiledFunction();
+
+    // Runs the expression of the configuration's current frame, and leaves its results on the stack like the interpreter does.
+    Optional<Trap> run(BytecodeInterpreter&, Configuration&) const;
+
+private:
+    CompiledFunction(void* code, size_t size, size_t operand_count, size_t result_count)
+        : m_code(code)
+        , m_size(size)
+        , m_operand_count(operand_count)
+        , m_result_count(result_count)
+    {
+    }
+
+    void* m_code { nullptr };
+    size_t m_size { 0 };
+    size_t m_operand_count { 0 };
+    size_t m_result_count { 0 };
+};
+
+// Whether there's a JIT for this platform at all.
+bool is_supported();
+
+// How many runs it takes for an expression to be compiled. This is Constants::jit_call_threshold, unless the
+// WASM_JIT_THRESHOLD environment variable says otherwise, and empty if that turns the JIT off or there isn't one for this platform.
+Optional<size_t> default_threshold();
+
+// Counts a run of the expression, and returns its machine code once it has been run `threshold` times.
+CompiledFunction const* compiled_function_for(LoweredExpression const&, Configuration&, size_t threshold);
+
+}
@@ -0,0 +1,71 @@
+;; The source of dispatch.wasm, which is assembled from it with `wat2wasm dispatch.wat`.
+;; A loop through a br_table and a call_indirect on every iteration: run() counts down from 1000000, picks
+;; what to do with its accumulator by the low two bits of the counter, and returns the accumulator, which
+;; ends up as 1552648789.
+(module
+  (type $binary_op (func (param i32 i32) (result i32)))
+
+  (func $add (type $binary_op) (param $a i32) (param $b i32) (result i32)
+    local.get $a
+    local.get $b
+    i32.add)
+
+  (func $xor (type $binary_op) (param $a i32) (param $b i32) (result i32)
+    local.get $a
+    local.get $b
+    i32.xor)
+
+  (func $triple (type $binary_op) (param $a i32) (param $b i32) (result i32)
+    local.get $a
+    i32.const 3
+    i32.mul)
+
+  (func $rotl (type $binary_op) (param $a i32) (param $b i32) (result i32)
+    local.get $a
+    local.get $b
+    i32.rotl)
+
+  (table 4 funcref)
+  (elem (i32.const 0) $add $xor $triple $rotl)
+
+  (func $run (export "run") (result i32)
+    (local $n i32)
+    (local $accumulator i32)
+    i32.const 1000000
+    local.set $n
+    i32.const 1
+    local.set $accumulator
+    loop $next
+      block $dispatched
+        block $case_1
+          block $case_0
+            local.get $n
+            i32.const 3
+            i32.and
+            br_table $case_0 $case_1 $dispatched
+          end
+          local.get $accumulator
+          i32.const 7
+          i32.add
+          local.set $accumulator
+          br $dispatched
+        end
+        local.get $accumulator
+        i32.const 1
+        i32.shr_u
+        local.set $accumulator
+      end
+      local.get $accumulator
+      local.get $n
+      local.get $n
+      i32.const 3
+      i32.and
+      call_indirect (type $binary_op)
+      local.set $accumulator
+      local.get $n
+      i32.const 1
+      i32.sub
+      local.tee $n
+      br_if $next
+    end
+    local.get $accumulator))
@@ -0,0 +1,24 @@
+;; The source of fib.wasm, which is assembled from it with `wat2wasm fib.wat`.
+;; The naive recursive fibonacci, so mostly calls: run() returns fib(27) = 196418.
+(module
+  (func $fib (param $n i32) (result i32)
+    local.get $n
+    i32.const 2
+    i32.lt_u
+    if (result i32)
+      local.get $n
+    else
+      local.get $n
+      i32.const 1
+      i32.sub
+      call $fib
+      local.get $n
+      i32.const 2
+      i32.sub
+      call $fib
+      i32.add
+    end)
+
+  (func $run (export "run") (result i32)
+    i32.const 27
+    call $fib))
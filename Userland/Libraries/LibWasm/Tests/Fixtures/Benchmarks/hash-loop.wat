@@ -0,0 +1,27 @@
+;; The source of hash-loop.wasm, which is assembled from it with `wat2wasm hash-loop.wat`.
+;; A tight loop of i64 arithmetic on locals: run() mixes a counter from 2000000 down to 1 into an FNV-1a hash.
+(module
+  (func $run (export "run") (result i64)
+    (local $i i32)
+    (local $hash i64)
+    i32.const 2000000
+    local.set $i
+    ;; The FNV-1a offset basis, 0xcbf29ce484222325.
+    i64.const -3750763034362895579
+    local.set $hash
+    loop $next
+      local.get $hash
+      local.get $i
+      i64.extend_i32_u
+      i64.xor
+      ;; The FNV-1a prime.
+      i64.const 0x100000001b3
+      i64.mul
+      local.set $hash
+      local.get $i
+      i32.const 1
+      i32.sub
+      local.tee $i
+      br_if $next
+    end
+    local.get $hash))
@@ -0,0 +1,110 @@
+;; The source of mandelbrot.wasm, which is assembled from it with `wat2wasm mandelbrot.wat`.
+;; Nested loops of f64 arithmetic: run() iterates every point of a 120x80 grid over [-2, 1] x [-1, 1] up to
+;; 200 times, and returns the total number of iterations, which is 540260.
+(module
+  (func $run (export "run") (result i32)
+    (local $x i32)
+    (local $y i32)
+    (local $cr f64)
+    (local $ci f64)
+    (local $zr f64)
+    (local $zi f64)
+    (local $next_zr f64)
+    (local $iterations i32)
+    (local $total i32)
+    i32.const 0
+    local.set $total
+    i32.const 0
+    local.set $y
+    loop $next_row
+      ;; ci = y * (2 / 80) - 1
+      local.get $y
+      f64.convert_i32_s
+      f64.const 0.025
+      f64.mul
+      f64.const 1
+      f64.sub
+      local.set $ci
+      i32.const 0
+      local.set $x
+      loop $next_column
+        ;; cr = x * (3 / 120) - 2
+        local.get $x
+        f64.convert_i32_s
+        f64.const 0.025
+        f64.mul
+        f64.const 2
+        f64.sub
+        local.set $cr
+        f64.const 0
+        local.set $zr
+        f64.const 0
+        local.set $zi
+        i32.const 0
+        local.set $iterations
+        block $escaped
+          loop $iterate
+            local.get $iterations
+            i32.const 200
+            i32.ge_u
+            br_if $escaped
+            ;; |z|^2 > 4
+            local.get $zr
+            local.get $zr
+            f64.mul
+            local.get $zi
+            local.get $zi
+            f64.mul
+            f64.add
+            f64.const 4
+            f64.gt
+            br_if $escaped
+            ;; z = z^2 + c
+            local.get $zr
+            local.get $zr
+            f64.mul
+            local.get $zi
+            local.get $zi
+            f64.mul
+            f64.sub
+            local.get $cr
+            f64.add
+            local.set $next_zr
+            f64.const 2
+            local.get $zr
+            f64.mul
+            local.get $zi
+            f64.mul
+            local.get $ci
+            f64.add
+            local.set $zi
+            local.get $next_zr
+            local.set $zr
+            local.get $iterations
+            i32.const 1
+            i32.add
+            local.set $iterations
+            br $iterate
+          end
+        end
+        local.get $total
+        local.get $iterations
+        i32.add
+        local.set $total
+        local.get $x
+        i32.const 1
+        i32.add
+        local.tee $x
+        i32.const 120
+        i32.lt_u
+        br_if $next_column
+      end
+      local.get $y
+      i32.const 1
+      i32.add
+      local.tee $y
+      i32.const 80
+      i32.lt_u
+      br_if $next_row
+    end
+    local.get $total))
@@ -0,0 +1,102 @@
+;; The source of sieve.wasm, which is assembled from it with `wat2wasm sieve.wat`.
+;; The sieve of Eratosthenes over a page of linear memory, one byte per number, so mostly byte loads and
+;; stores: run() sieves ten times and returns the number of primes below 65536, which is 6542.
+(module
+  (memory 1)
+
+  (func $run (export "run") (result i32)
+    (local $i i32)
+    (local $j i32)
+    (local $round i32)
+    (local $count i32)
+    i32.const 0
+    local.set $round
+    loop $next_round
+      ;; Start out with every number marked as a prime.
+      i32.const 0
+      local.set $i
+      loop $fill
+        local.get $i
+        i32.const 1
+        i32.store8
+        local.get $i
+        i32.const 1
+        i32.add
+        local.tee $i
+        i32.const 65536
+        i32.lt_u
+        br_if $fill
+      end
+
+      ;; Cross out the multiples of every prime up to the square root.
+      i32.const 2
+      local.set $i
+      block $sieved
+        loop $next_prime
+          local.get $i
+          local.get $i
+          i32.mul
+          i32.const 65536
+          i32.ge_u
+          br_if $sieved
+          local.get $i
+          i32.load8_u
+          if
+            local.get $i
+            local.get $i
+            i32.mul
+            local.set $j
+            block $crossed_out
+              loop $next_multiple
+                local.get $j
+                i32.const 65536
+                i32.ge_u
+                br_if $crossed_out
+                local.get $j
+                i32.const 0
+                i32.store8
+                local.get $j
+                local.get $i
+                i32.add
+                local.set $j
+                br $next_multiple
+              end
+            end
+          end
+          local.get $i
+          i32.const 1
+          i32.add
+          local.set $i
+          br $next_prime
+        end
+      end
+
+      ;; Count what is left, from 2 onwards.
+      i32.const 0
+      local.set $count
+      i32.const 2
+      local.set $i
+      loop $next_number
+        local.get $count
+        local.get $i
+        i32.load8_u
+        i32.add
+        local.set $count
+        local.get $i
+        i32.const 1
+        i32.add
+        local.tee $i
+        i32.const 65536
+        i32.lt_u
+        br_if $next_number
+      end
+
+      local.get $round
+      i32.const 1
+      i32.add
+      local.tee $round
+      i32.const 10
+      i32.lt_u
+      br_if $next_round
+    end
+    local.get $count))
@@ -0,0 +1,252 @@
+;; The source of control.wasm, which is assembled from it with `wat2wasm control.wat`.
+;; Branches that carry values, loops, selects, calls through the table and to functions with more arguments than
+;; compiled code has registers for, and globals of every type.
+(module
+  (type $binary (func (param i32 i32) (result i32)))
+
+  (global $count (mut i32) (i32.const 0))
+  (global $wide (mut i64) (i64.const 0))
+  (global $real (mut f64) (f64.const 0))
+
+  (func $add (type $binary) (param $a i32) (param $b i32) (result i32)
+    local.get $a
+    local.get $b
+    i32.add)
+
+  (func $sub (type $binary) (param $a i32) (param $b i32) (result i32)
+    local.get $a
+    local.get $b
+    i32.sub)
+
+  (func $mul (type $binary) (param $a i32) (param $b i32) (result i32)
+    local.get $a
+    local.get $b
+    i32.mul)
+
+  (func $negate (param $a i32) (result i32)
+    i32.const 0
+    local.get $a
+    i32.sub)
+
+  (table 4 funcref)
+  (elem (i32.const 0) $add $sub $mul $negate)
+
+  ;; Calls the function at `index` in the table, which traps for $negate and past the end of the table.
+  (func (export "apply") (param $index i32) (param $a i32) (param $b i32) (result i32)
+    local.get $a
+    local.get $b
+    local.get $index
+    call_indirect (type $binary))
+
+  ;; A br_table that carries a value to each of its targets.
+  (func (export "switch") (param $index i32) (result i32)
+    block $default (result i32)
+    block $two (result i32)
+    block $one (result i32)
+    block $zero (result i32)
+      i32.const 100
+      local.get $index
+      br_table $zero $one $two $default
+    end $zero
+      i32.const 1
+      i32.add
+      return
+    end $one
+      i32.const 2
+      i32.add
+      return
+    end $two
+      i32.const 3
+      i32.add
+      return
+    end $default)
+
+  ;; A br_if out of a nested block, which takes its value along and leaves the two below it behind.
+  (func (export "branch_out") (param $value i32) (result i32)
+    block $outer (result i32)
+      i32.const 1
+      i32.const 2
+      block $inner (result i32)
+        local.get $value
+        local.get $value
+        br_if $outer
+        drop
+        i32.const 7
+      end
+      i32.add
+      i32.add
+    end)
+
+  (func (export "if_else") (param $value i32) (result i32)
+    local.get $value
+    i32.const 10
+    i32.lt_s
+    if (result i32)
+      local.get $value
+      i32.const 2
+      i32.mul
+    else
+      local.get $value
+      i32.const 3
+      i32.sub
+    end)
+
+  ;; Adds up 1 to n, with seven values underneath the loop so that everything in it is in memory.
+  (func (export "sum") (param $n i32) (result i64)
+    (local $total i64)
+    i32.const 1
+    i32.const 2
+    i32.const 3
+    i32.const 4
+    i32.const 5
+    i32.const 6
+    i32.const 7
+    block $done
+      local.get $n
+      i32.eqz
+      br_if $done
+      loop $next
+        local.get $total
+        local.get $n
+        i64.extend_i32_u
+        i64.add
+        local.set $total
+        local.get $n
+        i32.const 1
+        i32.sub
+        local.tee $n
+        br_if $next
+      end
+    end
+    local.get $total
+    return)
+
+  (func (export "select_i32") (param $condition i32) (param $a i32) (param $b i32) (result i32)
+    local.get $a
+    local.get $b
+    local.get $condition
+    select)
+
+  (func (export "select_i64") (param $condition i32) (param $a i64) (param $b i64) (result i64)
+    local.get $a
+    local.get $b
+    local.get $condition
+    select)
+
+  (func (export "select_f64") (param $condition i32) (param $a f64) (param $b f64) (result f64)
+    local.get $a
+    local.get $b
+    local.get $condition
+    select)
+
+  (func $many (param $a i32) (param $b i64) (param $c f32) (param $d f64) (param $e i32) (param $f i64) (param $g f32) (param $h f64) (result f64)
+    local.get $a
+    f64.convert_i32_s
+    local.get $b
+    f64.convert_i64_s
+    f64.const 10
+    f64.mul
+    f64.add
+    local.get $c
+    f64.promote_f32
+    f64.const 100
+    f64.mul
+    f64.add
+    local.get $d
+    f64.const 1000
+    f64.mul
+    f64.add
+    local.get $e
+    f64.convert_i32_s
+    f64.const 10000
+    f64.mul
+    f64.add
+    local.get $f
+    f64.convert_i64_s
+    f64.const 100000
+    f64.mul
+    f64.add
+    local.get $g
+    f64.promote_f32
+    f64.const 1000000
+    f64.mul
+    f64.add
+    local.get $h
+    f64.const 10000000
+    f64.mul
+    f64.add)
+
+  ;; Calls $many with its arguments partly in registers and partly in memory, and with three values under them
+  ;; that have to be there again after the call.
+  (func (export "call_many") (param $x i32) (result f64)
+    local.get $x
+    f64.convert_i32_s
+    local.get $x
+    i32.const 2
+    i32.mul
+    f64.convert_i32_s
+    f64.const 0.5
+    local.get $x
+    local.get $x
+    i64.extend_i32_s
+    f32.const 2
+    f64.const 3
+    local.get $x
+    i32.const 4
+    i32.sub
+    i64.const 5
+    f32.const 6
+    local.get $x
+    f64.convert_i32_s
+    call $many
+    f64.add
+    f64.mul
+    f64.add)
+
+  (func $fib (export "fib") (param $n i32) (result i32)
+    local.get $n
+    i32.const 2
+    i32.lt_u
+    if
+      local.get $n
+      return
+    end
+    local.get $n
+    i32.const 1
+    i32.sub
+    call $fib
+    local.get $n
+    i32.const 2
+    i32.sub
+    call $fib
+    i32.add)
+
+  (func (export "count") (param $by i32) (result i32)
+    global.get $count
+    local.get $by
+    i32.add
+    global.set $count
+    global.get $count)
+
+  ;; Adds `by` to the upper half of a 64-bit global, and returns that upper half.
+  (func (export "count_wide") (param $by i32) (result i32)
+    global.get $wide
+    local.get $by
+    i64.extend_i32_u
+    i64.const 32
+    i64.shl
+    i64.add
+    global.set $wide
+    global.get $wide
+    i64.const 32
+    i64.shr_u
+    i32.wrap_i64)
+
+  (func (export "average") (param $value f64) (result f64)
+    global.get $real
+    local.get $value
+    f64.add
+    f64.const 0.5
+    f64.mul
+    global.set $real
+    global.get $real))
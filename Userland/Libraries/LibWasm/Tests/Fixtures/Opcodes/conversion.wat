@@ -0,0 +1,506 @@
+;; The source of conversion.wasm, which is assembled from it with `wat2wasm conversion.wat`.
+;; Every conversion between value types. The second operand is unused.
+;;
+;; The first argument of each function picks the instruction. 64-bit operands are passed in halves and results
+;; leave through split() and high(), so that no bits are lost to JavaScript numbers. Each function is there with
+;; 0, 4, 5 and 6 values under its operands: compiled code keeps the first six values of the stack in registers,
+;; so the deeper versions run each instruction with other registers and with operands in memory.
+(module
+  (global $high (mut i32) (i32.const 0))
+
+  ;; Keeps the high half of a result for high(), and returns the low half.
+  (func $split (param $value i64) (result i32)
+    local.get $value
+    i64.const 32
+    i64.shr_u
+    i32.wrap_i64
+    global.set $high
+    local.get $value
+    i32.wrap_i64)
+
+  (func (export "high") (result i32)
+    global.get $high)
+
+  (func $join (param $high i32) (param $low i32) (result i64)
+    local.get $high
+    i64.extend_i32_u
+    i64.const 32
+    i64.shl
+    local.get $low
+    i64.extend_i32_u
+    i64.or)
+
+  (func (export "convert_0") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    block $unknown
+    block $f64_reinterpret_i64
+    block $f32_reinterpret_i32
+    block $i64_reinterpret_f64
+    block $i32_reinterpret_f32
+    block $i64_trunc_sat_f64_u
+    block $i64_trunc_sat_f64_s
+    block $i64_trunc_sat_f32_u
+    block $i64_trunc_sat_f32_s
+    block $i32_trunc_sat_f64_u
+    block $i32_trunc_sat_f64_s
+    block $i32_trunc_sat_f32_u
+    block $i32_trunc_sat_f32_s
+    block $i64_trunc_f64_u
+    block $i64_trunc_f64_s
+    block $i64_trunc_f32_u
+    block $i64_trunc_f32_s
+    block $i32_trunc_f64_u
+    block $i32_trunc_f64_s
+    block $i32_trunc_f32_u
+    block $i32_trunc_f32_s
+    block $f64_promote_f32
+    block $f32_demote_f64
+    block $f64_convert_i64_u
+    block $f64_convert_i64_s
+    block $f64_convert_i32_u
+    block $f64_convert_i32_s
+    block $f32_convert_i64_u
+    block $f32_convert_i64_s
+    block $f32_convert_i32_u
+    block $f32_convert_i32_s
+    block $i64_extend_i32_u
+    block $i64_extend_i32_s
+    block $i32_wrap_i64
+      local.get $op
+      br_table $i32_wrap_i64 $i64_extend_i32_s $i64_extend_i32_u $f32_convert_i32_s $f32_convert_i32_u $f32_convert_i64_s $f32_convert_i64_u $f64_convert_i32_s $f64_convert_i32_u $f64_convert_i64_s $f64_convert_i64_u $f32_demote_f64 $f64_promote_f32 $i32_trunc_f32_s $i32_trunc_f32_u $i32_trunc_f64_s $i32_trunc_f64_u $i64_trunc_f32_s $i64_trunc_f32_u $i64_trunc_f64_s $i64_trunc_f64_u $i32_trunc_sat_f32_s $i32_trunc_sat_f32_u $i32_trunc_sat_f64_s $i32_trunc_sat_f64_u $i64_trunc_sat_f32_s $i64_trunc_sat_f32_u $i64_trunc_sat_f64_s $i64_trunc_sat_f64_u $i32_reinterpret_f32 $i64_reinterpret_f64 $f32_reinterpret_i32 $f64_reinterpret_i64 $unknown
+    end $i32_wrap_i64
+      local.get $a i32.wrap_i64 i64.extend_i32_u call $split return
+    end $i64_extend_i32_s
+      local.get $a_low i64.extend_i32_s call $split return
+    end $i64_extend_i32_u
+      local.get $a_low i64.extend_i32_u call $split return
+    end $f32_convert_i32_s
+      local.get $a_low f32.convert_i32_s i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_convert_i32_u
+      local.get $a_low f32.convert_i32_u i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_convert_i64_s
+      local.get $a f32.convert_i64_s i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_convert_i64_u
+      local.get $a f32.convert_i64_u i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f64_convert_i32_s
+      local.get $a_low f64.convert_i32_s i64.reinterpret_f64 call $split return
+    end $f64_convert_i32_u
+      local.get $a_low f64.convert_i32_u i64.reinterpret_f64 call $split return
+    end $f64_convert_i64_s
+      local.get $a f64.convert_i64_s i64.reinterpret_f64 call $split return
+    end $f64_convert_i64_u
+      local.get $a f64.convert_i64_u i64.reinterpret_f64 call $split return
+    end $f32_demote_f64
+      local.get $a f64.reinterpret_i64 f32.demote_f64 i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f64_promote_f32
+      local.get $a_low f32.reinterpret_i32 f64.promote_f32 i64.reinterpret_f64 call $split return
+    end $i32_trunc_f32_s
+      local.get $a_low f32.reinterpret_i32 i32.trunc_f32_s i64.extend_i32_u call $split return
+    end $i32_trunc_f32_u
+      local.get $a_low f32.reinterpret_i32 i32.trunc_f32_u i64.extend_i32_u call $split return
+    end $i32_trunc_f64_s
+      local.get $a f64.reinterpret_i64 i32.trunc_f64_s i64.extend_i32_u call $split return
+    end $i32_trunc_f64_u
+      local.get $a f64.reinterpret_i64 i32.trunc_f64_u i64.extend_i32_u call $split return
+    end $i64_trunc_f32_s
+      local.get $a_low f32.reinterpret_i32 i64.trunc_f32_s call $split return
+    end $i64_trunc_f32_u
+      local.get $a_low f32.reinterpret_i32 i64.trunc_f32_u call $split return
+    end $i64_trunc_f64_s
+      local.get $a f64.reinterpret_i64 i64.trunc_f64_s call $split return
+    end $i64_trunc_f64_u
+      local.get $a f64.reinterpret_i64 i64.trunc_f64_u call $split return
+    end $i32_trunc_sat_f32_s
+      local.get $a_low f32.reinterpret_i32 i32.trunc_sat_f32_s i64.extend_i32_u call $split return
+    end $i32_trunc_sat_f32_u
+      local.get $a_low f32.reinterpret_i32 i32.trunc_sat_f32_u i64.extend_i32_u call $split return
+    end $i32_trunc_sat_f64_s
+      local.get $a f64.reinterpret_i64 i32.trunc_sat_f64_s i64.extend_i32_u call $split return
+    end $i32_trunc_sat_f64_u
+      local.get $a f64.reinterpret_i64 i32.trunc_sat_f64_u i64.extend_i32_u call $split return
+    end $i64_trunc_sat_f32_s
+      local.get $a_low f32.reinterpret_i32 i64.trunc_sat_f32_s call $split return
+    end $i64_trunc_sat_f32_u
+      local.get $a_low f32.reinterpret_i32 i64.trunc_sat_f32_u call $split return
+    end $i64_trunc_sat_f64_s
+      local.get $a f64.reinterpret_i64 i64.trunc_sat_f64_s call $split return
+    end $i64_trunc_sat_f64_u
+      local.get $a f64.reinterpret_i64 i64.trunc_sat_f64_u call $split return
+    end $i32_reinterpret_f32
+      local.get $a_low f32.reinterpret_i32 i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $i64_reinterpret_f64
+      local.get $a f64.reinterpret_i64 i64.reinterpret_f64 call $split return
+    end $f32_reinterpret_i32
+      local.get $a_low f32.reinterpret_i32 i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f64_reinterpret_i64
+      local.get $a f64.reinterpret_i64 i64.reinterpret_f64 call $split return
+    end $unknown
+    unreachable)
+
+  (func (export "convert_4") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    block $unknown
+    block $f64_reinterpret_i64
+    block $f32_reinterpret_i32
+    block $i64_reinterpret_f64
+    block $i32_reinterpret_f32
+    block $i64_trunc_sat_f64_u
+    block $i64_trunc_sat_f64_s
+    block $i64_trunc_sat_f32_u
+    block $i64_trunc_sat_f32_s
+    block $i32_trunc_sat_f64_u
+    block $i32_trunc_sat_f64_s
+    block $i32_trunc_sat_f32_u
+    block $i32_trunc_sat_f32_s
+    block $i64_trunc_f64_u
+    block $i64_trunc_f64_s
+    block $i64_trunc_f32_u
+    block $i64_trunc_f32_s
+    block $i32_trunc_f64_u
+    block $i32_trunc_f64_s
+    block $i32_trunc_f32_u
+    block $i32_trunc_f32_s
+    block $f64_promote_f32
+    block $f32_demote_f64
+    block $f64_convert_i64_u
+    block $f64_convert_i64_s
+    block $f64_convert_i32_u
+    block $f64_convert_i32_s
+    block $f32_convert_i64_u
+    block $f32_convert_i64_s
+    block $f32_convert_i32_u
+    block $f32_convert_i32_s
+    block $i64_extend_i32_u
+    block $i64_extend_i32_s
+    block $i32_wrap_i64
+      local.get $op
+      br_table $i32_wrap_i64 $i64_extend_i32_s $i64_extend_i32_u $f32_convert_i32_s $f32_convert_i32_u $f32_convert_i64_s $f32_convert_i64_u $f64_convert_i32_s $f64_convert_i32_u $f64_convert_i64_s $f64_convert_i64_u $f32_demote_f64 $f64_promote_f32 $i32_trunc_f32_s $i32_trunc_f32_u $i32_trunc_f64_s $i32_trunc_f64_u $i64_trunc_f32_s $i64_trunc_f32_u $i64_trunc_f64_s $i64_trunc_f64_u $i32_trunc_sat_f32_s $i32_trunc_sat_f32_u $i32_trunc_sat_f64_s $i32_trunc_sat_f64_u $i64_trunc_sat_f32_s $i64_trunc_sat_f32_u $i64_trunc_sat_f64_s $i64_trunc_sat_f64_u $i32_reinterpret_f32 $i64_reinterpret_f64 $f32_reinterpret_i32 $f64_reinterpret_i64 $unknown
+    end $i32_wrap_i64
+      local.get $a i32.wrap_i64 i64.extend_i32_u call $split return
+    end $i64_extend_i32_s
+      local.get $a_low i64.extend_i32_s call $split return
+    end $i64_extend_i32_u
+      local.get $a_low i64.extend_i32_u call $split return
+    end $f32_convert_i32_s
+      local.get $a_low f32.convert_i32_s i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_convert_i32_u
+      local.get $a_low f32.convert_i32_u i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_convert_i64_s
+      local.get $a f32.convert_i64_s i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_convert_i64_u
+      local.get $a f32.convert_i64_u i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f64_convert_i32_s
+      local.get $a_low f64.convert_i32_s i64.reinterpret_f64 call $split return
+    end $f64_convert_i32_u
+      local.get $a_low f64.convert_i32_u i64.reinterpret_f64 call $split return
+    end $f64_convert_i64_s
+      local.get $a f64.convert_i64_s i64.reinterpret_f64 call $split return
+    end $f64_convert_i64_u
+      local.get $a f64.convert_i64_u i64.reinterpret_f64 call $split return
+    end $f32_demote_f64
+      local.get $a f64.reinterpret_i64 f32.demote_f64 i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f64_promote_f32
+      local.get $a_low f32.reinterpret_i32 f64.promote_f32 i64.reinterpret_f64 call $split return
+    end $i32_trunc_f32_s
+      local.get $a_low f32.reinterpret_i32 i32.trunc_f32_s i64.extend_i32_u call $split return
+    end $i32_trunc_f32_u
+      local.get $a_low f32.reinterpret_i32 i32.trunc_f32_u i64.extend_i32_u call $split return
+    end $i32_trunc_f64_s
+      local.get $a f64.reinterpret_i64 i32.trunc_f64_s i64.extend_i32_u call $split return
+    end $i32_trunc_f64_u
+      local.get $a f64.reinterpret_i64 i32.trunc_f64_u i64.extend_i32_u call $split return
+    end $i64_trunc_f32_s
+      local.get $a_low f32.reinterpret_i32 i64.trunc_f32_s call $split return
+    end $i64_trunc_f32_u
+      local.get $a_low f32.reinterpret_i32 i64.trunc_f32_u call $split return
+    end $i64_trunc_f64_s
+      local.get $a f64.reinterpret_i64 i64.trunc_f64_s call $split return
+    end $i64_trunc_f64_u
+      local.get $a f64.reinterpret_i64 i64.trunc_f64_u call $split return
+    end $i32_trunc_sat_f32_s
+      local.get $a_low f32.reinterpret_i32 i32.trunc_sat_f32_s i64.extend_i32_u call $split return
+    end $i32_trunc_sat_f32_u
+      local.get $a_low f32.reinterpret_i32 i32.trunc_sat_f32_u i64.extend_i32_u call $split return
+    end $i32_trunc_sat_f64_s
+      local.get $a f64.reinterpret_i64 i32.trunc_sat_f64_s i64.extend_i32_u call $split return
+    end $i32_trunc_sat_f64_u
+      local.get $a f64.reinterpret_i64 i32.trunc_sat_f64_u i64.extend_i32_u call $split return
+    end $i64_trunc_sat_f32_s
+      local.get $a_low f32.reinterpret_i32 i64.trunc_sat_f32_s call $split return
+    end $i64_trunc_sat_f32_u
+      local.get $a_low f32.reinterpret_i32 i64.trunc_sat_f32_u call $split return
+    end $i64_trunc_sat_f64_s
+      local.get $a f64.reinterpret_i64 i64.trunc_sat_f64_s call $split return
+    end $i64_trunc_sat_f64_u
+      local.get $a f64.reinterpret_i64 i64.trunc_sat_f64_u call $split return
+    end $i32_reinterpret_f32
+      local.get $a_low f32.reinterpret_i32 i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $i64_reinterpret_f64
+      local.get $a f64.reinterpret_i64 i64.reinterpret_f64 call $split return
+    end $f32_reinterpret_i32
+      local.get $a_low f32.reinterpret_i32 i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f64_reinterpret_i64
+      local.get $a f64.reinterpret_i64 i64.reinterpret_f64 call $split return
+    end $unknown
+    unreachable)
+
+  (func (export "convert_5") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    block $unknown
+    block $f64_reinterpret_i64
+    block $f32_reinterpret_i32
+    block $i64_reinterpret_f64
+    block $i32_reinterpret_f32
+    block $i64_trunc_sat_f64_u
+    block $i64_trunc_sat_f64_s
+    block $i64_trunc_sat_f32_u
+    block $i64_trunc_sat_f32_s
+    block $i32_trunc_sat_f64_u
+    block $i32_trunc_sat_f64_s
+    block $i32_trunc_sat_f32_u
+    block $i32_trunc_sat_f32_s
+    block $i64_trunc_f64_u
+    block $i64_trunc_f64_s
+    block $i64_trunc_f32_u
+    block $i64_trunc_f32_s
+    block $i32_trunc_f64_u
+    block $i32_trunc_f64_s
+    block $i32_trunc_f32_u
+    block $i32_trunc_f32_s
+    block $f64_promote_f32
+    block $f32_demote_f64
+    block $f64_convert_i64_u
+    block $f64_convert_i64_s
+    block $f64_convert_i32_u
+    block $f64_convert_i32_s
+    block $f32_convert_i64_u
+    block $f32_convert_i64_s
+    block $f32_convert_i32_u
+    block $f32_convert_i32_s
+    block $i64_extend_i32_u
+    block $i64_extend_i32_s
+    block $i32_wrap_i64
+      local.get $op
+      br_table $i32_wrap_i64 $i64_extend_i32_s $i64_extend_i32_u $f32_convert_i32_s $f32_convert_i32_u $f32_convert_i64_s $f32_convert_i64_u $f64_convert_i32_s $f64_convert_i32_u $f64_convert_i64_s $f64_convert_i64_u $f32_demote_f64 $f64_promote_f32 $i32_trunc_f32_s $i32_trunc_f32_u $i32_trunc_f64_s $i32_trunc_f64_u $i64_trunc_f32_s $i64_trunc_f32_u $i64_trunc_f64_s $i64_trunc_f64_u $i32_trunc_sat_f32_s $i32_trunc_sat_f32_u $i32_trunc_sat_f64_s $i32_trunc_sat_f64_u $i64_trunc_sat_f32_s $i64_trunc_sat_f32_u $i64_trunc_sat_f64_s $i64_trunc_sat_f64_u $i32_reinterpret_f32 $i64_reinterpret_f64 $f32_reinterpret_i32 $f64_reinterpret_i64 $unknown
+    end $i32_wrap_i64
+      local.get $a i32.wrap_i64 i64.extend_i32_u call $split return
+    end $i64_extend_i32_s
+      local.get $a_low i64.extend_i32_s call $split return
+    end $i64_extend_i32_u
+      local.get $a_low i64.extend_i32_u call $split return
+    end $f32_convert_i32_s
+      local.get $a_low f32.convert_i32_s i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_convert_i32_u
+      local.get $a_low f32.convert_i32_u i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_convert_i64_s
+      local.get $a f32.convert_i64_s i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_convert_i64_u
+      local.get $a f32.convert_i64_u i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f64_convert_i32_s
+      local.get $a_low f64.convert_i32_s i64.reinterpret_f64 call $split return
+    end $f64_convert_i32_u
+      local.get $a_low f64.convert_i32_u i64.reinterpret_f64 call $split return
+    end $f64_convert_i64_s
+      local.get $a f64.convert_i64_s i64.reinterpret_f64 call $split return
+    end $f64_convert_i64_u
+      local.get $a f64.convert_i64_u i64.reinterpret_f64 call $split return
+    end $f32_demote_f64
+      local.get $a f64.reinterpret_i64 f32.demote_f64 i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f64_promote_f32
+      local.get $a_low f32.reinterpret_i32 f64.promote_f32 i64.reinterpret_f64 call $split return
+    end $i32_trunc_f32_s
+      local.get $a_low f32.reinterpret_i32 i32.trunc_f32_s i64.extend_i32_u call $split return
+    end $i32_trunc_f32_u
+      local.get $a_low f32.reinterpret_i32 i32.trunc_f32_u i64.extend_i32_u call $split return
+    end $i32_trunc_f64_s
+      local.get $a f64.reinterpret_i64 i32.trunc_f64_s i64.extend_i32_u call $split return
+    end $i32_trunc_f64_u
+      local.get $a f64.reinterpret_i64 i32.trunc_f64_u i64.extend_i32_u call $split return
+    end $i64_trunc_f32_s
+      local.get $a_low f32.reinterpret_i32 i64.trunc_f32_s call $split return
+    end $i64_trunc_f32_u
+      local.get $a_low f32.reinterpret_i32 i64.trunc_f32_u call $split return
+    end $i64_trunc_f64_s
+      local.get $a f64.reinterpret_i64 i64.trunc_f64_s call $split return
+    end $i64_trunc_f64_u
+      local.get $a f64.reinterpret_i64 i64.trunc_f64_u call $split return
+    end $i32_trunc_sat_f32_s
+      local.get $a_low f32.reinterpret_i32 i32.trunc_sat_f32_s i64.extend_i32_u call $split return
+    end $i32_trunc_sat_f32_u
+      local.get $a_low f32.reinterpret_i32 i32.trunc_sat_f32_u i64.extend_i32_u call $split return
+    end $i32_trunc_sat_f64_s
+      local.get $a f64.reinterpret_i64 i32.trunc_sat_f64_s i64.extend_i32_u call $split return
+    end $i32_trunc_sat_f64_u
+      local.get $a f64.reinterpret_i64 i32.trunc_sat_f64_u i64.extend_i32_u call $split return
+    end $i64_trunc_sat_f32_s
+      local.get $a_low f32.reinterpret_i32 i64.trunc_sat_f32_s call $split return
+    end $i64_trunc_sat_f32_u
+      local.get $a_low f32.reinterpret_i32 i64.trunc_sat_f32_u call $split return
+    end $i64_trunc_sat_f64_s
+      local.get $a f64.reinterpret_i64 i64.trunc_sat_f64_s call $split return
+    end $i64_trunc_sat_f64_u
+      local.get $a f64.reinterpret_i64 i64.trunc_sat_f64_u call $split return
+    end $i32_reinterpret_f32
+      local.get $a_low f32.reinterpret_i32 i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $i64_reinterpret_f64
+      local.get $a f64.reinterpret_i64 i64.reinterpret_f64 call $split return
+    end $f32_reinterpret_i32
+      local.get $a_low f32.reinterpret_i32 i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f64_reinterpret_i64
+      local.get $a f64.reinterpret_i64 i64.reinterpret_f64 call $split return
+    end $unknown
+    unreachable)
+
+  (func (export "convert_6") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    block $unknown
+    block $f64_reinterpret_i64
+    block $f32_reinterpret_i32
+    block $i64_reinterpret_f64
+    block $i32_reinterpret_f32
+    block $i64_trunc_sat_f64_u
+    block $i64_trunc_sat_f64_s
+    block $i64_trunc_sat_f32_u
+    block $i64_trunc_sat_f32_s
+    block $i32_trunc_sat_f64_u
+    block $i32_trunc_sat_f64_s
+    block $i32_trunc_sat_f32_u
+    block $i32_trunc_sat_f32_s
+    block $i64_trunc_f64_u
+    block $i64_trunc_f64_s
+    block $i64_trunc_f32_u
+    block $i64_trunc_f32_s
+    block $i32_trunc_f64_u
+    block $i32_trunc_f64_s
+    block $i32_trunc_f32_u
+    block $i32_trunc_f32_s
+    block $f64_promote_f32
+    block $f32_demote_f64
+    block $f64_convert_i64_u
+    block $f64_convert_i64_s
+    block $f64_convert_i32_u
+    block $f64_convert_i32_s
+    block $f32_convert_i64_u
+    block $f32_convert_i64_s
+    block $f32_convert_i32_u
+    block $f32_convert_i32_s
+    block $i64_extend_i32_u
+    block $i64_extend_i32_s
+    block $i32_wrap_i64
+      local.get $op
+      br_table $i32_wrap_i64 $i64_extend_i32_s $i64_extend_i32_u $f32_convert_i32_s $f32_convert_i32_u $f32_convert_i64_s $f32_convert_i64_u $f64_convert_i32_s $f64_convert_i32_u $f64_convert_i64_s $f64_convert_i64_u $f32_demote_f64 $f64_promote_f32 $i32_trunc_f32_s $i32_trunc_f32_u $i32_trunc_f64_s $i32_trunc_f64_u $i64_trunc_f32_s $i64_trunc_f32_u $i64_trunc_f64_s $i64_trunc_f64_u $i32_trunc_sat_f32_s $i32_trunc_sat_f32_u $i32_trunc_sat_f64_s $i32_trunc_sat_f64_u $i64_trunc_sat_f32_s $i64_trunc_sat_f32_u $i64_trunc_sat_f64_s $i64_trunc_sat_f64_u $i32_reinterpret_f32 $i64_reinterpret_f64 $f32_reinterpret_i32 $f64_reinterpret_i64 $unknown
+    end $i32_wrap_i64
+      local.get $a i32.wrap_i64 i64.extend_i32_u call $split return
+    end $i64_extend_i32_s
+      local.get $a_low i64.extend_i32_s call $split return
+    end $i64_extend_i32_u
+      local.get $a_low i64.extend_i32_u call $split return
+    end $f32_convert_i32_s
+      local.get $a_low f32.convert_i32_s i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_convert_i32_u
+      local.get $a_low f32.convert_i32_u i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_convert_i64_s
+      local.get $a f32.convert_i64_s i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_convert_i64_u
+      local.get $a f32.convert_i64_u i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f64_convert_i32_s
+      local.get $a_low f64.convert_i32_s i64.reinterpret_f64 call $split return
+    end $f64_convert_i32_u
+      local.get $a_low f64.convert_i32_u i64.reinterpret_f64 call $split return
+    end $f64_convert_i64_s
+      local.get $a f64.convert_i64_s i64.reinterpret_f64 call $split return
+    end $f64_convert_i64_u
+      local.get $a f64.convert_i64_u i64.reinterpret_f64 call $split return
+    end $f32_demote_f64
+      local.get $a f64.reinterpret_i64 f32.demote_f64 i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f64_promote_f32
+      local.get $a_low f32.reinterpret_i32 f64.promote_f32 i64.reinterpret_f64 call $split return
+    end $i32_trunc_f32_s
+      local.get $a_low f32.reinterpret_i32 i32.trunc_f32_s i64.extend_i32_u call $split return
+    end $i32_trunc_f32_u
+      local.get $a_low f32.reinterpret_i32 i32.trunc_f32_u i64.extend_i32_u call $split return
+    end $i32_trunc_f64_s
+      local.get $a f64.reinterpret_i64 i32.trunc_f64_s i64.extend_i32_u call $split return
+    end $i32_trunc_f64_u
+      local.get $a f64.reinterpret_i64 i32.trunc_f64_u i64.extend_i32_u call $split return
+    end $i64_trunc_f32_s
+      local.get $a_low f32.reinterpret_i32 i64.trunc_f32_s call $split return
+    end $i64_trunc_f32_u
+      local.get $a_low f32.reinterpret_i32 i64.trunc_f32_u call $split return
+    end $i64_trunc_f64_s
+      local.get $a f64.reinterpret_i64 i64.trunc_f64_s call $split return
+    end $i64_trunc_f64_u
+      local.get $a f64.reinterpret_i64 i64.trunc_f64_u call $split return
+    end $i32_trunc_sat_f32_s
+      local.get $a_low f32.reinterpret_i32 i32.trunc_sat_f32_s i64.extend_i32_u call $split return
+    end $i32_trunc_sat_f32_u
+      local.get $a_low f32.reinterpret_i32 i32.trunc_sat_f32_u i64.extend_i32_u call $split return
+    end $i32_trunc_sat_f64_s
+      local.get $a f64.reinterpret_i64 i32.trunc_sat_f64_s i64.extend_i32_u call $split return
+    end $i32_trunc_sat_f64_u
+      local.get $a f64.reinterpret_i64 i32.trunc_sat_f64_u i64.extend_i32_u call $split return
+    end $i64_trunc_sat_f32_s
+      local.get $a_low f32.reinterpret_i32 i64.trunc_sat_f32_s call $split return
+    end $i64_trunc_sat_f32_u
+      local.get $a_low f32.reinterpret_i32 i64.trunc_sat_f32_u call $split return
+    end $i64_trunc_sat_f64_s
+      local.get $a f64.reinterpret_i64 i64.trunc_sat_f64_s call $split return
+    end $i64_trunc_sat_f64_u
+      local.get $a f64.reinterpret_i64 i64.trunc_sat_f64_u call $split return
+    end $i32_reinterpret_f32
+      local.get $a_low f32.reinterpret_i32 i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $i64_reinterpret_f64
+      local.get $a f64.reinterpret_i64 i64.reinterpret_f64 call $split return
+    end $f32_reinterpret_i32
+      local.get $a_low f32.reinterpret_i32 i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f64_reinterpret_i64
+      local.get $a f64.reinterpret_i64 i64.reinterpret_f64 call $split return
+    end $unknown
+    unreachable))
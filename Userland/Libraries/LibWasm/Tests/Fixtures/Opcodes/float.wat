@@ -0,0 +1,986 @@
+;; The source of float.wasm, which is assembled from it with `wat2wasm float.wat`.
+;; Every floating point instruction, with operands and results passed as their bits so that the
+;; bits of NaNs can be compared too.
+;;
+;; The first argument of each function picks the instruction. 64-bit operands are passed in halves and results
+;; leave through split() and high(), so that no bits are lost to JavaScript numbers. Each function is there with
+;; 0, 4, 5 and 6 values under its operands: compiled code keeps the first six values of the stack in registers,
+;; so the deeper versions run each instruction with other registers and with operands in memory.
+(module
+  (global $high (mut i32) (i32.const 0))
+
+  ;; Keeps the high half of a result for high(), and returns the low half.
+  (func $split (param $value i64) (result i32)
+    local.get $value
+    i64.const 32
+    i64.shr_u
+    i32.wrap_i64
+    global.set $high
+    local.get $value
+    i32.wrap_i64)
+
+  (func (export "high") (result i32)
+    global.get $high)
+
+  (func $join (param $high i32) (param $low i32) (result i64)
+    local.get $high
+    i64.extend_i32_u
+    i64.const 32
+    i64.shl
+    local.get $low
+    i64.extend_i32_u
+    i64.or)
+
+  (func (export "f32_binary_0") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    block $unknown
+    block $f32_copysign
+    block $f32_max
+    block $f32_min
+    block $f32_div
+    block $f32_mul
+    block $f32_sub
+    block $f32_add
+      local.get $op
+      br_table $f32_add $f32_sub $f32_mul $f32_div $f32_min $f32_max $f32_copysign $unknown
+    end $f32_add
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.add i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_sub
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.sub i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_mul
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.mul i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_div
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.div i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_min
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.min i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_max
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.max i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_copysign
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.copysign i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $unknown
+    unreachable)
+
+  (func (export "f32_binary_4") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    block $unknown
+    block $f32_copysign
+    block $f32_max
+    block $f32_min
+    block $f32_div
+    block $f32_mul
+    block $f32_sub
+    block $f32_add
+      local.get $op
+      br_table $f32_add $f32_sub $f32_mul $f32_div $f32_min $f32_max $f32_copysign $unknown
+    end $f32_add
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.add i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_sub
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.sub i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_mul
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.mul i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_div
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.div i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_min
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.min i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_max
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.max i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_copysign
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.copysign i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $unknown
+    unreachable)
+
+  (func (export "f32_binary_5") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    block $unknown
+    block $f32_copysign
+    block $f32_max
+    block $f32_min
+    block $f32_div
+    block $f32_mul
+    block $f32_sub
+    block $f32_add
+      local.get $op
+      br_table $f32_add $f32_sub $f32_mul $f32_div $f32_min $f32_max $f32_copysign $unknown
+    end $f32_add
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.add i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_sub
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.sub i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_mul
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.mul i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_div
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.div i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_min
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.min i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_max
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.max i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_copysign
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.copysign i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $unknown
+    unreachable)
+
+  (func (export "f32_binary_6") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    block $unknown
+    block $f32_copysign
+    block $f32_max
+    block $f32_min
+    block $f32_div
+    block $f32_mul
+    block $f32_sub
+    block $f32_add
+      local.get $op
+      br_table $f32_add $f32_sub $f32_mul $f32_div $f32_min $f32_max $f32_copysign $unknown
+    end $f32_add
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.add i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_sub
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.sub i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_mul
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.mul i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_div
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.div i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_min
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.min i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_max
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.max i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_copysign
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.copysign i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $unknown
+    unreachable)
+
+  (func (export "f32_compare_0") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    block $unknown
+    block $f32_ge
+    block $f32_le
+    block $f32_gt
+    block $f32_lt
+    block $f32_ne
+    block $f32_eq
+      local.get $op
+      br_table $f32_eq $f32_ne $f32_lt $f32_gt $f32_le $f32_ge $unknown
+    end $f32_eq
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.eq i64.extend_i32_u call $split return
+    end $f32_ne
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.ne i64.extend_i32_u call $split return
+    end $f32_lt
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.lt i64.extend_i32_u call $split return
+    end $f32_gt
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.gt i64.extend_i32_u call $split return
+    end $f32_le
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.le i64.extend_i32_u call $split return
+    end $f32_ge
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.ge i64.extend_i32_u call $split return
+    end $unknown
+    unreachable)
+
+  (func (export "f32_compare_4") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    block $unknown
+    block $f32_ge
+    block $f32_le
+    block $f32_gt
+    block $f32_lt
+    block $f32_ne
+    block $f32_eq
+      local.get $op
+      br_table $f32_eq $f32_ne $f32_lt $f32_gt $f32_le $f32_ge $unknown
+    end $f32_eq
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.eq i64.extend_i32_u call $split return
+    end $f32_ne
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.ne i64.extend_i32_u call $split return
+    end $f32_lt
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.lt i64.extend_i32_u call $split return
+    end $f32_gt
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.gt i64.extend_i32_u call $split return
+    end $f32_le
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.le i64.extend_i32_u call $split return
+    end $f32_ge
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.ge i64.extend_i32_u call $split return
+    end $unknown
+    unreachable)
+
+  (func (export "f32_compare_5") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    block $unknown
+    block $f32_ge
+    block $f32_le
+    block $f32_gt
+    block $f32_lt
+    block $f32_ne
+    block $f32_eq
+      local.get $op
+      br_table $f32_eq $f32_ne $f32_lt $f32_gt $f32_le $f32_ge $unknown
+    end $f32_eq
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.eq i64.extend_i32_u call $split return
+    end $f32_ne
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.ne i64.extend_i32_u call $split return
+    end $f32_lt
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.lt i64.extend_i32_u call $split return
+    end $f32_gt
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.gt i64.extend_i32_u call $split return
+    end $f32_le
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.le i64.extend_i32_u call $split return
+    end $f32_ge
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.ge i64.extend_i32_u call $split return
+    end $unknown
+    unreachable)
+
+  (func (export "f32_compare_6") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    block $unknown
+    block $f32_ge
+    block $f32_le
+    block $f32_gt
+    block $f32_lt
+    block $f32_ne
+    block $f32_eq
+      local.get $op
+      br_table $f32_eq $f32_ne $f32_lt $f32_gt $f32_le $f32_ge $unknown
+    end $f32_eq
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.eq i64.extend_i32_u call $split return
+    end $f32_ne
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.ne i64.extend_i32_u call $split return
+    end $f32_lt
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.lt i64.extend_i32_u call $split return
+    end $f32_gt
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.gt i64.extend_i32_u call $split return
+    end $f32_le
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.le i64.extend_i32_u call $split return
+    end $f32_ge
+      local.get $a_low f32.reinterpret_i32 local.get $b_low f32.reinterpret_i32 f32.ge i64.extend_i32_u call $split return
+    end $unknown
+    unreachable)
+
+  (func (export "f32_unary_0") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    block $unknown
+    block $f32_nearest
+    block $f32_trunc
+    block $f32_floor
+    block $f32_ceil
+    block $f32_sqrt
+    block $f32_neg
+    block $f32_abs
+      local.get $op
+      br_table $f32_abs $f32_neg $f32_sqrt $f32_ceil $f32_floor $f32_trunc $f32_nearest $unknown
+    end $f32_abs
+      local.get $a_low f32.reinterpret_i32 f32.abs i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_neg
+      local.get $a_low f32.reinterpret_i32 f32.neg i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_sqrt
+      local.get $a_low f32.reinterpret_i32 f32.sqrt i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_ceil
+      local.get $a_low f32.reinterpret_i32 f32.ceil i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_floor
+      local.get $a_low f32.reinterpret_i32 f32.floor i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_trunc
+      local.get $a_low f32.reinterpret_i32 f32.trunc i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_nearest
+      local.get $a_low f32.reinterpret_i32 f32.nearest i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $unknown
+    unreachable)
+
+  (func (export "f32_unary_4") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    block $unknown
+    block $f32_nearest
+    block $f32_trunc
+    block $f32_floor
+    block $f32_ceil
+    block $f32_sqrt
+    block $f32_neg
+    block $f32_abs
+      local.get $op
+      br_table $f32_abs $f32_neg $f32_sqrt $f32_ceil $f32_floor $f32_trunc $f32_nearest $unknown
+    end $f32_abs
+      local.get $a_low f32.reinterpret_i32 f32.abs i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_neg
+      local.get $a_low f32.reinterpret_i32 f32.neg i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_sqrt
+      local.get $a_low f32.reinterpret_i32 f32.sqrt i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_ceil
+      local.get $a_low f32.reinterpret_i32 f32.ceil i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_floor
+      local.get $a_low f32.reinterpret_i32 f32.floor i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_trunc
+      local.get $a_low f32.reinterpret_i32 f32.trunc i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_nearest
+      local.get $a_low f32.reinterpret_i32 f32.nearest i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $unknown
+    unreachable)
+
+  (func (export "f32_unary_5") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    block $unknown
+    block $f32_nearest
+    block $f32_trunc
+    block $f32_floor
+    block $f32_ceil
+    block $f32_sqrt
+    block $f32_neg
+    block $f32_abs
+      local.get $op
+      br_table $f32_abs $f32_neg $f32_sqrt $f32_ceil $f32_floor $f32_trunc $f32_nearest $unknown
+    end $f32_abs
+      local.get $a_low f32.reinterpret_i32 f32.abs i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_neg
+      local.get $a_low f32.reinterpret_i32 f32.neg i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_sqrt
+      local.get $a_low f32.reinterpret_i32 f32.sqrt i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_ceil
+      local.get $a_low f32.reinterpret_i32 f32.ceil i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_floor
+      local.get $a_low f32.reinterpret_i32 f32.floor i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_trunc
+      local.get $a_low f32.reinterpret_i32 f32.trunc i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_nearest
+      local.get $a_low f32.reinterpret_i32 f32.nearest i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $unknown
+    unreachable)
+
+  (func (export "f32_unary_6") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    block $unknown
+    block $f32_nearest
+    block $f32_trunc
+    block $f32_floor
+    block $f32_ceil
+    block $f32_sqrt
+    block $f32_neg
+    block $f32_abs
+      local.get $op
+      br_table $f32_abs $f32_neg $f32_sqrt $f32_ceil $f32_floor $f32_trunc $f32_nearest $unknown
+    end $f32_abs
+      local.get $a_low f32.reinterpret_i32 f32.abs i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_neg
+      local.get $a_low f32.reinterpret_i32 f32.neg i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_sqrt
+      local.get $a_low f32.reinterpret_i32 f32.sqrt i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_ceil
+      local.get $a_low f32.reinterpret_i32 f32.ceil i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_floor
+      local.get $a_low f32.reinterpret_i32 f32.floor i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_trunc
+      local.get $a_low f32.reinterpret_i32 f32.trunc i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f32_nearest
+      local.get $a_low f32.reinterpret_i32 f32.nearest i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $unknown
+    unreachable)
+
+  (func (export "f64_binary_0") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    block $unknown
+    block $f64_copysign
+    block $f64_max
+    block $f64_min
+    block $f64_div
+    block $f64_mul
+    block $f64_sub
+    block $f64_add
+      local.get $op
+      br_table $f64_add $f64_sub $f64_mul $f64_div $f64_min $f64_max $f64_copysign $unknown
+    end $f64_add
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.add i64.reinterpret_f64 call $split return
+    end $f64_sub
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.sub i64.reinterpret_f64 call $split return
+    end $f64_mul
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.mul i64.reinterpret_f64 call $split return
+    end $f64_div
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.div i64.reinterpret_f64 call $split return
+    end $f64_min
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.min i64.reinterpret_f64 call $split return
+    end $f64_max
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.max i64.reinterpret_f64 call $split return
+    end $f64_copysign
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.copysign i64.reinterpret_f64 call $split return
+    end $unknown
+    unreachable)
+
+  (func (export "f64_binary_4") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    block $unknown
+    block $f64_copysign
+    block $f64_max
+    block $f64_min
+    block $f64_div
+    block $f64_mul
+    block $f64_sub
+    block $f64_add
+      local.get $op
+      br_table $f64_add $f64_sub $f64_mul $f64_div $f64_min $f64_max $f64_copysign $unknown
+    end $f64_add
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.add i64.reinterpret_f64 call $split return
+    end $f64_sub
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.sub i64.reinterpret_f64 call $split return
+    end $f64_mul
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.mul i64.reinterpret_f64 call $split return
+    end $f64_div
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.div i64.reinterpret_f64 call $split return
+    end $f64_min
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.min i64.reinterpret_f64 call $split return
+    end $f64_max
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.max i64.reinterpret_f64 call $split return
+    end $f64_copysign
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.copysign i64.reinterpret_f64 call $split return
+    end $unknown
+    unreachable)
+
+  (func (export "f64_binary_5") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    block $unknown
+    block $f64_copysign
+    block $f64_max
+    block $f64_min
+    block $f64_div
+    block $f64_mul
+    block $f64_sub
+    block $f64_add
+      local.get $op
+      br_table $f64_add $f64_sub $f64_mul $f64_div $f64_min $f64_max $f64_copysign $unknown
+    end $f64_add
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.add i64.reinterpret_f64 call $split return
+    end $f64_sub
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.sub i64.reinterpret_f64 call $split return
+    end $f64_mul
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.mul i64.reinterpret_f64 call $split return
+    end $f64_div
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.div i64.reinterpret_f64 call $split return
+    end $f64_min
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.min i64.reinterpret_f64 call $split return
+    end $f64_max
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.max i64.reinterpret_f64 call $split return
+    end $f64_copysign
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.copysign i64.reinterpret_f64 call $split return
+    end $unknown
+    unreachable)
+
+  (func (export "f64_binary_6") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    block $unknown
+    block $f64_copysign
+    block $f64_max
+    block $f64_min
+    block $f64_div
+    block $f64_mul
+    block $f64_sub
+    block $f64_add
+      local.get $op
+      br_table $f64_add $f64_sub $f64_mul $f64_div $f64_min $f64_max $f64_copysign $unknown
+    end $f64_add
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.add i64.reinterpret_f64 call $split return
+    end $f64_sub
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.sub i64.reinterpret_f64 call $split return
+    end $f64_mul
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.mul i64.reinterpret_f64 call $split return
+    end $f64_div
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.div i64.reinterpret_f64 call $split return
+    end $f64_min
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.min i64.reinterpret_f64 call $split return
+    end $f64_max
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.max i64.reinterpret_f64 call $split return
+    end $f64_copysign
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.copysign i64.reinterpret_f64 call $split return
+    end $unknown
+    unreachable)
+
+  (func (export "f64_compare_0") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    block $unknown
+    block $f64_ge
+    block $f64_le
+    block $f64_gt
+    block $f64_lt
+    block $f64_ne
+    block $f64_eq
+      local.get $op
+      br_table $f64_eq $f64_ne $f64_lt $f64_gt $f64_le $f64_ge $unknown
+    end $f64_eq
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.eq i64.extend_i32_u call $split return
+    end $f64_ne
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.ne i64.extend_i32_u call $split return
+    end $f64_lt
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.lt i64.extend_i32_u call $split return
+    end $f64_gt
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.gt i64.extend_i32_u call $split return
+    end $f64_le
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.le i64.extend_i32_u call $split return
+    end $f64_ge
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.ge i64.extend_i32_u call $split return
+    end $unknown
+    unreachable)
+
+  (func (export "f64_compare_4") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    block $unknown
+    block $f64_ge
+    block $f64_le
+    block $f64_gt
+    block $f64_lt
+    block $f64_ne
+    block $f64_eq
+      local.get $op
+      br_table $f64_eq $f64_ne $f64_lt $f64_gt $f64_le $f64_ge $unknown
+    end $f64_eq
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.eq i64.extend_i32_u call $split return
+    end $f64_ne
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.ne i64.extend_i32_u call $split return
+    end $f64_lt
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.lt i64.extend_i32_u call $split return
+    end $f64_gt
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.gt i64.extend_i32_u call $split return
+    end $f64_le
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.le i64.extend_i32_u call $split return
+    end $f64_ge
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.ge i64.extend_i32_u call $split return
+    end $unknown
+    unreachable)
+
+  (func (export "f64_compare_5") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    block $unknown
+    block $f64_ge
+    block $f64_le
+    block $f64_gt
+    block $f64_lt
+    block $f64_ne
+    block $f64_eq
+      local.get $op
+      br_table $f64_eq $f64_ne $f64_lt $f64_gt $f64_le $f64_ge $unknown
+    end $f64_eq
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.eq i64.extend_i32_u call $split return
+    end $f64_ne
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.ne i64.extend_i32_u call $split return
+    end $f64_lt
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.lt i64.extend_i32_u call $split return
+    end $f64_gt
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.gt i64.extend_i32_u call $split return
+    end $f64_le
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.le i64.extend_i32_u call $split return
+    end $f64_ge
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.ge i64.extend_i32_u call $split return
+    end $unknown
+    unreachable)
+
+  (func (export "f64_compare_6") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    block $unknown
+    block $f64_ge
+    block $f64_le
+    block $f64_gt
+    block $f64_lt
+    block $f64_ne
+    block $f64_eq
+      local.get $op
+      br_table $f64_eq $f64_ne $f64_lt $f64_gt $f64_le $f64_ge $unknown
+    end $f64_eq
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.eq i64.extend_i32_u call $split return
+    end $f64_ne
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.ne i64.extend_i32_u call $split return
+    end $f64_lt
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.lt i64.extend_i32_u call $split return
+    end $f64_gt
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.gt i64.extend_i32_u call $split return
+    end $f64_le
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.le i64.extend_i32_u call $split return
+    end $f64_ge
+      local.get $a f64.reinterpret_i64 local.get $b f64.reinterpret_i64 f64.ge i64.extend_i32_u call $split return
+    end $unknown
+    unreachable)
+
+  (func (export "f64_unary_0") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    block $unknown
+    block $f64_nearest
+    block $f64_trunc
+    block $f64_floor
+    block $f64_ceil
+    block $f64_sqrt
+    block $f64_neg
+    block $f64_abs
+      local.get $op
+      br_table $f64_abs $f64_neg $f64_sqrt $f64_ceil $f64_floor $f64_trunc $f64_nearest $unknown
+    end $f64_abs
+      local.get $a f64.reinterpret_i64 f64.abs i64.reinterpret_f64 call $split return
+    end $f64_neg
+      local.get $a f64.reinterpret_i64 f64.neg i64.reinterpret_f64 call $split return
+    end $f64_sqrt
+      local.get $a f64.reinterpret_i64 f64.sqrt i64.reinterpret_f64 call $split return
+    end $f64_ceil
+      local.get $a f64.reinterpret_i64 f64.ceil i64.reinterpret_f64 call $split return
+    end $f64_floor
+      local.get $a f64.reinterpret_i64 f64.floor i64.reinterpret_f64 call $split return
+    end $f64_trunc
+      local.get $a f64.reinterpret_i64 f64.trunc i64.reinterpret_f64 call $split return
+    end $f64_nearest
+      local.get $a f64.reinterpret_i64 f64.nearest i64.reinterpret_f64 call $split return
+    end $unknown
+    unreachable)
+
+  (func (export "f64_unary_4") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    block $unknown
+    block $f64_nearest
+    block $f64_trunc
+    block $f64_floor
+    block $f64_ceil
+    block $f64_sqrt
+    block $f64_neg
+    block $f64_abs
+      local.get $op
+      br_table $f64_abs $f64_neg $f64_sqrt $f64_ceil $f64_floor $f64_trunc $f64_nearest $unknown
+    end $f64_abs
+      local.get $a f64.reinterpret_i64 f64.abs i64.reinterpret_f64 call $split return
+    end $f64_neg
+      local.get $a f64.reinterpret_i64 f64.neg i64.reinterpret_f64 call $split return
+    end $f64_sqrt
+      local.get $a f64.reinterpret_i64 f64.sqrt i64.reinterpret_f64 call $split return
+    end $f64_ceil
+      local.get $a f64.reinterpret_i64 f64.ceil i64.reinterpret_f64 call $split return
+    end $f64_floor
+      local.get $a f64.reinterpret_i64 f64.floor i64.reinterpret_f64 call $split return
+    end $f64_trunc
+      local.get $a f64.reinterpret_i64 f64.trunc i64.reinterpret_f64 call $split return
+    end $f64_nearest
+      local.get $a f64.reinterpret_i64 f64.nearest i64.reinterpret_f64 call $split return
+    end $unknown
+    unreachable)
+
+  (func (export "f64_unary_5") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    block $unknown
+    block $f64_nearest
+    block $f64_trunc
+    block $f64_floor
+    block $f64_ceil
+    block $f64_sqrt
+    block $f64_neg
+    block $f64_abs
+      local.get $op
+      br_table $f64_abs $f64_neg $f64_sqrt $f64_ceil $f64_floor $f64_trunc $f64_nearest $unknown
+    end $f64_abs
+      local.get $a f64.reinterpret_i64 f64.abs i64.reinterpret_f64 call $split return
+    end $f64_neg
+      local.get $a f64.reinterpret_i64 f64.neg i64.reinterpret_f64 call $split return
+    end $f64_sqrt
+      local.get $a f64.reinterpret_i64 f64.sqrt i64.reinterpret_f64 call $split return
+    end $f64_ceil
+      local.get $a f64.reinterpret_i64 f64.ceil i64.reinterpret_f64 call $split return
+    end $f64_floor
+      local.get $a f64.reinterpret_i64 f64.floor i64.reinterpret_f64 call $split return
+    end $f64_trunc
+      local.get $a f64.reinterpret_i64 f64.trunc i64.reinterpret_f64 call $split return
+    end $f64_nearest
+      local.get $a f64.reinterpret_i64 f64.nearest i64.reinterpret_f64 call $split return
+    end $unknown
+    unreachable)
+
+  (func (export "f64_unary_6") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    block $unknown
+    block $f64_nearest
+    block $f64_trunc
+    block $f64_floor
+    block $f64_ceil
+    block $f64_sqrt
+    block $f64_neg
+    block $f64_abs
+      local.get $op
+      br_table $f64_abs $f64_neg $f64_sqrt $f64_ceil $f64_floor $f64_trunc $f64_nearest $unknown
+    end $f64_abs
+      local.get $a f64.reinterpret_i64 f64.abs i64.reinterpret_f64 call $split return
+    end $f64_neg
+      local.get $a f64.reinterpret_i64 f64.neg i64.reinterpret_f64 call $split return
+    end $f64_sqrt
+      local.get $a f64.reinterpret_i64 f64.sqrt i64.reinterpret_f64 call $split return
+    end $f64_ceil
+      local.get $a f64.reinterpret_i64 f64.ceil i64.reinterpret_f64 call $split return
+    end $f64_floor
+      local.get $a f64.reinterpret_i64 f64.floor i64.reinterpret_f64 call $split return
+    end $f64_trunc
+      local.get $a f64.reinterpret_i64 f64.trunc i64.reinterpret_f64 call $split return
+    end $f64_nearest
+      local.get $a f64.reinterpret_i64 f64.nearest i64.reinterpret_f64 call $split return
+    end $unknown
+    unreachable))
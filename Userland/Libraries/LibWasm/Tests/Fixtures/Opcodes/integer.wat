@@ -0,0 +1,1103 @@
+;; The source of integer.wasm, which is assembled from it with `wat2wasm integer.wat`.
+;; Every integer instruction that compiled code runs by itself.
+;;
+;; The first argument of each function picks the instruction. 64-bit operands are passed in halves and results
+;; leave through split() and high(), so that no bits are lost to JavaScript numbers. Each function is there with
+;; 0, 4, 5 and 6 values under its operands: compiled code keeps the first six values of the stack in registers,
+;; so the deeper versions run each instruction with other registers and with operands in memory.
+(module
+  (global $high (mut i32) (i32.const 0))
+
+  ;; Keeps the high half of a result for high(), and returns the low half.
+  (func $split (param $value i64) (result i32)
+    local.get $value
+    i64.const 32
+    i64.shr_u
+    i32.wrap_i64
+    global.set $high
+    local.get $value
+    i32.wrap_i64)
+
+  (func (export "high") (result i32)
+    global.get $high)
+
+  (func $join (param $high i32) (param $low i32) (result i64)
+    local.get $high
+    i64.extend_i32_u
+    i64.const 32
+    i64.shl
+    local.get $low
+    i64.extend_i32_u
+    i64.or)
+
+  (func (export "i32_binary_0") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    block $unknown
+    block $i32_ge_u
+    block $i32_ge_s
+    block $i32_le_u
+    block $i32_le_s
+    block $i32_gt_u
+    block $i32_gt_s
+    block $i32_lt_u
+    block $i32_lt_s
+    block $i32_ne
+    block $i32_eq
+    block $i32_rotr
+    block $i32_rotl
+    block $i32_shr_u
+    block $i32_shr_s
+    block $i32_shl
+    block $i32_xor
+    block $i32_or
+    block $i32_and
+    block $i32_rem_u
+    block $i32_rem_s
+    block $i32_div_u
+    block $i32_div_s
+    block $i32_mul
+    block $i32_sub
+    block $i32_add
+      local.get $op
+      br_table $i32_add $i32_sub $i32_mul $i32_div_s $i32_div_u $i32_rem_s $i32_rem_u $i32_and $i32_or $i32_xor $i32_shl $i32_shr_s $i32_shr_u $i32_rotl $i32_rotr $i32_eq $i32_ne $i32_lt_s $i32_lt_u $i32_gt_s $i32_gt_u $i32_le_s $i32_le_u $i32_ge_s $i32_ge_u $unknown
+    end $i32_add
+      local.get $a_low local.get $b_low i32.add i64.extend_i32_u call $split return
+    end $i32_sub
+      local.get $a_low local.get $b_low i32.sub i64.extend_i32_u call $split return
+    end $i32_mul
+      local.get $a_low local.get $b_low i32.mul i64.extend_i32_u call $split return
+    end $i32_div_s
+      local.get $a_low local.get $b_low i32.div_s i64.extend_i32_u call $split return
+    end $i32_div_u
+      local.get $a_low local.get $b_low i32.div_u i64.extend_i32_u call $split return
+    end $i32_rem_s
+      local.get $a_low local.get $b_low i32.rem_s i64.extend_i32_u call $split return
+    end $i32_rem_u
+      local.get $a_low local.get $b_low i32.rem_u i64.extend_i32_u call $split return
+    end $i32_and
+      local.get $a_low local.get $b_low i32.and i64.extend_i32_u call $split return
+    end $i32_or
+      local.get $a_low local.get $b_low i32.or i64.extend_i32_u call $split return
+    end $i32_xor
+      local.get $a_low local.get $b_low i32.xor i64.extend_i32_u call $split return
+    end $i32_shl
+      local.get $a_low local.get $b_low i32.shl i64.extend_i32_u call $split return
+    end $i32_shr_s
+      local.get $a_low local.get $b_low i32.shr_s i64.extend_i32_u call $split return
+    end $i32_shr_u
+      local.get $a_low local.get $b_low i32.shr_u i64.extend_i32_u call $split return
+    end $i32_rotl
+      local.get $a_low local.get $b_low i32.rotl i64.extend_i32_u call $split return
+    end $i32_rotr
+      local.get $a_low local.get $b_low i32.rotr i64.extend_i32_u call $split return
+    end $i32_eq
+      local.get $a_low local.get $b_low i32.eq i64.extend_i32_u call $split return
+    end $i32_ne
+      local.get $a_low local.get $b_low i32.ne i64.extend_i32_u call $split return
+    end $i32_lt_s
+      local.get $a_low local.get $b_low i32.lt_s i64.extend_i32_u call $split return
+    end $i32_lt_u
+      local.get $a_low local.get $b_low i32.lt_u i64.extend_i32_u call $split return
+    end $i32_gt_s
+      local.get $a_low local.get $b_low i32.gt_s i64.extend_i32_u call $split return
+    end $i32_gt_u
+      local.get $a_low local.get $b_low i32.gt_u i64.extend_i32_u call $split return
+    end $i32_le_s
+      local.get $a_low local.get $b_low i32.le_s i64.extend_i32_u call $split return
+    end $i32_le_u
+      local.get $a_low local.get $b_low i32.le_u i64.extend_i32_u call $split return
+    end $i32_ge_s
+      local.get $a_low local.get $b_low i32.ge_s i64.extend_i32_u call $split return
+    end $i32_ge_u
+      local.get $a_low local.get $b_low i32.ge_u i64.extend_i32_u call $split return
+    end $unknown
+    unreachable)
+
+  (func (export "i32_binary_4") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    block $unknown
+    block $i32_ge_u
+    block $i32_ge_s
+    block $i32_le_u
+    block $i32_le_s
+    block $i32_gt_u
+    block $i32_gt_s
+    block $i32_lt_u
+    block $i32_lt_s
+    block $i32_ne
+    block $i32_eq
+    block $i32_rotr
+    block $i32_rotl
+    block $i32_shr_u
+    block $i32_shr_s
+    block $i32_shl
+    block $i32_xor
+    block $i32_or
+    block $i32_and
+    block $i32_rem_u
+    block $i32_rem_s
+    block $i32_div_u
+    block $i32_div_s
+    block $i32_mul
+    block $i32_sub
+    block $i32_add
+      local.get $op
+      br_table $i32_add $i32_sub $i32_mul $i32_div_s $i32_div_u $i32_rem_s $i32_rem_u $i32_and $i32_or $i32_xor $i32_shl $i32_shr_s $i32_shr_u $i32_rotl $i32_rotr $i32_eq $i32_ne $i32_lt_s $i32_lt_u $i32_gt_s $i32_gt_u $i32_le_s $i32_le_u $i32_ge_s $i32_ge_u $unknown
+    end $i32_add
+      local.get $a_low local.get $b_low i32.add i64.extend_i32_u call $split return
+    end $i32_sub
+      local.get $a_low local.get $b_low i32.sub i64.extend_i32_u call $split return
+    end $i32_mul
+      local.get $a_low local.get $b_low i32.mul i64.extend_i32_u call $split return
+    end $i32_div_s
+      local.get $a_low local.get $b_low i32.div_s i64.extend_i32_u call $split return
+    end $i32_div_u
+      local.get $a_low local.get $b_low i32.div_u i64.extend_i32_u call $split return
+    end $i32_rem_s
+      local.get $a_low local.get $b_low i32.rem_s i64.extend_i32_u call $split return
+    end $i32_rem_u
+      local.get $a_low local.get $b_low i32.rem_u i64.extend_i32_u call $split return
+    end $i32_and
+      local.get $a_low local.get $b_low i32.and i64.extend_i32_u call $split return
+    end $i32_or
+      local.get $a_low local.get $b_low i32.or i64.extend_i32_u call $split return
+    end $i32_xor
+      local.get $a_low local.get $b_low i32.xor i64.extend_i32_u call $split return
+    end $i32_shl
+      local.get $a_low local.get $b_low i32.shl i64.extend_i32_u call $split return
+    end $i32_shr_s
+      local.get $a_low local.get $b_low i32.shr_s i64.extend_i32_u call $split return
+    end $i32_shr_u
+      local.get $a_low local.get $b_low i32.shr_u i64.extend_i32_u call $split return
+    end $i32_rotl
+      local.get $a_low local.get $b_low i32.rotl i64.extend_i32_u call $split return
+    end $i32_rotr
+      local.get $a_low local.get $b_low i32.rotr i64.extend_i32_u call $split return
+    end $i32_eq
+      local.get $a_low local.get $b_low i32.eq i64.extend_i32_u call $split return
+    end $i32_ne
+      local.get $a_low local.get $b_low i32.ne i64.extend_i32_u call $split return
+    end $i32_lt_s
+      local.get $a_low local.get $b_low i32.lt_s i64.extend_i32_u call $split return
+    end $i32_lt_u
+      local.get $a_low local.get $b_low i32.lt_u i64.extend_i32_u call $split return
+    end $i32_gt_s
+      local.get $a_low local.get $b_low i32.gt_s i64.extend_i32_u call $split return
+    end $i32_gt_u
+      local.get $a_low local.get $b_low i32.gt_u i64.extend_i32_u call $split return
+    end $i32_le_s
+      local.get $a_low local.get $b_low i32.le_s i64.extend_i32_u call $split return
+    end $i32_le_u
+      local.get $a_low local.get $b_low i32.le_u i64.extend_i32_u call $split return
+    end $i32_ge_s
+      local.get $a_low local.get $b_low i32.ge_s i64.extend_i32_u call $split return
+    end $i32_ge_u
+      local.get $a_low local.get $b_low i32.ge_u i64.extend_i32_u call $split return
+    end $unknown
+    unreachable)
+
+  (func (export "i32_binary_5") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    block $unknown
+    block $i32_ge_u
+    block $i32_ge_s
+    block $i32_le_u
+    block $i32_le_s
+    block $i32_gt_u
+    block $i32_gt_s
+    block $i32_lt_u
+    block $i32_lt_s
+    block $i32_ne
+    block $i32_eq
+    block $i32_rotr
+    block $i32_rotl
+    block $i32_shr_u
+    block $i32_shr_s
+    block $i32_shl
+    block $i32_xor
+    block $i32_or
+    block $i32_and
+    block $i32_rem_u
+    block $i32_rem_s
+    block $i32_div_u
+    block $i32_div_s
+    block $i32_mul
+    block $i32_sub
+    block $i32_add
+      local.get $op
+      br_table $i32_add $i32_sub $i32_mul $i32_div_s $i32_div_u $i32_rem_s $i32_rem_u $i32_and $i32_or $i32_xor $i32_shl $i32_shr_s $i32_shr_u $i32_rotl $i32_rotr $i32_eq $i32_ne $i32_lt_s $i32_lt_u $i32_gt_s $i32_gt_u $i32_le_s $i32_le_u $i32_ge_s $i32_ge_u $unknown
+    end $i32_add
+      local.get $a_low local.get $b_low i32.add i64.extend_i32_u call $split return
+    end $i32_sub
+      local.get $a_low local.get $b_low i32.sub i64.extend_i32_u call $split return
+    end $i32_mul
+      local.get $a_low local.get $b_low i32.mul i64.extend_i32_u call $split return
+    end $i32_div_s
+      local.get $a_low local.get $b_low i32.div_s i64.extend_i32_u call $split return
+    end $i32_div_u
+      local.get $a_low local.get $b_low i32.div_u i64.extend_i32_u call $split return
+    end $i32_rem_s
+      local.get $a_low local.get $b_low i32.rem_s i64.extend_i32_u call $split return
+    end $i32_rem_u
+      local.get $a_low local.get $b_low i32.rem_u i64.extend_i32_u call $split return
+    end $i32_and
+      local.get $a_low local.get $b_low i32.and i64.extend_i32_u call $split return
+    end $i32_or
+      local.get $a_low local.get $b_low i32.or i64.extend_i32_u call $split return
+    end $i32_xor
+      local.get $a_low local.get $b_low i32.xor i64.extend_i32_u call $split return
+    end $i32_shl
+      local.get $a_low local.get $b_low i32.shl i64.extend_i32_u call $split return
+    end $i32_shr_s
+      local.get $a_low local.get $b_low i32.shr_s i64.extend_i32_u call $split return
+    end $i32_shr_u
+      local.get $a_low local.get $b_low i32.shr_u i64.extend_i32_u call $split return
+    end $i32_rotl
+      local.get $a_low local.get $b_low i32.rotl i64.extend_i32_u call $split return
+    end $i32_rotr
+      local.get $a_low local.get $b_low i32.rotr i64.extend_i32_u call $split return
+    end $i32_eq
+      local.get $a_low local.get $b_low i32.eq i64.extend_i32_u call $split return
+    end $i32_ne
+      local.get $a_low local.get $b_low i32.ne i64.extend_i32_u call $split return
+    end $i32_lt_s
+      local.get $a_low local.get $b_low i32.lt_s i64.extend_i32_u call $split return
+    end $i32_lt_u
+      local.get $a_low local.get $b_low i32.lt_u i64.extend_i32_u call $split return
+    end $i32_gt_s
+      local.get $a_low local.get $b_low i32.gt_s i64.extend_i32_u call $split return
+    end $i32_gt_u
+      local.get $a_low local.get $b_low i32.gt_u i64.extend_i32_u call $split return
+    end $i32_le_s
+      local.get $a_low local.get $b_low i32.le_s i64.extend_i32_u call $split return
+    end $i32_le_u
+      local.get $a_low local.get $b_low i32.le_u i64.extend_i32_u call $split return
+    end $i32_ge_s
+      local.get $a_low local.get $b_low i32.ge_s i64.extend_i32_u call $split return
+    end $i32_ge_u
+      local.get $a_low local.get $b_low i32.ge_u i64.extend_i32_u call $split return
+    end $unknown
+    unreachable)
+
+  (func (export "i32_binary_6") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    block $unknown
+    block $i32_ge_u
+    block $i32_ge_s
+    block $i32_le_u
+    block $i32_le_s
+    block $i32_gt_u
+    block $i32_gt_s
+    block $i32_lt_u
+    block $i32_lt_s
+    block $i32_ne
+    block $i32_eq
+    block $i32_rotr
+    block $i32_rotl
+    block $i32_shr_u
+    block $i32_shr_s
+    block $i32_shl
+    block $i32_xor
+    block $i32_or
+    block $i32_and
+    block $i32_rem_u
+    block $i32_rem_s
+    block $i32_div_u
+    block $i32_div_s
+    block $i32_mul
+    block $i32_sub
+    block $i32_add
+      local.get $op
+      br_table $i32_add $i32_sub $i32_mul $i32_div_s $i32_div_u $i32_rem_s $i32_rem_u $i32_and $i32_or $i32_xor $i32_shl $i32_shr_s $i32_shr_u $i32_rotl $i32_rotr $i32_eq $i32_ne $i32_lt_s $i32_lt_u $i32_gt_s $i32_gt_u $i32_le_s $i32_le_u $i32_ge_s $i32_ge_u $unknown
+    end $i32_add
+      local.get $a_low local.get $b_low i32.add i64.extend_i32_u call $split return
+    end $i32_sub
+      local.get $a_low local.get $b_low i32.sub i64.extend_i32_u call $split return
+    end $i32_mul
+      local.get $a_low local.get $b_low i32.mul i64.extend_i32_u call $split return
+    end $i32_div_s
+      local.get $a_low local.get $b_low i32.div_s i64.extend_i32_u call $split return
+    end $i32_div_u
+      local.get $a_low local.get $b_low i32.div_u i64.extend_i32_u call $split return
+    end $i32_rem_s
+      local.get $a_low local.get $b_low i32.rem_s i64.extend_i32_u call $split return
+    end $i32_rem_u
+      local.get $a_low local.get $b_low i32.rem_u i64.extend_i32_u call $split return
+    end $i32_and
+      local.get $a_low local.get $b_low i32.and i64.extend_i32_u call $split return
+    end $i32_or
+      local.get $a_low local.get $b_low i32.or i64.extend_i32_u call $split return
+    end $i32_xor
+      local.get $a_low local.get $b_low i32.xor i64.extend_i32_u call $split return
+    end $i32_shl
+      local.get $a_low local.get $b_low i32.shl i64.extend_i32_u call $split return
+    end $i32_shr_s
+      local.get $a_low local.get $b_low i32.shr_s i64.extend_i32_u call $split return
+    end $i32_shr_u
+      local.get $a_low local.get $b_low i32.shr_u i64.extend_i32_u call $split return
+    end $i32_rotl
+      local.get $a_low local.get $b_low i32.rotl i64.extend_i32_u call $split return
+    end $i32_rotr
+      local.get $a_low local.get $b_low i32.rotr i64.extend_i32_u call $split return
+    end $i32_eq
+      local.get $a_low local.get $b_low i32.eq i64.extend_i32_u call $split return
+    end $i32_ne
+      local.get $a_low local.get $b_low i32.ne i64.extend_i32_u call $split return
+    end $i32_lt_s
+      local.get $a_low local.get $b_low i32.lt_s i64.extend_i32_u call $split return
+    end $i32_lt_u
+      local.get $a_low local.get $b_low i32.lt_u i64.extend_i32_u call $split return
+    end $i32_gt_s
+      local.get $a_low local.get $b_low i32.gt_s i64.extend_i32_u call $split return
+    end $i32_gt_u
+      local.get $a_low local.get $b_low i32.gt_u i64.extend_i32_u call $split return
+    end $i32_le_s
+      local.get $a_low local.get $b_low i32.le_s i64.extend_i32_u call $split return
+    end $i32_le_u
+      local.get $a_low local.get $b_low i32.le_u i64.extend_i32_u call $split return
+    end $i32_ge_s
+      local.get $a_low local.get $b_low i32.ge_s i64.extend_i32_u call $split return
+    end $i32_ge_u
+      local.get $a_low local.get $b_low i32.ge_u i64.extend_i32_u call $split return
+    end $unknown
+    unreachable)
+
+  (func (export "i32_unary_0") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    block $unknown
+    block $i32_extend16_s
+    block $i32_extend8_s
+    block $i32_popcnt
+    block $i32_ctz
+    block $i32_clz
+    block $i32_eqz
+      local.get $op
+      br_table $i32_eqz $i32_clz $i32_ctz $i32_popcnt $i32_extend8_s $i32_extend16_s $unknown
+    end $i32_eqz
+      local.get $a_low i32.eqz i64.extend_i32_u call $split return
+    end $i32_clz
+      local.get $a_low i32.clz i64.extend_i32_u call $split return
+    end $i32_ctz
+      local.get $a_low i32.ctz i64.extend_i32_u call $split return
+    end $i32_popcnt
+      local.get $a_low i32.popcnt i64.extend_i32_u call $split return
+    end $i32_extend8_s
+      local.get $a_low i32.extend8_s i64.extend_i32_u call $split return
+    end $i32_extend16_s
+      local.get $a_low i32.extend16_s i64.extend_i32_u call $split return
+    end $unknown
+    unreachable)
+
+  (func (export "i32_unary_4") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    block $unknown
+    block $i32_extend16_s
+    block $i32_extend8_s
+    block $i32_popcnt
+    block $i32_ctz
+    block $i32_clz
+    block $i32_eqz
+      local.get $op
+      br_table $i32_eqz $i32_clz $i32_ctz $i32_popcnt $i32_extend8_s $i32_extend16_s $unknown
+    end $i32_eqz
+      local.get $a_low i32.eqz i64.extend_i32_u call $split return
+    end $i32_clz
+      local.get $a_low i32.clz i64.extend_i32_u call $split return
+    end $i32_ctz
+      local.get $a_low i32.ctz i64.extend_i32_u call $split return
+    end $i32_popcnt
+      local.get $a_low i32.popcnt i64.extend_i32_u call $split return
+    end $i32_extend8_s
+      local.get $a_low i32.extend8_s i64.extend_i32_u call $split return
+    end $i32_extend16_s
+      local.get $a_low i32.extend16_s i64.extend_i32_u call $split return
+    end $unknown
+    unreachable)
+
+  (func (export "i32_unary_5") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    block $unknown
+    block $i32_extend16_s
+    block $i32_extend8_s
+    block $i32_popcnt
+    block $i32_ctz
+    block $i32_clz
+    block $i32_eqz
+      local.get $op
+      br_table $i32_eqz $i32_clz $i32_ctz $i32_popcnt $i32_extend8_s $i32_extend16_s $unknown
+    end $i32_eqz
+      local.get $a_low i32.eqz i64.extend_i32_u call $split return
+    end $i32_clz
+      local.get $a_low i32.clz i64.extend_i32_u call $split return
+    end $i32_ctz
+      local.get $a_low i32.ctz i64.extend_i32_u call $split return
+    end $i32_popcnt
+      local.get $a_low i32.popcnt i64.extend_i32_u call $split return
+    end $i32_extend8_s
+      local.get $a_low i32.extend8_s i64.extend_i32_u call $split return
+    end $i32_extend16_s
+      local.get $a_low i32.extend16_s i64.extend_i32_u call $split return
+    end $unknown
+    unreachable)
+
+  (func (export "i32_unary_6") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    block $unknown
+    block $i32_extend16_s
+    block $i32_extend8_s
+    block $i32_popcnt
+    block $i32_ctz
+    block $i32_clz
+    block $i32_eqz
+      local.get $op
+      br_table $i32_eqz $i32_clz $i32_ctz $i32_popcnt $i32_extend8_s $i32_extend16_s $unknown
+    end $i32_eqz
+      local.get $a_low i32.eqz i64.extend_i32_u call $split return
+    end $i32_clz
+      local.get $a_low i32.clz i64.extend_i32_u call $split return
+    end $i32_ctz
+      local.get $a_low i32.ctz i64.extend_i32_u call $split return
+    end $i32_popcnt
+      local.get $a_low i32.popcnt i64.extend_i32_u call $split return
+    end $i32_extend8_s
+      local.get $a_low i32.extend8_s i64.extend_i32_u call $split return
+    end $i32_extend16_s
+      local.get $a_low i32.extend16_s i64.extend_i32_u call $split return
+    end $unknown
+    unreachable)
+
+  (func (export "i64_binary_0") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    block $unknown
+    block $i64_ge_u
+    block $i64_ge_s
+    block $i64_le_u
+    block $i64_le_s
+    block $i64_gt_u
+    block $i64_gt_s
+    block $i64_lt_u
+    block $i64_lt_s
+    block $i64_ne
+    block $i64_eq
+    block $i64_rotr
+    block $i64_rotl
+    block $i64_shr_u
+    block $i64_shr_s
+    block $i64_shl
+    block $i64_xor
+    block $i64_or
+    block $i64_and
+    block $i64_rem_u
+    block $i64_rem_s
+    block $i64_div_u
+    block $i64_div_s
+    block $i64_mul
+    block $i64_sub
+    block $i64_add
+      local.get $op
+      br_table $i64_add $i64_sub $i64_mul $i64_div_s $i64_div_u $i64_rem_s $i64_rem_u $i64_and $i64_or $i64_xor $i64_shl $i64_shr_s $i64_shr_u $i64_rotl $i64_rotr $i64_eq $i64_ne $i64_lt_s $i64_lt_u $i64_gt_s $i64_gt_u $i64_le_s $i64_le_u $i64_ge_s $i64_ge_u $unknown
+    end $i64_add
+      local.get $a local.get $b i64.add call $split return
+    end $i64_sub
+      local.get $a local.get $b i64.sub call $split return
+    end $i64_mul
+      local.get $a local.get $b i64.mul call $split return
+    end $i64_div_s
+      local.get $a local.get $b i64.div_s call $split return
+    end $i64_div_u
+      local.get $a local.get $b i64.div_u call $split return
+    end $i64_rem_s
+      local.get $a local.get $b i64.rem_s call $split return
+    end $i64_rem_u
+      local.get $a local.get $b i64.rem_u call $split return
+    end $i64_and
+      local.get $a local.get $b i64.and call $split return
+    end $i64_or
+      local.get $a local.get $b i64.or call $split return
+    end $i64_xor
+      local.get $a local.get $b i64.xor call $split return
+    end $i64_shl
+      local.get $a local.get $b i64.shl call $split return
+    end $i64_shr_s
+      local.get $a local.get $b i64.shr_s call $split return
+    end $i64_shr_u
+      local.get $a local.get $b i64.shr_u call $split return
+    end $i64_rotl
+      local.get $a local.get $b i64.rotl call $split return
+    end $i64_rotr
+      local.get $a local.get $b i64.rotr call $split return
+    end $i64_eq
+      local.get $a local.get $b i64.eq i64.extend_i32_u call $split return
+    end $i64_ne
+      local.get $a local.get $b i64.ne i64.extend_i32_u call $split return
+    end $i64_lt_s
+      local.get $a local.get $b i64.lt_s i64.extend_i32_u call $split return
+    end $i64_lt_u
+      local.get $a local.get $b i64.lt_u i64.extend_i32_u call $split return
+    end $i64_gt_s
+      local.get $a local.get $b i64.gt_s i64.extend_i32_u call $split return
+    end $i64_gt_u
+      local.get $a local.get $b i64.gt_u i64.extend_i32_u call $split return
+    end $i64_le_s
+      local.get $a local.get $b i64.le_s i64.extend_i32_u call $split return
+    end $i64_le_u
+      local.get $a local.get $b i64.le_u i64.extend_i32_u call $split return
+    end $i64_ge_s
+      local.get $a local.get $b i64.ge_s i64.extend_i32_u call $split return
+    end $i64_ge_u
+      local.get $a local.get $b i64.ge_u i64.extend_i32_u call $split return
+    end $unknown
+    unreachable)
+
+  (func (export "i64_binary_4") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    block $unknown
+    block $i64_ge_u
+    block $i64_ge_s
+    block $i64_le_u
+    block $i64_le_s
+    block $i64_gt_u
+    block $i64_gt_s
+    block $i64_lt_u
+    block $i64_lt_s
+    block $i64_ne
+    block $i64_eq
+    block $i64_rotr
+    block $i64_rotl
+    block $i64_shr_u
+    block $i64_shr_s
+    block $i64_shl
+    block $i64_xor
+    block $i64_or
+    block $i64_and
+    block $i64_rem_u
+    block $i64_rem_s
+    block $i64_div_u
+    block $i64_div_s
+    block $i64_mul
+    block $i64_sub
+    block $i64_add
+      local.get $op
+      br_table $i64_add $i64_sub $i64_mul $i64_div_s $i64_div_u $i64_rem_s $i64_rem_u $i64_and $i64_or $i64_xor $i64_shl $i64_shr_s $i64_shr_u $i64_rotl $i64_rotr $i64_eq $i64_ne $i64_lt_s $i64_lt_u $i64_gt_s $i64_gt_u $i64_le_s $i64_le_u $i64_ge_s $i64_ge_u $unknown
+    end $i64_add
+      local.get $a local.get $b i64.add call $split return
+    end $i64_sub
+      local.get $a local.get $b i64.sub call $split return
+    end $i64_mul
+      local.get $a local.get $b i64.mul call $split return
+    end $i64_div_s
+      local.get $a local.get $b i64.div_s call $split return
+    end $i64_div_u
+      local.get $a local.get $b i64.div_u call $split return
+    end $i64_rem_s
+      local.get $a local.get $b i64.rem_s call $split return
+    end $i64_rem_u
+      local.get $a local.get $b i64.rem_u call $split return
+    end $i64_and
+      local.get $a local.get $b i64.and call $split return
+    end $i64_or
+      local.get $a local.get $b i64.or call $split return
+    end $i64_xor
+      local.get $a local.get $b i64.xor call $split return
+    end $i64_shl
+      local.get $a local.get $b i64.shl call $split return
+    end $i64_shr_s
+      local.get $a local.get $b i64.shr_s call $split return
+    end $i64_shr_u
+      local.get $a local.get $b i64.shr_u call $split return
+    end $i64_rotl
+      local.get $a local.get $b i64.rotl call $split return
+    end $i64_rotr
+      local.get $a local.get $b i64.rotr call $split return
+    end $i64_eq
+      local.get $a local.get $b i64.eq i64.extend_i32_u call $split return
+    end $i64_ne
+      local.get $a local.get $b i64.ne i64.extend_i32_u call $split return
+    end $i64_lt_s
+      local.get $a local.get $b i64.lt_s i64.extend_i32_u call $split return
+    end $i64_lt_u
+      local.get $a local.get $b i64.lt_u i64.extend_i32_u call $split return
+    end $i64_gt_s
+      local.get $a local.get $b i64.gt_s i64.extend_i32_u call $split return
+    end $i64_gt_u
+      local.get $a local.get $b i64.gt_u i64.extend_i32_u call $split return
+    end $i64_le_s
+      local.get $a local.get $b i64.le_s i64.extend_i32_u call $split return
+    end $i64_le_u
+      local.get $a local.get $b i64.le_u i64.extend_i32_u call $split return
+    end $i64_ge_s
+      local.get $a local.get $b i64.ge_s i64.extend_i32_u call $split return
+    end $i64_ge_u
+      local.get $a local.get $b i64.ge_u i64.extend_i32_u call $split return
+    end $unknown
+    unreachable)
+
+  (func (export "i64_binary_5") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    block $unknown
+    block $i64_ge_u
+    block $i64_ge_s
+    block $i64_le_u
+    block $i64_le_s
+    block $i64_gt_u
+    block $i64_gt_s
+    block $i64_lt_u
+    block $i64_lt_s
+    block $i64_ne
+    block $i64_eq
+    block $i64_rotr
+    block $i64_rotl
+    block $i64_shr_u
+    block $i64_shr_s
+    block $i64_shl
+    block $i64_xor
+    block $i64_or
+    block $i64_and
+    block $i64_rem_u
+    block $i64_rem_s
+    block $i64_div_u
+    block $i64_div_s
+    block $i64_mul
+    block $i64_sub
+    block $i64_add
+      local.get $op
+      br_table $i64_add $i64_sub $i64_mul $i64_div_s $i64_div_u $i64_rem_s $i64_rem_u $i64_and $i64_or $i64_xor $i64_shl $i64_shr_s $i64_shr_u $i64_rotl $i64_rotr $i64_eq $i64_ne $i64_lt_s $i64_lt_u $i64_gt_s $i64_gt_u $i64_le_s $i64_le_u $i64_ge_s $i64_ge_u $unknown
+    end $i64_add
+      local.get $a local.get $b i64.add call $split return
+    end $i64_sub
+      local.get $a local.get $b i64.sub call $split return
+    end $i64_mul
+      local.get $a local.get $b i64.mul call $split return
+    end $i64_div_s
+      local.get $a local.get $b i64.div_s call $split return
+    end $i64_div_u
+      local.get $a local.get $b i64.div_u call $split return
+    end $i64_rem_s
+      local.get $a local.get $b i64.rem_s call $split return
+    end $i64_rem_u
+      local.get $a local.get $b i64.rem_u call $split return
+    end $i64_and
+      local.get $a local.get $b i64.and call $split return
+    end $i64_or
+      local.get $a local.get $b i64.or call $split return
+    end $i64_xor
+      local.get $a local.get $b i64.xor call $split return
+    end $i64_shl
+      local.get $a local.get $b i64.shl call $split return
+    end $i64_shr_s
+      local.get $a local.get $b i64.shr_s call $split return
+    end $i64_shr_u
+      local.get $a local.get $b i64.shr_u call $split return
+    end $i64_rotl
+      local.get $a local.get $b i64.rotl call $split return
+    end $i64_rotr
+      local.get $a local.get $b i64.rotr call $split return
+    end $i64_eq
+      local.get $a local.get $b i64.eq i64.extend_i32_u call $split return
+    end $i64_ne
+      local.get $a local.get $b i64.ne i64.extend_i32_u call $split return
+    end $i64_lt_s
+      local.get $a local.get $b i64.lt_s i64.extend_i32_u call $split return
+    end $i64_lt_u
+      local.get $a local.get $b i64.lt_u i64.extend_i32_u call $split return
+    end $i64_gt_s
+      local.get $a local.get $b i64.gt_s i64.extend_i32_u call $split return
+    end $i64_gt_u
+      local.get $a local.get $b i64.gt_u i64.extend_i32_u call $split return
+    end $i64_le_s
+      local.get $a local.get $b i64.le_s i64.extend_i32_u call $split return
+    end $i64_le_u
+      local.get $a local.get $b i64.le_u i64.extend_i32_u call $split return
+    end $i64_ge_s
+      local.get $a local.get $b i64.ge_s i64.extend_i32_u call $split return
+    end $i64_ge_u
+      local.get $a local.get $b i64.ge_u i64.extend_i32_u call $split return
+    end $unknown
+    unreachable)
+
+  (func (export "i64_binary_6") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    block $unknown
+    block $i64_ge_u
+    block $i64_ge_s
+    block $i64_le_u
+    block $i64_le_s
+    block $i64_gt_u
+    block $i64_gt_s
+    block $i64_lt_u
+    block $i64_lt_s
+    block $i64_ne
+    block $i64_eq
+    block $i64_rotr
+    block $i64_rotl
+    block $i64_shr_u
+    block $i64_shr_s
+    block $i64_shl
+    block $i64_xor
+    block $i64_or
+    block $i64_and
+    block $i64_rem_u
+    block $i64_rem_s
+    block $i64_div_u
+    block $i64_div_s
+    block $i64_mul
+    block $i64_sub
+    block $i64_add
+      local.get $op
+      br_table $i64_add $i64_sub $i64_mul $i64_div_s $i64_div_u $i64_rem_s $i64_rem_u $i64_and $i64_or $i64_xor $i64_shl $i64_shr_s $i64_shr_u $i64_rotl $i64_rotr $i64_eq $i64_ne $i64_lt_s $i64_lt_u $i64_gt_s $i64_gt_u $i64_le_s $i64_le_u $i64_ge_s $i64_ge_u $unknown
+    end $i64_add
+      local.get $a local.get $b i64.add call $split return
+    end $i64_sub
+      local.get $a local.get $b i64.sub call $split return
+    end $i64_mul
+      local.get $a local.get $b i64.mul call $split return
+    end $i64_div_s
+      local.get $a local.get $b i64.div_s call $split return
+    end $i64_div_u
+      local.get $a local.get $b i64.div_u call $split return
+    end $i64_rem_s
+      local.get $a local.get $b i64.rem_s call $split return
+    end $i64_rem_u
+      local.get $a local.get $b i64.rem_u call $split return
+    end $i64_and
+      local.get $a local.get $b i64.and call $split return
+    end $i64_or
+      local.get $a local.get $b i64.or call $split return
+    end $i64_xor
+      local.get $a local.get $b i64.xor call $split return
+    end $i64_shl
+      local.get $a local.get $b i64.shl call $split return
+    end $i64_shr_s
+      local.get $a local.get $b i64.shr_s call $split return
+    end $i64_shr_u
+      local.get $a local.get $b i64.shr_u call $split return
+    end $i64_rotl
+      local.get $a local.get $b i64.rotl call $split return
+    end $i64_rotr
+      local.get $a local.get $b i64.rotr call $split return
+    end $i64_eq
+      local.get $a local.get $b i64.eq i64.extend_i32_u call $split return
+    end $i64_ne
+      local.get $a local.get $b i64.ne i64.extend_i32_u call $split return
+    end $i64_lt_s
+      local.get $a local.get $b i64.lt_s i64.extend_i32_u call $split return
+    end $i64_lt_u
+      local.get $a local.get $b i64.lt_u i64.extend_i32_u call $split return
+    end $i64_gt_s
+      local.get $a local.get $b i64.gt_s i64.extend_i32_u call $split return
+    end $i64_gt_u
+      local.get $a local.get $b i64.gt_u i64.extend_i32_u call $split return
+    end $i64_le_s
+      local.get $a local.get $b i64.le_s i64.extend_i32_u call $split return
+    end $i64_le_u
+      local.get $a local.get $b i64.le_u i64.extend_i32_u call $split return
+    end $i64_ge_s
+      local.get $a local.get $b i64.ge_s i64.extend_i32_u call $split return
+    end $i64_ge_u
+      local.get $a local.get $b i64.ge_u i64.extend_i32_u call $split return
+    end $unknown
+    unreachable)
+
+  (func (export "i64_unary_0") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    block $unknown
+    block $i64_extend32_s
+    block $i64_extend16_s
+    block $i64_extend8_s
+    block $i64_popcnt
+    block $i64_ctz
+    block $i64_clz
+    block $i64_eqz
+      local.get $op
+      br_table $i64_eqz $i64_clz $i64_ctz $i64_popcnt $i64_extend8_s $i64_extend16_s $i64_extend32_s $unknown
+    end $i64_eqz
+      local.get $a i64.eqz i64.extend_i32_u call $split return
+    end $i64_clz
+      local.get $a i64.clz call $split return
+    end $i64_ctz
+      local.get $a i64.ctz call $split return
+    end $i64_popcnt
+      local.get $a i64.popcnt call $split return
+    end $i64_extend8_s
+      local.get $a i64.extend8_s call $split return
+    end $i64_extend16_s
+      local.get $a i64.extend16_s call $split return
+    end $i64_extend32_s
+      local.get $a i64.extend32_s call $split return
+    end $unknown
+    unreachable)
+
+  (func (export "i64_unary_4") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    block $unknown
+    block $i64_extend32_s
+    block $i64_extend16_s
+    block $i64_extend8_s
+    block $i64_popcnt
+    block $i64_ctz
+    block $i64_clz
+    block $i64_eqz
+      local.get $op
+      br_table $i64_eqz $i64_clz $i64_ctz $i64_popcnt $i64_extend8_s $i64_extend16_s $i64_extend32_s $unknown
+    end $i64_eqz
+      local.get $a i64.eqz i64.extend_i32_u call $split return
+    end $i64_clz
+      local.get $a i64.clz call $split return
+    end $i64_ctz
+      local.get $a i64.ctz call $split return
+    end $i64_popcnt
+      local.get $a i64.popcnt call $split return
+    end $i64_extend8_s
+      local.get $a i64.extend8_s call $split return
+    end $i64_extend16_s
+      local.get $a i64.extend16_s call $split return
+    end $i64_extend32_s
+      local.get $a i64.extend32_s call $split return
+    end $unknown
+    unreachable)
+
+  (func (export "i64_unary_5") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    block $unknown
+    block $i64_extend32_s
+    block $i64_extend16_s
+    block $i64_extend8_s
+    block $i64_popcnt
+    block $i64_ctz
+    block $i64_clz
+    block $i64_eqz
+      local.get $op
+      br_table $i64_eqz $i64_clz $i64_ctz $i64_popcnt $i64_extend8_s $i64_extend16_s $i64_extend32_s $unknown
+    end $i64_eqz
+      local.get $a i64.eqz i64.extend_i32_u call $split return
+    end $i64_clz
+      local.get $a i64.clz call $split return
+    end $i64_ctz
+      local.get $a i64.ctz call $split return
+    end $i64_popcnt
+      local.get $a i64.popcnt call $split return
+    end $i64_extend8_s
+      local.get $a i64.extend8_s call $split return
+    end $i64_extend16_s
+      local.get $a i64.extend16_s call $split return
+    end $i64_extend32_s
+      local.get $a i64.extend32_s call $split return
+    end $unknown
+    unreachable)
+
+  (func (export "i64_unary_6") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    block $unknown
+    block $i64_extend32_s
+    block $i64_extend16_s
+    block $i64_extend8_s
+    block $i64_popcnt
+    block $i64_ctz
+    block $i64_clz
+    block $i64_eqz
+      local.get $op
+      br_table $i64_eqz $i64_clz $i64_ctz $i64_popcnt $i64_extend8_s $i64_extend16_s $i64_extend32_s $unknown
+    end $i64_eqz
+      local.get $a i64.eqz i64.extend_i32_u call $split return
+    end $i64_clz
+      local.get $a i64.clz call $split return
+    end $i64_ctz
+      local.get $a i64.ctz call $split return
+    end $i64_popcnt
+      local.get $a i64.popcnt call $split return
+    end $i64_extend8_s
+      local.get $a i64.extend8_s call $split return
+    end $i64_extend16_s
+      local.get $a i64.extend16_s call $split return
+    end $i64_extend32_s
+      local.get $a i64.extend32_s call $split return
+    end $unknown
+    unreachable))
@@ -0,0 +1,470 @@
+;; The source of memory.wasm, which is assembled from it with `wat2wasm memory.wat`.
+;; Every load and store, at offsets 0 and 16: store_*() puts the second operand at the address in the low
+;; half of the first, and load_*() returns what is at that address. The memory starts out with one page and can
+;; grow to two.
+;;
+;; The first argument of each function picks the instruction. 64-bit operands are passed in halves and results
+;; leave through split() and high(), so that no bits are lost to JavaScript numbers. Each function is there with
+;; 0 and 6 values under its operands: compiled code keeps the first six values of the stack in registers, so the
+;; deeper version runs each instruction with its operands in memory.
+(module
+  (memory 1 2)
+
+  (func (export "size") (result i32)
+    memory.size)
+
+  (func (export "grow") (param $pages i32) (result i32)
+    local.get $pages
+    memory.grow)
+
+  (global $high (mut i32) (i32.const 0))
+
+  ;; Keeps the high half of a result for high(), and returns the low half.
+  (func $split (param $value i64) (result i32)
+    local.get $value
+    i64.const 32
+    i64.shr_u
+    i32.wrap_i64
+    global.set $high
+    local.get $value
+    i32.wrap_i64)
+
+  (func (export "high") (result i32)
+    global.get $high)
+
+  (func $join (param $high i32) (param $low i32) (result i64)
+    local.get $high
+    i64.extend_i32_u
+    i64.const 32
+    i64.shl
+    local.get $low
+    i64.extend_i32_u
+    i64.or)
+
+  (func (export "store_0") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    block $unknown
+    block $f64_store
+    block $f32_store
+    block $i64_store32
+    block $i64_store16
+    block $i64_store8
+    block $i64_store
+    block $i32_store16
+    block $i32_store8
+    block $i32_store
+      local.get $op
+      br_table $i32_store $i32_store8 $i32_store16 $i64_store $i64_store8 $i64_store16 $i64_store32 $f32_store $f64_store $unknown
+    end $i32_store
+      local.get $a_low local.get $b_low i32.store i64.const 0 call $split return
+    end $i32_store8
+      local.get $a_low local.get $b_low i32.store8 i64.const 0 call $split return
+    end $i32_store16
+      local.get $a_low local.get $b_low i32.store16 i64.const 0 call $split return
+    end $i64_store
+      local.get $a_low local.get $b i64.store i64.const 0 call $split return
+    end $i64_store8
+      local.get $a_low local.get $b i64.store8 i64.const 0 call $split return
+    end $i64_store16
+      local.get $a_low local.get $b i64.store16 i64.const 0 call $split return
+    end $i64_store32
+      local.get $a_low local.get $b i64.store32 i64.const 0 call $split return
+    end $f32_store
+      local.get $a_low local.get $b_low f32.reinterpret_i32 f32.store i64.const 0 call $split return
+    end $f64_store
+      local.get $a_low local.get $b f64.reinterpret_i64 f64.store i64.const 0 call $split return
+    end $unknown
+    unreachable)
+
+  (func (export "store_6") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    block $unknown
+    block $f64_store
+    block $f32_store
+    block $i64_store32
+    block $i64_store16
+    block $i64_store8
+    block $i64_store
+    block $i32_store16
+    block $i32_store8
+    block $i32_store
+      local.get $op
+      br_table $i32_store $i32_store8 $i32_store16 $i64_store $i64_store8 $i64_store16 $i64_store32 $f32_store $f64_store $unknown
+    end $i32_store
+      local.get $a_low local.get $b_low i32.store i64.const 0 call $split return
+    end $i32_store8
+      local.get $a_low local.get $b_low i32.store8 i64.const 0 call $split return
+    end $i32_store16
+      local.get $a_low local.get $b_low i32.store16 i64.const 0 call $split return
+    end $i64_store
+      local.get $a_low local.get $b i64.store i64.const 0 call $split return
+    end $i64_store8
+      local.get $a_low local.get $b i64.store8 i64.const 0 call $split return
+    end $i64_store16
+      local.get $a_low local.get $b i64.store16 i64.const 0 call $split return
+    end $i64_store32
+      local.get $a_low local.get $b i64.store32 i64.const 0 call $split return
+    end $f32_store
+      local.get $a_low local.get $b_low f32.reinterpret_i32 f32.store i64.const 0 call $split return
+    end $f64_store
+      local.get $a_low local.get $b f64.reinterpret_i64 f64.store i64.const 0 call $split return
+    end $unknown
+    unreachable)
+
+  (func (export "store_with_offset_0") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    block $unknown
+    block $f64_store
+    block $f32_store
+    block $i64_store32
+    block $i64_store16
+    block $i64_store8
+    block $i64_store
+    block $i32_store16
+    block $i32_store8
+    block $i32_store
+      local.get $op
+      br_table $i32_store $i32_store8 $i32_store16 $i64_store $i64_store8 $i64_store16 $i64_store32 $f32_store $f64_store $unknown
+    end $i32_store
+      local.get $a_low local.get $b_low i32.store offset=16 i64.const 0 call $split return
+    end $i32_store8
+      local.get $a_low local.get $b_low i32.store8 offset=16 i64.const 0 call $split return
+    end $i32_store16
+      local.get $a_low local.get $b_low i32.store16 offset=16 i64.const 0 call $split return
+    end $i64_store
+      local.get $a_low local.get $b i64.store offset=16 i64.const 0 call $split return
+    end $i64_store8
+      local.get $a_low local.get $b i64.store8 offset=16 i64.const 0 call $split return
+    end $i64_store16
+      local.get $a_low local.get $b i64.store16 offset=16 i64.const 0 call $split return
+    end $i64_store32
+      local.get $a_low local.get $b i64.store32 offset=16 i64.const 0 call $split return
+    end $f32_store
+      local.get $a_low local.get $b_low f32.reinterpret_i32 f32.store offset=16 i64.const 0 call $split return
+    end $f64_store
+      local.get $a_low local.get $b f64.reinterpret_i64 f64.store offset=16 i64.const 0 call $split return
+    end $unknown
+    unreachable)
+
+  (func (export "store_with_offset_6") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    block $unknown
+    block $f64_store
+    block $f32_store
+    block $i64_store32
+    block $i64_store16
+    block $i64_store8
+    block $i64_store
+    block $i32_store16
+    block $i32_store8
+    block $i32_store
+      local.get $op
+      br_table $i32_store $i32_store8 $i32_store16 $i64_store $i64_store8 $i64_store16 $i64_store32 $f32_store $f64_store $unknown
+    end $i32_store
+      local.get $a_low local.get $b_low i32.store offset=16 i64.const 0 call $split return
+    end $i32_store8
+      local.get $a_low local.get $b_low i32.store8 offset=16 i64.const 0 call $split return
+    end $i32_store16
+      local.get $a_low local.get $b_low i32.store16 offset=16 i64.const 0 call $split return
+    end $i64_store
+      local.get $a_low local.get $b i64.store offset=16 i64.const 0 call $split return
+    end $i64_store8
+      local.get $a_low local.get $b i64.store8 offset=16 i64.const 0 call $split return
+    end $i64_store16
+      local.get $a_low local.get $b i64.store16 offset=16 i64.const 0 call $split return
+    end $i64_store32
+      local.get $a_low local.get $b i64.store32 offset=16 i64.const 0 call $split return
+    end $f32_store
+      local.get $a_low local.get $b_low f32.reinterpret_i32 f32.store offset=16 i64.const 0 call $split return
+    end $f64_store
+      local.get $a_low local.get $b f64.reinterpret_i64 f64.store offset=16 i64.const 0 call $split return
+    end $unknown
+    unreachable)
+
+  (func (export "load_0") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    block $unknown
+    block $f64_load
+    block $f32_load
+    block $i64_load32_u
+    block $i64_load32_s
+    block $i64_load16_u
+    block $i64_load16_s
+    block $i64_load8_u
+    block $i64_load8_s
+    block $i64_load
+    block $i32_load16_u
+    block $i32_load16_s
+    block $i32_load8_u
+    block $i32_load8_s
+    block $i32_load
+      local.get $op
+      br_table $i32_load $i32_load8_s $i32_load8_u $i32_load16_s $i32_load16_u $i64_load $i64_load8_s $i64_load8_u $i64_load16_s $i64_load16_u $i64_load32_s $i64_load32_u $f32_load $f64_load $unknown
+    end $i32_load
+      local.get $a_low i32.load i64.extend_i32_u call $split return
+    end $i32_load8_s
+      local.get $a_low i32.load8_s i64.extend_i32_u call $split return
+    end $i32_load8_u
+      local.get $a_low i32.load8_u i64.extend_i32_u call $split return
+    end $i32_load16_s
+      local.get $a_low i32.load16_s i64.extend_i32_u call $split return
+    end $i32_load16_u
+      local.get $a_low i32.load16_u i64.extend_i32_u call $split return
+    end $i64_load
+      local.get $a_low i64.load call $split return
+    end $i64_load8_s
+      local.get $a_low i64.load8_s call $split return
+    end $i64_load8_u
+      local.get $a_low i64.load8_u call $split return
+    end $i64_load16_s
+      local.get $a_low i64.load16_s call $split return
+    end $i64_load16_u
+      local.get $a_low i64.load16_u call $split return
+    end $i64_load32_s
+      local.get $a_low i64.load32_s call $split return
+    end $i64_load32_u
+      local.get $a_low i64.load32_u call $split return
+    end $f32_load
+      local.get $a_low f32.load i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f64_load
+      local.get $a_low f64.load i64.reinterpret_f64 call $split return
+    end $unknown
+    unreachable)
+
+  (func (export "load_6") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    block $unknown
+    block $f64_load
+    block $f32_load
+    block $i64_load32_u
+    block $i64_load32_s
+    block $i64_load16_u
+    block $i64_load16_s
+    block $i64_load8_u
+    block $i64_load8_s
+    block $i64_load
+    block $i32_load16_u
+    block $i32_load16_s
+    block $i32_load8_u
+    block $i32_load8_s
+    block $i32_load
+      local.get $op
+      br_table $i32_load $i32_load8_s $i32_load8_u $i32_load16_s $i32_load16_u $i64_load $i64_load8_s $i64_load8_u $i64_load16_s $i64_load16_u $i64_load32_s $i64_load32_u $f32_load $f64_load $unknown
+    end $i32_load
+      local.get $a_low i32.load i64.extend_i32_u call $split return
+    end $i32_load8_s
+      local.get $a_low i32.load8_s i64.extend_i32_u call $split return
+    end $i32_load8_u
+      local.get $a_low i32.load8_u i64.extend_i32_u call $split return
+    end $i32_load16_s
+      local.get $a_low i32.load16_s i64.extend_i32_u call $split return
+    end $i32_load16_u
+      local.get $a_low i32.load16_u i64.extend_i32_u call $split return
+    end $i64_load
+      local.get $a_low i64.load call $split return
+    end $i64_load8_s
+      local.get $a_low i64.load8_s call $split return
+    end $i64_load8_u
+      local.get $a_low i64.load8_u call $split return
+    end $i64_load16_s
+      local.get $a_low i64.load16_s call $split return
+    end $i64_load16_u
+      local.get $a_low i64.load16_u call $split return
+    end $i64_load32_s
+      local.get $a_low i64.load32_s call $split return
+    end $i64_load32_u
+      local.get $a_low i64.load32_u call $split return
+    end $f32_load
+      local.get $a_low f32.load i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f64_load
+      local.get $a_low f64.load i64.reinterpret_f64 call $split return
+    end $unknown
+    unreachable)
+
+  (func (export "load_with_offset_0") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    block $unknown
+    block $f64_load
+    block $f32_load
+    block $i64_load32_u
+    block $i64_load32_s
+    block $i64_load16_u
+    block $i64_load16_s
+    block $i64_load8_u
+    block $i64_load8_s
+    block $i64_load
+    block $i32_load16_u
+    block $i32_load16_s
+    block $i32_load8_u
+    block $i32_load8_s
+    block $i32_load
+      local.get $op
+      br_table $i32_load $i32_load8_s $i32_load8_u $i32_load16_s $i32_load16_u $i64_load $i64_load8_s $i64_load8_u $i64_load16_s $i64_load16_u $i64_load32_s $i64_load32_u $f32_load $f64_load $unknown
+    end $i32_load
+      local.get $a_low i32.load offset=16 i64.extend_i32_u call $split return
+    end $i32_load8_s
+      local.get $a_low i32.load8_s offset=16 i64.extend_i32_u call $split return
+    end $i32_load8_u
+      local.get $a_low i32.load8_u offset=16 i64.extend_i32_u call $split return
+    end $i32_load16_s
+      local.get $a_low i32.load16_s offset=16 i64.extend_i32_u call $split return
+    end $i32_load16_u
+      local.get $a_low i32.load16_u offset=16 i64.extend_i32_u call $split return
+    end $i64_load
+      local.get $a_low i64.load offset=16 call $split return
+    end $i64_load8_s
+      local.get $a_low i64.load8_s offset=16 call $split return
+    end $i64_load8_u
+      local.get $a_low i64.load8_u offset=16 call $split return
+    end $i64_load16_s
+      local.get $a_low i64.load16_s offset=16 call $split return
+    end $i64_load16_u
+      local.get $a_low i64.load16_u offset=16 call $split return
+    end $i64_load32_s
+      local.get $a_low i64.load32_s offset=16 call $split return
+    end $i64_load32_u
+      local.get $a_low i64.load32_u offset=16 call $split return
+    end $f32_load
+      local.get $a_low f32.load offset=16 i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f64_load
+      local.get $a_low f64.load offset=16 i64.reinterpret_f64 call $split return
+    end $unknown
+    unreachable)
+
+  (func (export "load_with_offset_6") (param $op i32) (param $a_high i32) (param $a_low i32) (param $b_high i32) (param $b_low i32) (result i32)
+    (local $a i64) (local $b i64)
+    local.get $a_high
+    local.get $a_low
+    call $join
+    local.set $a
+    local.get $b_high
+    local.get $b_low
+    call $join
+    local.set $b
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    i32.const 0
+    block $unknown
+    block $f64_load
+    block $f32_load
+    block $i64_load32_u
+    block $i64_load32_s
+    block $i64_load16_u
+    block $i64_load16_s
+    block $i64_load8_u
+    block $i64_load8_s
+    block $i64_load
+    block $i32_load16_u
+    block $i32_load16_s
+    block $i32_load8_u
+    block $i32_load8_s
+    block $i32_load
+      local.get $op
+      br_table $i32_load $i32_load8_s $i32_load8_u $i32_load16_s $i32_load16_u $i64_load $i64_load8_s $i64_load8_u $i64_load16_s $i64_load16_u $i64_load32_s $i64_load32_u $f32_load $f64_load $unknown
+    end $i32_load
+      local.get $a_low i32.load offset=16 i64.extend_i32_u call $split return
+    end $i32_load8_s
+      local.get $a_low i32.load8_s offset=16 i64.extend_i32_u call $split return
+    end $i32_load8_u
+      local.get $a_low i32.load8_u offset=16 i64.extend_i32_u call $split return
+    end $i32_load16_s
+      local.get $a_low i32.load16_s offset=16 i64.extend_i32_u call $split return
+    end $i32_load16_u
+      local.get $a_low i32.load16_u offset=16 i64.extend_i32_u call $split return
+    end $i64_load
+      local.get $a_low i64.load offset=16 call $split return
+    end $i64_load8_s
+      local.get $a_low i64.load8_s offset=16 call $split return
+    end $i64_load8_u
+      local.get $a_low i64.load8_u offset=16 call $split return
+    end $i64_load16_s
+      local.get $a_low i64.load16_s offset=16 call $split return
+    end $i64_load16_u
+      local.get $a_low i64.load16_u offset=16 call $split return
+    end $i64_load32_s
+      local.get $a_low i64.load32_s offset=16 call $split return
+    end $i64_load32_u
+      local.get $a_low i64.load32_u offset=16 call $split return
+    end $f32_load
+      local.get $a_low f32.load offset=16 i32.reinterpret_f32 i64.extend_i32_u call $split return
+    end $f64_load
+      local.get $a_low f64.load offset=16 i64.reinterpret_f64 call $split return
+    end $unknown
+    unreachable))
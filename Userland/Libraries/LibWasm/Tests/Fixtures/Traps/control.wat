@@ -0,0 +1,57 @@
+;; The source of control.wasm, which is assembled from it with `wat2wasm control.wat`.
+;; Traps that don't come from arithmetic or memory accesses: unreachable, running out of branches or call
+;; stack, and traps in callees and in instructions that are left to the interpreter when compiling.
+(module
+  (func $unreachable (export "unreachable")
+    unreachable)
+
+  ;; Never stops branching.
+  (func (export "spin")
+    loop $forever
+      br $forever
+    end)
+
+  ;; Never stops calling itself.
+  (func $recurse (export "recurse") (param $depth i32) (result i32)
+    local.get $depth
+    i32.const 1
+    i32.add
+    call $recurse)
+
+  (func (export "call_unreachable") (param $value i32) (result i32)
+    local.get $value
+    call $unreachable)
+
+  ;; Counts down and calls a function that traps once it gets to zero.
+  (func $trap_at_zero (param $count i32) (result i32)
+    local.get $count
+    i32.eqz
+    if
+      unreachable
+    end
+    local.get $count)
+
+  (func (export "trap_after") (param $count i32) (result i32)
+    (local $total i32)
+    loop $next
+      local.get $total
+      local.get $count
+      call $trap_at_zero
+      i32.add
+      local.set $total
+      local.get $count
+      i32.const 1
+      i32.sub
+      local.set $count
+      br $next
+    end
+    local.get $total)
+
+  ;; Truncation traps on NaN, infinities and values out of range.
+  (func (export "truncate") (param $value f64) (result i32)
+    local.get $value
+    i32.trunc_f64_s)
+
+  (func (export "popcount") (param $value i32) (result i32)
+    local.get $value
+    i32.popcnt))
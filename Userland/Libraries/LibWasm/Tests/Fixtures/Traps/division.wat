@@ -0,0 +1,65 @@
+;; The source of division.wasm, which is assembled from it with `wat2wasm division.wat`.
+;; Integer division and remainder, which trap when dividing by zero, and when the smallest signed value is
+;; divided by -1. The i64 variants take i32 operands and sign-extend them, as the test harness can't pass
+;; every i64 value.
+(module
+  (func (export "i32_div_s") (param $lhs i32) (param $rhs i32) (result i32)
+    local.get $lhs
+    local.get $rhs
+    i32.div_s)
+
+  (func (export "i32_div_u") (param $lhs i32) (param $rhs i32) (result i32)
+    local.get $lhs
+    local.get $rhs
+    i32.div_u)
+
+  (func (export "i32_rem_s") (param $lhs i32) (param $rhs i32) (result i32)
+    local.get $lhs
+    local.get $rhs
+    i32.rem_s)
+
+  (func (export "i32_rem_u") (param $lhs i32) (param $rhs i32) (result i32)
+    local.get $lhs
+    local.get $rhs
+    i32.rem_u)
+
+  (func (export "i64_div_s") (param $lhs i32) (param $rhs i32) (result i64)
+    local.get $lhs
+    i64.extend_i32_s
+    local.get $rhs
+    i64.extend_i32_s
+    i64.div_s)
+
+  (func (export "i64_div_u") (param $lhs i32) (param $rhs i32) (result i64)
+    local.get $lhs
+    i64.extend_i32_u
+    local.get $rhs
+    i64.extend_i32_u
+    i64.div_u)
+
+  (func (export "i64_rem_s") (param $lhs i32) (param $rhs i32) (result i64)
+    local.get $lhs
+    i64.extend_i32_s
+    local.get $rhs
+    i64.extend_i32_s
+    i64.rem_s)
+
+  (func (export "i64_rem_u") (param $lhs i32) (param $rhs i32) (result i64)
+    local.get $lhs
+    i64.extend_i32_u
+    local.get $rhs
+    i64.extend_i32_u
+    i64.rem_u)
+
+  ;; The smallest i64, divided by the sign-extended operand.
+  (func (export "i64_min_div_s") (param $rhs i32) (result i64)
+    i64.const 0x8000000000000000
+    local.get $rhs
+    i64.extend_i32_s
+    i64.div_s)
+
+  (func (export "i64_min_rem_s") (param $rhs i32) (result i64)
+    i64.const 0x8000000000000000
+    local.get $rhs
+    i64.extend_i32_s
+    i64.rem_s))
@@ -0,0 +1,53 @@
+;; The source of memory.wasm, which is assembled from it with `wat2wasm memory.wat`.
+;; Loads and stores that trap when any of the bytes they access is outside of the memory, which starts out
+;; with one page and can grow to two.
+(module
+  (memory 1 2)
+
+  (func (export "load_byte") (param $address i32) (result i32)
+    local.get $address
+    i32.load8_u)
+
+  (func (export "store_byte") (param $address i32) (param $value i32)
+    local.get $address
+    local.get $value
+    i32.store8)
+
+  (func (export "load") (param $address i32) (result i32)
+    local.get $address
+    i32.load)
+
+  (func (export "store") (param $address i32) (param $value i32)
+    local.get $address
+    local.get $value
+    i32.store)
+
+  ;; Only the sum of the address and the offset has to be inside the memory.
+  (func (export "load_with_offset") (param $address i32) (result i32)
+    local.get $address
+    i32.load offset=65532)
+
+  ;; An offset that doesn't fit in a signed 32-bit immediate.
+  (func (export "load_with_huge_offset") (param $address i32) (result i32)
+    local.get $address
+    i32.load offset=0x80000000)
+
+  (func (export "load_i64") (param $address i32) (result i64)
+    local.get $address
+    i64.load)
+
+  ;; Grows the memory by a page, and then stores to and loads from it. Returns -1 if the memory couldn't grow.
+  (func (export "grow_and_store") (param $address i32) (param $value i32) (result i32)
+    i32.const 1
+    memory.grow
+    i32.const -1
+    i32.eq
+    if
+      i32.const -1
+      return
+    end
+    local.get $address
+    local.get $value
+    i32.store
+    local.get $address
+    i32.load))
@@ -0,0 +1,17 @@
+// These run long enough to have their hot functions compiled, so they check that the JIT and the interpreter agree.
+// hash-loop is left out, as its i64 result doesn't survive being turned into a double.
+const expectedResults = {
+    dispatch: 1552648789,
+    fib: 196418,
+    mandelbrot: 540260,
+    sieve: 6542,
+};
+
+for (const [name, expectedResult] of Object.entries(expectedResults)) {
+    test(`run ${name}`, () => {
+        const contents = readBinaryWasmFile(`Fixtures/Benchmarks/${name}.wasm`);
+        const module = parseWebAssemblyModule(contents);
+        const run = module.getExport("run");
+        expect(module.invoke(run)).toBe(expectedResult);
+    });
+}
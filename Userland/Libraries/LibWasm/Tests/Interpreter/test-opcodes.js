@@ -0,0 +1,416 @@
+// Runs every instruction that compiled code doesn't leave to the interpreter, and expects it to
+// give the same results and traps as machine code as it does in the interpreter. The fixtures
+// describe how the functions pick instructions and how their operands and results are passed.
+
+const integers = operands([
+    0n,
+    1n,
+    31n,
+    32n,
+    0x80n,
+    0x7fffffffn,
+    0x80000000n,
+    0xffffffffn,
+    0x123456789abcdef0n,
+    0x7fffffffffffffffn,
+    0x8000000000000000n,
+    0xffffffffffffffffn,
+]);
+
+// Zeros, ones, halves, the limits of the integer types, the largest and smallest values,
+// infinities and NaNs, as bits.
+const f32s = operands([
+    0x00000000n,
+    0x80000000n,
+    0x3f800000n,
+    0xbf800000n,
+    0x3fc00000n,
+    0x40200000n,
+    0xc0200000n,
+    0x4f000000n,
+    0xcf000000n,
+    0x5f000000n,
+    0x7f7fffffn,
+    0x00000001n,
+    0x7f800000n,
+    0xff800000n,
+    0x7fc00000n,
+    0xffc00001n,
+    0x7f800001n,
+]);
+const f64s = operands([
+    0x0000000000000000n,
+    0x8000000000000000n,
+    0x3ff0000000000000n,
+    0xbff0000000000000n,
+    0x3ff8000000000000n,
+    0x4004000000000000n,
+    0xc004000000000000n,
+    0x41e0000000000000n,
+    0xc1e0000000000000n,
+    0x41efffffffe00000n,
+    0x43e0000000000000n,
+    0x7fefffffffffffffn,
+    0x0000000000000001n,
+    0x7ff0000000000000n,
+    0xfff0000000000000n,
+    0x7ff8000000000000n,
+    0xfff8000000000001n,
+    0x7ff0000000000001n,
+]);
+
+const depths = [0, 4, 5, 6];
+
+function halves(value) {
+    return [Number(value >> 32n), Number(value & 0xffffffffn)];
+}
+
+// Splitting BigInts is slow, so the operands are split once, and kept with their halves.
+function operands(values) {
+    return values.map(value => ({ value, halves: halves(value) }));
+}
+
+// The deeper versions of a function only have to show that every instruction gets its operands
+// from and leaves its result in the other places, so they run with every third value.
+function valuesAt(depth, values) {
+    return depth === 0 ? values : values.filter((_, i) => i % 3 === 0);
+}
+
+function hex(value) {
+    return (value >>> 0).toString(16).padStart(8, "0");
+}
+
+function instantiate(name) {
+    const module = parseWebAssemblyModule(readBinaryWasmFile(`Fixtures/Opcodes/${name}.wasm`));
+    const addresses = new Map();
+    const address = exportName => {
+        if (!addresses.has(exportName)) addresses.set(exportName, module.getExport(exportName));
+        return addresses.get(exportName);
+    };
+    return {
+        interpreted: (exportName, ...args) =>
+            module.invokeInterpreted(address(exportName), ...args),
+        compiled: (exportName, ...args) => module.invokeCompiled(address(exportName), ...args),
+        high: () => module.invokeInterpreted(address("high")),
+    };
+}
+
+// What a function of the generated fixtures returns, as the 64 bits it put together, or why it
+// trapped. The operands are BigInts, or their halves.
+function run(module, tier, exportName, op, a, b = [0, 0]) {
+    if (typeof a === "bigint") a = halves(a);
+    if (typeof b === "bigint") b = halves(b);
+    try {
+        const low = module[tier](exportName, op, ...a, ...b);
+        return `0x${hex(module.high())}${hex(low)}`;
+    } catch (e) {
+        return e.message;
+    }
+}
+
+// Takes the halves of the bits of a value, like halves() returns them.
+function isNaNBits([high, low], size) {
+    if (size === 32) return (low & 0x7f800000) === 0x7f800000 && (low & 0x7fffff) !== 0;
+    return (high & 0x7ff00000) === 0x7ff00000 && ((high & 0xfffff) !== 0 || low !== 0);
+}
+
+function isNaNResult(result, size) {
+    if (!result.startsWith("0x")) return false;
+    const bits = [parseInt(result.substring(2, 10), 16), parseInt(result.substring(10), 16)];
+    return isNaNBits(bits, size);
+}
+
+const noOperand = { value: 0n, halves: [0, 0] };
+
+// Describes how the two tiers disagree about a call, if they do. If both operands are NaNs, an
+// arithmetic instruction can return either of them, and the interpreter and compiled code don't
+// pick the same one. Any NaN is fine then.
+function compareBits(module, exportName, op, a, b = noOperand, floatSize) {
+    const interpreted = run(module, "interpreted", exportName, op, a.halves, b.halves);
+    const compiled = run(module, "compiled", exportName, op, a.halves, b.halves);
+    if (interpreted === compiled) return null;
+    if (floatSize && isNaNBits(a.halves, floatSize) && isNaNBits(b.halves, floatSize)) {
+        if (isNaNResult(interpreted, floatSize) && isNaNResult(compiled, floatSize)) return null;
+    }
+    const call = `${exportName}(${op}, 0x${a.value.toString(16)}, 0x${b.value.toString(16)})`;
+    return `${call} = ${compiled}, not ${interpreted}`;
+}
+
+// There are tens of thousands of calls, so the differences are collected and expected once, and
+// only the first few are shown.
+function expectNoDifferences(differences) {
+    expect(differences.slice(0, 5).join("; ")).toBe("");
+}
+
+function testUnary(module, family, count, values) {
+    const differences = [];
+    for (const depth of depths) {
+        const exportName = `${family}_${depth}`;
+        for (let op = 0; op < count; ++op) {
+            for (const a of valuesAt(depth, values)) {
+                const difference = compareBits(module, exportName, op, a);
+                if (difference) differences.push(difference);
+            }
+        }
+    }
+    expectNoDifferences(differences);
+}
+
+function testBinary(module, family, count, values, floatSize) {
+    const differences = [];
+    for (const depth of depths) {
+        const exportName = `${family}_${depth}`;
+        for (let op = 0; op < count; ++op) {
+            for (const a of valuesAt(depth, values)) {
+                for (const b of valuesAt(depth, values)) {
+                    const difference = compareBits(module, exportName, op, a, b, floatSize);
+                    if (difference) differences.push(difference);
+                }
+            }
+        }
+    }
+    expectNoDifferences(differences);
+}
+
+describe("integer", () => {
+    const module = instantiate("integer");
+
+    test("i32 arithmetic, bitwise operations and comparisons", () => {
+        testBinary(module, "i32_binary", 25, integers);
+    });
+
+    test("i32 unary operations", () => {
+        testUnary(module, "i32_unary", 6, integers);
+    });
+
+    test("i64 arithmetic, bitwise operations and comparisons", () => {
+        testBinary(module, "i64_binary", 25, integers);
+    });
+
+    test("i64 unary operations", () => {
+        testUnary(module, "i64_unary", 7, integers);
+    });
+
+    test("results", () => {
+        // i64.mul, i32.shl, i64.rotr and i64.clz.
+        expect(run(module, "interpreted", "i64_binary_0", 2, 0x1234567890n, 0x10001n)).toBe(
+            "0x00123468ace67890"
+        );
+        expect(run(module, "interpreted", "i32_binary_0", 10, 1n, 33n)).toBe("0x0000000000000002");
+        expect(run(module, "interpreted", "i64_binary_0", 14, 0x8000000000000001n, 1n)).toBe(
+            "0xc000000000000000"
+        );
+        expect(run(module, "interpreted", "i64_unary_0", 1, 0xffffn)).toBe("0x0000000000000030");
+    });
+});
+
+describe("float", () => {
+    const module = instantiate("float");
+
+    test("f32 arithmetic, min, max and copysign", () => {
+        testBinary(module, "f32_binary", 7, f32s, 32);
+    });
+
+    test("f32 comparisons", () => {
+        testBinary(module, "f32_compare", 6, f32s);
+    });
+
+    test("f32 unary operations", () => {
+        testUnary(module, "f32_unary", 7, f32s);
+    });
+
+    test("f64 arithmetic, min, max and copysign", () => {
+        testBinary(module, "f64_binary", 7, f64s, 64);
+    });
+
+    test("f64 comparisons", () => {
+        testBinary(module, "f64_compare", 6, f64s);
+    });
+
+    test("f64 unary operations", () => {
+        testUnary(module, "f64_unary", 7, f64s);
+    });
+
+    test("results", () => {
+        // 1.5 + 2.5 as f32 and f64, NaN != NaN, and the sign of -0 flipped by f64.neg.
+        expect(run(module, "interpreted", "f32_binary_0", 0, 0x3fc00000n, 0x40200000n)).toBe(
+            "0x0000000040800000"
+        );
+        expect(
+            run(module, "interpreted", "f64_binary_0", 0, 0x3ff8000000000000n, 0x4004000000000000n)
+        ).toBe("0x4010000000000000");
+        expect(
+            run(module, "interpreted", "f64_compare_0", 1, 0x7ff8000000000000n, 0x7ff8000000000000n)
+        ).toBe("0x0000000000000001");
+        expect(run(module, "interpreted", "f64_unary_0", 1, 0x8000000000000000n)).toBe(
+            "0x0000000000000000"
+        );
+    });
+});
+
+describe("conversion", () => {
+    const module = instantiate("conversion");
+
+    test("between every two value types", () => {
+        testUnary(module, "convert", 33, [...integers, ...f32s, ...f64s]);
+    });
+
+    test("results", () => {
+        // f64.convert_i64_u of 2^64 - 1, and i32.trunc_sat_f64_s of -infinity.
+        expect(run(module, "interpreted", "convert_0", 10, 0xffffffffffffffffn)).toBe(
+            "0x43f0000000000000"
+        );
+        expect(run(module, "interpreted", "convert_0", 23, 0xfff0000000000000n)).toBe(
+            "0x0000000080000000"
+        );
+    });
+});
+
+describe("memory", () => {
+    const storeCount = 9;
+    const loadCount = 14;
+    // Around the start and the end of the first page once the offset is added, and an address that
+    // doesn't fit with the offset. They are passed as the low half of the first operand.
+    const nearTheEnd = [65528, 65529, 65531, 65532, 65534, 65535, 65536];
+    const variants = [
+        ["0", 0],
+        ["6", 0],
+        ["with_offset_0", 16],
+        ["with_offset_6", 16],
+    ];
+    // Compiled stores are checked by interpreted loads and the other way around.
+    const tiers = [
+        ["interpreted", "interpreted"],
+        ["interpreted", "compiled"],
+        ["compiled", "interpreted"],
+    ];
+    const pageSize = 65536;
+
+    // The bytes of the value are all different, and the top bit of each is set so that sign
+    // extension shows.
+    const value = 0x8f9eadbccbdae9f8n;
+    const valueHalves = halves(value);
+
+    // Stores the value with one tier, and loads every size of it back with the other.
+    function storeAndLoad(module, [storeTier, loadTier], variant, store, address) {
+        // Clear the memory that the functions can get at from the address first, byte by byte
+        // where an i64.store doesn't fit.
+        for (let start = address; start < Math.min(address + 32, pageSize); start += 8) {
+            if (run(module, "interpreted", "store_0", 3, [0, start]).startsWith("0x")) continue;
+            for (let byte = start; byte < pageSize; ++byte)
+                run(module, "interpreted", "store_0", 1, [0, byte]);
+        }
+        const stored = run(module, storeTier, `store_${variant}`, store, [0, address], valueHalves);
+        const loaded = [];
+        for (let load = 0; load < loadCount; ++load)
+            loaded.push(run(module, loadTier, `load_${variant}`, load, [0, address]));
+        return `store_${variant}(${store}, ${address}) = ${stored}, loads ${loaded}`;
+    }
+
+    test("stores and loads of every size, in both directions", () => {
+        const module = instantiate("memory");
+        const differences = [];
+        for (const [variant, offset] of variants) {
+            const addresses = [0, 1, 5, ...nearTheEnd.map(end => end - offset), 0xfffffff0];
+            for (const address of addresses) {
+                for (let store = 0; store < storeCount; ++store) {
+                    const results = tiers.map(pair =>
+                        storeAndLoad(module, pair, variant, store, address)
+                    );
+                    for (const result of results) {
+                        if (result !== results[0]) differences.push(`${result}, not ${results[0]}`);
+                    }
+                }
+            }
+        }
+        expectNoDifferences(differences);
+    });
+
+    test("results", () => {
+        const module = instantiate("memory");
+        // i64.store, then i32.load16_s and i64.load32_u from the middle of it.
+        expect(run(module, "compiled", "store_0", 3, 8n, value)).toBe("0x0000000000000000");
+        expect(run(module, "interpreted", "load_0", 3, 10n, 0n)).toBe("0x00000000ffffcbda");
+        expect(run(module, "interpreted", "load_6", 11, 10n, 0n)).toBe("0x00000000adbccbda");
+    });
+
+    test("compiled code sees the memory grow", () => {
+        const module = instantiate("memory");
+        expect(run(module, "compiled", "load_0", 0, 65536n, 0n)).toBe(
+            "Execution trapped: Memory access out of bounds"
+        );
+        expect(module.compiled("grow", 1)).toBe(1);
+        expect(module.compiled("size")).toBe(2);
+        expect(run(module, "compiled", "store_6", 3, 131064n, value)).toBe("0x0000000000000000");
+        expect(run(module, "compiled", "load_0", 5, 131064n, 0n)).toBe("0x8f9eadbccbdae9f8");
+        expect(run(module, "interpreted", "load_6", 5, 131064n, 0n)).toBe("0x8f9eadbccbdae9f8");
+    });
+});
+
+describe("control", () => {
+    const module = instantiate("control");
+
+    function expectSameResults(exportName, ...args) {
+        const results = ["interpreted", "compiled"].map(tier => {
+            try {
+                return `${exportName}(${args}) = ${module[tier](exportName, ...args)}`;
+            } catch (e) {
+                return `${exportName}(${args}) = ${e.message}`;
+            }
+        });
+        expect(results[1]).toBe(results[0]);
+        return results[0];
+    }
+
+    test("br_table", () => {
+        for (const index of [0, 1, 2, 3, 4, 0xffffffff]) expectSameResults("switch", index);
+        expect(module.compiled("switch", 2)).toBe(103);
+        expect(module.compiled("switch", 0xffffffff)).toBe(100);
+    });
+
+    test("branches with values, if and else, and loops", () => {
+        for (const value of [0, 1, 5]) expectSameResults("branch_out", value);
+        for (const value of [0, 9, 10, 0xffffffff]) expectSameResults("if_else", value);
+        for (const n of [0, 1, 100, 5000]) expectSameResults("sum", n);
+        expect(module.compiled("branch_out", 0)).toBe(10);
+        expect(module.compiled("branch_out", 5)).toBe(5);
+        expect(module.compiled("sum", 100)).toBe(5050);
+    });
+
+    test("select", () => {
+        for (const condition of [0, 1, 0x80000000]) {
+            expectSameResults("select_i32", condition, 1, 2);
+            expectSameResults("select_i64", condition, 2 ** 40, 3);
+            expectSameResults("select_f64", condition, -2.5, 0.5);
+        }
+    });
+
+    test("calls", () => {
+        for (const x of [0, 7, 0xfffffff0]) expectSameResults("call_many", x);
+        expect(module.compiled("call_many", 7)).toBe(1071465892);
+        expect(expectSameResults("fib", 20)).toBe("fib(20) = 6765");
+    });
+
+    test("calls through the table", () => {
+        for (const index of [0, 1, 2]) expectSameResults("apply", index, 5, 3);
+        expect(module.compiled("apply", 1, 5, 3)).toBe(2);
+        expect(expectSameResults("apply", 3, 5, 3)).toBe(
+            "apply(3,5,3) = Execution trapped: !expected_type || types_match(*type, *expected_type)"
+        );
+        expect(expectSameResults("apply", 4, 5, 3)).toBe(
+            "apply(4,5,3) = Execution trapped: index < table_instance->elements().size()"
+        );
+    });
+
+    test("globals", () => {
+        expect(module.interpreted("count", 3)).toBe(3);
+        expect(module.compiled("count", 4)).toBe(7);
+        expect(module.interpreted("count", 0)).toBe(7);
+        expect(module.compiled("count_wide", 1)).toBe(1);
+        expect(module.interpreted("count_wide", 5)).toBe(6);
+        expect(module.compiled("count_wide", 0)).toBe(6);
+        expect(module.compiled("average", 4)).toBe(2);
+        expect(module.interpreted("average", 4)).toBe(3);
+        expect(module.compiled("average", 0)).toBe(1.5);
+    });
+});
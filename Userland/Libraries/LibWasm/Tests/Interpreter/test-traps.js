@@ -0,0 +1,132 @@
+// Every way that running a function can trap, each of which the JIT has to leave its machine code
+// for. Everything runs in the interpreter, and again as machine code, which has to trap for the
+// same reasons.
+const divisionByZero = "rhs != 0";
+const integerOverflow = "!lhs.has_overflow()";
+
+// i32 arguments are passed as their unsigned bits.
+const minusOne = 0xffffffff;
+const i32Min = 0x80000000;
+
+function instantiate(name, tier) {
+    const module = parseWebAssemblyModule(readBinaryWasmFile(`Fixtures/Traps/${name}.wasm`));
+    const invoke = tier === "compiled" ? module.invokeCompiled : module.invokeInterpreted;
+    return (exportName, ...args) => invoke.call(module, module.getExport(exportName), ...args);
+}
+
+function expectTrap(callback, reason) {
+    expect(callback).toThrowWithMessage(TypeError, `Execution trapped: ${reason}`);
+}
+
+for (const tier of ["interpreted", "compiled"]) {
+    describe(`division (${tier})`, () => {
+        const call = instantiate("division", tier);
+
+        test("results", () => {
+            expect(call("i32_div_s", 7, minusOne)).toBe(-7);
+            expect(call("i32_div_s", i32Min, 2)).toBe(-1073741824);
+            expect(call("i32_div_u", minusOne, 2)).toBe(2147483647);
+            expect(call("i32_rem_s", minusOne - 6, 3)).toBe(-1);
+            expect(call("i32_rem_u", 7, 3)).toBe(1);
+            expect(call("i64_div_s", minusOne - 6, 2)).toBe(-3);
+            expect(call("i64_div_u", minusOne, 2)).toBe(2147483647);
+            expect(call("i64_rem_s", minusOne - 6, 3)).toBe(-1);
+            expect(call("i64_rem_u", minusOne, 16)).toBe(15);
+            expect(call("i64_min_div_s", 1)).toBe(-9223372036854775808);
+        });
+
+        test("the smallest value divided by -1 overflows, but its remainder is 0", () => {
+            expectTrap(() => call("i32_div_s", i32Min, minusOne), integerOverflow);
+            expect(call("i32_rem_s", i32Min, minusOne)).toBe(0);
+            expectTrap(() => call("i64_min_div_s", minusOne), integerOverflow);
+            expect(call("i64_min_rem_s", minusOne)).toBe(0);
+        });
+
+        test("by zero", () => {
+            for (const operation of ["div_s", "div_u", "rem_s", "rem_u"]) {
+                expectTrap(() => call(`i32_${operation}`, 1, 0), divisionByZero);
+                expectTrap(() => call(`i64_${operation}`, 1, 0), divisionByZero);
+            }
+            expectTrap(() => call("i64_min_div_s", 0), divisionByZero);
+            expectTrap(() => call("i64_min_rem_s", 0), divisionByZero);
+        });
+    });
+
+    describe(`memory (${tier})`, () => {
+        const outOfBounds = "Memory access out of bounds";
+
+        test("accesses right at the end", () => {
+            const call = instantiate("memory", tier);
+            call("store_byte", 65535, 0x1ff);
+            expect(call("load_byte", 65535)).toBe(0xff);
+            call("store", 65532, 0x12345678);
+            expect(call("load", 65532)).toBe(0x12345678);
+            expect(call("load_with_offset", 0)).toBe(0x12345678);
+            expect(call("load_i64", 65528)).toBe(0x12345678 * 2 ** 32);
+        });
+
+        test("accesses that are partly or entirely outside", () => {
+            const call = instantiate("memory", tier);
+            expectTrap(() => call("load_byte", 65536), outOfBounds);
+            expectTrap(() => call("store_byte", 65536, 1), outOfBounds);
+            expectTrap(() => call("load", 65533), outOfBounds);
+            expectTrap(() => call("store", 65533, 1), outOfBounds);
+            expectTrap(() => call("load_i64", 65529), outOfBounds);
+            expectTrap(() => call("load", minusOne), outOfBounds);
+        });
+
+        test("the offset is added to the address without wrapping around", () => {
+            const call = instantiate("memory", tier);
+            expectTrap(() => call("load_with_offset", 1), outOfBounds);
+            expectTrap(() => call("load_with_offset", minusOne), outOfBounds);
+            expectTrap(() => call("load_with_huge_offset", 0), outOfBounds);
+            expectTrap(() => call("load_with_huge_offset", i32Min), outOfBounds);
+        });
+
+        test("the memory can be accessed where it grew to", () => {
+            const call = instantiate("memory", tier);
+            expectTrap(() => call("load", 65536), outOfBounds);
+            expect(call("grow_and_store", 131068, 42)).toBe(42);
+            expect(call("load", 131068)).toBe(42);
+            expectTrap(() => call("load", 131069), outOfBounds);
+            // The memory can't grow past two pages.
+            expect(call("grow_and_store", 0, 1)).toBe(-1);
+        });
+    });
+
+    describe(`control (${tier})`, () => {
+        const call = instantiate("control", tier);
+
+        test("unreachable", () => {
+            expectTrap(() => call("unreachable"), "Unreachable");
+            expectTrap(() => call("call_unreachable", 1), "Unreachable");
+        });
+
+        test("a trap in a callee ends the caller too", () => {
+            expectTrap(() => call("trap_after", 10), "Unreachable");
+        });
+
+        test("running out of branches", () => {
+            expectTrap(() => call("spin"), "Exceeded maximum allowed number of branches");
+        });
+
+        test("running out of call stack", () => {
+            expectTrap(
+                () => call("recurse", 0),
+                "configuration.depth() <= Constants::max_allowed_call_stack_depth"
+            );
+        });
+
+        test("instructions that are left to the interpreter", () => {
+            expect(call("popcount", 0xf0f0)).toBe(8);
+            expect(call("truncate", -2.5)).toBe(-2);
+            expectTrap(() => call("truncate", NaN), "Signed truncation undefined behaviour");
+            expectTrap(() => call("truncate", Infinity), "Signed truncation undefined behaviour");
+            expectTrap(() => call("truncate", 2 ** 31), "Signed truncation out of range");
+        });
+
+        test("the machine can be used again after a trap", () => {
+            expect(call("popcount", 1)).toBe(1);
+        });
+    });
+}
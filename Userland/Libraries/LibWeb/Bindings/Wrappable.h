@@ -28,7 +28,8 @@ private:
 template<class NativeObject>
 inline Wrapper* wrap_impl(JS::GlobalObject& global_object, NativeObject& native_object)
 {
-    if (!native_object.wrapper()) {
+    // The old wrapper may be garbage that hasn't been swept yet, which must not be brought back to life.
+    if (!native_object.wrapper() || JS::Heap::is_dead_but_unswept(*native_object.wrapper())) {
         native_object.set_wrapper(*global_object.heap().allocate<typename NativeObject::WrapperType>(global_object, global_object, native_object));
     }
     return native_object.wrapper();
@@ -812,6 +812,11 @@ public:
     virtual bool internal_set(const JS::PropertyName&, JS::Value, JS::Value receiver) override;
 )~~~");
     }
+    if (interface.extended_attributes.contains("CustomGet") || interface.extended_attributes.contains("CustomSet")) {
+        generator.append(R"~~~(
+    virtual bool has_exotic_property_access() const override { return true; }
+)~~~");
+    }
 
     if (interface.wrapper_base_class == "Wrapper") {
         generator.append(R"~~~(
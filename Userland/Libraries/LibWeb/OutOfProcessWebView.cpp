@@ -341,6 +341,12 @@ void OutOfProcessWebView::notify_server_did_get_dom_tree(const String& dom_tree)
         on_get_dom_tree(dom_tree);
 }
 
+void OutOfProcessWebView::notify_server_did_get_js_profile(const String& profile)
+{
+    if (on_get_js_profile)
+        on_get_js_profile(profile);
+}
+
 void OutOfProcessWebView::notify_server_did_js_console_output(const String& method, const String& line)
 {
     if (on_js_console_output)
@@ -141,6 +141,11 @@ void WebContentClient::did_get_dom_tree(const String& dom_tree)
     m_view.notify_server_did_get_dom_tree(dom_tree);
 }
 
+void WebContentClient::did_get_js_profile(String const& profile)
+{
+    m_view.notify_server_did_get_js_profile(profile);
+}
+
 void WebContentClient::did_js_console_output(String const& method, String const& line)
 {
     m_view.notify_server_did_js_console_output(method, line);
@@ -14,6 +14,7 @@
 #include <LibJS/Heap/Heap.h>
 #include <LibJS/Interpreter.h>
 #include <LibJS/Parser.h>
+#include <LibJS/Runtime/SamplingProfiler.h>
 #include <LibJS/Runtime/VM.h>
 #include <LibWeb/Bindings/MainThreadVM.h>
 #include <LibWeb/Cookie/ParsedCookie.h>
@@ -208,6 +209,20 @@ void ClientConnection::debug_request(const String& request, const String& argume
     if (request == "spoof-user-agent") {
         Web::ResourceLoader::the().set_user_agent(argument);
     }
+
+    if (request == "start-js-profiler") {
+        if (!m_js_profiler)
+            m_js_profiler = make<JS::SamplingProfiler>(Web::Bindings::main_thread_vm());
+    }
+
+    if (request == "stop-js-profiler") {
+        if (m_js_profiler) {
+            m_js_profiler->stop();
+            // We can't write files, so the client has to save the profile for us.
+            async_did_get_js_profile(m_js_profiler->to_chrome_trace());
+            m_js_profiler = nullptr;
+        }
+    }
 }
 
 void ClientConnection::get_source()
@@ -67,6 +67,7 @@ private:
 
     WeakPtr<JS::Interpreter> m_interpreter;
     OwnPtr<WebContentConsoleClient> m_console_client;
+    OwnPtr<JS::SamplingProfiler> m_js_profiler;
 };
 
 }
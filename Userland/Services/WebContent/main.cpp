@@ -4,15 +4,19 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Time.h>
 #include <LibCore/EventLoop.h>
 #include <LibCore/LocalServer.h>
+#include <LibCore/Timer.h>
 #include <LibIPC/ClientConnection.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibWeb/Bindings/MainThreadVM.h>
 #include <WebContent/ClientConnection.h>
 
 int main(int, char**)
 {
     Core::EventLoop event_loop;
-    if (pledge("stdio recvfd sendfd accept unix rpath", nullptr) < 0) {
+    if (pledge("stdio recvfd sendfd accept unix rpath thread", nullptr) < 0) {
         perror("pledge");
         return 1;
     }
@@ -40,5 +44,15 @@ int main(int, char**)
     auto socket = Core::LocalSocket::take_over_accepted_socket_from_system_server();
     VERIFY(socket);
     IPC::new_client_connection<WebContent::ClientConnection>(socket.release_nonnull(), 1);
+
+    // The marking and sweeping that allocations leave over is done a millisecond at a time in between events,
+    // so that the page doesn't have to wait for it the next time it allocates.
+    RefPtr<Core::Timer> gc_work_timer;
+    gc_work_timer = Core::Timer::create_single_shot(100, [&] {
+        auto has_work_left = Web::Bindings::main_thread_vm().heap().perform_incremental_gc_work(Time::from_milliseconds(1));
+        gc_work_timer->start(has_work_left ? 0 : 100);
+    });
+    gc_work_timer->start();
+
     return event_loop.exec();
 }
@@ -11,10 +11,12 @@
 #include <AK/NonnullOwnPtr.h>
 #include <AK/StringBuilder.h>
 #include <LibCore/ArgsParser.h>
+#include <LibCore/ElapsedTimer.h>
 #include <LibCore/File.h>
 #include <LibCore/StandardPaths.h>
 #include <LibJS/AST.h>
 #include <LibJS/Bytecode/BasicBlock.h>
+#include <LibJS/Bytecode/ExecutableCache.h>
 #include <LibJS/Bytecode/Generator.h>
 #include <LibJS/Bytecode/Interpreter.h>
 #include <LibJS/Bytecode/PassManager.h>
@@ -38,6 +40,7 @@
 #include <LibJS/Runtime/Promise.h>
 #include <LibJS/Runtime/ProxyObject.h>
 #include <LibJS/Runtime/RegExpObject.h>
+#include <LibJS/Runtime/SamplingProfiler.h>
 #include <LibJS/Runtime/Set.h>
 #include <LibJS/Runtime/Shape.h>
 #include <LibJS/Runtime/StringObject.h>
@@ -85,7 +88,13 @@ static bool s_dump_ast = false;
 static bool s_dump_bytecode = false;
 static bool s_run_bytecode = false;
 static bool s_opt_bytecode = false;
+static bool s_parse_functions_lazily = false;
 static bool s_print_last_result = false;
+static bool s_dump_inline_caches = false;
+static bool s_dump_bytecode_statistics = false;
+static String s_bytecode_cache_directory;
+static String s_profile_path;
+static String s_profile_format = "folded";
 static RefPtr<Line::Editor> s_editor;
 static String s_history_path = String::formatted("{}/.js-history", Core::StandardPaths::home_directory());
 static int s_repl_line_level = 0;
@@ -565,22 +574,72 @@ static bool write_to_file(String const& path)
     return true;
 }
 
-static bool parse_and_run(JS::Interpreter& interpreter, StringView const& source)
+// Dumps the bytecode of the program and of the global functions it has called, along with how
+// their property lookup caches have fared.
+static void dump_inline_caches(JS::GlobalObject& global_object, JS::Bytecode::Executable const& unit)
 {
-    auto parser = JS::Parser(JS::Lexer(source));
-    auto program = parser.parse_program();
+    warnln("Inline caches of the program:");
+    unit.dump();
+    for (auto& property : global_object.shape().property_table_ordered()) {
+        auto value = global_object.get_direct(property.value.offset);
+        if (!value.is_object() || !is<JS::OrdinaryFunctionObject>(value.as_object()))
+            continue;
+        auto& function = static_cast<JS::OrdinaryFunctionObject&>(value.as_object());
+        if (!function.bytecode_executable().has_value())
+            continue;
+        warnln();
+        warnln("Inline caches of function '{}':", function.name());
+        function.bytecode_executable()->dump();
+    }
+}
 
-    if (s_dump_ast)
-        program->dump(0);
+static void run_bytecode(JS::Interpreter& interpreter, JS::Bytecode::Executable const& unit)
+{
+    JS::Bytecode::Interpreter bytecode_interpreter(interpreter.global_object());
+    if (s_dump_bytecode_statistics)
+        bytecode_interpreter.enable_statistics();
+    Core::ElapsedTimer timer(true);
+    timer.start();
+    bytecode_interpreter.run(unit);
+    auto elapsed_ms = max(timer.elapsed(), 1);
+    if (s_dump_inline_caches)
+        dump_inline_caches(interpreter.global_object(), unit);
+    if (s_dump_bytecode_statistics) {
+        auto& statistics = *bytecode_interpreter.statistics();
+        warnln("Ran for {} ms, {} instructions per second", elapsed_ms, statistics.executed_instructions * 1000 / elapsed_ms);
+        statistics.dump();
+    }
+}
 
-    if (parser.has_errors()) {
-        auto error = parser.errors()[0];
-        auto hint = error.source_location_hint(source);
-        if (!hint.is_empty())
-            outln("{}", hint);
-        vm->throw_exception<JS::SyntaxError>(interpreter.global_object(), error.to_string());
+static bool parse_and_run(JS::Interpreter& interpreter, StringView const& source)
+{
+    Optional<JS::Bytecode::ExecutableCache> bytecode_cache;
+    if (s_run_bytecode && !s_bytecode_cache_directory.is_empty() && !s_dump_ast)
+        bytecode_cache.emplace(s_bytecode_cache_directory);
+
+    Optional<JS::Bytecode::Executable> cached_unit;
+    if (bytecode_cache.has_value())
+        cached_unit = bytecode_cache->load(source, s_opt_bytecode);
+
+    if (cached_unit.has_value()) {
+        if (s_dump_bytecode)
+            cached_unit->dump();
+        run_bytecode(interpreter, *cached_unit);
     } else {
-        if (s_dump_bytecode || s_run_bytecode) {
+        auto parser = JS::Parser(JS::Lexer(source));
+        parser.set_parses_functions_lazily(s_parse_functions_lazily);
+        auto program = parser.parse_program();
+
+        if (s_dump_ast)
+            program->dump(0);
+
+        if (parser.has_errors()) {
+            auto error = parser.errors()[0];
+            auto hint = error.source_location_hint(source);
+            if (!hint.is_empty())
+                outln("{}", hint);
+            vm->throw_exception<JS::SyntaxError>(interpreter.global_object(), error.to_string());
+        } else if (s_dump_bytecode || s_run_bytecode) {
             auto unit = JS::Bytecode::Generator::generate(*program);
             if (s_opt_bytecode) {
                 auto& passes = JS::Bytecode::Interpreter::optimization_pipeline();
@@ -588,21 +647,15 @@ static bool parse_and_run(JS::Interpreter& interpreter, StringView const& source
                 dbgln("Optimisation passes took {}us", passes.elapsed());
             }
 
-            if (s_dump_bytecode) {
-                for (auto& block : unit.basic_blocks)
-                    block.dump(unit);
-                if (!unit.string_table->is_empty()) {
-                    outln();
-                    unit.string_table->dump();
-                }
-            }
+            if (bytecode_cache.has_value() && !bytecode_cache->store(source, s_opt_bytecode, unit))
+                dbgln("Could not store the bytecode in {}", s_bytecode_cache_directory);
 
-            if (s_run_bytecode) {
-                JS::Bytecode::Interpreter bytecode_interpreter(interpreter.global_object());
-                bytecode_interpreter.run(unit);
-            } else {
+            if (s_dump_bytecode)
+                unit.dump();
+
+            if (!s_run_bytecode)
                 return true;
-            }
+            run_bytecode(interpreter, unit);
         } else {
             interpreter.run(interpreter.global_object(), *program);
         }
@@ -666,6 +719,7 @@ static JS::Value load_file_impl(JS::VM& vm, JS::GlobalObject& global_object)
     auto file_contents = file->read_all();
     auto source = StringView { file_contents };
     auto parser = JS::Parser(JS::Lexer(source));
+    parser.set_parses_functions_lazily(s_parse_functions_lazily);
     auto program = parser.parse_program();
     if (parser.has_errors()) {
         auto& error = parser.errors()[0];
@@ -847,6 +901,8 @@ public:
 int main(int argc, char** argv)
 {
     bool gc_on_every_allocation = false;
+    double gc_heap_growth_factor = 0;
+    unsigned gc_minimum_heap_size_kib = 0;
     bool disable_syntax_highlight = false;
     Vector<String> script_paths;
 
@@ -856,15 +912,38 @@ int main(int argc, char** argv)
     args_parser.add_option(s_dump_bytecode, "Dump the bytecode", "dump-bytecode", 'd');
     args_parser.add_option(s_run_bytecode, "Run the bytecode", "run-bytecode", 'b');
     args_parser.add_option(s_opt_bytecode, "Optimize the bytecode", "optimize-bytecode", 'p');
+    args_parser.add_option(s_parse_functions_lazily, "Only parse the body of a function when it is first called", "lazy-parse", 'L');
+    args_parser.add_option(s_dump_bytecode_statistics, "Count the bytecode instructions that are executed, and show the most frequent ones", "bytecode-statistics", 'S');
+    args_parser.add_option(s_bytecode_cache_directory, "Keep the bytecode of scripts in this directory, and reuse it when they are run again", "bytecode-cache", 0, "directory");
+    args_parser.add_option(s_dump_inline_caches, "Dump the bytecode with the state of its inline caches after running it", "dump-inline-caches", 'c');
+    args_parser.add_option(s_profile_path, "Sample the call stack of the scripts while they run, and write the profile to this file", "profile", 0, "path");
+    args_parser.add_option(s_profile_format, "Write the profile as 'folded' stacks for flame graphs, or as a 'chrome' trace", "profile-format", 0, "format");
     args_parser.add_option(s_print_last_result, "Print last result", "print-last-result", 'l');
     args_parser.add_option(gc_on_every_allocation, "GC on every allocation", "gc-on-every-allocation", 'g');
+    args_parser.add_option(gc_heap_growth_factor, "Start a major GC once the heap has grown to this multiple of what survived the last one", "gc-heap-growth-factor", 0, "factor");
+    args_parser.add_option(gc_minimum_heap_size_kib, "Don't start a major GC before the heap has grown to this size", "gc-minimum-heap-size", 0, "KiB");
     args_parser.add_option(disable_syntax_highlight, "Disable live syntax highlighting", "no-syntax-highlight", 's');
     args_parser.add_positional_argument(script_paths, "Path to script files", "scripts", Core::ArgsParser::Required::No);
     args_parser.parse(argc, argv);
 
+    if (gc_heap_growth_factor != 0 && gc_heap_growth_factor <= 1) {
+        warnln("The heap growth factor must be greater than 1");
+        return 1;
+    }
+
+    if (s_profile_format != "folded" && s_profile_format != "chrome") {
+        warnln("Unknown profile format '{}', expected 'folded' or 'chrome'", s_profile_format);
+        return 1;
+    }
+
     bool syntax_highlight = !disable_syntax_highlight;
 
     vm = JS::VM::create();
+    if (gc_heap_growth_factor != 0)
+        vm->set_heap_growth_factor(gc_heap_growth_factor);
+    if (gc_minimum_heap_size_kib != 0)
+        vm->set_minimum_heap_size(gc_minimum_heap_size_kib * KiB);
+
     // NOTE: These will print out both warnings when using something like Promise.reject().catch(...) -
     // which is, as far as I can tell, correct - a promise is created, rejected without handler, and a
     // handler then attached to it. The Node.js REPL doesn't warn in this case, so it's something we
@@ -1117,7 +1196,28 @@ int main(int argc, char** argv)
             builder.append(source);
         }
 
-        if (!parse_and_run(*interpreter, builder.to_string()))
+        OwnPtr<JS::SamplingProfiler> profiler;
+        if (!s_profile_path.is_empty())
+            profiler = make<JS::SamplingProfiler>(*vm);
+
+        bool did_run = parse_and_run(*interpreter, builder.to_string());
+
+        if (profiler) {
+            profiler->stop();
+            auto profile = s_profile_format == "chrome" ? profiler->to_chrome_trace() : profiler->to_folded_stacks();
+            auto file_or_error = Core::File::open(s_profile_path, Core::OpenMode::WriteOnly);
+            if (file_or_error.is_error()) {
+                warnln("Failed to open {}: {}", s_profile_path, file_or_error.error());
+                return 1;
+            }
+            if (!file_or_error.value()->write(profile)) {
+                warnln("Failed to write the profile to {}", s_profile_path);
+                return 1;
+            }
+            warnln("Wrote {} samples to {}", profiler->sample_count(), s_profile_path);
+        }
+
+        if (!did_run)
             return 1;
     }
 
@@ -0,0 +1,377 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Format.h>
+#include <AK/Function.h>
+#include <AK/JsonObject.h>
+#include <AK/String.h>
+#include <AK/Time.h>
+#include <AK/Vector.h>
+#include <LibCore/ArgsParser.h>
+#include <LibSQL/BTree.h>
+#include <LibSQL/HashIndex.h>
+#include <LibSQL/Heap.h>
+#include <LibSQL/Key.h>
+#include <LibSQL/Tuple.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+// Measures the throughput of the basic operations on the two index types of LibSQL, using a Heap of
+// its own for every index. Every operation is run once per index type and number of keys. Besides
+// the number of operations per second, the number of blocks read from and written to the Heap per
+// operation and the size of the files of the Heap after the operation are reported, so a change in
+// the storage layer shows up even when it doesn't move the timings much.
+
+namespace {
+
+struct Options {
+    String directory { "/tmp" };
+    u32 block_size { SQL::DEFAULT_BLOCK_SIZE };
+    size_t page_cache_budget { SQL::DEFAULT_PAGE_CACHE_BUDGET };
+    u32 commit_interval { 1000 };
+    u64 seed { 0x5eed };
+    bool json { false };
+};
+
+struct Measurement {
+    String index;
+    String operation;
+    u32 keys { 0 };
+    u64 operations { 0 };
+    i64 elapsed_us { 0 };
+    u64 blocks_read { 0 };
+    u64 blocks_written { 0 };
+    off_t file_size { 0 };
+
+    double operations_per_second() const { return elapsed_us ? (double)operations * 1'000'000.0 / (double)elapsed_us : 0.0; }
+    double reads_per_operation() const { return operations ? (double)blocks_read / (double)operations : 0.0; }
+    double writes_per_operation() const { return operations ? (double)blocks_written / (double)operations : 0.0; }
+};
+
+// A fixed seed makes runs comparable: every run inserts, looks up and removes the keys in the same order.
+class Random {
+public:
+    explicit Random(u64 seed)
+        : m_state(seed ? seed : 1)
+    {
+    }
+
+    u64 next()
+    {
+        m_state ^= m_state << 13;
+        m_state ^= m_state >> 7;
+        m_state ^= m_state << 17;
+        return m_state;
+    }
+
+    u32 next(u32 bound) { return (u32)(next() % bound); }
+
+    void shuffle(Vector<u32>& values)
+    {
+        for (auto ix = values.size(); ix > 1; ix--)
+            swap(values[ix - 1], values[next((u32)ix)]);
+    }
+
+private:
+    u64 m_state;
+};
+
+Time now()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return Time::from_timespec(now);
+}
+
+off_t file_size(String const& path)
+{
+    struct stat stat_buffer;
+    if (stat(path.characters(), &stat_buffer) != 0)
+        return 0;
+    return stat_buffer.st_size;
+}
+
+// The index under test, with the Heap holding it. Both index types get the same interface, so the
+// operations can be written once.
+class Bench {
+public:
+    Bench(Options const& options, String index_type)
+        : m_options(options)
+        , m_index_type(move(index_type))
+        , m_file_name(String::formatted("{}/sql-benchmark-{}.db", options.directory, getpid()))
+    {
+        remove_files();
+        m_heap = SQL::Heap::construct(m_file_name, options.block_size);
+        m_heap->set_page_cache_budget(options.page_cache_budget);
+        m_descriptor.append({ "key", SQL::SQLType::Integer, SQL::AST::Order::Ascending });
+        if (is_btree())
+            m_btree = SQL::BTree::construct(*m_heap, m_descriptor, 0);
+        else
+            m_hash_index = SQL::HashIndex::construct(*m_heap, m_descriptor, m_heap->new_record_pointer());
+    }
+
+    ~Bench()
+    {
+        m_btree = nullptr;
+        m_hash_index = nullptr;
+        m_heap = nullptr;
+        remove_files();
+    }
+
+    [[nodiscard]] bool is_btree() const { return m_index_type == "btree"; }
+    [[nodiscard]] String const& index_type() const { return m_index_type; }
+
+    SQL::Key key(u32 value, u32 pointer) const
+    {
+        SQL::Key key(m_descriptor);
+        key[0] = (int)value;
+        key.set_pointer(pointer);
+        return key;
+    }
+
+    void insert(u32 value)
+    {
+        auto entry = key(value, value + 1);
+        if (is_btree())
+            m_btree->insert(entry);
+        else
+            m_hash_index->insert(entry);
+        operation_done();
+    }
+
+    bool lookup(u32 value)
+    {
+        auto entry = key(value, 0);
+        auto pointer = is_btree() ? m_btree->get(entry) : m_hash_index->get(entry);
+        return pointer.has_value();
+    }
+
+    // Visits `count` keys in ascending order, starting at the first key not less than `value`.
+    size_t scan(u32 value, size_t count)
+    {
+        VERIFY(is_btree());
+        size_t visited = 0;
+        for (auto iterator = m_btree->lower_bound(key(value, 0)); !iterator.is_end() && visited < count; iterator++)
+            visited++;
+        return visited;
+    }
+
+    void update(u32 value, u32 pointer)
+    {
+        auto entry = key(value, pointer);
+        if (is_btree()) {
+            m_btree->update_key_pointer(entry);
+        } else {
+            m_hash_index->remove(entry);
+            m_hash_index->insert(entry);
+        }
+        operation_done();
+    }
+
+    void remove(u32 value)
+    {
+        auto entry = key(value, 0);
+        if (is_btree())
+            m_btree->remove(entry);
+        else
+            m_hash_index->remove(entry);
+        operation_done();
+    }
+
+    Measurement measure(StringView operation, u32 keys, u64 operations, Function<void()> const& body)
+    {
+        auto blocks_read = m_heap->blocks_read();
+        auto blocks_written = m_heap->blocks_written();
+        auto start = now();
+        body();
+        m_heap->flush();
+        m_pending = 0;
+        auto elapsed = now() - start;
+
+        Measurement measurement;
+        measurement.index = m_index_type;
+        measurement.operation = operation;
+        measurement.keys = keys;
+        measurement.operations = operations;
+        measurement.elapsed_us = elapsed.to_microseconds();
+        measurement.blocks_read = m_heap->blocks_read() - blocks_read;
+        measurement.blocks_written = m_heap->blocks_written() - blocks_written;
+        measurement.file_size = file_size(m_file_name) + file_size(m_heap->wal_name());
+        return measurement;
+    }
+
+private:
+    // Changes are committed in batches, like a client inserting rows would:
+    void operation_done()
+    {
+        if (++m_pending >= m_options.commit_interval) {
+            m_heap->flush();
+            m_pending = 0;
+        }
+    }
+
+    void remove_files() const
+    {
+        unlink(m_file_name.characters());
+        unlink(String::formatted("{}-wal", m_file_name).characters());
+    }
+
+    Options const& m_options;
+    String m_index_type;
+    String m_file_name;
+    SQL::TupleDescriptor m_descriptor;
+    RefPtr<SQL::Heap> m_heap;
+    RefPtr<SQL::BTree> m_btree;
+    RefPtr<SQL::HashIndex> m_hash_index;
+    u32 m_pending { 0 };
+};
+
+constexpr static size_t RANGE_SCAN_LENGTH = 100;
+
+Vector<Measurement> run_benchmarks(Options const& options, String const& index_type, u32 keys)
+{
+    Vector<Measurement> measurements;
+    Random random(options.seed);
+
+    Vector<u32> shuffled;
+    shuffled.ensure_capacity(keys);
+    for (auto ix = 0u; ix < keys; ix++)
+        shuffled.append(ix);
+    random.shuffle(shuffled);
+
+    {
+        Bench bench(options, index_type);
+        measurements.append(bench.measure("insert_sequential", keys, keys, [&]() {
+            for (auto ix = 0u; ix < keys; ix++)
+                bench.insert(ix);
+        }));
+    }
+
+    Bench bench(options, index_type);
+    measurements.append(bench.measure("insert_random", keys, keys, [&]() {
+        for (auto value : shuffled)
+            bench.insert(value);
+    }));
+
+    random.shuffle(shuffled);
+    measurements.append(bench.measure("lookup", keys, keys, [&]() {
+        for (auto value : shuffled) {
+            if (!bench.lookup(value)) {
+                warnln("Key {} not found in {} index", value, index_type);
+                VERIFY_NOT_REACHED();
+            }
+        }
+    }));
+
+    if (bench.is_btree()) {
+        auto scans = max(keys / (u32)RANGE_SCAN_LENGTH, 1u);
+        measurements.append(bench.measure("range_scan", keys, scans, [&]() {
+            for (auto ix = 0u; ix < scans; ix++)
+                bench.scan(random.next(keys), RANGE_SCAN_LENGTH);
+        }));
+    }
+
+    random.shuffle(shuffled);
+    measurements.append(bench.measure("update", keys, keys, [&]() {
+        for (auto value : shuffled)
+            bench.update(value, value + 2);
+    }));
+
+    random.shuffle(shuffled);
+    measurements.append(bench.measure("delete", keys, keys, [&]() {
+        for (auto value : shuffled)
+            bench.remove(value);
+    }));
+    return measurements;
+}
+
+void print_header()
+{
+    outln("{:<6} {:<18} {:>10} {:>12} {:>10} {:>10} {:>12}", "index", "operation", "keys", "ops/s", "reads/op", "writes/op", "file size");
+}
+
+void print_measurement(Measurement const& measurement, bool json)
+{
+    if (json) {
+        JsonObject object;
+        object.set("index", measurement.index);
+        object.set("operation", measurement.operation);
+        object.set("keys", measurement.keys);
+        object.set("operations", measurement.operations);
+        object.set("elapsed_us", measurement.elapsed_us);
+        object.set("operations_per_second", measurement.operations_per_second());
+        object.set("blocks_read", measurement.blocks_read);
+        object.set("blocks_written", measurement.blocks_written);
+        object.set("blocks_read_per_operation", measurement.reads_per_operation());
+        object.set("blocks_written_per_operation", measurement.writes_per_operation());
+        object.set("file_size", (i64)measurement.file_size);
+        outln("{}", object.to_string());
+        return;
+    }
+    outln("{:<6} {:<18} {:>10} {:>12.0} {:>10.3} {:>10.3} {:>12}", measurement.index, measurement.operation, measurement.keys,
+        measurement.operations_per_second(), measurement.reads_per_operation(), measurement.writes_per_operation(), measurement.file_size);
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+    String key_counts = "10000,100000";
+    String index_types = "btree,hash";
+    unsigned page_cache_budget_kib = SQL::DEFAULT_PAGE_CACHE_BUDGET / KiB;
+    unsigned seed = options.seed;
+
+    Core::ArgsParser args_parser;
+    args_parser.set_general_help("Measure the throughput of the LibSQL index types.");
+    args_parser.add_option(key_counts, "Comma-separated numbers of keys (default 10000,100000)", "keys", 'n', "counts");
+    args_parser.add_option(index_types, "Comma-separated index types: btree, hash (default both)", "index", 'i', "types");
+    args_parser.add_option(options.directory, "Directory for the database files (default /tmp)", "directory", 'd', "directory");
+    args_parser.add_option(options.block_size, "Block size of the database files", "block-size", 'b', "bytes");
+    args_parser.add_option(page_cache_budget_kib, "Page cache budget", "page-cache", 'c', "KiB");
+    args_parser.add_option(options.commit_interval, "Number of changes per commit (default 1000)", "commit-interval", 'C', "changes");
+    args_parser.add_option(seed, "Seed for the order of the keys", "seed", 's', "seed");
+    args_parser.add_option(options.json, "Print every measurement as a JSON object on a line of its own", "json", 'j');
+    args_parser.parse(argc, argv);
+
+    options.page_cache_budget = (size_t)page_cache_budget_kib * KiB;
+    options.seed = seed;
+    options.commit_interval = max(options.commit_interval, 1u);
+    if (!SQL::Heap::is_valid_block_size(options.block_size)) {
+        warnln("Block size must be a power of two between {} and {}", SQL::MIN_BLOCK_SIZE, SQL::MAX_BLOCK_SIZE);
+        return 1;
+    }
+
+    Vector<u32> keys;
+    for (auto& count : key_counts.split(',')) {
+        auto value = count.to_uint();
+        if (!value.has_value() || value.value() == 0) {
+            warnln("Invalid number of keys '{}'", count);
+            return 1;
+        }
+        keys.append(value.value());
+    }
+    Vector<String> indexes;
+    for (auto& type : index_types.split(',')) {
+        if (type != "btree" && type != "hash") {
+            warnln("Unknown index type '{}'", type);
+            return 1;
+        }
+        indexes.append(type);
+    }
+
+    if (!options.json)
+        print_header();
+    for (auto& index_type : indexes) {
+        for (auto count : keys) {
+            for (auto& measurement : run_benchmarks(options, index_type, count))
+                print_measurement(measurement, options.json);
+        }
+    }
+    return 0;
+}
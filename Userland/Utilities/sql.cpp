@@ -7,16 +7,26 @@
 #include <AK/Format.h>
 #include <AK/String.h>
 #include <AK/StringBuilder.h>
+#include <LibCore/ArgsParser.h>
+#include <LibCore/File.h>
 #include <LibCore/StandardPaths.h>
 #include <LibLine/Editor.h>
 #include <LibSQL/AST/Lexer.h>
 #include <LibSQL/AST/Parser.h>
 #include <LibSQL/AST/Token.h>
+#include <LibSQL/BulkLoader.h>
+#include <LibSQL/Database.h>
+#include <LibSQL/Executor.h>
+#include <LibSQL/Meta.h>
+#include <LibSQL/Row.h>
+#include <stdlib.h>
 
 namespace {
 
 String s_history_path = String::formatted("{}/.sql-history", Core::StandardPaths::home_directory());
 RefPtr<Line::Editor> s_editor;
+RefPtr<SQL::Database> s_database;
+OwnPtr<SQL::Executor> s_executor;
 int s_repl_line_level = 0;
 bool s_keep_running = true;
 
@@ -86,23 +96,192 @@ String read_next_piece()
     return piece.to_string();
 }
 
+// Splits CSV or TSV text into records. Fields can be enclosed in double quotes, in which case they can
+// contain separators and line breaks, and a double quote is written as two double quotes.
+Vector<Vector<String>> parse_records(StringView text, char separator)
+{
+    Vector<Vector<String>> records;
+    Vector<String> record;
+    StringBuilder field;
+    bool in_quotes = false;
+    bool record_has_content = false;
+
+    auto end_field = [&]() {
+        record.append(field.build());
+        field.clear();
+    };
+    auto end_record = [&]() {
+        end_field();
+        if (record_has_content)
+            records.append(move(record));
+        record.clear();
+        record_has_content = false;
+    };
+
+    for (size_t ix = 0; ix < text.length(); ix++) {
+        auto ch = text[ix];
+        if (in_quotes) {
+            if (ch != '"')
+                field.append(ch);
+            else if (ix + 1 < text.length() && text[ix + 1] == '"')
+                field.append(text[++ix]);
+            else
+                in_quotes = false;
+            continue;
+        }
+        if (ch == '\r')
+            continue;
+        if (ch == '\n') {
+            end_record();
+            continue;
+        }
+        record_has_content = true;
+        if (ch == separator)
+            end_field();
+        else if (ch == '"')
+            in_quotes = true;
+        else
+            field.append(ch);
+    }
+    end_record();
+    return records;
+}
+
+Optional<String> store_field(SQL::Row& row, size_t column, String const& field)
+{
+    auto& value = row[column];
+    switch (value.type()) {
+    case SQL::SQLType::Text:
+        value = field;
+        return {};
+    case SQL::SQLType::Integer:
+        if (auto integer = field.to_int(); integer.has_value()) {
+            value = integer.value();
+            return {};
+        }
+        break;
+    case SQL::SQLType::Float: {
+        char* end = nullptr;
+        auto number = strtod(field.characters(), &end);
+        if (!field.is_empty() && end == field.characters() + field.length()) {
+            value = number;
+            return {};
+        }
+        break;
+    }
+    }
+    return String::formatted("Cannot store '{}' in column {} of type {}", field, row.descriptor()[column].name, value.type_name());
+}
+
+// Imports a CSV file, or a TSV file if its name ends in '.tsv', into an existing table. The fields
+// of every record are stored in the columns of the table in order. The first record is skipped if
+// it holds the names of the columns.
+bool import_file(StringView path, StringView table_name)
+{
+    auto qualified_name = String(table_name).to_uppercase();
+    String schema_name = "DEFAULT";
+    if (auto period = qualified_name.find('.'); period.has_value()) {
+        schema_name = qualified_name.substring(0, period.value());
+        qualified_name = qualified_name.substring(period.value() + 1);
+    }
+    auto table = s_database->get_table(schema_name, qualified_name);
+    if (!table) {
+        outln("\033[33;1mError:\033[0m No such table: {}", table_name);
+        return false;
+    }
+
+    auto file_or_error = Core::File::open(path, Core::OpenMode::ReadOnly);
+    if (file_or_error.is_error()) {
+        outln("\033[33;1mError:\033[0m Could not open {}: {}", path, file_or_error.error());
+        return false;
+    }
+    auto contents = file_or_error.value()->read_all();
+    auto records = parse_records(StringView(contents), path.ends_with(".tsv", CaseSensitivity::CaseInsensitive) ? '\t' : ',');
+
+    auto columns = table->columns();
+    size_t first_record = 0;
+    if (!records.is_empty() && records[0].size() == columns.size()) {
+        first_record = 1;
+        for (auto ix = 0u; ix < columns.size(); ix++) {
+            if (!records[0][ix].equals_ignoring_case(columns[ix].name()))
+                first_record = 0;
+        }
+    }
+
+    SQL::BulkLoader loader(*s_database, *table);
+    for (auto record_ix = first_record; record_ix < records.size(); record_ix++) {
+        auto& record = records[record_ix];
+        if (record.size() != columns.size()) {
+            outln("\033[33;1mError:\033[0m Record {} has {} fields for {} columns", record_ix + 1, record.size(), columns.size());
+            return false;
+        }
+        SQL::Row row(table);
+        for (auto ix = 0u; ix < record.size(); ix++) {
+            if (auto error = store_field(row, ix, record[ix]); error.has_value()) {
+                outln("\033[33;1mError:\033[0m Record {}: {}", record_ix + 1, error.value());
+                return false;
+            }
+        }
+        loader.append(row);
+    }
+    if (!loader.finish()) {
+        outln("\033[33;1mError:\033[0m UNIQUE constraint failed on table {}", table->name());
+        return false;
+    }
+    s_database->commit();
+    outln("Imported {} rows into {}", loader.rows(), table->name());
+    return true;
+}
+
 void handle_command(StringView command)
 {
-    if (command == ".exit")
+    auto parts = command.split_view(' ');
+    if (command == ".exit") {
         s_keep_running = false;
-    else
+    } else if (!parts.is_empty() && parts[0] == ".import") {
+        if (parts.size() != 3)
+            outln("\033[33;1mUsage:\033[0m .import FILE TABLE");
+        else
+            import_file(parts[1], parts[2]);
+    } else {
         outln("\033[33;1mUnrecognized command:\033[0m {}", command);
+    }
+}
+
+void print_rows(SQL::Operator& rows)
+{
+    for (auto row = rows.next(); row.has_value(); row = rows.next()) {
+        StringBuilder builder;
+        for (auto ix = 0u; ix < row->length(); ix++) {
+            if (ix > 0)
+                builder.append('|');
+            builder.append((*row)[ix].to_string().value_or({}));
+        }
+        outln("{}", builder.string_view());
+    }
 }
 
-void handle_statement(StringView statement_string)
+bool handle_statement(StringView statement_string)
 {
     auto parser = SQL::AST::Parser(SQL::AST::Lexer(statement_string));
-    [[maybe_unused]] auto statement = parser.next_statement();
+    while (!parser.is_eof()) {
+        auto statement = parser.next_statement();
+
+        if (parser.has_errors()) {
+            auto error = parser.errors()[0];
+            outln("\033[33;1mInvalid statement:\033[0m {}", error.to_string());
+            return false;
+        }
 
-    if (parser.has_errors()) {
-        auto error = parser.errors()[0];
-        outln("\033[33;1mInvalid statement:\033[0m {}", error.to_string());
+        auto result = s_executor->execute(statement);
+        if (result.is_error()) {
+            outln("\033[33;1mError:\033[0m {}", result.error());
+            return false;
+        }
+        if (auto rows = result.release_value(); rows)
+            print_rows(*rows);
     }
+    return true;
 }
 
 void repl()
@@ -121,8 +300,52 @@ void repl()
 
 }
 
-int main()
+int main(int argc, char** argv)
 {
+    String database_path = String::formatted("{}/sql.db", Core::StandardPaths::home_directory());
+    const char* script_path = nullptr;
+    const char* import_path = nullptr;
+    const char* import_table = nullptr;
+    unsigned page_size = SQL::DEFAULT_BLOCK_SIZE;
+
+    Core::ArgsParser args_parser;
+    args_parser.set_general_help("Run SQL statements against a database, either from a script or interactively.");
+    args_parser.add_option(database_path, "Database file to use", "database", 'd', "path");
+    args_parser.add_option(import_path, "CSV or TSV file to import into a table, before running the script", "import", 'i', "path");
+    args_parser.add_option(import_table, "Table to import the file into", "table", 't', "table");
+    args_parser.add_option(page_size, "Page size in bytes of a new database file (4096, 8192, or 16384)", "page-size", 'p', "bytes");
+    args_parser.add_positional_argument(script_path, "File with SQL statements to run", "script", Core::ArgsParser::Required::No);
+    args_parser.parse(argc, argv);
+
+    if (!SQL::Heap::is_valid_block_size(page_size)) {
+        warnln("Invalid page size {}. The page size must be a power of two between {} and {}", page_size, SQL::MIN_BLOCK_SIZE, SQL::MAX_BLOCK_SIZE);
+        return 1;
+    }
+
+    // The page size of an existing database file is the one it was created with.
+    s_database = SQL::Database::construct(database_path, page_size);
+    s_executor = make<SQL::Executor>(*s_database);
+
+    if (import_path) {
+        if (!import_table) {
+            warnln("The table to import {} into must be given using --table", import_path);
+            return 1;
+        }
+        if (!import_file(import_path, import_table))
+            return 1;
+        if (!script_path)
+            return 0;
+    }
+
+    if (script_path) {
+        auto file_or_error = Core::File::open(script_path, Core::OpenMode::ReadOnly);
+        if (file_or_error.is_error()) {
+            warnln("Could not open {}: {}", script_path, file_or_error.error());
+            return 1;
+        }
+        return handle_statement(file_or_error.value()->read_all()) ? 0 : 1;
+    }
+
     s_editor = Line::Editor::construct();
     s_editor->load_history(s_history_path);
 
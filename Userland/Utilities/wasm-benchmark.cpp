@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Format.h>
+#include <AK/LexicalPath.h>
+#include <AK/QuickSort.h>
+#include <AK/String.h>
+#include <AK/Vector.h>
+#include <LibCore/ArgsParser.h>
+#include <LibCore/DirIterator.h>
+#include <LibCore/ElapsedTimer.h>
+#include <LibCore/File.h>
+#include <LibCore/FileStream.h>
+#include <LibWasm/AbstractMachine/AbstractMachine.h>
+#include <LibWasm/AbstractMachine/BytecodeInterpreter.h>
+#include <LibWasm/Types.h>
+#include <stdlib.h>
+
+// Runs the same exported function of every module with both encodings the interpreter knows about: the
+// parsed Instructions, stepped through one at a time, and the lowered form that the interpreter normally
+// runs, and once more with every function compiled to machine code where there is a JIT. All of them have
+// to come up with the same results, so this doubles as a check that lowering and compiling didn't change
+// what a module does.
+//
+// The bundled modules each export a `run` function without parameters:
+// - dispatch: a loop through a br_table and a call_indirect on every iteration.
+// - fib: the naive recursive fibonacci, so mostly calls.
+// - hash-loop: a tight loop of i64 arithmetic on locals.
+// - mandelbrot: nested loops of f64 arithmetic.
+// - sieve: the sieve of Eratosthenes in linear memory, so mostly byte loads and stores.
+
+namespace {
+
+// Runs the parsed Instructions one at a time, like the debugger does, without any hooks to slow it down further.
+struct InstructionSteppingInterpreter final : public Wasm::BytecodeInterpreter {
+    virtual void interpret(Wasm::Configuration& configuration) override { step_through_instructions(configuration); }
+};
+
+struct Measurement {
+    i64 best_ms { NumericLimits<i64>::max() };
+    Vector<Wasm::Value> results;
+};
+
+Optional<Wasm::Module> parse(String const& filename)
+{
+    auto result = Core::File::open(filename, Core::OpenMode::ReadOnly);
+    if (result.is_error()) {
+        warnln("Failed to open {}: {}", filename, result.error());
+        return {};
+    }
+
+    auto stream = Core::InputFileStream(result.release_value());
+    auto parse_result = Wasm::Module::parse(stream);
+    if (parse_result.is_error()) {
+        warnln("Failed to parse {}: {}", filename, Wasm::parse_error_to_string(parse_result.error()));
+        // The stream insists on being told that its error was seen, or it asserts when it goes away.
+        stream.handle_any_error();
+        return {};
+    }
+    return parse_result.release_value();
+}
+
+// Every run gets a fresh instance, so a module that keeps state in its memory or globals is measured from the same start.
+Optional<Measurement> measure(Wasm::Module const& module, String const& function_name, Wasm::Interpreter& interpreter, unsigned runs)
+{
+    Measurement measurement;
+    for (unsigned i = 0; i < runs; ++i) {
+        Wasm::AbstractMachine machine;
+        auto instantiation_result = machine.instantiate(module, {});
+        if (instantiation_result.is_error()) {
+            warnln("Instantiation failed: {}", instantiation_result.error().error);
+            return {};
+        }
+        auto instance = instantiation_result.release_value();
+
+        Optional<Wasm::FunctionAddress> address;
+        for (auto& entry : instance->exports()) {
+            if (entry.name() == function_name) {
+                if (auto* function_address = entry.value().get_pointer<Wasm::FunctionAddress>())
+                    address = *function_address;
+            }
+        }
+        if (!address.has_value()) {
+            warnln("No exported function named '{}'", function_name);
+            return {};
+        }
+
+        Core::ElapsedTimer timer;
+        timer.start();
+        auto result = machine.invoke(interpreter, *address, {});
+        auto elapsed_ms = timer.elapsed();
+        if (result.is_trap()) {
+            warnln("Execution trapped: {}", result.trap().reason);
+            return {};
+        }
+        measurement.best_ms = min(measurement.best_ms, static_cast<i64>(elapsed_ms));
+        measurement.results = move(result.values());
+    }
+    return measurement;
+}
+
+// The size of the instruction records alone, not counting what their arguments allocate on the side.
+void count_encoded_bytes(Wasm::Module const& module, size_t& instruction_bytes, size_t& lowered_bytes)
+{
+    Wasm::AbstractMachine machine;
+    auto instantiation_result = machine.instantiate(module, {});
+    if (instantiation_result.is_error())
+        return;
+    for (auto& address : instantiation_result.value()->functions()) {
+        auto* function = machine.store().get(address);
+        if (!function || !function->has<Wasm::WasmFunction>())
+            continue;
+        auto* lowered = function->get<Wasm::WasmFunction>().lowered();
+        if (!lowered)
+            continue;
+        instruction_bytes += lowered->expression().instructions().size() * sizeof(Wasm::Instruction);
+        lowered_bytes += lowered->lowered_instructions().size() * sizeof(Wasm::LoweredInstruction);
+    }
+}
+
+bool results_match(Vector<Wasm::Value> const& a, Vector<Wasm::Value> const& b)
+{
+    if (a.size() != b.size())
+        return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (Wasm::value_to_slot(a[i]) != Wasm::value_to_slot(b[i]))
+            return false;
+    }
+    return true;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    Vector<String> filenames;
+    String function_name = "run";
+    unsigned runs = 3;
+
+    Core::ArgsParser args_parser;
+    args_parser.set_general_help("Compare how fast the interpreter runs modules with either of its instruction encodings, and with the JIT.");
+    args_parser.add_option(function_name, "Name of the exported function to run (default run)", "execute", 'e', "name");
+    args_parser.add_option(runs, "Number of runs per encoding, of which the fastest is reported (default 3)", "runs", 'n', "count");
+    args_parser.add_positional_argument(filenames, "Modules to run (default: the bundled benchmarks)", "files", Core::ArgsParser::Required::No);
+    args_parser.parse(argc, argv);
+
+    if (filenames.is_empty()) {
+        auto* source_dir = getenv("SERENITY_SOURCE_DIR");
+        if (!source_dir) {
+            warnln("No modules given, and SERENITY_SOURCE_DIR isn't set to find the bundled ones with");
+            return 1;
+        }
+        auto directory = String::formatted("{}/Userland/Libraries/LibWasm/Tests/Fixtures/Benchmarks", source_dir);
+        Core::DirIterator iterator(directory, Core::DirIterator::SkipDots);
+        while (iterator.has_next()) {
+            auto path = iterator.next_full_path();
+            if (path.ends_with(".wasm"))
+                filenames.append(move(path));
+        }
+        quick_sort(filenames);
+    }
+    runs = max(runs, 1u);
+
+    outln("{:<40} {:>12} {:>12} {:>12} {:>12} {:>8} {:>8}", "module", "insn bytes", "lowered", "stepped ms", "lowered ms", "jit ms", "speedup");
+    bool all_passed = true;
+    for (auto& filename : filenames) {
+        auto module = parse(filename);
+        if (!module.has_value()) {
+            all_passed = false;
+            continue;
+        }
+
+        InstructionSteppingInterpreter stepping_interpreter;
+        Wasm::BytecodeInterpreter lowered_interpreter;
+        lowered_interpreter.set_jit_threshold({});
+        Wasm::BytecodeInterpreter jit_interpreter;
+        auto stepped = measure(*module, function_name, stepping_interpreter, runs);
+        auto lowered = measure(*module, function_name, lowered_interpreter, runs);
+        if (!stepped.has_value() || !lowered.has_value()) {
+            warnln("Skipping {}", filename);
+            all_passed = false;
+            continue;
+        }
+        if (!results_match(stepped->results, lowered->results)) {
+            warnln("{}: the encodings returned different results", filename);
+            all_passed = false;
+        }
+
+        Optional<Measurement> compiled;
+        if (Wasm::JIT::default_threshold().has_value()) {
+            jit_interpreter.set_jit_threshold(0);
+            compiled = measure(*module, function_name, jit_interpreter, runs);
+            if (!compiled.has_value()) {
+                all_passed = false;
+            } else if (!results_match(stepped->results, compiled->results)) {
+                warnln("{}: the compiled code returned different results", filename);
+                all_passed = false;
+            }
+        }
+
+        size_t instruction_bytes = 0;
+        size_t lowered_bytes = 0;
+        count_encoded_bytes(*module, instruction_bytes, lowered_bytes);
+        auto speedup = lowered->best_ms ? static_cast<double>(stepped->best_ms) / static_cast<double>(lowered->best_ms) : 0.0;
+        auto compiled_ms = compiled.has_value() ? String::number(compiled->best_ms) : String("-");
+        outln("{:<40} {:>12} {:>12} {:>12} {:>12} {:>8} {:>7.2}x", LexicalPath::basename(filename), instruction_bytes, lowered_bytes, stepped->best_ms, lowered->best_ms, compiled_ms, speedup);
+    }
+    return all_passed ? 0 : 1;
+}
@@ -433,7 +433,6 @@ int main(int argc, char* argv[])
             Wasm::Expression expression { {} };
             config.set_frame(Wasm::Frame {
                 *module_instance,
-                Vector<Wasm::Value> {},
                 expression,
                 0,
             });
@@ -507,7 +506,8 @@ int main(int argc, char* argv[])
                 outln();
             }
 
-            auto result = machine.invoke(g_interpreter, run_address.value(), move(values));
+            // The debugger has to step through the instructions one by one, but otherwise we can run the lowered form.
+            auto result = debug ? machine.invoke(g_interpreter, run_address.value(), move(values)) : machine.invoke(run_address.value(), move(values));
 
             if (debug)
                 launch_repl();